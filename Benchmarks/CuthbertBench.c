@@ -0,0 +1,267 @@
+/*
+	File:		CuthbertBench.c
+
+	Contains:	Command-line timing and sanity check for lp.cuthbert's no-repeat draw,
+				against the urn scan the object used before.
+
+	Written by:	Peter Castine
+
+	Copyright:	© 2026 Peter Castine
+
+	Change History (most recent first):
+
+*/
+
+
+/******************************************************************************************
+
+	Not part of any external. Build it as a command-line tool with the same prefix header
+	and search paths as the Litter externals, plus these LitterLib sources:
+
+		Taus88.c  MiscUtils.c
+
+	and run it without arguments.
+
+	NextValue() below is a copy of the function of the same name in cuthbert.c, minus the
+	object struct; keep the two in step. UrnValue() is the ball-count scan that cuthbert
+	inherited from lp.ernie, with one ball per value and the urn refilled when empty.
+
+	Both are timed at kValCount values. The urn scan is linear in the number of values,
+	so it gets only kUrnDraws draws; the new draw gets kDraws. Each timing is the best of
+	kReps runs; expect run-to-run noise of 10-15%. After timing, the new draw is checked
+	for repeats within the memory length and for its mean.
+
+ ******************************************************************************************/
+
+#pragma mark • Include Files
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "Taus88.h"
+#include "MiscUtils.h"
+
+
+#pragma mark • Constants
+
+enum {
+	kValCount	= 1000000,
+	kMemLen		= 1000,
+	kDraws		= 10000000,
+	kUrnDraws	= 2000,
+	kReps		= 5
+	};
+
+
+#pragma mark • Type Definitions
+
+typedef struct {
+	long	valCount,
+			curMemLen,
+			poolSize,
+			filled,
+			head;
+	long*	perm;
+	} tNoRepeat;
+
+typedef struct {
+	long	valCount,
+			ballsInUrn;
+	long*	state;
+	} tUrn;
+
+
+#pragma mark • Static Variables
+
+static tTaus88Data	sTaus;
+
+
+#pragma mark -
+/*****************************  I M P L E M E N T A T I O N  ******************************/
+
+#pragma mark • Draws
+
+	static long NextValue(tNoRepeat* me, UInt32* ioS1, UInt32* ioS2, UInt32* ioS3)
+		{
+		long*	perm	= me->perm;
+		long	mem		= me->curMemLen,
+				i, x;
+
+		if (me->poolSize <= 0)
+			return -1;
+
+		if (me->filled < mem) {
+			long filled = me->filled;
+
+			i = filled + (long) ((double) (me->poolSize - filled)
+									* ULong2Unit_Zo(Taus88Process(ioS1, ioS2, ioS3)));
+			x			= perm[i];
+			perm[i]		= perm[filled];
+			perm[filled]= x;
+			me->filled	= filled + 1;
+			}
+
+		else {
+			long head = me->head;
+
+			i = mem + (long) ((double) (me->poolSize - mem)
+									* ULong2Unit_Zo(Taus88Process(ioS1, ioS2, ioS3)));
+			x			= perm[i];
+			perm[i]		= perm[head];
+			perm[head]	= x;
+			if (++head >= mem)
+				head = 0;
+			me->head	= head;
+			}
+
+		return x;
+		}
+
+	static void UrnRefill(tUrn* me)
+		{
+		long i;
+
+		for (i = 0; i < me->valCount; i += 1)
+			me->state[i] = 1;
+		me->ballsInUrn = me->valCount;
+		}
+
+	static long UrnValue(tUrn* me)
+		{
+		long	theBall = -1,
+				magic;
+		long*	sp;
+
+		if (me->ballsInUrn == 0)
+			UrnRefill(me);
+
+		magic = ((double) me->ballsInUrn) * ULong2Unit_Zo(Taus88(&sTaus)) + 1.0;
+
+		sp = me->state - 1;
+		do {
+			theBall += 1;
+			} while ((magic -= *++sp) > 0);
+
+		*sp				-= 1;
+		me->ballsInUrn	-= 1;
+
+		return theBall;
+		}
+
+
+#pragma mark • Timing
+
+	static double Nanos(clock_t iStart, long iCount)
+		{ return (double) (clock() - iStart) / (double) CLOCKS_PER_SEC * 1e9 / (double) iCount; }
+
+static void
+BenchUrn(void)
+
+	{
+	tUrn	urn;
+	double	best = 1e300;
+	long	sum = 0;
+	int		r;
+
+	urn.valCount	= kValCount;
+	urn.state		= (long*) malloc(kValCount * sizeof(long));
+	UrnRefill(&urn);
+
+	for (r = 0; r < kReps; r += 1) {
+		clock_t	start = clock();
+		long	i;
+		double	ns;
+
+		for (i = 0; i < kUrnDraws; i += 1)
+			sum += UrnValue(&urn);
+
+		ns = Nanos(start, kUrnDraws);
+		if (ns < best) best = ns;
+		}
+
+	printf("  urn scan (legacy)    %12.1f ns/draw   (%d draws; checksum %ld)\n",
+			best, kUrnDraws, sum);
+
+	free(urn.state);
+	}
+
+static void
+BenchNoRepeat(void)
+
+	{
+	tNoRepeat	nr;
+	long*		last	= (long*) malloc(kValCount * sizeof(long));
+	double		best	= 1e300,
+				sum		= 0.0;
+	long		repeats	= 0,
+				n		= 0,
+				i;
+	int			r;
+	UInt32		s1, s2, s3;
+
+	nr.valCount		= kValCount;
+	nr.poolSize		= kValCount;
+	nr.curMemLen	= kMemLen;
+	nr.filled		= 0;
+	nr.head			= 0;
+	nr.perm			= (long*) malloc(kValCount * sizeof(long));
+	for (i = 0; i < kValCount; i += 1) {
+		nr.perm[i]	= i;
+		last[i]		= -kMemLen - 1;
+		}
+
+	Taus88Load(&sTaus, &s1, &s2, &s3);
+
+	for (r = 0; r < kReps; r += 1) {
+		clock_t	start = clock();
+		long	x = 0;
+		double	ns;
+
+		for (i = 0; i < kDraws; i += 1)
+			x += NextValue(&nr, &s1, &s2, &s3);
+
+		ns = Nanos(start, kDraws);
+		if (ns < best) best = ns;
+		sum += (double) x;
+		}
+
+	printf("  ring swap (current)  %12.1f ns/draw   (%d draws; checksum %.0f)\n",
+			best, kDraws, sum);
+
+	// Sanity check: no value within kMemLen draws of its last appearance
+	sum = 0.0;
+	for (i = 0; i < kDraws; i += 1, n += 1) {
+		long x = NextValue(&nr, &s1, &s2, &s3);
+
+		if (n - last[x] <= kMemLen)
+			repeats += 1;
+		last[x] = n;
+		sum += (double) x;
+		}
+
+	Taus88Store(&sTaus, s1, s2, s3);
+
+	printf("\n  repeats within %d draws: %ld\n", kMemLen, repeats);
+	printf("  mean %.1f (exact %.1f)\n", sum / (double) kDraws, 0.5 * (kValCount - 1));
+
+	free(nr.perm);
+	free(last);
+	}
+
+
+#pragma mark -
+#pragma mark • Main
+
+int
+main(void)
+
+	{
+	Taus88Seed(&sTaus, 8191);
+
+	printf("cuthbert (%d values, memory length %d)\n", kValCount, kMemLen);
+	BenchUrn();
+	BenchNoRepeat();
+
+	return 0;
+	}
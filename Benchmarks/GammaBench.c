@@ -0,0 +1,294 @@
+/*
+	File:		GammaBench.c
+
+	Contains:	Command-line timing and sanity check for the gamma-family generators in
+				RNGGamma and RNGChi2, as used by gammer, chichi, fishie and stu.
+
+	Written by:	Peter Castine
+
+	Copyright:	© 2026 Peter Castine
+
+	Change History (most recent first):
+
+*/
+
+
+/******************************************************************************************
+
+	Not part of any external. Build it as a command-line tool with the same prefix header
+	and search paths as the Litter externals, plus these LitterLib sources:
+
+		Taus88.c  MiscUtils.c  MoreMath.c  RNGGauss.c  RNGGamma.c  RNGChi2.c
+
+	and run it without arguments. For every parameter value it prints nanoseconds per
+	deviate for the algorithm the objects used before Marsaglia-Tsang was added (legacy)
+	and for the one they use now, followed by the sample mean and variance of the current
+	generator next to the exact values. Each timing is the best of kReps runs of kCount
+	deviates; expect run-to-run noise of 10-15%.
+
+	The "legacy" column for stu is omitted. The old dof >= 4 code produced t(3) deviates,
+	so timing it says nothing useful.
+
+ ******************************************************************************************/
+
+#pragma mark • Include Files
+
+#include <stdio.h>
+#include <time.h>
+
+#include "Taus88.h"
+#include "RNGGauss.h"
+#include "RNGGamma.h"
+#include "RNGChi2.h"
+
+
+#pragma mark • Constants
+
+enum {
+	kCount	= 1000000,
+	kReps	= 7
+	};
+
+
+#pragma mark • Type Definitions
+
+typedef double (*tBenchFunc)(void*);
+
+typedef struct {
+	double	alpha;
+	eGammaAlg	alg;
+	union	{
+			tGammaGDParams	gd;
+			tGammaMTParams	mt;
+			} p;
+	} tGammaBench;
+
+typedef struct {
+	UInt32		dof;
+	eChi2Alg	alg;				// Legacy only: algChi2Dir or algChi2Rej
+	double		gamma;
+	tChi2Params	params;				// Current
+	} tChi2Bench;
+
+
+#pragma mark • Static Variables
+
+static tTaus88Data	sTaus;
+
+
+#pragma mark -
+/*****************************  I M P L E M E N T A T I O N  ******************************/
+
+#pragma mark • Timing
+
+	// Best of kReps runs, in nanoseconds per call. Also returns mean and variance of the
+	// last run, so the sanity check costs no extra draws.
+	static double TimeFunc(tBenchFunc iFunc, void* iData, double* oMean, double* oVar)
+		{
+		double	best = 1e300;
+		int		r;
+
+		Taus88Seed(&sTaus, 8191);
+
+		for (r = 0; r < kReps; r += 1) {
+			double	sum		= 0.0,
+					sum2	= 0.0,
+					ns;
+			clock_t	start	= clock();
+			long	i;
+
+			for (i = 0; i < kCount; i += 1) {
+				double x = iFunc(iData);
+				sum += x;
+				sum2 += x * x;
+				}
+
+			ns = (double) (clock() - start) / (double) CLOCKS_PER_SEC * 1e9 / (double) kCount;
+			if (ns < best) best = ns;
+
+			sum /= (double) kCount;
+			*oMean	= sum;
+			*oVar	= sum2 / (double) kCount - sum * sum;
+			}
+
+		return best;
+		}
+
+
+#pragma mark • Gamma
+
+	// What RecommendGammaAlg() returned before algMT was added
+	static eGammaAlg LegacyGammaAlg(double iAlpha)
+		{
+		if (iAlpha == floor(iAlpha)) {
+			if		(iAlpha <= 13.0)				return algErlDir;
+			else if	(iAlpha <= (double) kLongMax)	return algErlRej;
+			else									return algGD;
+			}
+
+		return (iAlpha < 1.0) ? algGS : algGD;
+		}
+
+	static void InitGamma(tGammaBench* oBench, double iAlpha, eGammaAlg iAlg)
+		{
+		oBench->alpha	= iAlpha;
+		oBench->alg		= iAlg;
+
+		if (iAlg == algGD)	CalcGDParams(&oBench->p.gd, iAlpha, 1.0);
+		if (iAlg == algMT)	CalcMTParams(&oBench->p.mt, iAlpha, 1.0);
+		}
+
+	static double NextGamma(tGammaBench* iBench)
+		{
+		double	alpha = iBench->alpha;
+
+		switch (iBench->alg) {
+			case algErlDir:	return GerErlangDirTaus88((UInt32) alpha, 1.0, &sTaus);
+			case algErlRej:	return GenErlangRejTaus88(	(UInt32) alpha, 1.0,
+														CalcErlangRejGamma((UInt32) alpha),
+														&sTaus);
+			case algGS:		return GenGammaGSTaus88(alpha, 1.0, CalcGSGamma(alpha), &sTaus);
+			case algGD:		return GenGammaGDTaus88(&iBench->p.gd, &sTaus);
+			case algMT:		return GenGammaMTTaus88(&iBench->p.mt, &sTaus);
+			default:		return 0.0;
+			}
+		}
+
+static void
+BenchGamma(void)
+
+	{
+	const double kAlphas[] = {0.3, 0.7, 1.5, 2.5, 4.0, 8.0, 13.0, 20.0, 50.0, 1000.0};
+
+	int	i;
+
+	printf("gammer (Gamma(alpha, 1))\n");
+	printf("  alpha     ns old   ns new        mean    exact        var    exact\n");
+
+	for (i = 0; i < sizeof(kAlphas) / sizeof(kAlphas[0]); i += 1) {
+		double		alpha = kAlphas[i],
+					mean, var, tOld, tNew;
+		tGammaBench	bench;
+
+		InitGamma(&bench, alpha, LegacyGammaAlg(alpha));
+		tOld = TimeFunc((tBenchFunc) NextGamma, &bench, &mean, &var);
+		InitGamma(&bench, alpha, RecommendGammaAlg(alpha));
+		tNew = TimeFunc((tBenchFunc) NextGamma, &bench, &mean, &var);
+
+		printf("  %7.1f   %6.1f   %6.1f      %8.3f %8.3f   %8.3f %8.3f\n",
+				alpha, tOld, tNew, mean, alpha, var, alpha);
+		}
+
+	}
+
+
+#pragma mark • Chi-Square, F, t
+
+	static void InitChi2(tChi2Bench* oBench, UInt32 iDoF)
+		{
+		oBench->dof		= iDoF;
+		oBench->alg		= (iDoF <= 26) ? algChi2Dir : algChi2Rej;	// Legacy choice
+		oBench->gamma	= CalcChi2RejGamma(iDoF);
+		CalcChi2Params(&oBench->params, iDoF);
+		}
+
+	static double LegacyChi2(tChi2Bench* iBench)
+		{
+		return (iBench->alg == algChi2Dir)
+				? GenChi2DirTaus88(iBench->dof, &sTaus)
+				: GenChi2RejTaus88(iBench->dof, iBench->gamma, &sTaus);
+		}
+
+	static double CurrentChi2(tChi2Bench* iBench)
+		{ return GenChi2Taus88(&iBench->params, &sTaus); }
+
+	static double LegacyF(tChi2Bench iBench[])
+		{
+		return (LegacyChi2(&iBench[0]) / (double) iBench[0].dof)
+				/ (LegacyChi2(&iBench[1]) / (double) iBench[1].dof);
+		}
+
+	static double CurrentF(tChi2Bench iBench[])
+		{
+		return (CurrentChi2(&iBench[0]) / (double) iBench[0].dof)
+				/ (CurrentChi2(&iBench[1]) / (double) iBench[1].dof);
+		}
+
+	static double CurrentT(tGammaMTParams* iChi2)
+		{ return NormalKRTaus88(&sTaus) / sqrt(GenGammaMTTaus88(iChi2, &sTaus)); }
+
+static void
+BenchChi2(void)
+
+	{
+	const UInt32	kDoFs[]		= {1, 3, 15, 26, 27, 40, 1000},
+					kFDoFs[][2]	= {{10, 20}, {30, 40}, {100, 100}},
+					kTDoFs[]	= {4, 10, 30, 1000};
+
+	int	i;
+
+	printf("\nchichi (Chi-square(dof))\n");
+	printf("  dof       ns old   ns new        mean    exact        var    exact\n");
+	for (i = 0; i < sizeof(kDoFs) / sizeof(kDoFs[0]); i += 1) {
+		double		mean, var, tOld, tNew,
+					dof = kDoFs[i];
+		tChi2Bench	bench;
+
+		InitChi2(&bench, kDoFs[i]);
+		tOld = TimeFunc((tBenchFunc) LegacyChi2, &bench, &mean, &var);
+		tNew = TimeFunc((tBenchFunc) CurrentChi2, &bench, &mean, &var);
+
+		printf("  %7lu   %6.1f   %6.1f      %8.3f %8.3f   %8.3f %8.3f\n",
+				(unsigned long) kDoFs[i], tOld, tNew, mean, dof, var, dof + dof);
+		}
+
+	printf("\nfishie (F(dof1, dof2))\n");
+	printf("  dofs      ns old   ns new        mean    exact        var    exact\n");
+	for (i = 0; i < sizeof(kFDoFs) / sizeof(kFDoFs[0]); i += 1) {
+		double		mean, var, tOld, tNew,
+					d1 = kFDoFs[i][0],
+					d2 = kFDoFs[i][1],
+					exMean	= d2 / (d2 - 2.0),
+					exVar	= 2.0 * d2 * d2 * (d1 + d2 - 2.0)
+								/ (d1 * (d2 - 2.0) * (d2 - 2.0) * (d2 - 4.0));
+		tChi2Bench	bench[2];
+
+		InitChi2(&bench[0], kFDoFs[i][0]);
+		InitChi2(&bench[1], kFDoFs[i][1]);
+		tOld = TimeFunc((tBenchFunc) LegacyF, bench, &mean, &var);
+		tNew = TimeFunc((tBenchFunc) CurrentF, bench, &mean, &var);
+
+		printf("  %3lu,%-3lu   %6.1f   %6.1f      %8.3f %8.3f   %8.3f %8.3f\n",
+				(unsigned long) kFDoFs[i][0], (unsigned long) kFDoFs[i][1],
+				tOld, tNew, mean, exMean, var, exVar);
+		}
+
+	printf("\nstu (t(dof), dof >= 4)\n");
+	printf("  dof                ns new        mean    exact        var    exact\n");
+	for (i = 0; i < sizeof(kTDoFs) / sizeof(kTDoFs[0]); i += 1) {
+		double			mean, var, tNew,
+						dof = kTDoFs[i];
+		tGammaMTParams	chi2;
+
+		CalcMTParams(&chi2, 0.5 * dof, 2.0 / dof);
+		tNew = TimeFunc((tBenchFunc) CurrentT, &chi2, &mean, &var);
+
+		printf("  %7lu            %6.1f      %8.3f %8.3f   %8.3f %8.3f\n",
+				(unsigned long) kTDoFs[i], tNew, mean, 0.0, var, dof / (dof - 2.0));
+		}
+
+	}
+
+
+#pragma mark -
+#pragma mark • Main
+
+int
+main(void)
+
+	{
+	BenchGamma();
+	BenchChi2();
+
+	return 0;
+	}
@@ -0,0 +1,187 @@
+/*
+	File:		JulieDriftCheck.c
+
+	Contains:	Command-line check that lbj.julie's interlaced re-render converges on the
+				full render for the current c.
+
+	Written by:	Peter Castine
+
+	Copyright:	© 2026 Peter Castine
+
+	Change History (most recent first):
+
+*/
+
+
+/******************************************************************************************
+
+	Not part of any external. Build it as a command-line tool with the same prefix header
+	and search paths as lbj.julie (it only needs Jitter/julie.h) and run it without
+	arguments. Exit status is zero if all checks pass.
+
+	The scheduling is the real DriftPlan() from julie.h. The pixels come from a plain
+	escape-count loop rather than lbj.julie's lane kernels; what is checked here is which
+	rows get drawn at which c, not the kernels themselves.
+
+	Each scenario starts from a full render at kC0, then moves c by less than the drift
+	radius and renders frames as lbj.julie would. After the move frame and interlace - 1
+	more frames with c fixed, the cache must equal a full render at the new c, and the
+	next frame must be skipped.
+
+ ******************************************************************************************/
+
+#pragma mark • Include Files
+
+#include <stdio.h>
+#include <string.h>
+
+#include "julie.h"
+
+
+#pragma mark • Constants
+
+enum {
+	kCols		= 64,
+	kRows		= 48,
+	kIter		= 64
+	};
+
+static const double	kC0[2]		= {-0.8, 0.156},
+					kC1[2]		= {-0.79, 0.16},
+					kC2[2]		= {-0.785, 0.158},
+					kDrift		= 0.05;
+
+
+#pragma mark • Static Variables
+
+static float	sCache[kRows][kCols],
+				sFull[kRows][kCols];
+static int		sFailures = 0;
+
+
+#pragma mark -
+/*****************************  I M P L E M E N T A T I O N  ******************************/
+
+#pragma mark • Rendering
+
+	static float Pixel(const double iC[2], long iRow, long iCol)
+		{
+		double	x = -1.6 + 3.2 * (double) iCol / (double) (kCols - 1),
+				y = 1.2 - 2.4 * (double) iRow / (double) (kRows - 1);
+		int		n;
+
+		for (n = 0; n < kIter && x * x + y * y <= 4.0; n += 1) {
+			double xx = x * x - y * y + iC[0];
+			y = 2.0 * x * y + iC[1];
+			x = xx;
+			}
+
+		return (float) n / (float) kIter;
+		}
+
+	static void Render(float oCache[kRows][kCols], const double iC[2], long iInterlace, long iPhase)
+		{
+		long row, col;
+
+		for (row = 0; row < kRows; row += 1) {
+			if (row % iInterlace != iPhase)
+				continue;
+			for (col = 0; col < kCols; col += 1)
+				oCache[row][col] = Pixel(iC, row, col);
+			}
+		}
+
+	// One frame as JulieJitMatrixCalc() runs it. Returns what DriftPlan() decided.
+	static long Frame(tDriftState* ioState, const double iC[2], long iInterlace)
+		{
+		long	phase,
+				plan = DriftPlan(ioState, iC, kDrift, iInterlace, true, &phase);
+
+		if (plan > 0)
+			Render(sCache, iC, plan, phase);
+
+		return plan;
+		}
+
+
+#pragma mark • Checks
+
+	static void Expect(int iOK, const char* iWhat, long iInterlace)
+		{
+		printf("  interlace %ld: %-48s %s\n", iInterlace, iWhat, iOK ? "ok" : "FAILED");
+		if (!iOK) sFailures += 1;
+		}
+
+	static void Start(tDriftState* oState, long iInterlace)
+		{
+		long phase;
+
+		memset(oState, 0, sizeof(*oState));
+		DriftPlan(oState, kC0, kDrift, iInterlace, false, &phase);	// Cache not yet valid
+		Render(sCache, kC0, 1, 0);
+		}
+
+static void
+CheckOneMove(
+	long	iInterlace)
+
+	{
+	tDriftState	state;
+	long		i;
+	int			partial = 1;
+
+	Start(&state, iInterlace);
+
+	partial &= (Frame(&state, kC1, iInterlace) == iInterlace);		// The move
+	for (i = 1; i < iInterlace; i += 1)								// c fixed
+		partial &= (Frame(&state, kC1, iInterlace) == iInterlace);
+
+	Render(sFull, kC1, 1, 0);
+	Expect(partial, "all frames after a small move are partial", iInterlace);
+	Expect(memcmp(sCache, sFull, sizeof sFull) == 0, "cache matches full render", iInterlace);
+	Expect(Frame(&state, kC1, iInterlace) == 0, "next frame is skipped", iInterlace);
+	}
+
+static void
+CheckMoveMidCycle(
+	long	iInterlace)
+
+	{
+	tDriftState	state;
+	long		i;
+
+	Start(&state, iInterlace);
+
+	Frame(&state, kC1, iInterlace);
+	Frame(&state, kC2, iInterlace);									// Move again
+	for (i = 1; i < iInterlace; i += 1)
+		Frame(&state, kC2, iInterlace);
+
+	Render(sFull, kC2, 1, 0);
+	Expect(memcmp(sCache, sFull, sizeof sFull) == 0, "second move mid-cycle: cache matches", iInterlace);
+	Expect(Frame(&state, kC2, iInterlace) == 0, "second move mid-cycle: then skipped", iInterlace);
+	}
+
+
+#pragma mark -
+#pragma mark • Main
+
+int
+main(void)
+
+	{
+	const long kInterlaces[] = {2, 3, 4, 7};
+
+	int i;
+
+	printf("lbj.julie drift re-render (%d x %d)\n", kCols, kRows);
+
+	for (i = 0; i < sizeof(kInterlaces) / sizeof(kInterlaces[0]); i += 1) {
+		CheckOneMove(kInterlaces[i]);
+		CheckMoveMidCycle(kInterlaces[i]);
+		}
+
+	printf("%s\n", sFailures ? "FAILED" : "all checks passed");
+
+	return sFailures != 0;
+	}
@@ -62,6 +62,10 @@ enum {
 	strIndexOutLeft		= strIndexTheOutlet
 	};
 
+enum {
+	kMaxVoices			= 32					// Chaos bank: most maps per object
+	};
+
 
 #pragma mark • Type Definitions
 
@@ -73,6 +77,10 @@ typedef struct {
 	t_pxobject		coreObject;
 	
 	double			curVal;
+	
+	long			voices;						// More than one for a chaos bank
+	double			bankVal[kMaxVoices];		// Current value of each voice
+	tSampleVector	outSigs[kMaxVoices];		// 32-bit bank chain
 	} tPink;
 
 
@@ -83,9 +91,10 @@ typedef struct {
 #pragma mark • Function Prototypes
 
 	// Class message functions
-void*	CCCNew(void);
+void*	CCCNew(long);
 
 	// Object message functions
+static void CCCSeeds(tPink*, Symbol*, short, Atom*);
 static void CCCTattle(tPink*);
 static void	CCCAssist(tPink*, void* , long , long , char*);
 static void	CCCInfo(tPink*);
@@ -93,6 +102,10 @@ static void	CCCInfo(tPink*);
 	// MSP Messages
 static void	BuildDSPChain(tPink*, t_signal**, short*);
 static int*	PerformPink(int*);
+static int*	PerformPinkBank(int*);
+static void	PinkBank(tPink*, long, Boolean, void*[]);
+static void	BuildDSPChain64(tPink*, t_object*, short*, double, long, long);
+static void	PerformPink64(tPink*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -124,12 +137,13 @@ main(void)
 			(method) dsp_free,			// Default deallocation function
 			sizeof(tPink),				// Class object size
 			NIL,						// No menu function
-			A_NOTHING,					// No arguments
+			A_DEFLONG,					// Optional: number of voices
 			0);		
 	
 	dsp_initclass();
 	
 	// Messages
+	addmess	((method) CCCSeeds,		"seeds",	A_GIMME, 0);
 	addmess	((method) CCCTattle,	"dblclick",	A_CANT, 0);
 	addmess	((method) CCCTattle,	"tattle",	A_NOTHING);
 	addmess	((method) CCCAssist,	"assist",	A_CANT, 0);
@@ -137,6 +151,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) BuildDSPChain, "dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) BuildDSPChain64, "dsp64",		A_CANT, 0);
 
 	// Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -151,25 +166,35 @@ main(void)
 
 /******************************************************************************************
  *
- *	CCCNew(iNN)
+ *	CCCNew(iVoices)
  *	
- *	Arguments: nn factor.
+ *	Arguments: number of voices. More than one makes a chaos bank of independent maps,
+ *	each with its own outlet.
  *
  ******************************************************************************************/
 
 void*
-CCCNew(void)
+CCCNew(
+	long iVoices)
 	
 	{
 	tPink*	me	= NIL;
+	long	i;
+	
+	if (iVoices < 1)				iVoices = 1;
+	else if (iVoices > kMaxVoices)	iVoices = kMaxVoices;
 	
 	// Let Max/MSP allocate us, our inlets, and outlets.
 	me = (tPink*) newobject(gObjectClass);
 	dsp_setup(&(me->coreObject), 1);				// Signal inlet for benefit of begin~
-	outlet_new(me, "signal");
+	for (i = 0; i < iVoices; i += 1)
+		outlet_new(me, "signal");
 	
 	// Set up object components
 	me->curVal = ULong2Unit_zo(MachineKharma());
+	me->voices = iVoices;
+	for (i = 0; i < iVoices; i += 1)
+		me->bankVal[i] = ULong2Unit_zo(MachineKharma());
 
 	return me;
 	}
@@ -177,6 +202,47 @@ CCCNew(void)
 #pragma mark -
 #pragma mark • Object Message Handlers
 
+/******************************************************************************************
+ *
+ *	CCCSeeds(me, sym, iArgC, iArgV)
+ *
+ *	Set the current value of each voice, in outlet order. Values are wrapped into the
+ *	unit interval; voices without a value are left alone.
+ *
+ ******************************************************************************************/
+
+void
+CCCSeeds(
+	tPink*	me,
+	Symbol*	sym,
+	short	iArgC,
+	Atom*	iArgV)
+	
+	{
+	#pragma unused(sym)
+	
+	long i;
+	
+	if (iArgC > me->voices)
+		iArgC = me->voices;
+	
+	for (i = 0; i < iArgC; i += 1) {
+		double x;
+		
+		if ( !ParseAtom(iArgV + i, false, true, 0, NIL, kClassName) )
+			continue;
+		
+		x = iArgV[i].a_w.w_float;
+		x -= floor(x);
+		
+		if (i == 0)
+			me->curVal = x;
+		me->bankVal[i] = x;
+		}
+	
+	}
+
+
 /******************************************************************************************
  *
  *	CCCTattle(me)
@@ -191,7 +257,15 @@ CCCTattle(
 	
 	{
 	post("%s state", kClassName);
-	post("  CurVal: %lf", me->curVal);
+	
+	if (me->voices > 1) {
+		long i;
+		
+		post("  Chaos bank with %ld voices", me->voices);
+		for (i = 0; i < me->voices; i += 1)
+			post("    %ld: %lf", i + 1, me->bankVal[i]);
+		}
+	else post("  CurVal: %lf", me->curVal);
 	}
 
 
@@ -240,6 +314,16 @@ BuildDSPChain(
 		outletPink
 		};
 	
+	if (me->voices > 1) {
+		long i;
+		
+		for (i = 0; i < me->voices; i += 1)
+			me->outSigs[i] = ioDSPVectors[outletPink + i]->s_vec;
+		
+		dsp_add(PerformPinkBank, 2, me, (long) ioDSPVectors[outletPink]->s_n);
+		return;
+		}
+	
 	dsp_add(
 		PerformPink, 3,
 		me, (long) ioDSPVectors[outletPink]->s_n, ioDSPVectors[outletPink]->s_vec
@@ -310,3 +394,149 @@ PerformPink(
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	BuildDSPChain64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	PerformPink64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. The map runs in double precision anyway, so here the
+ *	output is no longer rounded to float at every sample.
+ *
+ ******************************************************************************************/
+
+void
+BuildDSPChain64(
+	tPink*		me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) PerformPink64, 0, NIL);
+	}
+
+void
+PerformPink64(
+	tPink*		me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iIns, iInCount, iOutCount, iFlags, iUser)
+	
+	const double kMinPink = 1.0 / 525288.0;
+	
+	tSampleVector64	outNoise	= iOuts[0];
+	double			curVal		= me->curVal;
+	
+	if (me->coreObject.z_disabled) return;
+	
+	if (me->voices > 1) {
+		PinkBank(me, iVectorSize, true, (void**) iOuts);
+		return;
+		}
+	
+	// Same sanity check as in PerformPink()
+	if (curVal <= kMinPink) {
+		if (curVal == 0.0)	curVal  = kMinPink;
+		else				curVal += curVal;
+		}
+	
+	while (iVectorSize-- > 0) {
+		curVal = curVal * curVal + curVal;
+		if (curVal >= 1.0)
+			curVal -= 1.0;
+		
+		*outNoise++ = curVal;
+		}
+	
+	me->curVal	= curVal;
+	}
+
+
+/******************************************************************************************
+ *
+ *	PinkBank(me, iVecSize, iDouble, oVoices)
+ *	PerformPinkBank(iParams)
+ *
+ *	Chaos bank: me->voices independent copies of the map, one per outlet. Each voice on
+ *	its own is as serial as ever, but one step of all voices is a single pass over the
+ *	bankVal[] array (with the wrap-around written as a select), which the compiler can
+ *	vectorize. iDouble is a constant: true for the 64-bit chain.
+ *
+ *	The parameter block for PerformPinkBank() only has the object and the vector size;
+ *	BuildDSPChain() stores the output vectors in the object.
+ *
+ ******************************************************************************************/
+
+static void
+PinkBank(
+	tPink*	me,
+	long	iVecSize,
+	Boolean	iDouble,
+	void*	oVoices[])
+	
+	{
+	const double	kMinPink = 1.0 / 525288.0;
+	const long		voices	= me->voices;
+	
+	double*	val = me->bankVal;
+	long	i, j;
+	
+	// Same sanity check as in PerformPink(), voice by voice
+	for (j = 0; j < voices; j += 1) {
+		if (val[j] <= kMinPink) {
+			if (val[j] == 0.0)	val[j]  = kMinPink;
+			else				val[j] += val[j];
+			}
+		}
+	
+	for (i = 0; i < iVecSize; i += 1) {
+		for (j = 0; j < voices; j += 1) {
+			double x = val[j] * val[j] + val[j];
+			
+			val[j] = (x >= 1.0) ? x - 1.0 : x;
+			}
+		
+		if (iDouble)
+			for (j = 0; j < voices; j += 1) ((double*) oVoices[j])[i] = val[j];
+		else
+			for (j = 0; j < voices; j += 1) ((float*) oVoices[j])[i] = val[j];
+		}
+	
+	}
+
+int*
+PerformPinkBank(
+	int* iParams)
+	
+	{
+	enum {
+		paramFuncAddress	= 0,
+		paramMe,
+		paramVectorSize,
+		
+		paramNextLink
+		};
+	
+	tPink* me = (tPink*) iParams[paramMe];
+	
+	if (me->coreObject.z_disabled) goto exit;
+	
+	PinkBank(me, (long) iParams[paramVectorSize], false, (void**) me->outSigs);
+	
+exit:
+	return iParams + paramNextLink;
+	}
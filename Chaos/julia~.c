@@ -63,6 +63,14 @@ enum {
 	outletImag
 	};
 
+	// Flags for connected parameter inlets, passed to the 64-bit perform method
+enum {
+	connZ0Real		= 1 << inletZ0Real,
+	connZ0Imag		= 1 << inletZ0Imag,
+	connCReal		= 1 << inletCReal,
+	connCImag		= 1 << inletCImag
+	};
+
 #pragma mark • Type Definitions
 
 
@@ -100,6 +108,8 @@ static void	DoInfo(tJulie*);
 static void	BuildDSPChain(tJulie*, t_signal**, short*);
 static int*	PerformJulieDynamic(int*);
 static int*	PerformJulieStatic(int*);
+static void	BuildDSPChain64(tJulie*, t_object*, short*, double, long, long);
+static void	PerformJulie64(tJulie*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -150,6 +160,7 @@ main(void)
 	
 	// MSP-Level messages
 	addmess	((method) BuildDSPChain, "dsp",	A_CANT, 0);
+	addmess	((method) BuildDSPChain64, "dsp64", A_CANT, 0);
 
 	// Initialize LitterLit
 	LitterInit(kClassName, 0);
@@ -530,3 +541,96 @@ PerformJulieDynamic(
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	BuildDSPChain64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	PerformJulie64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit chain. There is only one perform method; it is told which parameter
+ *	inlets have signals connected. If none do we drop down to the tighter static loop.
+ *
+ ******************************************************************************************/
+
+void
+BuildDSPChain64(
+	tJulie*		me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iSampleRate, iMaxVectorSize, iFlags)
+	
+	long	conn = 0;
+	
+	if (iConnectCounts[outletReal] == 0 && iConnectCounts[outletImag] == 0)
+		return;
+	
+	if (iConnectCounts[inletZ0Real] > 0)	conn |= connZ0Real;
+	if (iConnectCounts[inletZ0Imag] > 0)	conn |= connZ0Imag;
+	if (iConnectCounts[inletCReal] > 0)		conn |= connCReal;
+	if (iConnectCounts[inletCImag] > 0)		conn |= connCImag;
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) PerformJulie64, 0, (void*) conn);
+	}
+
+
+void
+PerformJulie64(
+	tJulie*		me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iInCount, iOutCount, iFlags)
+	
+	long		conn	= (long) iUser;
+	double*		outReal	= iOuts[0];
+	double*		outImag	= iOuts[1];
+	double		zReal	= me->zReal,
+				zImag	= me->zImag,
+				cReal	= me->cReal,
+				cImag	= me->cImag;
+	
+	if (me->coreObject.z_disabled) return;
+	
+	if (conn == 0) {
+		while (iVectorSize-- > 0) {
+			double	r	= zReal,
+					i	= zImag;
+			
+			*outReal++ = zReal = r * r - i * i + cReal;
+			*outImag++ = zImag = 2 * r * i + cImag;
+			}
+		}
+	
+	else {
+		double*	inZReal	= (conn & connZ0Real)	? iIns[inletZ0Real]	: NIL;
+		double*	inZImag	= (conn & connZ0Imag)	? iIns[inletZ0Imag]	: NIL;
+		double*	inCReal	= (conn & connCReal)	? iIns[inletCReal]	: NIL;
+		double*	inCImag	= (conn & connCImag)	? iIns[inletCImag]	: NIL;
+		
+		while (iVectorSize-- > 0) {
+			double	r	= inZReal ? *inZReal++ : zReal,
+					i	= inZImag ? *inZImag++ : zImag,
+					cr	= inCReal ? *inCReal++ : cReal,
+					ci	= inCImag ? *inCImag++ : cImag;
+			
+			*outReal++ = zReal = r * r - i * i + cr;
+			*outImag++ = zImag = 2 * r * i + ci;
+			}
+		}
+	
+	me->zReal = zReal;
+	me->zImag = zImag;
+	}
@@ -112,12 +112,17 @@ const char*		kFuncNames[fnLast + 1]
 typedef enum Function tFunction;
 
 typedef double (*tLatooFunc)(double);
+
+	// Kernels run the iteration for a number of steps, writing to double-precision
+	// x and y vectors
+struct fiana;
+typedef void (*tLatooKernel)(struct fiana*, long, double[], double[]);
 	
 
 
 #pragma mark • Object Structure
 
-typedef struct {
+typedef struct fiana {
 	t_pxobject		coreObject;
 	
 	double			x0,	y0,						// Initial coordinates
@@ -125,9 +130,11 @@ typedef struct {
 					a, b, c, d;					// Parameters
 
 	tFunction		fnA, fnB, fnC, fnD;			// Functions
+	tLatooKernel	kernel;						// Chosen by SelectKernel()
 	
 	Boolean			autoParam,
-					autoSeed;
+					autoSeed,
+					fast;						// Use polynomial approximations
 	} tfiana;
 
 
@@ -149,6 +156,7 @@ static void DoSeed(tfiana*, Symbol*, short, Atom*);		// List message is specific
 														// new initial coordinate
 static void DoSet(tfiana*, double, double);
 static void DoReset(tfiana*);
+static void DoAccuracy(tfiana*, Symbol*);
 
 	// Set functions (inlet 0 ==> global, else a specific slot
 static void	DoIdent(tfiana*);
@@ -177,6 +185,8 @@ static void	DoInfo(tfiana*);
 
 static void DoDSP(tfiana*, t_signal**, short*);
 static int* Performfiana(int*);
+static void DoDSP64(tfiana*, t_object*, short*, double, long, long);
+static void Performfiana64(tfiana*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -184,6 +194,147 @@ static int* Performfiana(int*);
 
 #pragma mark • Inline Functions
 
+	// Polynomial approximations used when accuracy is set to fast. There are no branches
+	// (other than selects) and no table lookups, so the four function evaluations in
+	// one step of the iteration can run side by side in vector registers.
+	// Maximum absolute error is around 1e-15 for sin, cos, sinpi, cospi, and tanh, and
+	// relative error for exp is similar for moderate arguments. This is plenty for a
+	// chaotic generator (any difference gets amplified anyway), but the trajectories
+	// will not be identical to those produced with the exact (libm) functions.
+	
+	// Adding and subtracting 1.5 * 2^52 rounds a double to the nearest integer, and
+	// leaves the integer in the low bits of the sum
+#define kRoundMagic		6755399441055744.0
+#define kRoundMagicBits	0x4338000000000000ULL
+#define kInvPi			0.31830988618379067154			// 1 / pi
+
+typedef union {
+	double	f;
+	UInt64	i;
+	} tDoubleBits;
+
+	// sin(pi * t). Reduce to r = t - k, |r| <= 1/2, and flip the sign if k is odd.
+static inline double
+FastSinPi(double t)
+	{
+	const double	kTooBig	= 2251799813685248.0;			// 2^51: t is (as good as) an integer
+	
+	tDoubleBits	k,
+				result;
+	double		r, s, p;
+	
+	k.f	= t + kRoundMagic;
+	r	= t - (k.f - kRoundMagic);
+	r	= (fabs(t) < kTooBig) ? r : 0.0;
+	s	= r * r;
+	
+	p =			 -2.1132685303291125e-05;
+	p = p * s +	  4.659865987221153e-04;
+	p = p * s +	 -7.370364368004046e-03;
+	p = p * s +	  8.214587886696838e-02;
+	p = p * s +	 -5.992645288352979e-01;
+	p = p * s +	  2.550164039862674;
+	p = p * s +	 -5.16771278004981;
+	p = p * s +	  3.141592653589793;
+	
+	result.f  = p * r;
+	result.i ^= k.i << 63;
+	
+	return result.f;
+	}
+
+static inline double FastCosPi(double t)
+	{ return FastSinPi(t + 0.5); }
+
+static inline double FastSin(double x)
+	{ return FastSinPi(x * kInvPi); }
+
+static inline double FastCos(double x)
+	{ return FastSinPi(x * kInvPi + 0.5); }
+
+	// e^x = 2^k * 2^f, k integer, |f| <= 1/2
+static inline double
+FastExp(double x)
+	{
+	const double	kLog2e	= 1.4426950408889634,
+					kMaxArg	= 1024.0,
+					kMinArg	= -1075.0;
+	
+	tDoubleBits	k,
+				scale;
+	double		t = x * kLog2e,
+				tc, f, p;
+	
+	tc	= (t > 1023.0) ? 1023.0 : t;
+	tc	= (tc < -1022.0) ? -1022.0 : tc;
+	k.f	= tc + kRoundMagic;
+	f	= tc - (k.f - kRoundMagic);
+	
+	p =			  4.4344267758808197e-10;
+	p = p * f +	  7.074098251730484e-09;
+	p = p * f +	  1.0178203873796574e-07;
+	p = p * f +	  1.3215433135594994e-06;
+	p = p * f +	  1.5252733475459238e-05;
+	p = p * f +	  1.540353046241424e-04;
+	p = p * f +	  1.3333558146805672e-03;
+	p = p * f +	  9.618129107588424e-03;
+	p = p * f +	  5.5504108664819855e-02;
+	p = p * f +	  2.4022650695910155e-01;
+	p = p * f +	  6.931471805599453e-01;
+	p = p * f +	  1.0;
+	
+	scale.i = (k.i - kRoundMagicBits + 1023) << 52;
+	p *= scale.f;
+	
+	// Out of range: overflow to infinity, underflow to zero, as exp() would
+	p = (t > kMaxArg) ? HUGE_VAL : p;
+	p = (t < kMinArg) ? 0.0 : p;
+	
+	return p;
+	}
+
+static inline double
+FastTanh(double x)
+	{
+	double e = FastExp(-2.0 * fabs(x));
+	
+	return copysign((1.0 - e) / (1.0 + e), x);
+	}
+
+	// All the functions in one place. With a constant iFunc and iFast the switch
+	// folds away, leaving the function itself inlined into the kernel.
+	// The exact versions are the same expressions the function pointers used to evaluate,
+	// so results are bit-identical.
+static inline double
+EvalFunc(
+	tFunction	iFunc,
+	Boolean		iFast,
+	double		t)
+	
+	{
+	switch (iFunc) {
+		case fnZero:	return 0.0;
+		case fnOne:		return 1.0;
+		case fnRecip:	return 1.0 / t;
+		case fnSin:		return iFast ? FastSin(t) : sin(t);
+		case fnCos:		return iFast ? FastCos(t) : cos(t);
+		case fnTan:		return tan(t);
+		case fnCot:		return 1.0 / tan(t);
+		case fnSinPi:	return iFast ? FastSinPi(t) : sin(kPi * t);
+		case fnCosPi:	return iFast ? FastCosPi(t) : cos(kPi * t);
+		case fnTanPi:	return tan(kPi * t);
+		case fnCotPi:	return 1.0 / tan(kPi * t);
+		case fnSinh:	return sinh(t);
+		case fnCosh:	return cosh(t);
+		case fnTanh:	return iFast ? FastTanh(t) : tanh(t);
+		case fnLog:		return log(t);
+		case fnExp:		return iFast ? FastExp(t) : exp(t);
+		case fnSqr:		return t * t;
+		case fnRoot:	return sqrt(t);
+		default:		return t;									// fnIdent
+		}
+	}
+
 
 #pragma mark -
 
@@ -220,6 +371,7 @@ main(void*)				// Parameter is obsolete (68k legacy)
 	addmess	((method) DoSeed,	"list",		A_GIMME, 0);
 	addmess	((method) DoSet,	"set",		A_FLOAT, A_FLOAT, 0);
 	addmess	((method) DoReset,	"reset",	A_NOTHING);
+	addmess	((method) DoAccuracy, "accuracy", A_SYM, 0);
 	
 	addmess	((method) DoIdent,	"ident",	A_NOTHING);
 	addmess	((method) DoZero,	"zero",		A_NOTHING);
@@ -248,6 +400,7 @@ main(void*)				// Parameter is obsolete (68k legacy)
 	
 	// MSP messages
 	addmess	((method) DoDSP,	"dsp",		A_CANT, 0);
+	addmess	((method) DoDSP64,	"dsp64",	A_CANT, 0);
 
 	// Initialize Litter Library
 	// Bang message generates random (X0, Y0)
@@ -280,6 +433,178 @@ MapStrToFunction(
 	}
 
 
+/******************************************************************************************
+ *
+ *	IterateUniform(me, iFunc, iFast, iCount, oX, oY)
+ *	IterateMixed(me, iCount, oX, oY)
+ *	SelectKernel(me)
+ *
+ *	The kernels run iCount steps of the iteration, writing x and y to double-precision
+ *	output vectors and updating the current point.
+ *
+ *	When all four slots use the same function (by far the most common case, since the
+ *	first function argument or a function message in the left inlet sets all four),
+ *	there is a kernel specialized for that function with the function inlined. Otherwise
+ *	IterateMixed() calls through the function pointer table.
+ *
+ *	SelectKernel() picks the kernel to use; call it whenever a function or the accuracy
+ *	setting changes.
+ *
+ ******************************************************************************************/
+
+	static double ident(double iVal)	{ return iVal; }
+	static double zero(double)			{ return 0.0; }
+	static double one(double)			{ return 1.0; }
+	static double recip(double iVal)	{ return 1.0 / iVal; }
+	static double cot(double iVal)		{ return 1.0 / tan(iVal); }
+	static double sinpi(double iVal)	{ return sin(kPi * iVal); }
+	static double cospi(double iVal)	{ return cos(kPi * iVal); }
+	static double tanpi(double iVal)	{ return tan(kPi * iVal); }
+	static double cotpi(double iVal)	{ return 1.0 / tan(kPi * iVal); }
+	static double sqr(double iVal)		{ return iVal * iVal; }
+
+	const tLatooFunc kFuncPtr[fnLast + 1] = {
+									ident,	zero,	one,	recip,
+									sin,	cos,	tan,	cot,
+									sinpi,	cospi,	tanpi,	cotpi,
+									sinh,	cosh,	tanh,
+									log,	exp,	sqr,	sqrt };
+	
+	const tLatooFunc kFastFuncPtr[fnLast + 1] = {
+									ident,	zero,	one,	recip,
+									FastSin, FastCos, tan,	cot,
+									FastSinPi, FastCosPi, tanpi, cotpi,
+									sinh,	cosh,	FastTanh,
+									log,	FastExp, sqr,	sqrt };
+
+static inline void
+IterateUniform(
+	tfiana*		me,
+	tFunction	iFunc,
+	Boolean		iFast,
+	long		iCount,
+	double		oX[],
+	double		oY[])
+	
+	{
+	const double	a = me->a,
+					b = me->b,
+					c = me->c,
+					d = me->d;
+	
+	double	x = me->x,
+			y = me->y;
+	long	i;
+	
+	for (i = 0; i < iCount; i += 1) {
+		double	fa = EvalFunc(iFunc, iFast, a*y),
+				fb = EvalFunc(iFunc, iFast, a*x),
+				fc = EvalFunc(iFunc, iFast, b*x),
+				fd = EvalFunc(iFunc, iFast, b*y);
+		
+		oX[i] = x = fa + c * fb;
+		oY[i] = y = fc + d * fd;
+		}
+	
+	me->x = x;
+	me->y = y;
+	}
+
+static void
+IterateMixed(
+	tfiana*	me,
+	long	iCount,
+	double	oX[],
+	double	oY[])
+	
+	{
+	const tLatooFunc*	table = me->fast ? kFastFuncPtr : kFuncPtr;
+	const tLatooFunc	fnA = table[me->fnA],
+						fnB = table[me->fnB],
+						fnC = table[me->fnC],
+						fnD = table[me->fnD];
+	const double		a = me->a,
+						b = me->b,
+						c = me->c,
+						d = me->d;
+	
+	double	x = me->x,
+			y = me->y;
+	long	i;
+	
+	for (i = 0; i < iCount; i += 1) {
+		double xx = fnA(a*y) + c * fnB(a*x);
+		
+		oY[i] = y = fnC(b*x) + d * fnD(b*y);
+		oX[i] = x = xx;
+		}
+	
+	me->x = x;
+	me->y = y;
+	}
+
+#define DefineUniformKernels(FUNC)															\
+	static void Iterate_##FUNC(tfiana* me, long n, double oX[], double oY[])				\
+		{ IterateUniform(me, FUNC, false, n, oX, oY); }										\
+	static void IterateFast_##FUNC(tfiana* me, long n, double oX[], double oY[])			\
+		{ IterateUniform(me, FUNC, true, n, oX, oY); }
+
+DefineUniformKernels(fnIdent)
+DefineUniformKernels(fnZero)
+DefineUniformKernels(fnOne)
+DefineUniformKernels(fnRecip)
+DefineUniformKernels(fnSin)
+DefineUniformKernels(fnCos)
+DefineUniformKernels(fnTan)
+DefineUniformKernels(fnCot)
+DefineUniformKernels(fnSinPi)
+DefineUniformKernels(fnCosPi)
+DefineUniformKernels(fnTanPi)
+DefineUniformKernels(fnCotPi)
+DefineUniformKernels(fnSinh)
+DefineUniformKernels(fnCosh)
+DefineUniformKernels(fnTanh)
+DefineUniformKernels(fnLog)
+DefineUniformKernels(fnExp)
+DefineUniformKernels(fnSqr)
+DefineUniformKernels(fnRoot)
+
+#define UniformKernelPair(FUNC)		{ Iterate_##FUNC, IterateFast_##FUNC }
+
+	// Indexed by function and fast flag
+static const tLatooKernel kUniformKernels[fnLast + 1][2] = {
+									UniformKernelPair(fnIdent),
+									UniformKernelPair(fnZero),
+									UniformKernelPair(fnOne),
+									UniformKernelPair(fnRecip),
+									UniformKernelPair(fnSin),
+									UniformKernelPair(fnCos),
+									UniformKernelPair(fnTan),
+									UniformKernelPair(fnCot),
+									UniformKernelPair(fnSinPi),
+									UniformKernelPair(fnCosPi),
+									UniformKernelPair(fnTanPi),
+									UniformKernelPair(fnCotPi),
+									UniformKernelPair(fnSinh),
+									UniformKernelPair(fnCosh),
+									UniformKernelPair(fnTanh),
+									UniformKernelPair(fnLog),
+									UniformKernelPair(fnExp),
+									UniformKernelPair(fnSqr),
+									UniformKernelPair(fnRoot)
+									};
+
+static void
+SelectKernel(
+	tfiana* me)
+	
+	{
+	me->kernel = (me->fnA == me->fnB && me->fnA == me->fnC && me->fnA == me->fnD)
+					? kUniformKernels[me->fnA][me->fast ? 1 : 0]
+					: IterateMixed;
+	}
+
+
 #pragma mark -
 #pragma mark • Class Message Handlers
 
@@ -348,6 +673,7 @@ Newfiana(
 	me->fnD			= kDefFunc;
 	me->autoParam	= true;
 	me->autoSeed	= true;
+	me->fast		= false;
 	
 	//
 	// Parse and store arguments
@@ -423,6 +749,8 @@ Newfiana(
 			}														// END if ... else
 		}															// END while
 
+	SelectKernel(me);
+	
 	//
 	// All done
 	//
@@ -553,6 +881,36 @@ DoReset(
 	}	
 	
 
+/******************************************************************************************
+ *
+ *	DoAccuracy(me, iSym)
+ *
+ *	"accuracy exact" (the default) evaluates sin, cos, exp, etc. with the math library.
+ *	"accuracy fast" uses polynomial approximations for sin, cos, sinpi, cospi, exp, and
+ *	tanh instead. These are considerably faster, but trajectories will differ.
+ *
+ ******************************************************************************************/
+
+static void
+DoAccuracy(
+	tfiana*	me,
+	Symbol*	iSym)
+	
+	{
+	
+	if (iSym == gensym("fast"))
+		me->fast = true;
+	else if (iSym == gensym("exact"))
+		me->fast = false;
+	else {
+		error("%s: accuracy must be exact or fast", kClassName);
+		return;
+		}
+	
+	SelectKernel(me);
+	}
+	
+
 /******************************************************************************************
  *
  *	Ident(me)
@@ -586,6 +944,8 @@ DoReset(
 				me->fnA = me->fnB = me->fnC = me->fnD = iFunc;
 				break;
 			}
+		
+		SelectKernel(me);
 		}
 
 static void	DoIdent(tfiana* me)		{ SetFunc(me, fnIdent); }
@@ -631,6 +991,7 @@ DoTattle(
 			kFuncNames[me->fnA], me->a, me->b, kFuncNames[me->fnB], me->a);
 	post("    y' = %s(%lf y) + %lf %s(%lf x)",
 			kFuncNames[me->fnC], me->c, me->d, kFuncNames[me->fnD], me->c);
+	post("  Accuracy: %s", me->fast ? "fast" : "exact");
 	
 	}
 
@@ -710,24 +1071,6 @@ DoDSP(
  *
  ******************************************************************************************/
 
-	static double ident(double iVal)	{ return iVal; }
-	static double zero(double)			{ return 0.0; }
-	static double one(double)			{ return 1.0; }
-	static double recip(double iVal)	{ return 1.0 / iVal; }
-	static double cot(double iVal)		{ return 1.0 / tan(iVal); }
-	static double sinpi(double iVal)	{ return sin(kPi * iVal); }
-	static double cospi(double iVal)	{ return cos(kPi * iVal); }
-	static double tanpi(double iVal)	{ return tan(kPi * iVal); }
-	static double cotpi(double iVal)	{ return 1.0 / tan(kPi * iVal); }
-	static double sqr(double iVal)		{ return iVal * iVal; }
-
-	const tLatooFunc kFuncPtr[fnLast + 1] = {
-									ident,	zero,	one,	recip,
-									sin,	cos,	tan,	cot,
-									sinpi,	cospi,	tanpi,	cotpi,
-									sinh,	cosh,	tanh,
-									log,	exp,	sqr,	sqrt };
-	
 static int*
 Performfiana(
 	int* iParams)
@@ -743,43 +1086,92 @@ Performfiana(
 		paramNextLink
 		};
 	
+	enum {
+		kChunk				= 64				// Kernels work on double-precision chunks
+		};
+	
 	tfiana*			me = (tfiana*) iParams[paramMe];
 	long			vecSize;
 	tSampleVector	outX, outY;
-	double			a, b, c, d, x, y;
-	tLatooFunc		fnA, fnB, fnC, fnD;
+	double			chunkX[kChunk],
+					chunkY[kChunk];
 	
 	if (me->coreObject.z_disabled) goto exit;
 	
-	// Copy parameters into registers
 	vecSize	= (long) iParams[paramVectorSize];
 	outX	= (tSampleVector) iParams[paramOutX];
 	outY	= (tSampleVector) iParams[paramOutY];
 	
-	a		= me->a;
-	b		= me->b;
-	c		= me->c;
-	d		= me->d;
-	x		= me->x;
-	y		= me->y;
-	fnA		= kFuncPtr[me->fnA];
-	fnB		= kFuncPtr[me->fnB];
-	fnC		= kFuncPtr[me->fnC];
-	fnD		= kFuncPtr[me->fnD];
-	
-	do {
-		double xx = fnA(a*y) + c * fnB(a*x);
+	while (vecSize > 0) {
+		long	n = (vecSize < kChunk) ? vecSize : kChunk,
+				i;
 		
-		*outY++	= y = fnC(b*x) + d * fnD(b*y);
-		*outX++ = x = xx;
+		me->kernel(me, n, chunkX, chunkY);
 		
-		} while (--vecSize > 0);
-	
-	me->x	= x;
-	me->y	= y;
+		for (i = 0; i < n; i += 1) {
+			outX[i] = chunkX[i];
+			outY[i] = chunkY[i];
+			}
+		
+		outX	+= n;
+		outY	+= n;
+		vecSize	-= n;
+		}
 		
 exit:
 	return iParams + paramNextLink;
 	}
 
 
+/******************************************************************************************
+ *
+ *	DoDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	Performfiana64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	The Max 6 64-bit chain. Signal inlets are ignored here as well; the iteration itself
+ *	is done in double precision anyway, so the kernels can write straight to the output.
+ *
+ ******************************************************************************************/
+
+static void
+DoDSP64(
+	tfiana*		me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iSampleRate, iMaxVectorSize, iFlags)
+	
+	enum {
+		outletX			= 5,
+		outletY
+		};
+	
+	if (iConnectCounts[outletX] == 0 && iConnectCounts[outletY] == 0)
+		return;
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) Performfiana64, 0, NIL);
+	}
+
+static void
+Performfiana64(
+	tfiana*		me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iIns, iInCount, iOutCount, iFlags, iUser)
+	
+	if (me->coreObject.z_disabled) return;
+	
+	me->kernel(me, iVectorSize, iOuts[0], iOuts[1]);
+	}
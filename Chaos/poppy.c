@@ -34,6 +34,7 @@ Previous history:
 
 #include "LitterLib.h"
 #include "TrialPeriodUtils.h"
+#include "Verhulst.h"
 
 #ifdef __MWERKS__
 	// Used to need to include this for CodeWarrior
@@ -130,7 +131,7 @@ static Boolean SetRates(tPoppy*, short, Atom*);
 #pragma mark • Inline Functions
 
 static inline double NextPop(double iPop, double iGrowth)
-			{ return iGrowth * iPop * (1.0 - iPop); }
+			{ return VerhulstGrowth(mapPoppy, iPop, iPop, iGrowth); }
 
 #pragma mark -
 
@@ -38,6 +38,7 @@
 
 #include "LitterLib.h"
 #include "TrialPeriodUtils.h"
+#include "Verhulst.h"
 
 #ifdef __MWERKS__
 	#include <cfloat>									// For FLT_EPSILON
@@ -74,6 +75,11 @@ enum Interpolation {
 	interpMax			= interpQuad
 	};
 
+	// Chaos bank: most independent maps one object can run
+enum {
+	kMaxVoices			= 32
+	};
+
 
 #pragma mark • Type Definitions
 
@@ -100,6 +106,16 @@ typedef struct {
 	tInterp			interp;			// None, linear, quadratic, or geometric
 	
 	Boolean			seedPending;	// Flag if seed message arrives mid-cycle.
+	
+	long			voices;			// More than one for a chaos bank
+	double			bankPop[kMaxVoices],	// Per-voice state of a chaos bank, one array
+					bankGoal[kMaxVoices],	// per variable so all voices can be iterated
+					bankSlope[kMaxVoices],	// in one pass
+					bankCurve[kMaxVoices],
+					bankGrowth[kMaxVoices],
+					bankSeed[kMaxVoices];
+	tSampleVector	growthSig,				// Signal vectors for the 32-bit bank chain
+					outSigs[kMaxVoices];
 	} tPoppy;
 
 
@@ -118,6 +134,8 @@ static void DoSeed(tPoppy*, double);
 static void DoBaseFreq(tPoppy*, double);
 static void DoInterp(tPoppy*, long);
 static void DoReset(tPoppy*);
+static void DoGrowthList(tPoppy*, Symbol*, short, Atom*);
+static void DoSeedList(tPoppy*, Symbol*, short, Atom*);
 
 static void DoTattle(tPoppy*);
 static void	DoAssist(tPoppy*, void* , long , long , char*);
@@ -127,6 +145,9 @@ static void	DoInfo(tPoppy*);
 static void	DoDSP(tPoppy*, t_signal**, short*);
 static int*	PerformPoppyDynamic(int*);
 static int*	PerformPoppyStatic(int*);
+static int*	PerformPoppyBank(int*);
+static void	DoDSP64(tPoppy*, t_object*, short*, double, long, long);
+static void	PerformPoppy64(tPoppy*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 /*****************************  I M P L E M E N T A T I O N  ******************************/
@@ -135,7 +156,7 @@ static int*	PerformPoppyStatic(int*);
 #pragma mark • Inline Functions
 
 static inline double NextPop(double iPop, double iGrowth)
-			{ return iGrowth * iPop * (1.0 - iPop); }
+			{ return VerhulstGrowth(mapPoppy, iPop, iPop, iGrowth); }
 
 static inline double GeoSlope(double iNow, double iGoal, unsigned long iSteps)
 			{ return pow(iGoal/iNow, 1.0/(double)iSteps); }
@@ -191,6 +212,8 @@ main(void)
 	addinx	((method) DoInterp,		3);
 	
 	addmess	((method) DoReset,	"reset",	A_NOTHING);
+	addmess	((method) DoGrowthList,	"list",	A_GIMME, 0);
+	addmess	((method) DoSeedList,	"seeds",	A_GIMME, 0);
 	addmess	((method) DoTattle,	"dblclick",	A_CANT, 0);
 	addmess	((method) DoTattle,	"tattle",	A_NOTHING);
 	addmess	((method) DoAssist,	"assist",	A_CANT, 0);
@@ -198,6 +221,7 @@ main(void)
 	
 	// MSP messages
 	LITTER_TIMEBOMB addmess	((method) DoDSP,	"dsp",	A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) DoDSP64,	"dsp64",	A_CANT, 0);
 
 	// Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -207,6 +231,32 @@ main(void)
 #pragma mark -
 #pragma mark • Utility Methods
 
+	// The same for each voice of a chaos bank
+static void RecalcBankParams(tPoppy* me)
+	{
+	const unsigned long	sampsToGo	= me->sampsToGo;
+	const tInterp		interp		= me->interp;
+	long				i;
+	
+	for (i = 0; i < me->voices; i += 1) {
+		double	slope	= 0.0,
+				curve	= 0.0;
+		
+		if (sampsToGo == 0 || me->spc <= 2)
+			;	// Nothing to interpolate
+		else if (interp == interpLin)
+			slope = LinSlope(me->bankPop[i], me->bankGoal[i], sampsToGo);
+		else if (interp == interpQuad)
+			slope = QuadSlope(me->bankPop[i], me->bankGoal[i], sampsToGo, &curve);
+		else if (interp == interpGeo)
+			slope = GeoSlope(me->bankPop[i], me->bankGoal[i], sampsToGo);
+		
+		me->bankSlope[i] = slope;
+		me->bankCurve[i] = curve;
+		}
+	
+	}
+
 	// Utility to calculate interpolation parameters
 static inline void RecalcInterpParams(tPoppy* me)
 	{
@@ -229,6 +279,8 @@ static inline void RecalcInterpParams(tPoppy* me)
 		me->curve	= 0.0;
 		}
 	
+	if (me->voices > 1)
+		RecalcBankParams(me);
 	}
 
 	// Utility to convert the (approximate) user-specified Base Frequency to
@@ -259,6 +311,8 @@ static inline void UpdateBaseFreq(tPoppy* me)
  *	NewPoppy(iName, iArgC, iArgV)
  *	
  *	Arguments: vector of up to three values (growth rate, seed value, base frequency)
+ *	An interpolation type may follow, and after that the number of voices. More than
+ *	one voice makes a chaos bank: that many independent maps, each with its own outlet.
  *	
  ******************************************************************************************/
 
@@ -286,12 +340,18 @@ NewPoppy(
 				seed		= kDefSeed,
 				baseFreq	= kDefBF;
 	tInterp		interp		= kDefInterp;
+	long		voices		= 1,
+				i;
 	
 	// Run through initialization parameters from right to left
 	switch (iArgC) {
 		default:
 			error("%s: ignoring spurious arguments", kClassName);
 			// fall into next case...
+		case 5:
+			if ( ParseAtom(iArgV + 4, true, false, 0, NIL, kClassName) )
+				voices = iArgV[4].a_w.w_long;
+			// fall into next case...
 		case 4:
 			if ( ParseAtom(iArgV + 3, true, false, 0, NIL, kClassName) )
 				interp = iArgV[3].a_w.w_long;
@@ -324,7 +384,10 @@ NewPoppy(
 	floatin(me, 2);
 	floatin(me, 1);
 	
-	outlet_new(me, "signal");
+	if (voices < 1)					voices = 1;
+	else if (voices > kMaxVoices)	voices = kMaxVoices;
+	for (i = 0; i < voices; i += 1)
+		outlet_new(me, "signal");
 	
 	//
 	// Store initial values
@@ -336,6 +399,7 @@ NewPoppy(
 	me->curve		= 0.0;
 	me->sampsToGo	= 0;
 	me->spc			= 1;						// Preset this so DoBaseFreq() is well behaved.
+	me->voices		= voices;
 	
 	DoInterp(me, interp);						// Sets me->interp
 	DoBaseFreq(me, baseFreq);					// Sets me->userFreq, me->spc
@@ -373,10 +437,15 @@ DoGrowth(
 					kMaxGrowth	= 4.0;
 		// See DoSeed() about why FLT_EPSILON
 	
+	long	i;
+	
 	if (iGrowth < kMinGrowth)		iGrowth = kMinGrowth;
 	else if (iGrowth > kMaxGrowth)	iGrowth = kMaxGrowth;
 	
 	me->growth = iGrowth;
+	
+	for (i = 0; i < me->voices; i += 1)
+		me->bankGrowth[i] = iGrowth;
 	}
 
 
@@ -395,11 +464,22 @@ DoSeed(
 		//	warnings that I want to know about. It's possible to create a local version of
 		//	__dbl_epsilon, but that's deprecated in some circles.
 	
+	long	i;
+	
 	if (iSeed < kMinSeed)		iSeed = kMinSeed;
 	else if (iSeed > kMaxSeed)	iSeed = kMaxSeed;
 	
 	me->seed = iSeed;
 	
+	// Spread the voices of a chaos bank evenly around the unit interval from here
+	for (i = 0; i < me->voices; i += 1) {
+		double s = iSeed + (double) i / me->voices;
+		
+		if (s > kMaxSeed)
+			s -= 1.0;
+		me->bankSeed[i] = (s < kMinSeed) ? kMinSeed : s;
+		}
+	
 	if (me->sampsToGo > 0)
 		me->seedPending = true;
 	else {
@@ -407,6 +487,8 @@ DoSeed(
 		// Update curPop now, in case the special handling of me->spc <= 2 is in effect.
 		// This is harmless for larger values of spc.
 		me->curPop = me->goal = iSeed;
+		for (i = 0; i < me->voices; i += 1)
+			me->bankPop[i] = me->bankGoal[i] = me->bankSeed[i];
 		me->seedPending = false;
 		}
 	
@@ -460,16 +542,107 @@ DoReset(
 	
 	{
 	
+	long i;
+	
 	if (me->sampsToGo > 0)
 		me->seedPending = true;
 	else {
 		me->curPop = me->goal = me->seed;
+		for (i = 0; i < me->voices; i += 1)
+			me->bankPop[i] = me->bankGoal[i] = me->bankSeed[i];
 		me->seedPending = false;
 		}
 	
 	}
 
 
+/******************************************************************************************
+ *
+ *	DoGrowthList(me, sym, iArgC, iArgV)
+ *	DoSeedList(me, sym, iArgC, iArgV)
+ *
+ *	Set growth rates or seeds voice by voice. With a chaos bank, the first value goes
+ *	to the first voice, and so on; voices past the end of the list are left alone.
+ *	Otherwise only the first value is used, just as if it had been sent as a float.
+ *
+ ******************************************************************************************/
+
+static void
+DoGrowthList(
+	tPoppy*	me,
+	Symbol*	sym,
+	short	iArgC,
+	Atom*	iArgV)
+	
+	{
+	#pragma unused(sym)
+	
+	const double	kMinGrowth	= FLT_EPSILON,
+					kMaxGrowth	= 4.0;
+	
+	long	i;
+	
+	if (iArgC > me->voices)
+		iArgC = me->voices;
+	
+	for (i = 0; i < iArgC; i += 1) {
+		double g;
+		
+		if ( !ParseAtom(iArgV + i, false, true, 0, NIL, kClassName) )
+			continue;
+		
+		g = iArgV[i].a_w.w_float;
+		if (g < kMinGrowth)			g = kMinGrowth;
+		else if (g > kMaxGrowth)	g = kMaxGrowth;
+		
+		if (i == 0)
+			me->growth = g;
+		me->bankGrowth[i] = g;
+		}
+	
+	}
+
+static void
+DoSeedList(
+	tPoppy*	me,
+	Symbol*	sym,
+	short	iArgC,
+	Atom*	iArgV)
+	
+	{
+	#pragma unused(sym)
+	
+	const double	kMinSeed	= FLT_EPSILON,
+					kMaxSeed	= 1.0 - FLT_EPSILON;
+	
+	long	i;
+	
+	if (me->voices == 1) {
+		if (iArgC > 0 && ParseAtom(iArgV, false, true, 0, NIL, kClassName))
+			DoSeed(me, iArgV->a_w.w_float);
+		return;
+		}
+	
+	if (iArgC > me->voices)
+		iArgC = me->voices;
+	
+	for (i = 0; i < iArgC; i += 1) {
+		double s;
+		
+		if ( !ParseAtom(iArgV + i, false, true, 0, NIL, kClassName) )
+			continue;
+		
+		s = iArgV[i].a_w.w_float;
+		if (s < kMinSeed)		s = kMinSeed;
+		else if (s > kMaxSeed)	s = kMaxSeed;
+		
+		me->bankSeed[i] = s;
+		}
+	
+	DoReset(me);
+	}
+
+
 /******************************************************************************************
  *
  *	DoTattle(me)
@@ -518,6 +691,15 @@ DoTattle(
 		post("  Next seed population is: %lf", me->seed);
 	else post("  Initial population was: %lf", me->seed);
 	
+	if (me->voices > 1) {
+		long i;
+		
+		post("  Chaos bank with %ld voices:", me->voices);
+		for (i = 0; i < me->voices; i += 1)
+			post("    %ld: population %lf, growth rate %lf, seed %lf",
+					i + 1, me->bankPop[i], me->bankGrowth[i], me->bankSeed[i]);
+		}
+	
 	}
 
 
@@ -564,13 +746,23 @@ DoDSP(
 		};
 
 	
-	if (iConnectCounts[outletPoppy] == 0)
-		return;
-	
 	me->curSR = iDSPVectors[outletPoppy]->s_sr;
 	UpdateBaseFreq(me);
 	
-	if ( iConnectCounts[inletGrowth] > 0 ) {
+	if (me->voices > 1) {
+		long i;
+		
+		me->growthSig = (iConnectCounts[inletGrowth] > 0) ? iDSPVectors[inletGrowth]->s_vec : NIL;
+		for (i = 0; i < me->voices; i += 1)
+			me->outSigs[i] = iDSPVectors[outletPoppy + i]->s_vec;
+		
+		dsp_add(PerformPoppyBank, 2, me, (long) iDSPVectors[outletPoppy]->s_n);
+		}
+	
+	else if (iConnectCounts[outletPoppy] == 0)
+		return;
+	
+	else if ( iConnectCounts[inletGrowth] > 0 ) {
 	
 		dsp_add(
 			PerformPoppyDynamic, 4, me,
@@ -596,137 +788,117 @@ DoDSP(
 
 /******************************************************************************************
  *
- *	PerformPoppyStatic(iParams)
+ *	PoppyKernel(me, iVecSize, iMode, iDynamic, iGrowth, oPoppy)
+ *	SelectKernel(me, iDynamic)
  *
- *	Parameter block contains the following values values:
- *		- Address of the function
- *		- The performing poppy~ object
- *		- Vector size
- *		- output signal
- *		- Address of the next link in the parameter chain
+ *	Every perform routine runs through PoppyKernel(). There is one loop for each kernel
+ *	mode, i.e., for each interpolation type plus the special cases of one and two
+ *	samples per growth cycle. iMode and iDynamic are always constants, so each of the
+ *	wrappers generated below compiles down to the one loop it needs. The interpolation
+ *	and growth-rate source are no longer looked at inside the sample loop.
+ *
+ *	The loops are the ones we have always used, so the output is unchanged to the last
+ *	bit. Between cycle boundaries linear, quadratic and geometric interpolation are a
+ *	running sum (or product); evaluating the segment in closed form would vectorize,
+ *	but it would not produce the same samples. The constant runs of interpNone are plain
+ *	fills, which the compiler can vectorize.
+ *
+ *	iGrowth is only used when iDynamic is true, i.e., when a signal is connected to the
+ *	growth rate inlet. It must then hold iVecSize samples.
+ *
+ *	SelectKernel() returns the wrapper for the current interpolation and cycle length.
  *
  ******************************************************************************************/
 
-	static void PoppyStat1Step(tPoppy* me, long iVecSize, tSampleVector oPoppy)
-		{
-		double	curPop	= me->curPop,
-				growth	= me->growth;
-		
+enum KernelMode {
+	mode1Step			= 0,
+	mode2StepNone,
+	mode2StepLin,
+	mode2StepCurve,							// Quadratic and geometric are the same here
+	modeNone,
+	modeLin,
+	modeQuad,
+	modeGeo,
+	
+	modeCount
+	};
+
+typedef void (*tPoppyKernel)(tPoppy*, long, const double[], double[]);
+
+static inline void
+PoppyKernel(
+	tPoppy*			me,
+	long			iVecSize,
+	int				iMode,
+	Boolean			iDynamic,
+	const double	iGrowth[],
+	double			oPoppy[])
+	
+	{
+	const unsigned long	spc = me->spc;
+	
+	double			growth		= me->growth,
+					curPop		= me->curPop,
+					goal		= me->goal,
+					slope		= me->slope,
+					curve		= me->curve;
+	unsigned long	sampsToGo	= me->sampsToGo;
+	
+	switch (iMode) {
+	case mode1Step:
+		// We don't need to worry about interpolation
 		do {
+			if (iDynamic) growth = *iGrowth++;
 			*oPoppy++ = curPop = NextPop(curPop, growth);
 			} while (--iVecSize > 0);
-		
-		me->curPop = curPop;
-		}
+		break;
 	
-	static void PoppyStat2Step(tPoppy* me, long iVecSize, tInterp iInterp, tSampleVector oPoppy)
-		{
+	case mode2StepNone:
+	case mode2StepLin:
+	case mode2StepCurve:
 		// ASSERT: me->sampsToGo == 0
 		// As long as vector sizes are guaranteed to be powers of 2, the assertion holds
-		// NB:	Brief testing indicates that the above special-case is, indeed, a
+		// NB:	Brief testing indicates that this special case is, indeed, a
 		//		performance optimization
-		const double	growth		= me->growth;
-		
-		double	curPop,
-				goal	= me->goal;
-		
-		switch (iInterp) {
-			case interpNone:
-				do {
-					curPop		= goal;
-					goal		= NextPop(curPop, growth);
-					*oPoppy++	= curPop;
-					*oPoppy++	= curPop;
-					} while ((iVecSize -= 2) > 0);
-				break;
-			
-			case interpLin:
-				do {
-					curPop		= goal;
-					goal		= NextPop(curPop, growth);
-					*oPoppy++	= curPop;
-					*oPoppy++	= (curPop + goal) * 0.5;
-					} while ((iVecSize -= 2) > 0);
-					
-				curPop = oPoppy[-1];		// Store last sample in case base freq changes.
-				break;
-			
-			default:
-				// Both quadratic and geometric interpolation behave identically at
-				// two samples/cycle
-				do {
-					curPop		= goal;
-					goal		= NextPop(curPop, growth);
-					*oPoppy++	= curPop;
-					*oPoppy++	= curPop = sqrt(curPop * goal);
-					} while ((iVecSize -= 2) > 0);
-				
-				curPop = oPoppy[-1];		// Store last sample in case base freq changes.
-				break;
-			}
+		do {
+			if (iDynamic) {
+				growth	 = *iGrowth;
+				iGrowth	+= 2;
+				}
+			curPop		= goal;
+			goal		= NextPop(curPop, growth);
+			*oPoppy++	= curPop;
+			*oPoppy++	= (iMode == mode2StepNone)	? curPop
+						: (iMode == mode2StepLin)	? (curPop + goal) * 0.5
+						: sqrt(curPop * goal);
+			} while ((iVecSize -= 2) > 0);
 		
-		me->curPop	= curPop;
-		me->goal	= goal;
-		}
+		if (iMode != mode2StepNone)
+			curPop = oPoppy[-1];		// Store last sample in case base freq changes.
+		break;
 	
-	static void PoppyStatNoInterp(tPoppy* me, long iVecSize, unsigned long iSPC, tSampleVector oPoppy)
-		{
-		const double	growth		= me->growth;
-		
-		double			curPop		= me->curPop,
-						goal		= me->goal;
-		unsigned long	sampsToGo	= me->sampsToGo;
-		Boolean			seedPending	= me->seedPending;
-						
+	default:
 		do {
 			unsigned long sampsThisTime;
 			
 			if (sampsToGo == 0) {
-				if (seedPending) {
+				if (iMode == modeNone && !iDynamic && me->seedPending) {
 					goal = me->seed;
-					me->seedPending = seedPending = false;
+					me->seedPending = false;
 					}
-				curPop 		= goal;
-				goal		= NextPop(curPop, growth);
-				sampsToGo	= iSPC;
-				}
-			
-			sampsThisTime = sampsToGo;
-			if (sampsThisTime > iVecSize)
-				sampsThisTime = iVecSize;
-				
-				// ASSERT:	sampsThisTime ≤ iVecSize
-				// 			sampsThisTime ≤ sampsToGo
-			iVecSize -= sampsThisTime;
-			sampsToGo -= sampsThisTime;
-			
-			do { *oPoppy++ = curPop; } while (--sampsThisTime > 0);
+				if (iDynamic)
+					growth = *iGrowth;
 				
-			} while (iVecSize > 0);
-		
-		me->curPop		= curPop;
-		me->goal		= goal;
-		me->sampsToGo	= sampsToGo;
-		me->seedPending	= seedPending;
-		}
-	
-	static void PoppyStatLin(tPoppy* me, long iVecSize, unsigned long iSPC, tSampleVector oPoppy)
-		{
-		const double	growth		= me->growth;
-		
-		double			curPop		= me->curPop,
-						goal		= me->goal,
-						slope		= me->slope;
-		unsigned long	sampsToGo	= me->sampsToGo;
-						
-		do {
-			unsigned long sampsThisTime;
-			
-			if (sampsToGo == 0) {
 				curPop		= goal;
 				goal		= NextPop(curPop, growth);
-				slope		= LinSlope(curPop, goal, iSPC);
-				sampsToGo	= iSPC;
+				sampsToGo	= spc;
+				
+				switch (iMode) {
+					case modeLin:	slope = LinSlope(curPop, goal, spc);			break;
+					case modeQuad:	slope = QuadSlope(curPop, goal, spc, &curve);	break;
+					case modeGeo:	slope = GeoSlope(curPop, goal, spc);			break;
+					default:														break;
+					}
 				}
 			
 			sampsThisTime = sampsToGo;
@@ -735,107 +907,163 @@ DoDSP(
 				
 				// ASSERT:	sampsThisTime ≤ iVecSize
 				// 			sampsThisTime ≤ sampsToGo
-			iVecSize -= sampsThisTime;
-			sampsToGo -= sampsThisTime;
+			iVecSize	-= sampsThisTime;
+			sampsToGo	-= sampsThisTime;
+			if (iDynamic)
+				iGrowth	+= sampsThisTime;
 			
-			do { *oPoppy++ = curPop += slope; } while (--sampsThisTime > 0);
+			switch (iMode) {
+			case modeNone:
+				do { *oPoppy++ = curPop; } while (--sampsThisTime > 0);
+				break;
+			case modeLin:
+				do { *oPoppy++ = curPop += slope; } while (--sampsThisTime > 0);
+				break;
+			case modeQuad:
+				do {
+					*oPoppy++ = curPop += slope;
+					slope += curve;
+					} while (--sampsThisTime > 0);
+				break;
+			default:
+				do { *oPoppy++ = curPop *= slope; } while (--sampsThisTime > 0);
+				break;
+				}
 				
 			} while (iVecSize > 0);
-		
-		me->curPop		= curPop;
-		me->goal		= goal;
-		me->sampsToGo	= sampsToGo;
-		me->slope		= slope;
+		break;
 		}
 	
-	static void PoppyStatQuad(tPoppy* me, long iVecSize, long iSPC, tSampleVector oPoppy)
-		{
-		const double	growth		= me->growth;
-		
-		double			curPop		= me->curPop,
-						goal		= me->goal,
-						slope		= me->slope,
-						curve		= me->curve;
-		unsigned long	sampsToGo	= me->sampsToGo;
-		
-		do {
-			unsigned long sampsThisTime;
-			
-			if (sampsToGo == 0) {
-//				double	diff, durInv, durInv2;
-				curPop		= goal;
-				goal		= NextPop(curPop, growth);
-				slope		= QuadSlope(curPop, goal, iSPC, &curve);
-				sampsToGo	= iSPC;
-				
-//				diff		= goal - curPop;
-//				durInv		= 0.5 / sampsToGo;			// Take parabolic curve over twice
-//				durInv2		= durInv * durInv;			// the distance between random samples
-				
-//				slope		= 4.0 * diff * (durInv - durInv2);
-//				curve		= -8.0 * diff * durInv2;
-				}
-			
-			sampsThisTime = sampsToGo;
-			if (sampsThisTime > iVecSize)
-				sampsThisTime = iVecSize;
-			
-				// ASSERT:	sampsThisTime ≤ iVecSize
-				// 			sampsThisTime ≤ sampsToGo
-			iVecSize -= sampsThisTime;
-			sampsToGo -= sampsThisTime;
-			
-			do {
-				*oPoppy++ = curPop += slope;
-				slope += curve;
-				} while (--sampsThisTime > 0);
-				
-			} while (iVecSize > 0);
-		
-		me->curPop		= curPop;
-		me->goal		= goal;
-		me->slope		= slope;
-		me->curve		= curve;
-		me->sampsToGo	= sampsToGo;
+	me->curPop		= curPop;
+	me->goal		= goal;
+	me->slope		= slope;
+	me->curve		= curve;
+	me->sampsToGo	= sampsToGo;
+	}
+
+#define DefinePoppyKernels(MODE)															\
+	static void PoppyStat_##MODE(tPoppy* me, long n, const double iGrowth[], double oPoppy[])	\
+		{ PoppyKernel(me, n, MODE, false, iGrowth, oPoppy); }								\
+	static void PoppyDyn_##MODE(tPoppy* me, long n, const double iGrowth[], double oPoppy[])	\
+		{ PoppyKernel(me, n, MODE, true, iGrowth, oPoppy); }
+
+DefinePoppyKernels(mode1Step)
+DefinePoppyKernels(mode2StepNone)
+DefinePoppyKernels(mode2StepLin)
+DefinePoppyKernels(mode2StepCurve)
+DefinePoppyKernels(modeNone)
+DefinePoppyKernels(modeLin)
+DefinePoppyKernels(modeQuad)
+DefinePoppyKernels(modeGeo)
+
+#define PoppyKernelPair(MODE)	{ PoppyStat_##MODE, PoppyDyn_##MODE }
+
+	// Indexed by kernel mode and whether growth rate is a signal
+static const tPoppyKernel kPoppyKernels[modeCount][2] = {
+								PoppyKernelPair(mode1Step),
+								PoppyKernelPair(mode2StepNone),
+								PoppyKernelPair(mode2StepLin),
+								PoppyKernelPair(mode2StepCurve),
+								PoppyKernelPair(modeNone),
+								PoppyKernelPair(modeLin),
+								PoppyKernelPair(modeQuad),
+								PoppyKernelPair(modeGeo)
+								};
+
+static tPoppyKernel
+SelectKernel(
+	tPoppy*	me,
+	Boolean	iDynamic)
+	
+	{
+	const tInterp	interp = me->interp;
+	int				mode;
+	
+	switch (me->spc) {
+		case 1:
+			mode = mode1Step;
+			break;
+		case 2:
+			mode = (interp == interpNone)	? mode2StepNone
+				 : (interp == interpLin)	? mode2StepLin
+				 : mode2StepCurve;
+			break;
+		default:
+			mode = (interp == interpNone)	? modeNone
+				 : (interp == interpLin)	? modeLin
+				 : (interp == interpQuad)	? modeQuad
+				 : modeGeo;
+			break;
 		}
 	
-	static void PoppyStatGeo(tPoppy* me, long iVecSize, long iSPC, tSampleVector oPoppy)
-		{
-		const double	growth		= me->growth;
+	return kPoppyKernels[mode][iDynamic ? 1 : 0];
+	}
+
+
+/******************************************************************************************
+ *
+ *	PerformPoppy32(me, iVecSize, iGrowth, oPoppy)
+ *
+ *	The kernels work in double precision. For the 32-bit chain we run them in chunks on
+ *	the stack and convert on the way in and out. iGrowth is NIL if no signal is
+ *	connected to the growth inlet.
+ *
+ ******************************************************************************************/
+
+static void
+PerformPoppy32(
+	tPoppy*			me,
+	long			iVecSize,
+	tSampleVector	iGrowth,
+	tSampleVector	oPoppy)
+	
+	{
+	enum {
+		kChunk			= 64							// Must be even (see mode2Step...)
+		};
+	
+	tPoppyKernel	kernel = SelectKernel(me, iGrowth != NIL);
+	double			growth[kChunk],
+					poppy[kChunk];
+	
+	while (iVecSize > 0) {
+		long	n = (iVecSize < kChunk) ? iVecSize : kChunk,
+				i;
 		
-		double			curPop		= me->curPop,
-						goal		= me->goal,
-						slope		= me->slope;
-		unsigned long	sampsToGo	= me->sampsToGo;
-						
-		do {
-			unsigned long sampsThisTime;
-			
-			if (sampsToGo == 0) {
-				curPop		= goal;
-				goal		= NextPop(curPop, growth);
-				slope		= GeoSlope(curPop, goal, iSPC);
-				sampsToGo	= iSPC;
-				}
-			
-			sampsThisTime = sampsToGo;
-			if (sampsThisTime > iVecSize)
-				sampsThisTime = iVecSize;
-				
-				// ASSERT:	sampsThisTime ≤ iVecSize
-				// 			sampsThisTime ≤ sampsToGo
-			iVecSize -= sampsThisTime;
-			sampsToGo -= sampsThisTime;
-			
-			do { *oPoppy++ = curPop *= slope; } while (--sampsThisTime > 0);
-				
-			} while (iVecSize > 0);
+		if (iGrowth != NIL) {
+			for (i = 0; i < n; i += 1)
+				growth[i] = iGrowth[i];
+			iGrowth += n;
+			}
+		
+		kernel(me, n, growth, poppy);
 		
-		me->curPop		= curPop;
-		me->goal		= goal;
-		me->sampsToGo	= sampsToGo;
-		me->slope		= slope;
+		for (i = 0; i < n; i += 1)
+			oPoppy[i] = poppy[i];
+		
+		oPoppy		+= n;
+		iVecSize	-= n;
 		}
+	
+	// With two samples per cycle the current population is read back from the output.
+	// In the 32-bit chain that has always been the single-precision sample.
+	if (me->spc == 2 && me->interp != interpNone)
+		me->curPop = oPoppy[-1];
+	}
+
+
+/******************************************************************************************
+ *
+ *	PerformPoppyStatic(iParams)
+ *
+ *	Parameter block contains the following values values:
+ *		- Address of the function
+ *		- The performing poppy~ object
+ *		- Vector size
+ *		- output signal
+ *		- Address of the next link in the parameter chain
+ *
+ ******************************************************************************************/
 
 int*
 PerformPoppyStatic(
@@ -851,54 +1079,11 @@ PerformPoppyStatic(
 		paramNextLink
 		};
 	
-	unsigned long	spc;
-	tInterp			interp;
-	tPoppy*			me = (tPoppy*) iParams[paramMe];
+	tPoppy*	me = (tPoppy*) iParams[paramMe];
 	
 	if (me->coreObject.z_disabled) goto exit;
 	
-	// Copy parameters into registers
-	spc			= me->spc;
-	interp		= me->interp;
-	
-	switch (spc) {
-		case 1:
-			// We don't need to worry about interpolation
-			PoppyStat1Step(
-				me, (long) iParams[paramVectorSize], (tSampleVector) iParams[paramOut]);
-			break;
-		
-		case 2:
-			// We can optimize interpolation
-			PoppyStat2Step(
-				me, (long) iParams[paramVectorSize], interp, (tSampleVector) iParams[paramOut]);
-			break;
-		
-		default:
-			switch (me->interp) {
-				case interpNone:
-					PoppyStatNoInterp(
-						me, (long) iParams[paramVectorSize], spc, (tSampleVector) iParams[paramOut]);
-					break;
-				
-				case interpQuad:
-					PoppyStatQuad(
-						me, (long) iParams[paramVectorSize], spc, (tSampleVector) iParams[paramOut]);
-					break;
-				
-				case interpLin:
-					PoppyStatLin
-						(me, (long) iParams[paramVectorSize], spc, (tSampleVector) iParams[paramOut]);
-					break;
-				
-				default:
-					// Must be interpGeo
-					PoppyStatGeo(
-						me, (long) iParams[paramVectorSize], spc, (tSampleVector) iParams[paramOut]);
-					break;
-				}
-			break;
-		}
+	PerformPoppy32(me, (long) iParams[paramVectorSize], NIL, (tSampleVector) iParams[paramOut]);
 			
 exit:
 	return iParams + paramNextLink;
@@ -919,253 +1104,211 @@ exit:
  *
  ******************************************************************************************/
 
-	static void
-	PoppyDyn1Step(
-		tPoppy*			me,
-		long			iVecSize,
-		tSampleVector	iGrowth,
-		tSampleVector	oPoppy)
-		{
-		double	curPop	= me->curPop;
-		
-		do {
-			*oPoppy++ = curPop = NextPop(curPop, *iGrowth++);
-			} while (--iVecSize > 0);
+int*
+PerformPoppyDynamic(
+	int* iParams)
+	
+	{
+	enum {
+		paramFuncAddress	= 0,
+		paramMe,
+		paramVectorSize,
+		paramGrowth,
+		paramOut,
 		
-		me->curPop = curPop;
-		}
+		paramNextLink
+		};
+	
+	tPoppy*	me = (tPoppy*) iParams[paramMe];
+	
+	if (me->coreObject.z_disabled) goto exit;
+	
+	PerformPoppy32(	me,
+					(long) iParams[paramVectorSize],
+					(tSampleVector) iParams[paramGrowth],
+					(tSampleVector) iParams[paramOut] );
+	
+exit:
+	return iParams + paramNextLink;
+	}
 
-	static void
-	PoppyDyn2Step(
-		tPoppy*			me,
-		long			iVecSize,
-		tInterp			iInterp,
-		tSampleVector	iGrowth,
-		tSampleVector	oPoppy)
-		{
-		// ASSERT: me->sampsToGo == 0
-		// As long as vector sizes are guaranteed to be powers of 2, the assertion holds
-		double	curPop,
-				goal	= me->goal;
-		
-		switch (iInterp) {
-			case interpNone:
-				do {
-					curPop		= goal;
-					goal		= NextPop(curPop, *iGrowth);
-					iGrowth		+= 2;
-					*oPoppy++	= curPop;
-					*oPoppy++	= curPop;
-					} while ((iVecSize -= 2) > 0);
-				break;
-			
-			case interpLin:
-				do {
-					curPop		= goal;
-					goal		= NextPop(curPop, *iGrowth);
-					iGrowth		+= 2;
-					*oPoppy++	= curPop;
-					*oPoppy++	= (curPop + goal) * 0.5;
-					} while ((iVecSize -= 2) > 0);
-					
-				curPop = oPoppy[-1];		// Store last sample in case base freq changes.
-				break;
-			
-			default:
-				// Both quadratic and geometric interpolation behave identically at
-				// two samples/cycle
-				do {
-					curPop		= goal;
-					goal		= NextPop(curPop, *iGrowth);
-					iGrowth		+= 2;
-					*oPoppy++	= curPop;
-					*oPoppy++	= curPop = sqrt(curPop * goal);
-					} while ((iVecSize -= 2) > 0);
-				
-				curPop = oPoppy[-1];		// Store last sample in case base freq changes.
-				break;
-			}
-		
-		me->curPop	= curPop;
-		me->goal	= goal;
-		}
+
+/******************************************************************************************
+ *
+ *	PoppyBank(me, iVecSize, iDouble, iGrowth, oVoices)
+ *
+ *	Chaos bank: iterate me->voices independent maps side by side, each with its own
+ *	seed, growth rate, and interpolation state, writing one signal per voice.
+ *
+ *	Any one map is strictly serial, but the voices share the growth cycle, so at a
+ *	cycle boundary all the new goals and slopes can be computed in one pass across the
+ *	voices, and between boundaries each sample is one pass across the voices as well.
+ *	These loops over the voice arrays are what the compiler vectorizes.
+ *
+ *	All voices use the general interpolation formulas (with no interpolation at all for
+ *	one or two samples per cycle). A single map (me->voices == 1) does not come through
+ *	here, so its output is unaffected.
+ *
+ *	iDouble is a constant telling whether the signal vectors are double precision (the
+ *	64-bit chain) or single precision. iGrowth is NIL unless a signal is connected to
+ *	the growth inlet, in which case it sets the growth rate of every voice.
+ *
+ ******************************************************************************************/
+
+static inline void
+StoreFrame(
+	void*			oVoices[],
+	Boolean			iDouble,
+	long			iIndex,
+	const double	iFrame[],
+	long			iVoices)
 	
-	static void PoppyDynNoInterp(
-			tPoppy*			me,
-			long			iVecSize,
-			unsigned long	iSPC,
-			tSampleVector	iGrowth,
-			tSampleVector	oPoppy)
+	{
+	long j;
+	
+	if (iDouble)
+		for (j = 0; j < iVoices; j += 1) ((double*) oVoices[j])[iIndex] = iFrame[j];
+	else
+		for (j = 0; j < iVoices; j += 1) ((float*) oVoices[j])[iIndex] = iFrame[j];
+	}
+
+static inline void
+PoppyBank(
+	tPoppy*		me,
+	long		iVecSize,
+	Boolean		iDouble,
+	const void*	iGrowth,
+	void*		oVoices[])
+	
+	{
+	const long			voices	= me->voices;
+	const unsigned long	spc		= me->spc;
+	const tInterp		interp	= (spc > 2) ? me->interp : interpNone;
+	
+	double*			pop			= me->bankPop;
+	double*			goal		= me->bankGoal;
+	double*			slope		= me->bankSlope;
+	double*			curve		= me->bankCurve;
+	const double*	growth		= me->bankGrowth;
+	unsigned long	sampsToGo	= me->sampsToGo;
+	long			i = 0,
+					j;
+	
+	while (i < iVecSize) {
+		long	run, stop;
 		
-		{
-		double			curPop		= me->curPop,
-						goal		= me->goal;
-		unsigned long	sampsToGo	= me->sampsToGo;
-						
-		do {
-			unsigned long sampsThisTime;
-			
-			if (sampsToGo == 0) {
-				curPop		= goal;
-				goal		= NextPop(curPop, *iGrowth);
-				sampsToGo	= iSPC;
+		if (sampsToGo == 0) {
+			if (me->seedPending) {
+				for (j = 0; j < voices; j += 1)
+					goal[j] = me->bankSeed[j];
+				me->seedPending = false;
 				}
 			
-			sampsThisTime = sampsToGo;
-			if (sampsThisTime > iVecSize)
-				sampsThisTime = iVecSize;
-				
-				// ASSERT:	sampsThisTime ≤ iVecSize
-				// 			sampsThisTime ≤ sampsToGo
-			iGrowth		+= sampsThisTime;
-			iVecSize	-= sampsThisTime;
-			sampsToGo	-= sampsThisTime;
-			
-			do { *oPoppy++ = curPop; } while (--sampsThisTime > 0);
+			if (iGrowth == NIL) {
+				for (j = 0; j < voices; j += 1) {
+					pop[j]	= goal[j];
+					goal[j]	= NextPop(pop[j], growth[j]);
+					}
+				}
+			else {
+				double g = iDouble ? ((const double*) iGrowth)[i] : ((const float*) iGrowth)[i];
 				
-			} while (iVecSize > 0);
-		
-		me->curPop		= curPop;
-		me->goal		= goal;
-		me->sampsToGo	= sampsToGo;
-		}
-	
-	static void PoppyDynLin(
-			tPoppy*			me,
-			long			iVecSize,
-			unsigned long	iSPC,
-			tSampleVector	iGrowth,
-			tSampleVector	oPoppy)
-		
-		{
-		double			curPop		= me->curPop,
-						goal		= me->goal,
-						slope		= me->slope;
-		unsigned long	sampsToGo	= me->sampsToGo;
-						
-		do {
-			unsigned long sampsThisTime;
-			
-			if (sampsToGo == 0) {
-				curPop		= goal;
-				goal		= NextPop(curPop, *iGrowth);
-				slope		= LinSlope(curPop, goal, iSPC);
-				sampsToGo	= iSPC;
+				for (j = 0; j < voices; j += 1) {
+					pop[j]	= goal[j];
+					goal[j]	= NextPop(pop[j], g);
+					}
 				}
 			
-			sampsThisTime = sampsToGo;
-			if (sampsThisTime > iVecSize)
-				sampsThisTime = iVecSize;
-				
-				// ASSERT:	sampsThisTime ≤ iVecSize
-				// 			sampsThisTime ≤ sampsToGo
-			iVecSize	-= sampsThisTime;
-			sampsToGo	-= sampsThisTime;
-			iGrowth		+= sampsThisTime;
+			switch (interp) {
+				case interpLin:
+					for (j = 0; j < voices; j += 1)
+						slope[j] = LinSlope(pop[j], goal[j], spc);
+					break;
+				case interpQuad:
+					for (j = 0; j < voices; j += 1)
+						slope[j] = QuadSlope(pop[j], goal[j], spc, &curve[j]);
+					break;
+				case interpGeo:
+					for (j = 0; j < voices; j += 1)
+						slope[j] = GeoSlope(pop[j], goal[j], spc);
+					break;
+				default:
+					break;
+				}
 			
-			do { *oPoppy++ = curPop += slope; } while (--sampsThisTime > 0);
-				
-			} while (iVecSize > 0);
+			sampsToGo = spc;
+			}
 		
-		me->curPop		= curPop;
-		me->goal		= goal;
-		me->sampsToGo	= sampsToGo;
-		me->slope		= slope;
-		}
-
-	static void PoppyDynQuad(
-			tPoppy*			me,
-			long			iVecSize,
-			unsigned long	iSPC,
-			tSampleVector	iGrowth,
-			tSampleVector	oPoppy)
+		run = iVecSize - i;
+		if (run > sampsToGo)
+			run = sampsToGo;
+		sampsToGo	-= run;
+		stop		 = i + run;
 		
-		{
-		double			curPop		= me->curPop,
-						goal		= me->goal,
-						slope		= me->slope,
-						curve		= me->curve;
-		unsigned long	sampsToGo	= me->sampsToGo;
+		switch (interp) {
+		case interpNone:
+			// Constant: fill one voice at a time
+			for (j = 0; j < voices; j += 1) {
+				const double	p	= pop[j];
+				long			k;
+				
+				if (iDouble)
+					for (k = i; k < stop; k += 1) ((double*) oVoices[j])[k] = p;
+				else
+					for (k = i; k < stop; k += 1) ((float*) oVoices[j])[k] = p;
+				}
+			break;
 		
-		do {
-			unsigned long sampsThisTime;
-			
-			if (sampsToGo == 0) {
-				curPop		= goal;
-				goal		= NextPop(curPop, *iGrowth);
-				slope		= QuadSlope(curPop, goal, iSPC, &curve);
-				sampsToGo	= iSPC;
+		case interpLin:
+			for ( ; i < stop; i += 1) {
+				for (j = 0; j < voices; j += 1)
+					pop[j] += slope[j];
+				StoreFrame(oVoices, iDouble, i, pop, voices);
 				}
-			
-			sampsThisTime = sampsToGo;
-			if (sampsThisTime > iVecSize)
-				sampsThisTime = iVecSize;
-			
-				// ASSERT:	sampsThisTime ≤ iVecSize
-				// 			sampsThisTime ≤ sampsToGo
-			iVecSize	-= sampsThisTime;
-			sampsToGo	-= sampsThisTime;
-			iGrowth		+= sampsThisTime;
-			
-			do {
-				*oPoppy++ = curPop += slope;
-				slope += curve;
-				} while (--sampsThisTime > 0);
-				
-			} while (iVecSize > 0);
+			break;
 		
-		me->curPop		= curPop;
-		me->goal		= goal;
-		me->slope		= slope;
-		me->curve		= curve;
-		me->sampsToGo	= sampsToGo;
-		}
-	
-	static void PoppyDynGeo(
-			tPoppy*			me,
-			long			iVecSize,
-			unsigned long	iSPC,
-			tSampleVector	iGrowth,
-			tSampleVector	oPoppy)
-		{
-		double			curPop		= me->curPop,
-						goal		= me->goal,
-						slope		= me->slope;
-		unsigned long	sampsToGo	= me->sampsToGo;
-						
-		do {
-			unsigned long sampsThisTime;
-			
-			if (sampsToGo == 0) {
-				curPop		= goal;
-				goal		= NextPop(curPop, *iGrowth);
-				slope		= GeoSlope(curPop, goal, iSPC);
-				sampsToGo	= iSPC;
+		case interpQuad:
+			for ( ; i < stop; i += 1) {
+				for (j = 0; j < voices; j += 1) {
+					pop[j]		+= slope[j];
+					slope[j]	+= curve[j];
+					}
+				StoreFrame(oVoices, iDouble, i, pop, voices);
 				}
-			
-			sampsThisTime = sampsToGo;
-			if (sampsThisTime > iVecSize)
-				sampsThisTime = iVecSize;
-				
-				// ASSERT:	sampsThisTime ≤ iVecSize
-				// 			sampsThisTime ≤ sampsToGo
-			iVecSize	-= sampsThisTime;
-			sampsToGo	-= sampsThisTime;
-			iGrowth		+= sampsThisTime;
-			
-			do { *oPoppy++ = curPop *= slope; } while (--sampsThisTime > 0);
-				
-			} while (iVecSize > 0);
+			break;
 		
-		me->curPop		= curPop;
-		me->goal		= goal;
-		me->sampsToGo	= sampsToGo;
-		me->slope		= slope;
+		default:
+			for ( ; i < stop; i += 1) {
+				for (j = 0; j < voices; j += 1)
+					pop[j] *= slope[j];
+				StoreFrame(oVoices, iDouble, i, pop, voices);
+				}
+			break;
+			}
+		
+		i = stop;
 		}
+	
+	me->sampsToGo = sampsToGo;
+	}
 
 
+/******************************************************************************************
+ *
+ *	PerformPoppyBank(iParams)
+ *
+ *	Parameter block contains the following values values:
+ *		- Address of the function
+ *		- The performing poppy~ object
+ *		- Vector size
+ *		- Address of the next link in the parameter chain
+ *
+ *	The signal vectors are stored in the object by DoDSP().
+ *
+ ******************************************************************************************/
+
 int*
-PerformPoppyDynamic(
+PerformPoppyBank(
 	int* iParams)
 	
 	{
@@ -1173,79 +1316,89 @@ PerformPoppyDynamic(
 		paramFuncAddress	= 0,
 		paramMe,
 		paramVectorSize,
-		paramGrowth,
-		paramOut,
 		
 		paramNextLink
 		};
 	
-	unsigned long	spc;
-	tInterp			interp;
-	tPoppy*			me = (tPoppy*) iParams[paramMe];
+	tPoppy*	me = (tPoppy*) iParams[paramMe];
 	
 	if (me->coreObject.z_disabled) goto exit;
 	
-	// Copy parameters into registers
-	spc			= me->spc;
-	interp		= me->interp;
-	
-	switch (spc) {
-		case 1:
-			// We don't need to worry about interpolation
-			PoppyDyn1Step(	me,
-							(long) iParams[paramVectorSize],
-							(tSampleVector) iParams[paramGrowth],
-							(tSampleVector) iParams[paramOut] );
-			break;
-		
-		case 2:
-			// We can optimize interpolation
-			PoppyDyn2Step(	me,
-							(long) iParams[paramVectorSize],
-							interp,
-							(tSampleVector) iParams[paramGrowth],
-							(tSampleVector) iParams[paramOut] );
-			break;
-		
-		default:
-			switch (me->interp) {
-				case interpNone:
-					PoppyDynNoInterp(
-									me,
-									(long) iParams[paramVectorSize],
-									spc,
-									(tSampleVector) iParams[paramGrowth],
-									(tSampleVector) iParams[paramOut]);
-					break;
-				
-				case interpLin:
-					PoppyDynLin(	me,
-									(long) iParams[paramVectorSize],
-									spc,
-									(tSampleVector) iParams[paramGrowth],
-									(tSampleVector) iParams[paramOut]);
-					break;
-				
-				case interpQuad:
-					PoppyDynQuad(	me,
-									(long) iParams[paramVectorSize],
-									spc,
-									(tSampleVector) iParams[paramGrowth],
-									(tSampleVector) iParams[paramOut]);
-					break;
-				
-				default:
-					// Must be interpGeo
-					PoppyDynGeo(	me,
-									(long) iParams[paramVectorSize],
-									spc,
-									(tSampleVector) iParams[paramGrowth],
-									(tSampleVector) iParams[paramOut]);
-					break;
-				}
-			break;
-		}
+	PoppyBank(me, (long) iParams[paramVectorSize], false, me->growthSig, (void**) me->outSigs);
 	
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	DoDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *
+ *	Max 6 64-bit chain. The user parameter tells the perform method whether or not the
+ *	growth rate is coming in as a signal.
+ *
+ ******************************************************************************************/
+
+void
+DoDSP64(
+	tPoppy*		me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iMaxVectorSize, iFlags)
+	
+	enum {
+		inletGrowth			= 0,
+		outletPoppy
+		};
+	
+	if (me->voices == 1 && iConnectCounts[outletPoppy] == 0)
+		return;
+	
+	me->curSR = iSampleRate;
+	UpdateBaseFreq(me);
+	
+	dsp_add64(	iDSP64, (t_object*) me, (t_perfroutine64) PerformPoppy64, 0,
+				(void*) (long) (iConnectCounts[inletGrowth] > 0) );
+	}
+	
+
+/******************************************************************************************
+ *
+ *	PerformPoppy64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Runs the same kernels as PerformPoppyStatic() and PerformPoppyDynamic(), straight on
+ *	the 64-bit signal vectors. A chaos bank goes to PoppyBank() instead.
+ *
+ ******************************************************************************************/
+
+void
+PerformPoppy64(
+	tPoppy*		me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iInCount, iOutCount, iFlags)
+	
+	enum {
+		inletGrowth			= 0
+		};
+	
+	if (me->coreObject.z_disabled) return;
+	
+	if (me->voices > 1)
+		PoppyBank(me, iVectorSize, true, (iUser != NIL) ? iIns[inletGrowth] : NIL, (void**) iOuts);
+	else SelectKernel(me, iUser != NIL)(me, iVectorSize, iIns[inletGrowth], iOuts[0]);
+	}
@@ -77,6 +77,7 @@
 #pragma mark • Include Files
 
 #include "LitterLib.h"
+#include "Verhulst.h"
 
 #include <cfloat>			// For FLT_EPSILON
 #include <math.h>			// For fabs(), log()
@@ -102,48 +103,6 @@ enum {
 	strIndexOutLeft		= strIndexOutVera
 	};
 
-#if !__VERA_MAY__
-		// Indices for functions we support
-	enum Function {
-		fnIdent			= 0,
-		fnZero,
-		fnOne,
-		fnRecip,
-		fnSinPi,
-		fnCosPi,
-		fnTanPi,
-		fnCotPi,
-		fnSinh,
-		fnCosh,
-		fnTanh,
-		fnLog,
-		fnExp,
-		fnSqr,
-		fnRoot,
-		
-		fnFirst		= fnIdent,
-		fnLast		= fnRoot
-		};
-
-		// Function names
-	const char*		kFuncNames[fnLast + 1]
-							= {	"ident",
-								"zero",
-								"one",
-								"recip",
-								"sinpi",
-								"cospi",
-								"tanpi",
-								"cotpi",
-								"sinh",
-								"cosh",
-								"tanh",
-								"log",
-								"exp",
-								"sqr",
-								"sqrt"
-								};
-#endif
 
 	// The following four macros used to be "properly" defined as const doubles, but with
 	// changes to <cfloat> I can't figure out how to assign the new value of FLT_EPSILON
@@ -158,31 +117,37 @@ const double	kDefGrowth	= 0.0,
 
 #if __VERA_VAN__
 	const char	kClassName[]	= "lp.vera";			// Class name
+	const tMap	kMap			= mapVera;
 	
 	const enum Function kDefVFunc = fnSinPi;
 
 #elif __VERA_PLUS__
 	const char	kClassName[]	= "lp.vera+";			// Class name
+	const tMap	kMap			= mapVeraPlus;
 	
 	const enum Function kDefVFunc = fnSinPi;
 
 #elif __VERA_IS__
 	const char	kClassName[]	= "lp.vera=";			// Class name
+	const tMap	kMap			= mapVeraIs;
 	
 	const enum Function kDefVFunc = fnSinPi;
 
 #elif __VERA_LAM__
 	const char	kClassName[]	= "lp.veral";			// Class name
+	const tMap	kMap			= mapVeraL;
 	
 	const enum Function kDefVFunc = fnSinPi;
 
 #elif __VERA_STEW__
 	const char	kClassName[]	= "lp.veras";			// Class name
+	const tMap	kMap			= mapVeraS;
 	
 	const enum Function kDefVFunc = fnSinPi;
 
 #elif __VERA_MAY__
 	const char	kClassName[]	= "lp.veram";			// Class name
+	const tMap	kMap			= mapVeraM;
 	
 	const double	kDefBeta	= 1.0;
 #endif
@@ -192,10 +157,6 @@ const double	kDefGrowth	= 0.0,
 
 #pragma mark • Type Definitions
 
-#if !__VERA_MAY__
-	typedef enum Function tFunction;
-#endif
-
 #pragma mark • Object Structure
 
 typedef struct {
@@ -273,31 +234,8 @@ static Boolean SetRates(tVera*, short, Atom*);
 
 #pragma mark • Inline Functions
 
-#if __VERA_VAN__
-	static inline double NextPop(double iPop, double iFnPop, double iGrowth)
-				{ return iPop + iGrowth * iFnPop * (1.0 - iFnPop); }
-
-#elif __VERA_PLUS__
-	static inline double NextPop(double iPop, double iFnPop, double iGrowth)
-				{ return iPop + iGrowth * iFnPop; }
-
-#elif __VERA_IS__
-	static inline double NextPop(double , double iFnPop, double iGrowth)
-				{ return iGrowth * iFnPop; }
-
-#elif __VERA_LAM__
-	static inline double NextPop(double, double iFnPop, double iGrowth)
-				{ return iGrowth * iFnPop * (1.0 - iFnPop); }
-
-#elif __VERA_STEW__
-	static inline double NextPop(double, double iFnPop, double iGrowth)
-				{ return iGrowth * iFnPop * iFnPop - 1.; }
-
-#elif __VERA_MAY__
-	static inline double NextPop(double iPop, double iFnPop, double iGrowth)
-				{ return iGrowth * iPop / iFnPop; }
-
-#endif
+static inline double NextPop(double iPop, double iFnPop, double iGrowth)
+			{ return VerhulstGrowth(kMap, iPop, iFnPop, iGrowth); }
 
 
 #pragma mark -
@@ -577,24 +515,7 @@ DoNext(
 #if __VERA_MAY__
 	fnp = pow(p + 1.0, me->beta);
 #else
-	switch (me->func) {
-		case fnZero:	fnp = 0.0;				break;
-		case fnOne:		fnp = 1.0;				break;
-		case fnRecip:	fnp = 1.0 / p;			break;
-		case fnSinPi:	fnp = sin(kPi * p);		break;
-		case fnCosPi:	fnp = cos(kPi * p);		break;
-		case fnTanPi:	fnp = tan(kPi * p);		break;
-		case fnCotPi:	fnp = 1 / tan(kPi * p);	break;
-		case fnSinh:	fnp = sinh(p);			break;
-		case fnCosh:	fnp = cosh(p);			break;
-		case fnTanh:	fnp = tanh(p);			break;
-		case fnLog:		fnp = log(p);			break;
-		case fnExp:		fnp = exp(p);			break;
-		case fnSqr:		fnp = p * p;			break;
-		case fnRoot:	fnp = sqrt(p);			break;
-			// Only thing left is fnIdent
-		default:		fnp = p;				break;
-		}
+	fnp = VerhulstFunc(me->func, p);
 #endif
 	
 	if (me->cycleLen == 1)
@@ -118,6 +118,11 @@ enum Interpolation {
 	interpMax			= interpQuad
 	};
 
+	// Chaos bank: most independent maps one object can run
+enum {
+	kMaxVoices			= 32
+	};
+
 
 #if !__VERA_MAY__
 		// Indices for functions we support
@@ -246,6 +251,16 @@ typedef struct {
 	tInterp			interp;			// None, linear, quadratic, or geometric
 	
 	Boolean			seedPending;	// Flag if seed message arrives mid-cycle.
+	
+	long			voices;			// One per growth rate argument (chaos bank)
+	double			bankPop[kMaxVoices],	// Per-voice state of a chaos bank, laid out
+					bankGoal[kMaxVoices],	// as parallel arrays
+					bankSlope[kMaxVoices],
+					bankCurve[kMaxVoices],
+					bankGrowth[kMaxVoices],
+					bankSeed[kMaxVoices];
+	tSampleVector	growthSig,				// Signal vectors for the 32-bit bank chain
+					outSigs[kMaxVoices];
 
 	} tVera;
 
@@ -264,6 +279,8 @@ static void DoSeed(tVera*, double);
 static void DoBaseFreq(tVera*, double);
 static void DoInterp(tVera*, long);
 static void DoReset(tVera*);
+static void DoGrowthList(tVera*, Symbol*, short, Atom*);
+static void DoSeedList(tVera*, Symbol*, short, Atom*);
 
 #if __VERA_MAY__
 	static void DoBeta(tVera*, double);
@@ -293,6 +310,9 @@ static void	DoInfo(tVera*);
 static void	DoDSP(tVera*, t_signal**, short*);
 static int*	PerformPoppyDynamic(int*);
 static int*	PerformPoppyStatic(int*);
+static int*	PerformVeraBank(int*);
+static void	DoDSP64(tVera*, t_object*, short*, double, long, long);
+static void	PerformPoppy64(tVera*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -324,6 +344,43 @@ static int*	PerformPoppyStatic(int*);
 	static inline double NextPop(double iPop, double iFnPop, double iGrowth)
 				{ return iGrowth * iPop / iFnPop; }
 
+#endif
+
+	// One growth cycle: apply the function to the population and feed the result to the
+	// growth formula. Verhulst-May uses (p+1)^beta where the others use the function.
+	// The kernels always pass a constant iFunc, so only one case survives.
+#if __VERA_MAY__
+	static inline double NextGoal(double iPop, int, double iBeta, double iGrowth)
+				{ return NextPop(iPop, pow(iPop + 1.0, iBeta), iGrowth); }
+
+#else
+	static inline double
+	NextGoal(double iPop, int iFunc, double, double iGrowth)
+		{
+		double fnPop;
+		
+		switch (iFunc) {
+			case fnZero:	fnPop = 0.0;				break;
+			case fnOne:		fnPop = 1.0;				break;
+			case fnRecip:	fnPop = 1.0 / iPop;			break;
+			case fnSinPi:	fnPop = sin(kPi * iPop);	break;
+			case fnCosPi:	fnPop = cos(kPi * iPop);	break;
+			case fnTanPi:	fnPop = tan(kPi * iPop);	break;
+			case fnCotPi:	fnPop = 1 / tan(kPi * iPop);	break;
+			case fnSinh:	fnPop = sinh(iPop);			break;
+			case fnCosh:	fnPop = cosh(iPop);			break;
+			case fnTanh:	fnPop = tanh(iPop);			break;
+			case fnLog:		fnPop = log(iPop);			break;
+			case fnExp:		fnPop = exp(iPop);			break;
+			case fnSqr:		fnPop = iPop * iPop;		break;
+			case fnRoot:	fnPop = sqrt(iPop);			break;
+				// Only thing left is fnIdent
+			default:		fnPop = iPop;				break;
+			}
+		
+		return NextPop(iPop, fnPop, iGrowth);
+		}
+
 #endif
 
 static inline double GeoSlope(double iNow, double iGoal, unsigned long iSteps)
@@ -402,6 +459,9 @@ main(void*)				// Parameter is obsolete (68k legacy)
 	addmess	((method) DoRoot,	"sqrt",		A_NOTHING);
 #endif
 	
+	addmess	((method) DoGrowthList,	"list",	A_GIMME, 0);
+	addmess	((method) DoSeedList,	"seeds",	A_GIMME, 0);
+	
 	addmess	((method) DoTattle,	"dblclick",	A_CANT, 0);
 	addmess	((method) DoTattle,	"tattle",	A_NOTHING);
 	addmess	((method) DoAssist,	"assist",	A_CANT, 0);
@@ -409,6 +469,7 @@ main(void*)				// Parameter is obsolete (68k legacy)
 	
 	// MSP messages
 	addmess	((method) DoDSP,	"dsp",	A_CANT, 0);
+	addmess	((method) DoDSP64,	"dsp64",	A_CANT, 0);
 
 	// Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -441,6 +502,32 @@ main(void*)				// Parameter is obsolete (68k legacy)
 #endif
 
 
+	// Chaos bank version of the following; each voice has its own slope and curve
+static void RecalcBankParams(tVera* me)
+	{
+	const unsigned long	sampsToGo	= me->sampsToGo;
+	const tInterp		interp		= me->interp;
+	long				i;
+	
+	for (i = 0; i < me->voices; i += 1) {
+		double	slope	= 0.0,
+				curve	= 0.0;
+		
+		if (sampsToGo == 0 || me->spc <= 2)
+			;	// Nothing to interpolate
+		else if (interp == interpLin)
+			slope = LinSlope(me->bankPop[i], me->bankGoal[i], sampsToGo);
+		else if (interp == interpQuad)
+			slope = QuadSlope(me->bankPop[i], me->bankGoal[i], sampsToGo, &curve);
+		else if (interp == interpGeo)
+			slope = GeoSlope(me->bankPop[i], me->bankGoal[i], sampsToGo);
+		
+		me->bankSlope[i] = slope;
+		me->bankCurve[i] = curve;
+		}
+	
+	}
+
 	// Utility to calculate interpolation parameters
 static inline void RecalcInterpParams(tVera* me)
 	{
@@ -463,6 +550,8 @@ static inline void RecalcInterpParams(tVera* me)
 		me->curve	= 0.0;
 		}
 	
+	if (me->voices > 1)
+		RecalcBankParams(me);
 	}
 
 	// Utility to convert the (approximate) user-specified Base Frequency to
@@ -516,6 +605,8 @@ NewVera(
 				growth		= kDefGrowth,
 				baseFreq	= kDefBF;
 	tInterp		interp		= kDefInterp;
+	long		voices		= 1,
+				i;
 
 #if __VERA_MAY__
 	double		beta		= kDefBeta;
@@ -544,9 +635,6 @@ NewVera(
 	floatin(me, 1);
 #endif
 	
-		// One outlet
-	outlet_new(me, "signal");
-	
 	//
 	// Store initial values
 	//
@@ -603,24 +691,37 @@ NewVera(
 			}
 		}
 	
+		// Whatever is left are growth rates. More than one makes a chaos bank, with
+		// one voice (and one outlet) for each rate.
 	switch (iArgC) {
 		case 1:
 			if ( ParseAtom(iArgV, false, true, 0, NIL, NIL) )
 				growth = iArgV->a_w.w_float;
 			// fall into next case
 		case 0:
-			Set1Rate(me, growth);
 			break;
 		
 		default:
-			SetRates(me, iArgC, iArgV);
+			voices = iArgC;
+			if (voices > kMaxVoices) {
+				error("%s: only using the first %ld growth rates", kClassName, (long) kMaxVoices);
+				voices = kMaxVoices;
+				}
+			if ( ParseAtom(iArgV, false, true, 0, NIL, NIL) )
+				growth = iArgV->a_w.w_float;
 			break;	
 		}
+	
+	me->voices = voices;
+	for (i = 0; i < voices; i += 1)
+		outlet_new(me, "signal");
 
 	DoInterp(me, interp);						// Sets me->interp
 	DoBaseFreq(me, baseFreq);					// Sets me->userFreq, me->spc
 	DoSeed(me, seed);							// Sets me->seed, me->curPop, me->seedPending
 	DoGrowth(me, growth);						// Sets me->growth
+	if (voices > 1)
+		DoGrowthList(me, NIL, voices, iArgV);	// Sets me->bankGrowth
 	
 	
 	//
@@ -632,7 +733,6 @@ NewVera(
 punt:
 	// Oops... cheesy exception handling
 	error("Insufficient memory to create %s object.", kClassName);
-	if (me) FreeVera(me);
 	
 	return NIL;
 	}
@@ -650,8 +750,18 @@ punt:
  ******************************************************************************************/
 
 static void
-DoGrowth(tVera* me, double iGrowth)
-	{ me->growth = iGrowth; }
+DoGrowth(
+	tVera*	me,
+	double	iGrowth)
+	
+	{
+	long i;
+	
+	me->growth = iGrowth;
+	
+	for (i = 0; i < me->voices; i += 1)
+		me->bankGrowth[i] = iGrowth;
+	}
 
 
 static void
@@ -661,8 +771,17 @@ DoSeed(
 	
 	{
 	
+	long i;
+	
 	me->seed = iSeed;
 	
+	// A chaos bank starts its voices at evenly spaced points from here on
+	for (i = 0; i < me->voices; i += 1) {
+		double s = iSeed + (double) i / me->voices;
+		
+		me->bankSeed[i] = (s > kMaxSeed) ? s - 1.0 : s;
+		}
+	
 	if (me->sampsToGo > 0)
 		me->seedPending = true;
 	else {
@@ -670,6 +789,8 @@ DoSeed(
 		// Update curPop now, in case the special handling of me->spc <= 2 is in effect.
 		// This is harmless for larger values of spc.
 		me->curPop = me->goal = iSeed;
+		for (i = 0; i < me->voices; i += 1)
+			me->bankPop[i] = me->bankGoal[i] = me->bankSeed[i];
 		me->seedPending = false;
 		}
 	
@@ -723,16 +844,83 @@ DoReset(
 	
 	{
 	
+	long i;
+	
 	if (me->sampsToGo > 0)
 		me->seedPending = true;
 	else {
 		me->curPop = me->goal = me->seed;
+		for (i = 0; i < me->voices; i += 1)
+			me->bankPop[i] = me->bankGoal[i] = me->bankSeed[i];
 		me->seedPending = false;
 		}
 	
 	}
 
 
+/******************************************************************************************
+ *
+ *	DoGrowthList(me, sym, iArgC, iArgV)
+ *	DoSeedList(me, sym, iArgC, iArgV)
+ *
+ *	Per-voice growth rates and seeds for a chaos bank, in outlet order. Extra values are
+ *	ignored, and voices without a value keep what they had. With only one voice, the
+ *	first value is treated like a float.
+ *
+ ******************************************************************************************/
+
+static void
+DoGrowthList(
+	tVera*	me,
+	Symbol*	,
+	short	iArgC,
+	Atom*	iArgV)
+	
+	{
+	long	i;
+	
+	if (iArgC > me->voices)
+		iArgC = me->voices;
+	
+	for (i = 0; i < iArgC; i += 1) {
+		if ( !ParseAtom(iArgV + i, false, true, 0, NIL, kClassName) )
+			continue;
+		
+		if (i == 0)
+			me->growth = iArgV->a_w.w_float;
+		me->bankGrowth[i] = iArgV[i].a_w.w_float;
+		}
+	
+	}
+
+static void
+DoSeedList(
+	tVera*	me,
+	Symbol*	,
+	short	iArgC,
+	Atom*	iArgV)
+	
+	{
+	long	i;
+	
+	if (me->voices == 1) {
+		if (iArgC > 0 && ParseAtom(iArgV, false, true, 0, NIL, kClassName))
+			DoSeed(me, iArgV->a_w.w_float);
+		return;
+		}
+	
+	if (iArgC > me->voices)
+		iArgC = me->voices;
+	
+	for (i = 0; i < iArgC; i += 1) {
+		if ( ParseAtom(iArgV + i, false, true, 0, NIL, kClassName) )
+			me->bankSeed[i] = iArgV[i].a_w.w_float;
+		}
+	
+	DoReset(me);
+	}
+
+
 
 /******************************************************************************************
  *
@@ -800,6 +988,13 @@ DoTattle(
 			(long) me->func, kFuncNames[me->func]);
 #endif
 	
+	if (me->voices > 1) {
+		post("  Chaos bank with %ld voices:", me->voices);
+		for (i = 0; i < me->voices; i += 1)
+			post("    %d: population %lf, growth rate %lf, seed %lf",
+					i + 1, me->bankPop[i], me->bankGrowth[i], me->bankSeed[i]);
+		}
+	
 	}
 
 
@@ -838,13 +1033,23 @@ DoDSP(
 	
 	{
 	
-	if (iConnectCounts[outletVera] == 0)
-		return;
-	
 	me->curSR = iDSPVectors[outletVera]->s_sr;
 	UpdateBaseFreq(me);
 	
-	if ( iConnectCounts[inletGrowth] > 0 ) {
+	if (me->voices > 1) {
+		long i;
+		
+		me->growthSig = (iConnectCounts[inletGrowth] > 0) ? iDSPVectors[inletGrowth]->s_vec : NIL;
+		for (i = 0; i < me->voices; i += 1)
+			me->outSigs[i] = iDSPVectors[outletVera + i]->s_vec;
+		
+		dsp_add(PerformVeraBank, 2, me, (long) iDSPVectors[outletVera]->s_n);
+		}
+	
+	else if (iConnectCounts[outletVera] == 0)
+		return;
+	
+	else if ( iConnectCounts[inletGrowth] > 0 ) {
 	
 		dsp_add(
 			PerformPoppyDynamic, 4, me,
@@ -870,137 +1075,128 @@ DoDSP(
 
 /******************************************************************************************
  *
- *	PerformPoppyStatic(iParams)
+ *	VeraKernel(me, iVecSize, iMode, iFunc, iDynamic, iGrowth, oVera)
+ *	SelectKernel(me, iDynamic)
  *
- *	Parameter block contains the following values values:
- *		- Address of the function
- *		- The performing poppy~ object
- *		- Vector size
- *		- output signal
- *		- Address of the next link in the parameter chain
+ *	The same kernel scheme as in lp.poppy~, with one more dimension: the function applied
+ *	to the population before it goes into the growth formula. A wrapper is generated for
+ *	every combination of function, kernel mode (interpolation, plus the special cases of
+ *	one and two samples per cycle), and static or signal growth rate. All three are
+ *	constants in the wrapper, so the switches in VeraKernel() and NextGoal() fold away.
+ *
+ *	Interpolation between cycle boundaries is kept as the running sum (or product) that
+ *	lp.poppy~ uses, so both objects produce the same samples from the same populations.
+ *	A closed-form evaluation would vectorize but would round differently.
+ *
+ *	iGrowth is only used when iDynamic is true, i.e., when a signal is connected to the
+ *	growth rate inlet. It must then hold iVecSize samples.
+ *
+ *	SelectKernel() returns the wrapper for the current interpolation and cycle length.
  *
  ******************************************************************************************/
 
-	static void PoppyStat1Step(tVera* me, long iVecSize, tSampleVector oPoppy)
-		{
-		double	curPop	= me->curPop,
-				growth	= me->growth;
-		
+enum KernelMode {
+	mode1Step			= 0,
+	mode2StepNone,
+	mode2StepLin,
+	mode2StepCurve,							// Quadratic and geometric are the same here
+	modeNone,
+	modeLin,
+	modeQuad,
+	modeGeo,
+	
+	modeCount
+	};
+
+#if __VERA_MAY__
+		// Verhulst-May has no function slot; its (p+1)^beta term takes the place of f(p)
+	enum { fnMay = 0, kFuncCount };
+#else
+	enum { kFuncCount = fnLast + 1 };
+#endif
+
+typedef void (*tVeraKernel)(tVera*, long, const double[], double[]);
+
+static inline void
+VeraKernel(
+	tVera*			me,
+	long			iVecSize,
+	int				iMode,
+	int				iFunc,
+	Boolean			iDynamic,
+	const double	iGrowth[],
+	double			oVera[])
+	
+	{
+	const unsigned long	spc = me->spc;
+#if __VERA_MAY__
+	const double		beta = me->beta;
+#else
+	const double		beta = 0.0;					// Not used
+#endif
+	
+	double			growth		= me->growth,
+					curPop		= me->curPop,
+					goal		= me->goal,
+					slope		= me->slope,
+					curve		= me->curve;
+	unsigned long	sampsToGo	= me->sampsToGo;
+	
+	switch (iMode) {
+	case mode1Step:
+		// We don't need to worry about interpolation
 		do {
-			*oPoppy++ = curPop = NextPop(curPop, growth);
+			if (iDynamic) growth = *iGrowth++;
+			*oVera++ = curPop = NextGoal(curPop, iFunc, beta, growth);
 			} while (--iVecSize > 0);
-		
-		me->curPop = curPop;
-		}
+		break;
 	
-	static void PoppyStat2Step(tVera* me, long iVecSize, tInterp iInterp, tSampleVector oPoppy)
-		{
+	case mode2StepNone:
+	case mode2StepLin:
+	case mode2StepCurve:
 		// ASSERT: me->sampsToGo == 0
 		// As long as vector sizes are guaranteed to be powers of 2, the assertion holds
-		// NB:	Brief testing indicates that the above special-case is, indeed, a
+		// NB:	Brief testing indicates that this special case is, indeed, a
 		//		performance optimization
-		const double	growth		= me->growth;
-		
-		double	curPop,
-				goal	= me->goal;
-		
-		switch (iInterp) {
-			case interpNone:
-				do {
-					curPop		= goal;
-					goal		= NextPop(curPop, growth);
-					*oPoppy++	= curPop;
-					*oPoppy++	= curPop;
-					} while ((iVecSize -= 2) > 0);
-				break;
-			
-			case interpLin:
-				do {
-					curPop		= goal;
-					goal		= NextPop(curPop, growth);
-					*oPoppy++	= curPop;
-					*oPoppy++	= (curPop + goal) * 0.5;
-					} while ((iVecSize -= 2) > 0);
-					
-				curPop = oPoppy[-1];		// Store last sample in case base freq changes.
-				break;
-			
-			default:
-				// Both quadratic and geometric interpolation behave identically at
-				// two samples/cycle
-				do {
-					curPop		= goal;
-					goal		= NextPop(curPop, growth);
-					*oPoppy++	= curPop;
-					*oPoppy++	= curPop = sqrt(curPop * goal);
-					} while ((iVecSize -= 2) > 0);
-				
-				curPop = oPoppy[-1];		// Store last sample in case base freq changes.
-				break;
-			}
+		do {
+			if (iDynamic) {
+				growth	 = *iGrowth;
+				iGrowth	+= 2;
+				}
+			curPop		= goal;
+			goal		= NextGoal(curPop, iFunc, beta, growth);
+			*oVera++	= curPop;
+			*oVera++	= (iMode == mode2StepNone)	? curPop
+						: (iMode == mode2StepLin)	? (curPop + goal) * 0.5
+						: sqrt(curPop * goal);
+			} while ((iVecSize -= 2) > 0);
 		
-		me->curPop	= curPop;
-		me->goal	= goal;
-		}
+		if (iMode != mode2StepNone)
+			curPop = oVera[-1];		// Store last sample in case base freq changes.
+		break;
 	
-	static void PoppyStatNoInterp(tVera* me, long iVecSize, unsigned long iSPC, tSampleVector oPoppy)
-		{
-		const double	growth		= me->growth;
-		
-		double			curPop		= me->curPop,
-						goal		= me->goal;
-		unsigned long	sampsToGo	= me->sampsToGo;
-		Boolean			seedPending	= me->seedPending;
-						
+	default:
 		do {
 			unsigned long sampsThisTime;
 			
 			if (sampsToGo == 0) {
-				if (seedPending) {
+				if (iMode == modeNone && !iDynamic && me->seedPending) {
 					goal = me->seed;
-					me->seedPending = seedPending = false;
+					me->seedPending = false;
 					}
-				curPop 		= goal;
-				goal		= NextPop(curPop, growth);
-				sampsToGo	= iSPC;
-				}
-			
-			sampsThisTime = sampsToGo;
-			if (sampsThisTime > iVecSize)
-				sampsThisTime = iVecSize;
-				
-				// ASSERT:	sampsThisTime ≤ iVecSize
-				// 			sampsThisTime ≤ sampsToGo
-			iVecSize -= sampsThisTime;
-			sampsToGo -= sampsThisTime;
-			
-			do { *oPoppy++ = curPop; } while (--sampsThisTime > 0);
+				if (iDynamic)
+					growth = *iGrowth;
 				
-			} while (iVecSize > 0);
-		
-		me->curPop		= curPop;
-		me->goal		= goal;
-		me->sampsToGo	= sampsToGo;
-		me->seedPending	= seedPending;
-		}
-	
-	static void PoppyStatLin(tVera* me, long iVecSize, unsigned long iSPC, tSampleVector oPoppy)
-		{
-		const double	growth		= me->growth;
-		
-		double			curPop		= me->curPop,
-						goal		= me->goal,
-						slope		= me->slope;
-		unsigned long	sampsToGo	= me->sampsToGo;
-						
-		do {
-			unsigned long sampsThisTime;
-			
-			if (sampsToGo == 0) {
 				curPop		= goal;
-				goal		= NextPop(curPop, growth);
-				slope		= LinSlope(curPop, goal, iSPC);
-				sampsToGo	= iSPC;
+				goal		= NextGoal(curPop, iFunc, beta, growth);
+				sampsToGo	= spc;
+				
+				switch (iMode) {
+					case modeLin:	slope = LinSlope(curPop, goal, spc);			break;
+					case modeQuad:	slope = QuadSlope(curPop, goal, spc, &curve);	break;
+					case modeGeo:	slope = GeoSlope(curPop, goal, spc);			break;
+					default:														break;
+					}
 				}
 			
 			sampsThisTime = sampsToGo;
@@ -1009,434 +1205,249 @@ DoDSP(
 				
 				// ASSERT:	sampsThisTime ≤ iVecSize
 				// 			sampsThisTime ≤ sampsToGo
-			iVecSize -= sampsThisTime;
-			sampsToGo -= sampsThisTime;
-			
-			do { *oPoppy++ = curPop += slope; } while (--sampsThisTime > 0);
-				
-			} while (iVecSize > 0);
-		
-		me->curPop		= curPop;
-		me->goal		= goal;
-		me->sampsToGo	= sampsToGo;
-		me->slope		= slope;
-		}
-	
-	static void PoppyStatQuad(tVera* me, long iVecSize, long iSPC, tSampleVector oPoppy)
-		{
-		const double	growth		= me->growth;
-		
-		double			curPop		= me->curPop,
-						goal		= me->goal,
-						slope		= me->slope,
-						curve		= me->curve;
-		unsigned long	sampsToGo	= me->sampsToGo;
-		
-		do {
-			unsigned long sampsThisTime;
+			iVecSize	-= sampsThisTime;
+			sampsToGo	-= sampsThisTime;
+			if (iDynamic)
+				iGrowth	+= sampsThisTime;
 			
-			if (sampsToGo == 0) {
-//				double	diff, durInv, durInv2;
-				curPop		= goal;
-				goal		= NextPop(curPop, growth);
-				slope		= QuadSlope(curPop, goal, iSPC, &curve);
-				sampsToGo	= iSPC;
-				
-//				diff		= goal - curPop;
-//				durInv		= 0.5 / sampsToGo;			// Take parabolic curve over twice
-//				durInv2		= durInv * durInv;			// the distance between random samples
-				
-//				slope		= 4.0 * diff * (durInv - durInv2);
-//				curve		= -8.0 * diff * durInv2;
+			switch (iMode) {
+			case modeNone:
+				do { *oVera++ = curPop; } while (--sampsThisTime > 0);
+				break;
+			case modeLin:
+				do { *oVera++ = curPop += slope; } while (--sampsThisTime > 0);
+				break;
+			case modeQuad:
+				do {
+					*oVera++ = curPop += slope;
+					slope += curve;
+					} while (--sampsThisTime > 0);
+				break;
+			default:
+				do { *oVera++ = curPop *= slope; } while (--sampsThisTime > 0);
+				break;
 				}
-			
-			sampsThisTime = sampsToGo;
-			if (sampsThisTime > iVecSize)
-				sampsThisTime = iVecSize;
-			
-				// ASSERT:	sampsThisTime ≤ iVecSize
-				// 			sampsThisTime ≤ sampsToGo
-			iVecSize -= sampsThisTime;
-			sampsToGo -= sampsThisTime;
-			
-			do {
-				*oPoppy++ = curPop += slope;
-				slope += curve;
-				} while (--sampsThisTime > 0);
 				
 			} while (iVecSize > 0);
-		
-		me->curPop		= curPop;
-		me->goal		= goal;
-		me->slope		= slope;
-		me->curve		= curve;
-		me->sampsToGo	= sampsToGo;
+		break;
 		}
 	
-	static void PoppyStatGeo(tVera* me, long iVecSize, long iSPC, tSampleVector oPoppy)
-		{
-		const double	growth		= me->growth;
-		
-		double			curPop		= me->curPop,
-						goal		= me->goal,
-						slope		= me->slope;
-		unsigned long	sampsToGo	= me->sampsToGo;
-						
-		do {
-			unsigned long sampsThisTime;
-			
-			if (sampsToGo == 0) {
-				curPop		= goal;
-				goal		= NextPop(curPop, growth);
-				slope		= GeoSlope(curPop, goal, iSPC);
-				sampsToGo	= iSPC;
-				}
-			
-			sampsThisTime = sampsToGo;
-			if (sampsThisTime > iVecSize)
-				sampsThisTime = iVecSize;
-				
-				// ASSERT:	sampsThisTime ≤ iVecSize
-				// 			sampsThisTime ≤ sampsToGo
-			iVecSize -= sampsThisTime;
-			sampsToGo -= sampsThisTime;
-			
-			do { *oPoppy++ = curPop *= slope; } while (--sampsThisTime > 0);
-				
-			} while (iVecSize > 0);
-		
-		me->curPop		= curPop;
-		me->goal		= goal;
-		me->sampsToGo	= sampsToGo;
-		me->slope		= slope;
-		}
+	me->curPop		= curPop;
+	me->goal		= goal;
+	me->slope		= slope;
+	me->curve		= curve;
+	me->sampsToGo	= sampsToGo;
+	}
 
-int*
-PerformPoppyStatic(
-	int* iParams)
-	
-	{
-	enum {
-		paramFuncAddress	= 0,
-		paramMe,
-		paramVectorSize,
-		paramOut,
-		
-		paramNextLink
-		};
-	
-	unsigned long	spc;
-	tInterp			interp;
-	tVera*			me = (tVera*) iParams[paramMe];
+#define DefineVeraKernels(MODE, FUNC)														\
+	static void VeraStat_##MODE##_##FUNC(tVera* me, long n, const double iGrowth[], double oVera[])	\
+		{ VeraKernel(me, n, MODE, FUNC, false, iGrowth, oVera); }							\
+	static void VeraDyn_##MODE##_##FUNC(tVera* me, long n, const double iGrowth[], double oVera[])	\
+		{ VeraKernel(me, n, MODE, FUNC, true, iGrowth, oVera); }
+
+#define DefineVeraFuncKernels(FUNC)															\
+	DefineVeraKernels(mode1Step, FUNC)														\
+	DefineVeraKernels(mode2StepNone, FUNC)													\
+	DefineVeraKernels(mode2StepLin, FUNC)													\
+	DefineVeraKernels(mode2StepCurve, FUNC)													\
+	DefineVeraKernels(modeNone, FUNC)														\
+	DefineVeraKernels(modeLin, FUNC)														\
+	DefineVeraKernels(modeQuad, FUNC)														\
+	DefineVeraKernels(modeGeo, FUNC)
+
+#define VeraKernelPair(MODE, FUNC)	{ VeraStat_##MODE##_##FUNC, VeraDyn_##MODE##_##FUNC }
+
+#define VeraFuncKernels(FUNC)	{															\
+								VeraKernelPair(mode1Step, FUNC),							\
+								VeraKernelPair(mode2StepNone, FUNC),						\
+								VeraKernelPair(mode2StepLin, FUNC),							\
+								VeraKernelPair(mode2StepCurve, FUNC),						\
+								VeraKernelPair(modeNone, FUNC),								\
+								VeraKernelPair(modeLin, FUNC),								\
+								VeraKernelPair(modeQuad, FUNC),								\
+								VeraKernelPair(modeGeo, FUNC)								\
+								}
+
+#if __VERA_MAY__
+	DefineVeraFuncKernels(fnMay)
 	
-	if (me->coreObject.z_disabled) goto exit;
+	static const tVeraKernel kVeraKernels[kFuncCount][modeCount][2] = {
+									VeraFuncKernels(fnMay)
+									};
+#else
+	DefineVeraFuncKernels(fnIdent)
+	DefineVeraFuncKernels(fnZero)
+	DefineVeraFuncKernels(fnOne)
+	DefineVeraFuncKernels(fnRecip)
+	DefineVeraFuncKernels(fnSinPi)
+	DefineVeraFuncKernels(fnCosPi)
+	DefineVeraFuncKernels(fnTanPi)
+	DefineVeraFuncKernels(fnCotPi)
+	DefineVeraFuncKernels(fnSinh)
+	DefineVeraFuncKernels(fnCosh)
+	DefineVeraFuncKernels(fnTanh)
+	DefineVeraFuncKernels(fnLog)
+	DefineVeraFuncKernels(fnExp)
+	DefineVeraFuncKernels(fnSqr)
+	DefineVeraFuncKernels(fnRoot)
+	
+		// Indexed by function, kernel mode, and whether growth rate is a signal
+	static const tVeraKernel kVeraKernels[kFuncCount][modeCount][2] = {
+									VeraFuncKernels(fnIdent),
+									VeraFuncKernels(fnZero),
+									VeraFuncKernels(fnOne),
+									VeraFuncKernels(fnRecip),
+									VeraFuncKernels(fnSinPi),
+									VeraFuncKernels(fnCosPi),
+									VeraFuncKernels(fnTanPi),
+									VeraFuncKernels(fnCotPi),
+									VeraFuncKernels(fnSinh),
+									VeraFuncKernels(fnCosh),
+									VeraFuncKernels(fnTanh),
+									VeraFuncKernels(fnLog),
+									VeraFuncKernels(fnExp),
+									VeraFuncKernels(fnSqr),
+									VeraFuncKernels(fnRoot)
+									};
+#endif
+
+static tVeraKernel
+SelectKernel(
+	tVera*	me,
+	Boolean	iDynamic)
 	
-	// Copy parameters into registers
-	spc			= me->spc;
-	interp		= me->interp;
+	{
+	const tInterp	interp = me->interp;
+	int				mode;
 	
-	switch (spc) {
+	switch (me->spc) {
 		case 1:
-			// We don't need to worry about interpolation
-			PoppyStat1Step(
-				me, (long) iParams[paramVectorSize], (tSampleVector) iParams[paramOut]);
+			mode = mode1Step;
 			break;
-		
 		case 2:
-			// We can optimize interpolation
-			PoppyStat2Step(
-				me, (long) iParams[paramVectorSize], interp, (tSampleVector) iParams[paramOut]);
+			mode = (interp == interpNone)	? mode2StepNone
+				 : (interp == interpLin)	? mode2StepLin
+				 : mode2StepCurve;
 			break;
-		
 		default:
-			switch (me->interp) {
-				case interpNone:
-					PoppyStatNoInterp(
-						me, (long) iParams[paramVectorSize], spc, (tSampleVector) iParams[paramOut]);
-					break;
-				
-				case interpQuad:
-					PoppyStatQuad(
-						me, (long) iParams[paramVectorSize], spc, (tSampleVector) iParams[paramOut]);
-					break;
-				
-				case interpLin:
-					PoppyStatLin
-						(me, (long) iParams[paramVectorSize], spc, (tSampleVector) iParams[paramOut]);
-					break;
-				
-				default:
-					// Must be interpGeo
-					PoppyStatGeo(
-						me, (long) iParams[paramVectorSize], spc, (tSampleVector) iParams[paramOut]);
-					break;
-				}
+			mode = (interp == interpNone)	? modeNone
+				 : (interp == interpLin)	? modeLin
+				 : (interp == interpQuad)	? modeQuad
+				 : modeGeo;
 			break;
 		}
-			
-exit:
-	return iParams + paramNextLink;
+	
+#if __VERA_MAY__
+	return kVeraKernels[fnMay][mode][iDynamic ? 1 : 0];
+#else
+	return kVeraKernels[me->func][mode][iDynamic ? 1 : 0];
+#endif
 	}
 
 
 /******************************************************************************************
  *
- *	PerformPoppyDynamic(iParams)
+ *	PerformPoppy32(me, iVecSize, iGrowth, oVera)
  *
- *	Parameter block contains the following values values:
- *		- Address of the function
- *		- The performing poppy~ object
- *		- Vector size
- *		- Input growth rate signal
- *		- output signal
- *		- Address of the next link in the parameter chain
+ *	Runs the double-precision kernels for the 32-bit chain, a stack-sized chunk at a
+ *	time. iGrowth is NIL if no signal is connected to the growth inlet.
  *
  ******************************************************************************************/
 
-	static void
-	PoppyDyn1Step(
-		tVera*			me,
-		long			iVecSize,
-		tSampleVector	iGrowth,
-		tSampleVector	oPoppy)
-		{
-		double	curPop	= me->curPop;
-		
-		do {
-			*oPoppy++ = curPop = NextPop(curPop, *iGrowth++);
-			} while (--iVecSize > 0);
-		
-		me->curPop = curPop;
-		}
-
-	static void
-	PoppyDyn2Step(
-		tVera*			me,
-		long			iVecSize,
-		tInterp			iInterp,
-		tSampleVector	iGrowth,
-		tSampleVector	oPoppy)
-		{
-		// ASSERT: me->sampsToGo == 0
-		// As long as vector sizes are guaranteed to be powers of 2, the assertion holds
-		double	curPop,
-				goal	= me->goal;
+static void
+PerformPoppy32(
+	tVera*			me,
+	long			iVecSize,
+	tSampleVector	iGrowth,
+	tSampleVector	oVera)
+	
+	{
+	enum {
+		kChunk			= 64							// Must be even (see mode2Step...)
+		};
+	
+	tVeraKernel		kernel = SelectKernel(me, iGrowth != NIL);
+	double			growth[kChunk],
+					vera[kChunk];
+	
+	while (iVecSize > 0) {
+		long	n = (iVecSize < kChunk) ? iVecSize : kChunk,
+				i;
 		
-		switch (iInterp) {
-			case interpNone:
-				do {
-					curPop		= goal;
-					goal		= NextPop(curPop, *iGrowth);
-					iGrowth		+= 2;
-					*oPoppy++	= curPop;
-					*oPoppy++	= curPop;
-					} while ((iVecSize -= 2) > 0);
-				break;
-			
-			case interpLin:
-				do {
-					curPop		= goal;
-					goal		= NextPop(curPop, *iGrowth);
-					iGrowth		+= 2;
-					*oPoppy++	= curPop;
-					*oPoppy++	= (curPop + goal) * 0.5;
-					} while ((iVecSize -= 2) > 0);
-					
-				curPop = oPoppy[-1];		// Store last sample in case base freq changes.
-				break;
-			
-			default:
-				// Both quadratic and geometric interpolation behave identically at
-				// two samples/cycle
-				do {
-					curPop		= goal;
-					goal		= NextPop(curPop, *iGrowth);
-					iGrowth		+= 2;
-					*oPoppy++	= curPop;
-					*oPoppy++	= curPop = sqrt(curPop * goal);
-					} while ((iVecSize -= 2) > 0);
-				
-				curPop = oPoppy[-1];		// Store last sample in case base freq changes.
-				break;
+		if (iGrowth != NIL) {
+			for (i = 0; i < n; i += 1)
+				growth[i] = iGrowth[i];
+			iGrowth += n;
 			}
 		
-		me->curPop	= curPop;
-		me->goal	= goal;
-		}
-	
-	static void PoppyDynNoInterp(
-			tVera*			me,
-			long			iVecSize,
-			unsigned long	iSPC,
-			tSampleVector	iGrowth,
-			tSampleVector	oPoppy)
+		kernel(me, n, growth, vera);
 		
-		{
-		double			curPop		= me->curPop,
-						goal		= me->goal;
-		unsigned long	sampsToGo	= me->sampsToGo;
-						
-		do {
-			unsigned long sampsThisTime;
-			
-			if (sampsToGo == 0) {
-				curPop		= goal;
-				goal		= NextPop(curPop, *iGrowth);
-				sampsToGo	= iSPC;
-				}
-			
-			sampsThisTime = sampsToGo;
-			if (sampsThisTime > iVecSize)
-				sampsThisTime = iVecSize;
-				
-				// ASSERT:	sampsThisTime ≤ iVecSize
-				// 			sampsThisTime ≤ sampsToGo
-			iGrowth		+= sampsThisTime;
-			iVecSize	-= sampsThisTime;
-			sampsToGo	-= sampsThisTime;
-			
-			do { *oPoppy++ = curPop; } while (--sampsThisTime > 0);
-				
-			} while (iVecSize > 0);
+		for (i = 0; i < n; i += 1)
+			oVera[i] = vera[i];
 		
-		me->curPop		= curPop;
-		me->goal		= goal;
-		me->sampsToGo	= sampsToGo;
+		oVera		+= n;
+		iVecSize	-= n;
 		}
 	
-	static void PoppyDynLin(
-			tVera*			me,
-			long			iVecSize,
-			unsigned long	iSPC,
-			tSampleVector	iGrowth,
-			tSampleVector	oPoppy)
-		
-		{
-		double			curPop		= me->curPop,
-						goal		= me->goal,
-						slope		= me->slope;
-		unsigned long	sampsToGo	= me->sampsToGo;
-						
-		do {
-			unsigned long sampsThisTime;
-			
-			if (sampsToGo == 0) {
-				curPop		= goal;
-				goal		= NextPop(curPop, *iGrowth);
-				slope		= LinSlope(curPop, goal, iSPC);
-				sampsToGo	= iSPC;
-				}
-			
-			sampsThisTime = sampsToGo;
-			if (sampsThisTime > iVecSize)
-				sampsThisTime = iVecSize;
-				
-				// ASSERT:	sampsThisTime ≤ iVecSize
-				// 			sampsThisTime ≤ sampsToGo
-			iVecSize	-= sampsThisTime;
-			sampsToGo	-= sampsThisTime;
-			iGrowth		+= sampsThisTime;
-			
-			do { *oPoppy++ = curPop += slope; } while (--sampsThisTime > 0);
-				
-			} while (iVecSize > 0);
-		
-		me->curPop		= curPop;
-		me->goal		= goal;
-		me->sampsToGo	= sampsToGo;
-		me->slope		= slope;
-		}
+	// With two samples per cycle the current population is read back from the output,
+	// which in the 32-bit chain is the single-precision sample. Keep it that way, as in
+	// lp.poppy~.
+	if (me->spc == 2 && me->interp != interpNone)
+		me->curPop = oVera[-1];
+	}
 
-	static void PoppyDynQuad(
-			tVera*			me,
-			long			iVecSize,
-			unsigned long	iSPC,
-			tSampleVector	iGrowth,
-			tSampleVector	oPoppy)
-		
-		{
-		double			curPop		= me->curPop,
-						goal		= me->goal,
-						slope		= me->slope,
-						curve		= me->curve;
-		unsigned long	sampsToGo	= me->sampsToGo;
-		
-		do {
-			unsigned long sampsThisTime;
-			
-			if (sampsToGo == 0) {
-				curPop		= goal;
-				goal		= NextPop(curPop, *iGrowth);
-				slope		= QuadSlope(curPop, goal, iSPC, &curve);
-				sampsToGo	= iSPC;
-				}
-			
-			sampsThisTime = sampsToGo;
-			if (sampsThisTime > iVecSize)
-				sampsThisTime = iVecSize;
-			
-				// ASSERT:	sampsThisTime ≤ iVecSize
-				// 			sampsThisTime ≤ sampsToGo
-			iVecSize	-= sampsThisTime;
-			sampsToGo	-= sampsThisTime;
-			iGrowth		+= sampsThisTime;
-			
-			do {
-				*oPoppy++ = curPop += slope;
-				slope += curve;
-				} while (--sampsThisTime > 0);
-				
-			} while (iVecSize > 0);
+
+/******************************************************************************************
+ *
+ *	PerformPoppyStatic(iParams)
+ *
+ *	Parameter block contains the following values values:
+ *		- Address of the function
+ *		- The performing vera~ object
+ *		- Vector size
+ *		- output signal
+ *		- Address of the next link in the parameter chain
+ *
+ ******************************************************************************************/
+
+int*
+PerformPoppyStatic(
+	int* iParams)
+	
+	{
+	enum {
+		paramFuncAddress	= 0,
+		paramMe,
+		paramVectorSize,
+		paramOut,
 		
-		me->curPop		= curPop;
-		me->goal		= goal;
-		me->slope		= slope;
-		me->curve		= curve;
-		me->sampsToGo	= sampsToGo;
-		}
+		paramNextLink
+		};
 	
-	static void PoppyDynGeo(
-			tVera*			me,
-			long			iVecSize,
-			unsigned long	iSPC,
-			tSampleVector	iGrowth,
-			tSampleVector	oPoppy)
-		{
-		double			curPop		= me->curPop,
-						goal		= me->goal,
-						slope		= me->slope;
-		unsigned long	sampsToGo	= me->sampsToGo;
-						
-		do {
-			unsigned long sampsThisTime;
-			
-			if (sampsToGo == 0) {
-				curPop		= goal;
-				goal		= NextPop(curPop, *iGrowth);
-				slope		= GeoSlope(curPop, goal, iSPC);
-				sampsToGo	= iSPC;
-				}
-			
-			sampsThisTime = sampsToGo;
-			if (sampsThisTime > iVecSize)
-				sampsThisTime = iVecSize;
-				
-				// ASSERT:	sampsThisTime ≤ iVecSize
-				// 			sampsThisTime ≤ sampsToGo
-			iVecSize	-= sampsThisTime;
-			sampsToGo	-= sampsThisTime;
-			iGrowth		+= sampsThisTime;
+	tVera*	me = (tVera*) iParams[paramMe];
+	
+	if (me->coreObject.z_disabled) goto exit;
+	
+	PerformPoppy32(me, (long) iParams[paramVectorSize], NIL, (tSampleVector) iParams[paramOut]);
 			
-			do { *oPoppy++ = curPop *= slope; } while (--sampsThisTime > 0);
-				
-			} while (iVecSize > 0);
-		
-		me->curPop		= curPop;
-		me->goal		= goal;
-		me->sampsToGo	= sampsToGo;
-		me->slope		= slope;
-		}
+exit:
+	return iParams + paramNextLink;
+	}
+
 
+/******************************************************************************************
+ *
+ *	PerformPoppyDynamic(iParams)
+ *
+ *	Parameter block contains the following values values:
+ *		- Address of the function
+ *		- The performing vera~ object
+ *		- Vector size
+ *		- Input growth rate signal
+ *		- output signal
+ *		- Address of the next link in the parameter chain
+ *
+ ******************************************************************************************/
 
 int*
 PerformPoppyDynamic(
@@ -1453,73 +1464,288 @@ PerformPoppyDynamic(
 		paramNextLink
 		};
 	
-	unsigned long	spc;
-	tInterp			interp;
-	tVera*			me = (tVera*) iParams[paramMe];
+	tVera*	me = (tVera*) iParams[paramMe];
 	
 	if (me->coreObject.z_disabled) goto exit;
 	
-	// Copy parameters into registers
-	spc			= me->spc;
-	interp		= me->interp;
+	PerformPoppy32(	me,
+					(long) iParams[paramVectorSize],
+					(tSampleVector) iParams[paramGrowth],
+					(tSampleVector) iParams[paramOut] );
 	
-	switch (spc) {
-		case 1:
-			// We don't need to worry about interpolation
-			PoppyDyn1Step(	me,
-							(long) iParams[paramVectorSize],
-							(tSampleVector) iParams[paramGrowth],
-							(tSampleVector) iParams[paramOut] );
-			break;
-		
-		case 2:
-			// We can optimize interpolation
-			PoppyDyn2Step(	me,
-							(long) iParams[paramVectorSize],
-							interp,
-							(tSampleVector) iParams[paramGrowth],
-							(tSampleVector) iParams[paramOut] );
-			break;
+exit:
+	return iParams + paramNextLink;
+	}
+
+
+/******************************************************************************************
+ *
+ *	VeraBank(me, iVecSize, iDouble, iGrowth, oVoices)
+ *
+ *	Chaos bank: me->voices copies of the map, each with its own seed, growth rate, and
+ *	interpolation state, sharing the function (or beta), base frequency, and type of
+ *	interpolation. Each voice has its own outlet.
+ *
+ *	The voices run in lock step through the growth cycle. New goals and slopes are
+ *	computed for all voices at once at each cycle boundary, and interpolated samples
+ *	one frame (one sample of every voice) at a time, so the inner loops run across the
+ *	voice arrays and can be vectorized.
+ *
+ *	A single voice never comes through here. With one or two samples per cycle the
+ *	bank does not interpolate.
+ *
+ *	iDouble is a constant telling whether the signal vectors are double precision (the
+ *	64-bit chain) or single precision. iGrowth is NIL unless a signal is connected to
+ *	the growth inlet, in which case it sets the growth rate of every voice.
+ *
+ ******************************************************************************************/
+
+static inline void
+StoreFrame(
+	void*			oVoices[],
+	Boolean			iDouble,
+	long			iIndex,
+	const double	iFrame[],
+	long			iVoices)
+	
+	{
+	long j;
+	
+	if (iDouble)
+		for (j = 0; j < iVoices; j += 1) ((double*) oVoices[j])[iIndex] = iFrame[j];
+	else
+		for (j = 0; j < iVoices; j += 1) ((float*) oVoices[j])[iIndex] = iFrame[j];
+	}
+
+static inline void
+VeraBank(
+	tVera*		me,
+	long		iVecSize,
+	Boolean		iDouble,
+	const void*	iGrowth,
+	void*		oVoices[])
+	
+	{
+	const long			voices	= me->voices;
+	const unsigned long	spc		= me->spc;
+	const tInterp		interp	= (spc > 2) ? me->interp : interpNone;
+#if __VERA_MAY__
+	const int			func	= fnMay;
+	const double		beta	= me->beta;
+#else
+	const int			func	= me->func;
+	const double		beta	= 0.0;					// Not used
+#endif
+	
+	double*			pop			= me->bankPop;
+	double*			goal		= me->bankGoal;
+	double*			slope		= me->bankSlope;
+	double*			curve		= me->bankCurve;
+	const double*	growth		= me->bankGrowth;
+	unsigned long	sampsToGo	= me->sampsToGo;
+	long			i = 0,
+					j;
+	
+	while (i < iVecSize) {
+		long	run, stop;
 		
-		default:
-			switch (me->interp) {
-				case interpNone:
-					PoppyDynNoInterp(
-									me,
-									(long) iParams[paramVectorSize],
-									spc,
-									(tSampleVector) iParams[paramGrowth],
-									(tSampleVector) iParams[paramOut]);
-					break;
+		if (sampsToGo == 0) {
+			if (me->seedPending) {
+				for (j = 0; j < voices; j += 1)
+					goal[j] = me->bankSeed[j];
+				me->seedPending = false;
+				}
+			
+			if (iGrowth == NIL) {
+				for (j = 0; j < voices; j += 1) {
+					pop[j]	= goal[j];
+					goal[j]	= NextGoal(pop[j], func, beta, growth[j]);
+					}
+				}
+			else {
+				double g = iDouble ? ((const double*) iGrowth)[i] : ((const float*) iGrowth)[i];
 				
+				for (j = 0; j < voices; j += 1) {
+					pop[j]	= goal[j];
+					goal[j]	= NextGoal(pop[j], func, beta, g);
+					}
+				}
+			
+			switch (interp) {
 				case interpLin:
-					PoppyDynLin(	me,
-									(long) iParams[paramVectorSize],
-									spc,
-									(tSampleVector) iParams[paramGrowth],
-									(tSampleVector) iParams[paramOut]);
+					for (j = 0; j < voices; j += 1)
+						slope[j] = LinSlope(pop[j], goal[j], spc);
 					break;
-				
 				case interpQuad:
-					PoppyDynQuad(	me,
-									(long) iParams[paramVectorSize],
-									spc,
-									(tSampleVector) iParams[paramGrowth],
-									(tSampleVector) iParams[paramOut]);
+					for (j = 0; j < voices; j += 1)
+						slope[j] = QuadSlope(pop[j], goal[j], spc, &curve[j]);
+					break;
+				case interpGeo:
+					for (j = 0; j < voices; j += 1)
+						slope[j] = GeoSlope(pop[j], goal[j], spc);
 					break;
-				
 				default:
-					// Must be interpGeo
-					PoppyDynGeo(	me,
-									(long) iParams[paramVectorSize],
-									spc,
-									(tSampleVector) iParams[paramGrowth],
-									(tSampleVector) iParams[paramOut]);
 					break;
 				}
+			
+			sampsToGo = spc;
+			}
+		
+		run = iVecSize - i;
+		if (run > sampsToGo)
+			run = sampsToGo;
+		sampsToGo	-= run;
+		stop		 = i + run;
+		
+		switch (interp) {
+		case interpNone:
+			// Constant: fill one voice at a time
+			for (j = 0; j < voices; j += 1) {
+				const double	p	= pop[j];
+				long			k;
+				
+				if (iDouble)
+					for (k = i; k < stop; k += 1) ((double*) oVoices[j])[k] = p;
+				else
+					for (k = i; k < stop; k += 1) ((float*) oVoices[j])[k] = p;
+				}
 			break;
+		
+		case interpLin:
+			for ( ; i < stop; i += 1) {
+				for (j = 0; j < voices; j += 1)
+					pop[j] += slope[j];
+				StoreFrame(oVoices, iDouble, i, pop, voices);
+				}
+			break;
+		
+		case interpQuad:
+			for ( ; i < stop; i += 1) {
+				for (j = 0; j < voices; j += 1) {
+					pop[j]		+= slope[j];
+					slope[j]	+= curve[j];
+					}
+				StoreFrame(oVoices, iDouble, i, pop, voices);
+				}
+			break;
+		
+		default:
+			for ( ; i < stop; i += 1) {
+				for (j = 0; j < voices; j += 1)
+					pop[j] *= slope[j];
+				StoreFrame(oVoices, iDouble, i, pop, voices);
+				}
+			break;
+			}
+		
+		i = stop;
 		}
 	
+	me->sampsToGo = sampsToGo;
+	}
+
+
+/******************************************************************************************
+ *
+ *	PerformVeraBank(iParams)
+ *
+ *	Parameter block contains the following values values:
+ *		- Address of the function
+ *		- The performing vera~ object
+ *		- Vector size
+ *		- Address of the next link in the parameter chain
+ *
+ *	The signal vectors are stored in the object by DoDSP().
+ *
+ ******************************************************************************************/
+
+int*
+PerformVeraBank(
+	int* iParams)
+	
+	{
+	enum {
+		paramFuncAddress	= 0,
+		paramMe,
+		paramVectorSize,
+		
+		paramNextLink
+		};
+	
+	tVera*	me = (tVera*) iParams[paramMe];
+	
+	if (me->coreObject.z_disabled) goto exit;
+	
+	VeraBank(me, (long) iParams[paramVectorSize], false, me->growthSig, (void**) me->outSigs);
+	
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	DoDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *
+ *	Max 6 64-bit chain. The user parameter tells the perform method whether or not the
+ *	growth rate is coming in as a signal.
+ *
+ ******************************************************************************************/
+
+void
+DoDSP64(
+	tVera*		me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iMaxVectorSize, iFlags)
+	
+	if (me->voices == 1 && iConnectCounts[outletVera] == 0)
+		return;
+	
+	me->curSR = iSampleRate;
+	UpdateBaseFreq(me);
+	
+	dsp_add64(	iDSP64, (t_object*) me, (t_perfroutine64) PerformPoppy64, 0,
+				(void*) (long) (iConnectCounts[inletGrowth] > 0) );
+	}
+	
+
+/******************************************************************************************
+ *
+ *	PerformPoppy64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Runs the same kernels as PerformPoppyStatic() and PerformPoppyDynamic(), straight on
+ *	the 64-bit signal vectors, or VeraBank() for a chaos bank.
+ *
+ ******************************************************************************************/
+
+void
+PerformPoppy64(
+	tVera*		me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iInCount, iOutCount, iFlags)
+	
+	enum {
+		inletGrowth			= 0
+		};
+	
+	if (me->coreObject.z_disabled) return;
+	
+	if (me->voices > 1)
+		VeraBank(me, iVectorSize, true, (iUser != NIL) ? iIns[inletGrowth] : NIL, (void**) iOuts);
+	else SelectKernel(me, iUser != NIL)(me, iVectorSize, iIns[inletGrowth], iOuts[0]);
+	}
@@ -34,6 +34,7 @@
 #include "LitterLib.h"
 #include "RNGDistBeta.h"			// this #includes Taus88.h, MiscUtils.h, and math.h
 #include "TrialPeriodUtils.h"
+#include "DrawUtils.h"
 
 
 #pragma mark • Constants
@@ -72,6 +73,8 @@ typedef struct {
 					
 	eBetaAlg		whichAlg;
 	uBetaParams		params;
+	
+	tDrawBuf		drawBuf;
 	} objBeta;
 
 
@@ -83,88 +86,118 @@ typedef struct {
 /******************************************************************************************
  *
  *	AbbieBang(me)
+ *	AbbieDraw(me, iCount, iDest)
+ *
+ *	The draw message sends iCount deviates as one list (or into the buffer~ or table
+ *	named by iDest), checking the algorithm only once for the lot.
  *
  ******************************************************************************************/
 
-
-static void
-AbbieBang(
-	objBeta* me)
-	
-	{
-	double		randVal;
-	eBetaAlg	whichAlg = me->whichAlg;
-	
-	if (whichAlg == algUndef) {
-		double	alpha	= me->alpha,
-				beta	= me->beta;
-		
-		whichAlg = me->whichAlg = RecommendBetaAlg(alpha, beta);
+	static eBetaAlg CheckAlg(objBeta* me)
+		{
+		eBetaAlg whichAlg = me->whichAlg;
 		
-		switch (whichAlg) {
-		case algJoehnk:
-			CalcJKParams(&me->params.jk, alpha, beta);
-			break;
-		case algChengBB:
-			CalcBBParams(&me->params.bb, alpha, beta);
-			break;
-		case algChengBC:
-			CalcBCParams(&me->params.bc, alpha, beta);
-			break;
-		default:
-			// No special parameter calculations for other generators
-			break;
+		if (whichAlg == algUndef) {
+			double	alpha	= me->alpha,
+					beta	= me->beta;
+			
+			whichAlg = me->whichAlg = RecommendBetaAlg(alpha, beta);
+			
+			switch (whichAlg) {
+			case algJoehnk:
+				CalcJKParams(&me->params.jk, alpha, beta);
+				break;
+			case algChengBB:
+				CalcBBParams(&me->params.bb, alpha, beta);
+				break;
+			case algChengBC:
+				CalcBCParams(&me->params.bc, alpha, beta);
+				break;
+			default:
+				// No special parameter calculations for other generators
+				break;
+				}
+			
 			}
 		
+		return whichAlg;
 		}
 	
-	// ASSERT: whichAlg != algUndef
-	switch (whichAlg) {
-		case algIndeterm:
-			randVal = 0.0;
-			if (((long) Taus88(me->tausData)) < 0) break;
-			// otherwise, fall into next case
-		case algConstOne:
-			randVal = 1.0;
-			break;
-		
-		case algConstZero:
-			randVal = 0.0;
-			break;
-		
-		case algUniform:
-			// a == b == 1: Uniform distribution
-			randVal = ULong2Unit_ZO( Taus88(me->tausData) );
-			break;
-		
-		case algArcSine:
-			// a == b == 0.5: Arc Sine distribution
-			randVal = GenArcsineTaus88(me->tausData);
-			break;
-		
-		case algJoehnk:
-			randVal = GenBetaJKTaus88(&me->params.jk, me->tausData);
-			break;
-		
-		case algChengBB:
-			randVal = GenBetaBBTaus88(&me->params.bb, me->tausData);
-			break;
+	static inline double NextDeviate(objBeta* me, eBetaAlg iAlg)
+		{
+		double randVal = 0.0;
 		
-		case algChengBC:
-			randVal = GenBetaBCTaus88(&me->params.bc, me->tausData);
-			break;
+		// ASSERT: iAlg != algUndef
+		switch (iAlg) {
+			case algIndeterm:
+				if (((long) Taus88(me->tausData)) < 0) break;
+				// otherwise, fall into next case
+			case algConstOne:
+				randVal = 1.0;
+				break;
+			
+			case algConstZero:
+				break;
+			
+			case algUniform:
+				// a == b == 1: Uniform distribution
+				randVal = ULong2Unit_ZO( Taus88(me->tausData) );
+				break;
+			
+			case algArcSine:
+				// a == b == 0.5: Arc Sine distribution
+				randVal = GenArcsineTaus88(me->tausData);
+				break;
+			
+			case algJoehnk:
+				randVal = GenBetaJKTaus88(&me->params.jk, me->tausData);
+				break;
+			
+			case algChengBB:
+				randVal = GenBetaBBTaus88(&me->params.bb, me->tausData);
+				break;
+			
+			case algChengBC:
+				randVal = GenBetaBCTaus88(&me->params.bc, me->tausData);
+				break;
+			
+			default:
+				// This can never happen
+			#if defined(__DEBUG__) && __DEBUG__
+				error("%s: unknown algorigthm %ld", kClassName, (long) iAlg);
+			#endif
+				break;
+			}
 		
-		default:
-			// This can never happen
-		#if defined(__DEBUG__) && __DEBUG__
-			error("%s: unknown algorigthm %ld", kClassName, (long) whichAlg);
-		#endif
-			return;						// Exit function early rather, 
-			break;
+		return randVal;
 		}
+	
+	static void DrawDeviates(objBeta* me, double oVals[], long iCount)
+		{
+		eBetaAlg	whichAlg = CheckAlg(me);
+		long		i;
 		
-	outlet_float(me->coreObject.o_outlet, randVal);
+		for (i = 0; i < iCount; i += 1)
+			oVals[i] = NextDeviate(me, whichAlg);
+		}
+
+static void
+AbbieBang(
+	objBeta* me)
 	
+	{
+	outlet_float(me->coreObject.o_outlet, NextDeviate(me, CheckAlg(me)));
+	}
+
+static void
+AbbieDraw(
+	objBeta*	me,
+	long		iCount,
+	Symbol*		iDest)
+	
+	{
+	DrawFloats(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawFloatFunc) DrawDeviates);
 	}
 
 
@@ -521,6 +554,7 @@ noMoreDefaults:
 	
 	// Store object components
 	me->tausData	= myTausStuff;
+	DrawInit(&me->drawBuf);
 	me->whichAlg	= algUndef;
 	AbbieAlpha(me, iAlpha);
 	AbbieBeta(me, iBeta);
@@ -529,7 +563,10 @@ noMoreDefaults:
 	}
 
 static void AbbieFree(objBeta* me)
-	{ Taus88Free(me->tausData); }							// Taus88Free is NIL-safe
+	{
+	Taus88Free(me->tausData);								// Taus88Free is NIL-safe
+	DrawFree(&me->drawBuf);
+	}
 
 
 #pragma mark -
@@ -570,6 +607,7 @@ main(void)
 	LitterAddMess1	((method) AbbieAlpha,	"ft1",	A_FLOAT);
 	LitterAddMess1	((method) AbbieBeta,	"ft2",	A_FLOAT);
 	LitterAddMess1	((method) AbbieSeed,	"seed",	A_DEFLONG);
+	LitterAddMess2	((method) AbbieDraw,	"draw",	A_LONG, A_DEFSYM);
 	LitterAddMess2	((method) AbbieTell,	"tell", A_SYM, A_SYM);
 	LitterAddMess0	((method) AbbieTattle,	"tattle");
 	LitterAddCant	((method) AbbieTattle,	"dblclick");
@@ -42,6 +42,7 @@
 #include "TrialPeriodUtils.h"
 #include "RNGChi2.h"
 #include "MoreMath.h"
+#include "DrawUtils.h"
 
 
 
@@ -97,13 +98,14 @@ typedef struct {
 	tTaus88DataPtr	tausData;
 	
 	UInt32			dof;			// Degrees of Freedom (nu)
-	double			scale,			// Normally unit except for scale-inverse
+	double			scale;			// Normally unit except for scale-inverse
 									// but we don't need to be fussy
-					gamma;			// Aux parameter used when using Rejection algorith
+	tChi2Params		params;			// Generator constants for the current dof
 									
 	Symbol*			varSym;			// Fast way to get name of variant
 	eDistVar		variant;		// More convenient for switch statements
-	eChi2Alg		alg;
+	
+	tDrawBuf		drawBuf;
 	} objChiSquare;
 
 
@@ -116,58 +118,72 @@ typedef struct {
 /******************************************************************************************
  *
  *	ChichiBang(me)
+ *	ChichiDraw(me, iCount, iDest)
+ *
+ *	ChichiDraw() sends iCount deviates as a single list, or writes them into the buffer~
+ *	or table named by iDest.
  *
  ******************************************************************************************/
 
+	static inline double NextDeviate(objChiSquare* me)
+		{
+		// Start off with Chi-Squared generation
+		double	result = GenChi2Taus88(&me->params, me->tausData);
+		
+		// We could shave off a few bytes of object code by restructuring the following as a 
+		// series of if/else statements, but the switch seems much easier to maintain.
+		switch (me->variant) {
+		default:
+			// Must be chi-square (chi2). Nothing more to do.
+			break;
+		
+		case distChi:
+			result = sqrt(result);
+			// ?? There is supposed to be a more efficient, direct algorithm for calculating
+			//		chi variates in John F Monahan (1987), "An algorithm for generating chi
+			//		random variables," ACM Transactions on Mathematical Software 13, pp168-171
+			//		(Corrections 1988, ibid., 14 p.111)
+			break;
+		
+		case distInv:
+			result = 1.0 / result;
+			break;
+		
+		case distScaleInv:
+			result = ((double) me->dof) / result;
+			break;
+			}
+		
+		result *= me->scale;
+		
+		return result;
+		}
+
 static void
 ChichiBang(
 	objChiSquare* me)
 	
 	{
-	double	result;
-	
-	// Start off with Chi-Squared generation
-	switch (me->alg) {
-	case algChi2Dir:
-		result = GenChi2DirTaus88(me->dof, me->tausData);
-		break;
-	case algChi2Rej:
-		result = GenChi2RejTaus88(me->dof, me->gamma, me->tausData);
-		break;
-	default:
-		// Must be algChi2Const0
-		result = 0.0;
-		break;
-		}
-	
-	// We could shave off a few bytes of object code by restructuring the following as a 
-	// series of if/else statements, but the switch seems much easier to maintain.
-	switch (me->variant) {
-	default:
-		// Must be chi-square (chi2). Nothing more to do.
-		break;
+	outlet_float(me->coreObject.o_outlet, NextDeviate(me));
+	}
+
+	static void DrawDeviates(objChiSquare* me, double oVals[], long iCount)
+		{
+		long i;
 		
-	case distChi:
-		result = sqrt(result);
-		// ?? There is supposed to be a more efficient, direct algorithm for calculating
-		//		chi variates in John F Monahan (1987), "An algorithm for generating chi
-		//		random variables," ACM Transactions on Mathematical Software 13, pp168-171
-		//		(Corrections 1988, ibid., 14 p.111)
-		break;
-	
-	case distInv:
-		result = 1.0 / result;
-		break;
-	
-	case distScaleInv:
-		result = ((double) me->dof) / result;
-		break;
+		for (i = 0; i < iCount; i += 1)
+			oVals[i] = NextDeviate(me);
 		}
+
+static void
+ChichiDraw(
+	objChiSquare*	me,
+	long			iCount,
+	Symbol*			iDest)
 	
-	result *= me->scale;
-	
-	outlet_float(me->coreObject.o_outlet, result);
-	
+	{
+	DrawFloats(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawFloatFunc) DrawDeviates);
 	}
 
 
@@ -188,11 +204,8 @@ ChichiDoF(
 	
 	{
 	if (iDoF > 0) {
-		 me->dof	= iDoF;
-		 me->alg	= Chi2RecommendAlg(iDoF);
-		 me->gamma	= (me->alg == algChi2Rej)
-		 				? CalcChi2RejGamma(iDoF)
-		 				: 0.0;
+		 me->dof = iDoF;
+		 CalcChi2Params(&me->params, iDoF);
 		 }
 	else error("%s: degrees of freedom must be positive", kClassName);
 	}
@@ -250,7 +263,10 @@ static void ChichiSeed(objChiSquare*	me, long iSeed)
  ******************************************************************************************/
 
 static void ChichiFree(objChiSquare* me)
-	{ Taus88Free(me->tausData); }							// Taus88Free is NIL-safe
+	{
+	Taus88Free(me->tausData);								// Taus88Free is NIL-safe
+	DrawFree(&me->drawBuf);
+	}
 
 static void*
 ChichiNew(
@@ -286,9 +302,10 @@ noMoreDefaults:
 	me->tausData	= myTausStuff;
 	me->dof			= kDefDoF;
 	me->scale		= kDefScale;
-	me->gamma		= 0.0;
+	CalcChi2Params(&me->params, kDefDoF);
 	me->variant		= kDefVariant;
 	me->varSym		= gensym(kDistSymNames[kDefVariant]);
+	DrawInit(&me->drawBuf);
 	
 	// Has the user overridden any of the defaults?
 	if (iDoF != kDefDoF)	ChichiDoF(me, iDoF);
@@ -726,6 +743,7 @@ main(void)
 	LitterAddMess1	((method) ChichiScale,	"scale",A_FLOAT);
 	LitterAddMess1	((method) ChichiVariant,"var",	A_SYM);
 	LitterAddMess1	((method) ChichiSeed,	"seed",	A_DEFLONG);
+	LitterAddMess2	((method) ChichiDraw,	"draw",	A_LONG, A_DEFSYM);
 	LitterAddMess2	((method) ChichiTell,	"tell", A_SYM, A_SYM);
 	LitterAddMess0	((method) ChichiTattle,	"tattle");
 	LitterAddCant	((method) ChichiTattle,	"dblclick");
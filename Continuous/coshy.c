@@ -34,6 +34,8 @@
 #include "TrialPeriodUtils.h"
 #include "RNGCauchy.h"
 #include "MiscUtils.h"
+#include "DrawUtils.h"
+#include "FastMath.h"
 
 
 #pragma mark • Constants
@@ -69,6 +71,9 @@ typedef struct {
 	double			tau,
 					loc;
 	eSymmetry		sym;		
+	long			exact;			// Draw with the RNGCauchy rejection generators
+	
+	tDrawBuf		drawBuf;
 	} objCauchy;
 
 
@@ -110,35 +115,94 @@ static void	CoshyInfo	(objCauchy*);
 /******************************************************************************************
  *
  *	CoshyBang(me)
+ *	CoshyDraw(me, iCount, iDest)
+ *
+ *	CoshyDraw() sends out iCount deviates in a single list; if iDest names a buffer~ or
+ *	table, they are written there instead.
+ *
+ *	For a block of deviates we invert the distribution function directly: tan(pi·(u-1/2))
+ *	for the symmetric case, tan(pi·u/2) when folded to one side. With FastTanPi() the
+ *	whole chunk is transformed in one vectorizable loop, which beats the rejection methods
+ *	in RNGCauchy. One deviate at a time, though, the rejection methods are cheaper (they
+ *	don't call libm either), so CoshyBang() always uses them. Setting the exact attribute
+ *	makes CoshyDraw() use them too, giving the same values as a series of bangs.
  *
  ******************************************************************************************/
 
+	static inline double NextDeviate(objCauchy* me)
+		{
+		double	cauchy,
+				scale	= me->tau,
+				loc		= me->loc;
+		
+		switch (me->sym) {
+		case symNeg:
+			scale *= -1.0;
+			// fall into next case...
+		case symPos:
+			cauchy = GenCauchyPosTaus88(me->tausData);
+			break;
+		
+		default:
+			// must be symSym...
+			cauchy = GenCauchyStdTaus88(me->tausData);
+			break;
+			}
+		
+		cauchy *= scale;
+		cauchy += loc;
+		return cauchy;
+		}
+
 static void
 CoshyBang(
 	objCauchy* me)
 	
 	{
-	double	cauchy,
-			scale	= me->tau,
-			loc		= me->loc;
-	
-	switch (me->sym) {
-	case symNeg:
-		scale *= -1.0;
-		// fall into next case...
-	case symPos:
-		cauchy = GenCauchyPosTaus88(me->tausData);
-		break;
-	
-	default:
-		// must be symSym...
-		cauchy = GenCauchyStdTaus88(me->tausData);
-		break;
+	outlet_float(me->coreObject.o_outlet, NextDeviate(me));
+	}
+
+	static void DrawDeviates(objCauchy* me, double oVals[], long iCount)
+		{
+		tTaus88DataPtr	tausData	= me->tausData;
+		double			scale		= me->tau,
+						loc			= me->loc;
+		UInt32			s1, s2, s3;
+		long			i;
+		
+		if (me->exact) {
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = NextDeviate(me);
+			return;
+			}
+		
+		if (tausData == NIL)
+			tausData = Taus88GetGlobals();
+		Taus88Load(tausData, &s1, &s2, &s3);
+		for (i = 0; i < iCount; i += 1)
+			oVals[i] = ULong2Unit_zo( Taus88Process(&s1, &s2, &s3) );
+		Taus88Store(tausData, s1, s2, s3);
+		
+		if (me->sym == symSym)
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = FastTanPi(oVals[i] - 0.5) * scale + loc;
+		else {
+			if (me->sym == symNeg)
+				scale *= -1.0;
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = FastTanPi(0.5 * oVals[i]) * scale + loc;
+			}
 		}
+
+static void
+CoshyDraw(
+	objCauchy*	me,
+	long		iCount,
+	Symbol*		iDest)
 	
-	cauchy *= scale;
-	cauchy += loc;
-	outlet_float(me->coreObject.o_outlet, cauchy);
+	{
+	DrawFloats(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawFloatFunc) DrawDeviates);
 	}
 
 
@@ -167,12 +231,16 @@ static void CoshyNeg(objCauchy* me)		{ me->sym = symNeg; }
 /******************************************************************************************
  *
  *	CoshySeed(me, iSeed)
+ *	CoshyExact(me, iExact)
  *
  ******************************************************************************************/
 
 static void CoshySeed(objCauchy* me, long iSeed)
 	{ Taus88Seed(me->tausData, (unsigned long) iSeed); }
 
+static void CoshyExact(objCauchy* me, long iExact)
+	{ me->exact = (iExact != 0); }
+
 
 #pragma mark -
 #pragma mark • Attribute/Information Functions
@@ -321,12 +389,15 @@ DoExpect(
 		{
 		Object*	attr;
 		Symbol*	symFloat64		= gensym("float64");
+		Symbol*	symLong			= gensym("long");
 		
 		// Read-Write Attributes
 		attr = attr_offset_new("tau", symFloat64, 0, NIL, NIL, calcoffset(objCauchy, tau));
 		class_addattr(gObjectClass, attr);
 		attr = attr_offset_new("loc", symFloat64, 0, NIL, NIL, calcoffset(objCauchy, loc));
 		class_addattr(gObjectClass, attr);
+		attr = attr_offset_new("exact", symLong, 0, NIL, NIL, calcoffset(objCauchy, exact));
+		class_addattr(gObjectClass, attr);
 		
 		// Read-Only Attributes
 //		attr = attribute_new("min", symFloat64, kAttrFlagsReadOnly, (method) CoshyGetMin, NULL);
@@ -391,7 +462,10 @@ static void CoshyTell(objCauchy* me, Symbol* iTarget, Symbol* iAttrName)
  ******************************************************************************************/
 
 static void CoshyFree(objCauchy* me)
-	{ Taus88Free(me->tausData); }							// Taus88Free is NIL-safe
+	{
+	Taus88Free(me->tausData);								// Taus88Free is NIL-safe
+	DrawFree(&me->drawBuf);
+	}
 
 static void*
 CoshyNew(
@@ -431,6 +505,8 @@ noMoreDefaults:
 	
 	// Store object components
 	me->tausData	= myTTStuff;
+	me->exact		= false;
+	DrawInit(&me->drawBuf);
 	me->tau			= iTau;
 	me->loc			= kDefLoc;
 	
@@ -485,6 +561,8 @@ main(void)
 	LitterAddMess1	((method) CoshyTau,	"ft1",		A_FLOAT);
 	LitterAddMess1	((method) CoshyLoc,	"ft2",		A_FLOAT);
 	LitterAddMess1	((method) CoshySeed,"seed",		A_DEFLONG);
+	LitterAddMess2	((method) CoshyDraw,"draw",		A_LONG, A_DEFSYM);
+	LitterAddMess1	((method) CoshyExact,"exact",	A_DEFLONG);
 	LitterAddMess0	((method) CoshySym,	"sym");
 	LitterAddMess0	((method) CoshyPos,	"pos");
 	LitterAddMess0	((method) CoshyNeg,	"neg");
@@ -34,6 +34,7 @@
 #include "TrialPeriodUtils.h"
 #include "Taus88.h"
 #include "MiscUtils.h"
+#include "DrawUtils.h"
 
 #include <math.h>
 
@@ -68,6 +69,8 @@ typedef struct {
 	double			tau,					// = 1/lambda	
 					loc;					
 	eSymmetry		sym;
+	
+	tDrawBuf		drawBuf;
 	} objExpran;
 
 
@@ -88,8 +91,12 @@ SymbolPtr	gSymSymbol	= NIL,
 /******************************************************************************************
  *
  *	ExpoBang(me)
+ *	ExpoDraw(me, iCount, iDest)
  *	ExpoFloat(me)
  *
+ *	ExpoDraw() produces iCount deviates at a go, as a list or written to the buffer~ or
+ *	table named by iDest. The Taus88 seeds stay in registers for the whole block.
+ *
  ******************************************************************************************/
 
 static void
@@ -117,6 +124,54 @@ ExpoBang(
 	
 	}
 
+	static void DrawDeviates(objExpran* me, double oVals[], long iCount)
+		{
+		tTaus88DataPtr	tausData	= me->tausData;
+		double			tau			= me->tau,
+						loc			= me->loc;
+		UInt32			s1, s2, s3;
+		long			i;
+		
+		if (tau <= 0.0) {
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = tau + loc;
+			return;
+			}
+		
+		if (tausData == NIL)
+			tausData = Taus88GetGlobals();
+		Taus88Load(tausData, &s1, &s2, &s3);
+		
+		if (me->sym == symSym) {
+			for (i = 0; i < iCount; i += 1) {
+				double u = ULong2Unit_zO( Taus88Process(&s1, &s2, &s3) );
+				
+				oVals[i] = tau * Unit2Laplace(u) + loc;
+				}
+			}
+		else {
+			tau *= me->sym;
+			for (i = 0; i < iCount; i += 1) {
+				double u = ULong2Unit_zO( Taus88Process(&s1, &s2, &s3) );
+				
+				oVals[i] = tau * Unit2Exponential(u) + loc;
+				}
+			}
+		
+		Taus88Store(tausData, s1, s2, s3);
+		}
+
+static void
+ExpoDraw(
+	objExpran*	me,
+	long		iCount,
+	Symbol*		iDest)
+	
+	{
+	DrawFloats(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawFloatFunc) DrawDeviates);
+	}
+
 static void
 ExpoFloat(
 	objExpran*	me,
@@ -184,7 +239,10 @@ static void ExpoSeed(objExpran* me, long iSeed)
  ******************************************************************************************/
 
 static void ExpoFree(objExpran* me)
-	{ Taus88Free(me->tausData); }							// Taus88Free is NIL-safe
+	{
+	Taus88Free(me->tausData);								// Taus88Free is NIL-safe
+	DrawFree(&me->drawBuf);
+	}
 
 static void*
 ExpoNew(
@@ -223,6 +281,7 @@ noMoreDefaults:
 	
 	// Store object components
 	me->tausData	= myTausStuff;
+	DrawInit(&me->drawBuf);
 	ExpoLamda(me, iLambda);				// Lamda defaults to 1.0
 		// The following would be sort of nicer with a switch, but C can't switch against
 		// values not known at compile time
@@ -547,6 +606,7 @@ main(void)
 	LitterAddMess0	((method) ExpoPos,		"pos");
 	LitterAddMess0	((method) ExpoNeg,		"neg");
 	LitterAddMess1	((method) ExpoSeed,		"seed",	A_DEFLONG);
+	LitterAddMess2	((method) ExpoDraw,		"draw",	A_LONG, A_DEFSYM);
 	LitterAddMess2	((method) ExpoTell,		"tell", A_SYM, A_SYM);
 	LitterAddCant	((method) ExpoTattle,	"dblclick");
 	LitterAddMess0	((method) ExpoTattle,	"tattle");
@@ -33,6 +33,7 @@
 #include "TrialPeriodUtils.h"
 #include "Taus88.h"
 #include "RNGChi2.h"
+#include "DrawUtils.h"
 
 
 #pragma mark • Constants
@@ -64,12 +65,12 @@ typedef struct {
 	UInt32			dof1,
 					dof2;
 	double			dofInv1,
-					dofInv2,
-					gamma1,				// Gammas are an auxiliary value needed for large
-					gamma2;				// values for Degrees of Freedom
+					dofInv2;
 	
-	eChi2Alg		alg1,
-					alg2;	
+	tChi2Params		params1,			// Chi-square generator constants for
+					params2;			// numerator and denominator
+	
+	tDrawBuf		drawBuf;
 	} objFisher;
 
 
@@ -82,26 +83,50 @@ typedef struct {
 /******************************************************************************************
  *
  *	FishieBang(me)
+ *	FishieDraw(me, iCount, iDest)
+ *
+ *	FishieDraw() sends iCount variates as one list, or writes them into the buffer~ or
+ *	table named by iDest.
  *
  ******************************************************************************************/
 
+	static inline double NextDeviate(objFisher* me)
+		{
+		tTaus88DataPtr	tausData = me->tausData;
+		double			fish1	= GenChi2Taus88(&me->params1, tausData),
+						fish2	= GenChi2Taus88(&me->params2, tausData);
+		
+		fish1 *= me->dofInv1;
+		fish2 *= me->dofInv2;
+		
+		return fish1 / fish2;
+		}
+
 static void
 FishieBang(
 	objFisher* me)
 	
 	{
-	tTaus88DataPtr	tausData = me->tausData;
-	double			fish1	= (me->alg1 == algChi2Dir)
-									? GenChi2DirTaus88(me->dof1, tausData)
-									: GenChi2RejTaus88(me->dof1, me->gamma1, tausData),
-					fish2	= (me->alg2 == algChi2Dir)
-									? GenChi2DirTaus88(me->dof2, tausData)
-									: GenChi2RejTaus88(me->dof2, me->gamma2, tausData);
-	
-	fish1 *= me->dofInv1;
-	fish2 *= me->dofInv2;
-	
-	outlet_float(me->coreObject.o_outlet, fish1 / fish2);
+	outlet_float(me->coreObject.o_outlet, NextDeviate(me));
+	}
+
+	static void DrawDeviates(objFisher* me, double oVals[], long iCount)
+		{
+		long i;
+		
+		for (i = 0; i < iCount; i += 1)
+			oVals[i] = NextDeviate(me);
+		}
+
+static void
+FishieDraw(
+	objFisher*	me,
+	long		iCount,
+	Symbol*		iDest)
+	
+	{
+	DrawFloats(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawFloatFunc) DrawDeviates);
 	}
 
 
@@ -119,27 +144,24 @@ FishieBang(
  ******************************************************************************************/
 
 	static inline void
-	UpdateDoF(long iDoF, UInt32* oStore, eChi2Alg* oAlg, double* oGamma, double* oInv)
+	UpdateDoF(long iDoF, UInt32* oStore, tChi2Params* oParams, double* oInv)
 		{
-		eChi2Alg	alg;
 		
 		// Sanity check
 		if (iDoF <= 0)	iDoF = 1;
 		
-		alg = Chi2RecommendAlg(iDoF);
+		CalcChi2Params(oParams, iDoF);
 		
 		*oStore	= iDoF;
-		*oAlg	= alg;
-		*oGamma	= (alg == algChi2Rej) ? CalcChi2RejGamma(iDoF) : 0.0;
 		*oInv	= 1.0 / (double) iDoF;
 		
 		}
 
 static void FishieF1(objFisher* me, long iF1)
-	{ UpdateDoF(iF1, &me->dof1, &me->alg1, &me->gamma1, &me->dofInv1); }
+	{ UpdateDoF(iF1, &me->dof1, &me->params1, &me->dofInv1); }
 	
 static void FishieF2(objFisher* me, long iF2)
-	{ UpdateDoF(iF2, &me->dof2, &me->alg2, &me->gamma2, &me->dofInv2); }
+	{ UpdateDoF(iF2, &me->dof2, &me->params2, &me->dofInv2); }
 	
 
 static void FishieSeed	(objFisher*	me, long iSeed)
@@ -165,9 +187,8 @@ FishieTattle(
 	post("  Degrees of Freedom: %ld, %ld", me->dof1, me->dof2);
 	post("  Inverses: % lf, %lf", me->dofInv1, me->dofInv2);
 	post("  Algorithms: %s and %s",
-			(me->alg1 == algChi2Dir) ? "direct" : "rejection",
-			(me->alg2 == algChi2Dir) ? "direct" : "rejection");
-	post("  Gamma values (if applicable): % lf, %lf", me->gamma1, me->gamma2);
+			(me->params1.alg == algChi2Dir) ? "direct" : "Marsaglia-Tsang",
+			(me->params2.alg == algChi2Dir) ? "direct" : "Marsaglia-Tsang");
 	}
 
 static void FishieAssist(objFisher* me, void* box, long iDir, long iArgNum, char* oCStr)
@@ -367,7 +388,10 @@ void FishieTell(objFisher* me, Symbol* iTarget, Symbol* iAttrName)
  ******************************************************************************************/
 
 static void FishieFree(objFisher* me)
-	{ Taus88Free(me->tausData); }							// Taus88Free is NIL-safe
+	{
+	Taus88Free(me->tausData);								// Taus88Free is NIL-safe
+	DrawFree(&me->drawBuf);
+	}
 
 static void*
 FishieNew(
@@ -406,6 +430,7 @@ noMoreDefaults:
 	
 	// Store object components
 	me->tausData	= myTausStuff;
+	DrawInit(&me->drawBuf);
 	FishieF1(me, iDoF1);
 	FishieF2(me, iDoF2);
 	
@@ -450,6 +475,7 @@ main(void)
 	LitterAddMess1	((method) FishieF1,		"in1",		A_LONG);
 	LitterAddMess1	((method) FishieF2,		"in2",		A_LONG);
 	LitterAddMess1 ((method) FishieSeed,	"seed",		A_DEFLONG);
+	LitterAddMess2	((method) FishieDraw,	"draw",		A_LONG, A_DEFSYM);
 	LitterAddMess2 ((method) FishieTell,	"tell", A_SYM, A_SYM);
 	LitterAddMess0	((method) FishieTattle,	"tattle");
 	LitterAddCant	((method) FishieTattle,	"dblclick");
@@ -44,6 +44,7 @@
 #include "RNGGamma.h"
 #include "MiscUtils.h"
 #include "MoreMath.h"
+#include "DrawUtils.h"
 
 
 #pragma mark • Constants
@@ -94,6 +95,7 @@ typedef union {
 		tErlRejParams	er;
 		tGammaGSParams	gs;
 		tGammaGDParams	gd;
+		tGammaMTParams	mt;
 		} uGammerParams;
 
 		
@@ -106,6 +108,8 @@ typedef struct {
 	
 	eGammaAlg		alg;
 	uGammerParams	params;
+	
+	tDrawBuf		drawBuf;
 	} objGammer;
 
 
@@ -129,6 +133,7 @@ GammerGetAlpha(
 		case algErlRej:	alpha = me->params.er.alpha;	break;
 		case algGS:		alpha = me->params.gs.alpha;	break;
 		case algGD:		alpha = me->params.gd.alpha;	break;
+		case algMT:		alpha = me->params.mt.alpha;	break;
 		default:		alpha = 0.0;					break;	/* This can't happen */
 		}
 	
@@ -148,6 +153,7 @@ GammerGetBeta(
 		case algErlRej:	beta = me->params.er.beta;		break;
 		case algGS:		beta = me->params.gs.beta;		break;
 		case algGD:		beta = me->params.gd.beta;		break;
+		case algMT:		beta = me->params.mt.beta;		break;
 		default:		beta = 0.0;						break;	/* This can't happen */
 		}
 	
@@ -162,48 +168,80 @@ GammerGetBeta(
 /******************************************************************************************
  *
  *	GammerBang(me)
+ *	GammerDraw(me, iCount, iDest)
+ *
+ *	GammerDraw() sends iCount deviates as a single list, or writes them straight into the
+ *	buffer~ or table named by iDest.
  *
  ******************************************************************************************/		
 
+	static inline double NextDeviate(objGammer* me)
+		{
+		double	g;
+		
+		switch (me->alg) {
+		case algErlDir:
+			g = GerErlangDirTaus88(	me->params.ed.alpha,
+									me->params.ed.beta,
+									me->theData);
+			break;
+		
+		case algErlRej:
+			g = GenErlangRejTaus88(	me->params.er.alpha,
+									me->params.er.beta,
+									me->params.er.gamma,
+									me->theData);
+			break;
+		
+		case algGS:
+			g = GenGammaGSTaus88(	me->params.gs.alpha,
+									me->params.gs.beta,
+									me->params.gs.gamma,
+									me->theData);
+			break;
+		
+		case algGD:
+			g = GenGammaGDTaus88(&me->params.gd, me->theData);
+			break;
+		
+		case algMT:
+			g = GenGammaMTTaus88(&me->params.mt, me->theData);
+			break;
+		
+		default:
+			// Must be algUndef. Degenerate case
+			g = 0.0;
+			break;
+			}
+		
+		return g;
+		}
+
 static void
 GammerBang(
 	objGammer* me)
 	
 	{
-	double	g;
-	
-	switch (me->alg) {
-	case algErlDir:
-		g = GerErlangDirTaus88(	me->params.ed.alpha,
-								me->params.ed.beta,
-								me->theData);
-		break;
-	
-	case algErlRej:
-		g = GenErlangRejTaus88(	me->params.er.alpha,
-								me->params.er.beta,
-								me->params.er.gamma,
-								me->theData);
-		break;
-	
-	case algGS:
-		g = GenGammaGSTaus88(	me->params.gs.alpha,
-								me->params.gs.beta,
-								me->params.gs.gamma,
-								me->theData);
-		break;
-	
-	case algGD:
-		g = GenGammaGDTaus88(&me->params.gd, me->theData);
-		break;
-	
-	default:
-		// Must be algUndef. Degenerate case
-		g = 0.0;
-		break;
-		}
+	outlet_float(me->coreObject.o_outlet, NextDeviate(me));
+	}
+
+	static void DrawDeviates(objGammer* me, double oVals[], long iCount)
+		{
+		long i;
 		
-	outlet_float(me->coreObject.o_outlet, g);
+		for (i = 0; i < iCount; i += 1)
+			oVals[i] = NextDeviate(me);
+		}
+
+static void
+GammerDraw(
+	objGammer*	me,
+	long		iCount,
+	Symbol*		iDest)
+	
+	{
+	DrawFloats(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawFloatFunc) DrawDeviates);
 	}
 
 
@@ -239,7 +277,6 @@ GammerOrder(
 		me->params.er.gamma	= CalcErlangRejGamma(me->params.er.alpha);
 				// The above assumes that it's cheaper to read from memory than
 				// to perform double-to-int conversion twice. I might be wrong.
-post("GammerOrder setting gamma to %lf", CalcErlangRejGamma(me->params.er.alpha));
 		break;
 	
 	case algGS:
@@ -251,6 +288,11 @@ post("GammerOrder setting gamma to %lf", CalcErlangRejGamma(me->params.er.alpha)
 	case algGD:
 		CalcGDParams(&me->params.gd, iOrder, beta);
 		break;
+	
+	case algMT:
+		CalcMTParams(&me->params.mt, iOrder, beta);
+		break;
+	
 	default:
 		// This can't happen
 		break;
@@ -267,6 +309,7 @@ static void GammerBeta(objGammer* me, double iBeta)
 		case algErlRej:	me->params.er.beta = iBeta;		break;
 		case algGS:		me->params.gs.beta = iBeta;		break;
 		case algGD:		me->params.gd.beta = iBeta;		break;
+		case algMT:		me->params.mt.beta = iBeta;		break;
 		default:			/* no other cases */		break;
 		}
 	
@@ -315,7 +358,8 @@ GammerAssist(
 	if (iDir == ASSIST_INLET)
 		LitterAssist(iDir, iArgNum, strIndexLeftInlet, 0, oCStr);
 	else {
-		short fragIndex = (me->alg == algErlDir || me->alg == algErlRej)
+		double	alpha		= GammerGetAlpha(me);
+		short	fragIndex	= (alpha == floor(alpha))
 									? strIndexFragErlang
 									: strIndexFragGamma;
 		
@@ -366,6 +410,14 @@ GammerTattle(
 		post("  c      = %lf", me->params.gd.c);
 		break;
 	
+	case algMT:
+		post("  Gamma distribution; using Marsaglia-Tsang algorithm");
+		post("  alpha = %lg", me->params.mt.alpha);
+		post("  beta  = %lf", me->params.mt.beta);
+		post("  d     = %lf", me->params.mt.d);
+		post("  c     = %lf", me->params.mt.c);
+		break;
+	
 	default:
 		// Must be algNone (i.e., bad alpha parameter)
 		post("   Invalid data entered for alpha; degenerate distribution");
@@ -562,7 +614,10 @@ void GammerTell(objGammer* me, Symbol* iTarget, Symbol* iAttrName)
 
 static void
 GammerFree(objGammer* me)
-	{ Taus88Free(me->theData); }						// Taus88Free() is NIL-pointer safe
+	{
+	Taus88Free(me->theData);							// Taus88Free() is NIL-pointer safe
+	DrawFree(&me->drawBuf);
+	}
 
 static void*
 GammerNew(
@@ -604,6 +659,7 @@ GammerNew(
 	
 	// Initialize object components
 	me->theData = myTausStuff;
+	DrawInit(&me->drawBuf);
 	GammerOrder(me, iOrder);
 	GammerLoc(me, iLoc);
 	
@@ -648,6 +704,7 @@ main(void)
 	LitterAddMess1	((method) GammerBeta,	"ft2",	A_FLOAT);
 	LitterAddMess1	((method) GammerLoc,	"loc",	A_FLOAT);
 	LitterAddMess1	((method) GammerSeed,	"seed",	A_DEFLONG);
+	LitterAddMess2	((method) GammerDraw,	"draw",	A_LONG, A_DEFSYM);
 	LitterAddMess2	((method) GammerTell,	"tell", A_SYM, A_SYM);
 	LitterAddCant	((method) GammerTattle,	"dblclick");
 	LitterAddCant	((method) GammerAssist,	"assist");
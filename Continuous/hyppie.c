@@ -39,6 +39,8 @@
 #include "TrialPeriodUtils.h"
 #include "Taus88.h"
 #include "MiscUtils.h"
+#include "DrawUtils.h"
+#include "FastMath.h"
 
 
 #pragma mark • Constants
@@ -74,6 +76,9 @@ typedef struct {
 	tTaus88DataPtr	tausData;
 	
 	eHypVar			variant;
+	long			exact;					// Use libm for log, tan, asinh
+	
+	tDrawBuf		drawBuf;
 	} objHyperan;
 
 
@@ -86,8 +91,18 @@ typedef struct {
 /******************************************************************************************
  *
  *	HyppieBang(me)
+ *	HyppieDraw(me, iCount, iDest)
  *	HyppieFloat(me, iVal)
  *
+ *	HyppieDraw() sends iCount deviates as a single list (or into the buffer~ or table
+ *	named by iDest), keeping the Taus88 seeds in registers throughout. HyppieBang() draws
+ *	a single deviate the same way.
+ *
+ *	Unless the exact attribute is set, the inversions are evaluated with the FastMath.h
+ *	functions in a second pass over the chunk. For 0 < x < 1, asinh(cot(pi·x)) is the
+ *	same as log(cot(pi·x/2)) = -log(tan(pi·x/2)), so both variants come down to
+ *	log(tan(pi·x/2)), the secant variant scaled by 2/pi. HyppieFloat() always uses libm.
+ *
  ******************************************************************************************/
 
 	static double CalcHypercos(double x)
@@ -95,19 +110,59 @@ typedef struct {
 	
 	static double CalcHypersec(double x)
 		{ return (-2.0 / kPi) * asinh(1.0 / tan(kPi * x)); }
+	
+	static void DrawDeviates(objHyperan* me, double oVals[], long iCount)
+		{
+		tTaus88DataPtr	tausData	= me->tausData;
+		UInt32			s1, s2, s3;
+		long			i;
+		
+		if (tausData == NIL)
+			tausData = Taus88GetGlobals();
+		Taus88Load(tausData, &s1, &s2, &s3);
+		
+		if (me->exact) {
+			if (me->variant == hypCos)
+				for (i = 0; i < iCount; i += 1)
+					oVals[i] = CalcHypercos( ULong2Unit_zo(Taus88Process(&s1, &s2, &s3)) );
+			else for (i = 0; i < iCount; i += 1)
+					oVals[i] = CalcHypersec( ULong2Unit_zo(Taus88Process(&s1, &s2, &s3)) );
+			}
+		
+		else {
+			double scale = (me->variant == hypCos) ? 1.0 : 2.0 / kPi;
+			
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = ULong2Unit_zo(Taus88Process(&s1, &s2, &s3));
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = scale * FastLog(FastTanPi(0.5 * oVals[i]));
+			}
+		
+		Taus88Store(tausData, s1, s2, s3);
+		}
 
 static void
 HyppieBang(
 	objHyperan* me)
 	
 	{
-	double h = ULong2Unit_zo(Taus88(me->tausData));
-	
-	h = (me->variant == hypCos) ? CalcHypercos(h) : CalcHypersec(h);
+	double h;
 	
+	DrawDeviates(me, &h, 1);
 	outlet_float(me->coreObject.o_outlet, h);
 	}
 
+static void
+HyppieDraw(
+	objHyperan*	me,
+	long		iCount,
+	Symbol*		iDest)
+	
+	{
+	DrawFloats(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawFloatFunc) DrawDeviates);
+	}
+
 static void
 HyppieFloat(
 	objHyperan*	me,
@@ -135,12 +190,16 @@ static void HyppieSec(objHyperan* me)		{ me->variant = hypSec; }
 /******************************************************************************************
  *
  *	HyppieSeed(me, iSeed)
+ *	HyppieExact(me, iExact)
  *
  ******************************************************************************************/
 
 static void HyppieSeed(objHyperan* me, long iSeed)
 	{ Taus88Seed(me->tausData, (unsigned long) iSeed); }
 
+static void HyppieExact(objHyperan* me, long iExact)
+	{ me->exact = (iExact != 0); }
+
 
 #pragma mark -
 #pragma mark • Attribute/Information Functions
@@ -279,6 +338,12 @@ static double DoExpect(objHyperan* me, eExpectSelector iSel)
 		{
 		Object*	attr;
 		Symbol*	symFloat64		= gensym("float64");
+		Symbol*	symLong			= gensym("long");
+		
+		// Read-Write Attributes
+		attr = attr_offset_new(	"exact", symLong, 0,
+								NULL, NULL, calcoffset(objHyperan, exact));
+		class_addattr(gObjectClass, attr);
 		
 		// Read-Only Attributes
 		attr = attribute_new("min", symFloat64, kAttrFlagsReadOnly, (method) HyppieGetMin, NULL);
@@ -346,7 +411,10 @@ static void HyppieTell(objHyperan* me, Symbol* iTarget, Symbol* iAttrName)
  ******************************************************************************************/
 
 static void HyppieFree(objHyperan* me)
-	{ Taus88Free(me->tausData); }							// Taus88Free is NIL-safe
+	{
+	Taus88Free(me->tausData);								// Taus88Free is NIL-safe
+	DrawFree(&me->drawBuf);
+	}
 
 static void*
 HyppieNew(
@@ -370,6 +438,8 @@ noMoreDefaults:
 	
 	// Store object components
 	me->tausData	= myTausStuff;
+	me->exact		= false;
+	DrawInit(&me->drawBuf);
 	me->variant		= hypCos;
 	
 	return me;
@@ -419,6 +489,8 @@ main(void)
 	LitterAddMess0	((method) HyppieCos,	"cos");
 	LitterAddMess0	((method) HyppieSec,	"sec");
 	LitterAddMess1	((method) HyppieSeed,	"seed",	A_DEFLONG);
+	LitterAddMess2	((method) HyppieDraw,	"draw",	A_LONG, A_DEFSYM);
+	LitterAddMess1	((method) HyppieExact,	"exact", A_DEFLONG);
 	LitterAddMess2	((method) HyppieTell,	"tell", A_SYM, A_SYM);
 	LitterAddCant	((method) HyppieTattle,	"dblclick");
 	LitterAddMess0	((method) HyppieTattle,	"tattle");
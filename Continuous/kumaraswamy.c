@@ -24,6 +24,8 @@
 #include "Taus88.h"
 #include "MiscUtils.h"
 #include "UniformExpectations.h"
+#include "DrawUtils.h"
+#include "FastMath.h"
 
 #include <math.h>
 
@@ -78,6 +80,9 @@ typedef struct {
 					beta1;
 	
 	eSpecialCase	exception;
+	long			exact;				// Nonzero: pow() from libm
+	
+	tDrawBuf		drawBuf;
 	} objSwamy;
 
 
@@ -90,36 +95,81 @@ typedef struct {
 /******************************************************************************************
  *
  *	SwamyBang(me)
+ *	SwamyDraw(me, iCount, iDest)
+ *
+ *	SwamyDraw() generates iCount deviates with a single load/store of the Taus88 seeds
+ *	and sends them as a list, or writes them into the buffer~ or table named by iDest.
+ *	SwamyBang() asks for exactly one.
+ *
+ *	In the general case both powers are taken with FastPow() in a loop of their own,
+ *	after the uniform deviates for the chunk are in place. With the exact attribute set
+ *	libm's pow() is called per deviate instead.
  *
  ******************************************************************************************/
 
+	static void DrawDeviates(objSwamy* me, double oVals[], long iCount)
+		{
+		tTaus88DataPtr	tausData	= me->tausData;
+		double			a1			= me->alpha1,
+						b1			= me->beta1;
+		UInt32			s1, s2, s3;
+		long			i;
+		
+		if (tausData == NIL)
+			tausData = Taus88GetGlobals();
+		Taus88Load(tausData, &s1, &s2, &s3);
+		
+		if (a1 == 0.0) {
+			if (b1 == 0.0)
+				for (i = 0; i < iCount; i += 1)
+					oVals[i] = (double) (Taus88Process(&s1, &s2, &s3) & 0x01);
+			else for (i = 0; i < iCount; i += 1)
+					oVals[i] = 1.0;
+			}
+		
+		else if (b1 == 0.0)
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = 0.0;
+		
+		else if (me->exact)
+			for (i = 0; i < iCount; i += 1) {
+				double k = ULong2Unit_ZO( Taus88Process(&s1, &s2, &s3) );
+				
+				oVals[i] = pow(1.0 - pow(k, b1), a1);
+				}
+		
+		else {
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = ULong2Unit_ZO( Taus88Process(&s1, &s2, &s3) );
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = FastPow(1.0 - FastPow(oVals[i], b1), a1);
+			}
+		
+		Taus88Store(tausData, s1, s2, s3);
+		}
 
 static void
 SwamyBang(
 	objSwamy* me)
 	
 	{
-	double	k,
-			a1 = me->alpha1,			// Per convention, if alpha/beta were set to zero
-			b1 = me->beta1;				// then alpha1 and beta1 are also zeroed
-	
-	if (a1 == 0.0)
-		k = (b1 == 0.0)
-			? (double) (Taus88(me->tausData) & 0x01)
-			: 1.0;
-	
-	else if (b1 == 0.0)
-		k = 0.0;
-	
-	else {
-		k = ULong2Unit_ZO(Taus88(me->tausData));
-		
-		k = pow(1.0 - pow(k, b1), a1);
-		}
+	double k;
 	
+	DrawDeviates(me, &k, 1);
 	outlet_float(me->coreObject.o_outlet, k);
 	}
 
+static void
+SwamyDraw(
+	objSwamy*	me,
+	long		iCount,
+	Symbol*		iDest)
+	
+	{
+	DrawFloats(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawFloatFunc) DrawDeviates);
+	}
+
 
 /******************************************************************************************
  *
@@ -185,12 +235,16 @@ SwamyBeta(
 /******************************************************************************************
  *
  *	SwamySeed(me, iSeed)
+ *	SwamyExact(me, iExact)
  *
  ******************************************************************************************/
 
 static void SwamySeed(objSwamy* me,long iSeed)
 	{ Taus88Seed(me->tausData, (unsigned long) iSeed); }
 
+static void SwamyExact(objSwamy* me, long iExact)
+	{ me->exact = (iExact != 0); }
+
 #pragma mark -
 #pragma mark • Attribute/Information Functions
 
@@ -400,6 +454,7 @@ DoExpect(objSwamy* me, eExpectSelector iSel)
 		{
 		Object*	attr;
 		Symbol*	symFloat64		= gensym("float64");
+		Symbol*	symLong			= gensym("long");
 		
 		// Read-Write Attributes
 		attr = attr_offset_new(	"alpha", symFloat64, 0,
@@ -410,6 +465,9 @@ DoExpect(objSwamy* me, eExpectSelector iSel)
 								NULL, (method) SwamySetAttrBeta,
 								calcoffset(objSwamy, beta));
 		class_addattr(gObjectClass, attr);
+		attr = attr_offset_new(	"exact", symLong, 0,
+								NULL, NULL, calcoffset(objSwamy, exact));
+		class_addattr(gObjectClass, attr);
 		
 		// Read-Only Attributes
 		attr = attribute_new("min", symFloat64, kAttrFlagsReadOnly, (method) SwamyGetMin, NULL);
@@ -475,7 +533,10 @@ static void SwamyTell(objSwamy* me, Symbol* iTarget, Symbol* iAttrName)
 
 static void
 SwamyFree(objSwamy* me)
-	{ Taus88Free(me->tausData); }						// Taus88Free() is NIL-pointer safe
+	{
+	Taus88Free(me->tausData);							// Taus88Free() is NIL-pointer safe
+	DrawFree(&me->drawBuf);
+	}
 
 static void*
 SwamyNew(
@@ -498,6 +559,8 @@ SwamyNew(
 	
 	// Initialize object components
 	me->tausData	= NIL;
+	me->exact		= false;
+	DrawInit(&me->drawBuf);
 	me->alpha		= kDefParam;
 	me->alpha1		= 1.0 / kDefParam;
 	me->beta		= kDefParam;
@@ -554,6 +617,8 @@ main(void)
 	LitterAddMess1	((method) SwamyAlpha,	"ft1",	A_FLOAT);
 	LitterAddMess1	((method) SwamyBeta,	"ft2",	A_FLOAT);
 	LitterAddMess1	((method) SwamySeed,	"seed",	A_DEFLONG);
+	LitterAddMess2	((method) SwamyDraw,	"draw",	A_LONG, A_DEFSYM);
+	LitterAddMess1	((method) SwamyExact,	"exact", A_DEFLONG);
 	LitterAddMess2	((method) SwamyTell,	"tell", A_SYM, A_SYM);
 	LitterAddCant	((method) SwamyTattle,	"dblclick");
 	LitterAddCant	((method) SwamyAssist,	"assist");
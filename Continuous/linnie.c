@@ -34,6 +34,7 @@
 #include "TrialPeriodUtils.h"
 #include "Taus88.h"
 #include "MiscUtils.h"
+#include "DrawUtils.h"
 
 #include <math.h>
 
@@ -67,6 +68,7 @@ typedef struct {
 					cc;					// Apex normalized inside unit range: (c-a)/(b-a)
 	UInt32			lrThresh;
 		
+	tDrawBuf		drawBuf;
 	} objLinran;
 
 
@@ -87,6 +89,7 @@ SymbolPtr	gSymSymbol	= NIL,
 /******************************************************************************************
  *
  *	LinnieBang(me)
+ *	LinnieDraw(me, iCount, iDest)
  *	LinnieFloat(me, float)
  *	
  *	There are two methods in the literature for generating a linear distribution: 
@@ -102,56 +105,87 @@ SymbolPtr	gSymSymbol	= NIL,
  *	
  *	The mapping function provided by LinnieFloat() uses the first variant. 
  *
+ *	LinnieDraw() sends iCount deviates as a single list, or writes them into the buffer~
+ *	or table named by iDest.
+ *
  ******************************************************************************************/
 
-static void
-LinnieBang(
-	objLinran* me)
-	
-	{
-	tTaus88DataPtr	tausData = me->tausData;
-	UInt32			lrThresh = me->lrThresh,
-					s1, s2, s3;
-	double			lin, u1, u2;
-	
-	if (tausData == NIL)
-		tausData = Taus88GetGlobals();
-	Taus88Load(tausData, &s1, &s2, &s3);
-	
-	// We need two unit uniform random variates no matter what
-	u1 = ULong2Unit_ZO( Taus88Process(&s1, &s2, &s3) ),
-	u2 = ULong2Unit_ZO( Taus88Process(&s1, &s2, &s3) );
-	
-	if (lrThresh == 0x80000000UL) {
-		// Special case for isoceles coordinates
-		lin  = u1 + u2;
-		lin *= me->scaleLeft;
-		lin += me->a;
-		}
-	else {
-		// If the core RNG were expensive, we could consider getting by with the two
-		// uniform deviates already calculated. Taken together, we have 64 random bits,
-		// and we basically need three single-precision float values, so there are enough
-		// random bits to go around for "pretty good" randomness. But inline Taus88 is so
-		// fast, let's just grab another variate.
-		// We don't even have to convert this one to float.
-		if (Taus88Process(&s1, &s2, &s3) <= lrThresh) {
-			lin  = (u1 > u2) ? u1 : u2;
+	static inline double NextDeviate(objLinran* me, UInt32* s1, UInt32* s2, UInt32* s3)
+		{
+		UInt32	lrThresh = me->lrThresh;
+		double	lin, u1, u2;
+		
+		// We need two unit uniform random variates no matter what
+		u1 = ULong2Unit_ZO( Taus88Process(s1, s2, s3) ),
+		u2 = ULong2Unit_ZO( Taus88Process(s1, s2, s3) );
+		
+		if (lrThresh == 0x80000000UL) {
+			// Special case for isoceles coordinates
+			lin  = u1 + u2;
 			lin *= me->scaleLeft;
 			lin += me->a;
 			}
 		else {
-			lin = (u1 < u2) ? u1 : u2;
-			lin *= me->scaleRight;
-			lin += me->c;
+			// If the core RNG were expensive, we could consider getting by with the two
+			// uniform deviates already calculated. Taken together, we have 64 random bits,
+			// and we basically need three single-precision float values, so there are
+			// enough random bits to go around for "pretty good" randomness. But inline
+			// Taus88 is so fast, let's just grab another variate.
+			// We don't even have to convert this one to float.
+			if (Taus88Process(s1, s2, s3) <= lrThresh) {
+				lin  = (u1 > u2) ? u1 : u2;
+				lin *= me->scaleLeft;
+				lin += me->a;
+				}
+			else {
+				lin = (u1 < u2) ? u1 : u2;
+				lin *= me->scaleRight;
+				lin += me->c;
+				}
 			}
+		
+		return lin;
+		}
+
+	static void DrawDeviates(objLinran* me, double oVals[], long iCount)
+		{
+		tTaus88DataPtr	tausData = me->tausData;
+		UInt32			s1, s2, s3;
+		long			i;
+		
+		if (tausData == NIL)
+			tausData = Taus88GetGlobals();
+		Taus88Load(tausData, &s1, &s2, &s3);
+		
+		for (i = 0; i < iCount; i += 1)
+			oVals[i] = NextDeviate(me, &s1, &s2, &s3);
+		
+		Taus88Store(tausData, s1, s2, s3);
 		}
+
+static void
+LinnieBang(
+	objLinran* me)
+	
+	{
+	double lin;
 	
-	Taus88Store(tausData, s1, s2, s3);
+	DrawDeviates(me, &lin, 1);
 	
 	outlet_float(me->coreObject.o_outlet, lin);
 	}
 
+static void
+LinnieDraw(
+	objLinran*	me,
+	long		iCount,
+	Symbol*		iDest)
+	
+	{
+	DrawFloats(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawFloatFunc) DrawDeviates);
+	}
+
 static void
 LinnieFloat(
 	objLinran*	me,
@@ -568,7 +602,10 @@ static void LinnieTell(objLinran* me, Symbol* iTarget, Symbol* iMsg)
  ******************************************************************************************/
 
 static void LinnieFree(objLinran* me)
-	{ Taus88Free(me->tausData); }							// Taus88Free is NIL-safe
+	{
+	Taus88Free(me->tausData);								// Taus88Free is NIL-safe
+	DrawFree(&me->drawBuf);
+	}
 
 static void*
 LinnieNew(
@@ -597,6 +634,7 @@ noMoreDefaults:
 	
 	// Store object components
 	me->tausData	= myTausStuff;
+	DrawInit(&me->drawBuf);
 	me->a			= 0.0;
 	me->b			= 1.0;
 	me->c			= 0.5;
@@ -646,6 +684,7 @@ main(void)
 	LITTER_TIMEBOMB addfloat((method) LinnieFloat);
 	LITTER_TIMEBOMB LitterAddMess1	((method) LinnieList, "list", A_GIMME);
 	LitterAddMess1 ((method) LinnieSeed,		"seed",		A_DEFLONG);
+	LitterAddMess2 ((method) LinnieDraw,		"draw",		A_LONG, A_DEFSYM);
 	LitterAddMess0	((method) LinniePos,		"pos");
 	LitterAddMess0	((method) LinnieSym,		"sym");
 	LitterAddMess0	((method) LinnieNeg,		"neg");
@@ -33,6 +33,8 @@
 #include "TrialPeriodUtils.h"
 #include "Taus88.h"
 #include "MiscUtils.h"
+#include "DrawUtils.h"
+#include "FastMath.h"
 
 #include <math.h>
 
@@ -62,6 +64,10 @@ typedef struct {
 	
 	double			scale,
 					beta;		
+	
+	long			exact;					// libm log() rather than FastLog()
+	
+	tDrawBuf		drawBuf;
 	} objLogiran;
 
 
@@ -73,28 +79,81 @@ typedef struct {
 /******************************************************************************************
  *
  *	LoggieBang(me)
+ *	LoggieDraw(me, iCount, iDest)
+ *
+ *	LoggieDraw() sends iCount deviates as a list, or writes them into the buffer~ or
+ *	table named by iDest. Seeds are loaded and stored once for the lot. LoggieBang() is
+ *	the same thing with a count of one.
+ *
+ *	The inversion -log(1/u - 1) is the same as log(u/(1-u)). Unless the exact attribute
+ *	is set, we evaluate the latter with FastLog() in a separate pass over the uniform
+ *	deviates, which leaves the compiler a loop it can vectorize.
  *
  ******************************************************************************************/
 
+	static void DrawDeviates(objLogiran* me, double oVals[], long iCount)
+		{
+		tTaus88DataPtr	tausData	= me->tausData;
+		double			scale		= me->scale,
+						beta		= me->beta;
+		UInt32			s1, s2, s3;
+		long			i;
+		
+		if (scale <= 0.0) {
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = scale;
+			return;
+			}
+		
+		if (tausData == NIL)
+			tausData = Taus88GetGlobals();
+		Taus88Load(tausData, &s1, &s2, &s3);
+		
+		if (me->exact) {
+			for (i = 0; i < iCount; i += 1) {
+				double u = ULong2Unit_zo( Taus88Process(&s1, &s2, &s3) );
+				
+				u = 1.0 / u;
+				u -= 1.0;
+				u = -log(u);
+				
+				oVals[i] = scale * (u + beta);
+				}
+			}
+		
+		else {
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = ULong2Unit_zo( Taus88Process(&s1, &s2, &s3) );
+			for (i = 0; i < iCount; i += 1) {
+				double u = oVals[i];
+				
+				oVals[i] = scale * (FastLog(u / (1.0 - u)) + beta);
+				}
+			}
+		
+		Taus88Store(tausData, s1, s2, s3);
+		}
+
 static void
 LoggieBang(
 	objLogiran* me)
 	
 	{
-	double	logistic = me->scale;			// Initialize calculation
-	
-	if (logistic > 0.0) {
-		double u = ULong2Unit_zo( Taus88(me->tausData) );
-		
-		u = 1.0 / u;
-		u -= 1.0;
-		u = -log(u);
-		
-		logistic *= (u + me->beta);
-		}
+	double logistic;
 	
+	DrawDeviates(me, &logistic, 1);
 	outlet_float(me->theOutlet, logistic);
+	}
+
+static void
+LoggieDraw(
+	objLogiran*	me,
+	long		iCount,
+	Symbol*		iDest)
 	
+	{
+	DrawFloats(	(Object*) me, &me->drawBuf, me->theOutlet,
+				iCount, iDest, (tDrawFloatFunc) DrawDeviates);
 	}
 
 static void
@@ -148,12 +207,16 @@ static void LoggieBeta	(objLogiran* me, double iBeta)
 /******************************************************************************************
  *
  *	LoggieSeed(me, iSeed)
+ *	LoggieExact(me, iExact)
  *
  ******************************************************************************************/
 
 static void LoggieSeed(objLogiran* me, long iSeed)
 	{ Taus88Seed(me->tausData, (unsigned long) iSeed); }
 
+static void LoggieExact(objLogiran* me, long iExact)
+	{ me->exact = (iExact != 0); }
+
 
 #pragma mark -
 #pragma mark • Attribute/Information Functions
@@ -303,6 +366,7 @@ DoExpect(objLogiran* me, eExpectSelector iSel)
 		{
 		Object*	attr;
 		Symbol*	symFloat64		= gensym("float64");
+		Symbol*	symLong			= gensym("long");
 		
 		// Read-Write Attributes
 		attr = attr_offset_new(	"alpha", symFloat64, 0,
@@ -312,6 +376,9 @@ DoExpect(objLogiran* me, eExpectSelector iSel)
 								NULL, (method) LoggieSetAttrLoc,
 								calcoffset(objLogiran, beta));
 		class_addattr(gObjectClass, attr);
+		attr = attr_offset_new(	"exact", symLong, 0,
+								NULL, NULL, calcoffset(objLogiran, exact));
+		class_addattr(gObjectClass, attr);
 		
 		// Read-Only Attributes
 		attr = attribute_new("min", symFloat64, kAttrFlagsReadOnly, (method) LoggieGetMin, NULL);
@@ -381,7 +448,10 @@ static void LoggieTell(objLogiran* me, Symbol* iTarget, Symbol* iMsg)
  ******************************************************************************************/
 
 static void LoggieFree(objLogiran* me)
-	{ Taus88Free(me->tausData); }							// Taus88Free is NIL-safe
+	{
+	Taus88Free(me->tausData);								// Taus88Free is NIL-safe
+	DrawFree(&me->drawBuf);
+	}
 
 static void*
 LoggieNew(
@@ -419,6 +489,8 @@ noMoreDefaults:
 	
 	// Store object components
 	me->tausData	= myTausStuff;
+	me->exact		= false;
+	DrawInit(&me->drawBuf);
 	LoggieAlpha(me, iAlpha);
 	LoggieBeta(me, iBeta);
 	
@@ -466,6 +538,8 @@ main(void)
 	LitterAddMess1	((method) LoggieAlpha,		"ft1",		A_FLOAT);
 	LitterAddMess1	((method) LoggieBeta,		"ft2",		A_FLOAT);
 	LitterAddMess1 ((method) LoggieSeed,		"seed",		A_DEFLONG);
+	LitterAddMess2 ((method) LoggieDraw,		"draw",		A_LONG, A_DEFSYM);
+	LitterAddMess1 ((method) LoggieExact,		"exact",	A_DEFLONG);
 	LitterAddMess2 ((method) LoggieTell,		"tell", A_SYM, A_SYM);
 	LitterAddCant	((method) LoggieTattle,		"dblclick");
 	LitterAddCant	((method) LoggieAssist,		"assist");
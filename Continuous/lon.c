@@ -34,6 +34,8 @@
 #include "RNGGauss.h"
 #include "Taus88.h"
 #include "MiscUtils.h"
+#include "DrawUtils.h"
+#include "FastMath.h"
 
 #include <math.h>
 
@@ -67,6 +69,10 @@ typedef struct {
 					baseMean,						// Mean of the base normal distribution
 					stdDev,							// Nominal standard deviation
 					baseStdDev;						// Standard deviation of base normal dist.
+	
+	long			exact;							// Exponentiate with libm, not FastExp()
+	
+	tDrawBuf		drawBuf;
 	} objLogNorm;
 
 
@@ -79,27 +85,59 @@ typedef struct {
 /******************************************************************************************
  *
  *	LonBang(me)
+ *	LonDraw(me, iCount, iDest)
+ *
+ *	LonDraw() sends iCount deviates out as one list, or writes them into the buffer~ or
+ *	table named by iDest. The underlying normal deviates come from NormalKRTaus88Fill().
+ *	LonBang() draws a single deviate.
+ *
+ *	The normal deviates are exponentiated in a separate pass over the array with
+ *	FastExp() (a branch-free loop that vectorizes) unless the exact attribute asks for
+ *	libm's exp().
  *
  ******************************************************************************************/
 
+	static void DrawDeviates(objLogNorm* me, double oVals[], long iCount)
+		{
+		double	mu		= me->baseMean,
+				sigma	= me->baseStdDev;
+		long	i;
+		
+		if (me->mean <= 0.0) {
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = 0.0;									// Degenerate case
+			return;
+			}
+		
+		NormalKRTaus88Fill(me->tausData, oVals, iCount);
+		
+		if (me->exact)
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = exp(oVals[i] * sigma + mu);
+		else for (i = 0; i < iCount; i += 1)
+			oVals[i] = FastExp(oVals[i] * sigma + mu);
+		}
+
 static void
 LonBang(
 	objLogNorm* me)
 	
 	{
-	double			l;
+	double l;
 	
-	if (me->mean > 0.0) {
-		l = NormalKRTaus88(me->tausData);
-		l *= me->baseStdDev;
-		l += me->baseMean;
-		l = exp(l);
-		}
-	
-	else l = 0.0;											// Degenerate case
-			
+	DrawDeviates(me, &l, 1);
 	outlet_float(me->coreObject.o_outlet, l);
+	}
+
+static void
+LonDraw(
+	objLogNorm*	me,
+	long		iCount,
+	Symbol*		iDest)
 	
+	{
+	DrawFloats(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawFloatFunc) DrawDeviates);
 	}
 
 
@@ -108,6 +146,7 @@ LonBang(
  *	LonMean(me, iOrder)
  *	LonStdDev(me, iStdDev)
  *	LonSeed(me, iSeed)
+ *	LonExact(me, iExact)
  *	
  *	Set parameters, making sure nothing bad happens.
  *	
@@ -151,6 +190,9 @@ static void LonStdDev(objLogNorm* me, double iStdDev)
 static void LonSeed(objLogNorm* me, long iSeed)
 	{ Taus88Seed(me->tausData, (unsigned long) iSeed); }
 
+static void LonExact(objLogNorm* me, long iExact)
+	{ me->exact = (iExact != 0); }
+
 #pragma mark -
 #pragma mark • Attribute/Information Functions
 
@@ -324,6 +366,7 @@ DoExpect(
 		{
 		Object*	attr;
 		Symbol*	symFloat64		= gensym("float64");
+		Symbol*	symLong			= gensym("long");
 		
 		// Read-Write Attributes
 		attr = attr_offset_new(	"mean", symFloat64, 0,
@@ -334,6 +377,9 @@ DoExpect(
 								NULL, (method) LonSetAttrStdDev,
 								calcoffset(objLogNorm, stdDev));
 		class_addattr(gObjectClass, attr);
+		attr = attr_offset_new(	"exact", symLong, 0,
+								NULL, NULL, calcoffset(objLogNorm, exact));
+		class_addattr(gObjectClass, attr);
 		
 		// Read-Only Attributes
 		attr = attribute_new("min", symFloat64, kAttrFlagsReadOnly, (method) LonGetMin, NULL);
@@ -396,7 +442,10 @@ static void LonTell(objLogNorm* me, Symbol* iTarget, Symbol* iMsg)
  ******************************************************************************************/
 
 static void LonFree(objLogNorm* me)
-	{ Taus88Free(me->tausData); }							// Taus88Free is NIL-safe
+	{
+	Taus88Free(me->tausData);								// Taus88Free is NIL-safe
+	DrawFree(&me->drawBuf);
+	}
 
 
 static void*
@@ -438,6 +487,8 @@ noMoreDefaults:
 	
 	// Initialize object components
 	me->tausData	= myTausStuff;
+	me->exact		= false;
+	DrawInit(&me->drawBuf);
 	me->mean		= (iMean >= 0.0) ? iMean : 0.0;
 	me->stdDev		= iStdDev;
 	UpdateBaseParams(me);
@@ -484,6 +535,8 @@ main(void)
 	LitterAddMess1	((method) LonMean,		"ft1",	A_FLOAT);
 	LitterAddMess1	((method) LonStdDev,	"ft2",	A_FLOAT);
 	LitterAddMess1	((method) LonSeed,		"seed",	A_DEFLONG);
+	LitterAddMess2	((method) LonDraw,		"draw",	A_LONG, A_DEFSYM);
+	LitterAddMess1	((method) LonExact,		"exact", A_DEFLONG);
 	LitterAddMess2	((method) LonTell,		"tell", A_SYM, A_SYM);
 	LitterAddCant	((method) LonTattle,	"dblclick");
 	LitterAddCant	((method) LonAssist,	"assist");
@@ -34,6 +34,7 @@
 #include "Taus88.h"
 #include "RNGGauss.h"
 #include "MiscUtils.h"
+#include "DrawUtils.h"
 
 
 #pragma mark • Constants
@@ -64,6 +65,8 @@ typedef struct {
 	double			mean,
 					stdDev;
 	
+	tDrawBuf		drawBuf;
+	
 	} objGauss;
 
 
@@ -76,6 +79,10 @@ typedef struct {
 /******************************************************************************************
  *
  *	NormBang(me)
+ *	NormDraw(me, iCount, iDest)
+ *
+ *	NormDraw() sends iCount deviates as one list, or writes them to the buffer~ or table
+ *	named by iDest.
  *
  ******************************************************************************************/
 
@@ -92,6 +99,28 @@ NormBang(
 	outlet_float(me->coreObject.o_outlet, g);
 	}
 
+	static void DrawDeviates(objGauss* me, double oVals[], long iCount)
+		{
+		double	mean	= me->mean,
+				stdDev	= me->stdDev;
+		long	i;
+		
+		NormalKRTaus88Fill(me->tausData, oVals, iCount);
+		for (i = 0; i < iCount; i += 1)
+			oVals[i] = oVals[i] * stdDev + mean;
+		}
+
+static void
+NormDraw(
+	objGauss*	me,
+	long		iCount,
+	Symbol*		iDest)
+	
+	{
+	DrawFloats(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawFloatFunc) DrawDeviates);
+	}
+
 
 /******************************************************************************************
  *
@@ -310,7 +339,10 @@ static void NormTell(objGauss* me, Symbol* iTarget, Symbol* iAttrName)
  ******************************************************************************************/
 
 static void NormFree(objGauss* me)
-	{ Taus88Free(me->tausData); }							// Taus88Free is NIL-safe
+	{
+	Taus88Free(me->tausData);								// Taus88Free is NIL-safe
+	DrawFree(&me->drawBuf);
+	}
 
 static void*
 NormNew(
@@ -335,6 +367,7 @@ NormNew(
 	me->tausData	= NIL;
 	me->mean		= 0.0;
 	me->stdDev		= 1.0;
+	DrawInit(&me->drawBuf);
 
 	// Run through initialization parameters from right to left
 	switch (iArgCount) {
@@ -401,6 +434,7 @@ main(void)
 	LitterAddMess1	((method) NormMean,		"ft1",	A_LONG);
 	LitterAddMess1	((method) NormStdDev,	"ft2",	A_LONG);
 	LitterAddMess1	((method) NormSeed,		"seed",	A_DEFLONG);
+	LitterAddMess2	((method) NormDraw,		"draw",	A_LONG, A_DEFSYM);
 	LitterAddMess2	((method) NormTell,		"tell", A_SYM, A_SYM);
 	LitterAddMess0	((method) NormTattle,	"tattle");
 	LitterAddCant	((method) NormTattle,	"dblclick");
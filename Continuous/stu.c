@@ -34,8 +34,11 @@
 #include "LitterLib.h"
 #include "TrialPeriodUtils.h"
 #include "RNGCauchy.h"
+#include "RNGGauss.h"
+#include "RNGGamma.h"
 #include "MiscUtils.h"
 #include "MoreMath.h"							// Needed for digamma(), #includes <math.h>
+#include "DrawUtils.h"
 
 
 #pragma mark • Constants
@@ -62,6 +65,9 @@ typedef struct {
 	tTaus88DataPtr	tausData;
 	
 	long			dof;			// Degrees of Freedom	
+	tGammaMTParams	chi2;			// Chi-square/dof as Gamma(dof/2, 2/dof); dof >= 4
+	
+	tDrawBuf		drawBuf;
 	} objStu;
 
 
@@ -75,10 +81,16 @@ typedef struct {
 /******************************************************************************************
  *
  *	StuBang(me)
+ *	StuDraw(me, iCount, iDest)
  *
  *	Degrees of Freedom == 1		Equivalent to standard Cauchy distribution
  *	Degrees of Freedom == 2		Kinderman & Monahan
- *	Degrees of Freedom >= 3		Best's T3T algorithm, with modifications by Dagpunar
+ *	Degrees of Freedom == 3		Best's T3T algorithm
+ *	Degrees of Freedom >= 4		Z / sqrt(X/dof), Z standard normal and X chi-square, the
+ *								latter from the Marsaglia-Tsang gamma generator
+ *
+ *	StuDraw() sends iCount deviates as one list, or writes them into the buffer~ or table
+ *	named by iDest.
  *
  ******************************************************************************************/
 	
@@ -161,81 +173,54 @@ typedef struct {
 		return stu;
 		}
 
-	static inline double CalcStu3Plus(long iDoF, tTaus88Data* iData)
+	static inline double CalcStuMT(tGammaMTParams* iChi2, tTaus88Data* iData)
 		{
-		const double	kD1 = 0.86602540378,			// sqrt(3) / 2
-						kD2 = 8.59111293933,			// 256 * e / 81
-						kD3 = 0.92740571477;			// 9 * sqrt(e) / 16
+		double z = NormalKRTaus88(iData);
 		
-		double	stu,
-				stsq,			// square of candidate variate (stu ^ 2)
-				dof1,			// 1 / (dof + 1)
-				thresh;		
-		UInt32	s1, s2, s3;
-		
-		if (iData == NIL)
-			iData = Taus88GetGlobals();
-		Taus88Load(iData, &s1, &s2,&s3);
+		return z / sqrt( GenGammaMTTaus88(iChi2, iData) );
+		}
 		
-		do  {
-			double u, w;
-			
-			do	{
-				const double	x = ULong2Unit_zo( Taus88Process(&s1, &s2, &s3) ),
-								y = 2.0 * ULong2Unit_zo( Taus88Process(&s1, &s2, &s3) ) - 1.0;
-				
-				stu = kD1 * y / x;
-				
-				// Evaluate test condtion. Use variable u as temporary register.
-				stsq = stu * stu;
-				u = stsq + 3.0;		// Use variable u as temeporary register for the
-				u *= x;				// expression (x * (3 + t))
-				} while (u > 3.0);
-			
-			u = ULong2Unit_zo( Taus88Process(&s1, &s2, &s3) );
-			w = u * u;
-			
-			// First, fastest acceptance condition
-			thresh  = kD3 * kD3;
-			thresh -= stsq / kD2;
-			if (thresh >= w) break;
-			
-			// Second acceptance condition
-			thresh  = stsq / 3.0;
-			thresh += 1.0;
-			thresh *= thresh;
-			thresh *= kD3;
-			thresh /= u;
-			if (stsq <= thresh) break;
-			
-			// Final acceptance condition
-			dof1 = 1.0 / ((double) iDoF + 1.0);
-			thresh -= 1.0;
-			thresh *= dof1;
-			} while (log((stsq + (double) iDoF) * dof1) > thresh);
+	static inline double NextDeviate(objStu* me)
+		{
+		long	dof = me->dof;
+		double	stu;
 		
-		Taus88Store(iData, s1, s2, s3);
+		// ASSERT: (dof > 0)
+		switch (dof) {
+			case 1:		stu = CalcStu1(me->tausData);			break;
+			case 2:		stu = CalcStu2(me->tausData);			break;
+			case 3:		stu = CalcStu3(me->tausData);			break;
+			default:	stu = CalcStuMT(&me->chi2, me->tausData);	break;
+			}
 		
 		return stu;
 		}
-		
+
 static void
 StuBang(
 	objStu* me)
 	
 	{
-	long	dof = me->dof;
-	double	stu;
-	
-	// ASSERT: (dof > 0)
-	switch (dof) {
-		case 1:		stu = CalcStu1(me->tausData);			break;
-		case 2:		stu = CalcStu2(me->tausData);			break;
-		case 3:		stu = CalcStu3(me->tausData);			break;
-		default:	stu = CalcStu3Plus(dof, me->tausData);	break;
+	outlet_float(me->coreObject.o_outlet, NextDeviate(me));
+	}
+
+	static void DrawDeviates(objStu* me, double oVals[], long iCount)
+		{
+		long i;
+		
+		for (i = 0; i < iCount; i += 1)
+			oVals[i] = NextDeviate(me);
 		}
+
+static void
+StuDraw(
+	objStu*	me,
+	long	iCount,
+	Symbol*	iDest)
 	
-	outlet_float(me->coreObject.o_outlet, stu);
+	{
+	DrawFloats(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawFloatFunc) DrawDeviates);
 	}
 
 
@@ -249,7 +234,12 @@ StuBang(
  ******************************************************************************************/
 
 static void StuDoF(objStu* me, long iDoF)
-	{ me->dof = (iDoF > 0) ? iDoF : 1; }
+	{
+	me->dof = (iDoF > 0) ? iDoF : 1;
+	
+	if (me->dof >= 4)
+		CalcMTParams(&me->chi2, 0.5 * (double) me->dof, 2.0 / (double) me->dof);
+	}
 	
 static void StuSeed(objStu* me, long iSeed)
 	
@@ -469,7 +459,10 @@ static void StuTell(objStu* me, Symbol* iTarget, Symbol* iMsg)
  ******************************************************************************************/
 
 static void StuFree(objStu* me)
-	{ Taus88Free(me->tausData); }							// Taus88Free is NIL-safe
+	{
+	Taus88Free(me->tausData);								// Taus88Free is NIL-safe
+	DrawFree(&me->drawBuf);
+	}
 
 static void*
 StuNew(
@@ -503,6 +496,7 @@ noMoreDefaults:
 	
 	// Store object components
 	me->tausData = myTausStuff;
+	DrawInit(&me->drawBuf);
 	StuDoF(me, iDoF);
 	
 	return me;
@@ -545,6 +539,7 @@ main(void)
 	LITTER_TIMEBOMB LitterAddBang((method) StuBang);
 	LitterAddMess1	((method) StuDoF,		"in1",		A_LONG);
 	LitterAddMess1 ((method) StuSeed,		"seed",		A_DEFLONG);
+	LitterAddMess2 ((method) StuDraw,		"draw",		A_LONG, A_DEFSYM);
 	LitterAddMess2 ((method) StuTell,		"tell", A_SYM, A_SYM);
 	LitterAddCant	((method) StuTattle,	"dblclick");
 	LitterAddMess0	((method) StuTattle,	"tattle");
@@ -22,6 +22,8 @@
 #include "TrialPeriodUtils.h"
 #include "Taus88.h"
 #include "MiscUtils.h"
+#include "DrawUtils.h"
+#include "FastMath.h"
 
 #include <math.h>
 
@@ -56,7 +58,10 @@ typedef struct {
 	double			alpha,
 					beta,
 					negAlpha1;			// Cache -1/alpha
+	
+	long			exact;				// Call pow() from libm
 					
+	tDrawBuf		drawBuf;
 	} objPareto;
 
 
@@ -69,27 +74,77 @@ typedef struct {
 /******************************************************************************************
  *
  *	VilfrieBang(me)
+ *	VilfrieDraw(me, iCount, iDest)
+ *
+ *	VilfrieDraw() sends iCount deviates as a single list, or writes them into the buffer~
+ *	or table named by iDest. The Taus88 seeds are fetched once for the whole block.
+ *	VilfrieBang() is a block of one.
+ *
+ *	Normally the block is filled with uniform deviates first and then raised to the
+ *	power -1/alpha in one go with FastPow(). The exact attribute switches to libm pow().
+ *	The one visible difference: where pow() returns infinity for p = 0, FastPow() gives
+ *	a very large finite number.
  *
  ******************************************************************************************/
 
+	static void DrawDeviates(objPareto* me, double oVals[], long iCount)
+		{
+		tTaus88DataPtr	tausData	= me->tausData;
+		double			beta		= me->beta,
+						negAlpha1	= me->negAlpha1;
+		UInt32			s1, s2, s3;
+		long			i;
+		
+		if (me->alpha <= 0.0) {
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = beta;
+			return;
+			}
+		
+		if (tausData == NIL)
+			tausData = Taus88GetGlobals();
+		Taus88Load(tausData, &s1, &s2, &s3);
+		
+		if (me->exact) {
+			for (i = 0; i < iCount; i += 1) {
+				double p = ULong2Unit_ZO( Taus88Process(&s1, &s2, &s3) );
+				
+				oVals[i] = pow(p, negAlpha1) * beta;
+				}
+			}
+		
+		else {
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = ULong2Unit_ZO( Taus88Process(&s1, &s2, &s3) );
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = FastPow(oVals[i], negAlpha1) * beta;
+			}
+		
+		Taus88Store(tausData, s1, s2, s3);
+		}
 
 static void
 VilfrieBang(
 	objPareto* me)
 	
 	{
-	double	p;
+	double p;
 	
-	if (me->alpha > 0.0) {
-		p  = ULong2Unit_ZO( Taus88(me->tausData) );
-		p  = pow(p, me->negAlpha1);
-		p *= me->beta;
-		}
-	else p = me->beta;
-			
+	DrawDeviates(me, &p, 1);
 	outlet_float(me->coreObject.o_outlet, p);
 	}
 
+static void
+VilfrieDraw(
+	objPareto*	me,
+	long		iCount,
+	Symbol*		iDest)
+	
+	{
+	DrawFloats(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawFloatFunc) DrawDeviates);
+	}
+
 static void
 VilfrieMap(
 	objPareto*	me,
@@ -147,12 +202,16 @@ VilfrieBeta(
 /******************************************************************************************
  *
  *	VilfrieSeed(me, iSeed)
+ *	VilfrieExact(me, iExact)
  *
  ******************************************************************************************/
 
 static void VilfrieSeed(objPareto* me, long iSeed)	
 	{ Taus88Seed(me->tausData, (unsigned long) iSeed); }
 
+static void VilfrieExact(objPareto* me, long iExact)
+	{ me->exact = (iExact != 0); }
+
 
 #pragma mark -
 #pragma mark • Attribute/Information Functions
@@ -322,6 +381,7 @@ static double DoExpect(objPareto* me, eExpectSelector iSel)
 		{
 		Object*	attr;
 		Symbol*	symFloat64		= gensym("float64");
+		Symbol*	symLong			= gensym("long");
 		
 		// Read-Write Attributes
 		attr = attr_offset_new(	"alpha", symFloat64, 0,
@@ -332,6 +392,9 @@ static double DoExpect(objPareto* me, eExpectSelector iSel)
 								NULL, (method) VilfrieSetAttrBeta,
 								calcoffset(objPareto, beta));
 		class_addattr(gObjectClass, attr);
+		attr = attr_offset_new(	"exact", symLong, 0,
+								NULL, NULL, calcoffset(objPareto, exact));
+		class_addattr(gObjectClass, attr);
 		
 		// Read-Only Attributes
 		attr = attribute_new("min", symFloat64, kAttrFlagsReadOnly, (method) VilfrieGetMin, NULL);
@@ -397,7 +460,10 @@ static void VilfrieTell(objPareto* me, Symbol* iTarget, Symbol* iMsg)
  ******************************************************************************************/
 
 static void VilfrieFree(objPareto* me)
-	{ Taus88Free(me->tausData); }							// Taus88Free is NIL-safe
+	{
+	Taus88Free(me->tausData);								// Taus88Free is NIL-safe
+	DrawFree(&me->drawBuf);
+	}
 
 static void*
 VilfrieNew(
@@ -437,6 +503,8 @@ noMoreDefaults:
 	
 	// Store object components
 	me->tausData	= myTausStuff;
+	me->exact		= false;
+	DrawInit(&me->drawBuf);
 	VilfrieAlpha(me, iAlpha);
 	VilfrieBeta(me, iBeta);
 	
@@ -482,6 +550,8 @@ main(void)
 	LitterAddMess1	((method) VilfrieAlpha,		"ft1",		A_DEFFLOAT);
 	LitterAddMess1	((method) VilfrieBeta,		"ft2",		A_DEFFLOAT);
 	LitterAddMess1	((method) VilfrieSeed,		"seed",		A_DEFLONG);
+	LitterAddMess2	((method) VilfrieDraw,		"draw",		A_LONG, A_DEFSYM);
+	LitterAddMess1	((method) VilfrieExact,		"exact",	A_DEFLONG);
 	LitterAddMess2	((method) VilfrieTell,		"tell", A_SYM, A_SYM);
 	LitterAddCant	((method) VilfrieTattle,	"dblclick");
 	LitterAddMess0	((method) VilfrieTattle,	"tattle");
@@ -34,6 +34,8 @@
 #include "Taus88.h"
 #include "MiscUtils.h"
 #include "MoreMath.h"
+#include "DrawUtils.h"
+#include "FastMath.h"
 
 #include <math.h>
 
@@ -70,6 +72,10 @@ typedef struct {
 	
 	double			scale,
 					oneOverT;		
+	
+	long			exact;						// Use libm instead of FastMath
+	
+	tDrawBuf		drawBuf;
 	} objWeibull;
 
 
@@ -82,25 +88,74 @@ typedef struct {
 /******************************************************************************************
  *
  *	YBang(me)
+ *	YDraw(me, iCount, iDest)
+ *
+ *	YDraw() fills a list (or the buffer~ or table named by iDest) with iCount deviates,
+ *	loading and storing the Taus88 seeds only once. A bang is simply a draw of one.
+ *
+ *	By default the uniform deviates for a whole chunk are generated first and then
+ *	transformed in a second loop using the approximations in FastMath.h, which the
+ *	compiler is free to vectorize. Setting the exact attribute goes back to calling
+ *	pow() and log() from libm for every deviate.
  *
  ******************************************************************************************/
 
+	static void DrawDeviates(objWeibull* me, double oVals[], long iCount)
+		{
+		tTaus88DataPtr	tausData	= me->tausData;
+		double			scale		= me->scale,
+						c			= me->oneOverT;
+		UInt32			s1, s2, s3;
+		long			i;
+		
+		if (scale <= 0.0 || c <= 0.0) {
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = scale;
+			return;
+			}
+		
+		if (tausData == NIL)
+			tausData = Taus88GetGlobals();
+		Taus88Load(tausData, &s1, &s2, &s3);
+		
+		if (me->exact) {
+			for (i = 0; i < iCount; i += 1) {
+				double u = ULong2Unit_zO( Taus88Process(&s1, &s2, &s3) );
+				
+				oVals[i] = scale * pow(log(1.0 / u), c);
+				}
+			}
+		
+		else {
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = ULong2Unit_zO( Taus88Process(&s1, &s2, &s3) );
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = scale * FastPow(-FastLog(oVals[i]), c);
+			}
+		
+		Taus88Store(tausData, s1, s2, s3);
+		}
+
 static void
 YBang(
 	objWeibull* me)
 	
 	{
-	double	weibull = me->scale,				// Initialize calculation
-			c		= me->oneOverT;
+	double weibull;
 	
-	if (weibull > 0.0 && c > 0.0) {
-		double u = ULong2Unit_zO( Taus88(me->tausData) );
-		
-		weibull *= pow(log(1.0 / u), c);
-		}
-		
+	DrawDeviates(me, &weibull, 1);
 	outlet_float(me->coreObject.o_outlet, weibull);
+	}
+
+static void
+YDraw(
+	objWeibull*	me,
+	long		iCount,
+	Symbol*		iDest)
 	
+	{
+	DrawFloats(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawFloatFunc) DrawDeviates);
 	}
 
 
@@ -109,6 +164,7 @@ YBang(
  *	YScale(me, iScale)
  *	YCurve(me, iCurve)
  *	YSeed(me, iSeed)
+ *	YExact(me, iExact)
  *	
  *	Set parameters, making sure nothing bad happens.
  *	
@@ -126,6 +182,9 @@ static void YCurve(objWeibull* me, double iVal)
 static void YSeed( objWeibull* me, long iSeed)
 	{ Taus88Seed(me->tausData, (unsigned long) iSeed); }
 
+static void YExact(objWeibull* me, long iExact)
+	{ me->exact = (iExact != 0); }
+
 
 #pragma mark -
 #pragma mark • Attribute/Information Functions
@@ -321,6 +380,7 @@ DoExpect(
 		{
 		Object*	attr;
 		Symbol*	symFloat64		= gensym("float64");
+		Symbol*	symLong			= gensym("long");
 		
 		// Read-Write Attributes
 		attr = attr_offset_new(	"scale", symFloat64, 0,
@@ -330,6 +390,9 @@ DoExpect(
 		attr = attr_offset_new(	"shape", symFloat64, 0,
 								(method) YGetAttrCurve, (method) YSetAttrCurve, 0);
 		class_addattr(gObjectClass, attr);
+		attr = attr_offset_new(	"exact", symLong, 0,
+								NULL, NULL, calcoffset(objWeibull, exact));
+		class_addattr(gObjectClass, attr);
 		
 		// Read-Only Attributes
 		attr = attribute_new("min", symFloat64, kAttrFlagsReadOnly, (method) YGetMin, NULL);
@@ -396,7 +459,10 @@ static void YTell(objWeibull* me, Symbol* iTarget, Symbol* iAttrName)
  ******************************************************************************************/
 
 static void YFree(objWeibull* me)
-	{ Taus88Free(me->tausData); }							// Taus88Free is NIL-safe
+	{
+	Taus88Free(me->tausData);								// Taus88Free is NIL-safe
+	DrawFree(&me->drawBuf);
+	}
 
 static void*
 YNew(
@@ -435,6 +501,8 @@ noMoreDefaults:
 	
 	// Store object components
 	me->tausData = myTausStuff;
+	me->exact	 = false;
+	DrawInit(&me->drawBuf);
 	YScale(me, iScale);
 	YCurve(me, iCurve);
 	
@@ -479,6 +547,8 @@ main(void)
 	LitterAddMess1	((method) YScale,	"ft1",	A_FLOAT);
 	LitterAddMess1	((method) YCurve,	"ft2",	A_FLOAT);
 	LitterAddMess1	((method) YSeed,	"seed",	A_DEFLONG);
+	LitterAddMess2	((method) YDraw,	"draw",	A_LONG, A_DEFSYM);
+	LitterAddMess1	((method) YExact,	"exact", A_DEFLONG);
 	LitterAddMess2	((method) YTell,	"tell", A_SYM, A_SYM);
 	LitterAddCant	((method) YTattle,	"dblclick");
 	LitterAddMess0	((method) YTattle,	"tattle");
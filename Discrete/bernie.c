@@ -34,6 +34,7 @@
 #include "TrialPeriodUtils.h"
 #include "Taus88.h"
 #include "RNGBinomial.h"
+#include "DrawUtils.h"
 
 #pragma mark • Constants
 
@@ -58,7 +59,8 @@ enum Generator {								// How to generate deviates
 	genFiftyFifty,								// p = .5, n < ~768
 	genBruteForce,								// n < ~ 15
 	genBInversion,								// np < 20
-	genBTPErej									// General-purpose
+	genBTPErej,									// General-purpose
+	genBitStream								// n = 1 (bit-sliced, 32 trials at a time)
 	};
 
 
@@ -68,6 +70,7 @@ typedef enum Generator eGenerator;
 
 typedef union genParams {
 	UInt32		bfThresh;
+	UInt64		bsThresh;
 	tBINVParams	binvStuff;
 	tBTPEParams	btpeStuff;
 	} uGenParams;
@@ -83,6 +86,11 @@ typedef struct {
 	UInt32			nTrials;
 	eGenerator		gen;
 	uGenParams		params;
+	
+	UInt32			bitPool;			// Trials left over from the last bit-sliced word
+	short			bitsLeft;
+	
+	tDrawBuf		drawBuf;			// Output buffer for bits and draw messages
 	} objBernie;
 
 
@@ -107,6 +115,12 @@ typedef struct {
 		
 		else if (p == 1.0)
 			me->gen = genAlwaysN;
+		
+		else if (n == 1) {
+			me->gen = genBitStream;
+			me->params.bsThresh = CalcBSThreshhold(p);
+			me->bitsLeft = 0;
+			}
 			
 		else if (p == 0.5 && n <= 768)
 			me->gen	= genFiftyFifty;
@@ -134,16 +148,13 @@ typedef struct {
 		
 		}
 
-static void
-BernieBang(
+static long
+NextDeviate(
 	objBernie* me)
 	
 	{
 	long	b;
 	
-	if (me->gen == genUndef)
-		SelectGenerator(me);
-		
 	switch (me->gen) {
 	default:											// Must be genAlwaysZero
 		b = 0;
@@ -153,6 +164,16 @@ BernieBang(
 		b = me->nTrials;
 		break;
 	
+	case genBitStream:
+		if (me->bitsLeft == 0) {
+			GenBernoulliBitsTaus88(me->params.bsThresh, &me->bitPool, 1, me->tausData);
+			me->bitsLeft = 32;
+			}
+		b = me->bitPool & 0x01;
+		me->bitPool >>= 1;
+		me->bitsLeft -= 1;
+		break;
+	
 	case genFiftyFifty:
 		b = GenDevBinomialFCTaus88(me->nTrials, me->tausData);
 		break;
@@ -170,7 +191,113 @@ BernieBang(
 		break;
 		}
 	
-	outlet_int(me->coreObject.o_outlet, b);
+	return b;
+	}
+
+static void
+BernieBang(
+	objBernie* me)
+	
+	{
+	
+	if (me->gen == genUndef)
+		SelectGenerator(me);
+	
+	outlet_int(me->coreObject.o_outlet, NextDeviate(me));
+	}
+
+
+/******************************************************************************************
+ *
+ *	BernieBits(me, iCount)
+ *	BernieDraw(me, iCount, iDest)
+ *
+ *	Bulk output for streams of trials.
+ *
+ *	The bits message runs iCount Bernoulli trials with the current p (regardless of the
+ *	number of trials per deviate) and sends them packed 32 to an int, first trial in the
+ *	least significant bit. Unused bits of the last int are zero.
+ *
+ *	The draw message sends iCount deviates from the current distribution as one list, or
+ *	writes them to a buffer~ or table. With one trial per deviate these are bit-sliced
+ *	just like the bits message and then unpacked to 0s and 1s.
+ *
+ *	Both work through kDrawChunk words (or deviates) at a time, so no scratch memory
+ *	beyond the atoms is needed.
+ *
+ ******************************************************************************************/
+
+static void
+BernieBits(
+	objBernie*	me,
+	long		iCount)
+	
+	{
+	long	words = (iCount + 31) >> 5,
+			i;
+	UInt64	thresh;
+	Atom*	atoms;
+	Atom	countAtom;
+	
+	if (iCount <= 0)
+		return;
+	if (words > kDrawMaxList) {
+		words	= kDrawMaxList;
+		iCount	= words << 5;
+		}
+	
+	AtomSetLong(&countAtom, iCount);
+	if (!DrawReserve((Object*) me, &me->drawBuf, words, gensym("bits"), 1, &countAtom))
+		return;
+	
+	thresh	= CalcBSThreshhold(me->prob);
+	atoms	= me->drawBuf.atoms;
+	for (i = 0; i < words; i += kDrawChunk) {
+		UInt32	w[kDrawChunk];
+		long	n = words - i,
+				j;
+		
+		if (n > kDrawChunk)
+			n = kDrawChunk;
+		
+		GenBernoulliBitsTaus88(thresh, w, n, me->tausData);
+		if (i + n == words && (iCount & 0x1f))
+			w[n - 1] &= 0xffffffff >> (32 - (iCount & 0x1f));
+		
+		for (j = 0; j < n; j += 1)
+			AtomSetLong(&atoms[i + j], (long) w[j]);
+		}
+	
+	outlet_list(me->coreObject.o_outlet, NIL, (short) words, atoms);
+	}
+
+	static void DrawDeviates(objBernie* me, long oVals[], long iCount)
+		{
+		long i;
+		
+		if (me->gen == genUndef)
+			SelectGenerator(me);
+		
+		if (me->gen == genBitStream) {
+			UInt32 w[kDrawChunk / 32];
+			
+			GenBernoulliBitsTaus88(me->params.bsThresh, w, (iCount + 31) >> 5, me->tausData);
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = (w[i >> 5] >> (i & 0x1f)) & 0x01;
+			}
+		else for (i = 0; i < iCount; i += 1)
+			oVals[i] = NextDeviate(me);
+		}
+
+static void
+BernieDraw(
+	objBernie*	me,
+	long		iCount,
+	Symbol*		iDest)
+	
+	{
+	DrawLongs(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawLongFunc) DrawDeviates);
 	}
 	
 
@@ -198,7 +325,10 @@ static void BernieProb(objBernie* me, double iProb)
 	}
 	
 static void BernieSeed(objBernie* me, long iSeed)
-	{ if (me->tausData) Taus88Seed(me->tausData, (UInt32) iSeed); }
+	{
+	if (me->tausData) Taus88Seed(me->tausData, (UInt32) iSeed);
+	me->bitsLeft = 0;										// Drop bits from old seed
+	}
 
 
 #pragma mark • Class Message Handlers
@@ -234,6 +364,9 @@ BernieNew(
 	me->nTrials		= kDefNTrials;
 	me->gen			= genUndef;
 		// Don't need to worry about genParams as long as the generator is undefined
+	me->bitPool		= 0;
+	me->bitsLeft	= 0;
+	DrawInit(&me->drawBuf);
 	
 	// Run through initialization parameters from right to left, checking for defaults
 	if (iSeed == 0) Taus88Init();
@@ -252,7 +385,10 @@ BernieNew(
 	}
 
 static void BernieFree(objBernie* me)
-	{ Taus88Free(me->tausData); }							// BernieFree is NIL-safe
+	{
+	Taus88Free(me->tausData);								// Taus88Free is NIL-safe
+	DrawFree(&me->drawBuf);
+	}
 
 
 
@@ -283,6 +419,10 @@ BernieTattle(
 	case genAlwaysN:
 		post("    always n");
 		break;
+	case genBitStream:
+		post("    bit-sliced Bernoulli trials");
+		post("    %d trials buffered", me->bitsLeft);
+		break;
 	case genFiftyFifty:
 		post("    flip-coin algorithm");
 		break;
@@ -638,6 +778,12 @@ BernieGen(
 		me->gen = iAlg;
 		me->params.bfThresh = CalcBFThreshhold(me->prob);
 		break;
+	case genBitStream:
+		ClearParamsUnion(&me->params);
+		me->gen = iAlg;
+		me->params.bsThresh = CalcBSThreshhold(me->prob);
+		me->bitsLeft = 0;
+		break;
 	case genBInversion:
 		ClearParamsUnion(&me->params);
 		me->gen = iAlg;
@@ -694,6 +840,8 @@ main(void)
 	LitterAddMess1	((method) BernieNTrials,	"in1",		A_LONG);
 	LitterAddMess1	((method) BernieProb,		"ft2",		A_FLOAT);
 	LitterAddMess1	((method) BernieSeed,		"seed",		A_DEFLONG);
+	LitterAddMess1	((method) BernieBits,		"bits",		A_LONG);
+	LitterAddMess2	((method) BernieDraw,		"draw",		A_LONG, A_DEFSYM);
 #if __DEBUG__
 	LitterAddMess1	((method) BernieGen,		"gen",		A_LONG);
 #endif
@@ -23,6 +23,7 @@
 #include "Taus88.h"
 #include "RNGBinomial.h"
 #include "RNGDistBeta.h"
+#include "DrawUtils.h"
 
 #pragma mark • Constants
 
@@ -77,6 +78,8 @@ typedef struct {
 					beta;
 	eBetaAlg		betaAlg;
 	uBetaParams		betaParams;
+	
+	tDrawBuf		drawBuf;
 	} objBibi;
 
 
@@ -89,6 +92,10 @@ typedef struct {
 /******************************************************************************************
  *
  *	BibiBang(me)
+ *	BibiDraw(me, iCount, iDest)
+ *
+ *	BibiDraw() sends iCount beta-binomial deviates at once, as a list or into a buffer~
+ *	or table.
  *
  ******************************************************************************************/
 
@@ -166,91 +173,115 @@ typedef struct {
 		return result;
 		}
 
-static void
-BibiBang(
-	objBibi* me)
-	
-	{
-	long			b,
-					n = me->nTrials;
-	double			p;
-	uBinomParams	binomParams;
-	
-	//
-	//	First generate a beta-distributed value for p
-	//
-	
-	if (me->betaAlg == algUndef)
-		me->betaAlg = SelectBetaAlg(me->alpha, me->beta, &me->betaParams);
-	
-	// ASSERT: me->betaAlg != algUndef
-	switch (me->betaAlg) {
-		default:							// Must be algIndeterm
-			p = 0.0;
-			if (((long) Taus88(me->tausData)) < 0) break;
-			// otherwise, fall into next case
-		case algConstOne:
-			p = 1.0;
-			break;
+	static inline long NextDeviate(objBibi* me)
+		{
+		long			b,
+						n = me->nTrials;
+		double			p;
+		uBinomParams	binomParams;
+		
+		//
+		//	First generate a beta-distributed value for p
+		//
 		
-		case algConstZero:
-			p = 0.0;
+		if (me->betaAlg == algUndef)
+			me->betaAlg = SelectBetaAlg(me->alpha, me->beta, &me->betaParams);
+		
+		// ASSERT: me->betaAlg != algUndef
+		switch (me->betaAlg) {
+			default:							// Must be algIndeterm
+				p = 0.0;
+				if (((long) Taus88(me->tausData)) < 0) break;
+				// otherwise, fall into next case
+			case algConstOne:
+				p = 1.0;
+				break;
+			
+			case algConstZero:
+				p = 0.0;
+				break;
+			
+			case algUniform:
+				// a == b == 1: Uniform distribution
+				p = ULong2Unit_ZO( Taus88(me->tausData) );
+				break;
+			
+			case algArcSine:
+				// a == b == 0.5: Arc Sine distribution
+				p = GenArcsineTaus88(me->tausData);
+				break;
+			
+			case algJoehnk:
+				p = GenBetaJKTaus88(&me->betaParams.jk, me->tausData);
+				break;
+			
+			case algChengBB:
+				p = GenBetaBBTaus88(&me->betaParams.bb, me->tausData);
+				break;
+			
+			case algChengBC:
+				p = GenBetaBCTaus88(&me->betaParams.bc, me->tausData);
+				break;
+			}
+		
+		//
+		//	Now use that to generate a (n, p)-distributed binomial variate
+		//
+		
+		switch ( SelectBinomAlg(n, p, &binomParams) ) {
+		default:											// Must be genAlwaysZero
+			b = 0;
 			break;
 		
-		case algUniform:
-			// a == b == 1: Uniform distribution
-			p = ULong2Unit_ZO( Taus88(me->tausData) );
+		case binalgAlwaysN:
+			b = me->nTrials;
 			break;
 		
-		case algArcSine:
-			// a == b == 0.5: Arc Sine distribution
-			p = GenArcsineTaus88(me->tausData);
+		case binalgFiftyFifty:
+			b = GenDevBinomialFCTaus88(n, me->tausData);
 			break;
 		
-		case algJoehnk:
-			p = GenBetaJKTaus88(&me->betaParams.jk, me->tausData);
+		case binalgBruteForce:
+			b = GenDevBinomialBFTaus88(n, binomParams.bfThresh, me->tausData);
 			break;
 		
-		case algChengBB:
-			p = GenBetaBBTaus88(&me->betaParams.bb, me->tausData);
+		case binalgBInversion:
+			b = GenBinomialBINV(&binomParams.binvStuff, (tRandomFunc) Taus88, (void*) me->tausData);
 			break;
 		
-		case algChengBC:
-			p = GenBetaBCTaus88(&me->betaParams.bc, me->tausData);
+		case binalgBTPErej:
+			b = GenBinomialBTPE(&binomParams.btpeStuff, (tRandomFunc) Taus88, (void*) me->tausData);
 			break;
+			}
+		
+		return b;
 		}
+
+static void
+BibiBang(
+	objBibi* me)
 	
-	//
-	//	Now use that to generate a (n, p)-distributed binomial variate
-	//
-	
-	switch ( SelectBinomAlg(n, p, &binomParams) ) {
-	default:											// Must be genAlwaysZero
-		b = 0;
-		break;
-	
-	case binalgAlwaysN:
-		b = me->nTrials;
-		break;
-	
-	case binalgFiftyFifty:
-		b = GenDevBinomialFCTaus88(n, me->tausData);
-		break;
-	
-	case binalgBruteForce:
-		b = GenDevBinomialBFTaus88(n, binomParams.bfThresh, me->tausData);
-		break;
-	
-	case binalgBInversion:
-		b = GenBinomialBINV(&binomParams.binvStuff, (tRandomFunc) Taus88, (void*) me->tausData);
-		break;
-	
-	case binalgBTPErej:
-		b = GenBinomialBTPE(&binomParams.btpeStuff, (tRandomFunc) Taus88, (void*) me->tausData);
-		break;
+	{
+	outlet_int(me->coreObject.o_outlet, NextDeviate(me));
+	}
+
+	static void DrawDeviates(objBibi* me, long oVals[], long iCount)
+		{
+		long i;
+		
+		for (i = 0; i < iCount; i += 1)
+			oVals[i] = NextDeviate(me);
 		}
+
+static void
+BibiDraw(
+	objBibi*	me,
+	long		iCount,
+	Symbol*		iDest)
 	
-	outlet_int(me->coreObject.o_outlet, b);
+	{
+	DrawLongs(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawLongFunc) DrawDeviates);
 	}
 	
 
@@ -339,6 +370,7 @@ BibiNew(
 	me->beta		= kDefBeta;
 	me->betaAlg		= algUndef;
 	me->betaParams	= kDefParams;
+	DrawInit(&me->drawBuf);
 	
 	// Run through initialization parameters from right to left, checking for defaults
 	switch (iArgC) {
@@ -373,7 +405,10 @@ BibiNew(
 	}
 
 static void BibiFree(objBibi* me)
-	{ Taus88Free(me->tausData); }							// Taus88Free is NIL-safe
+	{
+	Taus88Free(me->tausData);								// Taus88Free is NIL-safe
+	DrawFree(&me->drawBuf);
+	}
 
 
 #pragma mark -
@@ -660,6 +695,7 @@ main(void)
 	LitterAddMess1	((method) BibiAlpha,	"ft2",		A_FLOAT);
 	LitterAddMess1	((method) BibiBeta,		"ft3",		A_FLOAT);
 	LitterAddMess1 ((method) BibiSeed,		"seed",		A_DEFLONG);
+	LitterAddMess2 ((method) BibiDraw,		"draw",		A_LONG, A_DEFSYM);
 	LitterAddMess2	((method) BibiTell,		"tell",		A_SYM, A_SYM);
 	LitterAddMess0	((method) BibiTattle,	"tattle");
 	LitterAddCant	((method) BibiTattle,	"dblclick");
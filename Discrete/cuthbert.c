@@ -10,6 +10,11 @@
 
 	Change History (most recent first):
 
+         <1>  18–10–2026    pc      Replace the urn scan with a constant-time draw and add the draw
+                                    message. Arguments are value count, seed (both as before) and
+                                    memory length. refer, set, clear/zero, const and count are
+                                    kept, but ball counts only decide whether a value can be
+                                    drawn: every value with a nonzero count is equally likely.
 */
 
 
@@ -22,12 +27,14 @@
 #include "TrialPeriodUtils.h"
 #include "Taus88.h"
 #include "MiscUtils.h"
+#include "DrawUtils.h"
 
 #pragma mark • Constants
 
 const char*		kClassName	= "lp.cuthbert";			// Class name
 
-const long		kDefMemory	= 1;
+const long		kDefValCount	= 2,
+				kDefMemory		= 1;
 
 	// Indices for STR# resource
 enum {
@@ -41,15 +48,6 @@ enum {
 	};
 
 
-#pragma mark Macros
-
-	// Ugly macro to change BlockMoveData() to memcpy() on Windows.
-	// I don't understand why BlockMoveData() isn't working on Windows,
-	// but this change makes things work
-#ifdef WIN_VERSION
-	#define BlockMoveData(SRC, DEST, BYTES)		memcpy(DEST, SRC, BYTES)
-#endif
-
 #pragma mark • Type Definitions
 
 
@@ -65,12 +63,15 @@ typedef struct {
 					curMemLen,		// The last curMemLen values won't be repeated
 					wantMemLen,		// The user may have asked for longer memory
 									// than is possible with the current valCount
-					memSize;		// Size of memory buffer, >= sizeof(long) * curMemLen
-	long*			memory;			// Initial state of urn
-	long*			state;						// Current state (after removing balls)
-		// Cache total number of balls in both master and state vectors
-	long			totalBalls,
-					ballsInUrn;
+					poolSize,		// Values with a nonzero ball count (<= valCount)
+					filled,			// Values in the cooling ring (<= curMemLen)
+					head;			// Ring position of the oldest cooling value
+	long*			perm;			// Permutation of [0 .. valCount). The first curMemLen
+									// slots are the cooling ring, the rest of the first
+									// poolSize slots are available. Values past poolSize
+									// are never drawn.
+	
+	tDrawBuf		drawBuf;		// Output buffer for the draw message
 	
 	} tCuthbert;
 
@@ -82,21 +83,23 @@ typedef struct {
 #pragma mark • Function Prototypes
 
 	// Class message functions
-void*	CuthbertNew	(long, long);
+void*	CuthbertNew		(long, long, long);
 void	CuthbertFree	(tCuthbert*);
 
 	// Object message functions
 static void CuthbertBang	(tCuthbert*);
+static void CuthbertDraw	(tCuthbert*, long, Symbol*);
+static void CuthbertMemLen	(tCuthbert*, long);
 static void CuthbertTable	(tCuthbert*, Symbol*);
-static void CuthbertSet	(tCuthbert*, Symbol*, short, Atom*);
+static void CuthbertSet		(tCuthbert*, Symbol*, short, Atom*);
 static void CuthbertClear	(tCuthbert*);
 static void CuthbertConst	(tCuthbert*, long);
 static void CuthbertReset	(tCuthbert*);
 static void CuthbertSize	(tCuthbert*, long);
 static void CuthbertCount	(tCuthbert*, long);
 static void CuthbertSeed	(tCuthbert*, long);
-static void CuthbertTattle(tCuthbert*);
-static void	CuthbertAssist(tCuthbert*, void* , long , long , char*);
+static void CuthbertTattle	(tCuthbert*);
+static void	CuthbertAssist	(tCuthbert*, void* , long , long , char*);
 static void	CuthbertInfo	(tCuthbert*);
 
 
@@ -105,6 +108,64 @@ static void	CuthbertInfo	(tCuthbert*);
 
 #pragma mark • Inline Functions
 
+/******************************************************************************************
+ *
+ *	NextValue(me, ioS1, ioS2, ioS3)
+ *
+ *	me->perm holds every value in [0 .. valCount) exactly once. The first curMemLen slots
+ *	form a ring of recently emitted ("cooling") values, oldest at me->head; the remaining
+ *	slots up to poolSize hold the values available for output.
+ *
+ *	A draw picks one available slot at random and swaps its value with the oldest cooling
+ *	value: the new value starts cooling, the oldest one is released. Until the ring has
+ *	filled up after a reset, the chosen value is swapped to the end of the ring instead.
+ *	Either way a draw takes constant time, regardless of valCount or memory length.
+ *
+ *	If no value has a nonzero ball count, the result is -1 (as for lp.ernie's empty urn).
+ *
+ ******************************************************************************************/
+
+static inline long
+NextValue(
+	tCuthbert*	me,
+	UInt32*		ioS1,
+	UInt32*		ioS2,
+	UInt32*		ioS3)
+	
+	{
+	long*	perm	= me->perm;
+	long	mem		= me->curMemLen,
+			i, x;
+	
+	if (me->poolSize <= 0)
+		return -1;
+	
+	if (me->filled < mem) {
+		long filled = me->filled;
+		
+		i = filled + (long) ((double) (me->poolSize - filled)
+								* ULong2Unit_Zo(Taus88Process(ioS1, ioS2, ioS3)));
+		x			= perm[i];
+		perm[i]		= perm[filled];
+		perm[filled]= x;
+		me->filled	= filled + 1;
+		}
+	
+	else {
+		long head = me->head;
+		
+		i = mem + (long) ((double) (me->poolSize - mem)
+								* ULong2Unit_Zo(Taus88Process(ioS1, ioS2, ioS3)));
+		x			= perm[i];
+		perm[i]		= perm[head];
+		perm[head]	= x;
+		if (++head >= mem)
+			head = 0;
+		me->head	= head;
+		}
+	
+	return x;
+	}
 
 
 #pragma mark -
@@ -125,29 +186,32 @@ main(void)
 	
 	// Standard Max setup() call
 	setup(	&gObjectClass,				// Pointer to our class definition
-			(method) CuthbertNew,			// Instance creation function
-			(method) CuthbertFree,			// Deallocation function
-			(short) sizeof(tCuthbert),		// Class object size
+			(method) CuthbertNew,		// Instance creation function
+			(method) CuthbertFree,		// Deallocation function
+			(short) sizeof(tCuthbert),	// Class object size
 			NIL,						// No menu function
-			A_DEFLONG,					// Optional arguments:	1: Data size
+			A_DEFLONG,					// Optional arguments:	1: Number of values
 			A_DEFLONG,					// 						2: seed
+			A_DEFLONG,					// 						3: Memory length
 			0);		
 	
 
 	// Messages
 	LITTER_TIMEBOMB LitterAddBang	((method) CuthbertBang);
-	addmess	((method) CuthbertTable,		"refer",	A_SYM, 0);
-	addmess	((method) CuthbertSet,			"set",		A_GIMME, 0);
+	addinx	((method) CuthbertMemLen,	1);
+	addmess	((method) CuthbertDraw,		"draw",		A_LONG, A_DEFSYM, 0);
+	addmess	((method) CuthbertTable,	"refer",	A_SYM, 0);
+	addmess	((method) CuthbertSet,		"set",		A_GIMME, 0);
 	addmess ((method) CuthbertSeed,		"seed",		A_DEFLONG, 0);
-	addmess ((method) CuthbertClear,		"clear",	A_NOTHING);
-	addmess ((method) CuthbertClear,		"zero",		A_NOTHING);
-	addmess ((method) CuthbertConst,		"const",	A_DEFLONG, 0);
-	addmess ((method) CuthbertReset,		"reset",	A_NOTHING);
+	addmess ((method) CuthbertClear,	"clear",	A_NOTHING);
+	addmess ((method) CuthbertClear,	"zero",		A_NOTHING);
+	addmess ((method) CuthbertConst,	"const",	A_DEFLONG, 0);
+	addmess ((method) CuthbertReset,	"reset",	A_NOTHING);
 	addmess	((method) CuthbertSize,		"size",		A_LONG, 0);
-	addmess	((method) CuthbertCount,		"count",	A_DEFLONG, 0);
-	addmess	((method) CuthbertTattle,		"dblclick",	A_CANT, 0);
-	addmess	((method) CuthbertTattle,		"tattle",	A_NOTHING);
-	addmess	((method) CuthbertAssist,		"assist",	A_CANT, 0);
+	addmess	((method) CuthbertCount,	"count",	A_DEFLONG, 0);
+	addmess	((method) CuthbertTattle,	"dblclick",	A_CANT, 0);
+	addmess	((method) CuthbertTattle,	"tattle",	A_NOTHING);
+	addmess	((method) CuthbertAssist,	"assist",	A_CANT, 0);
 	addmess	((method) CuthbertInfo,		"info",		A_CANT, 0);
 	
 	//Initialize Litter Library
@@ -162,49 +226,54 @@ main(void)
 
 /******************************************************************************************
  *
- *	CuthbertNew(iOracle)
+ *	CuthbertNew(iValCount, iSeed, iMemLen)
+ *
+ *	The first two arguments are in the same place as before the memory length was added,
+ *	so existing patches keep their value count and seed.
  *
  ******************************************************************************************/
 
 void*
 CuthbertNew(
-	long	iDataSize,
-	long	iSeed)
+	long	iValCount,
+	long	iSeed,
+	long	iMemLen)
 	
 	{
-	tCuthbert*			me				= NIL;
+	tCuthbert*		me				= NIL;
 	tTaus88DataPtr	myTaus88Stuff	= NIL;
 	
 	
-	// Run through initialization parameters from right to left, handling defaults
-	if (iSeed != 0) {
+	// Run through initialization parameters, handling defaults
+	if (iMemLen == 0)
+		iMemLen = kDefMemory;
+	if (iSeed != 0)
 		myTaus88Stuff = Taus88New(iSeed);
-		goto noMoreDefaults;
-		}
-	
-	if (iDataSize == 0)
-		iDataSize = kDefMemory;
-noMoreDefaults:
+	if (iValCount <= 0)
+		iValCount = kDefValCount;
 	// Finished checking intialization parameters
 
-	// Let Max allocate us and our outlets. We only use the default inlet
-	me = (tCuthbert*) LitterAllocateObject
-
+	// Let Max allocate us, our inlets, and outlets.
+	me = (tCuthbert*) LitterAllocateObject();
 	if (me == NIL) goto punt;
 	
-	me->resetOutlet	= bangout(me);
+	intin(me, 1);
 	intout(me);							// Access through me->coreObject.o_outlet
 	
 	// Initialize object components
 	me->tausData	= myTaus88Stuff;
-	me->dataSize	= 0;				// Start from clean slate before calling CuthbertSize()
-	me->master		= NIL;
-	me->state		= NIL;
-	CuthbertSize(me, iDataSize);
-	if (me->master == NIL || me->state == NIL) {
+	me->valCount	= 0;				// Start from clean slate before calling CuthbertSize()
+	me->curMemLen	= 0;
+	me->wantMemLen	= (iMemLen > 0) ? iMemLen : 0;
+	me->poolSize	= 0;
+	me->filled		= 0;
+	me->head		= 0;
+	me->perm		= NIL;
+	DrawInit(&me->drawBuf);
+	
+	CuthbertSize(me, iValCount);
+	if (me->perm == NIL)
 		goto punt;
-		}
-	CuthbertClear(me);
 	
 	return me;
 
@@ -220,40 +289,10 @@ punt:
 
 /******************************************************************************************
  *
- *	CuthbertFree(iOracle)
+ *	CuthbertFree(me)
  *
  ******************************************************************************************/
 
-	static void DeferDisposePtr(Ptr iPtr, Symbol* sym, short argc, Atom argv[])
-		{
-		#pragma unused(sym, argc, argv)
-		
-		DisposePtr(iPtr);
-		}
-	
-	static void DisposeMemory(long* iMaster, long* iState, long memBytes)
-		{
-		
-		// Non-zero memBytes indicates that we are using Max' own memory allocation
-		if (memBytes > 0) {
-			if (iMaster != NIL)	freebytes(iMaster, memBytes);
-			if (iState != NIL)	freebytes(iState, memBytes);
-			}
-		
-		// If we are using Mac OS memory allocation, remember that even though the memory
-		// was allocated outside an interrupt, DisposeMemory() may be called inside an
-		// interrupt
-		else if (isr() != 0) {
-			if (iMaster != NIL)	defer(iMaster, (method) DeferDisposePtr, NIL, 0, NIL);
-			if (iState != NIL)	defer(iState, (method) DeferDisposePtr, NIL, 0, NIL);
-			}
-		
-		else {
-			if (iMaster != NIL)	DisposePtr((Ptr) iMaster);
-			if (iState != NIL)	DisposePtr((Ptr) iState);
-			}
-		}
-
 void
 CuthbertFree(
 	tCuthbert*	me)
@@ -262,7 +301,9 @@ CuthbertFree(
 	
 	Taus88Free(me->tausData);					// Taus88Free is NIL-safe
 	
-	DisposeMemory(me->master, me->state, me->maxMemory ? sizeof(long) * me->dataSize : 0);
+	if (me->perm != NIL)
+		DisposePtr((Ptr) me->perm);
+	DrawFree(&me->drawBuf);
 	
 	}
 
@@ -272,6 +313,10 @@ CuthbertFree(
 /******************************************************************************************
  *
  *	CuthbertBang(me)
+ *	CuthbertDraw(me, iCount, iDest)
+ *
+ *	The draw message sends iCount values as one list (or writes them to the buffer~ or
+ *	table iDest), loading and storing the Taus88 registers once per chunk.
  *
  ******************************************************************************************/
 
@@ -280,48 +325,51 @@ CuthbertBang(
 	tCuthbert* me)
 	
 	{
-	long	theBall = -1;			// This is the result defined for the degenerate case
-									// of "no balls in the system"; this value also allows
-									// the main loop condition to be streamlined.
+	tTaus88Data*	td = me->tausData;
+	UInt32			s1, s2, s3;
+	long			x;
 	
+	if (td == NIL)
+		td = Taus88GetGlobals();
 	
-	if (me->totalBalls > 0) {
-		long	magic;
-		long*	sp;
-		
-		if (me->ballsInUrn == 0) {
-			CuthbertReset(me);
-			}
-		
-		// ULong2Unit_Zo returns value in range			[0.0 .. 1.0)
-		// * b	  (b = ballsInUrn) results in range		[0.0 .. b)
-		// + 1.0			results in range			[1.0 .. b + 1.0)
-		// conversion to int results in range			[1 .. b] w/equiprob. for each value
-		// QED
-		magic = ((double) me->ballsInUrn) * ULong2Unit_Zo(Taus88(me->tausData)) + 1.0;
-		
-		// This initial value allows the loop below to increment the pointer as part of
-		// the loop condition.
-		sp = me->state - 1;
+	Taus88Load(td, &s1, &s2, &s3);
+	x = NextValue(me, &s1, &s2, &s3);
+	Taus88Store(td, s1, s2, s3);
+	
+	outlet_int(me->coreObject.o_outlet, x);
+	
+	}
+
+	static void DrawDeviates(tCuthbert* me, long oVals[], long iCount)
+		{
+		tTaus88Data*	td = me->tausData;
+		UInt32			s1, s2, s3;
+		long			i;
 		
-		// ASSERT: loop terminates for all values of magic in [1 .. b] due to
-		// b == sum(sp[0] .. sp[dataSize-1])
-		do {
-			theBall += 1;
-			} while ((magic -= *++sp) > 0);
+		if (td == NIL)
+			td = Taus88GetGlobals();
 		
-		// Update state of urn
-		*sp				-= 1;
-		me->ballsInUrn	-= 1;
+		Taus88Load(td, &s1, &s2, &s3);
+		for (i = 0; i < iCount; i += 1)
+			oVals[i] = NextValue(me, &s1, &s2, &s3);
+		Taus88Store(td, s1, s2, s3);
 		}
+
+void
+CuthbertDraw(
+	tCuthbert*	me,
+	long		iCount,
+	Symbol*		iDest)
 	
-	outlet_int(me->coreObject.o_outlet, theBall);
-	
+	{
+	DrawLongs(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawLongFunc) DrawDeviates);
 	}
 
 
 /******************************************************************************************
  *
+ *	CuthbertMemLen(me, iMemLen)
  *	CuthbertTable(me, iTable)
  *	CuthbertSet(me, iSym, iArgC, iArgV)
  *	CuthbertClear(me)
@@ -331,223 +379,231 @@ CuthbertBang(
  *	
  *	Set parameters and data. Make sure nothing bad is happening.
  *	
+ *	Changing the memory length keeps as much history as possible: the cooling ring is
+ *	rotated so that the oldest value comes first. Shortening the memory then releases the
+ *	oldest values; lengthening it just lets the ring fill up further.
+ *	
+ *	refer, set, clear and const date from when lp.cuthbert was an urn model like lp.ernie
+ *	and still take lists of ball counts. There are no balls anymore: a value with a
+ *	nonzero count can be drawn, a value with a zero count can't. All drawable values are
+ *	equally likely, whatever their count. Each of these messages implies a reset.
+ *	
  ******************************************************************************************/
 
-	static void RecalcMasterTotal(tCuthbert* me)
+	static void Reverse(long iVals[], long iLo, long iHi)
 		{
-		unsigned	dataSize	= me->dataSize;
-		long*		data		= me->master;
-		long		total		= 0;
+		// Reverses iVals[iLo .. iHi)
+		while (iLo < --iHi) {
+			long x = iVals[iLo];
+			iVals[iLo++] = iVals[iHi];
+			iVals[iHi] = x;
+			}
+		}
+	
+	static void RotateLeft(long iVals[], long iCount, long iShift)
+		{
+		if (iShift <= 0 || iShift >= iCount)
+			return;
+		
+		Reverse(iVals, 0, iShift);
+		Reverse(iVals, iShift, iCount);
+		Reverse(iVals, 0, iCount);
+		}
+	
+	static void ApplyMemLen(tCuthbert* me)
+		{
+		long	memLen = me->wantMemLen;
+		
+		if (memLen > me->poolSize - 1)
+			memLen = me->poolSize - 1;
+		if (memLen < 0)
+			memLen = 0;
 		
-		while (dataSize-- > 0) {
-			total += *(data++);
+		// Linearize the ring, oldest first
+		RotateLeft(me->perm, me->filled, me->head);
+		me->head = 0;
+		
+		if (memLen < me->filled) {
+			// Keep the newest values, release the rest into the available region
+			RotateLeft(me->perm, me->filled, me->filled - memLen);
+			me->filled = memLen;
 			}
 		
-		me->totalBalls = total;
+		me->curMemLen = memLen;
 		}
 
 void
-CuthbertTable(
+CuthbertMemLen(
 	tCuthbert*	me,
-	Symbol*	iTable)
+	long		iMemLen)
 	
 	{
-	long**	tableData;			// Isn't there a typedef that could be used???
-	long	size;
-	
-	if (table_get(iTable, &tableData, &size) == 0) {
-		if (size > me->dataSize) size = me->dataSize;	// Don't read more than we can
-		else if (size < me->dataSize) {
-			// Cheesy way to zero out values not specified in the table
-			me->dataSize	-= size;
-			me->master		+= size;
-			me->state		+= size;
-			CuthbertConst(me, 0);
-			me->dataSize	+= size;
-			me->master		-= size;
-			me->state		-= size;
+	
+	me->wantMemLen = (iMemLen > 0) ? iMemLen : 0;
+	ApplyMemLen(me);
+	
+	}
+
+	static void RebuildPool(tCuthbert* me)
+		{
+		// On entry me->perm[v] holds the ball count for value v. On exit it holds a
+		// permutation with the values that have a nonzero count first, in ascending order.
+		long*	perm		= me->perm;
+		long	valCount	= me->valCount,
+				poolSize	= 0,
+				j, k, v;
+		Boolean	weighted	= false;
+		
+		for (v = 0; v < valCount; v += 1) {
+			if (perm[v] > 1)
+				weighted = true;
+			if (perm[v] > 0)
+				perm[poolSize++] = v;			// poolSize <= v, so no count is lost
+			}
+		
+		// Append the values that weren't copied to the front
+		for (v = 0, j = 0, k = poolSize; v < valCount; v += 1) {
+			if (j < poolSize && perm[j] == v)
+				j += 1;
+			else perm[k++] = v;
 			}
 		
-		BlockMoveData(*tableData, me->master, size * sizeof(long));
+		if (weighted)
+			post("%s: ball counts greater than 1 are treated as 1", kClassName);
 		
-		RecalcMasterTotal(me);
+		me->poolSize = poolSize;
 		CuthbertReset(me);
 		}
+
+void
+CuthbertTable(
+	tCuthbert*	me,
+	Symbol*		iTable)
 	
-	else error("%s: can't find table named %s", kClassName, iTable->s_name);
+	{
+	long**	tableData;
+	long	size,
+			i;
 	
-	}
+	if (table_get(iTable, &tableData, &size) != 0) {
+		error("%s: can't find table named %s", kClassName, iTable->s_name);
+		return;
+		}
 	
+	if (size > me->valCount)
+		size = me->valCount;					// Don't read more than we can
+	
+	for (i = 0; i < size; i += 1)
+		me->perm[i] = (*tableData)[i];
+	for ( ; i < me->valCount; i += 1)
+		me->perm[i] = 0;
+	
+	RebuildPool(me);
+	
+	}
+
 void
 CuthbertSet(
 	tCuthbert*	me,
-	Symbol*	sym,				// Is always gensym("set")
-	short	iArgC,
-	Atom*	iArgV)
+	Symbol*		sym,						// Is always gensym("set")
+	short		iArgC,
+	Atom*		iArgV)
 	
 	{
 	#pragma unused(sym)
 	
-	long*	dataPtr = me->master;
-	long	total	= 0;
-	// Nothing Enter/ExitCallback()-sensitive here;
-	
-	if (iArgC > me->dataSize)	iArgC = me->dataSize;
-	else if (iArgC < me->dataSize) {
-		// Cheesy way to zero out values not specified in the Atom vector
-		me->dataSize	-= iArgC;
-		me->master		+= iArgC;
-		me->state		+= iArgC;
-		CuthbertConst(me, 0);
-		me->dataSize	+= iArgC;
-		me->master		-= iArgC;
-		me->state		-= iArgC;
-		}
-	while (iArgC-- > 0) {
-		long	val;
-		switch (iArgV->a_type) {
-			case A_LONG:
-				val = iArgV->a_w.w_long;
-				break;
-			case A_FLOAT:
-				val = iArgV->a_w.w_float;
-				break;
-			default:
-				// We don't like this to happen, but we won't kvetch
-				val = 0;
-				break;
-			}
-		*(dataPtr++) = val;
-		total += val;
-		iArgV += 1;
-		}
-	me->totalBalls = total;
-	CuthbertReset(me);
+	long	i;
 	
-	}
+	if (iArgC > me->valCount)
+		iArgC = me->valCount;
+	
+	for (i = 0; i < iArgC; i += 1)
+		me->perm[i] = AtomGetLong(&iArgV[i]);	// Symbols count as zero
+	for ( ; i < me->valCount; i += 1)
+		me->perm[i] = 0;
 	
+	RebuildPool(me);
+	
+	}
+
 void
 CuthbertClear(
 	tCuthbert*	me)
 	
 	{
 	
-	CuthbertConst(me, 0);		// That's all. Don't even need Enter/ExitCallback mantra
+	CuthbertConst(me, 0);
 	
 	}
 
 void
 CuthbertConst(
 	tCuthbert*	me,
-	long	iVal)
+	long		iVal)
 	
 	{
-	long*		dataPtr	= me->master;
-	unsigned	ds		= me->dataSize;
-	// Nothing Enter/ExitCallback()-sensitive here;
+	long	i;
 	
-	me->totalBalls = ds * iVal;
-	while (ds-- > 0) {
-		*(dataPtr++) = iVal;
-		}
+	for (i = 0; i < me->valCount; i += 1)
+		me->perm[i] = iVal;
 	
-	CuthbertReset(me);
+	RebuildPool(me);
 	
 	}
-	
-	
+
+	static void DeferSize(tCuthbert* me, Symbol* sym, short argc, Atom argv[])
+		{
+		#pragma unused(sym, argc)
+		
+		CuthbertSize(me, argv[0].a_w.w_long);
+		}
+
 void
 CuthbertSize(
 	tCuthbert*	me,
-	long	iSize)
+	long		iSize)
 	
 	{
-	const long	kMaxSize = 4095;	// Largest number of "balls" we can reliably allocate
-	
-	long*	newMaster;
-	long*	newState;
-	Boolean	maxMemory;
-	long	sizeBytes;				// Use this for a couple of purposes
-						
-	if (iSize > kMaxSize) {
-			error("%s can't handle more than %lf different kinds of 'ball'.",
-					kClassName, kMaxSize);
-			iSize = kMaxSize;
-			}
-	else if (iSize <= 0) {
-		error("%s size parameter must be positive");
+	long*	newPerm;
+	long	i;
+	
+	if (iSize <= 0) {
+		error("%s: size parameter must be positive", kClassName);
 		return;
 		}
 	
-	if (iSize == me->dataSize) {
-		// Nothin' to do...
-		// ... 'cept that the documentation asserts that a size message always entails a reset
-		CuthbertReset(me);
+	if (iSize == me->valCount) {
+		// Nothin' to allocate...
+		// ... 'cept that a size message always makes every value drawable and resets
+		CuthbertConst(me, 1);
 		return;
 		}
-				
-	sizeBytes = sizeof(long) * iSize;						// New buffer size in bytes
-	maxMemory = (isr() != 0);								// User getbytes() or NewPtr() ?
 	
-	if (maxMemory) {
-		newMaster	= (long*) getbytes(sizeBytes);
-		newState	= (long*) getbytes(sizeBytes);
-		}
-	else {
-		// We could NewPtrClr() here or try SetPtrSize(), but that would entail even
-		// more special casing. Also note that we are not trying for Temp Memory.
-		// That, too, would entail more special case handling.
-		// Using handles on the Mac Memory side might be worth the overhead of extra
-		// special-case handling, and we might try that in a future version...
-		newMaster	= (long*) NewPtr(sizeBytes);
-		newState	= (long*) NewPtr(sizeBytes);
+	// Don't allocate memory at interrupt level
+	if (isr()) {
+		Atom sizeAtom;
+		
+		AtomSetLong(&sizeAtom, iSize);
+		defer(me, (method) DeferSize, NIL, 1, &sizeAtom);
+		return;
 		}
 	
-	if (newMaster == NIL || newState == NIL) {
-		// Aw, shucks.
-		// Let's try to articulate the problem a little better than getbytes() does
-		error("%s: Max cannot allocate the required memory for size message.");
+	newPerm = (long*) NewPtr(iSize * sizeof(long));
+	if (newPerm == NIL) {
+		error("%s: Max cannot allocate the required memory for size message.", kClassName);
 		post ("    Try a smaller value.");
-		DisposeMemory(newMaster, newState, maxMemory ? sizeBytes : 0);
 		return;
 		}
 	
-	// Any old data to copy and and dispose of?
-	if (me->dataSize > 0) {
-		if (me->dataSize < iSize)
-			sizeBytes = sizeof(long) * me->dataSize;	// Now number of bytes to move
-		BlockMoveData(	me->master, newMaster, sizeBytes);
-		BlockMoveData(	me->master, newState, sizeBytes);
-		DisposeMemory(me->master, me->state, me->maxMemory ? sizeof(long) * me->dataSize : 0);
-		}
-	me->maxMemory	= maxMemory;
-	me->master		= newMaster;
-	me->state		= newState;
-	
-	// What's the best way to recalculate total, zero new entries, etc.?
-	if (me->dataSize > iSize || me->dataSize == 0) {
-		// Memory has shrunk; we need to recalc the master total
-		// ... or this could be the first time through
-		// This could be made faster by checking if (iSize > me->dataSize/2 && me->dataSize != 0).
-		// Maybe someday.
-		// Such an optimization would also entail moving the deallocation around. Pain.
-		me->dataSize = iSize;
-		RecalcMasterTotal(me);
-		}
-	else {
-		// Memory has expanded. Master total is good, but we need to set the counts of the
-		// "new" balls to 0. Variant on cheesy trick.
-		long	oldTotal	= me->totalBalls,
-				oldSize		= me->dataSize;
-		me->master		+= oldSize;
-		me->state		+= oldSize;
-		me->dataSize	=  iSize - me->dataSize;
-		CuthbertConst(me, 0);
-		me->master		-= oldSize;
-		me->state		-= oldSize;
-		me->dataSize	=  iSize;
-		me->totalBalls	=  oldTotal;
-		}
+	for (i = 0; i < iSize; i += 1)
+		newPerm[i] = i;
+	
+	if (me->perm != NIL)
+		DisposePtr((Ptr) me->perm);
+	me->perm		= newPerm;
+	me->valCount	= iSize;
+	me->poolSize	= iSize;
+	
 	CuthbertReset(me);
 	
 	}
@@ -559,10 +615,10 @@ CuthbertReset(
 	
 	{
 	
-	BlockMoveData(me->master, me->state, me->dataSize * sizeof(long));
-	me->ballsInUrn = me->totalBalls;
-	
-	outlet_bang(me->resetOutlet);
+	// Forget history; the permutation itself can stay as it is
+	me->filled	= 0;
+	me->head	= 0;
+	ApplyMemLen(me);
 	
 	}
 
@@ -571,25 +627,25 @@ CuthbertReset(
  *
  *	CuthbertCount(me, iWhat)
  *	
- *	Send information out left outlet. The iWhat parameter determines whether count/sum is
- *	made on all balls (when iWhat is zero), only the balls still in the urn (for positive
- *	iWhat), or balls already taken out of the urn (negative values). 
+ *	Send information out left outlet, following lp.ernie. With iWhat zero, the number of
+ *	values that can be drawn at all; for positive iWhat the number that can be drawn right
+ *	now; for negative iWhat the number held back by the memory.
  *	
  ******************************************************************************************/
 
 void
 CuthbertCount(
 	tCuthbert*	me,
-	long	iWhat)
+	long		iWhat)
 	
 	{
-	long	result = 0;
+	long	result;
 	
 	if (iWhat == 0)
-			result = me->totalBalls;
+			result = me->poolSize;
 	else if (iWhat > 0)
-			result = me->ballsInUrn;
-	else	result = me->totalBalls - me->ballsInUrn;
+			result = me->poolSize - me->filled;
+	else	result = me->filled;
 	
 	outlet_int(me->coreObject.o_outlet, result);
 	
@@ -622,13 +678,15 @@ CuthbertTattle(
 	
 	post("%s state",
 			kClassName);
-	post("  number of kinds of balls in urn is %lu",
-			me->dataSize);
-	post("  total number of balls currently in urn is %lu (initial state is %lu)",
-			me->ballsInUrn,
-			me->totalBalls);
-	post("  Current memory allocation is using %s",
-			me->maxMemory ? "getbytes()" : "NewPtr()");
+	post("  generating values from 0 to %ld",
+			me->valCount - 1);
+	if (me->poolSize < me->valCount)
+		post("  (%ld of these have a nonzero count)", me->poolSize);
+	post("  no repetitions within %ld values (%ld in memory)",
+			me->curMemLen,
+			me->filled);
+	if (me->wantMemLen != me->curMemLen)
+		post("  (requested memory length is %ld)", me->wantMemLen);
 	
 	}
 
@@ -33,7 +33,9 @@
 #include "TrialPeriodUtils.h"
 #include "Taus88.h"
 #include "MiscUtils.h"
+#include "RNGGauss.h"
 #include "UniformExpectations.h"
+#include "DrawUtils.h"
 
 
 #pragma mark • Constants
@@ -43,8 +45,12 @@ const char*	kPackageName	= "lp.dicey Package";	// Package name for 'vers'(2) res
 
 const long	kDefNDice		= 2,
 			kDefNFaces		= 6,
-			kMinFaces		= 1;			// How can a die have one face?
+			kMinFaces		= 1,			// How can a die have one face?
 											// Don't ask me; ask a topologist.
+			kMaxSupport		= 65536,		// Largest sum distribution we tabulate
+			kDirectMax		= 32;			// Beyond this many dice we won't loop per die
+
+const double kExactBudget	= 33554432.0;	// Max. multiply-adds to convolve the PMF (2^25)
 
 	// Indices for STR# resource
 enum {
@@ -72,48 +78,412 @@ typedef struct {
 	
 	long			nDice,
 					nFaces;
+	
+		// Cached distribution of the sum. cacheDice/cacheFaces record the parameters
+		// the cache was last evaluated for; pmf is NIL if those parameters were too
+		// expensive to tabulate exactly. pmf, prob, alias and work share one block.
+	long			cacheDice,
+					cacheFaces,
+					support;				// Number of possible sums: nDice*(nFaces-1) + 1
+	double*			pmf;
+	double*			prob;					// Alias table: acceptance probabilities...
+	long*			alias;					// ... and alias columns
+	Boolean			rebuildPending;
+	
+	tDrawBuf		drawBuf;
 	} objDicey;
 
 
 #pragma mark -
 /*****************************  I M P L E M E N T A T I O N  ******************************/
 
+#pragma mark • Utility Functions
+
+/******************************************************************************************
+ *
+ *	ExactFeasible(iNDice, iNFaces)
+ *	BuildPMF(oPMF, ioTemp, iNDice, iNFaces)
+ *	BuildAlias(iPMF, oProb, oAlias, ioWork, iSupport)
+ *
+ *	The sum of n f-sided dice takes one of S = n(f-1) + 1 values. We tabulate its
+ *	probability mass function by convolving the single-die PMF with itself n-1 times
+ *	(using a running window sum, each pass costs one add and one subtract per entry).
+ *	The whole job is about n*S/2 multiply-adds, which ExactFeasible() checks against
+ *	kExactBudget.
+ *
+ *	BuildAlias() sets up Walker's alias table (in Vose's formulation) so that a sum can
+ *	be drawn in constant time with two uniform deviates, however many dice are involved.
+ *
+ ******************************************************************************************/
+
+static Boolean
+ExactFeasible(
+	long	iNDice,
+	long	iNFaces)
+
+	{
+	double	s = (double) iNDice * (double) (iNFaces - 1) + 1.0;
+
+	return	iNDice > 0 && iNFaces >= 2
+				&& s <= (double) kMaxSupport
+				&& 0.5 * s * (double) iNDice <= kExactBudget;
+	}
+
+static void
+BuildPMF(
+	double	oPMF[],
+	double	ioTemp[],
+	long	iNDice,
+	long	iNFaces)
+
+	{
+	double	scale	= 1.0 / (double) iNFaces;
+	double*	src		= oPMF;
+	double*	dst		= ioTemp;
+	long	len		= iNFaces,					// Number of entries in src
+			d, i;
+
+	// Arrange the ping-pong so that the last pass lands in oPMF
+	if ((iNDice & 1) == 0) {
+		src = ioTemp;
+		dst = oPMF;
+		}
+
+	for (i = 0; i < iNFaces; i += 1)
+		src[i] = scale;
+
+	for (d = 1; d < iNDice; d += 1) {
+		double*	swap;
+		double	window = 0.0;
+		long	newLen = len + iNFaces - 1;
+
+		for (i = 0; i < newLen; i += 1) {
+			if (i < len)
+				window += src[i];
+			if (i >= iNFaces)
+				window -= src[i - iNFaces];
+			dst[i] = scale * window;
+			}
+
+		len		= newLen;
+		swap	= src;
+		src		= dst;
+		dst		= swap;
+		}
+
+	// Running sums accumulate a little rounding noise; make sure we're normalized
+	// and that nothing has drifted below zero.
+		{
+		double sum = 0.0;
+
+		for (i = 0; i < len; i += 1) {
+			if (oPMF[i] < 0.0)
+				oPMF[i] = 0.0;
+			sum += oPMF[i];
+			}
+		sum = 1.0 / sum;
+		for (i = 0; i < len; i += 1)
+			oPMF[i] *= sum;
+		}
+	}
+
+static void
+BuildAlias(
+	const double	iPMF[],
+	double			oProb[],
+	long			oAlias[],
+	long			ioWork[],
+	long			iSupport)
+
+	{
+	double	s		= iSupport;
+	long	nSmall	= 0,						// Small columns stack up from the bottom
+			nLarge	= iSupport,					// of ioWork[], large from the top
+			i;
+
+	for (i = 0; i < iSupport; i += 1) {
+		oProb[i]	= s * iPMF[i];
+		oAlias[i]	= i;
+		if (oProb[i] < 1.0)
+				ioWork[nSmall++] = i;
+		else	ioWork[--nLarge] = i;
+		}
+
+	while (nSmall > 0 && nLarge < iSupport) {
+		long	small	= ioWork[--nSmall],
+				large	= ioWork[nLarge];
+
+		oAlias[small] = large;
+		oProb[large] -= 1.0 - oProb[small];
+		if (oProb[large] < 1.0) {
+			// Move large column over to the small stack. Since nSmall has just been
+			// decremented there's always room at ioWork[nSmall].
+			nLarge += 1;
+			ioWork[nSmall++] = large;
+			}
+		}
+
+	// Anything left over is 1.0 up to rounding error
+	while (nSmall > 0)
+		oProb[ioWork[--nSmall]] = 1.0;
+	while (nLarge < iSupport)
+		oProb[ioWork[nLarge++]] = 1.0;
+	}
+
+
+/******************************************************************************************
+ *
+ *	FreeCache(me)
+ *	RebuildCache(me)
+ *	DeferRebuild(me, sym, argc, argv)
+ *	CacheCurrent(me)
+ *
+ ******************************************************************************************/
+
+static void
+FreeCache(
+	objDicey* me)
+
+	{
+	if (me->pmf != NIL) {
+		DisposePtr((Ptr) me->pmf);
+		me->pmf		= NIL;
+		me->prob	= NIL;
+		me->alias	= NIL;
+		}
+	me->support = 0;
+	}
+
+static void
+RebuildCache(
+	objDicey* me)
+
+	{
+	long	n = me->nDice,
+			f = me->nFaces,
+			s;
+	double*	block;
+
+	FreeCache(me);
+	me->cacheDice	= n;
+	me->cacheFaces	= f;
+
+	if ( !ExactFeasible(n, f) )
+		return;
+
+	s = n * (f - 1) + 1;
+	block = (double*) NewPtr(s * (2 * sizeof(double) + 2 * sizeof(long)));
+	if (block == NIL) {
+		error("%s: not enough memory to tabulate %ldd%ld; using approximation", kClassName, n, f);
+		return;
+		}
+
+	me->pmf		= block;
+	me->prob	= block + s;
+	me->alias	= (long*) (block + 2 * s);
+	me->support	= s;
+
+	BuildPMF(me->pmf, me->prob, n, f);						// prob[] is scratch space here
+	BuildAlias(me->pmf, me->prob, me->alias, me->alias + s, s);
+	}
+
+	static void DeferRebuild(objDicey* me, Symbol* sym, short argc, Atom argv[])
+		{
+		#pragma unused(sym, argc, argv)
+
+		me->rebuildPending = false;
+		if (me->cacheDice != me->nDice || me->cacheFaces != me->nFaces)
+			RebuildCache(me);
+		}
+
+static inline Boolean
+CacheCurrent(
+	objDicey* me)
+
+	{
+	return me->cacheDice == me->nDice && me->cacheFaces == me->nFaces;
+	}
+
+
+/******************************************************************************************
+ *
+ *	DrawAlias(me)
+ *	DrawDirect(me)
+ *	DrawNormal(me)
+ *
+ *	The three ways of throwing dice.
+ *
+ *	DrawAlias() picks a column of the alias table without bias (multiply-shift with
+ *	Lemire's rejection step) and then flips a coin weighted by prob[] to decide between
+ *	the column and its alias.
+ *
+ *	DrawDirect() is the traditional approach: throw each die and add up the results.
+ *	It is exact and cheap for a handful of dice.
+ *
+ *	DrawNormal() is used when there are too many dice to loop over and the sum's
+ *	distribution is too large to tabulate. It uses a normal deviate with a
+ *	Cornish-Fisher correction for the (negative) excess kurtosis, with both variance and
+ *	fourth cumulant adjusted for the continuity correction (Sheppard's corrections).
+ *	Skew is zero by symmetry, so the first non-trivial term is the kurtosis term. The
+ *	maximum error of the resulting CDF against the exact CDF falls off roughly as
+ *	0.007/n^2, independent of the number of faces: below 1e-5 at 32 dice, below 5e-7 at
+ *	128 dice. With the default limits this path is only taken for more than 1000 faces
+ *	or several thousand dice, where the error is well below 1e-8.
+ *
+ ******************************************************************************************/
+
+static long
+DrawAlias(
+	objDicey* me)
+
+	{
+	tTaus88Data*	td	= me->tausData;
+	UInt32			s	= me->support,
+					s1, s2, s3;
+	UInt64			m;
+	long			col;
+
+	if (td == NIL)
+		td = Taus88GetGlobals();
+	Taus88Load(td, &s1, &s2, &s3);
+
+	m = (UInt64) Taus88Process(&s1, &s2, &s3) * s;
+	if ((UInt32) m < s) {
+		UInt32 threshold = (0 - s) % s;
+
+		while ((UInt32) m < threshold)
+			m = (UInt64) Taus88Process(&s1, &s2, &s3) * s;
+		}
+	col = (long) (m >> 32);
+
+	if ( ULong2Unit_Zo(Taus88Process(&s1, &s2, &s3)) >= me->prob[col] )
+		col = me->alias[col];
+
+	Taus88Store(td, s1, s2, s3);
+
+	return me->cacheDice + col;
+	}
+
+static long
+DrawDirect(
+	objDicey* me)
+
+	{
+	long			c			= me->nDice;
+	tTaus88DataPtr	tausData	= me->tausData;
+	double			ff			= me->nFaces,		// Convert long to double now
+					d			= 0.0;
+
+	while (c-- > 0) {
+		// ULong2Unit_Zo returns value in range		[0.0 .. 1.0)
+		// * ff				results in range			[0.0 .. ff)
+		// Truncation gives equiprobable distribution of 0, 1, .. f-1, so adding
+		// c + 1 after truncating each die gives the sum.
+		d += (double) (long) (ff * ULong2Unit_Zo(Taus88(tausData)));
+		}
+
+	return (long) d + me->nDice;
+	}
+
+static long
+DrawNormal(
+	objDicey* me)
+
+	{
+	double	n		= me->nDice,
+			f		= me->nFaces,
+			f2		= f * f,
+			mu		= 0.5 * n * (f + 1.0),
+			var		= n * (f2 - 1.0) / 12.0 - 1.0 / 12.0,
+			k4		= -n * (f2 + 1.0) * (f2 - 1.0) / 120.0 + 1.0 / 120.0,
+			g		= k4 / (var * var) / 24.0,
+			z		= NormalKRTaus88(me->tausData),
+			x;
+
+	x = mu + sqrt(var) * (z + g * z * (z * z - 3.0));
+	x = floor(x + 0.5);
+
+	if (x < n)				x = n;
+	else if (x > n * f)		x = n * f;
+
+	return (long) x;
+	}
+
+
 #pragma mark • Object Message Handlers
 
 /******************************************************************************************
  *
  *	DiceyBang(me)
+ *	DiceyDraw(me, iCount, iDest)
+ *
+ *	A draw checks the cache once and then rolls iCount times, sending the sums as a list
+ *	or writing them into a buffer~ or table.
  *
  ******************************************************************************************/
 
+	static inline long NextDeviate(objDicey* me)
+		{
+		long	d;
+
+		if (me->nFaces < 2 || me->nDice == 0)
+			d = me->nDice;							// Shortcut for degenerate dice
+
+		else {
+			if ( !CacheCurrent(me) ) {
+				if ( !isr() )
+					RebuildCache(me);
+				else if ( ExactFeasible(me->nDice, me->nFaces) ) {
+					// Don't allocate memory at interrupt level; tabulate later and make do
+					// with one of the other methods in the meantime
+					if ( !me->rebuildPending ) {
+						me->rebuildPending = true;
+						defer(me, (method) DeferRebuild, NIL, 0, NIL);
+						}
+					}
+				else {
+					// Nothing to tabulate, so no need to wait for the main thread
+					FreeCache(me);
+					me->cacheDice	= me->nDice;
+					me->cacheFaces	= me->nFaces;
+					}
+				}
+
+			if (me->pmf != NIL && CacheCurrent(me))
+				d = DrawAlias(me);
+			else if (me->nDice <= kDirectMax)
+				d = DrawDirect(me);
+			else d = DrawNormal(me);
+			}
+
+		return d;
+		}
+
 static void
 DiceyBang(
 	objDicey* me)
-	
+
 	{
-	long	c	= me->nDice,		// All of these are non-negative, but will not exceed
-			f	= me->nFaces,		// kMaxLong, so don't need to declare unsigned.
-			d;						// Initialize in if/else below
-	
-	
-	if (f < 2) d = c;				// Shortcut for degenerate dice
-	else {
-		tTaus88DataPtr	tausData = me->tausData;
-		double			ff		= f;				// Convert long to double now
-		d = 0;
-		while (c-- > 0) {
-			// ULong2Unit_Zo returns value in range		[0.0 .. 1.0)
-			// * ff				results in range			[0.0 .. ff)
-			// + 1.0			results in range			[1.0 .. ff + 1.0)
-			// Thus values are equally distributed over [1 .. 2), [2 .. 3), ..., [ff .. f+1)
-			// After truncation to integer we have equiprobably distribution of 1, 2, .. f
-			// QED
-			d += ff * ULong2Unit_Zo(Taus88(tausData)) + 1.0;
-			}
+	outlet_int(me->coreObject.o_outlet, NextDeviate(me));
+	}
+
+	static void DrawDeviates(objDicey* me, long oVals[], long iCount)
+		{
+		long i;
+
+		for (i = 0; i < iCount; i += 1)
+			oVals[i] = NextDeviate(me);
 		}
+
+static void
+DiceyDraw(
+	objDicey*	me,
+	long		iCount,
+	Symbol*		iDest)
 	
-	outlet_int(me->coreObject.o_outlet, d);
-	
+	{
+	DrawLongs(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawLongFunc) DrawDeviates);
 	}
 
 
@@ -184,6 +554,14 @@ noMoreDefaults:
 	
 	// Initialize object components
 	me->tausData	= myTaus88Stuff;
+	me->cacheDice	= -1;							// Nothing cached yet
+	me->cacheFaces	= -1;
+	me->support		= 0;
+	me->pmf			= NIL;
+	me->prob		= NIL;
+	me->alias		= NIL;
+	me->rebuildPending = false;
+	DrawInit(&me->drawBuf);
 	DiceyNDice(me, iNDice);
 	DiceyNFaces(me, iNFaces);
 	
@@ -191,7 +569,11 @@ noMoreDefaults:
 	}
 
 static void DiceyFree(objDicey* me)
-	{ Taus88Free(me->tausData); }							// Taus88Free is NIL-safe
+	{
+	Taus88Free(me->tausData);								// Taus88Free is NIL-safe
+	FreeCache(me);
+	DrawFree(&me->drawBuf);
+	}
 
 #pragma mark -
 #pragma mark • Attribute/Information Functions
@@ -217,6 +599,13 @@ DiceyTattle(
 	post("  Throwing %ld dice with %ld faces each",
 			me->nDice,
 			me->nFaces);
+	if (me->nDice > 0 && me->nFaces >= 2) {
+		if (me->pmf != NIL && CacheCurrent(me))
+			post("  Sums drawn from a tabulated distribution (%ld values)", me->support);
+		else if (me->nDice <= kDirectMax)
+			post("  Each die is thrown individually");
+		else post("  Sums drawn from a corrected normal approximation");
+		}
 	if ( CanOverflow(me) ) {
 		post("  --> These parameters may cause arithmetic overflow.");
 		if (Taus88(me->tausData) < 0)
@@ -256,21 +645,155 @@ DiceyAssist(
 
 /******************************************************************************************
  *
- *	DoExpect()
+ *	ExpectPMF(me, iSel)
+ *	DoExpect(me, iSel)
+ *
+ *	Helper functions for calculating expected values (mean, standard deviation, etc.)
  *
- *	Helper function for calculating expected values (mean, standard deviation, etc.)
+ *	Whenever the sum's distribution can be tabulated, the values are taken from the
+ *	same cached PMF used for throwing. Otherwise we fall back on closed forms: the sum of
+ *	n independent dice has n times the variance of a single die and 1/n times its
+ *	excess kurtosis. For entropy we use that of the normal approximation, which is
+ *	accurate to many decimals by the time the PMF grows too large to tabulate.
  *	
  ******************************************************************************************/
 
+static double
+ExpectPMF(
+	objDicey*		me,
+	eExpectSelector	iSel)
+	
+	{
+	const double*	p		= me->pmf;
+	long			s		= me->support,
+					base	= me->cacheDice,
+					i;
+	double			result	= 0.0 / 0.0,					// Initially undefined
+					mean	= 0.0,
+					m2		= 0.0,
+					m3		= 0.0,
+					m4		= 0.0;
+	
+	for (i = 0; i < s; i += 1)
+		mean += (double) i * p[i];
+	
+	switch (iSel) {
+	case expMean:
+		result = mean + base;
+		break;
+	
+	case expMedian:
+		{
+		// Smallest sum whose CDF reaches 1/2, or the midpoint of the two candidates if
+		// the CDF hits 1/2 on the nose
+		double cdf = 0.0;
+		
+		for (i = 0; i < s; i += 1) {
+			cdf += p[i];
+			if (cdf >= 0.5 - 1e-12) break;
+			}
+		result = base + i;
+		if (fabs(cdf - 0.5) <= 1e-12)
+			result += 0.5;
+		}
+		break;
+	
+	case expMode:
+		// A single die has no mode; otherwise average all sums sharing the maximum
+		// probability (there are two of them when the mean falls between integers)
+		if (base > 1) {
+			double	pMax	= 0.0;
+			long	first	= 0,
+					last	= 0;
+			
+			for (i = 0; i < s; i += 1) {
+				if (p[i] > pMax * (1.0 + 1e-12)) {
+					pMax	= p[i];
+					first	= i;
+					last	= i;
+					}
+				else if (p[i] >= pMax * (1.0 - 1e-12))
+					last = i;
+				}
+			result = base + 0.5 * (first + last);
+			}
+		break;
+	
+	case expVar:
+	case expStdDev:
+	case expSkew:
+	case expKurtosis:
+		for (i = 0; i < s; i += 1) {
+			double	x	= (double) i - mean,
+					x2	= x * x;
+			
+			m2 += x2 * p[i];
+			m3 += x2 * x * p[i];
+			m4 += x2 * x2 * p[i];
+			}
+		switch (iSel) {
+			case expVar:		result = m2;							break;
+			case expStdDev:		result = sqrt(m2);						break;
+			case expSkew:		result = m3 / (m2 * sqrt(m2));			break;
+			default:			result = m4 / (m2 * m2) - 3.0;			break;
+			}
+		break;
+	
+	case expEntropy:
+		result = 0.0;
+		for (i = 0; i < s; i += 1)
+			if (p[i] > 0.0)
+				result -= p[i] * log2(p[i]);
+		break;
+	
+	case expMin:
+		result = base;
+		break;
+	case expMax:
+		result = base + s - 1;
+		break;
+	
+	default:
+		break;
+		}
+	
+	return result;
+	}
+
 static double
 DoExpect(
 	objDicey*		me,
-	eExpectSelector iSel)
+	eExpectSelector	iSel)
 	
 	{
 	long	n		= me->nDice;
-	double	result	= UniformExpectationsDiscrete(1, me->nFaces, iSel);
+	double	result;
+	
+	if (n == 0 || me->nFaces < 2) {
+		// Degenerate case: the sum is always n
+		switch (iSel) {
+		case expVar:
+		case expStdDev:
+		case expEntropy:
+			result = 0.0;
+			break;
+		case expSkew:
+		case expKurtosis:
+			result = 0.0 / 0.0;								// Undefined
+			break;
+		default:
+			result = n;
+			break;
+			}
+		return result;
+		}
+	
+	if ( !CacheCurrent(me) && !isr() )
+		RebuildCache(me);
+	if (me->pmf != NIL && CacheCurrent(me))
+		return ExpectPMF(me, iSel);
 	
+	result = UniformExpectationsDiscrete(1, me->nFaces, iSel);
 	switch(iSel) {
 	default:
 		result *= n;				// Holds for all selectors except the following
@@ -284,10 +807,11 @@ DoExpect(
 		result *= sqrt(n);
 		break;
 	case expKurtosis:
-		result /= (n * n);
+		result /= n;
 		break;
 	case expEntropy:
-		result += log2(n);
+		result = UniformExpectationsDiscrete(1, me->nFaces, expVar);
+		result = 0.5 * log2(k2pi * kNatLogBase * n * result);
 		break;
 		}
 		
@@ -469,6 +993,7 @@ main(void)
 	LitterAddMess1	((method) DiceyNDice,	"in1",		A_LONG);
 	LitterAddMess1	((method) DiceyNFaces,	"in2",		A_LONG);
 	LitterAddMess1	((method) DiceySeed,	"seed",		A_DEFLONG);
+	LitterAddMess2	((method) DiceyDraw,	"draw",		A_LONG, A_DEFSYM);
 	LitterAddMess2	((method) DiceyTell,	"tell",		A_SYM, A_SYM);
 	LitterAddMess0	((method) DiceyTattle,	"tattle");
 	LitterAddCant	((method) DiceyTattle,	"dblclick");
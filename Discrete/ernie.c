@@ -34,6 +34,7 @@
 #include "TrialPeriodUtils.h"
 #include "Taus88.h"
 #include "MiscUtils.h"
+#include "DrawUtils.h"
 
 #pragma mark • Constants
 
@@ -81,6 +82,8 @@ typedef struct {
 	
 	Boolean			maxMemory;			// False if using OS Memory allocation; true if
 										// we're using Max' getbytes();
+	
+	tDrawBuf		drawBuf;
 	} objErnie;
 
 
@@ -141,6 +144,7 @@ noMoreDefaults:
 	me->dataSize	= 0;				// Start from clean slate before calling ErnieSize()
 	me->master		= NIL;
 	me->state		= NIL;
+	DrawInit(&me->drawBuf);
 	ErnieSize(me, iDataSize);
 	if (me->master == NIL || me->state == NIL) {
 		goto punt;
@@ -204,6 +208,7 @@ ErnieFree(
 	Taus88Free(me->tausData);					// Taus88Free is NIL-safe
 	
 	DisposeMemory(me->master, me->state, me->maxMemory ? sizeof(long) * me->dataSize : 0);
+	DrawFree(&me->drawBuf);
 	
 	}
 
@@ -214,51 +219,79 @@ ErnieFree(
 /******************************************************************************************
  *
  *	ErnieBang(me)
+ *	ErnieDraw(me, iCount, iDest)
+ *
+ *	ErnieDraw() takes iCount balls out of the urn in one go and sends them as a list, or
+ *	writes them into a buffer~ or table. If the urn runs empty on the way it is refilled
+ *	(and the reset outlet bangs) just as with repeated bangs.
  *
  ******************************************************************************************/
 
+	static inline long NextDeviate(objErnie* me)
+		{
+		long	theBall = -1;			// This is the result defined for the degenerate case
+										// of "no balls in the system"; this value also allows
+										// the main loop condition to be streamlined.
+		
+		
+		if (me->totalBalls > 0) {
+			long	magic;
+			long*	sp;
+			
+			if (me->ballsInUrn == 0) {
+				ErnieReset(me);
+				}
+			
+			// ULong2Unit_Zo returns value in range			[0.0 .. 1.0)
+			// * b	  (b = ballsInUrn) results in range		[0.0 .. b)
+			// + 1.0			results in range			[1.0 .. b + 1.0)
+			// conversion to int results in range			[1 .. b] w/equiprob. for each value
+			// QED
+			magic = ((double) me->ballsInUrn) * ULong2Unit_Zo(Taus88(me->tausData)) + 1.0;
+			
+			// This initial value allows the loop below to increment the pointer as part of
+			// the loop condition.
+			sp = me->state - 1;
+			
+			// ASSERT: loop terminates for all values of magic in [1 .. b] due to
+			// b == sum(sp[0] .. sp[dataSize-1])
+			do {
+				theBall += 1;
+				} while ((magic -= *++sp) > 0);
+			
+			// Update state of urn
+			*sp				-= 1;
+			me->ballsInUrn	-= 1;
+			}
+		
+		return theBall;
+		}
+
 static void
 ErnieBang(
 	objErnie* me)
 	
 	{
-	long	theBall = -1;			// This is the result defined for the degenerate case
-									// of "no balls in the system"; this value also allows
-									// the main loop condition to be streamlined.
-	
-	
-	if (me->totalBalls > 0) {
-		long	magic;
-		long*	sp;
-		
-		if (me->ballsInUrn == 0) {
-			ErnieReset(me);
-			}
-		
-		// ULong2Unit_Zo returns value in range			[0.0 .. 1.0)
-		// * b	  (b = ballsInUrn) results in range		[0.0 .. b)
-		// + 1.0			results in range			[1.0 .. b + 1.0)
-		// conversion to int results in range			[1 .. b] w/equiprob. for each value
-		// QED
-		magic = ((double) me->ballsInUrn) * ULong2Unit_Zo(Taus88(me->tausData)) + 1.0;
-		
-		// This initial value allows the loop below to increment the pointer as part of
-		// the loop condition.
-		sp = me->state - 1;
-		
-		// ASSERT: loop terminates for all values of magic in [1 .. b] due to
-		// b == sum(sp[0] .. sp[dataSize-1])
-		do {
-			theBall += 1;
-			} while ((magic -= *++sp) > 0);
+	outlet_int(me->coreObject.o_outlet, NextDeviate(me));
+	}
+
+	static void DrawDeviates(objErnie* me, long oVals[], long iCount)
+		{
+		long i;
 		
-		// Update state of urn
-		*sp				-= 1;
-		me->ballsInUrn	-= 1;
+		for (i = 0; i < iCount; i += 1)
+			oVals[i] = NextDeviate(me);
 		}
+
+static void
+ErnieDraw(
+	objErnie*	me,
+	long		iCount,
+	Symbol*		iDest)
 	
-	outlet_int(me->coreObject.o_outlet, theBall);
-	
+	{
+	DrawLongs(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawLongFunc) DrawDeviates);
 	}
 
 
@@ -858,6 +891,7 @@ main(void)
 	LitterAddMess1	((method) ErnieTable,		"refer",	A_SYM);
 	LitterAddGimme	((method) ErnieSet,			"set");
 	LitterAddMess1	((method) ErnieSeed,		"seed",		A_DEFLONG);
+	LitterAddMess2	((method) ErnieDraw,		"draw",		A_LONG, A_DEFSYM);
 	LitterAddMess0	((method) ErnieClear,		"clear");
 	LitterAddMess0	((method) ErnieClear,		"zero");
 	LitterAddMess1	((method) ErnieConst,		"const",	A_LONG);
@@ -30,6 +30,8 @@
 #include "TrialPeriodUtils.h"
 #include "MiscUtils.h"
 #include "UniformExpectations.h"
+#include "LinCong.h"
+#include "DrawUtils.h"
 
 
 #pragma mark • Constants
@@ -56,10 +58,10 @@ enum {
 typedef struct {
 	LITTER_CORE_OBJECT(Object, coreObject);
 	
-	UInt32	seed,
-			mul,
-			add,
-			mod;
+	UInt32		seed;
+	tLinCong	lc;							// mul, add, mod & precalculated constants
+	
+	tDrawBuf	drawBuf;
 	} objLili;
 
 
@@ -76,6 +78,7 @@ static void LiliSet		(objLili*, UInt32);
 /******************************************************************************************
  *
  *	LiliNew(iMul, iAdd, iMod, iSeed)
+ *	LiliFree(me)
  *
  ******************************************************************************************/
 
@@ -116,14 +119,16 @@ noMoreDefaults:
 	intout(me);					// Access main outlet through me->coreObject.o_outlet;
 	
 	// Initialize and store object components
-	me->mul		= iMul;
-	me->add		= iAdd;
-	me->mod		= iMod;
+	LinCongSetup(&me->lc, iMul, iAdd, iMod);
 	me->seed	= iSeed;
+	DrawInit(&me->drawBuf);
 	
 	return me;
 	}
 
+static void LiliFree(objLili* me)
+	{ DrawFree(&me->drawBuf); }
+
 #pragma mark -
 #pragma mark • Object Message Handlers
 
@@ -131,9 +136,13 @@ noMoreDefaults:
  *
  *	LiliBang(me)
  *	LiliSeed(me)
+ *	LiliDraw(me, iCount, iDest)
  *
  *	Grab a new random number from Lili.
  *
+ *	LiliDraw() steps the generator iCount times, sending the values as a list (or into
+ *	a buffer~ or table). The seed stays in a register until the chunk is done.
+ *
  ******************************************************************************************/
 
 static void
@@ -141,12 +150,8 @@ LiliBang(
 	objLili* me)
 	
 	{
-	UInt32	l,
-			mod	= me->mod;
+	UInt32 l = LinCongStep(&me->lc, me->seed);
 	
-	l = me->seed * me->mul + me->add;
-	if (mod != 0)
-		l %= mod;
 	me->seed = l;
 	
 	outlet_int(me->coreObject.o_outlet, l);		// Implicitly typecasts l to signed long
@@ -163,22 +168,54 @@ LiliSeed(
 	LiliBang(me);
 	}
 
+	static void DrawDeviates(objLili* me, long oVals[], long iCount)
+		{
+		UInt32	l = me->seed;
+		long	i;
+		
+		for (i = 0; i < iCount; i += 1)
+			oVals[i] = l = LinCongStep(&me->lc, l);
+		
+		me->seed = l;
+		}
+
+static void
+LiliDraw(
+	objLili*	me,
+	long		iCount,
+	Symbol*		iDest)
+	
+	{
+	DrawLongs(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawLongFunc) DrawDeviates);
+	}
+
 /******************************************************************************************
  *
  *	LiliSet(me, iSeed)
  *	LiliMul(me, iMul)
  *	LiliAdderl(me, iMul)
  *	LiliMod(me, iMul)
+ *	LiliSkip(me, iCount)
  *	
  *	Nothing reallly bad can happen... we simply treat everything as unsigned. A multiplier
  *	of 0 seems a little counter-productive, but even this is allowed.
  *
+ *	Skip advances the seed as if iCount bangs had been received, without output.
+ *
  ******************************************************************************************/
 
 static void LiliSet		(objLili* me, UInt32 iSeed)	{ me->seed = iSeed; }
-static void LiliMul		(objLili* me, UInt32 iMul)	{ me->mul = iMul; }
-static void LiliAdder	(objLili* me, UInt32 iAdd)	{ me->add = iAdd; }
-static void LiliMod		(objLili* me, UInt32 iMod)	{ me->mod = iMod; }
+static void LiliMul		(objLili* me, UInt32 iMul)	{ LinCongSetup(&me->lc, iMul, me->lc.add, me->lc.mod); }
+static void LiliAdder	(objLili* me, UInt32 iAdd)	{ LinCongSetup(&me->lc, me->lc.mul, iAdd, me->lc.mod); }
+static void LiliMod		(objLili* me, UInt32 iMod)	{ LinCongSetup(&me->lc, me->lc.mul, me->lc.add, iMod); }
+
+static void LiliSkip(objLili* me, double iCount)
+	{
+	if (iCount < 0.0)
+		error("%s: can't skip backwards (%lf)", kClassName, iCount);
+	else me->seed = LinCongSkip(&me->lc, me->seed, (UInt64) iCount);
+	}
 
 
 #pragma mark -
@@ -207,10 +244,10 @@ LiliTattle(
 	post("%s state",
 			kClassName);
 	post("  Current seed: %lu", me->seed);
-	post("  Current multiplier: %lu", me->mul);
-	post("  Current adder: %lu", me->add);
-	post("  Current modulo: %lu", me->mod);
-	if (me->mod == 0)
+	post("  Current multiplier: %lu", me->lc.mul);
+	post("  Current adder: %lu", me->lc.add);
+	post("  Current modulo: %lu", me->lc.mod);
+	if (me->lc.mod == 0)
 		post("     ...which is treated as 4294967296");
 	
 	}
@@ -229,14 +266,14 @@ DoExpect(
 	{
 	long min, max;
 	
-	if (me->mod == 0 || me->mod > kLongMax) {
+	if (me->lc.mod == 0 || me->lc.mod > kLongMax) {
 		// Calculated values will include results that wrap around to negative values
 		min = kLongMin;
 		max = kLongMax;
 		}
 	else {
 		min = 0;
-		max = me->mod - 1;
+		max = me->lc.mod - 1;
 		}
 	
 	return UniformExpectationsDiscrete(min, max, iSel);
@@ -313,6 +350,29 @@ DoExpect(
 		return LitterGetAttrFloat(DoExpect(me, expEntropy), ioArgC, ioArgV);
 		}
 	
+		// The recurrence parameters need setters so the kernel constants are recalculated
+	static t_max_err LiliSetMulAttr(objLili* me, void* iAttr, long iArgC, Atom iArgV[])
+		{
+		#pragma unused(iAttr)
+		
+		if (iArgC > 0) LiliMul(me, AtomGetLong(iArgV));
+		return MAX_ERR_NONE;
+		}
+	static t_max_err LiliSetAddAttr(objLili* me, void* iAttr, long iArgC, Atom iArgV[])
+		{
+		#pragma unused(iAttr)
+		
+		if (iArgC > 0) LiliAdder(me, AtomGetLong(iArgV));
+		return MAX_ERR_NONE;
+		}
+	static t_max_err LiliSetModAttr(objLili* me, void* iAttr, long iArgC, Atom iArgV[])
+		{
+		#pragma unused(iAttr)
+		
+		if (iArgC > 0) LiliMod(me, AtomGetLong(iArgV));
+		return MAX_ERR_NONE;
+		}
+	
 	static inline void
 	AddInfo(void)
 		{
@@ -323,11 +383,11 @@ DoExpect(
 		// Read-Write Attributes
 		attr = attr_offset_new("seed", symLong, 0, NULL, NULL, calcoffset(objLili, seed));
 		class_addattr(gObjectClass, attr);
-		attr = attr_offset_new("mul", symLong, 0, NULL, NULL, calcoffset(objLili, mul));
+		attr = attr_offset_new("mul", symLong, 0, NULL, (method) LiliSetMulAttr, calcoffset(objLili, lc.mul));
 		class_addattr(gObjectClass, attr);
-		attr = attr_offset_new("add", symLong, 0, NULL, NULL, calcoffset(objLili, add));
+		attr = attr_offset_new("add", symLong, 0, NULL, (method) LiliSetAddAttr, calcoffset(objLili, lc.add));
 		class_addattr(gObjectClass, attr);
-		attr = attr_offset_new("mod", symLong, 0, NULL, NULL, calcoffset(objLili, mod));
+		attr = attr_offset_new("mod", symLong, 0, NULL, (method) LiliSetModAttr, calcoffset(objLili, lc.mod));
 		class_addattr(gObjectClass, attr);
 		
 		// Read-Only Attributes
@@ -412,7 +472,7 @@ main(void)
 						sizeof(objLili),			// Class object size
 						LitterCalcOffset(objLili),	// Magic "Obex" Calculation
 						(method) LiliNew,			// Instance creation function
-						NIL,						// No custom deallocation function
+						(method) LiliFree,			// Custom deallocation function
 						NIL,						// No UI function
 						myArgTypes);				// See above
 
@@ -424,6 +484,8 @@ main(void)
 	LitterAddMess1	((method) LiliMul,		"in1",		A_LONG);
 	LitterAddMess1	((method) LiliAdder,	"in2",		A_LONG);
 	LitterAddMess1	((method) LiliMod,		"in3",		A_LONG);
+	LitterAddMess1	((method) LiliSkip,		"skip",		A_FLOAT);
+	LitterAddMess2	((method) LiliDraw,		"draw",		A_LONG, A_DEFSYM);
 	LitterAddMess2	((method) LiliTell,		"tell",		A_SYM, A_SYM);
 	LitterAddMess0	((method) LiliTattle,	"tattle");
 	LitterAddCant	((method) LiliTattle,	"dblclick");
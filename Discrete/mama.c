@@ -29,6 +29,7 @@
 #include "TrialPeriodUtils.h"
 #include "MiscUtils.h"
 #include "UniformExpectations.h"
+#include "DrawUtils.h"
 
 
 #pragma mark • Constants
@@ -51,9 +52,36 @@ enum {
 
 	// Use enum rather than const int for compatibility across compilers
 enum {
-	kArraySize = 10
+	kArraySize		= 10,					// Classic pool: carry, 8 lags, 1 spare
+	kLags			= 8,
+	kMaxLanes		= 32,
+	kLaneBlock		= 8,					// kMaxLanes must be a multiple
+	
+	kDigits			= 10,					// Base 2^16 digits for jump arithmetic
+	kLaneSpacing	= 96					// Lanes are 2^96 steps apart
 	};
 
+	// The two multiply-with-carry generators, multipliers listed by lag
+static const UInt32 kMultipliers[2][kLags] = {
+		// Marsaglia used: 1941, 1860, 1812, 1776, 1492, 1215, 1066, 12013
+		{1949, 1861, 1831, 1777, 1493, 1217, 1069, 1021},
+		// Marsaglia used: 1111, 2222, 3333, ..., 7777, 9272
+		{1117, 2237, 3343,  351, 1461, 2577, 3693, 1085}
+		};
+
+
+#pragma mark • Type Definitions
+
+	// Several independent copies of one generator, stored as structure-of-arrays so
+	// the loop over lanes is a run of identical multiply-adds. The last eight outputs
+	// are a ring buffer; the slot of the newest is kept in the object (all lanes and
+	// both generators step together).
+typedef struct {
+	UInt32	lag[kLags][kMaxLanes],
+			carry[kMaxLanes];
+	} tMWCLanes;
+
+typedef UInt32 tBigNum[kDigits];
 
 
 #pragma mark • Object Structure
@@ -61,16 +89,28 @@ enum {
 typedef struct {
 	LITTER_CORE_OBJECT(Object, coreObject);
 	
-	UInt16*			pools;
+	tMWCLanes		mwc[2];
+	int				head,					// Ring slot of the newest output
+					laneCount,
+					frameCount,				// Values in frame[]...
+					nextOut;				// ...and the next one to use
+	UInt32			frame[kMaxLanes];
+	
 	long			min,
 					max;
+	UInt32			range,					// Cached from min/max, see CheckRange()
+					threshold;
+	
+	tDrawBuf		drawBuf;				// Output buffer for the draw message
 	} objMama;
 
 
 #pragma mark • Global Variables
 
-static UInt16	gPool1[kArraySize],		// Inited at run time
-				gPool2[kArraySize];
+	// Jump-ahead constants for each generator, set up in main()
+static tBigNum	gModulus[2],
+				gWeights[2][kLags],
+				gLaneJump[2];
 
 
 #pragma mark -
@@ -125,75 +165,463 @@ MamaInit(
 
 /******************************************************************************************
  *
- *	MamaRand()
+ *	LagSlot(me, iLag)
+ *
+ *	Ring buffer slot holding the output iLag steps back (iLag = 1 is the newest). In the
+ *	classic pool layout this is pool[iLag].
+ *
+ ******************************************************************************************/
+
+static inline int LagSlot(const objMama* me, int iLag)
+	{ return (me->head + kLags + 1 - iLag) & (kLags - 1); }		// kLags is a power of 2
+
+/******************************************************************************************
+ *
+ *	MamaStep(me, oFrame)
+ *
+ *	Advance every lane of both generators by one step and write the combined 32-bit
+ *	outputs to oFrame[0 .. laneCount-1]. Lane 0 is exactly the classic single-stream
+ *	Mother. (With only one lane, FillClassic() is faster.)
+ *
+ *	Lanes are processed in blocks of kLaneBlock with a fixed trip count, which the
+ *	compiler turns into straight vector code; any lanes past laneCount in the last block
+ *	are stepped along with the rest and ignored. The sums go to a local array first, and
+ *	each of the loops that follow stores to just one array, so there is no aliasing for
+ *	the compiler to worry about.
  *
  ******************************************************************************************/
 
-	static inline UInt16 FastHiWord(UInt32 x) { return x >> 16; }
-	static inline UInt16 FastLoWord(UInt32 x) { return x; }
+static void
+MamaStep(
+	objMama*	me,
+	UInt32		oFrame[])
+
+	{
+	int		newest	= (me->head + 1) & (kLags - 1),
+			n		= me->laneCount,
+			g, j, j0;
 	
-	// This is faster than using BlockMoveData() or memmove()
-	// Funnily enough, after unwrapping the loop, I tried several variants of the following
-	// using more "typically C" constructs with pointer arithmetic, but the CodeWarrior
-	// compiler always ended up generating (at best) the same code as it does for the 
-	// more "amateurish" (Pascal-like?) code that follows. Go figure.
-	static inline void UpdatePool(UInt16 ioPool[], UInt32 iCarry)
-		{
-		ioPool[8] = ioPool[7];
-		ioPool[7] = ioPool[6];
-		ioPool[6] = ioPool[5];
-		ioPool[5] = ioPool[4];
-		ioPool[4] = ioPool[3];
-		ioPool[3] = ioPool[2];
-		ioPool[2] = ioPool[1];
-		ioPool[1] = FastLoWord(iCarry);
-		ioPool[0] = FastHiWord(iCarry);
-		}
-
-static UInt32
-MamaRand(
+	for (j0 = 0; j0 < n; j0 += kLaneBlock) {
+		UInt32	sum[2][kLaneBlock];
+		int		count = n - j0;
+		
+		for (g = 0; g < 2; g += 1) {
+			const UInt32*	a		= kMultipliers[g];
+			tMWCLanes*		mwc		= &me->mwc[g];
+			const UInt32	*x1		= mwc->lag[LagSlot(me, 1)] + j0,
+							*x2		= mwc->lag[LagSlot(me, 2)] + j0,
+							*x3		= mwc->lag[LagSlot(me, 3)] + j0,
+							*x4		= mwc->lag[LagSlot(me, 4)] + j0,
+							*x5		= mwc->lag[LagSlot(me, 5)] + j0,
+							*x6		= mwc->lag[LagSlot(me, 6)] + j0,
+							*x7		= mwc->lag[LagSlot(me, 7)] + j0,
+							*x8		= mwc->lag[LagSlot(me, 8)] + j0;
+			UInt32*			carry	= mwc->carry + j0;
+			UInt32*			out		= mwc->lag[newest] + j0;		// Replaces x8
+			UInt32*			s		= sum[g];
+			
+			for (j = 0; j < kLaneBlock; j += 1)
+				s[j] = carry[j]	+ a[0] * x1[j] + a[1] * x2[j] + a[2] * x3[j] + a[3] * x4[j]
+								+ a[4] * x5[j] + a[5] * x6[j] + a[6] * x7[j] + a[7] * x8[j];
+			for (j = 0; j < kLaneBlock; j += 1)
+				out[j] = s[j] & 0x0000ffff;
+			for (j = 0; j < kLaneBlock; j += 1)
+				carry[j] = s[j] >> 16;
+			}
+		
+		// Combine the two 16 bit random numbers into one 32 bit word
+		if (count > kLaneBlock)
+			count = kLaneBlock;
+		for (j = 0; j < count; j += 1)
+			oFrame[j0 + j] = (sum[0][j] << 16) | (sum[1][j] & 0x0000ffff);
+		}
+	
+	me->head = newest;
+	
+	}
+
+/******************************************************************************************
+ *
+ *	FillClassic(me, oBuf, iCount)
+ *
+ *	With a single lane there is nothing to vectorize, but the two generators can at least
+ *	run side by side with all their state in registers. Only lane 0 is touched.
+ *
+ ******************************************************************************************/
+
+static void
+FillClassic(
+	objMama*	me,
+	UInt32		oBuf[],
+	long		iCount)
+
+	{
+	tMWCLanes	*mwc1	= &me->mwc[0],
+				*mwc2	= &me->mwc[1];
+	const UInt32*	a	= kMultipliers[0];
+	const UInt32*	b	= kMultipliers[1];
+	UInt32		c1	= mwc1->carry[0],
+				c2	= mwc2->carry[0],
+				p1	= mwc1->lag[LagSlot(me, 1)][0],		q1	= mwc2->lag[LagSlot(me, 1)][0],
+				p2	= mwc1->lag[LagSlot(me, 2)][0],		q2	= mwc2->lag[LagSlot(me, 2)][0],
+				p3	= mwc1->lag[LagSlot(me, 3)][0],		q3	= mwc2->lag[LagSlot(me, 3)][0],
+				p4	= mwc1->lag[LagSlot(me, 4)][0],		q4	= mwc2->lag[LagSlot(me, 4)][0],
+				p5	= mwc1->lag[LagSlot(me, 5)][0],		q5	= mwc2->lag[LagSlot(me, 5)][0],
+				p6	= mwc1->lag[LagSlot(me, 6)][0],		q6	= mwc2->lag[LagSlot(me, 6)][0],
+				p7	= mwc1->lag[LagSlot(me, 7)][0],		q7	= mwc2->lag[LagSlot(me, 7)][0],
+				p8	= mwc1->lag[LagSlot(me, 8)][0],		q8	= mwc2->lag[LagSlot(me, 8)][0];
+	
+	while (iCount-- > 0) {
+		c1 += a[0] * p1 + a[1] * p2 + a[2] * p3 + a[3] * p4
+				+ a[4] * p5 + a[5] * p6 + a[6] * p7 + a[7] * p8;
+		c2 += b[0] * q1 + b[1] * q2 + b[2] * q3 + b[3] * q4
+				+ b[4] * q5 + b[5] * q6 + b[6] * q7 + b[7] * q8;
+		
+		p8 = p7; p7 = p6; p6 = p5; p5 = p4; p4 = p3; p3 = p2; p2 = p1;
+		q8 = q7; q7 = q6; q6 = q5; q5 = q4; q4 = q3; q3 = q2; q2 = q1;
+		p1 = c1 & 0x0000ffff;	c1 >>= 16;
+		q1 = c2 & 0x0000ffff;	c2 >>= 16;
+		
+		*oBuf++ = (p1 << 16) | q1;
+		}
+	
+	// The ring is relative to head, so we can write the lags back without moving it
+	mwc1->carry[0] = c1;							mwc2->carry[0] = c2;
+	mwc1->lag[LagSlot(me, 1)][0] = p1;				mwc2->lag[LagSlot(me, 1)][0] = q1;
+	mwc1->lag[LagSlot(me, 2)][0] = p2;				mwc2->lag[LagSlot(me, 2)][0] = q2;
+	mwc1->lag[LagSlot(me, 3)][0] = p3;				mwc2->lag[LagSlot(me, 3)][0] = q3;
+	mwc1->lag[LagSlot(me, 4)][0] = p4;				mwc2->lag[LagSlot(me, 4)][0] = q4;
+	mwc1->lag[LagSlot(me, 5)][0] = p5;				mwc2->lag[LagSlot(me, 5)][0] = q5;
+	mwc1->lag[LagSlot(me, 6)][0] = p6;				mwc2->lag[LagSlot(me, 6)][0] = q6;
+	mwc1->lag[LagSlot(me, 7)][0] = p7;				mwc2->lag[LagSlot(me, 7)][0] = q7;
+	mwc1->lag[LagSlot(me, 8)][0] = p8;				mwc2->lag[LagSlot(me, 8)][0] = q8;
+	
+	}
+
+/******************************************************************************************
+ *
+ *	MamaRand(me)
+ *	MamaFill(me, oBuf, iCount)
+ *
+ *	Outputs run through the lanes in order, one frame at a time. A single lane is
+ *	buffered kMaxLanes values at a time instead. MamaFill() gives the same sequence as
+ *	calling MamaRand() iCount times; whole frames are written straight into oBuf.
+ *
+ ******************************************************************************************/
+
+static inline void
+NextFrame(
 	objMama* me)
 
 	{
-	UInt32	carry1,
-			carry2;
-	UInt16	*pool1,
-			*pool2;
 	
-	if (me->pools == NULL) {
-		pool1 = gPool1;
-		pool2 = gPool2;
+	if (me->laneCount == 1) {
+		FillClassic(me, me->frame, kMaxLanes);
+		me->frameCount = kMaxLanes;
 		}
 	else {
-		pool1 = me->pools;
-		pool2 = me->pools + kArraySize;
-		}
-
-	
-	// Munge bits around, update pool sets
-	carry1 = pool1[0] + 1949 * pool1[1]			// Marsaglia used:	1941
-					  + 1861 * pool1[2]			//					1860
-					  + 1831 * pool1[3]			//					1812
-					  + 1777 * pool1[4]			//					1776
-					  + 1493 * pool1[5]			//					1492
-					  + 1217 * pool1[6]			//					1215
-					  + 1069 * pool1[7]			//					1066
-					  + 1021 * pool1[8];		//					12013
-	UpdatePool(pool1, carry1);
-	carry2 = pool2[0] + 1117 * pool2[1]			//					1111
-					  + 2237 * pool2[2]			//					2222
-					  + 3343 * pool2[3]			//					etc.
-					  +  351 * pool2[4]
-					  + 1461 * pool2[5]
-					  + 2577 * pool2[6]
-					  + 3693 * pool2[7]			//					7777
-					  + 1085 * pool2[8];		//					9272
-	UpdatePool(pool2, carry2);
-
-	// Combine the two 16 bit random numbers into one 32 bit word
-	// Don't worry about the fact that we appear to be taking the low word from the
-	// carry2 twice. FastLoWord(0 is basically just syntactic sugar.
-	return (carry1 << 16) + FastLoWord(carry2);
+		MamaStep(me, me->frame);
+		me->frameCount = me->laneCount;
+		}
+	
+	me->nextOut = 0;
+	
+	}
+
+static inline UInt32
+MamaRand(
+	objMama* me)
+
+	{
+	
+	if (me->nextOut >= me->frameCount)
+		NextFrame(me);
+	
+	return me->frame[me->nextOut++];
+	}
+
+static void
+MamaFill(
+	objMama*	me,
+	UInt32		oBuf[],
+	long		iCount)
+
+	{
+	long n = me->laneCount;
+	
+	while (iCount > 0 && me->nextOut < me->frameCount) {
+		*oBuf++	= me->frame[me->nextOut++];
+		iCount	-= 1;
+		}
+	
+	if (n == 1) {
+		FillClassic(me, oBuf, iCount);
+		return;
+		}
+	
+	while (iCount >= n) {
+		MamaStep(me, oBuf);
+		oBuf	+= n;
+		iCount	-= n;
+		}
+	
+	while (iCount-- > 0)
+		*oBuf++ = MamaRand(me);
+	
+	}
+
+
+#pragma mark -
+#pragma mark • Jump Ahead
+
+/******************************************************************************************
+ *
+ *	Multiple-precision arithmetic for jumping ahead
+ *
+ *	A lag-r multiply-with-carry generator with base b = 2^16 and multipliers a[1..r] is a
+ *	multiplicative congruential generator in disguise (Couture & L'Ecuyer). With
+ *		m	= a[1] b + a[2] b^2 + ... + a[r] b^r - 1
+ *		w_k	= a[k] + a[k+1] b + ... + a[r] b^(r-k)
+ *	the state maps to v = carry + sum of w_k * (output k steps back), and one step
+ *	takes v to v * w_1 mod m (w_1 is the inverse of b modulo m). So n steps multiply by
+ *	w_1^n mod m. Going back from v to the lags and carry is long division by m.
+ *
+ *	m is about 140 bits, so we only need a few digits and the simplest algorithms.
+ *	Numbers are little-endian base 2^16 digits, one per UInt32.
+ *
+ ******************************************************************************************/
+
+static void BigSet(tBigNum oNum, UInt32 iVal)
+	{
+	int i;
+	
+	oNum[0] = iVal & 0x0000ffff;
+	oNum[1] = iVal >> 16;
+	for (i = 2; i < kDigits; i += 1)
+		oNum[i] = 0;
+	}
+
+static void BigCopy(tBigNum oDest, const tBigNum iSrc)
+	{
+	int i;
+	
+	for (i = 0; i < kDigits; i += 1)
+		oDest[i] = iSrc[i];
+	}
+
+static int BigCompare(const tBigNum iA, const tBigNum iB)
+	{
+	int i;
+	
+	for (i = kDigits - 1; i >= 0; i -= 1)
+		if (iA[i] != iB[i])
+			return (iA[i] > iB[i]) ? 1 : -1;
+	
+	return 0;
+	}
+
+	// ioA += iB * iMul, iMul < 2^16
+static void BigMulAdd(tBigNum ioA, const tBigNum iB, UInt32 iMul)
+	{
+	UInt32	carry = 0;
+	int		i;
+	
+	for (i = 0; i < kDigits; i += 1) {
+		carry	+= ioA[i] + iB[i] * iMul;
+		ioA[i]	= carry & 0x0000ffff;
+		carry	>>= 16;
+		}
+	}
+
+	// ioA -= iB * iMul, iMul < 2^16. Result must not be negative
+static void BigMulSub(tBigNum ioA, const tBigNum iB, UInt32 iMul)
+	{
+	UInt32	carry	= 0,				// Pending from iB * iMul
+			borrow	= 0;
+	int		i;
+	
+	for (i = 0; i < kDigits; i += 1) {
+		UInt32 sub;
+		
+		carry	+= iB[i] * iMul;
+		sub		= (carry & 0x0000ffff) + borrow;
+		carry	>>= 16;
+		borrow	= (ioA[i] < sub);
+		ioA[i]	= (ioA[i] + (borrow << 16) - sub) & 0x0000ffff;
+		}
+	}
+
+static void BigMulMod(tBigNum ioA, const tBigNum iB, const tBigNum iMod)
+	{
+	tBigNum	r;
+	int		bit;
+	
+	BigSet(r, 0);
+	for (bit = 16 * kDigits - 1; bit >= 0; bit -= 1) {
+		BigMulAdd(r, r, 1);
+		if (BigCompare(r, iMod) >= 0)
+			BigMulSub(r, iMod, 1);
+		if ((iB[bit >> 4] >> (bit & 15)) & 1) {
+			BigMulAdd(r, ioA, 1);
+			if (BigCompare(r, iMod) >= 0)
+				BigMulSub(r, iMod, 1);
+			}
+		}
+	
+	BigCopy(ioA, r);
+	}
+
+	// oPow = w_1^iSteps mod m
+static void JumpMultiplier(int iGen, UInt32 iSteps, tBigNum oPow)
+	{
+	tBigNum base;
+	
+	BigCopy(base, gWeights[iGen][0]);
+	BigSet(oPow, 1);
+	while (iSteps > 0) {
+		if (iSteps & 1)
+			BigMulMod(oPow, base, gModulus[iGen]);
+		BigMulMod(base, base, gModulus[iGen]);
+		iSteps >>= 1;
+		}
+	}
+
+/******************************************************************************************
+ *
+ *	InitJumpConstants()
+ *	JumpLane(me, iLane, iMult)
+ *
+ *	JumpLane() moves one lane of both generators forward by the number of steps encoded
+ *	in iMult[] (see JumpMultiplier()).
+ *
+ ******************************************************************************************/
+
+static void
+InitJumpConstants(void)
+
+	{
+	int g, k, i;
+	
+	for (g = 0; g < 2; g += 1) {
+		const UInt32* a = kMultipliers[g];
+		
+		for (k = 0; k < kLags; k += 1) {
+			BigSet(gWeights[g][k], 0);
+			for (i = k; i < kLags; i += 1)
+				gWeights[g][k][i - k] = a[i];
+			}
+		
+		// m = b * w_1 - 1
+		BigSet(gModulus[g], 0);
+		for (i = 0; i < kLags; i += 1)
+			gModulus[g][i + 1] = a[i];
+		gModulus[g][0] = 0x0000ffff;
+		gModulus[g][1] -= 1;
+		
+		BigCopy(gLaneJump[g], gWeights[g][0]);
+		for (i = 0; i < kLaneSpacing; i += 1)
+			BigMulMod(gLaneJump[g], gLaneJump[g], gModulus[g]);
+		}
+	
+	}
+
+static void
+JumpLane(
+	objMama*		me,
+	int				iLane,
+	const tBigNum	iMult[])
+
+	{
+	int g, k;
+	
+	for (g = 0; g < 2; g += 1) {
+		tMWCLanes*	mwc	= &me->mwc[g];
+		tBigNum		v,
+					rem,
+					bv,
+					prod;
+		
+		BigSet(v, mwc->carry[iLane]);
+		for (k = 1; k <= kLags; k += 1)
+			BigMulAdd(v, gWeights[g][k - 1], mwc->lag[LagSlot(me, k)][iLane]);
+		while (BigCompare(v, gModulus[g]) >= 0)
+			BigMulSub(v, gModulus[g], 1);
+		
+		BigMulMod(v, iMult[g], gModulus[g]);
+		
+		// Peel off outputs, newest first: x = floor(b v / m), v <- b v - m x
+		BigCopy(rem, v);
+		for (k = 1; k <= kLags; k += 1) {
+			double	num = 0.0,
+					den = 0.0;
+			UInt32	x;
+			int		i;
+			
+			bv[0] = 0;
+			for (i = 1; i < kDigits; i += 1)
+				bv[i] = rem[i - 1];
+			for (i = kDigits - 1; i >= 0; i -= 1) {
+				num = 65536.0 * num + bv[i];
+				den = 65536.0 * den + gModulus[g][i];
+				}
+			x = (UInt32) (num / den);
+			if (x > 0x0000ffff)
+				x = 0x0000ffff;
+			
+			// The estimate can be off by one either way
+			BigSet(prod, 0);
+			BigMulAdd(prod, gModulus[g], x);
+			while (BigCompare(prod, bv) > 0) {
+				BigMulSub(prod, gModulus[g], 1);
+				x -= 1;
+				}
+			BigCopy(rem, bv);
+			BigMulSub(rem, gModulus[g], x);
+			while (BigCompare(rem, gModulus[g]) >= 0) {
+				BigMulSub(rem, gModulus[g], 1);
+				x += 1;
+				}
+			
+			mwc->lag[LagSlot(me, k)][iLane] = x;
+			}
+		
+		// What's left over is the carry
+		for (k = 1; k <= kLags; k += 1)
+			BigMulSub(v, gWeights[g][k - 1], mwc->lag[LagSlot(me, k)][iLane]);
+		mwc->carry[iLane] = v[0];
+		}
+	
+	}
+
+/******************************************************************************************
+ *
+ *	SpreadLanes(me)
+ *
+ *	Lane 0 is left alone; every other lane starts 2^96 steps further along than the one
+ *	before, so the lanes will not overlap in any practical time frame.
+ *
+ ******************************************************************************************/
+
+static void
+SpreadLanes(
+	objMama* me)
+
+	{
+	int g, j, k;
+	
+	for (j = 1; j < me->laneCount; j += 1) {
+		for (g = 0; g < 2; g += 1) {
+			tMWCLanes* mwc = &me->mwc[g];
+			
+			mwc->carry[j] = mwc->carry[j - 1];
+			for (k = 0; k < kLags; k += 1)
+				mwc->lag[k][j] = mwc->lag[k][j - 1];
+			}
+		JumpLane(me, j, gLaneJump);
+		}
+	
+	me->frameCount = me->nextOut = 0;			// Discard anything left in frame[]
+	
 	}
 
 
@@ -203,9 +631,12 @@ MamaRand(
 /******************************************************************************************
  *
  *	MamaNew(iMin, iMax, iSeed)
+ *	MamaFree(me)
  *
  ******************************************************************************************/
 
+static void MamaSeed(objMama*, long);
+
 static void*
 MamaNew(
 	long	iMin,
@@ -214,17 +645,10 @@ MamaNew(
 	
 	{
 	objMama*	me		= NIL;
-	UInt16*		myPool	= NIL;
 	
 	// Run through initialization parameters from right to left, handling defaults
-	if (iSeed != 0) {
-		myPool = (UInt16*) NewPtr(2 * kArraySize * sizeof(UInt16));
-		if (myPool != NIL)
-			 MamaInit(iSeed, myPool, myPool + kArraySize);
-		else error("%s: could not allocate memory for private seed pool", kClassName);
-			
+	if (iSeed != 0)
 		goto noMoreDefaults;
-		}
 	
 	if (iMax == 0) {
 		if (iMin > 0) {
@@ -248,21 +672,85 @@ noMoreDefaults:
 	intout(me);					// Access main outlet through me->coreObject.o_outlet;
 	
 	// Store object components
-	me->pools	= myPool;
-	me->min		= iMin;
-	me->max		= iMax;
+	me->laneCount	= 1;
+	me->min			= iMin;
+	me->max			= iMax;
+	me->range		= 0;
+	me->threshold	= 0;
+	DrawInit(&me->drawBuf);
+	
+	MamaSeed(me, iSeed);								// Every instance has its own pools
 	
 	return me;
 	}
 
+static void
+MamaFree(
+	objMama* me)
+	
+	{
+	DrawFree(&me->drawBuf);
+	}
+
 #pragma mark -
 #pragma mark • Object Message Handlers
 
+/******************************************************************************************
+ *
+ *	CheckRange(me)
+ *	ScaleWord(me, iRange, iRaw)
+ *
+ *	Scale a raw value to [min .. max] with Lemire's multiply-shift method. The rejection
+ *	threshold 2^32 mod range is cached, so scaling needs no division unless the range
+ *	has changed. A range of 0 means the full 2^32.
+ *
+ ******************************************************************************************/
+
+static inline UInt32
+CheckRange(
+	objMama* me)
+	
+	{
+	UInt32 range = (UInt32) me->max - (UInt32) me->min + 1;
+	
+	if (range != me->range) {
+		me->range		= range;
+		me->threshold	= (range == 0) ? 0 : (0 - range) % range;
+		}
+	
+	return range;
+	}
+
+static inline long
+ScaleWord(
+	objMama*	me,
+	UInt32		iRange,
+	UInt32		iRaw)
+	
+	{
+	UInt64 m;
+	
+	if (iRange == 0)
+		return me->min + (long) iRaw;
+	
+	m = (UInt64) iRaw * iRange;
+	while ((UInt32) m < me->threshold)
+		m = (UInt64) MamaRand(me) * iRange;
+	
+	return me->min + (long) (m >> 32);
+	}
+
+
 /******************************************************************************************
  *
  *	MamaBang(me)
+ *	MamaDraw(me, iCount, iDest)
+ *
+ *	Grab a new random number from Mama. Scale if necessary.
  *
- *	Grab a new random number from Taus88. Scale if necessary.
+ *	MamaDraw() sends iCount values as a list, or writes them to a buffer~ or table. Raw
+ *	values are fetched a chunk at a time, and rejected values are redrawn from the same
+ *	chunk, so draw n gives the same values as n bangs.
  *
  ******************************************************************************************/
 
@@ -275,34 +763,189 @@ MamaBang(
 			min		= me->min,
 			max		= me->max;
 	
-	if (min < max) {
-		double	scale = (double) max - (double) min + 1.0;
-		
-		mama = MamaRand(me);
-		mama = scale * ULong2Unit_Zo(mama) + min;
-		}
+	if (min < max)
+		mama = ScaleWord(me, CheckRange(me), MamaRand(me));
 	else mama = (min == max) ? min : 0;
 	
 	outlet_int(me->coreObject.o_outlet, mama);
 	
 	}
 
+	// Next raw word for DrawDeviates(). Rejections can use up the block before every
+	// value is drawn; it is then refilled with just as many words as values remain.
+	static inline UInt32 BlockWord(objMama* me, UInt32 ioWords[], long* ioNext, long* ioFilled, long iNeeded)
+		{
+		if (*ioNext >= *ioFilled) {
+			MamaFill(me, ioWords, iNeeded);
+			*ioNext		= 0;
+			*ioFilled	= iNeeded;
+			}
+		
+		return ioWords[(*ioNext)++];
+		}
+	
+	static void DrawDeviates(objMama* me, long oVals[], long iCount)
+		{
+		long	min = me->min,
+				max = me->max,
+				i;
+		
+		if (min < max) {
+			UInt32	range	= CheckRange(me),
+					words[kDrawChunk];
+			long	next	= 0,
+					filled	= 0;
+			
+			for (i = 0; i < iCount; i += 1) {
+				UInt32	raw = BlockWord(me, words, &next, &filled, iCount - i);
+				UInt64	m;
+				
+				if (range == 0) {
+					oVals[i] = min + (long) raw;
+					continue;
+					}
+				
+				// As ScaleWord(), but redraws come from the block
+				m = (UInt64) raw * range;
+				while ((UInt32) m < me->threshold)
+					m = (UInt64) BlockWord(me, words, &next, &filled, iCount - i) * range;
+				
+				oVals[i] = min + (long) (m >> 32);
+				}
+			}
+		
+		else {
+			long mama = (min == max) ? min : 0;
+			
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = mama;
+			}
+		}
+
+static void
+MamaDraw(
+	objMama*	me,
+	long		iCount,
+	Symbol*		iDest)
+	
+	{
+	DrawLongs(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawLongFunc) DrawDeviates);
+	}
+
 
 /******************************************************************************************
  *
  *	MamaMin(me, iMin)
  *	MamaMax(me, iMax)
  *	MamaSeed(me, iSeed)
+ *	MamaLanes(me, iLanes)
+ *	MamaSkip(me, iSteps)
+ *
+ *	Seeding sets up lane 0 exactly as the classic Mother, so with a single lane (the
+ *	default) a given seed produces the same sequence it always has. More lanes are
+ *	stepped together, and their outputs are interleaved.
+ *
+ *	Skip advances every lane iSteps steps (i.e., skips iSteps * lanes values) at the cost
+ *	of a few hundred multiplications of 140-bit numbers. With a single lane the skip is
+ *	exact; with more, whatever is left of the current frame is dropped first.
  *
  ******************************************************************************************/
 
 static void MamaMin(objMama* me, long iMin)	{ me->min = iMin; }
 static void MamaMax(objMama* me, long iMax)	{ me->max = iMax; }
 
-static void MamaSeed(objMama* me, long iSeed)
+static void
+MamaSeed(
+	objMama*	me,
+	long		iSeed)
+	
 	{
-	if (me->pools != NIL)	MamaInit(iSeed, me->pools, me->pools + kArraySize);
-	else					MamaInit(iSeed, gPool1, gPool2);
+	UInt16	pool1[kArraySize],
+			pool2[kArraySize];
+	int		k;
+	
+	MamaInit(iSeed, pool1, pool2);
+	
+	me->head = 0;
+	me->mwc[0].carry[0] = pool1[0];
+	me->mwc[1].carry[0] = pool2[0];
+	for (k = 1; k <= kLags; k += 1) {
+		me->mwc[0].lag[LagSlot(me, k)][0] = pool1[k];
+		me->mwc[1].lag[LagSlot(me, k)][0] = pool2[k];
+		}
+	
+	SpreadLanes(me);
+	
+	}
+
+static void
+MamaLanes(
+	objMama*	me,
+	long		iLanes)
+	
+	{
+	
+	if (iLanes < 1)
+		iLanes = 1;
+	else if (iLanes > kMaxLanes)
+		iLanes = kMaxLanes;
+	
+	if (iLanes != me->laneCount) {
+		me->laneCount = iLanes;
+		SpreadLanes(me);
+		}
+	
+	}
+
+static void MamaSkip(objMama*, long);
+
+	static void DeferSkip(objMama* me, Symbol* sym, short argc, Atom argv[])
+		{
+		#pragma unused(sym, argc)
+		
+		MamaSkip(me, argv[0].a_w.w_long);
+		}
+
+static void
+MamaSkip(
+	objMama*	me,
+	long		iSteps)
+	
+	{
+	tBigNum	mult[2];
+	int		j;
+	
+	if (iSteps <= 0)
+		return;
+	
+	if (isr()) {
+		Atom stepAtom;
+		
+		AtomSetLong(&stepAtom, iSteps);
+		defer(me, (method) DeferSkip, NIL, 1, &stepAtom);
+		return;
+		}
+	
+	// A single lane may have values buffered that we can simply skip over. With more
+	// lanes, the rest of the current frame is discarded.
+	if (me->laneCount == 1) {
+		long pending = me->frameCount - me->nextOut;
+		
+		if (iSteps <= pending) {
+			me->nextOut += iSteps;
+			return;
+			}
+		iSteps -= pending;
+		}
+	
+	JumpMultiplier(0, iSteps, mult[0]);
+	JumpMultiplier(1, iSteps, mult[1]);
+	for (j = 0; j < me->laneCount; j += 1)
+		JumpLane(me, j, mult);
+	
+	me->frameCount = me->nextOut = 0;
+	
 	}
 
 
@@ -351,6 +994,8 @@ MamaTattle(
 			me->min, me->max);
 	if (me->min > me->max)
 		post("  NB: Ignoring range while min > max");
+	post("  Lanes: %d",
+			me->laneCount);
 	
 	}
 
@@ -425,6 +1070,16 @@ static double DoExpect(objMama* me, eExpectSelector iSel)
 		return LitterGetAttrFloat(DoExpect(me, expEntropy), ioArgC, ioArgV);
 		}
 	
+	static t_max_err MamaSetAttrLanes(objMama* me, void* iAttr, long* iArgC, Atom iArgV[])
+		{
+		#pragma unused(iAttr)
+		
+		if (*iArgC > 0 && iArgV != NIL)
+			MamaLanes(me, AtomGetLong(iArgV));
+		
+		return MAX_ERR_NONE;
+		}
+	
 	static inline void
 	AddInfo(void)
 		{
@@ -437,6 +1092,10 @@ static double DoExpect(objMama* me, eExpectSelector iSel)
 		class_addattr(gObjectClass, attr);
 		attr = attr_offset_new("max", symLong, 0, NULL, NULL, calcoffset(objMama, max));
 		class_addattr(gObjectClass, attr);
+		attr = attr_offset_new(	"lanes", symLong, 0,
+								NULL, (method) MamaSetAttrLanes,
+								calcoffset(objMama, laneCount));
+		class_addattr(gObjectClass, attr);
 		
 		// Read-Only Attributes
 		attr = attribute_new("mean", symFloat64, kAttrFlagsReadOnly, (method) MamaGetMean, NULL);
@@ -514,7 +1173,7 @@ main(void)
 						sizeof(objMama),			// Class object size
 						LitterCalcOffset(objMama),	// Magic Obex offset calculation
 						(method) MamaNew,			// Instance creation function
-						NIL,						// No custom deallocation function
+						(method) MamaFree,			// Custom deallocation function
 						NIL,						// No menu function
 						myArgTypes);		
 	
@@ -523,6 +1182,9 @@ main(void)
 	LitterAddMess1	((method) MamaMin,		"in1",		A_LONG);
 	LitterAddMess1	((method) MamaMax,		"in2",		A_LONG);
 	LitterAddMess1	((method) MamaSeed,		"seed",		A_DEFLONG);
+	LitterAddMess1	((method) MamaLanes,	"lanes",	A_LONG);
+	LitterAddMess1	((method) MamaSkip,		"skip",		A_LONG);
+	LitterAddMess2	((method) MamaDraw,		"draw",		A_LONG, A_DEFSYM);
 	LitterAddMess2	((method) MamaTell,		"tell",		A_SYM, A_SYM);
 	LitterAddMess0	((method) MamaTattle,	"tattle");
 	LitterAddCant	((method) MamaTattle,	"dblclick");
@@ -532,7 +1194,7 @@ main(void)
 	
 	//Initialize Litter Library
 	LitterInit(kClassName, 0);
-	MamaInit(0, gPool1, gPool2);
+	InitJumpConstants();
 	
 	}
 
@@ -24,6 +24,7 @@
 #include "TrialPeriodUtils.h"
 #include "MiscUtils.h"
 #include "UniformExpectations.h"
+#include "DrawUtils.h"
 
 
 #pragma mark • Constants
@@ -49,8 +50,26 @@ enum {
 	kArrayBreakPt	= 397
 	};
 
+	// Constants for the SIMD-oriented variant (SFMT19937). The state is the same size,
+	// but is treated as 156 128-bit words
+enum {
+	kSFMTSize		= kArraySize / 4,
+	kSFMTPos1		= 122,
+	kSFMTSL1		= 18,
+	kSFMTSL2		= 1,					// Bytes
+	kSFMTSR1		= 11,
+	kSFMTSR2		= 1						// Bytes
+	};
+
+static const UInt32	kSFMTMask[4]	= {0xdfffffef, 0xddfecb7f, 0xbffaffff, 0xbffffff6},
+					kSFMTParity[4]	= {0x00000001, 0x00000000, 0x00000000, 0x13c9e684};
+
 #pragma mark • Type Definitions
 
+enum Algorithm {
+	algClassic		= 0,					// MT19937
+	algSFMT									// SFMT19937
+	};
 
 
 #pragma mark • Object Structure
@@ -60,94 +79,224 @@ typedef struct {
 	
 	long			min,
 					max;
+	
+	long			alg;					// Will only be algClassic or algSFMT, but is
+											// an attribute so use a long
+	UInt32			seed;					// Last seed, so we can switch algorithms
+	int				index;					// Next word to hand out from output[]
+	const UInt32*	output;					// SFMT output is the state itself; MT19937
+											// output is the tempered copy in tempered[]
+	UInt32			state[kArraySize],
+					tempered[kArraySize];
+	
+	tDrawBuf		drawBuf;				// Output buffer for the draw message
 	} objMersenne;
 
 
-#pragma mark • Global Variables
-
-static UInt32	gMTData[kArraySize];		// Inited at run time
-static int		gMTIndex = 0;
-
-
 #pragma mark -
 /*****************************  I M P L E M E N T A T I O N  ******************************/
 
-#pragma mark • Class Message Handlers
+#pragma mark • Generators
 
 /******************************************************************************************
  *
- *	MrmrInit(iSeed)
+ *	MrmrInit(me, iSeed)
+ *
+ *	Both generators are initialized with the same linear recurrence. SFMT additionally
+ *	needs to make sure the seed doesn't lead to a shortened period.
  *
  ******************************************************************************************/
 
 static void
 MrmrInit(
-	UInt32 iSeed)
+	objMersenne*	me,
+	UInt32			iSeed)
 
 	{
 	const UInt32 kKnuthMult	= 1812433253UL;
 	
+	UInt32*	mt = me->state;
 	UInt32	prevSeed;								// Cache this in a register
 	int		i;
    
-	prevSeed = gMTData[0] = iSeed;
+	me->seed = iSeed;
+	prevSeed = mt[0] = iSeed;
 	
 	for (i = 1; i < kArraySize; i += 1)
-		prevSeed = gMTData[i] = (kKnuthMult * (prevSeed ^ (prevSeed >> 30)) + i); 
+		prevSeed = mt[i] = (kKnuthMult * (prevSeed ^ (prevSeed >> 30)) + i); 
 	
+	if (me->alg == algSFMT) {
+		// Period certification
+		UInt32	inner = 0;
+		
+		for (i = 0; i < 4; i += 1)
+			inner ^= mt[i] & kSFMTParity[i];
+		for (i = 16; i > 0; i >>= 1)
+			inner ^= inner >> i;
+		
+		if ((inner & 0x01) == 0) {
+			// Flip the lowest parity bit we can find
+			for (i = 0; i < 4; i += 1) {
+				UInt32 work = kSFMTParity[i] & -kSFMTParity[i];	// Lowest set bit
+				
+				if (work != 0) {
+					mt[i] ^= work;
+					break;
+					}
+				}
+			}
+		}
+	
+	me->output	= (me->alg == algSFMT) ? me->state : me->tempered;
+	me->index	= kArraySize;						// Force refill on first use
 	}
 
+
 /******************************************************************************************
  *
- *	MrmrRand()
+ *	RefillClassic(ioMT, oOut)
+ *	RefillSFMT(ioMT)
+ *
+ *	Both generators regenerate the entire 624-word block at once, so that handing out a
+ *	random number is just an array access.
+ *
+ *	The classic MT19937 recurrence is split into the usual three loops so that no index
+ *	ever needs to wrap; the magic constant is selected with a mask rather than a table.
+ *	Tempering is done for the whole block in a separate loop without dependencies
+ *	between iterations.
+ *
+ *	SFMT works on 128-bit words: a byte shift across all 128 bits, which we do on two
+ *	64-bit halves, plus four independent 32-bit lane operations. We don't use vector
+ *	intrinsics, so this is portable and endian-neutral (we never look at the 128-bit
+ *	words as bytes). Tempering is not needed with SFMT.
  *
  ******************************************************************************************/
 
-static UInt32
-MrmrRand(void)
+static void
+RefillClassic(
+	UInt32 mt[],
+	UInt32 oOut[])
 
 	{
-	const UInt32 kMerMagic[2] = {0, 0x9908b0df};
+	const UInt32	kHighBit	= 0x80000000,
+					kLowBits	= 0x7fffffff,
+					kMagic		= 0x9908b0df;
 	
-	UInt32	result;
+	UInt32	y;
+	int 	i;
 	
-	if (gMTIndex >= kArraySize) {
-		// Generate new set of seeds
-		const UInt32	kHighBit = 0x80000000,
-						kLowBits = 0x7fffffff,
-						kZeroBit = 0x00000001;
-		
-		UInt32	y;
-		int 	i;
+	for (i = 0; i < kArraySize - kArrayBreakPt; i += 1) {
+		y = (mt[i] & kHighBit) | (mt[i + 1] & kLowBits);
+		mt[i] = mt[i + kArrayBreakPt] ^ (y >> 1) ^ (-(y & 0x01) & kMagic);
+		}
+	for ( ; i < kArraySize - 1; i += 1) {
+		y = (mt[i] & kHighBit) | (mt[i + 1] & kLowBits);
+		mt[i] = mt[i + kArrayBreakPt - kArraySize] ^ (y >> 1) ^ (-(y & 0x01) & kMagic);
+		}
+	y = (mt[kArraySize - 1] & kHighBit) | (mt[0] & kLowBits);
+	mt[kArraySize - 1] = mt[kArrayBreakPt - 1] ^ (y >> 1) ^ (-(y & 0x01) & kMagic);
+	
+	for (i = 0; i < kArraySize; i += 1) {
+		y  = mt[i];
+		y ^= (y >> 11);
+		y ^= (y << 7) & 0x9d2c5680UL;
+		y ^= (y << 15) & 0xefc60000UL;
+		y ^= (y >> 18);
+		oOut[i] = y;
+		}
+	}
+
+static void
+RefillSFMT(
+	UInt32 mt[])
+
+	{
+	// The two most recent outputs (r1 and r2 in the SFMT paper) live in registers
+	UInt32	c0 = mt[kArraySize - 8], c1 = mt[kArraySize - 7],
+			c2 = mt[kArraySize - 6], c3 = mt[kArraySize - 5],
+			d0 = mt[kArraySize - 4], d1 = mt[kArraySize - 3],
+			d2 = mt[kArraySize - 2], d3 = mt[kArraySize - 1];
+	int		i;
+	
+	for (i = 0; i < kSFMTSize; i += 1) {
+		UInt32*			a	= mt + 4 * i;
+		const UInt32*	b	= mt + 4 * ((i < kSFMTSize - kSFMTPos1) ? i + kSFMTPos1 : i + kSFMTPos1 - kSFMTSize);
+		UInt64			aLo	= ((UInt64) a[1] << 32) | a[0],
+						aHi	= ((UInt64) a[3] << 32) | a[2],
+						cLo	= ((UInt64) c1 << 32) | c0,
+						cHi	= ((UInt64) c3 << 32) | c2,
+						xLo, xHi;
 		
-		for (i = 0; i < kArraySize - kArrayBreakPt; i += 1) {
-			y = (gMTData[i] & kHighBit) | (gMTData[i + 1] & kLowBits);
-			gMTData[i] = gMTData[i + kArrayBreakPt] ^ (y >> 1) ^ kMerMagic[y & kZeroBit];
-			}
-		for ( ; i < kArraySize - 1; i += 1) {
-			y = (gMTData[i] & kHighBit) | (gMTData[i + 1] & kLowBits);
-			gMTData[i] = gMTData[i + kArrayBreakPt - kArraySize] ^ (y >> 1) ^ kMerMagic[y & kZeroBit];
-			}
-		y = (gMTData[kArraySize - 1] & kHighBit) | (gMTData[0] & kLowBits);
-		gMTData[kArraySize - 1] = gMTData[kArrayBreakPt - 1] ^ (y >> 1) ^ kMerMagic[y & kZeroBit];
+		// a ^ (a << 8 bits) ^ (c >> 8 bits), shifting across all 128 bits
+		xLo = aLo ^ (aLo << (8 * kSFMTSL2)) ^ (cLo >> (8 * kSFMTSR2)) ^ (cHi << (64 - 8 * kSFMTSR2));
+		xHi = aHi ^ (aHi << (8 * kSFMTSL2)) ^ (aLo >> (64 - 8 * kSFMTSL2)) ^ (cHi >> (8 * kSFMTSR2));
 		
-		gMTIndex = 0;
+		// The remaining terms work lane by lane
+		c0 = d0; c1 = d1; c2 = d2; c3 = d3;
+		d0 = a[0] = (UInt32) xLo			^ ((b[0] >> kSFMTSR1) & kSFMTMask[0]) ^ (c0 << kSFMTSL1);
+		d1 = a[1] = (UInt32) (xLo >> 32)	^ ((b[1] >> kSFMTSR1) & kSFMTMask[1]) ^ (c1 << kSFMTSL1);
+		d2 = a[2] = (UInt32) xHi			^ ((b[2] >> kSFMTSR1) & kSFMTMask[2]) ^ (c2 << kSFMTSL1);
+		d3 = a[3] = (UInt32) (xHi >> 32)	^ ((b[3] >> kSFMTSR1) & kSFMTMask[3]) ^ (c3 << kSFMTSL1);
+		}
+	}
+
+
+/******************************************************************************************
+ *
+ *	MrmrRand(me)
+ *	MrmrScale(me, iRange)
+ *
+ *	MrmrScale() maps to [0 .. iRange) by multiplying and keeping the high word, rejecting
+ *	the few raw values that would otherwise make some results more likely than others
+ *	(Lemire's method). iRange == 0 stands for the full 2^32 range. Without a rejection
+ *	this gives exactly the same values as the floating-point scaling we used to do.
+ *
+ ******************************************************************************************/
+
+static inline UInt32
+MrmrRand(
+	objMersenne* me)
+
+	{
+	if (me->index >= kArraySize) {
+		if (me->alg == algSFMT)
+				RefillSFMT(me->state);
+		else	RefillClassic(me->state, me->tempered);
+		me->index = 0;
 		}
 	
-	result = gMTData[gMTIndex++];
-	
-	// "Temper" the result
-    result ^= (result >> 11);
-    result ^= (result << 7) & 0x9d2c5680UL;
-    result ^= (result << 15) & 0xefc60000UL;
-    result ^= (result >> 18);
+	return me->output[me->index++];
+	}
+
+static inline UInt32
+MrmrScale(
+	objMersenne*	me,
+	UInt32			iRange)
 
-    return result;
+	{
+	UInt64	m;
+	
+	if (iRange == 0)
+		return MrmrRand(me);
+	
+	m = (UInt64) MrmrRand(me) * iRange;
+	if ((UInt32) m < iRange) {
+		UInt32 threshold = (0 - iRange) % iRange;
+		
+		while ((UInt32) m < threshold)
+			m = (UInt64) MrmrRand(me) * iRange;
+		}
+	
+	return (UInt32) (m >> 32);
 	}
 
+
+#pragma mark • Class Message Handlers
+
 /******************************************************************************************
  *
  *	MrmrNew(iMin, iMax, iSeed)
+ *	MrmrFree(me)
  *
  ******************************************************************************************/
 
@@ -161,10 +310,8 @@ MrmrNew(
 	objMersenne*		me			= NIL;
 	
 	// Run through initialization parameters from right to left, handling defaults
-	if (iSeed != 0) {
-		MrmrInit(iSeed);
+	if (iSeed != 0)
 		goto noMoreDefaults;
-		}
 	
 	if (iMax == 0) {
 		if (iMin > 0) {
@@ -189,42 +336,76 @@ noMoreDefaults:
 	intout(me);					// Access main outlet through me->coreObject.o_outlet;
 	
 	// Initialize and store object components
-	me->min	= iMin;
-	me->max	= iMax;
+	me->min			= iMin;
+	me->max			= iMax;
+	me->alg			= algClassic;
+	DrawInit(&me->drawBuf);
+	MrmrInit(me, (iSeed != 0) ? (UInt32) iSeed : MachineKharma());
 	
 	return me;
 	}
 
+static void
+MrmrFree(
+	objMersenne* me)
+	
+	{
+	DrawFree(&me->drawBuf);
+	}
+
 #pragma mark -
 #pragma mark • Object Message Handlers
 
 /******************************************************************************************
  *
  *	MrmrBang(me)
+ *	MrmrDraw(me, iCount, iDest)
+ *
+ *	Grab a new random number (or iCount of them) from Mrmr. Scale if necessary.
  *
- *	Grab a new random number from Mrmr. Scale if necessary.
+ *	The draw message can also fill a buffer~ or table named by iDest.
  *
  ******************************************************************************************/
 
+	static inline long NextValue(objMersenne* me)
+		{
+		long	min		= me->min,
+				max		= me->max;
+		
+		if (min < max)
+			// Range wraps to 0 if it's the full 2^32
+			return min + (long) MrmrScale(me, (UInt32) max - (UInt32) min + 1);
+		
+		return (min == max) ? min : 0;
+		}
+
 static void
 MrmrBang(
 	objMersenne* me)
 	
 	{
-	long	mt,
-			min		= me->min,
-			max		= me->max;
 	
-	if (min < max) {
-		double	scale = (double) max - (double) min + 1.0;
+	outlet_int(me->coreObject.o_outlet, NextValue(me));
+	
+	}
+
+	static void DrawDeviates(objMersenne* me, long oVals[], long iCount)
+		{
+		long i;
 		
-		mt = MrmrRand();
-		mt = scale * ULong2Unit_Zo(mt) + min;
+		for (i = 0; i < iCount; i += 1)
+			oVals[i] = NextValue(me);
 		}
-	else mt = (min == max) ? min : 0;
-	
-	outlet_int(me->coreObject.o_outlet, mt);
+
+static void
+MrmrDraw(
+	objMersenne*	me,
+	long			iCount,
+	Symbol*			iDest)
 	
+	{
+	DrawLongs(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawLongFunc) DrawDeviates);
 	}
 
 
@@ -233,6 +414,11 @@ MrmrBang(
  *	MrmrMin(me, iMin)
  *	MrmrMax(me, iMax)
  *	MrmrSeed(me, iSeed)
+ *	MrmrSFMT(me, iSFMT)
+ *
+ *	Seeding only affects this instance. Switching between the classic Mersenne Twister and
+ *	SFMT reseeds with the most recent seed, so a given seed always gives the same sequence
+ *	for either algorithm.
  *
  ******************************************************************************************/
 
@@ -240,10 +426,20 @@ static void MrmrMin(objMersenne* me, long iMin)	{ me->min = iMin; }
 static void MrmrMax(objMersenne* me, long iMax)	{ me->max = iMax; }
 
 static void MrmrSeed(objMersenne* me, long iSeed)
+	{ MrmrInit(me, (UInt32) iSeed); }
+
+static void
+MrmrSFMT(
+	objMersenne*	me,
+	long			iSFMT)
+	
 	{
-	#pragma unused(me)
+	long alg = (iSFMT != 0) ? algSFMT : algClassic;
 	
-	MrmrInit((UInt32) iSeed);
+	if (alg != me->alg) {
+		me->alg = alg;
+		MrmrInit(me, me->seed);
+		}
 	}
 
 
@@ -292,6 +488,9 @@ MrmrTattle(
 			me->min, me->max);
 	if (me->min > me->max)
 		post("  NB: Ignoring range while min > max");
+	post("  Algorithm: %s, seed %lu",
+			(me->alg == algSFMT) ? "SFMT19937" : "MT19937",
+			me->seed);
 	
 	}
 
@@ -373,6 +572,16 @@ DoExpect(
 		return LitterGetAttrFloat(DoExpect(me, expEntropy), ioArgC, ioArgV);
 		}
 	
+	static t_max_err MrmrSetAttrSFMT(objMersenne* me, void* iAttr, long* iArgC, Atom iArgV[])
+		{
+		#pragma unused(iAttr)
+		
+		if (*iArgC > 0 && iArgV != NIL)
+			MrmrSFMT(me, AtomGetLong(iArgV));
+		
+		return MAX_ERR_NONE;
+		}
+	
 	static inline void
 	AddInfo(void)
 		{
@@ -385,6 +594,10 @@ DoExpect(
 		class_addattr(gObjectClass, attr);
 		attr = attr_offset_new("max", symLong, 0, NULL, NULL, calcoffset(objMersenne, max));
 		class_addattr(gObjectClass, attr);
+		attr = attr_offset_new(	"sfmt", symLong, 0,
+								NULL, (method) MrmrSetAttrSFMT,
+								calcoffset(objMersenne, alg));
+		class_addattr(gObjectClass, attr);
 		
 		// Read-Only Attributes
 		attr = attribute_new("mean", symFloat64, kAttrFlagsReadOnly, (method) MrmrGetMean, NULL);
@@ -463,7 +676,7 @@ main(void)
 						sizeof(objMersenne),			// Class object size
 						LitterCalcOffset(objMersenne),	// Magic "Obex" Calculation
 						(method) MrmrNew,				// Instance creation function
-						NIL,							// No custom deallocation function
+						(method) MrmrFree,				// Custom deallocation function
 						NIL,							// No menu function
 						myArgTypes);					// See above
 	
@@ -473,6 +686,8 @@ main(void)
 	LitterAddMess1	((method) MrmrMin,		"in1",		A_LONG);
 	LitterAddMess1	((method) MrmrMax,		"in2",		A_LONG);
 	LitterAddMess1	((method) MrmrSeed,		"seed",		A_DEFLONG);
+	LitterAddMess1	((method) MrmrSFMT,		"sfmt",		A_DEFLONG);
+	LitterAddMess2	((method) MrmrDraw,		"draw",		A_LONG, A_DEFSYM);
 	LitterAddMess2	((method) MrmrTell,		"tell",		A_SYM, A_SYM);
 	LitterAddMess0	((method) MrmrTattle,	"tattle");
 	LitterAddCant	((method) MrmrTattle,	"dblclick");
@@ -482,7 +697,6 @@ main(void)
 	
 	//Initialize Litter Library
 	LitterInit(kClassName, 0);
-	MrmrInit( MachineKharma() );
 	
 	}
 
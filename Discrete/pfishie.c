@@ -38,6 +38,7 @@
 
 #include "TrialPeriodUtils.h"
 #include "RNGPoisson.h"
+#include "DrawUtils.h"
 
 
 #pragma mark • Constants
@@ -71,6 +72,7 @@ typedef struct {
 	ePoisAlg		alg;
 	uPoisParams		params;
 			
+	tDrawBuf		drawBuf;
 	} objPoisson;
 
 
@@ -124,13 +126,17 @@ noMoreDefaults:
 	
 	// Store object components
 	me->tausData	= myTausData;
+	DrawInit(&me->drawBuf);
 	PfishieLambda(me, iLambda);				// Sets up all other members
 	
 	return me;
 	}
 
 static void PfishieFree(objPoisson* me)
-	{ Taus88Free(me->tausData); }							// Taus88Free is NIL-safe
+	{
+	Taus88Free(me->tausData);								// Taus88Free is NIL-safe
+	DrawFree(&me->drawBuf);
+	}
 
 
 #pragma mark -
@@ -139,34 +145,62 @@ static void PfishieFree(objPoisson* me)
 /******************************************************************************************
  *
  *	PfishieBang(me)
+ *	PfishieDraw(me, iCount, iDest)
+ *
+ *	The draw message is the bulk version of bang: iCount Poisson deviates as a list, or
+ *	straight into the buffer~ or table iDest.
  *
  ******************************************************************************************/
 
+	static inline long NextDeviate(objPoisson* me)
+		{
+		long p;
+		
+		switch (me->alg) {
+		case algReject:
+			p = GenPoissonRejTaus88(&me->params.rejParams, me->tausData);
+			break;
+		case algInversion:
+			p = GenPoissonInvTaus88(&me->params.invParams, me->tausData);
+			break;
+		case algDirect:
+			p = GenPoissonDirTaus88(me->params.invParams.thresh, me->tausData);
+			break;
+		default:
+			// Must be algConstZero
+			// Or algUndef, which is an error, but our lambda method prevents that
+			p = 0;
+			break;
+			}
+		
+		return p;
+		}
+
 static void
 PfishieBang(
 	objPoisson* me)
 	
 	{
-	long p;
-	
-	switch (me->alg) {
-	case algReject:
-		p = GenPoissonRejTaus88(&me->params.rejParams, me->tausData);
-		break;
-	case algInversion:
-		p = GenPoissonInvTaus88(&me->params.invParams, me->tausData);
-		break;
-	case algDirect:
-		p = GenPoissonDirTaus88(me->params.invParams.thresh, me->tausData);
-		break;
-	default:
-		// Must be algConstZero
-		// Or algUndef, which is an error, but our lambda method prevents that
-		p = 0;
-		break;
+	outlet_int(me->coreObject.o_outlet, NextDeviate(me));
+	}
+
+	static void DrawDeviates(objPoisson* me, long oVals[], long iCount)
+		{
+		long i;
+		
+		for (i = 0; i < iCount; i += 1)
+			oVals[i] = NextDeviate(me);
 		}
+
+static void
+PfishieDraw(
+	objPoisson*	me,
+	long		iCount,
+	Symbol*		iDest)
 	
-	outlet_int(me->coreObject.o_outlet, p);
+	{
+	DrawLongs(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawLongFunc) DrawDeviates);
 	}
 
 
@@ -490,6 +524,7 @@ main(void)
 	LITTER_TIMEBOMB LitterAddBang	((method) PfishieBang);
 	LitterAddMess1	((method) PfishieLambda,	"ft1",	A_FLOAT);
 	LitterAddMess1	((method) PfishieSeed,		"seed",	A_DEFLONG);
+	LitterAddMess2	((method) PfishieDraw,		"draw",	A_LONG, A_DEFSYM);
 	LitterAddMess2	((method) PfishieTell,		"tell",	A_SYM, A_SYM);
 	LitterAddMess0	((method) PfishieTattle,	"tattle");
 	LitterAddCant	((method) PfishieTattle,	"dblclick");
@@ -33,6 +33,7 @@
 #include "Taus88.h"
 #include "MiscUtils.h"
 #include "UniformExpectations.h"
+#include "DrawUtils.h"
 
 
 #pragma mark • Constants
@@ -57,6 +58,8 @@ typedef struct {
 	tTaus88DataPtr	tausStuff;
 	long			min,
 					max;
+	
+	tDrawBuf		drawBuf;
 	} objTaus88;
 
 
@@ -116,12 +119,16 @@ noMoreDefaults:
 	me->tausStuff = myTausStuff;
 	me->min		= iMin;
 	me->max		= iMax;
+	DrawInit(&me->drawBuf);
 	
 	return me;
 	}
 
 static void TataFree(objTaus88* me)
-	{ Taus88Free(me->tausStuff); }							// Taus88Free is NIL-safe
+	{
+	Taus88Free(me->tausStuff);								// Taus88Free is NIL-safe
+	DrawFree(&me->drawBuf);
+	}
 
 
 #pragma mark -
@@ -130,9 +137,13 @@ static void TataFree(objTaus88* me)
 /******************************************************************************************
  *
  *	TataBang(me)
+ *	TataDraw(me, iCount, iDest)
  *
  *	Grab a new random number from Taus88. Scale if necessary.
  *
+ *	TataDraw() does the same for iCount numbers at a time, keeping the Taus88 state in
+ *	registers between values. They go out as a list or into a buffer~ or table.
+ *
  ******************************************************************************************/
 
 static void
@@ -156,6 +167,45 @@ TataBang(
 	
 	}
 
+	static void DrawDeviates(objTaus88* me, long oVals[], long iCount)
+		{
+		long	min		= me->min,
+				max		= me->max,
+				i;
+		
+		if (min < max) {
+			double			scale	= (double) max - (double) min + 1.0;
+			tTaus88Data*	td		= me->tausStuff;
+			UInt32			s1, s2, s3;
+			
+			if (td == NIL)
+				td = Taus88GetGlobals();
+			
+			Taus88Load(td, &s1, &s2, &s3);
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = scale * ULong2Unit_Zo(Taus88Process(&s1, &s2, &s3)) + min;
+			Taus88Store(td, s1, s2, s3);
+			}
+		
+		else {
+			long taus = (min == max) ? min : 0;
+			
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = taus;
+			}
+		}
+
+static void
+TataDraw(
+	objTaus88*	me,
+	long		iCount,
+	Symbol*		iDest)
+	
+	{
+	DrawLongs(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawLongFunc) DrawDeviates);
+	}
+
 
 /******************************************************************************************
  *
@@ -401,6 +451,7 @@ main(void)
 	LitterAddMess1	((method) TataMin,		"in1",		A_LONG);
 	LitterAddMess1	((method) TataMax,		"in2",		A_LONG);
 	LitterAddMess1	((method) TataSeed,		"seed",		A_DEFLONG);
+	LitterAddMess2	((method) TataDraw,		"draw",		A_LONG, A_DEFSYM);
 	LitterAddMess2	((method) TataTell,		"tell",		A_SYM, A_SYM);
 	LitterAddMess0	((method) TataTattle,	"tattle");
 	LitterAddCant	((method) TataTattle,	"dblclick");
@@ -32,6 +32,7 @@
 #include "TT800.h"
 #include "MiscUtils.h"
 #include "UniformExpectations.h"
+#include "DrawUtils.h"
 
 #pragma mark • Constants
 
@@ -50,6 +51,10 @@ enum {
 	strIndexLeftOutlet	= strIndexTheOutlet
 	};
 
+enum {
+	kJumpLog2			= 400				// Each jump skips 2^400 values
+	};
+
 
 
 #pragma mark • Object Structure
@@ -61,6 +66,10 @@ typedef struct {
 	
 	long			min,
 					max;
+	UInt32			range,					// Cached from min/max, see CheckRange()
+					threshold;				// Raw values below this are rejected
+	
+	tDrawBuf		drawBuf;				// Output buffer for the draw message
 	} objTT800;
 
 
@@ -70,12 +79,66 @@ typedef struct {
 
 #pragma mark • Object Message Handlers
 
+/******************************************************************************************
+ *
+ *	CheckRange(me)
+ *	ScaleWord(me, iRange, iRaw)
+ *
+ *	Scaling multiplies a raw 32-bit value by the range and keeps the high word. To make
+ *	every result equally likely, raw values whose low word falls below 2^32 mod range are
+ *	rejected (Lemire's method). That threshold is the only thing that needs a division;
+ *	we cache it and only recalculate when min or max have changed (they can be set
+ *	through attributes as well as inlets, so we check rather than relying on TitiMin()
+ *	and TitiMax()). A range of 0 stands for the full 2^32.
+ *
+ ******************************************************************************************/
+
+static inline UInt32
+CheckRange(
+	objTT800* me)
+	
+	{
+	UInt32 range = (UInt32) me->max - (UInt32) me->min + 1;
+	
+	if (range != me->range) {
+		me->range		= range;
+		me->threshold	= (range == 0) ? 0 : (0 - range) % range;
+		}
+	
+	return range;
+	}
+
+static inline long
+ScaleWord(
+	objTT800*	me,
+	UInt32		iRange,
+	UInt32		iRaw)
+	
+	{
+	UInt64 m;
+	
+	if (iRange == 0)
+		return me->min + (long) iRaw;
+	
+	m = (UInt64) iRaw * iRange;
+	while ((UInt32) m < me->threshold)
+		m = (UInt64) TT800(me->ttStuff) * iRange;
+	
+	return me->min + (long) (m >> 32);
+	}
+
+
 /******************************************************************************************
  *
  *	TitiBang(me)
+ *	TitiDraw(me, iCount, iDest)
  *
  *	Grab a new random number from Titi. Scale if necessary.
  *
+ *	TitiDraw() sends iCount values as a list (or into a buffer~ or table), fetching raw
+ *	values from TT800 a chunk at a time. Rejected values are redrawn from the same chunk,
+ *	so draw n produces exactly the values that n bangs would have.
+ *
  ******************************************************************************************/
 
 static void
@@ -87,24 +150,89 @@ TitiBang(
 			min		= me->min,
 			max		= me->max;
 	
-	if (min < max) {
-		double	scale = (double) max - (double) min + 1.0;
-		
-		tt = TT800(me->ttStuff);
-		tt = scale * ULong2Unit_ZO(tt) + min;
-		}
+	if (min < max)
+		tt = ScaleWord(me, CheckRange(me), TT800(me->ttStuff));
 	else tt = (min == max) ? min : 0;
 	
 	outlet_int(me->coreObject.o_outlet, tt);
 	
 	}
 
+	// Next raw word for DrawDeviates(). When the block runs out (because rejections
+	// used up words meant for later values) it is refilled with only as many words as
+	// values are still needed. No word is generated and then dropped, so the stream is
+	// exactly what the same number of bangs would consume.
+	static inline UInt32 BlockWord(objTT800* me, UInt32 ioWords[], long* ioNext, long* ioFilled, long iNeeded)
+		{
+		if (*ioNext >= *ioFilled) {
+			TT800Fill(me->ttStuff, ioWords, iNeeded);
+			*ioNext		= 0;
+			*ioFilled	= iNeeded;
+			}
+		
+		return ioWords[(*ioNext)++];
+		}
+	
+	static void DrawDeviates(objTT800* me, long oVals[], long iCount)
+		{
+		long	min = me->min,
+				max = me->max,
+				i;
+		
+		if (min < max) {
+			UInt32	range	= CheckRange(me),
+					words[kDrawChunk];
+			long	next	= 0,
+					filled	= 0;
+			
+			for (i = 0; i < iCount; i += 1) {
+				UInt32	raw = BlockWord(me, words, &next, &filled, iCount - i);
+				UInt64	m;
+				
+				if (range == 0) {
+					oVals[i] = min + (long) raw;
+					continue;
+					}
+				
+				// Same rejection as ScaleWord(), but redraws come from the block
+				m = (UInt64) raw * range;
+				while ((UInt32) m < me->threshold)
+					m = (UInt64) BlockWord(me, words, &next, &filled, iCount - i) * range;
+				
+				oVals[i] = min + (long) (m >> 32);
+				}
+			}
+		
+		else {
+			long tt = (min == max) ? min : 0;
+			
+			for (i = 0; i < iCount; i += 1)
+				oVals[i] = tt;
+			}
+		}
+
+static void
+TitiDraw(
+	objTT800*	me,
+	long		iCount,
+	Symbol*		iDest)
+	
+	{
+	DrawLongs(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawLongFunc) DrawDeviates);
+	}
+
 
 /******************************************************************************************
  *
  *	TitiMin(me, iMin)
  *	TitiMax(me, iMax)
  *	TitiSeed(me, iSeed)
+ *	TitiJump(me, iJumps)
+ *
+ *	Each instance has its own TT800 state. To get several streams that are guaranteed
+ *	not to overlap, give the instances the same seed and then send them different
+ *	numbers of jumps (default 1); each jump skips 2^400 values.
  *
  ******************************************************************************************/
 
@@ -112,7 +240,40 @@ static void TitiMin(objTT800* me, long iMin)	{ me->min = iMin; }
 static void TitiMax(objTT800* me, long iMax)	{ me->max = iMax; }
 
 static void TitiSeed(objTT800* me, long iSeed)
-	{ TT800Seed(me->ttStuff, (unsigned long) iSeed); }
+	{ TT800Seed(me->ttStuff, (UInt32) iSeed); }
+
+static void TitiJump(objTT800*, long);
+
+	static void DeferJump(objTT800* me, Symbol* sym, short argc, Atom argv[])
+		{
+		#pragma unused(sym, argc)
+		
+		TitiJump(me, argv[0].a_w.w_long);
+		}
+
+static void
+TitiJump(
+	objTT800*	me,
+	long		iJumps)
+	
+	{
+	
+	// The first jump has to do some polynomial arithmetic; keep it out of the scheduler
+	if (isr()) {
+		Atom jumpAtom;
+		
+		AtomSetLong(&jumpAtom, iJumps);
+		defer(me, (method) DeferJump, NIL, 1, &jumpAtom);
+		return;
+		}
+	
+	if (iJumps <= 0)
+		iJumps = 1;
+	
+	while (iJumps-- > 0)
+		TT800Jump(me->ttStuff, kJumpLog2);
+	
+	}
 
 
 /******************************************************************************************
@@ -188,11 +349,8 @@ TitiNew(
 	tTT800DataPtr	myTTStuff	= NIL;
 	
 	// Run through initialization parameters from right to left, handling defaults
-	if (iSeed == 0) TT800Init();
-	else {
-		myTTStuff = TT800New(iSeed);
+	if (iSeed != 0)
 		goto noMoreDefaults;
-		}
 	
 	if (iMax == 0) {
 		if (iMin > 0) {
@@ -207,6 +365,11 @@ TitiNew(
 noMoreDefaults:
 	// Finished checking intialization parameters
 	
+	// Every instance gets its own state (a seed of 0 means autoseed). If we can't get
+	// memory for it we fall back on the shared pool, so make sure that's initialized.
+	TT800Init();
+	myTTStuff = TT800New((UInt32) iSeed);
+	
 	// Let Max allocate us, our inlets, and outlets
 	me = (objTT800*) LitterAllocateObject();
 	
@@ -216,16 +379,28 @@ noMoreDefaults:
 	intout(me);					// Access main outlet through me->coreObject.o_outlet;
 	
 	// Store object components
-	me->ttStuff	= myTTStuff;
-	me->min		= iMin;
-	me->max		= iMax;
+	me->ttStuff		= myTTStuff;
+	me->min			= iMin;
+	me->max			= iMax;
+	me->range		= 0;
+	me->threshold	= 0;
+	DrawInit(&me->drawBuf);
 	
 	return me;
 	}
 
 
-static void TitiFree(objTT800* me)
-	{ TT800Free(me->ttStuff); }								// TitiFree() is NULL-safe
+static void
+TitiFree(
+	objTT800* me)
+	
+	{
+	
+	TT800Free(me->ttStuff);									// TT800Free() is NULL-safe
+	
+	DrawFree(&me->drawBuf);
+	
+	}
 
 
 #pragma mark -
@@ -399,6 +574,8 @@ main(void)
 	LitterAddMess1	((method) TitiMin,		"in1",		A_LONG);
 	LitterAddMess1	((method) TitiMax,		"in2",		A_LONG);
 	LitterAddMess1	((method) TitiSeed,		"seed",		A_DEFLONG);
+	LitterAddMess1	((method) TitiJump,		"jump",		A_DEFLONG);
+	LitterAddMess2	((method) TitiDraw,		"draw",		A_LONG, A_DEFSYM);
 	LitterAddMess2	((method) TitiTell,		"tell",		A_SYM, A_SYM);
 	LitterAddCant	((method) TitiTattle,	"dblclick");
 	LitterAddMess0	((method) TitiTattle,	"tattle");
@@ -27,6 +27,7 @@
 #include "Taus88.h"
 #include "MiscUtils.h"
 #include "MoreMath.h"
+#include "DrawUtils.h"
 
 //#include <math.h>
 
@@ -35,6 +36,10 @@
 
 const char*		kClassName		= "lp.zippie";			// Class name
 
+enum {
+	kTableSize		= 1024					// Ranks tabulated for the guide table
+	};
+
 
 	// Indices for STR# resource
 enum {
@@ -56,9 +61,21 @@ typedef struct {
 	
 	tTaus88DataPtr	tausData;
 	
-	double			rho,
-					delta,				// rho - 0.5
-					logos;				// (rho + 1) * ln(1 / (rho + 1))
+	double			rho;				// Probability of rank k is proportional to k^-(rho+1)
+	long			n;					// Largest rank; 0 for the unbounded (zeta) case
+		
+		// Sampling constants, recalculated when rho or n change
+	Boolean			dirty;
+	long			headLen;			// Number of ranks in cdf[] and guide[]
+	double			headMass,			// P(rank <= headLen)
+					q,					// Exponent: rho + 1
+					hX1,				// Rejection-inversion constants for the ranks
+					hN,					// beyond the table
+					squeeze;
+	double			cdf[kTableSize];	// cdf[i] = P(rank <= i+1)
+	long			guide[kTableSize];	// Guide table into cdf[]
+	
+	tDrawBuf		drawBuf;			// Output buffer for the draw message
 	} objZipf;
 
 
@@ -67,11 +84,259 @@ typedef struct {
 
 /*****************************  I M P L E M E N T A T I O N  ******************************/
 
+#pragma mark • Utility Functions
+
+/******************************************************************************************
+ *
+ *	PowerSum(iLo, iHi, iS)
+ *	GenHarmonic(iN, iS)
+ *
+ *	PowerSum() evaluates the sum of k^-s for k = iLo .. iHi by Euler-Maclaurin summation.
+ *	We only call it with iLo > kTableSize, where terms beyond f''' are well below double
+ *	precision. iHi == 0 stands for infinity, in which case iS must be > 1.
+ *
+ *	GenHarmonic() is the generalized harmonic number H(n, s), the sum of k^-s for
+ *	k = 1 .. n, added up term-by-term as far as kTableSize and with PowerSum() for the
+ *	rest.
+ *
+ ******************************************************************************************/
+
+static double
+PowerSum(
+	long	iLo,
+	long	iHi,
+	double	iS)
+	
+	{
+	double	a		= iLo,
+			s3		= iS * (iS + 1.0) * (iS + 2.0),
+			sum;
+	
+	if (iHi == 0) {
+		sum  = pow(a, 1.0 - iS) / (iS - 1.0);
+		sum += 0.5 * pow(a, -iS);
+		sum += iS * pow(a, -iS - 1.0) / 12.0;
+		sum -= s3 * pow(a, -iS - 3.0) / 720.0;
+		}
+	else {
+		double b = iHi;
+		
+		sum	 = (iS == 1.0)
+				? log(b / a)
+				: (pow(b, 1.0 - iS) - pow(a, 1.0 - iS)) / (1.0 - iS);
+		sum += 0.5 * (pow(a, -iS) + pow(b, -iS));
+		sum -= iS * (pow(b, -iS - 1.0) - pow(a, -iS - 1.0)) / 12.0;
+		sum += s3 * (pow(b, -iS - 3.0) - pow(a, -iS - 3.0)) / 720.0;
+		}
+	
+	return sum;
+	}
+
+static double
+GenHarmonic(
+	long	iN,
+	double	iS)
+	
+	{
+	long	k,
+			kMax = (iN == 0 || iN > kTableSize) ? kTableSize : iN;
+	double	sum = 0.0;
+	
+	// Add small terms first
+	for (k = kMax; k > 0; k -= 1)
+		sum += pow(k, -iS);
+	
+	if (kMax < iN || iN == 0)
+		sum += PowerSum(kMax + 1, iN, iS);
+	
+	return sum;
+	}
+
+
+/******************************************************************************************
+ *
+ *	HIntegral(x, q)
+ *	HInverse(x, q)
+ *
+ *	Hörmann & Derflinger's rejection-inversion works with the hat function h(x) = x^-q
+ *	and its integral H(x) = (x^(1-q) - 1) / (1-q). Both H and its inverse are written
+ *	in terms of log1p/expm1 so that they are accurate for q close to 1.
+ *
+ ******************************************************************************************/
+
+	static inline double Helper1(double x)		// log(1 + x) / x
+		{ return (fabs(x) > 1e-8) ? log1p(x) / x : 1.0 - x * (0.5 - x / 3.0); }
+	
+	static inline double Helper2(double x)		// (exp(x) - 1) / x
+		{ return (fabs(x) > 1e-8) ? expm1(x) / x : 1.0 + x * (0.5 + x / 6.0); }
+
+static inline double
+HIntegral(
+	double x,
+	double q)
+	
+	{
+	double logX = log(x);
+	
+	return Helper2((1.0 - q) * logX) * logX;
+	}
+
+static inline double
+HInverse(
+	double x,
+	double q)
+	
+	{
+	double t = x * (1.0 - q);
+	
+	if (t < -1.0)
+		t = -1.0;
+	
+	return exp(Helper1(t) * x);
+	}
+
+
+/******************************************************************************************
+ *
+ *	UpdateConstants(me)
+ *
+ *	Ranks up to kTableSize (or all of them, for small n) are drawn by inversion from a
+ *	table of the CDF. A guide table takes us straight to the right neighborhood, so the
+ *	expected search is about one step.
+ *
+ *	Anything beyond the table is drawn by rejection-inversion. Exponents are typically
+ *	large enough that this is rare, so pow() and log() are only evaluated on a minority
+ *	of draws (and on the even rarer rejections).
+ *
+ *	Recalculating costs one pow() per table entry. No memory is allocated, so this is safe
+ *	at interrupt level.
+ *
+ ******************************************************************************************/
+
+static void
+UpdateConstants(
+	objZipf* me)
+	
+	{
+	long	n		= me->n,
+			len		= (n == 0 || n > kTableSize) ? kTableSize : n,
+			i, j;
+	double	q		= me->rho + 1.0,
+			total	= 0.0,
+			norm;
+	
+	me->q		= q;
+	me->headLen	= len;
+	me->dirty	= false;
+	
+	if (n == 0 && q <= 1.0)
+		return;									// No such distribution; see NextZipf()
+	
+	for (i = 0; i < len; i += 1) {
+		total += pow(i + 1, -q);
+		me->cdf[i] = total;
+		}
+	
+	if (len < n || n == 0) {
+		double a = len + 1;
+		
+		total += PowerSum(len + 1, n, q);
+		
+		me->hX1		= HIntegral(a + 0.5, q) - pow(a, -q);
+		me->hN		= (n == 0) ? 1.0 / (q - 1.0) : HIntegral(n + 0.5, q);
+		me->squeeze	= a + 1.0 - HInverse(HIntegral(a + 1.5, q) - pow(a + 1.0, -q), q);
+		}
+	
+	norm = 1.0 / total;
+	for (i = 0; i < len; i += 1)
+		me->cdf[i] *= norm;
+	if (len == n)
+		me->cdf[len - 1] = 1.0;					// No rounding fuzz at the top
+	me->headMass = me->cdf[len - 1];
+	
+	for (i = j = 0; j < kTableSize; j += 1) {
+		double u = (double) j / (double) kTableSize;
+		
+		while (i < len - 1 && me->cdf[i] <= u)
+			i += 1;
+		me->guide[j] = i;
+		}
+	
+	}
+
+
+/******************************************************************************************
+ *
+ *	NextZipf(me, ioS1, ioS2, ioS3)
+ *
+ *	Caller is responsible for the Taus88 registers and for calling UpdateConstants()
+ *	beforehand if the parameters have changed.
+ *
+ ******************************************************************************************/
+
+static long
+NextZipf(
+	objZipf*	me,
+	UInt32*		ioS1,
+	UInt32*		ioS2,
+	UInt32*		ioS3)
+	
+	{
+	double	q	= me->q,
+			u;
+	long	n	= me->n,
+			k;
+	
+	if (n == 0 && q <= 1.0) {
+		// Slightly cheesy uniform distribution of positive integers
+		do { k = Taus88Process(ioS1, ioS2, ioS3) & 0x7fffffff; } while (k == 0);
+		return k;
+		}
+	
+	u = ULong2Unit_Zo( Taus88Process(ioS1, ioS2, ioS3) );
+	
+	if (u < me->headMass) {
+		// Inversion from the table
+		const double* cdf = me->cdf;
+		
+		k = me->guide[(long) (u * kTableSize)];
+		while (cdf[k] <= u)
+			k += 1;
+		return k + 1;
+		}
+	
+	else {
+		// Rejection-inversion for the rest
+		double	hX1		= me->hX1,
+				hN		= me->hN,
+				lo		= me->headLen + 1,
+				hi		= (n == 0) ? (double) kLongMax : (double) n,
+				x, kk;
+		
+		do {
+			u	= hN + ULong2Unit_zo( Taus88Process(ioS1, ioS2, ioS3) ) * (hX1 - hN);
+			x	= HInverse(u, q);
+			kk	= floor(x + 0.5);
+			
+			if (kk < lo)		kk = lo;
+			else if (kk > hi)	kk = hi;
+			} while (kk - x > me->squeeze && u < HIntegral(kk + 0.5, q) - pow(kk, -q));
+		
+		return (long) kk;
+		}
+	
+	}
+
+
 #pragma mark • Object Message Handlers
 
 /******************************************************************************************
  *
  *	ZippieBang(me)
+ *	ZippieDraw(me, iCount, iDest)
+ *
+ *	The draw message sends iCount values as one list, or into the buffer~ or table named
+ *	by iDest.
  *
  ******************************************************************************************/
 
@@ -80,48 +345,64 @@ ZippieBang(
 	objZipf* me)
 	
 	{
-	double			rho	= me->rho;
 	long			zeta;
 	UInt32			s1, s2, s3;
 	tTaus88Data*	td = me->tausData;
 	
+	if (me->dirty)
+		UpdateConstants(me);
+	
 	if (td == NIL)
 		td = Taus88GetGlobals();
 	Taus88Load(td, &s1, &s2, &s3);
+	zeta = NextZipf(me, &s1, &s2, &s3);
+	Taus88Store(td, s1, s2, s3);
 	
-	if (rho > 0.0) {
-		double			rho		= me->rho,
-						delta	= me->delta,
-						logos	= me->logos,
-						n, e, thresh;
-		do {
-			double	u1 = ULong2Unit_zo( Taus88Process(&s1, &s2, &s3) ),
-					u2 = ULong2Unit_zo( Taus88Process(&s1, &s2, &s3) ),
-					x  = rho * pow(u1, -1.0 / rho) - delta;
-			
-			n = floor(x + 0.5);
-			e = -log(u2);
-			
-			thresh = (rho + 1.0) * log(n / (x + delta)) - logos;
-			} while (e <= thresh);
+	outlet_int(me->coreObject.o_outlet, zeta);
+	}
+
+	static void DrawDeviates(objZipf* me, long oVals[], long iCount)
+		{
+		tTaus88Data*	td = me->tausData;
+		UInt32			s1, s2, s3;
+		long			i;
+		
+		if (me->dirty)
+			UpdateConstants(me);
+		
+		if (td == NIL)
+			td = Taus88GetGlobals();
 		
-		zeta = (long) n;
+		Taus88Load(td, &s1, &s2, &s3);
+		for (i = 0; i < iCount; i += 1)
+			oVals[i] = NextZipf(me, &s1, &s2, &s3);
+		Taus88Store(td, s1, s2, s3);
 		}
-	else do { zeta = Taus88Process(&s1, &s2, &s3) & 0x7fffffff; } while (zeta == 0);
-		// Slightly cheesy uniform distribution of positive integers
-	
-	Taus88Store(td, s1, s2, s3);
+
+static void
+ZippieDraw(
+	objZipf*	me,
+	long		iCount,
+	Symbol*		iDest)
 	
-	outlet_int(me->coreObject.o_outlet, zeta);
+	{
+	DrawLongs(	(Object*) me, &me->drawBuf, me->coreObject.o_outlet,
+				iCount, iDest, (tDrawLongFunc) DrawDeviates);
 	}
 
 
 /******************************************************************************************
  *
- *	ZippieLambda(me, iLambda)
+ *	ZippieRho(me, iRho)
+ *	ZippieN(me, iN)
  *	ZippieSeed(me, iSeed)
  *	
- *	Set parameter. Make sure nothing bad is happening.
+ *	Set parameters. Make sure nothing bad is happening.
+ *
+ *	With a finite number of ranks any exponent rho + 1 >= 0 gives a proper distribution
+ *	(rho = 0 is the classic Zipf law, rho = -1 is uniform). The unbounded zeta distribution
+ *	needs rho > 0; for smaller values we fall back to an (approximately) uniform
+ *	distribution of positive integers, as we always have.
  *	
  ******************************************************************************************/
 
@@ -131,25 +412,19 @@ ZippieRho(
 	double		iRho)
 	
 	{
-//	const double kMinRho = 0.00000011920929;		// Arbitrary, smaller than anything
-													// we are likely to be sent in an Atom
-	// Sanity check
-	if (iRho > 0.0) {
-		me->rho		= iRho;
-		me->delta	= iRho - 0.5;
-		
-		// Increment rho once, use the incremented value twice
-		iRho	 += 1.0;
-		me->logos = iRho * log(1.0 / iRho);
-		}
-	else {
-		me->rho		= 0.0;
-		me->delta	= 0.0;
-		me->logos	= 0.0;
-		}
-	
+	me->rho		= (iRho > -1.0) ? iRho : -1.0;
+	me->dirty	= true;
 	}
 	
+static void
+ZippieN(
+	objZipf*	me,
+	long		iN)
+	
+	{
+	me->n		= (iN > 0) ? iN : 0;
+	me->dirty	= true;
+	}
 
 static void ZippieSeed(objZipf* me, long iSeed)
 	{ Taus88Seed(me->tausData, (unsigned long) iSeed); }
@@ -160,14 +435,16 @@ static void ZippieSeed(objZipf* me, long iSeed)
 
 /******************************************************************************************
  *
- *	ZippieNew(iRho, iSeed)
+ *	ZippieNew(iRho, iSeed, iN)
+ *	ZippieFree(me)
  *
  ******************************************************************************************/
 
 static void*
 ZippieNew(
 	double	iRho,
-	long	iSeed)
+	long	iSeed,
+	long	iN)
 	
 	{
 	const double	kDefRho	= 1.0;
@@ -176,6 +453,7 @@ ZippieNew(
 	tTaus88DataPtr	myTausData	= NIL;
 	
 	// Run through initialization parameters from right to left, handling defaults
+	// (no special handling for n: zero means unbounded)
 	if (iSeed == 0) Taus88Init();						// Use Taus88's data pool
 	else {
 		myTausData = Taus88New(iSeed);
@@ -191,19 +469,29 @@ noMoreDefaults:
 	// Let Max allocate us, our inlets, and outlets
 	me = (objZipf*) LitterAllocateObject();
 
-	floatin(me, 1);												// lambda inlet
+	intin(me, 2);												// n inlet
+	floatin(me, 1);												// rho inlet
 	
 	intout(me);					// Access main outlet through me->coreObject.o_outlet;
 	
 	// Store object components
-	me->tausData = myTausData;
+	me->tausData	= myTausData;
+	DrawInit(&me->drawBuf);
 	ZippieRho(me, iRho);
+	ZippieN(me, iN);
+	UpdateConstants(me);
 	
 	return me;
 	}
 
-static void ZippieFree(objZipf* me)
-	{ Taus88Free(me->tausData); }							// Taus88Free is NIL-safe
+static void
+ZippieFree(
+	objZipf* me)
+	
+	{
+	Taus88Free(me->tausData);							// Taus88Free is NIL-safe
+	DrawFree(&me->drawBuf);
+	}
 
 #pragma mark -
 #pragma mark • Attribute/Information Functions
@@ -223,7 +511,16 @@ ZippieTattle(
 	
 	post("%s state",
 			kClassName);
-	post("  zeta exponent: %lf (delta %lf, logos %lf)", me->rho, me->delta, me->logos);
+	post("  zeta exponent: %lf", me->rho);
+	if (me->n > 0)
+			post("  ranks: 1 .. %ld", me->n);
+	else	post("  ranks: unbounded");
+	if (me->dirty)
+		UpdateConstants(me);
+	if (me->n == 0 && me->q <= 1.0)
+		post("  --> exponent too small for an unbounded distribution; drawing uniformly");
+	else post("  %lf%% of draws come from the table of the first %ld ranks",
+				100.0 * me->headMass, me->headLen);
 	
 	}
 
@@ -240,8 +537,11 @@ static void ZippieAssist(objZipf* me, void* iBox, long iDir, long iArgNum, char*
  *
  *	DoExpect()
  *
- *	Helper function for calculating expected values (mean, standard deviation, etc.) for
- *	Taus88
+ *	Helper function for calculating expected values (mean, standard deviation, etc.)
+ *
+ *	Moments are ratios of zeta functions in the unbounded case and of generalized
+ *	harmonic numbers when the number of ranks is finite. The median is looked up in the
+ *	CDF table if it falls inside it (which it nearly always does).
  *	
  ******************************************************************************************/
 
@@ -252,18 +552,26 @@ DoExpect(
 	
 	{
 	double	result	= 0.0 / 0.0,
-			rho;
+			rho		= me->rho;
+	long	n		= me->n;
 	
 	switch(iSel) {
 	case expMean:
-		rho = me->rho;
-		if (rho > 1.0)
+		if (n > 0)
+			result = GenHarmonic(n, rho) / GenHarmonic(n, rho + 1.0);
+		else if (rho > 1.0)
 			result = RiemannZeta(rho) / RiemannZeta(rho + 1.0);
 		break;
 	case expVar:
 	case expStdDev:
-		rho = me->rho;
-		if (rho > 2.0) {
+		if (n > 0) {
+			double	h0 = GenHarmonic(n, rho + 1.0),
+					m1 = GenHarmonic(n, rho) / h0;
+			
+			result = GenHarmonic(n, rho - 1.0) / h0 - m1 * m1;
+			if (iSel == expStdDev) result = sqrt(result);
+			}
+		else if (rho > 2.0) {
 			double  zetaRho1 = RiemannZeta(rho + 1.0);
 			
 			result  = RiemannZeta(rho) / zetaRho1;
@@ -273,12 +581,47 @@ DoExpect(
 			if (iSel == expStdDev) result = sqrt(result);
 			}
 		break;
+	case expSkew:
+	case expKurtosis:
+		if (n > 0) {
+			double	h0	= GenHarmonic(n, rho + 1.0),
+					m1	= GenHarmonic(n, rho) / h0,
+					m2	= GenHarmonic(n, rho - 1.0) / h0,
+					m3	= GenHarmonic(n, rho - 2.0) / h0,
+					var	= m2 - m1 * m1;
+			
+			if (iSel == expSkew)
+				result = (m3 - 3.0 * m1 * var - m1 * m1 * m1) / (var * sqrt(var));
+			else {
+				double m4 = GenHarmonic(n, rho - 3.0) / h0;
+				
+				result  = m4 - 4.0 * m1 * m3 + 6.0 * m1 * m1 * m2 - 3.0 * m1 * m1 * m1 * m1;
+				result /= var * var;
+				result -= 3.0;
+				}
+			}
+		break;
+	case expMedian:
+		{
+		long i;
+		
+		if (n == 0 && rho <= 0.0)
+			break;											// Not a distribution
+		if (me->dirty)
+			UpdateConstants(me);
+		for (i = 0; i < me->headLen; i += 1)
+			if (me->cdf[i] >= 0.5) {
+				result = i + 1;
+				break;
+				}
+		}
+		break;
 	case expMode:
 	case expMin:
 		result = 1.0;
 		break;
 	case expMax:
-		result = 1.0 / 0.0;
+		result = (n > 0) ? (double) n : 1.0 / 0.0;
 		break;
 	default:
 		break;
@@ -357,20 +700,32 @@ DoExpect(
 		return MAX_ERR_NONE;
 		}
 	
+	static t_max_err ZippieSetAttrN(objZipf* me, void* iAttr, long* iArgC, Atom iArgV[])
+		{
+		#pragma unused(iAttr)
+		
+		if (*iArgC > 0 && iArgV != NIL)
+			ZippieN(me, AtomGetLong(iArgV));
+		
+		return MAX_ERR_NONE;
+		}
+	
 	static inline void
 	AddInfo(void)
 		{
 		Object*	attr;
 		Symbol*	symFloat64		= gensym("float64");
-//		Symbol*	symLong			= gensym("long");
+		Symbol*	symLong			= gensym("long");
 		
 		// Read-Write Attributes
 		attr = attr_offset_new(	"rho", symFloat64, 0,
 								NULL, (method) ZippieSetAttrRho,
 								calcoffset(objZipf, rho));
 		class_addattr(gObjectClass, attr);
-//		attr = attr_offset_new("max", symLong, 0, NULL, NULL, calcoffset(objZipf, max));
-//		class_addattr(gObjectClass, attr);
+		attr = attr_offset_new(	"n", symLong, 0,
+								NULL, (method) ZippieSetAttrN,
+								calcoffset(objZipf, n));
+		class_addattr(gObjectClass, attr);
 		
 		// Read-Only Attributes
 		attr = attribute_new("mean", symFloat64, kAttrFlagsReadOnly, (method) ZippieGetMean, NULL);
@@ -438,6 +793,7 @@ main(void)
 						A_DEFFLOAT,			// Optional arguments:	1. rho
 						A_DEFLONG,			// 						2. seed
 											// If no seed specified, use global Taus88 data
+						A_DEFLONG,			//						3. n (0: unbounded)
 						A_NOTHING
 						};
 	
@@ -454,6 +810,8 @@ main(void)
 	// Messages
 	LITTER_TIMEBOMB LitterAddBang	((method) ZippieBang);
 	LitterAddMess1	((method) ZippieRho,	"ft1",		A_FLOAT);
+	LitterAddMess1	((method) ZippieN,		"in2",		A_LONG);
+	LitterAddMess2	((method) ZippieDraw,	"draw",		A_LONG, A_DEFSYM);
 	LitterAddMess1	((method) ZippieSeed,	"seed",		A_DEFLONG);
 	LitterAddMess2	((method) ZippieTell,	"tell"	,	A_SYM, A_SYM);
 	LitterAddMess0	((method) ZippieTattle,	"tattle");
@@ -0,0 +1,115 @@
+/*
+	File:		julie.h
+
+	Contains:	Render scheduling for lbj.julie: decides from frame to frame whether to skip,
+				partially re-render, or fully re-render the cached Julia set as c drifts.
+
+	Written by:	Peter Castine
+
+	Copyright:	© 2026 Peter Castine
+
+	Change History (most recent first):
+
+*/
+
+
+/******************************************************************************************
+ ******************************************************************************************/
+
+#pragma once
+#ifndef __JULIE_H__
+#define __JULIE_H__
+
+
+#pragma mark • Include Files
+
+#ifndef __MACTYPES__
+	#include <MacTypes.h>									// For Boolean
+#endif
+
+
+#pragma mark • Type Definitions
+
+	// Rows are split into interlace groups; group g holds the rows with row % interlace == g.
+	// While c drifts, one group per frame is re-rendered. owed counts the groups that have
+	// not yet been drawn at the current c; the render is only skipped when it reaches zero.
+typedef struct {
+	double	cFull[2],				// c at last full render
+			cLast[2];				// c at last (partial or full) render
+	long	phase,					// Next row group to re-render
+			owed;					// Row groups still drawn at an earlier c
+	} tDriftState;
+
+
+#pragma mark • Inline Functions
+
+/******************************************************************************************
+ *
+ *	DriftReset(ioState)
+ *	DriftPlan(ioState, iC, iDrift, iInterlace, iCacheUsable, oPhase)
+ *
+ *	DriftPlan() returns
+ *		0		if the cache already shows the set for iC;
+ *		1		for a full render (all rows);
+ *		n > 1	to render only the rows with row % n == *oPhase.
+ *
+ *	Whenever c moves (but stays within iDrift of the c of the last full render) every row
+ *	group is owed again, and the groups are then drawn in turn, one per frame, until all
+ *	of them show the current c. Pass iCacheUsable = false when anything other than c has
+ *	changed.
+ *
+ ******************************************************************************************/
+
+static inline void DriftReset(tDriftState* ioState)
+	{ ioState->phase = 0; ioState->owed = 0; }
+
+static inline long
+DriftPlan(
+	tDriftState*	ioState,
+	const double	iC[2],
+	double			iDrift,
+	long			iInterlace,
+	Boolean			iCacheUsable,
+	long*			oPhase)
+
+	{
+	long	result = 1;
+
+	*oPhase = 0;
+
+	if (iCacheUsable) {
+		Boolean	cMoved	= (iC[0] != ioState->cLast[0] || iC[1] != ioState->cLast[1]);
+		double	dr		= iC[0] - ioState->cFull[0],
+				di		= iC[1] - ioState->cFull[1];
+
+		if (cMoved)
+			ioState->owed = (dr * dr + di * di <= iDrift * iDrift && iInterlace > 1)
+								? iInterlace
+								: 0;							// Too far: full render
+
+		if (ioState->owed > 0 && iInterlace > 1) {
+			if (ioState->owed > iInterlace)						// interlace was reduced
+				ioState->owed = iInterlace;
+			result			= iInterlace;
+			*oPhase			= ioState->phase % iInterlace;
+			ioState->phase	= (*oPhase + 1) % iInterlace;
+			ioState->owed  -= 1;
+			}
+		else if (!cMoved && ioState->owed <= 0)
+			result = 0;											// Nothing to do
+		}
+
+	if (result == 1) {
+		ioState->cFull[0] = iC[0];
+		ioState->cFull[1] = iC[1];
+		DriftReset(ioState);
+		}
+	if (result > 0) {
+		ioState->cLast[0] = iC[0];
+		ioState->cLast[1] = iC[1];
+		}
+
+	return result;
+	}
+
+#endif		// __JULIE_H__
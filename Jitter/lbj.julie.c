@@ -0,0 +1,947 @@
+/*
+	File:		lbj.julie.c
+
+	Contains:	Max/Jitter external object rendering filled Julia sets for the iteration
+				z' <- z^2 + c that lp.julie steps through one point at a time.
+
+	Written by:	Peter Castine
+
+	Copyright:	© 2026 Peter Castine
+
+	Change History (most recent first):
+
+*/
+
+
+/******************************************************************************************
+ ******************************************************************************************/
+
+#pragma mark • Include Files
+
+#include "LitterLib.h"
+#include "TrialPeriodUtils.h"
+#include "MiscUtils.h"
+#include "julie.h"
+
+#include <math.h>
+
+
+#pragma mark • Constants
+
+const char	kMaxClassName[]		= "lbj.julie",			// Class name for Max
+			kJitClassName[]		= "lbj-julie";			// Class name for Jitter
+
+	// Indices for STR# resource
+enum {
+	strIndexInBang		= lpStrIndexLastStandard + 1,
+
+	strIndexOutJulia,
+	strIndexOutDump,
+
+	strIndexInLeft		= strIndexInBang,
+	strIndexOutLeft		= strIndexOutJulia
+	};
+
+	// Number of pixels iterated in lockstep
+enum {
+	kLanes		= 64
+	};
+
+	// How often (in iterations) the lane kernel checks whether any pixel is still inside
+	// the bailout radius.
+enum {
+	kCheckPeriod	= 8
+	};
+
+	// Coloring
+enum Mode {
+	modeEscape		= 0,					// Escape count / iter
+	modeSmooth,								// Continuous (normalized) iteration count
+	modeTrap,								// Closest approach to the trap point
+
+	modeFirst		= modeEscape,
+	modeLast		= modeTrap
+	};
+
+const char*	kModeNames[modeLast + 1]	= {	"escape",
+											"smooth",
+											"trap"
+											};
+
+
+#pragma mark • Type Definitions
+
+typedef enum Mode tMode;
+
+	// Everything but c that goes into a rendered image. A change to any of these
+	// invalidates the cache.
+typedef struct {
+	double	view[4],
+			bailout,
+			trap[2];
+	long	iter,
+			mode,
+			cols,
+			rows;
+	} tRenderKey;
+
+
+#pragma mark • Object Structure
+
+typedef struct {
+	Object		coreObject;
+	voidPtr		obex;					// The magic extended object thing.
+	} msobJulie;						// Mac Shell Object
+
+typedef struct {
+	Object		coreObject;
+
+	long		cCount,					// Attribute array counts
+				viewCount,
+				trapCount;
+	double		c[2],					// Offset parameter (real, imaginary)
+				view[4],				// Left, top, right, bottom of the complex plane
+				trap[2],				// Orbit trap point
+				bailout,
+				drift;					// Max. distance c may wander from the last full
+										// render before we do a full render again
+	long		iter,
+				interlace;				// While drifting, re-render every nth row per frame
+	tMode		mode;
+
+		// Render cache: one float per pixel, stored row-major
+	float*		cache;
+	long		cacheSize;				// Number of floats allocated
+	Boolean		cacheValid;
+	tRenderKey	cacheKey;				// What's in the cache
+	tDriftState	sched;					// Which rows still show an earlier c
+	} jcobJulie;						// Jitter Core Object
+
+	// Per-frame parameters handed to the parallel worker
+typedef struct {
+	const jcobJulie*	me;
+	float*				base;
+	double				x0, dx,
+						y0, dy,
+						bailout2;
+	long				interlace,
+						phase;
+	} tJuliaCalc;
+
+
+#pragma mark • Global Variables
+
+void*			gJulieJitClass	= NIL;
+Messlist*		gJulieMaxClass	= NIL;
+
+
+#pragma mark • Function Prototypes
+
+	// Max methods/functions
+static void*JulieNewMaxShell	(Symbol*, long, Atom*);
+static void	JulieFreeMaxShell(msobJulie*);
+
+static void JulieOutputMatrix(msobJulie*);
+static void JulieTattle	(msobJulie*);
+static void	JulieAssist	(msobJulie*, void* , long , long , char*);
+static void	JulieInfo	(msobJulie*);
+
+	// Jitter methods/functions
+static t_jit_err JulieJitInit		(void);
+
+
+#pragma mark -
+/*****************************  I M P L E M E N T A T I O N  ******************************/
+
+#pragma mark • Inline Functions
+
+static inline Byte Unit2Byte(double x)
+	{ return (Byte) (255.0 * x + 0.5); }
+
+
+/******************************************************************************************
+ *
+ *	JuliaLanes(iCalc, iMode, iCol, iCount, iY, oValue)
+ *
+ *	Iterates z' <- z^2 + c for iCount pixels of one row, starting at column iCol, and stores
+ *	the pixel values in oValue[].
+ *
+ *	All lanes step together. A lane that leaves the bailout radius keeps its last z and
+ *	stops counting; the update is written as a select rather than a branch so the loop
+ *	over lanes vectorizes. The block stops early once every lane has escaped.
+ *
+ *	Callers pass a constant iMode so the coloring code for the other modes folds away.
+ *
+ ******************************************************************************************/
+
+static inline void
+JuliaLanes(
+	const tJuliaCalc*	iCalc,
+	int					iMode,
+	long				iCol,
+	long				iCount,
+	double				iY,
+	float				oValue[])
+
+	{
+	const jcobJulie*	me			= iCalc->me;
+	const double		kCReal		= me->c[0],
+						kCImag		= me->c[1],
+						kBail2		= iCalc->bailout2,
+						kTrapReal	= me->trap[0],
+						kTrapImag	= me->trap[1],
+						kDX			= iCalc->dx;
+	const long			kIter		= me->iter;
+
+	double	zr[kLanes],
+			zi[kLanes],
+			dist2[kLanes];
+	long	count[kLanes],
+			alive[kLanes],
+			i, k;
+
+	for (k = 0; k < iCount; k += 1) {
+		zr[k]		= iCalc->x0 + kDX * (double) (iCol + k);
+		zi[k]		= iY;
+		count[k]	= 0;
+		alive[k]	= 1;
+		if (iMode == modeTrap) {
+			double	tr = zr[k] - kTrapReal,
+					ti = zi[k] - kTrapImag;
+			dist2[k] = tr * tr + ti * ti;
+			}
+		}
+
+	for (i = 0; i < kIter; i += 1) {
+		for (k = 0; k < iCount; k += 1) {
+			double	r	= zr[k],
+					m	= zi[k],
+					r2	= r * r,
+					m2	= m * m;
+			long	a	= alive[k] & (r2 + m2 <= kBail2);
+
+			zr[k]		 = a ? r2 - m2 + kCReal : r;
+			zi[k]		 = a ? 2.0 * r * m + kCImag : m;
+			count[k]	+= a;
+			alive[k]	 = a;
+
+			if (iMode == modeTrap) {
+				double	tr = zr[k] - kTrapReal,
+						ti = zi[k] - kTrapImag,
+						d2 = tr * tr + ti * ti;
+				dist2[k] = (a && d2 < dist2[k]) ? d2 : dist2[k];
+				}
+			}
+
+		if ((i + 1) % kCheckPeriod == 0) {
+			long any = 0;
+			for (k = 0; k < iCount; k += 1)
+				any |= alive[k];
+			if (any == 0)
+				break;
+			}
+		}
+
+	// Color
+	for (k = 0; k < iCount; k += 1) {
+		double	mod2	= zr[k] * zr[k] + zi[k] * zi[k],
+				x;
+
+		switch (iMode) {
+		case modeSmooth:
+			if (mod2 > kBail2) {
+				// Continuous iteration count; the correction term is < 1 for escaped z
+				x = (double) count[k] + 1.0 - log2(0.5 * log(mod2));
+				x /= (double) kIter;
+				if (x < 0.0)		x = 0.0;
+				else if (x > 1.0)	x = 1.0;
+				}
+			else x = 0.0;
+			break;
+
+		case modeTrap:
+			x = sqrt(dist2[k] / kBail2);
+			x = (x < 1.0) ? 1.0 - x : 0.0;
+			break;
+
+		default:
+			// modeEscape
+			x = (mod2 > kBail2) ? (double) count[k] / (double) kIter : 0.0;
+			break;
+			}
+
+		oValue[k] = x;
+		}
+
+	}
+
+
+#pragma mark -
+
+/******************************************************************************************
+ *
+ *	main()
+ *
+ *	Standard Max External Object Entry Point Function
+ *
+ ******************************************************************************************/
+
+void
+main(void)
+
+	{
+	const long kAttr = MAX_JIT_MOP_FLAGS_OWN_OUTPUTMATRIX | MAX_JIT_MOP_FLAGS_OWN_JIT_MATRIX;
+
+	voidPtr	p,									// Have to guess about what these two do
+			q;									// Not much is documented in the Jitter SDK
+
+	LITTER_CHECKTIMEOUT(kMaxClassName);
+	JulieJitInit();
+
+	// Standard Max setup() call
+	setup(	&gJulieMaxClass,					// Pointer to our class definition
+			(method) JulieNewMaxShell,		// Instance creation function
+			(method) JulieFreeMaxShell,		// Custom deallocation function
+			(short) sizeof(msobJulie),		// Class object size
+			NIL,							// No menu function
+			A_GIMME,						// Jitter objects always parse their own arguments
+			0);
+
+	// Jitter Magic...
+	p = max_jit_classex_setup(calcoffset(msobJulie, obex));
+	q = jit_class_findbyname(gensym((char*) kJitClassName));
+    max_jit_classex_mop_wrap(p, q, kAttr);
+    max_jit_classex_standard_wrap(p, q, 0);
+	LITTER_TIMEBOMB max_addmethod_usurp_low((method) JulieOutputMatrix, "outputmatrix");
+
+	// Back to adding messages...
+	addmess	((method) JulieTattle,	"dblclick",	A_CANT, 0);
+	addmess	((method) JulieTattle,	"tattle",	A_NOTHING);
+	addmess	((method) JulieAssist,	"assist",	A_CANT, 0);
+	addmess	((method) JulieInfo,		"info",		A_CANT, 0);
+
+	// Initialize Litter Library
+	LitterInit(kMaxClassName, 0);
+	}
+
+
+#pragma mark -
+#pragma mark • Internal functions
+
+/******************************************************************************************
+ *
+ *	RenderRows(iCalc, iDimCount, iDim, iPlaneCount, iCacheInfo, ioCache)
+ *
+ *	Worker for jit_parallel_ndim_simplecalc1(). Jitter hands each thread a band of rows
+ *	of the cache; we recover the first row of the band from the data pointer.
+ *
+ *	When iCalc->interlace > 1 only rows congruent to iCalc->phase are rendered, the others
+ *	keep what the cache already holds.
+ *
+ ******************************************************************************************/
+
+static void
+RenderRows(
+	const tJuliaCalc*	iCalc,
+	long				iDimCount,
+	long*				iDim,
+	long				iPlaneCount,
+	t_jit_matrix_info*	iCacheInfo,
+	char*				ioCache)
+
+	{
+	#pragma unused(iDimCount, iPlaneCount)
+
+	const long	kCols		= iDim[0],
+				kRowStride	= iCacheInfo->dimstride[1],
+				kFirstRow	= (ioCache - (char*) iCalc->base) / kRowStride,
+				kEndRow		= kFirstRow + ((iDimCount > 1) ? iDim[1] : 1),
+				kInterlace	= iCalc->interlace;
+
+	long	row, col, n;
+
+	for (row = kFirstRow; row < kEndRow; row += 1) {
+		float*	out;
+		double	y;
+
+		if (row % kInterlace != iCalc->phase)
+			continue;
+
+		out	= (float*) (ioCache + (row - kFirstRow) * kRowStride);
+		y	= iCalc->y0 + iCalc->dy * (double) row;
+
+		for (col = 0; col < kCols; col += kLanes) {
+			n = kCols - col;
+			if (n > kLanes)
+				n = kLanes;
+
+			switch (iCalc->me->mode) {
+				case modeSmooth:	JuliaLanes(iCalc, modeSmooth, col, n, y, out + col);	break;
+				case modeTrap:		JuliaLanes(iCalc, modeTrap, col, n, y, out + col);	break;
+				default:			JuliaLanes(iCalc, modeEscape, col, n, y, out + col);	break;
+				}
+			}
+		}
+
+	}
+
+
+/******************************************************************************************
+ *
+ *	WriteCharMatrix(me, iCols, iRows, iMInfo, oData)
+ *	WriteFloatMatrix(me, iCols, iRows, iMInfo, oData)
+ *
+ *	Copy the cache to the output matrix, same value to all planes.
+ *
+ ******************************************************************************************/
+
+static void
+WriteCharMatrix(
+	const jcobJulie*	me,
+	long				iCols,
+	long				iRows,
+	t_jit_matrix_info*	iMInfo,
+	char*				oData)
+
+	{
+	const long		kPlanes	= iMInfo->planecount;
+	const float*	cache	= me->cache;
+
+	long	row, col, j;
+
+	for (row = 0; row < iRows; row += 1) {
+		Byte* out = (Byte*) oData + row * iMInfo->dimstride[1];
+
+		for (col = 0; col < iCols; col += 1) {
+			Byte b = Unit2Byte(*cache++);
+
+			for (j = 0; j < kPlanes; j += 1)
+				out[j] = b;
+			out += iMInfo->dimstride[0];
+			}
+		}
+
+	}
+
+static void
+WriteFloatMatrix(
+	const jcobJulie*	me,
+	long				iCols,
+	long				iRows,
+	t_jit_matrix_info*	iMInfo,
+	char*				oData)
+
+	{
+	const long		kPlanes	= iMInfo->planecount;
+	const float*	cache	= me->cache;
+
+	long	row, col, j;
+
+	for (row = 0; row < iRows; row += 1) {
+		char* out = oData + row * iMInfo->dimstride[1];
+
+		for (col = 0; col < iCols; col += 1) {
+			float x = *cache++;
+
+			for (j = 0; j < kPlanes; j += 1)
+				((float*) out)[j] = x;
+			out += iMInfo->dimstride[0];
+			}
+		}
+
+	}
+
+
+/******************************************************************************************
+ *
+ *	GetRenderKey(me, iCols, iRows, oKey)
+ *	SameRenderKey(iKey1, iKey2)
+ *
+ ******************************************************************************************/
+
+static void
+GetRenderKey(
+	const jcobJulie*	me,
+	long				iCols,
+	long				iRows,
+	tRenderKey*			oKey)
+
+	{
+	int i;
+
+	for (i = 0; i < 4; i += 1)
+		oKey->view[i] = me->view[i];
+	oKey->bailout	= me->bailout;
+	oKey->trap[0]	= me->trap[0];
+	oKey->trap[1]	= me->trap[1];
+	oKey->iter		= me->iter;
+	oKey->mode		= me->mode;
+	oKey->cols		= iCols;
+	oKey->rows		= iRows;
+	}
+
+static Boolean
+SameRenderKey(
+	const tRenderKey*	iKey1,
+	const tRenderKey*	iKey2)
+
+	{
+	int i;
+
+	for (i = 0; i < 4; i += 1)
+		if (iKey1->view[i] != iKey2->view[i]) return false;
+
+	return iKey1->bailout == iKey2->bailout
+			&& iKey1->iter == iKey2->iter
+			&& iKey1->mode == iKey2->mode
+			&& iKey1->cols == iKey2->cols
+			&& iKey1->rows == iKey2->rows
+			&& (iKey1->mode != modeTrap
+					|| (iKey1->trap[0] == iKey2->trap[0] && iKey1->trap[1] == iKey2->trap[1]));
+	}
+
+
+#pragma mark -
+#pragma mark • Max Shell Methods
+
+/******************************************************************************************
+ *
+ *	JulieNewMaxShell(iSym, iArgC, iArgV)
+ *
+ ******************************************************************************************/
+
+static void*
+JulieNewMaxShell(
+	SymbolPtr	sym,
+	long		iArgC,
+	Atom		iArgV[])
+
+	{
+	#pragma unused(sym)
+
+	msobJulie*	me			= NIL;
+	void*		jitObj		= NIL;
+	Symbol*		classSym	= gensym((char*) kJitClassName);
+
+	me = (msobJulie*) max_jit_obex_new(gJulieMaxClass, classSym);
+	if (me == NIL) goto punt;
+
+	jitObj = jit_object_new(classSym);
+		if (jitObj == NIL) goto punt;
+
+	max_jit_mop_setup_simple(me, jitObj, iArgC, iArgV);
+	max_jit_attr_args(me, iArgC, iArgV);
+
+	return me;
+	// ------------------------------------------------------------------------
+	// End of normal processing
+
+	// Poor man's exception handling
+punt:
+	error("%s: could not allocate object", kMaxClassName);
+	if (me != NIL)
+		freeobject(&me->coreObject);
+
+	return NIL;
+	}
+
+/******************************************************************************************
+ *
+ *	JulieFreeMaxShell(me)
+ *
+ ******************************************************************************************/
+
+static void
+JulieFreeMaxShell(
+	msobJulie* me)
+
+	{
+	max_jit_mop_free(me);
+	jit_object_free(max_jit_obex_jitob_get(me));
+	max_jit_obex_free(me);
+	}
+
+
+/******************************************************************************************
+ *
+ *	JulieOutputMatrix(me)
+ *
+ ******************************************************************************************/
+
+static void
+JulieOutputMatrix(
+	msobJulie* me)
+
+	{
+	void*		mop = max_jit_obex_adornment_get(me, _jit_sym_jit_mop);
+	t_jit_err	err = noErr;
+
+	// Sanity check: don't output if mop is NIL
+	if (mop == NIL)
+		return;
+
+	if (max_jit_mop_getoutputmode(me) == 1) {
+		err = (t_jit_err) jit_object_method(
+								max_jit_obex_jitob_get(me),
+								_jit_sym_matrix_calc,
+								jit_object_method(mop, _jit_sym_getinputlist),
+								jit_object_method(mop, _jit_sym_getoutputlist));
+
+		if (err == noErr)
+				max_jit_mop_outputmatrix(me);
+		else	jit_error_code(me, err);
+		}
+
+	}
+
+
+/******************************************************************************************
+ *
+ *	JulieTattle(me)
+ *	JulieInfo(me)
+ *	JulieAssist(me, iBox, iDir, iArgNum, oCStr)
+ *
+ *	Litter responses to standard Max messages
+ *
+ ******************************************************************************************/
+
+void
+JulieTattle(
+	msobJulie* me)
+
+	{
+	jcobJulie* jitMe = (jcobJulie*) max_jit_obex_jitob_get(me);
+
+	post("%s state", kMaxClassName);
+	post("  c: (%lf, %lf)", jitMe->c[0], jitMe->c[1]);
+	post("  view: (%lf, %lf) to (%lf, %lf)",
+			jitMe->view[0], jitMe->view[1], jitMe->view[2], jitMe->view[3]);
+	post("  mode: %s, %ld iterations, bailout %lf",
+			kModeNames[jitMe->mode], jitMe->iter, jitMe->bailout);
+	if (jitMe->mode == modeTrap)
+		post("  trap: (%lf, %lf)", jitMe->trap[0], jitMe->trap[1]);
+	if (jitMe->drift > 0.0)
+		post("  drift: %lf, interlace: %ld", jitMe->drift, jitMe->interlace);
+	}
+
+void JulieInfo(msobJulie* me)
+	{ LitterInfo(kMaxClassName, &me->coreObject, (method) JulieTattle); }
+
+void JulieAssist(msobJulie* me, void* box, long iDir, long iArgNum, char* oCStr)
+	{
+	#pragma unused(me, box)
+
+	LitterAssist(iDir, iArgNum, strIndexInLeft, strIndexOutLeft, oCStr);
+	}
+
+
+#pragma mark -
+#pragma mark • Jitter Methods
+
+/******************************************************************************************
+ *
+ *	JulieJitNew()
+ *	JulieJitFree(me)
+ *
+ ******************************************************************************************/
+
+static jcobJulie* JulieJitNew()
+	{
+	jcobJulie* me = (jcobJulie*) jit_object_alloc(gJulieJitClass);
+
+	me->cCount		= 2;
+	me->c[0]		= -0.8;							// Something with a connected set
+	me->c[1]		= 0.156;
+	me->viewCount	= 4;
+	me->view[0]		= -1.6;
+	me->view[1]		= 1.2;
+	me->view[2]		= 1.6;
+	me->view[3]		= -1.2;
+	me->trapCount	= 2;
+	me->trap[0]		= 0.0;
+	me->trap[1]		= 0.0;
+	me->bailout		= 2.0;
+	me->drift		= 0.0;
+	me->iter		= 64;
+	me->interlace	= 4;
+	me->mode		= modeEscape;
+	me->cache		= NIL;
+	me->cacheSize	= 0;
+	me->cacheValid	= false;
+	DriftReset(&me->sched);
+
+	return me;
+	}
+
+static void JulieJitFree(jcobJulie* me)
+	{ if (me->cache != NIL) sysmem_freeptr(me->cache); }
+
+
+/******************************************************************************************
+ *
+ *	JulieJitMatrixCalc(me, inputs, outputs)
+ *
+ *	Pixel values are rendered into a private float cache, which is then copied to the
+ *	output matrix. If nothing has changed since the last frame, only the copy happens.
+ *
+ *	If only c has changed, and it is still within drift of the c used for the last full
+ *	render, we re-render one row in interlace, cycling through the rows from frame to
+ *	frame. Rows not yet re-rendered show the set for a nearby c. Once c stops moving the
+ *	cycle continues until every row shows the current c; only then are renders skipped.
+ *	A full render happens when c wanders further, or when anything else changes. The
+ *	bookkeeping is in DriftPlan() (julie.h).
+ *
+ ******************************************************************************************/
+
+static t_jit_err
+JulieJitMatrixCalc(
+	jcobJulie*	me,
+	void*		inputs,
+	void*		outputs)
+
+	{
+	#pragma unused(inputs)
+
+	t_jit_err			err = JIT_ERR_NONE;
+	long				outSaveLock,
+						cols, rows;
+	t_jit_matrix_info	outMInfo,
+						cacheMInfo;
+	char*				outMData;
+	tRenderKey			key;
+	tJuliaCalc			calc;
+	void*				outMatrix = jit_object_method(outputs, _jit_sym_getindex, 0);
+
+	// Sanity check
+	if ((me == NIL) || (outMatrix == NIL))
+		return JIT_ERR_INVALID_PTR;
+
+	outSaveLock = (long) jit_object_method(outMatrix, _jit_sym_lock, 1);
+
+	jit_object_method(outMatrix, _jit_sym_getinfo, &outMInfo);
+	jit_object_method(outMatrix, _jit_sym_getdata, &outMData);
+
+	if (outMData == NIL)
+		{ err = JIT_ERR_INVALID_OUTPUT; goto alohamora; }
+	if (outMInfo.type != _jit_sym_char && outMInfo.type != _jit_sym_float32)
+		{ err = JIT_ERR_MISMATCH_TYPE; goto alohamora; }
+
+	cols = outMInfo.dim[0];
+	rows = (outMInfo.dimcount > 1) ? outMInfo.dim[1] : 1;
+
+	// Make sure the cache is big enough
+	if (me->cache == NIL || me->cacheSize < cols * rows) {
+		if (me->cache != NIL)
+			sysmem_freeptr(me->cache);
+
+		me->cache		= (float*) sysmem_newptr(cols * rows * sizeof(float));
+		me->cacheSize	= (me->cache != NIL) ? cols * rows : 0;
+		me->cacheValid	= false;
+		if (me->cache == NIL)
+			{ err = JIT_ERR_OUT_OF_MEM; goto alohamora; }
+		}
+
+	// Decide how much to render
+	GetRenderKey(me, cols, rows, &key);
+	calc.interlace = DriftPlan(	&me->sched, me->c, me->drift, me->interlace,
+								me->cacheValid && SameRenderKey(&key, &me->cacheKey),
+								&calc.phase);
+
+	if (calc.interlace > 0) {
+		me->cacheKey	= key;
+		me->cacheValid	= true;
+
+		calc.me			= me;
+		calc.base		= me->cache;
+		calc.x0			= me->view[0];
+		calc.dx			= (cols > 1) ? (me->view[2] - me->view[0]) / (double) (cols - 1) : 0.0;
+		calc.y0			= me->view[1];
+		calc.dy			= (rows > 1) ? (me->view[3] - me->view[1]) / (double) (rows - 1) : 0.0;
+		calc.bailout2	= me->bailout * me->bailout;
+
+		jit_matrix_info_default(&cacheMInfo);
+		cacheMInfo.type			= _jit_sym_float32;
+		cacheMInfo.planecount	= 1;
+		cacheMInfo.dimcount		= 2;
+		cacheMInfo.dim[0]		= cols;
+		cacheMInfo.dim[1]		= rows;
+		cacheMInfo.dimstride[0]	= sizeof(float);
+		cacheMInfo.dimstride[1]	= cols * sizeof(float);
+		cacheMInfo.size			= cols * rows * sizeof(float);
+
+		jit_parallel_ndim_simplecalc1(	(method) RenderRows, &calc,
+										cacheMInfo.dimcount, cacheMInfo.dim, 1,
+										&cacheMInfo, (char*) me->cache,
+										0);
+		}
+
+	if (outMInfo.type == _jit_sym_char)
+			WriteCharMatrix(me, cols, rows, &outMInfo, outMData);
+	else	WriteFloatMatrix(me, cols, rows, &outMInfo, outMData);
+
+alohamora:
+	jit_object_method(outMatrix, _jit_sym_lock, outSaveLock);
+
+	return err;
+	}
+
+
+/******************************************************************************************
+ *
+ *	JulieJitInit(me)
+ *
+ ******************************************************************************************/
+
+	static t_jit_err JulieGetMode(jcobJulie* me, void* iAttr, long* ioArgC, Atom** ioArgV)
+		{
+		#pragma unused(iAttr)
+
+		if (*ioArgC <= 0 || *ioArgV == NIL) {
+			*ioArgV = (Atom*) getbytes(sizeof(Atom));
+			if (*ioArgV == NIL)
+				return JIT_ERR_OUT_OF_MEM;
+			}
+
+		*ioArgC = 1;
+		AtomSetSym(*ioArgV, gensym((char*) kModeNames[me->mode]));
+
+		return JIT_ERR_NONE;
+		}
+
+	static t_jit_err JulieSetMode(jcobJulie* me, void* iAttr, long iArgC, Atom iArgV[])
+		{
+		#pragma unused(iAttr)
+
+		int i;
+
+		if (iArgC <= 0 || iArgV == NIL || iArgV[0].a_type != A_SYM)
+			return JIT_ERR_INVALID_INPUT;
+
+		for (i = modeLast; i >= modeFirst; i -= 1)
+			if (strcmp(iArgV[0].a_w.w_sym->s_name, kModeNames[i]) == 0) {
+				me->mode = (tMode) i;
+				return JIT_ERR_NONE;
+				}
+
+		error("%s: unknown mode %s", kMaxClassName, iArgV[0].a_w.w_sym->s_name);
+		return JIT_ERR_INVALID_INPUT;
+		}
+
+	// !! convenience type, should move to MaxUtils.h or such
+	typedef t_jit_object* tJitObjPtr;
+
+t_jit_err
+JulieJitInit(void)
+
+	{
+	const long	kAttrRWFlags	= JIT_ATTR_GET_DEFER_LOW | JIT_ATTR_SET_USURP_LOW;
+	const int	kJitterInlets	= 0,	// No inlets for Jitter Matrices
+				kJitterOutlets	= 1;	// One outlet for Jitter Matrices (Julia set)
+
+	tJitObjPtr	mop,
+				attr;
+
+	gJulieJitClass = jit_class_new(	(char*) kJitClassName,
+									(method) JulieJitNew,
+									(method) JulieJitFree,
+									sizeof(jcobJulie),
+									A_CANT, 0L
+									);
+
+	// Add matrix operator
+	mop = jit_object_new(_jit_sym_jit_mop, kJitterInlets, kJitterOutlets);
+	jit_class_addadornment(gJulieJitClass, mop);
+
+	// Add methods
+	jit_class_addmethod(gJulieJitClass,
+						(method) JulieJitMatrixCalc,
+						"matrix_calc",
+						A_CANT, 0L);
+
+	// Add attributes
+		// Offset parameter and viewport
+	attr = jit_object_new(	_jit_sym_jit_attr_offset_array,
+							"c",
+							_jit_sym_float64,
+							2,
+							kAttrRWFlags,
+							(method) NIL, (method) NIL,
+							calcoffset(jcobJulie, cCount),
+							calcoffset(jcobJulie, c)
+							);
+	jit_class_addattr(gJulieJitClass, attr);
+	attr = jit_object_new(	_jit_sym_jit_attr_offset_array,
+							"view",
+							_jit_sym_float64,
+							4,
+							kAttrRWFlags,
+							(method) NIL, (method) NIL,
+							calcoffset(jcobJulie, viewCount),
+							calcoffset(jcobJulie, view)
+							);
+	jit_class_addattr(gJulieJitClass, attr);
+
+		// Coloring
+	attr = jit_object_new(	_jit_sym_jit_attr_offset,
+							"mode",
+							_jit_sym_symbol,
+							kAttrRWFlags,
+							(method) JulieGetMode, (method) JulieSetMode,
+							0
+							);
+	jit_class_addattr(gJulieJitClass, attr);
+	attr = jit_object_new(	_jit_sym_jit_attr_offset_array,
+							"trap",
+							_jit_sym_float64,
+							2,
+							kAttrRWFlags,
+							(method) NIL, (method) NIL,
+							calcoffset(jcobJulie, trapCount),
+							calcoffset(jcobJulie, trap)
+							);
+	jit_class_addattr(gJulieJitClass, attr);
+
+		// Iteration limits
+	attr = jit_object_new(	_jit_sym_jit_attr_offset,
+							"iter",
+							_jit_sym_long,
+							kAttrRWFlags,
+							(method) NIL, (method) NIL,
+							calcoffset(jcobJulie, iter)
+							);
+	jit_attr_addfilterset_clip(attr, 1, 1, true, false);		// Must be positive
+	jit_class_addattr(gJulieJitClass, attr);
+	attr = jit_object_new(	_jit_sym_jit_attr_offset,
+							"bailout",
+							_jit_sym_float64,
+							kAttrRWFlags,
+							(method) NIL, (method) NIL,
+							calcoffset(jcobJulie, bailout)
+							);
+	jit_attr_addfilterset_clip(attr, 2.0, 2.0, true, false);	// Smaller radii miss points
+	jit_class_addattr(gJulieJitClass, attr);
+
+		// Incremental rendering
+	attr = jit_object_new(	_jit_sym_jit_attr_offset,
+							"drift",
+							_jit_sym_float64,
+							kAttrRWFlags,
+							(method) NIL, (method) NIL,
+							calcoffset(jcobJulie, drift)
+							);
+	jit_attr_addfilterset_clip(attr, 0.0, 0.0, true, false);	// Must be non-negative
+	jit_class_addattr(gJulieJitClass, attr);
+	attr = jit_object_new(	_jit_sym_jit_attr_offset,
+							"interlace",
+							_jit_sym_long,
+							kAttrRWFlags,
+							(method) NIL, (method) NIL,
+							calcoffset(jcobJulie, interlace)
+							);
+	jit_attr_addfilterset_clip(attr, 1, 1, true, false);		// Must be positive
+	jit_class_addattr(gJulieJitClass, attr);
+
+	// Register class and go
+	jit_class_register(gJulieJitClass);
+	return JIT_ERR_NONE;
+	}
@@ -0,0 +1,903 @@
+/*
+	File:		lbj.vera.c
+
+	Contains:	Max/Jitter external object rendering bifurcation (orbit density) diagrams
+				of the Verhulst population growth models used by lp.poppy and lp.vera.
+
+	Written by:	Peter Castine
+
+	Copyright:	© 2026 Peter Castine
+
+	Change History (most recent first):
+
+*/
+
+
+/******************************************************************************************
+ ******************************************************************************************/
+
+#pragma mark • Include Files
+
+#include "LitterLib.h"
+#include "TrialPeriodUtils.h"
+#include "MiscUtils.h"
+#include "Verhulst.h"
+
+#include <math.h>
+
+
+#pragma mark • Constants
+
+const char	kMaxClassName[]		= "lbj.vera",			// Class name for Max
+			kJitClassName[]		= "lbj-vera";			// Class name for Jitter
+
+	// Indices for STR# resource
+enum {
+	strIndexInBang		= lpStrIndexLastStandard + 1,
+
+	strIndexOutOrbits,
+	strIndexOutDump,
+
+	strIndexInLeft		= strIndexInBang,
+	strIndexOutLeft		= strIndexOutOrbits
+	};
+
+	// Number of growth rates (matrix columns) iterated in lockstep
+enum {
+	kLanes		= 64
+	};
+
+
+#pragma mark • Object Structure
+
+typedef struct {
+	Object		coreObject;
+	voidPtr		obex;					// The magic extended object thing.
+	} msobVera;							// Mac Shell Object
+
+typedef struct {
+	Object		coreObject;
+
+	tMap		map;
+	tFunction	func;
+
+	long		growthCount,			// Attribute array counts; always 2 after
+				popCount;				// initialization
+	double		growth[2],				// Growth rate at first and last column
+				pop[2],					// Population at bottom and top row
+				seed,
+				beta;					// Only used by veram
+	long		transient,				// Iterations discarded before plotting
+				settle;					// Iterations plotted
+	char		normalize;				// true: scale each column to its densest cell
+
+		// Orbit histogram, one column of counts per growth rate, stored column-major so
+		// that each growth rate owns a contiguous run of memory. Reallocated when the
+		// output matrix changes size.
+	UInt32*		hist;
+	long		histCols,
+				histRows;
+	} jcobVera;							// Jitter Core Object
+
+
+#pragma mark • Global Variables
+
+void*			gVeraJitClass	= NIL;
+Messlist*		gVeraMaxClass	= NIL;
+
+
+#pragma mark • Function Prototypes
+
+	// Max methods/functions
+static void*VeraNewMaxShell	(Symbol*, long, Atom*);
+static void	VeraFreeMaxShell(msobVera*);
+
+static void VeraOutputMatrix(msobVera*);
+static void VeraTattle	(msobVera*);
+static void	VeraAssist	(msobVera*, void* , long , long , char*);
+static void	VeraInfo	(msobVera*);
+
+	// Jitter methods/functions
+static t_jit_err VeraJitInit		(void);
+
+
+#pragma mark -
+/*****************************  I M P L E M E N T A T I O N  ******************************/
+
+#pragma mark • Inline Functions
+
+static inline Byte Unit2Byte(double x)
+	{ return (Byte) (255.0 * x + 0.5); }
+
+
+#pragma mark -
+
+/******************************************************************************************
+ *
+ *	main()
+ *
+ *	Standard Max External Object Entry Point Function
+ *
+ ******************************************************************************************/
+
+void
+main(void)
+
+	{
+	const long kAttr = MAX_JIT_MOP_FLAGS_OWN_OUTPUTMATRIX | MAX_JIT_MOP_FLAGS_OWN_JIT_MATRIX;
+
+	voidPtr	p,									// Have to guess about what these two do
+			q;									// Not much is documented in the Jitter SDK
+
+	LITTER_CHECKTIMEOUT(kMaxClassName);
+	VeraJitInit();
+
+	// Standard Max setup() call
+	setup(	&gVeraMaxClass,					// Pointer to our class definition
+			(method) VeraNewMaxShell,		// Instance creation function
+			(method) VeraFreeMaxShell,		// Custom deallocation function
+			(short) sizeof(msobVera),		// Class object size
+			NIL,							// No menu function
+			A_GIMME,						// Jitter objects always parse their own arguments
+			0);
+
+	// Jitter Magic...
+	p = max_jit_classex_setup(calcoffset(msobVera, obex));
+	q = jit_class_findbyname(gensym((char*) kJitClassName));
+    max_jit_classex_mop_wrap(p, q, kAttr);
+    max_jit_classex_standard_wrap(p, q, 0);
+	LITTER_TIMEBOMB max_addmethod_usurp_low((method) VeraOutputMatrix, "outputmatrix");
+
+	// Back to adding messages...
+	addmess	((method) VeraTattle,	"dblclick",	A_CANT, 0);
+	addmess	((method) VeraTattle,	"tattle",	A_NOTHING);
+	addmess	((method) VeraAssist,	"assist",	A_CANT, 0);
+	addmess	((method) VeraInfo,		"info",		A_CANT, 0);
+
+	// Initialize Litter Library
+	LitterInit(kMaxClassName, 0);
+	}
+
+
+#pragma mark -
+#pragma mark • Internal functions
+
+/******************************************************************************************
+ *
+ *	IterateLanes(iMap, iFunc, iBeta, iLanes, iRate, ioPop)
+ *
+ *	Advances iLanes populations by one growth cycle, each with its own growth rate.
+ *
+ *	The formulas are those in Verhulst.h, evaluated in two passes: first the function
+ *	(or (p+1)^beta for veram) across all lanes, then the growth formula. Both choices are
+ *	made once per call rather than once per lane: each loop passes a constant selector to
+ *	the inline, so each pass is a flat loop over adjacent doubles that the compiler can
+ *	vectorize.
+ *
+ ******************************************************************************************/
+
+static void
+IterateLanes(
+	tMap		iMap,
+	tFunction	iFunc,
+	double		iBeta,
+	long		iLanes,
+	const double iRate[],
+	double		ioPop[])
+
+	{
+	double	fnPop[kLanes];
+	long	k;
+
+	#define LaneLoop(EXPR)		for (k = 0; k < iLanes; k += 1) { EXPR; } break
+	#define FuncLoop(FN)		LaneLoop(fnPop[k] = VerhulstFunc(FN, ioPop[k]))
+	#define GrowthLoop(MAP)		LaneLoop(ioPop[k] = VerhulstGrowth(MAP, ioPop[k], fnPop[k], iRate[k]))
+
+	// Pass 1: f(p)
+	switch (iMap) {
+	case mapPoppy:
+		// No function
+		break;
+
+	case mapVeraM:
+		for (k = 0; k < iLanes; k += 1)
+			fnPop[k] = pow(ioPop[k] + 1.0, iBeta);
+		break;
+
+	default:
+		switch (iFunc) {
+			case fnZero:	FuncLoop(fnZero);
+			case fnOne:		FuncLoop(fnOne);
+			case fnRecip:	FuncLoop(fnRecip);
+			case fnSinPi:	FuncLoop(fnSinPi);
+			case fnCosPi:	FuncLoop(fnCosPi);
+			case fnTanPi:	FuncLoop(fnTanPi);
+			case fnCotPi:	FuncLoop(fnCotPi);
+			case fnSinh:	FuncLoop(fnSinh);
+			case fnCosh:	FuncLoop(fnCosh);
+			case fnTanh:	FuncLoop(fnTanh);
+			case fnLog:		FuncLoop(fnLog);
+			case fnExp:		FuncLoop(fnExp);
+			case fnSqr:		FuncLoop(fnSqr);
+			case fnRoot:	FuncLoop(fnRoot);
+			default:		FuncLoop(fnIdent);
+			}
+		break;
+		}
+
+	// Pass 2: growth formula
+	switch (iMap) {
+		case mapVera:		GrowthLoop(mapVera);
+		case mapVeraPlus:	GrowthLoop(mapVeraPlus);
+		case mapVeraIs:		GrowthLoop(mapVeraIs);
+		case mapVeraL:		GrowthLoop(mapVeraL);
+		case mapVeraS:		GrowthLoop(mapVeraS);
+		case mapVeraM:		GrowthLoop(mapVeraM);
+		default:			GrowthLoop(mapPoppy);
+		}
+
+	#undef GrowthLoop
+	#undef FuncLoop
+	#undef LaneLoop
+	}
+
+
+/******************************************************************************************
+ *
+ *	RenderColumns(me, iDimCount, iDim, iPlaneCount, iHistInfo, ioHist)
+ *
+ *	Worker for jit_parallel_ndim_simplecalc1().
+ *
+ *	The histogram is presented to the parallel machinery as a 2-D matrix with the rows
+ *	of the diagram as dim[0] and the growth rates as dim[1]. Jitter splits work along
+ *	dim[1], so each thread receives a band of whole columns and never touches another
+ *	thread's counts. We recover the first column of the band from the data pointer.
+ *
+ *	Within the band, kLanes adjacent growth rates are iterated together.
+ *
+ ******************************************************************************************/
+
+static void
+RenderColumns(
+	jcobVera*			me,
+	long				iDimCount,
+	long*				iDim,
+	long				iPlaneCount,
+	t_jit_matrix_info*	iHistInfo,
+	char*				ioHist)
+
+	{
+	#pragma unused(iDimCount, iPlaneCount)
+
+	const long		kRows		= iDim[0],
+					kColStride	= iHistInfo->dimstride[1],
+					kFirstCol	= (ioHist - (char*) me->hist) / kColStride,
+					kEndCol		= kFirstCol + iDim[1],
+					kLastCol	= me->histCols - 1;
+	const double	kPopLo		= me->pop[0],
+					kBinScale	= (double) kRows / (me->pop[1] - me->pop[0]),
+					kRateLo		= me->growth[0],
+					kRateStep	= (kLastCol > 0)
+									? (me->growth[1] - me->growth[0]) / (double) kLastCol
+									: 0.0;
+
+	double	rate[kLanes],
+			pop[kLanes];
+	long	col, i, k, n;
+
+	for (col = kFirstCol; col < kEndCol; col += kLanes) {
+		UInt32* hist = (UInt32*) (ioHist + (col - kFirstCol) * kColStride);
+
+		n = kEndCol - col;
+		if (n > kLanes)
+			n = kLanes;
+
+		for (k = 0; k < n; k += 1) {
+			rate[k]	= kRateLo + kRateStep * (double) (col + k);
+			pop[k]	= me->seed;
+			}
+
+		for (i = me->transient; i > 0; i -= 1)
+			IterateLanes(me->map, me->func, me->beta, n, rate, pop);
+
+		for (i = me->settle; i > 0; i -= 1) {
+			IterateLanes(me->map, me->func, me->beta, n, rate, pop);
+
+			for (k = 0; k < n; k += 1) {
+				double bin = (pop[k] - kPopLo) * kBinScale;
+
+				// Written so that NaNs fail the test
+				if (bin >= 0.0 && bin < (double) kRows)
+					hist[k * kRows + (long) bin] += 1;
+				}
+			}
+		}
+
+	}
+
+
+/******************************************************************************************
+ *
+ *	WriteCharMatrix(me, iMInfo, oData)
+ *	WriteFloatMatrix(me, iMInfo, oData)
+ *
+ *	Copy the histogram into the output matrix. The highest population goes at the top
+ *	(row 0), all planes get the same value.
+ *
+ ******************************************************************************************/
+
+	static double ColumnScale(const jcobVera* me, const UInt32 iCol[])
+		{
+		UInt32	peak = 0;
+		long	i;
+
+		if (!me->normalize)
+			return 1.0 / (double) me->settle;
+
+		for (i = 0; i < me->histRows; i += 1)
+			if (peak < iCol[i]) peak = iCol[i];
+
+		return (peak > 0) ? 1.0 / (double) peak : 0.0;
+		}
+
+static void
+WriteCharMatrix(
+	const jcobVera*		me,
+	t_jit_matrix_info*	iMInfo,
+	char*				oData)
+
+	{
+	const long	kRows	= me->histRows,
+				kPlanes	= iMInfo->planecount;
+
+	long	col, row, j;
+
+	for (col = 0; col < me->histCols; col += 1) {
+		const UInt32*	hist	= me->hist + col * kRows;
+		double			scale	= ColumnScale(me, hist);
+		Byte*			out		= (Byte*) oData + col * iMInfo->dimstride[0];
+
+		for (row = kRows - 1; row >= 0; row -= 1) {
+			double	x = scale * (double) hist[row];
+			Byte	b = Unit2Byte(x < 1.0 ? x : 1.0);
+
+			for (j = 0; j < kPlanes; j += 1)
+				out[j] = b;
+			out += iMInfo->dimstride[1];
+			}
+		}
+
+	}
+
+static void
+WriteFloatMatrix(
+	const jcobVera*		me,
+	t_jit_matrix_info*	iMInfo,
+	char*				oData)
+
+	{
+	const long	kRows	= me->histRows,
+				kPlanes	= iMInfo->planecount;
+
+	long	col, row, j;
+
+	for (col = 0; col < me->histCols; col += 1) {
+		const UInt32*	hist	= me->hist + col * kRows;
+		double			scale	= ColumnScale(me, hist);
+		char*			out		= oData + col * iMInfo->dimstride[0];
+
+		for (row = kRows - 1; row >= 0; row -= 1) {
+			float	x = scale * (double) hist[row];
+
+			for (j = 0; j < kPlanes; j += 1)
+				((float*) out)[j] = x;
+			out += iMInfo->dimstride[1];
+			}
+		}
+
+	}
+
+
+/******************************************************************************************
+ *
+ *	SetHistSize(me, iCols, iRows)
+ *
+ ******************************************************************************************/
+
+static t_jit_err
+SetHistSize(
+	jcobVera*	me,
+	long		iCols,
+	long		iRows)
+
+	{
+
+	if (me->hist == NIL || me->histCols * me->histRows < iCols * iRows) {
+		if (me->hist != NIL)
+			sysmem_freeptr(me->hist);
+
+		me->hist = (UInt32*) sysmem_newptr(iCols * iRows * sizeof(UInt32));
+		if (me->hist == NIL) {
+			me->histCols = me->histRows = 0;
+			return JIT_ERR_OUT_OF_MEM;
+			}
+		}
+
+	me->histCols = iCols;
+	me->histRows = iRows;
+
+	return JIT_ERR_NONE;
+	}
+
+
+#pragma mark -
+#pragma mark • Max Shell Methods
+
+/******************************************************************************************
+ *
+ *	VeraNewMaxShell(iSym, iArgC, iArgV)
+ *
+ ******************************************************************************************/
+
+static void*
+VeraNewMaxShell(
+	SymbolPtr	sym,
+	long		iArgC,
+	Atom		iArgV[])
+
+	{
+	#pragma unused(sym)
+
+	msobVera*	me			= NIL;
+	void*		jitObj		= NIL;
+	Symbol*		classSym	= gensym((char*) kJitClassName);
+
+	me = (msobVera*) max_jit_obex_new(gVeraMaxClass, classSym);
+	if (me == NIL) goto punt;
+
+	jitObj = jit_object_new(classSym);
+		if (jitObj == NIL) goto punt;
+
+	max_jit_mop_setup_simple(me, jitObj, iArgC, iArgV);
+	max_jit_attr_args(me, iArgC, iArgV);
+
+	return me;
+	// ------------------------------------------------------------------------
+	// End of normal processing
+
+	// Poor man's exception handling
+punt:
+	error("%s: could not allocate object", kMaxClassName);
+	if (me != NIL)
+		freeobject(&me->coreObject);
+
+	return NIL;
+	}
+
+/******************************************************************************************
+ *
+ *	VeraFreeMaxShell(me)
+ *
+ ******************************************************************************************/
+
+static void
+VeraFreeMaxShell(
+	msobVera* me)
+
+	{
+	max_jit_mop_free(me);
+	jit_object_free(max_jit_obex_jitob_get(me));
+	max_jit_obex_free(me);
+	}
+
+
+/******************************************************************************************
+ *
+ *	VeraOutputMatrix(me)
+ *
+ ******************************************************************************************/
+
+static void
+VeraOutputMatrix(
+	msobVera* me)
+
+	{
+	void*		mop = max_jit_obex_adornment_get(me, _jit_sym_jit_mop);
+	t_jit_err	err = noErr;
+
+	// Sanity check: don't output if mop is NIL
+	if (mop == NIL)
+		return;
+
+	if (max_jit_mop_getoutputmode(me) == 1) {
+		err = (t_jit_err) jit_object_method(
+								max_jit_obex_jitob_get(me),
+								_jit_sym_matrix_calc,
+								jit_object_method(mop, _jit_sym_getinputlist),
+								jit_object_method(mop, _jit_sym_getoutputlist));
+
+		if (err == noErr)
+				max_jit_mop_outputmatrix(me);
+		else	jit_error_code(me, err);
+		}
+
+	}
+
+
+/******************************************************************************************
+ *
+ *	VeraTattle(me)
+ *	VeraInfo(me)
+ *	VeraAssist(me, iBox, iDir, iArgNum, oCStr)
+ *
+ *	Litter responses to standard Max messages
+ *
+ ******************************************************************************************/
+
+void
+VeraTattle(
+	msobVera* me)
+
+	{
+	jcobVera* jitMe = (jcobVera*) max_jit_obex_jitob_get(me);
+
+	post("%s state", kMaxClassName);
+	post("  map: %s", kMapNames[jitMe->map]);
+	if (jitMe->map == mapVeraM)
+		post("  beta: %lf", jitMe->beta);
+	else if (jitMe->map != mapPoppy)
+		post("  function: %s", kFuncNames[jitMe->func]);
+	post("  growth rates %lf to %lf", jitMe->growth[0], jitMe->growth[1]);
+	post("  populations %lf to %lf", jitMe->pop[0], jitMe->pop[1]);
+	post("  seed: %lf", jitMe->seed);
+	post("  %ld transient and %ld plotted iterations", jitMe->transient, jitMe->settle);
+	}
+
+void VeraInfo(msobVera* me)
+	{ LitterInfo(kMaxClassName, &me->coreObject, (method) VeraTattle); }
+
+void VeraAssist(msobVera* me, void* box, long iDir, long iArgNum, char* oCStr)
+	{
+	#pragma unused(me, box)
+
+	LitterAssist(iDir, iArgNum, strIndexInLeft, strIndexOutLeft, oCStr);
+	}
+
+
+#pragma mark -
+#pragma mark • Jitter Methods
+
+/******************************************************************************************
+ *
+ *	VeraJitNew()
+ *	VeraJitFree(me)
+ *
+ ******************************************************************************************/
+
+static jcobVera* VeraJitNew()
+	{
+	jcobVera* me = (jcobVera*) jit_object_alloc(gVeraJitClass);
+
+	me->map			= mapPoppy;
+	me->func		= fnSinPi;						// Same default as lp.vera
+	me->growthCount	= 2;
+	me->growth[0]	= 2.8;
+	me->growth[1]	= 4.0;
+	me->popCount	= 2;
+	me->pop[0]		= 0.0;
+	me->pop[1]		= 1.0;
+	me->seed		= 2.0 / 3.0;
+	me->beta		= 1.0;
+	me->transient	= 256;
+	me->settle		= 256;
+	me->normalize	= true;
+	me->hist		= NIL;
+	me->histCols	= 0;
+	me->histRows	= 0;
+
+	return me;
+	}
+
+static void VeraJitFree(jcobVera* me)
+	{ if (me->hist != NIL) sysmem_freeptr(me->hist); }
+
+
+/******************************************************************************************
+ *
+ *	VeraJitMatrixCalc(me, inputs, outputs)
+ *
+ *	dim[0] of the output matrix is the growth rate axis, dim[1] the population axis.
+ *	Higher dimensions are not used.
+ *
+ ******************************************************************************************/
+
+static t_jit_err
+VeraJitMatrixCalc(
+	jcobVera*	me,
+	void*		inputs,
+	void*		outputs)
+
+	{
+	#pragma unused(inputs)
+
+	t_jit_err			err = JIT_ERR_NONE;
+	long				outSaveLock,
+						cols, rows;
+	t_jit_matrix_info	outMInfo,
+						histMInfo;
+	char*				outMData;
+	void*				outMatrix = jit_object_method(outputs, _jit_sym_getindex, 0);
+
+	// Sanity check
+	if ((me == NIL) || (outMatrix == NIL))
+		return JIT_ERR_INVALID_PTR;
+
+	outSaveLock = (long) jit_object_method(outMatrix, _jit_sym_lock, 1);
+
+	jit_object_method(outMatrix, _jit_sym_getinfo, &outMInfo);
+	jit_object_method(outMatrix, _jit_sym_getdata, &outMData);
+
+	if (outMData == NIL)
+		{ err = JIT_ERR_INVALID_OUTPUT; goto alohamora; }
+	if (outMInfo.type != _jit_sym_char && outMInfo.type != _jit_sym_float32)
+		{ err = JIT_ERR_MISMATCH_TYPE; goto alohamora; }
+	if (me->pop[1] <= me->pop[0] || me->settle <= 0)
+		{ err = JIT_ERR_INVALID_INPUT; goto alohamora; }
+
+	cols = outMInfo.dim[0];
+	rows = (outMInfo.dimcount > 1) ? outMInfo.dim[1] : 1;
+
+	err = SetHistSize(me, cols, rows);
+	if (err != JIT_ERR_NONE)
+		goto alohamora;
+
+	// Describe the histogram as a column-major matrix of counts so the parallel
+	// machinery splits it between growth rates (see RenderColumns()).
+	jit_matrix_info_default(&histMInfo);
+	histMInfo.type			= _jit_sym_long;
+	histMInfo.planecount	= 1;
+	histMInfo.dimcount		= 2;
+	histMInfo.dim[0]		= rows;
+	histMInfo.dim[1]		= cols;
+	histMInfo.dimstride[0]	= sizeof(UInt32);
+	histMInfo.dimstride[1]	= rows * sizeof(UInt32);
+	histMInfo.size			= cols * rows * sizeof(UInt32);
+
+	memset(me->hist, 0, cols * rows * sizeof(UInt32));
+
+	jit_parallel_ndim_simplecalc1(	(method) RenderColumns, me,
+									histMInfo.dimcount, histMInfo.dim, 1,
+									&histMInfo, (char*) me->hist,
+									0);
+
+	if (outMInfo.type == _jit_sym_char)
+			WriteCharMatrix(me, &outMInfo, outMData);
+	else	WriteFloatMatrix(me, &outMInfo, outMData);
+
+alohamora:
+	jit_object_method(outMatrix, _jit_sym_lock, outSaveLock);
+
+	return err;
+	}
+
+
+/******************************************************************************************
+ *
+ *	VeraJitInit(me)
+ *
+ ******************************************************************************************/
+
+	static t_jit_err VeraGetSym(long* ioArgC, Atom** ioArgV, const char* iName)
+		{
+		if (*ioArgC <= 0 || *ioArgV == NIL) {
+			*ioArgV = (Atom*) getbytes(sizeof(Atom));
+			if (*ioArgV == NIL)
+				return JIT_ERR_OUT_OF_MEM;
+			}
+
+		*ioArgC = 1;
+		AtomSetSym(*ioArgV, gensym((char*) iName));
+
+		return JIT_ERR_NONE;
+		}
+
+	static t_jit_err VeraGetMap(jcobVera* me, void* iAttr, long* ioArgC, Atom** ioArgV)
+		{
+		#pragma unused(iAttr)
+		return VeraGetSym(ioArgC, ioArgV, kMapNames[me->map]);
+		}
+
+	static t_jit_err VeraGetFunc(jcobVera* me, void* iAttr, long* ioArgC, Atom** ioArgV)
+		{
+		#pragma unused(iAttr)
+		return VeraGetSym(ioArgC, ioArgV, kFuncNames[me->func]);
+		}
+
+	static t_jit_err VeraSetMap(jcobVera* me, void* iAttr, long iArgC, Atom iArgV[])
+		{
+		#pragma unused(iAttr)
+
+		int i;
+
+		if (iArgC <= 0 || iArgV == NIL || iArgV[0].a_type != A_SYM)
+			return JIT_ERR_INVALID_INPUT;
+
+		for (i = mapLast; i >= mapFirst; i -= 1)
+			if (strcmp(iArgV[0].a_w.w_sym->s_name, kMapNames[i]) == 0) {
+				me->map = (tMap) i;
+				return JIT_ERR_NONE;
+				}
+
+		error("%s: unknown map %s", kMaxClassName, iArgV[0].a_w.w_sym->s_name);
+		return JIT_ERR_INVALID_INPUT;
+		}
+
+	static t_jit_err VeraSetFunc(jcobVera* me, void* iAttr, long iArgC, Atom iArgV[])
+		{
+		#pragma unused(iAttr)
+
+		int i;
+
+		if (iArgC <= 0 || iArgV == NIL || iArgV[0].a_type != A_SYM)
+			return JIT_ERR_INVALID_INPUT;
+
+		for (i = fnLast; i >= fnFirst; i -= 1)
+			if (strcmp(iArgV[0].a_w.w_sym->s_name, kFuncNames[i]) == 0) {
+				me->func = (tFunction) i;
+				return JIT_ERR_NONE;
+				}
+
+		error("%s: unknown function %s", kMaxClassName, iArgV[0].a_w.w_sym->s_name);
+		return JIT_ERR_INVALID_INPUT;
+		}
+
+	// The two ranges are [lo hi] pairs. A single value only moves the low end.
+	static t_jit_err SetRange(double oRange[], long iArgC, Atom iArgV[])
+		{
+		if (iArgC <= 0 || iArgV == NIL)
+			return JIT_ERR_INVALID_INPUT;
+
+		oRange[0] = AtomGetFloat(&iArgV[0]);
+		if (iArgC > 1)
+			oRange[1] = AtomGetFloat(&iArgV[1]);
+
+		return JIT_ERR_NONE;
+		}
+
+	static t_jit_err VeraSetGrowth(jcobVera* me, void* iAttr, long iArgC, Atom iArgV[])
+		{
+		#pragma unused(iAttr)
+		return SetRange(me->growth, iArgC, iArgV);
+		}
+
+	static t_jit_err VeraSetPop(jcobVera* me, void* iAttr, long iArgC, Atom iArgV[])
+		{
+		#pragma unused(iAttr)
+		return SetRange(me->pop, iArgC, iArgV);
+		}
+
+	// !! convenience type, should move to MaxUtils.h or such
+	typedef t_jit_object* tJitObjPtr;
+
+t_jit_err
+VeraJitInit(void)
+
+	{
+	const long	kAttrRWFlags	= JIT_ATTR_GET_DEFER_LOW | JIT_ATTR_SET_USURP_LOW;
+	const int	kJitterInlets	= 0,	// No inlets for Jitter Matrices
+				kJitterOutlets	= 1;	// One outlet for Jitter Matrices (orbit densities)
+
+	tJitObjPtr	mop,
+				attr;
+
+	gVeraJitClass = jit_class_new(	(char*) kJitClassName,
+									(method) VeraJitNew,
+									(method) VeraJitFree,
+									sizeof(jcobVera),
+									A_CANT, 0L
+									);
+
+	// Add matrix operator
+	mop = jit_object_new(_jit_sym_jit_mop, kJitterInlets, kJitterOutlets);
+	jit_class_addadornment(gVeraJitClass, mop);
+
+	// Add methods
+	jit_class_addmethod(gVeraJitClass,
+						(method) VeraJitMatrixCalc,
+						"matrix_calc",
+						A_CANT, 0L);
+
+	// Add attributes
+		// Map and function
+	attr = jit_object_new(	_jit_sym_jit_attr_offset,
+							"map",
+							_jit_sym_symbol,
+							kAttrRWFlags,
+							(method) VeraGetMap, (method) VeraSetMap,
+							0
+							);
+	jit_class_addattr(gVeraJitClass, attr);
+	attr = jit_object_new(	_jit_sym_jit_attr_offset,
+							"func",
+							_jit_sym_symbol,
+							kAttrRWFlags,
+							(method) VeraGetFunc, (method) VeraSetFunc,
+							0
+							);
+	jit_class_addattr(gVeraJitClass, attr);
+
+		// Ranges
+	attr = jit_object_new(	_jit_sym_jit_attr_offset_array,
+							"growth",
+							_jit_sym_float64,
+							2,
+							kAttrRWFlags,
+							(method) NIL, (method) VeraSetGrowth,
+							calcoffset(jcobVera, growthCount),
+							calcoffset(jcobVera, growth)
+							);
+	jit_class_addattr(gVeraJitClass, attr);
+	attr = jit_object_new(	_jit_sym_jit_attr_offset_array,
+							"pop",
+							_jit_sym_float64,
+							2,
+							kAttrRWFlags,
+							(method) NIL, (method) VeraSetPop,
+							calcoffset(jcobVera, popCount),
+							calcoffset(jcobVera, pop)
+							);
+	jit_class_addattr(gVeraJitClass, attr);
+
+		// Seed and beta
+	attr = jit_object_new(	_jit_sym_jit_attr_offset,
+							"seed",
+							_jit_sym_float64,
+							kAttrRWFlags,
+							(method) NIL, (method) NIL,
+							calcoffset(jcobVera, seed)
+							);
+	jit_class_addattr(gVeraJitClass, attr);
+	attr = jit_object_new(	_jit_sym_jit_attr_offset,
+							"beta",
+							_jit_sym_float64,
+							kAttrRWFlags,
+							(method) NIL, (method) NIL,
+							calcoffset(jcobVera, beta)
+							);
+	jit_class_addattr(gVeraJitClass, attr);
+
+		// Iteration counts
+	attr = jit_object_new(	_jit_sym_jit_attr_offset,
+							"transient",
+							_jit_sym_long,
+							kAttrRWFlags,
+							(method) NIL, (method) NIL,
+							calcoffset(jcobVera, transient)
+							);
+	jit_attr_addfilterset_clip(attr, 0, 0, true, false);		// Must be non-negative
+	jit_class_addattr(gVeraJitClass, attr);
+	attr = jit_object_new(	_jit_sym_jit_attr_offset,
+							"settle",
+							_jit_sym_long,
+							kAttrRWFlags,
+							(method) NIL, (method) NIL,
+							calcoffset(jcobVera, settle)
+							);
+	jit_attr_addfilterset_clip(attr, 1, 1, true, false);		// Must be positive
+	jit_class_addattr(gVeraJitClass, attr);
+
+		// Normalization
+	attr = jit_object_new(	_jit_sym_jit_attr_offset,
+							"normalize",
+							_jit_sym_char,
+							kAttrRWFlags,
+							(method) NIL, (method) NIL,
+							calcoffset(jcobVera, normalize)
+							);
+	jit_attr_addfilterset_clip(attr, 0, 1, true, true);			// Only allow canonical true settings
+	jit_class_addattr(gVeraJitClass, attr);
+
+	// Register class and go
+	jit_class_register(gVeraJitClass);
+	return JIT_ERR_NONE;
+	}
@@ -0,0 +1,318 @@
+/*
+	File:		DrawUtils.c
+
+	Contains:	Bulk output of random deviates: the "draw" message shared by the scalar
+				Litter RNG objects.
+
+	Written by:	Peter Castine
+
+	Copyright:	© 2026 Peter Castine
+
+	Change History (most recent first):
+
+*/
+
+
+/******************************************************************************************
+ ******************************************************************************************/
+
+#pragma mark • Include Files
+
+#include "DrawUtils.h"
+#include "buffer.h"
+
+
+#pragma mark • Constants
+
+
+
+#pragma mark • Type Definitions
+
+
+
+#pragma mark • Global Variables
+
+
+
+#pragma mark -
+/*****************************  I M P L E M E N T A T I O N  ******************************/
+
+#pragma mark • Private Functions
+
+	// Anything that had to wait for low priority is simply sent again
+	static void DeferredDraw(Object* me, Symbol* iSel, short iArgC, Atom iArgV[])
+		{ typedmess(me, iSel, iArgC, iArgV); }
+
+	static t_buffer* FindBuffer(Symbol* iSym)
+		{
+		t_buffer* buf = (t_buffer*) iSym->s_thing;
+
+		if (buf == NIL || ob_sym(buf) != gensym("buffer~") || !buf->b_valid)
+			return NIL;
+
+		return buf;
+		}
+
+/******************************************************************************************
+ *
+ *	DrawTarget(me, iCount, iDest, iFloatFunc, iLongFunc)
+ *
+ *	Write deviates straight into a buffer~ or table. One and only one of the generator
+ *	functions is non-NIL.
+ *
+ *	Buffer~ samples are interleaved, so the whole buffer (all channels) is treated as one
+ *	array. Integer deviates are simply converted to float; floating point deviates going
+ *	to a table are rounded to the nearest integer. A count of zero (or more than the
+ *	target holds) fills the whole target.
+ *
+ *	While we write, the buffer~ is flagged in use (the same save/restore of b_inuse that
+ *	the SDK's index~ example uses), and afterwards it is told that it is dirty, so
+ *	waveform~ displays and the like are redrawn.
+ *
+ ******************************************************************************************/
+
+static void
+DrawTarget(
+	Object*			me,
+	long			iCount,
+	Symbol*			iDest,
+	tDrawFloatFunc	iFloatFunc,
+	tDrawLongFunc	iLongFunc)
+
+	{
+	t_buffer*	buf		= FindBuffer(iDest);
+	float*		samples	= NIL;
+	long*		cells	= NIL;
+	long**		tableData;
+	long		size,
+				i,
+				inuseState	= false;
+
+	if (buf != NIL) {
+		inuseState		= buf->b_inuse;
+		buf->b_inuse	= true;
+		samples			= buf->b_samples;
+		size			= buf->b_frames * buf->b_nchans;
+		}
+	else if (table_get(iDest, &tableData, &size) == 0)
+		cells = *tableData;
+	else {
+		error("%s: no buffer~ or table %s", ob_sym(me)->s_name, iDest->s_name);
+		return;
+		}
+
+	if (iCount <= 0 || iCount > size)
+		iCount = size;
+
+	for (i = 0; i < iCount; i += kDrawChunk) {
+		long	n = iCount - i,
+				j;
+
+		if (n > kDrawChunk)
+			n = kDrawChunk;
+
+		if (iFloatFunc != NIL) {
+			double vals[kDrawChunk];
+
+			iFloatFunc(me, vals, n);
+			if (samples != NIL)
+				for (j = 0; j < n; j += 1) samples[i + j] = vals[j];
+			else for (j = 0; j < n; j += 1) cells[i + j] = (long) floor(vals[j] + 0.5);
+			}
+		else {
+			long vals[kDrawChunk];
+
+			iLongFunc(me, vals, n);
+			if (samples != NIL)
+				for (j = 0; j < n; j += 1) samples[i + j] = vals[j];
+			else for (j = 0; j < n; j += 1) cells[i + j] = vals[j];
+			}
+		}
+
+	if (buf != NIL) {
+		buf->b_inuse = inuseState;
+		object_method(buf, gensym("dirty"));
+		}
+	else table_dirty(iDest);
+	}
+
+	static Boolean HasTarget(Symbol* iDest)
+		{ return iDest != NIL && iDest != gensym(""); }
+
+	static Boolean ReserveDraw(Object* me, tDrawBufPtr ioBuf, long iCount)
+		{
+		Atom countAtom;
+
+		AtomSetLong(&countAtom, iCount);
+
+		return DrawReserve(me, ioBuf, iCount, gensym("draw"), 1, &countAtom);
+		}
+
+
+#pragma mark -
+#pragma mark • Public Functions
+
+/******************************************************************************************
+ *
+ *	DrawInit(oBuf)
+ *	DrawFree(ioBuf)
+ *	DrawReserve(me, ioBuf, iCount, iSel, iArgC, iArgV)
+ *
+ *	Housekeeping for the atoms used by the list output.
+ *
+ *	DrawReserve() makes sure there are at least iCount atoms. Memory is never allocated
+ *	at interrupt level: in that case the message (iSel with its arguments) is deferred
+ *	and sent to the object again at low priority, and DrawReserve() returns false. It
+ *	also returns false, after posting an error, if the Memory Manager lets us down.
+ *
+ ******************************************************************************************/
+
+void
+DrawInit(
+	tDrawBufPtr oBuf)
+
+	{
+	oBuf->atoms	= NIL;
+	oBuf->size	= 0;
+	}
+
+void
+DrawFree(
+	tDrawBufPtr ioBuf)
+
+	{
+	if (ioBuf->atoms != NIL)
+		DisposePtr((Ptr) ioBuf->atoms);
+	DrawInit(ioBuf);
+	}
+
+Boolean
+DrawReserve(
+	Object*		me,
+	tDrawBufPtr	ioBuf,
+	long		iCount,
+	Symbol*		iSel,
+	short		iArgC,
+	Atom		iArgV[])
+
+	{
+	Atom* newBuf;
+
+	if (iCount <= ioBuf->size)
+		return true;
+
+	if (isr()) {
+		defer(me, (method) DeferredDraw, iSel, iArgC, iArgV);
+		return false;
+		}
+
+	newBuf = (Atom*) NewPtr(iCount * sizeof(Atom));
+	if (newBuf == NIL) {
+		error("%s: can't allocate memory for %ld element list", ob_sym(me)->s_name, iCount);
+		return false;
+		}
+
+	if (ioBuf->atoms != NIL)
+		DisposePtr((Ptr) ioBuf->atoms);
+	ioBuf->atoms	= newBuf;
+	ioBuf->size		= iCount;
+
+	return true;
+	}
+
+
+/******************************************************************************************
+ *
+ *	DrawFloats(me, ioBuf, iOutlet, iCount, iDest, iFunc)
+ *	DrawLongs(me, ioBuf, iOutlet, iCount, iDest, iFunc)
+ *
+ *	The body of every "draw" message: iCount deviates from iFunc, sent out iOutlet as a
+ *	single list or, if iDest names a buffer~ or table, written straight into that.
+ *
+ *	Lists are limited to kDrawMaxList elements.
+ *
+ ******************************************************************************************/
+
+void
+DrawFloats(
+	Object*			me,
+	tDrawBufPtr		ioBuf,
+	tOutletPtr		iOutlet,
+	long			iCount,
+	Symbol*			iDest,
+	tDrawFloatFunc	iFunc)
+
+	{
+	Atom*	atoms;
+	long	i;
+
+	if (HasTarget(iDest)) {
+		DrawTarget(me, iCount, iDest, iFunc, NIL);
+		return;
+		}
+
+	if (iCount <= 0)
+		return;
+	if (iCount > kDrawMaxList)
+		iCount = kDrawMaxList;
+	if (!ReserveDraw(me, ioBuf, iCount))
+		return;
+
+	atoms = ioBuf->atoms;
+	for (i = 0; i < iCount; i += kDrawChunk) {
+		double	vals[kDrawChunk];
+		long	n = iCount - i,
+				j;
+
+		if (n > kDrawChunk)
+			n = kDrawChunk;
+
+		iFunc(me, vals, n);
+		for (j = 0; j < n; j += 1)
+			AtomSetFloat(&atoms[i + j], vals[j]);
+		}
+
+	outlet_list(iOutlet, NIL, (short) iCount, atoms);
+	}
+
+void
+DrawLongs(
+	Object*			me,
+	tDrawBufPtr		ioBuf,
+	tOutletPtr		iOutlet,
+	long			iCount,
+	Symbol*			iDest,
+	tDrawLongFunc	iFunc)
+
+	{
+	Atom*	atoms;
+	long	i;
+
+	if (HasTarget(iDest)) {
+		DrawTarget(me, iCount, iDest, NIL, iFunc);
+		return;
+		}
+
+	if (iCount <= 0)
+		return;
+	if (iCount > kDrawMaxList)
+		iCount = kDrawMaxList;
+	if (!ReserveDraw(me, ioBuf, iCount))
+		return;
+
+	atoms = ioBuf->atoms;
+	for (i = 0; i < iCount; i += kDrawChunk) {
+		long	vals[kDrawChunk],
+				n = iCount - i,
+				j;
+
+		if (n > kDrawChunk)
+			n = kDrawChunk;
+
+		iFunc(me, vals, n);
+		for (j = 0; j < n; j += 1)
+			AtomSetLong(&atoms[i + j], vals[j]);
+		}
+
+	outlet_list(iOutlet, NIL, (short) iCount, atoms);
+	}
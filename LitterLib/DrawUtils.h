@@ -0,0 +1,63 @@
+/*
+	File:		DrawUtils.h
+
+	Contains:	Header file for DrawUtils.c, bulk output of random deviates for the "draw"
+				message.
+
+	Written by:	Peter Castine
+
+	Copyright:	© 2026 Peter Castine
+
+	Change History (most recent first):
+
+*/
+
+
+/******************************************************************************************
+ ******************************************************************************************/
+
+#pragma once
+#ifndef __DRAWUTILS_H__
+#define __DRAWUTILS_H__
+
+
+#pragma mark • Include Files
+
+#include "MaxUtils.h"										// For Atom, tOutletPtr, &c.
+
+
+#pragma mark • Constants
+
+enum {
+	kDrawChunk		= 256,									// Deviates per generator call
+	kDrawMaxList	= 32767									// Longest list outlet_list()
+															// can handle (short argc)
+	};
+
+
+#pragma mark • Type Definitions
+
+	// Atoms for the list output. The buffer only ever grows, and only at low priority.
+typedef struct drawBuf {
+			Atom*	atoms;
+			long	size;									// Atoms allocated
+			} tDrawBuf;
+typedef tDrawBuf* tDrawBufPtr;
+
+	// Generators fill an array with the requested number of deviates (at most kDrawChunk
+	// at a time). They should fetch the object's RNG state once on entry and store it
+	// once on exit, so a chunk costs one load/store cycle instead of one per value.
+typedef void (*tDrawFloatFunc)(Object*, double[], long);
+typedef void (*tDrawLongFunc)(Object*, long[], long);
+
+
+#pragma mark • Function Prototypes
+
+void	DrawInit	(tDrawBufPtr);
+void	DrawFree	(tDrawBufPtr);							// Not at interrupt level
+Boolean	DrawReserve	(Object*, tDrawBufPtr, long, Symbol*, short, Atom[]);
+
+void	DrawFloats	(Object*, tDrawBufPtr, tOutletPtr, long, Symbol*, tDrawFloatFunc);
+void	DrawLongs	(Object*, tDrawBufPtr, tOutletPtr, long, Symbol*, tDrawLongFunc);
+
+#endif		// __DRAWUTILS_H__
@@ -0,0 +1,250 @@
+/*
+	File:		FastMath.h
+
+	Contains:	Inline, branch-free replacements for log(), exp(), pow() and tan() for
+				use in the inner loops of inverse-CDF generators.
+
+	Written by:	Peter Castine
+
+	Copyright:	© 2026 Peter Castine
+
+	Change History (most recent first):
+
+*/
+
+
+/******************************************************************************************
+ ******************************************************************************************/
+
+#pragma once
+#ifndef __FASTMATH_H__
+#define __FASTMATH_H__
+
+
+#pragma mark • Include Files
+
+#ifndef __MACTYPES__
+	#include <MacTypes.h>									// For UInt64
+#endif
+
+#include <math.h>
+
+
+/******************************************************************************************
+ *
+ *	The functions below are built from the kernels of Sun's fdlibm (the polynomials for
+ *	log, exp, sin and cos, with their coefficients), but all special-case branches have
+ *	been stripped out and the argument reduction is done with integer operations on the
+ *	bit pattern. That leaves straight-line code that the compiler can inline into a loop
+ *	over an array and, on vector hardware, evaluate several values at a time. Calling
+ *	libm once per variate prevents both.
+ *
+ *	The price is a restricted domain. Inputs outside the domains listed here give
+ *	finite but meaningless results instead of NaN, infinity or errno.
+ *
+ *	Errors, measured against long double over 10^7 random arguments in each domain:
+ *
+ *		FastLog(x)		x > 0, normal				≤ 1 ULP
+ *						x == 0						returns -709.09 (not -inf)
+ *		FastExp(x)		|x| ≤ 708					≤ 1 ULP
+ *						otherwise the argument is clamped to ±708
+ *		FastPow(x, y)	x > 0, |y·ln x| ≤ 708		≤ 1 + 2|y·ln x| ULP
+ *						(exp(y·log(x)); the rounding of the product is scaled up by
+ *						exp, so the bound grows with the magnitude of the result's
+ *						logarithm. For results between 2^-20 and 2^20 we measured
+ *						≤ 20 ULP, with a mean below 1 ULP)
+ *		FastTanPi(x)	tan(pi·x), |x| < 2^50		≤ 4 ULP
+ *		FastCotPi(x)	1/tan(pi·x), |x| < 2^50		≤ 4 ULP
+ *
+ *	Only double precision is provided; none of this relies on the FPU rounding mode
+ *	other than the default round-to-nearest.
+ *
+ ******************************************************************************************/
+
+
+#pragma mark • Constants
+
+static const double	kFMLn2Hi		= 6.93147180369123816490e-01,	// 0x3fe62e42fee00000
+					kFMLn2Lo		= 1.90821492927058770002e-10,	// 0x3dea39ef35793c76
+					kFMInvLn2		= 1.44269504088896338700e+00,
+					kFMPi			= 3.14159265358979311600e+00,
+					kFMRoundMagic	= 6755399441055744.0;			// 1.5 · 2^52
+
+static const SInt64	kFMExpLimitBits	= 0x4086200000000000LL;			// 708.0
+
+
+#pragma mark • Type Definitions
+
+typedef union {
+			double	d;
+			UInt64	u;
+			} uFMBits;
+
+
+#pragma mark -
+#pragma mark • Inline Functions
+
+static inline UInt64 FMDoubleBits(double x)
+	{ uFMBits b; b.d = x; return b.u; }
+
+static inline double FMBitsDouble(UInt64 x)
+	{ uFMBits b; b.u = x; return b.d; }
+
+
+/******************************************************************************************
+ *
+ *	FastLog(x)
+ *
+ *	x = 2^k · m with sqrt(1/2) ≤ m < sqrt(2), found by adding an offset to the bit
+ *	pattern so that the exponent field rolls over at sqrt(2) rather than 2. Then
+ *	log(m) = 2·atanh(s), s = (m-1)/(m+1), as in fdlibm's e_log.c. k is converted to
+ *	double by splicing it into the mantissa of 2^52, avoiding an int-to-float conversion
+ *	that most vector units can't do for 64-bit integers.
+ *
+ ******************************************************************************************/
+
+static inline double
+FastLog(
+	double x)
+
+	{
+	const double	kLg1 = 6.666666666666735130e-01,
+					kLg2 = 3.999999999940941908e-01,
+					kLg3 = 2.857142874366239149e-01,
+					kLg4 = 2.222219843214978396e-01,
+					kLg5 = 1.818357216161805012e-01,
+					kLg6 = 1.531383769920937332e-01,
+					kLg7 = 1.479819860511658591e-01;
+
+	UInt64	bits	= FMDoubleBits(x) + 0x00095f6200000000ULL;		// 0x3ff00000 - 0x3fe6a09e
+	double	k		= FMBitsDouble((bits >> 52) | 0x4330000000000000ULL)
+						- (4503599627370496.0 + 1023.0),
+			f		= FMBitsDouble((bits & 0x000fffffffffffffULL) + 0x3fe6a09e00000000ULL)
+						- 1.0,
+			hfsq	= 0.5 * f * f,
+			s		= f / (2.0 + f),
+			z		= s * s,
+			w		= z * z,
+			r		= z * (kLg1 + w * (kLg3 + w * (kLg5 + w * kLg7)))
+						+ w * (kLg2 + w * (kLg4 + w * kLg6));
+
+	return s * (hfsq + r) + k * kFMLn2Lo - hfsq + f + k * kFMLn2Hi;
+	}
+
+
+/******************************************************************************************
+ *
+ *	FastExp(x)
+ *
+ *	exp(x) = 2^k · exp(r), k = round(x/ln 2), |r| ≤ ln(2)/2, with fdlibm's rational
+ *	approximation for exp(r). Rounding uses the 1.5·2^52 trick, which leaves k in the low
+ *	bits of the sum; shifting those up into the exponent field builds 2^k directly.
+ *
+ *	The argument is clamped on its bit pattern. A floating-point comparison can raise an
+ *	exception, so a compiler respecting IEEE traps won't if-convert it and the loop
+ *	around us would no longer vectorize. An integer comparison has no such problem.
+ *
+ ******************************************************************************************/
+
+static inline double
+FastExp(
+	double x)
+
+	{
+	const double	kP1 =  1.66666666666666019037e-01,
+					kP2 = -2.77777777770155933842e-03,
+					kP3 =  6.61375632143793436117e-05,
+					kP4 = -1.65339022054652515390e-06,
+					kP5 =  4.13813679705723846039e-08;
+
+	UInt64	bits	= FMDoubleBits(x);
+	SInt64	mag		= bits & 0x7fffffffffffffffULL;
+	double	kd, k, hi, lo, r, rr, c, y;
+
+	mag	= (mag > kFMExpLimitBits) ? kFMExpLimitBits : mag;
+	x	= FMBitsDouble(mag | (bits & 0x8000000000000000ULL));
+
+	kd	= x * kFMInvLn2 + kFMRoundMagic;
+	k	= kd - kFMRoundMagic;
+	hi	= x - k * kFMLn2Hi;
+	lo	= k * kFMLn2Lo;
+	r	= hi - lo;
+	rr	= r * r;
+	c	= r - rr * (kP1 + rr * (kP2 + rr * (kP3 + rr * (kP4 + rr * kP5))));
+	y	= 1.0 - ((lo - (r * c) / (2.0 - c)) - hi);
+
+	return y * FMBitsDouble((FMDoubleBits(kd) + 1023) << 52);
+	}
+
+
+/******************************************************************************************
+ *
+ *	FastPow(x, y)
+ *
+ *	Just exp(y·log(x)), for x > 0. See the error bound above.
+ *
+ ******************************************************************************************/
+
+static inline double FastPow(double x, double y)
+	{ return FastExp(y * FastLog(x)); }
+
+
+/******************************************************************************************
+ *
+ *	FastTanPi(x)
+ *	FastCotPi(x)
+ *
+ *	Arguments are in units of pi, which is what inversion formulae want anyway and makes
+ *	range reduction exact: x = n/2 + r, |r| ≤ 1/4. With s = sin(pi·r) and c = cos(pi·r)
+ *	from the fdlibm kernels, tan(pi·x) is s/c for even n and -c/s for odd n.
+ *
+ ******************************************************************************************/
+
+	static inline void FMSinCosPi(double x, double* oNum, double* oDen)
+		{
+		const double	kS1 = -1.66666666666666324348e-01,
+						kS2 =  8.33333333332248946124e-03,
+						kS3 = -1.98412698298579493134e-04,
+						kS4 =  2.75573137070700676789e-06,
+						kS5 = -2.50507602534068634195e-08,
+						kS6 =  1.58969099521155010221e-10,
+						kC1 =  4.16666666666666019037e-02,
+						kC2 = -1.38888888888741095749e-03,
+						kC3 =  2.48015872894767294178e-05,
+						kC4 = -2.75573143513906633035e-07,
+						kC5 =  2.08757232129817482790e-09,
+						kC6 = -1.13596475577881948265e-11;
+
+		double	nd		= (x + x) + kFMRoundMagic,
+				n		= nd - kFMRoundMagic,
+				a		= kFMPi * (x - 0.5 * n),
+				z		= a * a,
+				w		= z * z,
+				hz		= 0.5 * z,
+				s		= a + z * a * (kS1 + z * (kS2 + z * (kS3 + z * (kS4 + z * (kS5 + z * kS6))))),
+				c0		= 1.0 - hz,
+				c		= c0 + (((1.0 - c0) - hz)
+							+ z * (z * (kC1 + z * (kC2 + z * kC3)) + w * w * (kC4 + z * (kC5 + z * kC6))));
+		Boolean	odd		= (FMDoubleBits(nd) & 0x01) != 0;
+
+		*oNum = odd ? -c : s;
+		*oDen = odd ? s : c;
+		}
+
+static inline double FastTanPi(double x)
+	{
+	double num, den;
+
+	FMSinCosPi(x, &num, &den);
+	return num / den;
+	}
+
+static inline double FastCotPi(double x)
+	{
+	double num, den;
+
+	FMSinCosPi(x, &num, &den);
+	return den / num;
+	}
+
+#endif		// __FASTMATH_H__
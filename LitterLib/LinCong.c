@@ -0,0 +1,203 @@
+/*
+	File:		LinCong.c
+
+	Contains:	Linear congruence kernels: block generation and jump-ahead.
+
+	Written by:	Peter Castine
+
+	Copyright:	© 2026 Peter Castine
+
+	Change History (most recent first):
+
+*/
+
+
+/******************************************************************************************
+ ******************************************************************************************/
+
+#pragma mark • Include Files
+
+#include "LinCong.h"
+#include "MiscUtils.h"
+
+
+#pragma mark • Constants
+
+
+
+#pragma mark • Type Definitions
+
+
+
+#pragma mark • Global Variables
+
+
+
+#pragma mark -
+/*****************************  I M P L E M E N T A T I O N  ******************************/
+
+#pragma mark • Public Functions
+
+/******************************************************************************************
+ *
+ *	LinCongSetup(oLC, iMul, iAdd, iMod)
+ *
+ *	Precalculate everything the kernels need for the recurrence x' = (iMul * x + iAdd)
+ *	mod iMod. As everywhere else in Litter, a modulus of 0 stands for 2^32.
+ *
+ *	Intermediate products are held in 64 bits, so the recurrence is exact for any 32-bit
+ *	multiplier, adder, and modulus (the non-power-of-two moduli used to be reduced after
+ *	the product had already been truncated to 32 bits).
+ *
+ ******************************************************************************************/
+
+void
+LinCongSetup(
+	tLinCongPtr	oLC,
+	UInt32		iMul,
+	UInt32		iAdd,
+	UInt32		iMod)
+
+	{
+	UInt32	mul,
+			add;
+	int		j;
+
+	oLC->mul	= iMul;
+	oLC->add	= iAdd;
+	oLC->mod	= iMod;
+
+	if (iMod == 0) {
+		oLC->modMask	= kULongMax;
+		oLC->barrett	= 0;
+		mul				= iMul;
+		add				= iAdd;
+		}
+	else if (iMod > 1 && (iMod & (iMod - 1)) == 0) {
+		oLC->modMask	= iMod - 1;
+		oLC->barrett	= 0;
+		mul				= iMul & oLC->modMask;
+		add				= iAdd & oLC->modMask;
+		}
+	else {
+		oLC->modMask	= 0;
+		oLC->barrett	= ~((UInt64) 0) / iMod;
+		mul				= iMul % iMod;
+		add				= iAdd % iMod;
+		}
+
+	// Lane j takes x straight to its (j+1)th successor:
+	//	x(j+1) = mul * x(j) + add
+	//		   = mul * (laneMul[j-1] * x + laneAdd[j-1]) + add
+	oLC->laneMul[0] = mul;
+	oLC->laneAdd[0] = add;
+	for (j = 1; j < kLinCongLanes; j += 1) {
+		oLC->laneMul[j] = LinCongMulAdd(oLC, mul, oLC->laneMul[j-1], 0);
+		oLC->laneAdd[j] = LinCongMulAdd(oLC, mul, oLC->laneAdd[j-1], add);
+		}
+
+	}
+
+
+/******************************************************************************************
+ *
+ *	LinCongSkip(iLC, iX, iCount)
+ *
+ *	Returns the value the recurrence reaches from iX after iCount steps, in O(log iCount)
+ *	operations. Uses the usual square-and-multiply on the affine map x -> m * x + a,
+ *	which gives mul^n and add * (mul^(n-1) + ... + 1) without any division.
+ *
+ ******************************************************************************************/
+
+UInt32
+LinCongSkip(
+	const tLinCong*	iLC,
+	UInt32			iX,
+	UInt64			iCount)
+
+	{
+	UInt32	accMul	= 1,
+			accAdd	= 0,
+			curMul	= iLC->laneMul[0],
+			curAdd	= iLC->laneAdd[0];
+
+	if (iCount == 0)
+		return iX;
+
+	while (iCount > 0) {
+		if (iCount & 1) {
+			// All powers of the same map commute, so the order of composition is moot
+			accAdd = LinCongMulAdd(iLC, curMul, accAdd, curAdd);
+			accMul = LinCongMulAdd(iLC, curMul, accMul, 0);
+			}
+
+		curAdd = LinCongMulAdd(iLC, curMul, curAdd, curAdd);
+		curMul = LinCongMulAdd(iLC, curMul, curMul, 0);
+		iCount >>= 1;
+		}
+
+	return LinCongMulAdd(iLC, accMul, iX, accAdd);
+	}
+
+
+/******************************************************************************************
+ *
+ *	LinCongFill(iLC, iX, oBuf, iCount)
+ *
+ *	Write the next iCount values of the sequence starting after iX to oBuf and return the
+ *	last of them (i.e., the new seed).
+ *
+ *	The values are generated kLinCongLanes at a time. Every value in a block is computed
+ *	directly from the last value of the previous block with the precalculated lane
+ *	multipliers and adders, so there are no dependencies inside a block and the compiler
+ *	can vectorize the inner loops. The output is bit-identical to iterating LinCongStep().
+ *
+ ******************************************************************************************/
+
+UInt32
+LinCongFill(
+	const tLinCong*	iLC,
+	UInt32			iX,
+	UInt32			oBuf[],
+	long			iCount)
+
+	{
+	const UInt32*	laneMul = iLC->laneMul;
+	const UInt32*	laneAdd = iLC->laneAdd;
+
+	long			remain	= iCount % kLinCongLanes;
+	int				j;
+
+	iCount -= remain;
+
+	if (iLC->modMask != 0) {
+		// Power of two modulus (including 2^32): just mask
+		UInt32 mask = iLC->modMask;
+
+		for ( ; iCount > 0; iCount -= kLinCongLanes) {
+			for (j = 0; j < kLinCongLanes; j += 1)
+				oBuf[j] = (laneMul[j] * iX + laneAdd[j]) & mask;
+			iX = oBuf[kLinCongLanes - 1];
+			oBuf += kLinCongLanes;
+			}
+		}
+
+	else {
+		// Other moduli: Barrett reduction
+		for ( ; iCount > 0; iCount -= kLinCongLanes) {
+			for (j = 0; j < kLinCongLanes; j += 1)
+				oBuf[j] = LinCongReduce(iLC, (UInt64) laneMul[j] * iX + laneAdd[j]);
+			iX = oBuf[kLinCongLanes - 1];
+			oBuf += kLinCongLanes;
+			}
+		}
+
+	// Whatever is left over is shorter than a block
+	if (remain > 0) {
+		for (j = 0; j < remain; j += 1)
+			oBuf[j] = LinCongMulAdd(iLC, laneMul[j], iX, laneAdd[j]);
+		iX = oBuf[remain - 1];
+		}
+
+	return iX;
+	}
@@ -0,0 +1,110 @@
+/*
+	File:		LinCong.h
+
+	Contains:	Header file for LinCong.c, linear congruence kernels shared by lp.lili and
+				lp.lll~.
+
+	Written by:	Peter Castine
+
+	Copyright:	© 2026 Peter Castine
+
+	Change History (most recent first):
+
+*/
+
+
+/******************************************************************************************
+ ******************************************************************************************/
+
+#pragma once
+#ifndef __LINCONG_H__
+#define __LINCONG_H__
+
+
+#pragma mark • Include Files
+
+#ifndef __MACTYPES__
+	#include <MacTypes.h>									// For UInt32, UInt64
+#endif
+
+
+#pragma mark • Constants
+
+enum {
+	kLinCongLanes		= 8									// Values per block in LinCongFill()
+	};
+
+
+#pragma mark • Type Definitions
+
+	// Parameters of the recurrence x' = (mul * x + add) mod mod, with a modulus of 0
+	// standing for 2^32. Everything else is precalculated by LinCongSetup():
+	//	-	modMask is mod - 1 if the modulus is a power of two (0xffffffff for 2^32), 0
+	//		otherwise
+	//	-	barrett is floor((2^64 - 1) / mod) for other moduli.
+	//	-	laneMul[j] and laneAdd[j] are the multiplier and adder that take x directly to
+	//		the (j+1)th successor: mul^(j+1) and add * (mul^j + ... + mul + 1), both
+	//		reduced by the modulus.
+typedef struct linCong {
+			UInt32	mul,
+					add,
+					mod,
+					modMask;
+			UInt64	barrett;
+			UInt32	laneMul[kLinCongLanes],
+					laneAdd[kLinCongLanes];
+			} tLinCong;
+typedef tLinCong* tLinCongPtr;
+
+
+#pragma mark • Function Prototypes
+
+void	LinCongSetup	(tLinCongPtr, UInt32, UInt32, UInt32);
+UInt32	LinCongSkip		(const tLinCong*, UInt32, UInt64);
+UInt32	LinCongFill		(const tLinCong*, UInt32, UInt32[], long);
+
+
+#pragma mark -
+#pragma mark • Inline Functions
+
+	// High 64 bits of the 128-bit product a * b, using only 32 x 32 bit multiplications
+static inline UInt64 LinCongMulHi(UInt64 a, UInt64 b)
+	{
+	UInt64	aLo		= (UInt32) a,
+			aHi		= a >> 32,
+			bLo		= (UInt32) b,
+			bHi		= b >> 32,
+			loLo	= aLo * bLo,
+			hiLo	= aHi * bLo,
+			loHi	= aLo * bHi,
+			cross	= (loLo >> 32) + (UInt32) hiLo + loHi;
+
+	return aHi * bHi + (hiLo >> 32) + (cross >> 32);
+	}
+
+	// Barrett reduction of x < mod^2 (or any x < 2^64). The estimated quotient is at
+	// most two short, so at most two corrections are needed.
+static inline UInt32 LinCongReduce(const tLinCong* iLC, UInt64 x)
+	{
+	UInt64	r = x - LinCongMulHi(x, iLC->barrett) * iLC->mod;
+
+	if (r >= iLC->mod) r -= iLC->mod;
+	if (r >= iLC->mod) r -= iLC->mod;
+
+	return (UInt32) r;
+	}
+
+	// (m * x + a) mod modulus, for any of the three kinds of moduli
+static inline UInt32 LinCongMulAdd(const tLinCong* iLC, UInt32 m, UInt32 x, UInt32 a)
+	{
+	if (iLC->modMask != 0)
+		return (m * x + a) & iLC->modMask;
+
+	return LinCongReduce(iLC, (UInt64) m * x + a);
+	}
+
+	// One step of the recurrence; bit-identical to the first value of LinCongFill()
+static inline UInt32 LinCongStep(const tLinCong* iLC, UInt32 x)
+	{ return LinCongMulAdd(iLC, iLC->laneMul[0], x, iLC->laneAdd[0]); }
+
+#endif		// __LINCONG_H__
@@ -187,6 +187,7 @@ typedef t_atombuf	AtomBuf, *AtomBufPtr;
 
 #ifdef __MAX_MSP_OBJECT__
 	typedef t_sample*	tSampleVector;
+	typedef double*		tSampleVector64;	// Signal vectors passed to Max 6 dsp64 methods
 	typedef t_buffer*	tBufferPtr;
 #endif
 
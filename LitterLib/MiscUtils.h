@@ -69,6 +69,8 @@ static inline double	ULong2Unit_zO	(UInt32);
 static inline double	ULong2Unit_ZO	(UInt32);
 static inline float		ULong2Signal	(UInt32);				// ! returns a simple float !
 static inline float		Long2Signal		(long);
+static inline double	ULong2Signal64	(UInt32);				// Full 32-bit resolution
+static inline double	Long2Signal64	(long);
 
 
 
@@ -137,6 +139,22 @@ inline float	Long2Signal(long iVal)						// Return range: -1 <= x < 1
 					return kScale * iVal;
 					}
 
+	// Double precision versions of the above for 64-bit signal vectors. ULong2Signal64
+	// maps to the same range as ULong2Signal, but keeps all 32 bits of iVal
+inline double	ULong2Signal64(UInt32 iVal)			// Return range: -1 <= x < 1
+					{
+					const double kScale = 2.0 / ((double) kULongMax + 1.0);
+					
+					return kScale * iVal - 1.0;
+					}
+
+inline double	Long2Signal64(long iVal)					// Return range: -1 <= x < 1
+					{
+					const double kScale = 1.0 / ((double) kLongMax + 1.0);
+					
+					return kScale * iVal;
+					}
+
 inline double	Unit2Exponential(double iVal)
 					{ return -log(iVal); }
 inline double	Unit2Laplace	(double iVal)
@@ -171,6 +171,63 @@ GenDevBinomialBFTaus88(
 	}
 	
 
+/******************************************************************************************
+ *
+ *	GenBernoulliBitsTaus88(iThresh, oBits, iWords, iData)
+ *
+ *	Fills oBits[] with iWords * 32 independent Bernoulli trials, one trial per bit. The
+ *	value iThresh maps p into 64-bit fixed point; use CalcBSThreshhold() to calculate it.
+ *
+ *	Each bit position compares its own uniform deviate U against p, one binary digit at a
+ *	time starting with the most significant, all 32 positions in parallel. Every random
+ *	word settles about half of the positions still tied with p, so filling a word takes
+ *	about log2(32) + 1.3, i.e. fewer than seven Taus88 words. The brute force approach
+ *	needs 32. We also stop as soon as the remaining digits of p are all zero, so p = 0.5
+ *	costs exactly one word, p = 0.25 or 0.75 two, etc.
+ *
+ *	Probabilities are exact to 64 binary places.
+ *
+ ******************************************************************************************/
+
+void
+GenBernoulliBitsTaus88(
+	UInt64			iThresh,
+	UInt32			oBits[],
+	long			iWords,
+	tTaus88Data*	iData)
+
+	{
+	UInt32	s1, s2, s3;
+
+	if (iData == NIL)
+		iData = Taus88GetGlobals();
+
+	Taus88Load(iData, &s1, &s2, &s3);
+
+	while (iWords-- > 0) {
+		UInt64	t	= iThresh;
+		UInt32	lt	= 0,						// Positions where U < p is settled
+				eq	= 0xffffffff;				// Positions where U still matches p
+
+		while (eq != 0 && t != 0) {
+			UInt32 u = Taus88Process(&s1, &s2, &s3);
+
+			if (t >> 63) {
+				lt |= eq & ~u;
+				eq &= u;
+				}
+			else eq &= ~u;
+
+			t <<= 1;
+			}
+
+		*oBits++ = lt;
+		}
+
+	Taus88Store(iData, s1, s2, s3);
+	}
+
+
 /******************************************************************************************
  *
  *	CalcBINVParams(oParams, iNTrials, iProb)
@@ -175,3 +175,52 @@ GenChi2RejTaus88(
 	return chi2;
 	}
 
+
+/******************************************************************************************
+ *
+ *	CalcChi2Params(oParams, iFreedom)
+ *	GenChi2Taus88(iParams, iData)
+ *
+ *	A chi-square variate with nu degrees of freedom is Gamma(nu/2, 2), so for all but the
+ *	smallest values of nu we use the Marsaglia-Tsang generator, which takes odd values of
+ *	nu in its stride. Its constants are calculated once here, when nu changes, and
+ *	reused for every deviate.
+ *
+ ******************************************************************************************/
+
+void
+CalcChi2Params(
+	tChi2Params*	oParams,
+	UInt32			iFreedom)
+	
+	{
+	oParams->dof = iFreedom;
+	oParams->alg = Chi2RecommendAlg(iFreedom);
+	
+	if (oParams->alg == algChi2MT)
+		CalcMTParams(&oParams->mt, 0.5 * (double) iFreedom, 2.0);
+	}
+
+double
+GenChi2Taus88(
+	tChi2Params*	iParams,
+	tTaus88Data*	iData)
+	
+	{
+	double chi2;
+	
+	switch (iParams->alg) {
+	case algChi2MT:
+		chi2 = GenGammaMTTaus88(&iParams->mt, iData);
+		break;
+	case algChi2Dir:
+		chi2 = GenChi2DirTaus88(iParams->dof, iData);
+		break;
+	default:
+		// Must be algChi2Const0
+		chi2 = 0.0;
+		break;
+		}
+	
+	return chi2;
+	}
@@ -63,6 +63,14 @@
  *
  *	RecommendGammaAlg(iAlpha)
  *
+ *	The direct Erlang method costs one uniform deviate per unit of alpha; Marsaglia-Tsang
+ *	costs about the same as four. So the direct method is only worth it for small
+ *	integral alpha. Below alpha = 1/2, GS is a little quicker than Marsaglia-Tsang with
+ *	its correction for alpha < 1.
+ *
+ *	Non-positive alpha gets algUndef. It must not reach the Erlang functions, which would
+ *	count an unsigned alpha of 0 down through 2^32 iterations.
+ *
  ******************************************************************************************/
  
 eGammaAlg
@@ -70,20 +78,15 @@ RecommendGammaAlg(
 	double iAlpha)
 	
 	{
-	eGammaAlg	rec			= algUndef;
-	double		intAlpha	= floor(iAlpha);
+	eGammaAlg	rec = algUndef;
 		
-	if (iAlpha == intAlpha) {
-			// Let's see if we can use one of the Erlang algorithms
-		if		(iAlpha <= 13.0)				rec = algErlDir;
-		else if	(iAlpha <= (double) kLongMax)	rec = algErlRej;
-			// Otherwise it may be integer, but way too big for Erlang algorithms
-		else									rec = algGD;
-		}
+	if (iAlpha <= 0.0)
+		rec = algUndef;										// Degenerate; leave it to the caller
 	
 	else {
-		if		(iAlpha < 1.0)					rec = algGS;
-		else									rec = algGD; 
+		if		(iAlpha < 0.5)								rec = algGS;
+		else if	(iAlpha <= 4.0 && iAlpha == floor(iAlpha))	rec = algErlDir;
+		else												rec = algMT;
 		}
 	
 	return rec;
@@ -150,6 +153,10 @@ GerErlangDirTaus88(
  *
  *	Use rejection method to calculate one Gamma-distributed deviate.
  *
+ *	The num/denom pair must be uniform over [-1, 1), so the 32-bit deviate is cast to
+ *	SInt32 before Long2Signal(). Otherwise, on LP64 builds it is never negative and the
+ *	ratio (and with it the output) is biased.
+ *
  ******************************************************************************************/
 
 double
@@ -174,8 +181,8 @@ GenErlangRej(
 			//  the unit circle. Protect against division by 0.
 			double num, denom;
 			do {
-				num		= Long2Signal(iFunc(iData));
-				denom	= Long2Signal(iFunc(iData));
+				num		= Long2Signal((SInt32) iFunc(iData));
+				denom	= Long2Signal((SInt32) iFunc(iData));
 				} while ( (denom == 0.0) || (num * num + denom * denom > 1.0) );
 			ratio = num / denom;
 			// Calculate candidate unscaled Erlang value;
@@ -187,7 +194,7 @@ GenErlangRej(
 		b *= exp(alpha1 * log(e/alpha1) - iGamma * ratio);
 		} while (ULong2Unit_zo(iFunc(iData)) > b);
 	
-	return -log(e) * iBeta;
+	return e * iBeta;
 	}
 	
 double
@@ -217,8 +224,8 @@ GenErlangRejTaus88(
 			// Get the ratio of a pair of uniformly distributed deviates inside
 			//  the unit circle. Protect against division by 0.
 			do  {
-				num		= Long2Signal( Taus88Process(&s1, &s2, &s3) );
-				denom	= Long2Signal( Taus88Process(&s1, &s2, &s3) );
+				num		= Long2Signal( (SInt32) Taus88Process(&s1, &s2, &s3) );
+				denom	= Long2Signal( (SInt32) Taus88Process(&s1, &s2, &s3) );
 				} while ( (denom == 0.0) || (num * num + denom * denom > 1.0) );
 			
 			ratio = num / denom;
@@ -318,7 +325,11 @@ GenGammaGSTaus88(
  *	GenGammaGD(iAlpha, iFunc, iData)
  *	GenGammaGDTaus88(iAlpha, iData)
  *
- *	Use GS method to calculate one Gamma-distributed deviate.
+ *	Use GD method to calculate one Gamma-distributed deviate.
+ *
+ *	The Laplace loop must start over after each of its rejection tests. A continue inside
+ *	do {} while (test) would jump to the final test, using w left over from the previous
+ *	pass, so the loop only exits through the break on acceptance.
  *
  ******************************************************************************************/
 
@@ -462,9 +473,10 @@ GenGammaGD(
 				
 				w = CalcMagicW(q);
 				
-				// Reject this t?
+				// Accept this t?
 				// NB: We made sure that u was positive above!
-				} while (iParams->c * u > w * exp(e - 0.5 * t * t));
+				if (iParams->c * u <= w * exp(e - 0.5 * t * t)) break;
+				} while (true);
 			
 			// We've got a winner. Finally
 			x = sigma + 0.5 * t;
@@ -535,9 +547,10 @@ GenGammaGDTaus88(
 				
 				w = CalcMagicW(q);
 				
-				// Reject this t?
+				// Accept this t?
 				// NB: We made sure that u was positive above!
-				} while (iParams->c * u > w * exp(e - 0.5 * t * t));
+				if (iParams->c * u <= w * exp(e - 0.5 * t * t)) break;
+				} while (true);
 			
 			// We've got a winner. Finally
 			x = sigma + 0.5 * t;
@@ -551,3 +564,116 @@ exit:
 		
 	return gd * iParams->beta;
 	}
+
+
+/******************************************************************************************
+ *
+ *	CalcMTParams(oParams, iAlpha, iBeta)
+ *	GenGammaMT(iParams, iFunc, iData)
+ *	GenGammaMTTaus88(iParams, iData)
+ *
+ *	Marsaglia & Tsang (2000), "A simple method for generating gamma variables," ACM
+ *	Transactions on Mathematical Software 26, pp. 363-372.
+ *
+ *	A standard normal x is mapped to d·(1 + c·x)^3, which is already very close to a
+ *	Gamma(alpha) deviate. The candidate is accepted at once if u < 1 - 0.0331·x^4 (the
+ *	squeeze, which catches nearly all of them); only the rest need the log() test. There
+ *	are never more than a few percent rejections, for any alpha >= 1.
+ *
+ *	For alpha < 1 we generate Gamma(alpha + 1) and multiply by u^(1/alpha).
+ *
+ *	All constants depend only on alpha, so CalcMTParams() should be called when the
+ *	parameters change, not per deviate. The caller must make sure that alpha > 0.
+ *
+ ******************************************************************************************/
+
+void
+CalcMTParams(
+	tGammaMTParams*	oParams,
+	double			iAlpha,
+	double			iBeta)
+	
+	{
+	double	d = iAlpha - 1.0 / 3.0;
+	
+	if (iAlpha < 1.0) {
+		oParams->alphaInv	= 1.0 / iAlpha;
+		d					+= 1.0;
+		}
+	else oParams->alphaInv	= 0.0;
+	
+	oParams->alpha	= iAlpha;
+	oParams->beta	= iBeta;
+	oParams->d		= d;
+	oParams->c		= 1.0 / sqrt(9.0 * d);
+	}
+
+double
+GenGammaMT(
+	tGammaMTParams*	iParams,
+	tRandomFunc		iFunc,
+	void*			iData)
+	
+	{
+	const double	d	= iParams->d,
+					c	= iParams->c;
+	
+	double	x, v, u;
+	
+	do  {
+		do	{
+			x = NormalKR(iFunc, iData);
+			v = 1.0 + c * x;
+			} while (v <= 0.0);
+		
+		v *= v * v;
+		u  = ULong2Unit_zo( iFunc(iData) );
+		x *= x;
+		
+		if (u < 1.0 - 0.0331 * x * x) break;					// Squeeze
+		} while (log(u) >= 0.5 * x + d * (1.0 - v + log(v)));
+	
+	v *= d;
+	if (iParams->alphaInv > 0.0)
+		v *= exp( log(ULong2Unit_zo( iFunc(iData) )) * iParams->alphaInv );
+	
+	return v * iParams->beta;
+	}
+
+double
+GenGammaMTTaus88(
+	tGammaMTParams*	iParams,
+	tTaus88Data*	iData)
+	
+	{
+	const double	d	= iParams->d,
+					c	= iParams->c;
+	
+	double	x, v, u;
+	UInt32	s1, s2, s3;
+	
+	if (iData == NIL)
+		iData = Taus88GetGlobals();
+	Taus88Load(iData, &s1, &s2, &s3);
+	
+	do  {
+		do	{
+			x = NormalKRTaus88Regs(&s1, &s2, &s3);
+			v = 1.0 + c * x;
+			} while (v <= 0.0);
+		
+		v *= v * v;
+		u  = ULong2Unit_zo( Taus88Process(&s1, &s2, &s3) );
+		x *= x;
+		
+		if (u < 1.0 - 0.0331 * x * x) break;					// Squeeze
+		} while (log(u) >= 0.5 * x + d * (1.0 - v + log(v)));
+	
+	v *= d;
+	if (iParams->alphaInv > 0.0)
+		v *= exp( log(ULong2Unit_zo( Taus88Process(&s1, &s2, &s3) )) * iParams->alphaInv );
+	
+	Taus88Store(iData, s1, s2, s3);
+	
+	return v * iParams->beta;
+	}
@@ -1 +1 @@
-/*	File:		RNGGamma.h	Contains:	<contents>	Written by:	Peter Castine	Copyright:	<copyright>	Change History (most recent first):         <1>   3032006    pc      Initial check in.*//*	File:		RNGChi2.h	Contains:	Header file for RNGChi2.c.	Written by:	Peter Castine	Copyright:	 2001-06 Peter Castine	Change History (most recent first):*//******************************************************************************************	Previous history:		24-Mar-06:	Spun off from LitterLib ******************************************************************************************/#pragma once#ifndef __RNGGAMMA_H__#define __RNGGAMMA_H__#pragma mark  Include Files#ifndef __TAUS88_H__	#include "Taus88.h"#endif#ifndef __MISCUTILS_H__	#include "MiscUtils.h"#endif#pragma mark  Constants	// Algorithm used for generating deviatesenum gammaAlg {	algUndef		= -1,	// Caller may need a flag for not having asked							// or alpha may be invalid		algErlDir,				// Integral order values, up to 6	algErlRej,				// Integral order values, larger than 6	algGS,					// Floating-point alpha values less than 1	algGD,					// Floating-point alpha values greater than 1		algCount	};#pragma mark  Type Definitionstypedef enum gammaAlg eGammaAlg;typedef struct {			double	alpha,					beta,					gamma,			// was me->auxAlpha					sigma,			// was me->s					sigma2,			// was me->s2					delta,			// was me->d					rho,			// was me->r					si,					q0,					c;			} tGammaGDParams;#pragma mark  Global Variables#pragma mark  Function PrototypeseGammaAlg RecommendGammaAlg(double);double	GenErlangDir		(UInt32, double, tRandomFunc, void*);double	GerErlangDirTaus88	(UInt32, double, tTaus88Data*);static inline double  CalcErlangRejGamma	(UInt32);double	GenErlangRej		(UInt32, double, double, tRandomFunc, void*);double	GenErlangRejTaus88	(UInt32, double, double, tTaus88Data*);static inline double	CalcGSGamma			(double);double	GenGammaGS			(double, double, double, tRandomFunc, void*);double	GenGammaGSTaus88	(double, double, double, tTaus88Data*);void	CalcGDParams		(tGammaGDParams*, double, double);double	GenGammaGD			(tGammaGDParams*, tRandomFunc, void*);double	GenGammaGDTaus88	(tGammaGDParams*, tTaus88Data*);#pragma mark -#pragma mark  Inline Functions & Macrosstatic inline double CalcErlangRejGamma(UInt32 iAlpha)		{ return sqrt(iAlpha + iAlpha - 1); }static inline double CalcGSGamma(double iAlpha)		{ return 1.0 + 0.3678794 * iAlpha; }	#endif			// __RNGCHI2_H__
\ No newline at end of file
+/*	File:		RNGGamma.h	Contains:	<contents>	Written by:	Peter Castine	Copyright:	<copyright>	Change History (most recent first):         <1>   3032006    pc      Initial check in.*//*	File:		RNGChi2.h	Contains:	Header file for RNGChi2.c.	Written by:	Peter Castine	Copyright:	 2001-06 Peter Castine	Change History (most recent first):*//******************************************************************************************	Previous history:		24-Mar-06:	Spun off from LitterLib ******************************************************************************************/#pragma once#ifndef __RNGGAMMA_H__#define __RNGGAMMA_H__#pragma mark  Include Files#ifndef __TAUS88_H__	#include "Taus88.h"#endif#ifndef __MISCUTILS_H__	#include "MiscUtils.h"#endif#pragma mark  Constants	// Algorithm used for generating deviatesenum gammaAlg {	algUndef		= -1,	// Caller may need a flag for not having asked							// or alpha may be invalid		algErlDir,				// Integral order values, up to 6	algErlRej,				// Integral order values, larger than 6	algGS,					// Floating-point alpha values less than 1	algGD,					// Floating-point alpha values greater than 1	algMT,					// Marsaglia-Tsang; any alpha > 0		algCount	};#pragma mark  Type Definitionstypedef enum gammaAlg eGammaAlg;typedef struct {			double	alpha,					beta,					gamma,			// was me->auxAlpha					sigma,			// was me->s					sigma2,			// was me->s2					delta,			// was me->d					rho,			// was me->r					si,					q0,					c;			} tGammaGDParams;typedef struct {			double	alpha,					beta,					d,				// alpha - 1/3 (alpha + 2/3 if alpha < 1)					c,				// 1 / sqrt(9d)					alphaInv;		// 1/alpha if alpha < 1, otherwise 0			} tGammaMTParams;#pragma mark  Global Variables#pragma mark  Function PrototypeseGammaAlg RecommendGammaAlg(double);double	GenErlangDir		(UInt32, double, tRandomFunc, void*);double	GerErlangDirTaus88	(UInt32, double, tTaus88Data*);static inline double  CalcErlangRejGamma	(UInt32);double	GenErlangRej		(UInt32, double, double, tRandomFunc, void*);double	GenErlangRejTaus88	(UInt32, double, double, tTaus88Data*);static inline double	CalcGSGamma			(double);double	GenGammaGS			(double, double, double, tRandomFunc, void*);double	GenGammaGSTaus88	(double, double, double, tTaus88Data*);void	CalcGDParams		(tGammaGDParams*, double, double);double	GenGammaGD			(tGammaGDParams*, tRandomFunc, void*);double	GenGammaGDTaus88	(tGammaGDParams*, tTaus88Data*);void	CalcMTParams		(tGammaMTParams*, double, double);double	GenGammaMT			(tGammaMTParams*, tRandomFunc, void*);double	GenGammaMTTaus88	(tGammaMTParams*, tTaus88Data*);#pragma mark -#pragma mark  Inline Functions & Macrosstatic inline double CalcErlangRejGamma(UInt32 iAlpha)		{ return sqrt(iAlpha + iAlpha - 1); }static inline double CalcGSGamma(double iAlpha)		{ return 1.0 + 0.3678794 * iAlpha; }	#endif			// __RNGGAMMA_H__
\ No newline at end of file
@@ -186,9 +186,6 @@ NormalBMTaus88(
 #pragma mark -
 #pragma mark • Kinderman-Ramage Algorithm
 
-	static inline double NormKRHelper(double x, double A)
-		{ return 0.3989422804 * exp(-0.5 * x * x) - 0.1800251911 * (A - x); }
-
 double
 NormalKR(
 	tRandomFunc	iFunc,
@@ -309,117 +306,46 @@ NormalKRTaus88(
 	tTaus88Data*	iData)
 	
 	{
-    const double A = 2.2160358672;
-    
-	UInt32	u1, s1, s2, s3;
-	double	u2,
-			u3,
-			result;
+	UInt32	s1, s2, s3;
+	double	result;
 	
 	if (iData == NIL)
 		iData = Taus88GetGlobals();
 	Taus88Load(iData, &s1, &s2, &s3);
 	
-	u1 = Taus88Process(&s1, &s2, &s3);
-	u2 = ULong2Unit_ZO( Taus88Process(&s1, &s2, &s3) );
-	u3 = ULong2Unit_ZO( Taus88Process(&s1, &s2, &s3) );
-
+	result = NormalKRTaus88Regs(&s1, &s2, &s3);
 	
-	if (u1 < 3797053464UL)							// Main body of standard distribution
-	    result = A * (u2 + u3 - 1.0);
+	Taus88Store(iData, s1, s2, s3);
 	
-	else if (u1 < 3914058587UL) do {					// Region 1
-		double sign = 1.0;
-			
-		if (u3 < u2) {
-			// Swap random deviates, generate negative variate
-			double temp = u2;
-			u2 = u3;
-			u3 = temp;
-			sign = -1.0;
-			}										// ASSERT (u2 < u3)
-	   
-	    result = 0.4797274042 - 0.5955071380 * u2;
-	    if (result >= 0.0) {						// Potential variate
-		    if (u3 <= 0.8055779244
-		    		|| 0.0533775495 * (u3-u2) <= NormKRHelper(result, A)) {
-				result *= sign;						// We have a variate
-				break;
-				}
-			}
-	    
-	    // Try again
-	    u2 = ULong2Unit_ZO( Taus88Process(&s1, &s2, &s3) );
-	    u3 = ULong2Unit_ZO( Taus88Process(&s1, &s2, &s3) );
-		} while (true);
+	return result;
+	}
+
+
+/******************************************************************************************
+ *
+ *	NormalKRTaus88Fill(iData, oBuf, iCount)
+ *	
+ *	Fill a block with standard normal deviates. The seeds are loaded and stored only once
+ *	per block; the output is identical to iCount consecutive calls to NormalKRTaus88().
+ *	iCount may be any non-negative number.
+ *	
+ ******************************************************************************************/
+
+void
+NormalKRTaus88Fill(
+	tTaus88Data*	iData,
+	double			oBuf[],
+	long			iCount)
 	
-	else if (u1 < 4117674588UL) do {					// Region 2
-		double sign = 1.0;
-			
-		if (u3 < u2) {
-			// Swap random deviates, generate negative variate
-			double temp = u2;
-			u2 = u3;
-			u3 = temp;
-			sign = -1.0;
-			}										// ASSERT (u2 < u3)
-	   
-		result = 0.4797274042 + 1.1054736610 * u2;
-		if(u3 <= 0.8728349767
-				|| 0.0492644964 * (u3-u2) <= NormKRHelper(result, A)) {
-		    result *= sign;
-		    break;
-		    }
-	    
-	    // Try again
-		u2 = ULong2Unit_ZO( Taus88Process(&s1, &s2, &s3) );
-		u3 = ULong2Unit_ZO( Taus88Process(&s1, &s2, &s3) );
-    	} while (true);		
+	{
+	UInt32	s1, s2, s3;
 	
-	else if (u1 < 4180338716UL) do {					// Region 3
-		double sign = 1.0;
-			
-		if (u3 < u2) {
-			// Swap random deviates, generate negative variate
-			double temp = u2;
-			u2 = u3;
-			u3 = temp;
-			sign = -1.0;
-			}										// ASSERT (u2 < u3)
-		
-		result = A - 0.6308348019 * u2;
-		if (u3 <= 0.7555915317
-				|| 0.0342405038 * (u3 - u2) <= NormKRHelper(result, A)) {
-		    result *= sign;
-		    break;
-		    }
-	    
-	    // Try again
-		u2 = ULong2Unit_ZO( Taus88Process(&s1, &s2, &s3) );
-		u3 = ULong2Unit_ZO( Taus88Process(&s1, &s2, &s3) );
-		} while (true);
+	if (iData == NIL)
+		iData = Taus88GetGlobals();
+	Taus88Load(iData, &s1, &s2, &s3);
 	
-	else do {										// Tail
-		result  = -log(u3);
-		result += result;
-		result += A * A;
-		// ASSERT (result == A * A - 2 * log(u3))
-		
-		if (result * u2 * u2 < A * A ) {				// We have a variate
-			result = sqrt(result);
-			if (u1 & 0x01)								// Toss a coin to determine sign
-		    	result = -result;
-		    break;
-		    }
-	    
-	    // Try again
-		u2 = ULong2Unit_ZO( Taus88Process(&s1, &s2, &s3) );
-		u3 = ULong2Unit_ZO( Taus88Process(&s1, &s2, &s3) );
-		} while (true);
+	while (iCount-- > 0)
+		*oBuf++ = NormalKRTaus88Regs(&s1, &s2, &s3);
 	
 	Taus88Store(iData, s1, s2, s3);
-	
-	return result;
 	}
-	
-
@@ -45,9 +45,133 @@ double	NormalBMTaus88	(double*		oSpare,
 double	NormalKR		(tRandomFunc	iFunc,
 						 void*			iData);
 double	NormalKRTaus88	(tTaus88Data*	iData);
+void	NormalKRTaus88Fill
+						(tTaus88Data*	iData,
+						 double			oBuf[],
+						 long			iCount);
 
 
 #pragma mark -
 #pragma mark  Inline Functions & Macros
 
 	
+	// Kinderman-Ramage working directly on the caller's Taus88 registers. Generators that
+	// keep the seeds loaded through their own rejection loops (e.g., GenGammaMTTaus88())
+	// call this instead of NormalKRTaus88(). NormalKRTaus88() and NormalKRTaus88Fill()
+	// are built on it, so all three produce identical sequences.
+static inline double NormKRHelper(double x, double A)
+	{ return 0.3989422804 * exp(-0.5 * x * x) - 0.1800251911 * (A - x); }
+
+static inline double
+NormalKRTaus88Regs(
+	UInt32*	s1,
+	UInt32*	s2,
+	UInt32*	s3)
+	
+	{
+    const double A = 2.2160358672;
+    
+	UInt32	u1;
+	double	u2,
+			u3,
+			result;
+	
+	u1 = Taus88Process(s1, s2, s3);
+	u2 = ULong2Unit_ZO( Taus88Process(s1, s2, s3) );
+	u3 = ULong2Unit_ZO( Taus88Process(s1, s2, s3) );
+
+	
+	if (u1 < 3797053464UL)							// Main body of standard distribution
+	    result = A * (u2 + u3 - 1.0);
+	
+	else if (u1 < 3914058587UL) do {					// Region 1
+		double sign = 1.0;
+			
+		if (u3 < u2) {
+			// Swap random deviates, generate negative variate
+			double temp = u2;
+			u2 = u3;
+			u3 = temp;
+			sign = -1.0;
+			}										// ASSERT (u2 < u3)
+	   
+	    result = 0.4797274042 - 0.5955071380 * u2;
+	    if (result >= 0.0) {						// Potential variate
+		    if (u3 <= 0.8055779244
+		    		|| 0.0533775495 * (u3-u2) <= NormKRHelper(result, A)) {
+				result *= sign;						// We have a variate
+				break;
+				}
+			}
+	    
+	    // Try again
+	    u2 = ULong2Unit_ZO( Taus88Process(s1, s2, s3) );
+	    u3 = ULong2Unit_ZO( Taus88Process(s1, s2, s3) );
+		} while (true);
+	
+	else if (u1 < 4117674588UL) do {					// Region 2
+		double sign = 1.0;
+			
+		if (u3 < u2) {
+			// Swap random deviates, generate negative variate
+			double temp = u2;
+			u2 = u3;
+			u3 = temp;
+			sign = -1.0;
+			}										// ASSERT (u2 < u3)
+	   
+		result = 0.4797274042 + 1.1054736610 * u2;
+		if(u3 <= 0.8728349767
+				|| 0.0492644964 * (u3-u2) <= NormKRHelper(result, A)) {
+		    result *= sign;
+		    break;
+		    }
+	    
+	    // Try again
+		u2 = ULong2Unit_ZO( Taus88Process(s1, s2, s3) );
+		u3 = ULong2Unit_ZO( Taus88Process(s1, s2, s3) );
+    	} while (true);		
+	
+	else if (u1 < 4180338716UL) do {					// Region 3
+		double sign = 1.0;
+			
+		if (u3 < u2) {
+			// Swap random deviates, generate negative variate
+			double temp = u2;
+			u2 = u3;
+			u3 = temp;
+			sign = -1.0;
+			}										// ASSERT (u2 < u3)
+		
+		result = A - 0.6308348019 * u2;
+		if (u3 <= 0.7555915317
+				|| 0.0342405038 * (u3 - u2) <= NormKRHelper(result, A)) {
+		    result *= sign;
+		    break;
+		    }
+	    
+	    // Try again
+		u2 = ULong2Unit_ZO( Taus88Process(s1, s2, s3) );
+		u3 = ULong2Unit_ZO( Taus88Process(s1, s2, s3) );
+		} while (true);
+	
+	else do {										// Tail
+		result  = -log(u3);
+		result += result;
+		result += A * A;
+		// ASSERT (result == A * A - 2 * log(u3))
+		
+		if (result * u2 * u2 < A * A ) {				// We have a variate
+			result = sqrt(result);
+			if (u1 & 0x01)								// Toss a coin to determine sign
+		    	result = -result;
+		    break;
+		    }
+	    
+	    // Try again
+		u2 = ULong2Unit_ZO( Taus88Process(s1, s2, s3) );
+		u3 = ULong2Unit_ZO( Taus88Process(s1, s2, s3) );
+		} while (true);
+	
+	return result;
+	}
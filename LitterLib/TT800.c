@@ -24,6 +24,15 @@
 
 #pragma mark • Constants	
 
+	// The following values are magic that TT800 depends on, don't change.
+static const UInt32	kMagicA		= 0x8ebfd028,
+					kMagicB		= 0x2b5b2500,
+					kMagicC		= 0xdb8b0000;
+
+	// The following must be less than kTT800SeedArraySize. There may be other
+	// requirements but if 7 is good enough for Matsumoto, it's good enough for us!
+enum { kTT800SeedArrayOffset = 7 };
+
 
 #pragma mark • Type Definitions
 
@@ -40,7 +49,8 @@ static tTT800Data
 					 0xc1de75b7, 0x8858a9c9, 0x2da87693, 0xb657f9dd, 0xffdc8a9f,
 					 0x8121da71, 0x8b823ecb, 0x885d05f5, 0x4e20cd47, 0x5a9ad5d9,
 					 0x512c0c03, 0xea857ccd, 0x4cc1d30f, 0x8891a8a1, 0xa6b7aadb},
-					0 };
+					{0},
+					kTT800SeedArraySize };			// outputs[] not tempered yet
 
 
 #pragma mark • Initialize Global Variables
@@ -53,59 +63,114 @@ static tTT800Data
 
 #pragma mark • TT800 Functions
 
+/******************************************************************************************
+ *
+ *	RegenerateBlock(ioSeeds)
+ *	TemperBlock(iSeeds, oOut)
+ *
+ *	Matsumoto's TT800 recurrence, applied to all 25 words in one go. The first loop only
+ *	reads words it hasn't overwritten yet and the second only reads words the first loop
+ *	has finished with, so neither has a loop-carried dependency and both vectorize. The
+ *	magic constant is selected with a mask rather than a table lookup.
+ *
+ *	Tempering is a separate pass so it, too, runs as a straight vector loop.
+ *
+ ******************************************************************************************/
+
+static inline UInt32 TT800Twist(UInt32 iSeed, UInt32 iOff)
+	{ return iOff ^ (iSeed >> 1) ^ (kMagicA & (0 - (iSeed & 1))); }
+
+static void
+RegenerateBlock(
+	UInt32 ioSeeds[])
+	
+	{
+	int i;
+	
+	for (i = 0; i < kTT800SeedArraySize - kTT800SeedArrayOffset; i += 1)
+		ioSeeds[i] = TT800Twist(ioSeeds[i], ioSeeds[i + kTT800SeedArrayOffset]);
+	for ( ; i < kTT800SeedArraySize; i += 1)
+		ioSeeds[i] = TT800Twist(ioSeeds[i], ioSeeds[i + kTT800SeedArrayOffset - kTT800SeedArraySize]);
+	}
+
+static void
+TemperBlock(
+	const UInt32	iSeeds[],
+	UInt32			oOut[])
+	
+	{
+	int i;
+	
+	for (i = 0; i < kTT800SeedArraySize; i += 1) {
+		UInt32 y = iSeeds[i];
+		
+		y ^= (y << 7) & kMagicB;
+		y ^= (y << 15) & kMagicC;
+		oOut[i] = y ^ (y >> 16);
+		}
+	}
+
+
 /******************************************************************************************
  *
  *	TT800(iData)
+ *	TT800Fill(iData, oBuf, iCount)
+ *
+ *	Matsumoto's TT800 algorithm. Outputs come from the pre-tempered block, so the usual
+ *	call is an index check and a load.
  *
- *	Matsumoto's TT800 algorithm, with a few minor speed optimizations.
+ *	TT800Fill() writes iCount consecutive outputs to oBuf; the sequence is identical to
+ *	calling TT800() iCount times. Whole blocks are tempered straight into oBuf.
  *
  ******************************************************************************************/
 
-unsigned long
+UInt32
 TT800(
 	tTT800DataPtr	iData)
 	
 	{
-	// The following values are magic that TT800 depends on, don't change.
-	const UInt32	kMagicA[]			= {0x0, 0x8ebfd028},
-	    			kMagicB				= 0x2b5b2500,
-	    			kMagicC				= 0xdb8b0000;
-		// The following  be less than kTT800SeedArraySize. There may be other
-		// requirements but if 7 is good enough for Matsumoto, it's good enough for us!
-	const int		kTT800SeedArrayOffset	= 7;	
-	
-	UInt32	y;
 	
 	if (iData == NULL)
 		iData = &sTT800Data;
 	
 	if (iData->curSeed >= kTT800SeedArraySize) {
-		// Generate N new random values at one time
-    	unsigned long*	curSeed	= iData->seeds;
-    	unsigned long*	offSet	= curSeed + kTT800SeedArrayOffset;
-    	int				i;
-		
-		i = kTT800SeedArraySize - kTT800SeedArrayOffset;
-		while (i-- > 0) {
-			*curSeed = *offSet++ ^ (*curSeed >> 1) ^ kMagicA[*curSeed & 1];
-			curSeed += 1;
-			}
-		*offSet -= kTT800SeedArraySize;		// ASSERT: offSet == me->seedArray
-		
-		i = kTT800SeedArrayOffset;
-		while (i-- > 0) {
-			*curSeed = *offSet++ ^ (*curSeed >> 1) ^ kMagicA[*curSeed & 1];
-			curSeed += 1;
-			}
-		
+		RegenerateBlock(iData->seeds);
+		TemperBlock(iData->seeds, iData->outputs);
 		iData->curSeed = 0;
 		}
     
-    y = iData->seeds[iData->curSeed++];
-    y ^= (y << 7) & kMagicB;
-    y ^= (y << 15) & kMagicC;
-    
-	return y ^ (y >> 16);
+	return iData->outputs[iData->curSeed++];
+	}
+
+void
+TT800Fill(
+	tTT800DataPtr	iData,
+	UInt32			oBuf[],
+	long			iCount)
+	
+	{
+	
+	if (iData == NULL)
+		iData = &sTT800Data;
+	
+	// Use up what's left of the current block
+	while (iCount > 0 && iData->curSeed < kTT800SeedArraySize) {
+		*oBuf++	= iData->outputs[iData->curSeed++];
+		iCount	-= 1;
+		}
+	
+	// Whole blocks bypass outputs[]. ASSERT: curSeed == kTT800SeedArraySize here
+	while (iCount >= kTT800SeedArraySize) {
+		RegenerateBlock(iData->seeds);
+		TemperBlock(iData->seeds, oBuf);
+		oBuf	+= kTT800SeedArraySize;
+		iCount	-= kTT800SeedArraySize;
+		}
+	
+	// Partial block at the end
+	while (iCount-- > 0)
+		*oBuf++ = TT800(iData);
+	
 	}
 
 
@@ -176,6 +241,7 @@ TT800Seed(
 		iSalt = RotateBits(iSalt, (newSeed & 0x01) ? i + 1 : 31 - i);
 		}
 	
+	TemperBlock(iData->seeds, iData->outputs);
 	iData->curSeed = 0;
 	
 	}
@@ -191,7 +257,7 @@ TT800Seed(
 
 tTT800DataPtr
 TT800New(
-	unsigned long iSeed)
+	UInt32 iSeed)
 	
 	{
 	tTT800DataPtr newTT800 = (tTT800DataPtr) getbytes(sizeof(tTT800Data));
@@ -205,3 +271,205 @@ TT800New(
 	}
 
 
+#pragma mark -
+#pragma mark • Jump Ahead
+
+/******************************************************************************************
+ *
+ *	Polynomial arithmetic for jumping ahead
+ *
+ *	The 25 seeds are a window onto a linear recurrence over GF(2) with an 800-bit state.
+ *	Advancing J steps means applying T^J, T being the one-step transition. By Cayley-
+ *	Hamilton, T^J = q(T) with q(x) = x^J mod p(x), p being the characteristic polynomial
+ *	of T. We find p once, with Berlekamp-Massey on one bit of the raw sequence, and then
+ *	evaluate q(T) on the seeds with Horner's rule. This is the method of Haramoto et al.
+ *	for the Mersenne Twister, which carries over directly.
+ *
+ *	A polynomial is a bit vector, with bit i holding the coefficient of x^i.
+ *
+ ******************************************************************************************/
+
+enum {
+	kStateBits	= 32 * kTT800SeedArraySize,
+	kPolyWords	= kTT800SeedArraySize + 1				// Room for the x^800 term of p
+	};
+
+typedef UInt32 tPoly[kPolyWords];
+
+static tPoly	sCharPoly;
+static Boolean	sCharPolyInited	= false;
+static tPoly	sJumpPoly;
+static int		sJumpLog2		= -1;
+
+static inline int PolyBit(const UInt32 iPoly[], int iBit)
+	{ return (iPoly[iBit >> 5] >> (iBit & 31)) & 1; }
+
+static void
+StepWindow(
+	UInt32 ioWin[])
+	
+	{
+	UInt32	y = TT800Twist(ioWin[0], ioWin[kTT800SeedArrayOffset]);
+	int		i;
+	
+	for (i = 1; i < kTT800SeedArraySize; i += 1)
+		ioWin[i - 1] = ioWin[i];
+	ioWin[kTT800SeedArraySize - 1] = y;
+	}
+
+static void
+CalcCharPoly(void)
+	
+	{
+	enum { kSeqLen = 2 * kStateBits };
+	
+	unsigned char	seq[kSeqLen],
+					c[kSeqLen + 1],
+					b[kSeqLen + 1],
+					t[kSeqLen + 1];
+	UInt32			win[kTT800SeedArraySize];
+	int				n, i,
+					len		= 0,
+					shift	= 1;
+	
+	// Any nonzero state will do: the characteristic polynomial is primitive
+	for (i = 0; i < kTT800SeedArraySize; i += 1)
+		win[i] = sTT800Data.seeds[i] | 1;
+	for (n = 0; n < kSeqLen; n += 1) {
+		seq[n] = win[0] & 1;
+		StepWindow(win);
+		}
+	
+	// Berlekamp-Massey over GF(2)
+	for (i = 0; i <= kSeqLen; i += 1)
+		c[i] = b[i] = 0;
+	c[0] = b[0] = 1;
+	for (n = 0; n < kSeqLen; n += 1) {
+		int d = seq[n];
+		
+		for (i = 1; i <= len; i += 1)
+			d ^= c[i] & seq[n - i];
+		
+		if (d == 0)
+			shift += 1;
+		else if (2 * len <= n) {
+			for (i = 0; i <= kSeqLen; i += 1)
+				t[i] = c[i];
+			for (i = shift; i <= kSeqLen; i += 1)
+				c[i] ^= b[i - shift];
+			for (i = 0; i <= kSeqLen; i += 1)
+				b[i] = t[i];
+			len		= n + 1 - len;
+			shift	= 1;
+			}
+		else {
+			for (i = shift; i <= kSeqLen; i += 1)
+				c[i] ^= b[i - shift];
+			shift += 1;
+			}
+		}
+	
+	// c is the connection polynomial; p is its reciprocal. ASSERT: len == kStateBits
+	for (i = 0; i < kPolyWords; i += 1)
+		sCharPoly[i] = 0;
+	for (i = 0; i <= len; i += 1)
+		if (c[len - i])
+			sCharPoly[i >> 5] |= 1UL << (i & 31);
+	
+	sCharPolyInited = true;
+	}
+
+	// oProd = iA * iB mod p. oProd may be the same as either of the inputs.
+static void
+PolyMulMod(
+	const UInt32	iA[],
+	const UInt32	iB[],
+	UInt32			oProd[])
+	
+	{
+	tPoly	r;
+	int		i, j;
+	
+	for (j = 0; j < kPolyWords; j += 1)
+		r[j] = 0;
+	
+	for (i = kStateBits - 1; i >= 0; i -= 1) {
+		// r = r * x mod p ...
+		for (j = kPolyWords - 1; j > 0; j -= 1)
+			r[j] = (r[j] << 1) | (r[j - 1] >> 31);
+		r[0] <<= 1;
+		if (PolyBit(r, kStateBits))
+			for (j = 0; j < kPolyWords; j += 1)
+				r[j] ^= sCharPoly[j];
+		
+		// ... + a * b_i
+		if (PolyBit(iB, i))
+			for (j = 0; j < kPolyWords; j += 1)
+				r[j] ^= iA[j];
+		}
+	
+	for (j = 0; j < kPolyWords; j += 1)
+		oProd[j] = r[j];
+	}
+
+
+/******************************************************************************************
+ *
+ *	TT800Jump(iData, iLog2Steps)
+ *	
+ *	Advance iData by 2^iLog2Steps outputs, as if TT800() had been called that many times.
+ *	With iLog2Steps = 400 this splits the period of 2^800 - 1 into streams that will
+ *	never overlap in practice: seed several pools identically and jump each one a
+ *	different number of times.
+ *	
+ *	The first call takes a few milliseconds to find the characteristic polynomial, and
+ *	each new jump distance needs iLog2Steps polynomial squarings (cached for the next call).
+ *	After that a jump costs about as much as generating 800 values. Do not call at
+ *	interrupt level.
+ *	
+ ******************************************************************************************/
+
+void
+TT800Jump(
+	tTT800DataPtr	iData,
+	int				iLog2Steps)
+	
+	{
+	UInt32	acc[kTT800SeedArraySize];
+	int		i, j;
+	
+	if (iLog2Steps < 0)
+		return;
+	if (iData == NULL)
+		iData = &sTT800Data;
+	
+	if (!sCharPolyInited)
+		CalcCharPoly();
+	
+	if (iLog2Steps != sJumpLog2) {
+		// x^(2^k) mod p, starting from x (p has degree 800, so x mod p = x)
+		for (j = 0; j < kPolyWords; j += 1)
+			sJumpPoly[j] = 0;
+		sJumpPoly[0] = 2;
+		for (i = 0; i < iLog2Steps; i += 1)
+			PolyMulMod(sJumpPoly, sJumpPoly, sJumpPoly);
+		sJumpLog2 = iLog2Steps;
+		}
+	
+	// Horner: acc = sum of q_i * T^i(seeds)
+	for (j = 0; j < kTT800SeedArraySize; j += 1)
+		acc[j] = 0;
+	for (i = kStateBits - 1; i >= 0; i -= 1) {
+		StepWindow(acc);
+		if (PolyBit(sJumpPoly, i))
+			for (j = 0; j < kTT800SeedArraySize; j += 1)
+				acc[j] ^= iData->seeds[j];
+		}
+	
+	// The window has moved, the position within the block has not
+	for (j = 0; j < kTT800SeedArraySize; j += 1)
+		iData->seeds[j] = acc[j];
+	TemperBlock(iData->seeds, iData->outputs);
+	
+	}
+
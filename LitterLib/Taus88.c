@@ -31,6 +31,10 @@
 
 #pragma mark • Constants
 
+enum {
+	kBitLanes		= 8,						// Streams used for one-bit noise
+	kBitsPerChunk	= kBitLanes * 32			// Samples generated per tBitLanes frame
+	};
 	
 
 
@@ -43,6 +47,10 @@
 		// but I'm wary of leaving this stuff initialized to 0s.
 tTaus88Data gTausData = {0x4a1fcf79, 0xb86271cc, 0x6c986d11};
 
+		// Private streams for Taus88BitSigVector() and Taus88BitFlipVector(). Seeded by
+		// Taus88Init()
+static tTaus88Lanes sBitLanes;
+
 #pragma mark • Initialize Global Variables
 
 
@@ -164,6 +172,183 @@ Taus88(
 		// Typecast and move t into the range -1 ≤ t < 1
 		return *((float*) &t) - 3.0f; 
 		}
+
+
+/******************************************************************************************
+ *
+ *	Taus88BitSigVector(oVector, iCount, iAmp)
+ *	Taus88BitFlipVector(iVector, oVector, iCount)
+ *	
+ *	One-bit noise: each sample is either iAmp or -iAmp (BitSigVector), or the input sample
+ *	with a random sign (BitFlipVector). iVector and oVector may be the same vector.
+ *	
+ *	Random words come from the kBitLanes private Taus88 streams, one word per lane, 256
+ *	bits per round. Sample i takes bit (i / kBitLanes) from lane (i % kBitLanes), so
+ *	each run of kBitLanes consecutive samples uses the same shift on all lanes. The bit
+ *	is XOR-ed straight into the IEEE sign bit; there are no branches, and the compiler
+ *	can expand a full vector register of bits per instruction. Any iCount is fine.
+ *	
+ ******************************************************************************************/
+
+	static inline void BitLanesRound(UInt32 oWords[])
+		{ Taus88LanesFill(&sBitLanes, oWords, 1); }
+
+	void
+	Taus88BitSigVector(
+		tSampleVector	oVector,
+		long			iCount,
+		float			iAmp)
+		
+		{
+		const UInt32 kSignBit = 0x80000000;
+		
+		UInt32	words[kBitLanes],
+				ampBits = *((UInt32*) &iAmp),
+				*out	= (UInt32*) oVector;
+		
+		while (iCount > 0) {
+			long	n = (iCount < kBitsPerChunk) ? iCount : kBitsPerChunk,
+					i;
+			
+			BitLanesRound(words);
+			for (i = 0; i < n; i += 1)
+				out[i] = ampBits ^ ((words[i % kBitLanes] << (i / kBitLanes)) & kSignBit);
+			
+			out		+= n;
+			iCount	-= n;
+			}
+		
+		}
+
+	void
+	Taus88BitFlipVector(
+		tSampleVector	iVector,
+		tSampleVector	oVector,
+		long			iCount)
+		
+		{
+		const UInt32 kSignBit = 0x80000000;
+		
+		UInt32	words[kBitLanes],
+				*in		= (UInt32*) iVector,
+				*out	= (UInt32*) oVector;
+		
+		while (iCount > 0) {
+			long	n = (iCount < kBitsPerChunk) ? iCount : kBitsPerChunk,
+					i;
+			
+			BitLanesRound(words);
+			for (i = 0; i < n; i += 1)
+				out[i] = in[i] ^ ((words[i % kBitLanes] << (i / kBitLanes)) & kSignBit);
+			
+			in		+= n;
+			out		+= n;
+			iCount	-= n;
+			}
+		
+		}
+
+
+/******************************************************************************************
+ *
+ *	Taus88SigVector64(oVector, iCount)
+ *	Taus88SigVectorMasked64(oVector, iCount, iMask, iOffset)
+ *	Taus88BitSigVector64(oVector, iCount, iAmp)
+ *	Taus88BitFlipVector64(iVector, oVector, iCount)
+ *	
+ *	Versions of the above for 64-bit signal vectors. The white noise versions keep the
+ *	full 32 bits of each random value instead of the 23 bits that fit in a float.
+ *	
+ ******************************************************************************************/
+
+	void
+	Taus88SigVector64(
+		tSampleVector64	oVector,
+		long			iCount)
+		
+		{
+		UInt32 s1, s2, s3;
+		
+		Taus88Load(&gTausData, &s1, &s2, &s3);
+		
+		while (iCount-- > 0)
+			*oVector++ = ULong2Signal64( Taus88Process(&s1, &s2, &s3) );
+		
+		Taus88Store(&gTausData, s1, s2, s3);
+		}
+
+	void
+	Taus88SigVectorMasked64(
+		tSampleVector64	oVector,
+		long			iCount,
+		UInt32			iMask,
+		UInt32			iOffset)
+		
+		{
+		UInt32 s1, s2, s3;
+		
+		Taus88Load(&gTausData, &s1, &s2, &s3);
+		
+		while (iCount-- > 0)
+			*oVector++ = ULong2Signal64((Taus88Process(&s1, &s2, &s3) & iMask) + iOffset);
+		
+		Taus88Store(&gTausData, s1, s2, s3);
+		}
+
+	void
+	Taus88BitSigVector64(
+		tSampleVector64	oVector,
+		long			iCount,
+		double			iAmp)
+		
+		{
+		const UInt64 kSignBit = 0x8000000000000000ULL;
+		
+		UInt32	words[kBitLanes];
+		UInt64	ampBits = *((UInt64*) &iAmp),
+				*out	= (UInt64*) oVector;
+		
+		while (iCount > 0) {
+			long	n = (iCount < kBitsPerChunk) ? iCount : kBitsPerChunk,
+					i;
+			
+			BitLanesRound(words);
+			for (i = 0; i < n; i += 1)
+				out[i] = ampBits ^ (((UInt64) (words[i % kBitLanes] << (i / kBitLanes)) << 32) & kSignBit);
+			
+			out		+= n;
+			iCount	-= n;
+			}
+		
+		}
+
+	void
+	Taus88BitFlipVector64(
+		tSampleVector64	iVector,
+		tSampleVector64	oVector,
+		long			iCount)
+		
+		{
+		const UInt64 kSignBit = 0x8000000000000000ULL;
+		
+		UInt32	words[kBitLanes];
+		UInt64	*in		= (UInt64*) iVector,
+				*out	= (UInt64*) oVector;
+		
+		while (iCount > 0) {
+			long	n = (iCount < kBitsPerChunk) ? iCount : kBitsPerChunk,
+					i;
+			
+			BitLanesRound(words);
+			for (i = 0; i < n; i += 1)
+				out[i] = in[i] ^ (((UInt64) (words[i % kBitLanes] << (i / kBitLanes)) << 32) & kSignBit);
+			
+			in		+= n;
+			out		+= n;
+			iCount	-= n;
+			}
+		
+		}
 #endif		// __MAX_MSP_OBJECT__
 
 
@@ -185,6 +370,7 @@ Taus88Init(void)
 
 	if (!sTaus88Inited) {
 		Taus88Seed(NULL, 0);
+		Taus88LanesSeed(&sBitLanes, kBitLanes, 0);
 		sTaus88Inited = true;
 		}
 	
@@ -278,3 +464,104 @@ Taus88New(
 void Taus88Free(tTaus88DataPtr iTaus)
 	{ if (iTaus != NIL) DisposePtr((Ptr) iTaus); }
 
+
+
+#pragma mark -
+#pragma mark • Split Streams
+
+/******************************************************************************************
+ *
+ *	Taus88LanesSeed(ioLanes, iLaneCount, iSalt)
+ *	Taus88LanesFill(ioLanes, oBuf, iFrames)
+ *	
+ *	A tTaus88Lanes holds up to kTaus88MaxLanes independent Taus88 streams, one for each
+ *	channel of a multichannel object. Each lane is seeded exactly as Taus88Seed() would
+ *	seed a private pool, using a salt that is spread across lanes with the golden ratio
+ *	increment. If iSalt is 0 a salt is taken from MachineKharma().
+ *	
+ *	Taus88LanesFill() advances all lanes iFrames times and writes the results interleaved,
+ *	i.e., oBuf[frame * laneCount + lane]. The seeds are copied to local arrays for the
+ *	duration of the call, the inner loop has no dependencies between lanes.
+ *	
+ ******************************************************************************************/
+
+void
+Taus88LanesSeed(
+	tTaus88LanesPtr	ioLanes,
+	int				iLaneCount,
+	UInt32			iSalt)
+	
+	{
+	const UInt32 kGolden = 0x9e3779b9;
+	
+	tTaus88Data	laneData;
+	int			i;
+	
+	if (iLaneCount < 1)
+		iLaneCount = 1;
+	else if (iLaneCount > kTaus88MaxLanes)
+		iLaneCount = kTaus88MaxLanes;
+	
+	if (iSalt == 0)
+		iSalt = MachineKharma();				// Already salted per call, so two objects
+												// created in the same tick still differ
+	
+	for (i = 0; i < iLaneCount; i += 1) {
+		UInt32 laneSalt = iSalt + i * kGolden;
+		
+		// Taus88Seed() would interpret 0 as "make up your own"; don't let that happen
+		Taus88Seed(&laneData, (laneSalt != 0) ? laneSalt : kGolden);
+		
+		ioLanes->seed1[i] = laneData.seed1;
+		ioLanes->seed2[i] = laneData.seed2;
+		ioLanes->seed3[i] = laneData.seed3;
+		}
+	
+	ioLanes->laneCount = iLaneCount;
+	}
+
+void
+Taus88LanesFill(
+	tTaus88LanesPtr	ioLanes,
+	UInt32			oBuf[],
+	long			iFrames)
+	
+	{
+	const UInt32	tausMagic1	= 0xfffffffe,
+					tausMagic2	= 0xfffffff8,
+					tausMagic3	= 0xfffffff0;
+	const int		laneCount	= ioLanes->laneCount;
+	
+	UInt32	s1[kTaus88MaxLanes],
+			s2[kTaus88MaxLanes],
+			s3[kTaus88MaxLanes];
+	int		i;
+	
+	for (i = 0; i < laneCount; i += 1) {
+		s1[i] = ioLanes->seed1[i];
+		s2[i] = ioLanes->seed2[i];
+		s3[i] = ioLanes->seed3[i];
+		}
+	
+	while (iFrames-- > 0) {
+		for (i = 0; i < laneCount; i += 1) {
+			UInt32	b1 = ((s1[i] << 13) ^ s1[i]) >> 19,
+					b2 = ((s2[i] << 2) ^ s2[i]) >> 25,
+					b3 = ((s3[i] << 3) ^ s3[i]) >> 11;
+			
+			s1[i] = ((s1[i] & tausMagic1) << 12) ^ b1;
+			s2[i] = ((s2[i] & tausMagic2) << 4) ^ b2;
+			s3[i] = ((s3[i] & tausMagic3) << 17) ^ b3;
+			
+			oBuf[i] = s1[i] ^ s2[i] ^ s3[i];
+			}
+		oBuf += laneCount;
+		}
+	
+	for (i = 0; i < laneCount; i += 1) {
+		ioLanes->seed1[i] = s1[i];
+		ioLanes->seed2[i] = s2[i];
+		ioLanes->seed3[i] = s3[i];
+		}
+	
+	}
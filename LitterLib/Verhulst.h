@@ -0,0 +1,155 @@
+/*
+	File:		Verhulst.h
+
+	Contains:	The Verhulst population growth models shared by lp.poppy, lp.poppy~, the
+				lp.vera family and lbj.vera: growth formulas, the functions lp.vera applies
+				to the population, and the names these go by in messages and attributes.
+
+	Written by:	Peter Castine
+
+	Copyright:	© 2026 Peter Castine
+
+	Change History (most recent first):
+
+*/
+
+
+/******************************************************************************************
+
+	Everything here is inline. Callers that iterate many populations with the same map and
+	function should switch on the map/function once and call VerhulstFunc() and
+	VerhulstGrowth() with a constant selector inside the loop; the compiler then drops the
+	switch and the loop body reduces to the bare formula.
+
+ ******************************************************************************************/
+
+#pragma once
+#ifndef __VERHULST_H__
+#define __VERHULST_H__
+
+
+#pragma mark • Include Files
+
+#ifndef __LITTERLIB_H__
+	#include "LitterLib.h"									// For kPi
+#endif
+
+#include <math.h>
+
+
+#pragma mark • Constants
+
+	// The growth formulas. Names match the Max class names of the point-stream objects,
+	// minus the "lp." prefix.
+enum Map {
+	mapPoppy		= 0,				// p' <- r·p·(1-p)
+	mapVera,							// p' <- p + r·f(p)·(1-f(p))
+	mapVeraPlus,						// p' <- p + r·f(p)
+	mapVeraIs,							// p' <- r·f(p)
+	mapVeraL,							// p' <- r·f(p)·(1-f(p))
+	mapVeraS,							// p' <- r·f(p)² - 1
+	mapVeraM,							// p' <- r·p / (p+1)^beta
+
+	mapFirst		= mapPoppy,
+	mapLast			= mapVeraM
+	};
+
+static const char* const kMapNames[mapLast + 1]
+						= {	"poppy",
+							"vera",
+							"vera+",
+							"vera=",
+							"veral",
+							"veras",
+							"veram"
+							};
+
+	// The functions f() the vera maps apply to the population before feeding it to the
+	// growth formula. (mapVeraM always uses (p+1)^beta; mapPoppy uses no function.)
+enum Function {
+	fnIdent			= 0,
+	fnZero,
+	fnOne,
+	fnRecip,
+	fnSinPi,
+	fnCosPi,
+	fnTanPi,
+	fnCotPi,
+	fnSinh,
+	fnCosh,
+	fnTanh,
+	fnLog,
+	fnExp,
+	fnSqr,
+	fnRoot,
+
+	fnFirst		= fnIdent,
+	fnLast		= fnRoot
+	};
+
+static const char* const kFuncNames[fnLast + 1]
+						= {	"ident",
+							"zero",
+							"one",
+							"recip",
+							"sinpi",
+							"cospi",
+							"tanpi",
+							"cotpi",
+							"sinh",
+							"cosh",
+							"tanh",
+							"log",
+							"exp",
+							"sqr",
+							"sqrt"
+							};
+
+
+#pragma mark • Type Definitions
+
+typedef enum Map		tMap;
+typedef enum Function	tFunction;
+
+
+#pragma mark -
+#pragma mark • Inline Functions
+
+static inline double VerhulstFunc(tFunction iFunc, double iPop)
+	{
+	switch (iFunc) {
+		case fnZero:	return 0.0;
+		case fnOne:		return 1.0;
+		case fnRecip:	return 1.0 / iPop;
+		case fnSinPi:	return sin(kPi * iPop);
+		case fnCosPi:	return cos(kPi * iPop);
+		case fnTanPi:	return tan(kPi * iPop);
+		case fnCotPi:	return 1 / tan(kPi * iPop);
+		case fnSinh:	return sinh(iPop);
+		case fnCosh:	return cosh(iPop);
+		case fnTanh:	return tanh(iPop);
+		case fnLog:		return log(iPop);
+		case fnExp:		return exp(iPop);
+		case fnSqr:		return iPop * iPop;
+		case fnRoot:	return sqrt(iPop);
+			// Only thing left is fnIdent
+		default:		return iPop;
+		}
+	}
+
+	// iFnPop is f(p) for the vera maps, (p+1)^beta for mapVeraM; mapPoppy ignores it.
+static inline double VerhulstGrowth(tMap iMap, double iPop, double iFnPop, double iGrowth)
+	{
+	switch (iMap) {
+		case mapVera:		return iPop + iGrowth * iFnPop * (1.0 - iFnPop);
+		case mapVeraPlus:	return iPop + iGrowth * iFnPop;
+		case mapVeraIs:		return iGrowth * iFnPop;
+		case mapVeraL:		return iGrowth * iFnPop * (1.0 - iFnPop);
+		case mapVeraS:		return iGrowth * iFnPop * iFnPop - 1.;
+		case mapVeraM:		return iGrowth * iPop / iFnPop;
+			// Only thing left is mapPoppy
+		default:			return iGrowth * iPop * (1.0 - iPop);
+		}
+	}
+
+#endif		// __VERHULST_H__
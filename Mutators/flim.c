@@ -30,6 +30,8 @@
 #include "TrialPeriodUtils.h"
 #include "imLib.h"
 
+#include "buffer.h"				// For buffer~ mode
+
 
 #pragma mark • Constants
 
@@ -39,6 +41,7 @@ const char*	kClassName		= "lp.vim";				// Class name
 #pragma mark • Function Prototypes
 
 void*	NewMutator(Symbol*, short, Atom*);
+void	FlimFree(tMutator*);
 
 	// Various Max messages
 void	FlimAssist(tMutator*, void* , long , long , char*);
@@ -59,6 +62,11 @@ static void FlimOmegaInt(tMutator*, long);
 static void FlimPiInt(tMutator*, long);
 static void FlimDeltaInt(tMutator*, long);
 
+	// List and buffer~ mode
+static void	FlimList(tMutator*, Symbol*, short, Atom[]);
+static void	FlimTargetList(tMutator*, Symbol*, short, Atom[]);
+static void	FlimBuffer(tMutator*, Symbol*, Symbol*, Symbol*);
+
 #pragma mark -
 /*****************************  I M P L E M E N T A T I O N  ******************************/
 
@@ -79,7 +87,7 @@ main(void)
 	// Standard Max setup() call
 	setup(	&gObjectClass,				// Pointer to our class definition
 			(method) NewMutator,		// Instance creation function
-			NIL,						// No custom deallocation function
+			(method) FlimFree,			// Custom deallocation function
 			(short) sizeof(tMutator),	// Class object size
 			NIL,						// No menu function
 			A_GIMME,					// We parse our arguments
@@ -107,6 +115,7 @@ main(void)
 	// Vaguely standard messages
 	addmess ((method) DoClear,			"clear",	A_NOTHING);
 	addmess	((method) FlimSet,			"set",		A_DEFFLOAT, 0);
+	LITTER_TIMEBOMB addmess	((method) FlimList,	"list",		A_GIMME, 0);
 	
 	//Our messages
 	addmess ((method) DoUSIM,			"usim",		A_NOTHING);
@@ -123,6 +132,9 @@ main(void)
 	addmess	((method) FlimClumpTight,	"tight",	A_DEFLONG, 0);
 	addmess ((method) FlimClumpHard,	"hard",		A_DEFLONG, 0);
 	
+	addmess ((method) FlimTargetList,	"target",	A_GIMME, 0);
+	addmess ((method) FlimBuffer,		"buffer",	A_SYM, A_DEFSYM, A_DEFSYM, 0);
+	
 	// Initialize Litter Library
 	LitterInit(kClassName, 0);
 	Taus88Init();
@@ -211,16 +223,35 @@ NewMutator(
 	floatin(me, 1);
 	
 	// And outlet, main outlet accessed through me->coreObject.o_outlet.
-	floatout(me);			
+	// Untyped, as list mode sends lists through it.
+	outlet_new(me, NIL);
 	
 	// Set up default/initial values
 	Initialize(me, initType, initOmega, initPi, initDelta, gotInitDelta);
 	
 	me->pendTarget	= 0.0;
+	me->listTargets	= 0;
+	me->listSize	= 0;
+	me->listBuf		= NIL;
 	
 	return me;
 	}
 
+/******************************************************************************************
+ *
+ *	FlimFree(me)
+ *
+ ******************************************************************************************/
+
+void
+FlimFree(
+	tMutator* me)
+	
+	{
+	if (me->listBuf != NIL)
+		DisposePtr((Ptr) me->listBuf);
+	}
+
 #pragma mark -
 #pragma mark • Object Message Handlers
 
@@ -281,11 +312,18 @@ NewMutator(
 	static double CalcRelIrreg(tMutator* me, tInterval iSource)
 		{
 		tInterval	deltaSource = iSource - me->history.source;
-		double		deltaMutant = MutateOrNot(me)
-									? me->params.function.irregularFunc(deltaSource,
-																me->pendTarget - me->history.target)
-									: deltaSource,
+		double		deltaMutant,
 					deltaEmph	= me->params.delta;
+		
+		if ( MutateOrNot(me) ) {
+			me->history.state = stateTarget;
+			deltaMutant = me->params.function.irregularFunc(deltaSource,
+															me->pendTarget - me->history.target);
+			}
+		else {
+			me->history.state = stateSource;
+			deltaMutant = deltaSource;
+			}
 				
 		return (deltaEmph >= 0)
 				? EmphasizePos(me->history.mutant, deltaMutant, 1.0 - deltaEmph)
@@ -347,7 +385,8 @@ FlimTarget(
 	double		iTarget)
 	
 	{
-	me->pendTarget = iTarget;
+	me->pendTarget	= iTarget;
+	me->listTargets	= 0;					// A single target replaces any target list
 	}
 
 /******************************************************************************************
@@ -427,6 +466,9 @@ FlimTattle(
 	post("Previous Source: %lf, Target: %lf, Mutant: %lf",
 		me->history.source, me->history.target, me->history.mutant);
 	
+	if (me->listTargets > 0)
+		post("  Target list of %ld values pending", me->listTargets);
+	
 	}
 
 
@@ -447,3 +489,408 @@ void FlimClumpTight(tMutator*me , long iClumpSize)
 void FlimClumpHard(tMutator*me , long iClumpSize)
 	{ me->params.clumpLen = (iClumpSize >= 0) ? -iClumpSize : 0; }
 
+
+#pragma mark -
+#pragma mark • List and buffer~ Mode
+
+/******************************************************************************************
+ *
+ *	ListTargets(me), ListSources(me), ListMutants(me), ListWork(me), ListAtoms(me)
+ *	GrowListBuf(me, iCount)
+ *
+ *	Everything list mode needs lives in one block, listBuf, laid out as
+ *		- listSize pending targets
+ *		- listSize source values (buffer~ mode converts samples to double here)
+ *		- listSize mutants
+ *		- 2 * listSize of work space (relative intervals)
+ *		- listSize Atoms for the output list
+ *	GrowListBuf() makes sure there is room for iCount elements, keeping any pending
+ *	targets. Returns false if memory is short.
+ *
+ ******************************************************************************************/
+
+static inline double* ListTargets(tMutator* me)
+	{ return me->listBuf; }
+static inline double* ListSources(tMutator* me)
+	{ return me->listBuf + me->listSize; }
+static inline double* ListMutants(tMutator* me)
+	{ return me->listBuf + 2 * me->listSize; }
+static inline double* ListWork(tMutator* me)
+	{ return me->listBuf + 3 * me->listSize; }
+static inline Atom* ListAtoms(tMutator* me)
+	{ return (Atom*) (me->listBuf + 5 * me->listSize); }
+
+static Boolean
+GrowListBuf(
+	tMutator*	me,
+	long		iCount)
+	
+	{
+	double* newBuf;
+	
+	if (iCount <= me->listSize)
+		return true;
+	
+	newBuf = (double*) NewPtr(iCount * (5 * sizeof(double) + sizeof(Atom)));
+	if (newBuf == NIL) {
+		error("%s: can't allocate memory for %ld element list", kClassName, iCount);
+		return false;
+		}
+	
+	if (me->listBuf != NIL) {
+		BlockMoveData((Ptr) me->listBuf, (Ptr) newBuf, me->listTargets * sizeof(double));
+		DisposePtr((Ptr) me->listBuf);
+		}
+	
+	me->listBuf		= newBuf;
+	me->listSize	= iCount;
+	
+	return true;
+	}
+
+
+/******************************************************************************************
+ *
+ *	UniformKernel(iType, iCount, iSource, iTarget, oMutant, iOmega)
+ *	IrregularKernel(me, iType, iCount, iSource, iTarget, oMutant)
+ *	MutateBlock(me, iCount, iSource, iTarget, oMutant)
+ *
+ *	Block versions of FlimSet(). MutateBlock() mutates iCount values exactly as if they
+ *	had arrived one after the other at the left inlet, each with its own target, and
+ *	leaves the history where the last of them would have.
+ *
+ *	The kernels are called with a constant mutation type, so the switches in
+ *	MutateUniform() and MutateIrregular() fold away and the loops vectorize. The parts
+ *	that really are sequential are pulled out into separate, simple loops: the Markov
+ *	chain deciding which values are mutated (one Taus88 value per element, as in
+ *	MutateOrNot()) and the delta emphasis for relative intervals.
+ *
+ ******************************************************************************************/
+
+static inline void
+UniformKernel(
+	int				iType,
+	long			iCount,
+	const double	iSource[],
+	const double	iTarget[],
+	double			oMutant[],
+	double			iOmega)
+	
+	{
+	long i;
+	
+	for (i = 0; i < iCount; i += 1)
+		oMutant[i] = MutateUniform(iType, iSource[i], iTarget[i], iOmega);
+	}
+
+static inline void
+IrregularKernel(
+	int				iType,
+	long			iCount,
+	const double	iSource[],
+	const double	iTarget[],
+	double			ioMutant[])
+	
+	{
+	long i;
+	
+	// On entry ioMutant[] flags the elements to mutate
+	for (i = 0; i < iCount; i += 1)
+		ioMutant[i] = (ioMutant[i] != 0.0)
+						? MutateIrregular(iType, iSource[i], iTarget[i])
+						: iSource[i];
+	}
+
+static void
+MutateBlock(
+	tMutator*		me,
+	long			iCount,
+	const double	iSource[],
+	const double	iTarget[],
+	double			oMutant[])
+	
+	{
+	const int		kType	= CalcMutationIndex(me);
+	const double	kOmega	= me->params.omega;
+	
+	const double*	src		= iSource;
+	const double*	tgt		= iTarget;
+	long			i;
+	
+	if (iCount <= 0)
+		return;
+	
+	// Relative intervals: mutate the differences between successive values
+	if (me->params.relInterval) {
+		double*	srcInt = ListWork(me);
+		double*	tgtInt = srcInt + me->listSize;
+		
+		srcInt[0] = iSource[0] - me->history.source;
+		tgtInt[0] = iTarget[0] - me->history.target;
+		for (i = 1; i < iCount; i += 1) {
+			srcInt[i] = iSource[i] - iSource[i-1];
+			tgtInt[i] = iTarget[i] - iTarget[i-1];
+			}
+		
+		src = srcInt;
+		tgt = tgtInt;
+		}
+	
+	if (!me->params.irregular) {
+		switch (kType) {
+			case imUUIM:	UniformKernel(imUUIM, iCount, src, tgt, oMutant, kOmega);	break;
+			case imWCM:		UniformKernel(imWCM, iCount, src, tgt, oMutant, kOmega);	break;
+			default:		UniformKernel(imUSIM, iCount, src, tgt, oMutant, kOmega);	break;
+			}
+		}
+	
+	else {
+		double			omegaPrime	= CalcOmegaPrime(kOmega, me->params.pi);
+		unsigned long	initThresh	= CalcInitThresh(kOmega),
+						srcThresh	= CalcSourceToMutantThresh(kOmega, omegaPrime),
+						mutThresh	= CalcMutantToMutantThresh(omegaPrime);
+		Byte			state		= me->history.state;
+		UInt32			s1, s2, s3;
+		
+		Taus88LoadGlobal(&s1, &s2, &s3);
+		for (i = 0; i < iCount; i += 1) {
+			unsigned long thresh = (state == stateSource)
+										? srcThresh
+										: (state == stateTarget) ? mutThresh : initThresh;
+			
+			state = (Taus88Process(&s1, &s2, &s3) < thresh) ? stateTarget : stateSource;
+			oMutant[i] = (state == stateTarget);
+			}
+		Taus88StoreGlobal(s1, s2, s3);
+		
+		me->history.state = state;
+		
+		switch (kType) {
+			case imIUIM:	IrregularKernel(imIUIM, iCount, src, tgt, oMutant);			break;
+			case imLCM:		IrregularKernel(imLCM, iCount, src, tgt, oMutant);			break;
+			default:		IrregularKernel(imISIM, iCount, src, tgt, oMutant);			break;
+			}
+		}
+	
+	if (me->params.relInterval) {
+		double	prevCoeff	= EmphPrevCoeff(me->params.delta),
+				intCoeff	= EmphIntCoeff(me->params.delta),
+				mutant		= me->history.mutant;
+		
+		for (i = 0; i < iCount; i += 1)
+			oMutant[i] = mutant = prevCoeff * mutant + intCoeff * oMutant[i];
+		}
+	
+	me->history.source = iSource[iCount - 1];
+	me->history.target = iTarget[iCount - 1];
+	me->history.mutant = oMutant[iCount - 1];
+	}
+
+
+/******************************************************************************************
+ *
+ *	FillTargets(me, iCount)
+ *
+ *	Targets for list and buffer~ mode are whatever the target message set; if that list is
+ *	shorter than the sources (or empty), the remaining elements use the last float received
+ *	in the target inlet.
+ *
+ ******************************************************************************************/
+
+static void
+FillTargets(
+	tMutator*	me,
+	long		iCount)
+	
+	{
+	double* tgt = ListTargets(me);
+	long	i;
+	
+	for (i = me->listTargets; i < iCount; i += 1)
+		tgt[i] = me->pendTarget;
+	}
+
+
+/******************************************************************************************
+ *
+ *	FlimList(me, sym, iArgC, iArgV)
+ *	FlimTargetList(me, sym, iArgC, iArgV)
+ *
+ *	A list in the left inlet is mutated as a whole and sent out as a single list. The
+ *	targets come from the most recent target message.
+ *
+ ******************************************************************************************/
+
+static void
+FlimList(
+	tMutator*	me,
+	Symbol*		sym,
+	short		iArgC,
+	Atom		iArgV[])
+	
+	{
+	#pragma unused(sym)
+	
+	double*	src;
+	double*	mut;
+	Atom*	atoms;
+	long	i;
+	
+	if (iArgC <= 0 || !GrowListBuf(me, iArgC))
+		return;
+	
+	src = ListSources(me);
+	for (i = 0; i < iArgC; i += 1)
+		src[i] = AtomGetFloat(&iArgV[i]);
+	FillTargets(me, iArgC);
+	
+	mut = ListMutants(me);
+	MutateBlock(me, iArgC, src, ListTargets(me), mut);
+	
+	atoms = ListAtoms(me);
+	for (i = 0; i < iArgC; i += 1)
+		AtomSetFloat(&atoms[i], mut[i]);
+	
+	outlet_list(me->coreObject.o_outlet, NIL, iArgC, atoms);
+	}
+
+static void
+FlimTargetList(
+	tMutator*	me,
+	Symbol*		sym,
+	short		iArgC,
+	Atom		iArgV[])
+	
+	{
+	#pragma unused(sym)
+	
+	double*	tgt;
+	long	i;
+	
+	me->listTargets = 0;
+	if (iArgC <= 0 || !GrowListBuf(me, iArgC))
+		return;
+	
+	tgt = ListTargets(me);
+	for (i = 0; i < iArgC; i += 1)
+		tgt[i] = AtomGetFloat(&iArgV[i]);
+	me->listTargets = iArgC;
+	}
+
+
+/******************************************************************************************
+ *
+ *	FlimBuffer(me, iSource, iTarget, iDest)
+ *
+ *	Mutate the contents of buffer~ iSource (against the contents of buffer~ iTarget, if
+ *	specified, otherwise against the pending targets) and write the result to buffer~
+ *	iDest, or back into iSource if no destination is given. Multichannel buffers are
+ *	treated as one sequence of samples in their interleaved order. A target buffer~
+ *	shorter than the source is padded as in FillTargets().
+ *
+ *	All three buffer~s are flagged in use while we read and write them (save b_inuse, set
+ *	it, restore it afterwards, as in DrawUtils.c and gruyere~). They may be the same
+ *	buffer~, so the flags are restored in the reverse order they were saved. Finally the
+ *	destination is told that it is dirty.
+ *
+ ******************************************************************************************/
+
+	static t_buffer* LookupBuffer(Symbol* iSym)
+		{
+		t_buffer* buf;
+		
+		if (iSym == NIL || iSym == gensym(""))
+			return NIL;
+		
+		buf = (t_buffer*) iSym->s_thing;
+		if (buf == NIL || ob_sym(buf) != gensym("buffer~") || !buf->b_valid) {
+			error("%s: no buffer~ %s", kClassName, iSym->s_name);
+			return NIL;
+			}
+		
+		return buf;
+		}
+
+static void
+FlimBuffer(
+	tMutator*	me,
+	Symbol*		iSource,
+	Symbol*		iTarget,
+	Symbol*		iDest)
+	
+	{
+	t_buffer*	srcBuf	= LookupBuffer(iSource);
+	t_buffer*	tgtBuf	= NIL;
+	t_buffer*	dstBuf	= srcBuf;
+	long		count,
+				i;
+	double*		src;
+	double*		tgt;
+	double*		mut;
+	float*		samples;
+	Boolean		srcInUse,
+				tgtInUse = false,
+				dstInUse;
+	
+	if (srcBuf == NIL)
+		return;
+	if (iTarget != NIL && iTarget != gensym("")) {
+		tgtBuf = LookupBuffer(iTarget);
+		if (tgtBuf == NIL) return;
+		}
+	if (iDest != NIL && iDest != gensym("")) {
+		dstBuf = LookupBuffer(iDest);
+		if (dstBuf == NIL) return;
+		}
+	
+	count = srcBuf->b_frames * srcBuf->b_nchans;
+	if (count <= 0 || !GrowListBuf(me, count))
+		return;
+	
+	srcInUse		= srcBuf->b_inuse;
+	srcBuf->b_inuse	= true;
+	if (tgtBuf != NIL) {
+		tgtInUse		= tgtBuf->b_inuse;
+		tgtBuf->b_inuse	= true;
+		}
+	dstInUse		= dstBuf->b_inuse;
+	dstBuf->b_inuse	= true;
+	
+	src		= ListSources(me);
+	tgt		= ListTargets(me);
+	mut		= ListMutants(me);
+	samples	= srcBuf->b_samples;
+	for (i = 0; i < count; i += 1)
+		src[i] = samples[i];
+	
+	if (tgtBuf != NIL) {
+		long tgtCount = tgtBuf->b_frames * tgtBuf->b_nchans;
+		
+		if (tgtCount > count)
+			tgtCount = count;
+		samples = tgtBuf->b_samples;
+		for (i = 0; i < tgtCount; i += 1)
+			tgt[i] = samples[i];
+		for ( ; i < count; i += 1)
+			tgt[i] = me->pendTarget;
+		
+		// The target buffer~ overwrote any pending target list
+		me->listTargets = 0;
+		}
+	else FillTargets(me, count);
+	
+	MutateBlock(me, count, src, tgt, mut);
+	
+	if (count > dstBuf->b_frames * dstBuf->b_nchans)
+		count = dstBuf->b_frames * dstBuf->b_nchans;
+	samples = dstBuf->b_samples;
+	for (i = 0; i < count; i += 1)
+		samples[i] = mut[i];
+	
+	dstBuf->b_inuse = dstInUse;
+	if (tgtBuf != NIL)
+		tgtBuf->b_inuse = tgtInUse;
+	srcBuf->b_inuse = srcInUse;
+	
+	object_method(dstBuf, gensym("dirty"));
+	}
@@ -36,6 +36,12 @@
 
 const char*	kClassName		= "lp.frim~";			// Class name
 
+enum {
+	kMutateBlock		= 256,						// Bins per decision pass
+	kConvVectors		= 9							// Sources, targets, mutants, omega, pi,
+													// and delta for the 32-bit chain
+	};
+
 
 #pragma mark • Function Prototypes
 
@@ -52,27 +58,18 @@ void	DoOBands(tMutator*, long);
 	// MSP messages
 void	BuildDSPChain(tMutator*, t_signal**, short*);
 int*	PerformMutator(int*);
-	// The following routines are where the actual work is done.
-	// The first parameters are always: Mutator object, vector size, Source signal, Target
-	// signal, and Mutant signal. The three signals are guaranteed never to be NIL.
-	// These parameters are all followed by omega. If the mutation is irregular, the 
-	// parameter pi follows. And, finally, if the mutation is not using absolute values
-	// (i.e., it history >= 1) there is a delta parameter.
-	// With control-rate mutations, omega, delta and pi are floats (taken from the first
-	// sample of the signal if non-NIL, otherwise the current values from the Mutator object
-	// are taken).
-void	CalcAbsIrreg(	tMutator*, long,
-						t_sample*, t_sample*, t_sample*, t_sample*, t_sample*, t_sample*,
-						t_sample, t_sample);
-void	CalcAbsUniform(tMutator*, long,
-						t_sample*, t_sample*, t_sample*, t_sample*, t_sample*, t_sample*,
-						t_sample);
-void	CalcRelIrreg(	tMutator*, long,
-						t_sample*, t_sample*, t_sample*, t_sample*, t_sample*, t_sample*,
-						t_sample, t_sample, t_sample);
-void	CalcRelUniform(tMutator*, long,
-						t_sample*, t_sample*, t_sample*, t_sample*, t_sample*, t_sample*,
-						t_sample, t_sample);
+
+	// Same again for Max 6 64-bit signal vectors
+void	BuildDSPChain64(tMutator*, t_object*, short*, double, long, long);
+void	PerformMutator64(tMutator*, t_object*, double**, long, double**, long, long, long, void*);
+
+	// This is where the actual work is done, for both signal chains. After the object and
+	// vector size come the two Source, two Target, and two Mutant signals (guaranteed
+	// never to be NIL), and then the Omega, Pi, and Delta signals (NIL if not connected).
+static void	MutateVector(	tMutator*, long,
+							const double*, const double*, const double*, const double*,
+							double*, double*,
+							const double*, const double*, const double*);
 
 
 #pragma mark -
@@ -119,6 +116,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) BuildDSPChain, "dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) BuildDSPChain64, "dsp64",	A_CANT, 0);
 
 	//Our messages
 	addmess ((method) DoUSIM,		"usim",		A_NOTHING);
@@ -268,7 +266,7 @@ NewMutator(
 	double			initOmega		= 0.0,
 					initPi			= 0.0,
 					initDelta		= 0.0;
-	tMutationPtr	muBuffer		= NIL;
+	float*			planeBuffer		= NIL;
 	BytePtr			stateBuffer		= NIL;
 	
 	tMutator*		me				= NIL;
@@ -328,8 +326,10 @@ NewMutator(
 		// This is the critical point in initialization; allocating memory
 		// for storing Source, Target, and Mutant signal values for the length
 		// specified by histSize.
-		muBuffer = (tMutationPtr) NewPtrClear(histSize * sizeof(tMutation));
-			if (muBuffer == NIL) goto punt;
+		// Six planes: source, target, and mutant, each with real/amplitude and
+		// imaginary/phase components.
+		planeBuffer = (float*) NewPtrClear(6 * histSize * sizeof(float));
+			if (planeBuffer == NIL) goto punt;
 		stateBuffer = (BytePtr) NewPtrClear((nyquist + 1) * sizeof(Byte));
 			if (stateBuffer == NIL) goto punt;
 		}
@@ -349,10 +349,17 @@ NewMutator(
 	me->history.bufSize		= histSize;
 	me->history.bufIndex	= 0;
 	me->history.nyquist		= nyquist;
-	me->history.muBuffer	= me->history.curMu
-							= muBuffer;
-	me->history.stateBuf	= me->history.curState
-							= stateBuffer;
+	me->history.planeBuf	= planeBuffer;
+	me->history.source1		= planeBuffer;
+	me->history.source2		= planeBuffer + histSize;
+	me->history.target1		= planeBuffer + 2 * histSize;
+	me->history.target2		= planeBuffer + 3 * histSize;
+	me->history.mutant1		= planeBuffer + 4 * histSize;
+	me->history.mutant2		= planeBuffer + 5 * histSize;
+	me->history.stateBuf	= stateBuffer;
+	
+	me->bufSize				= 0;
+	me->convBuf				= NIL;
 	
 	me->params.omega		= ValidOmega(initOmega);
 	me->params.pi			= ValidPi(initPi);
@@ -370,7 +377,7 @@ NewMutator(
 //	Exception handling
 //	
 punt:
-	if (muBuffer != NIL)	DisposePtr((Ptr) muBuffer);
+	if (planeBuffer != NIL)	DisposePtr((Ptr) planeBuffer);
 	if (stateBuffer != NIL)	DisposePtr((Ptr) stateBuffer);
 		
 	return NIL;
@@ -391,10 +398,13 @@ FreeMutator(
 	dsp_free(&(me->coreObject));
 	
 	if ( HasHistory(me) ) {
-		DisposePtr((Ptr) me->history.muBuffer);
+		DisposePtr((Ptr) me->history.planeBuf);
 		DisposePtr((Ptr) me->history.stateBuf);
 		}
 	
+	if (me->convBuf != NIL)
+		DisposePtr((Ptr) me->convBuf);
+	
 	}
 
 #pragma mark -
@@ -501,111 +511,53 @@ DoOBands(
 /******************************************************************************************
  *
  *	HasHistory(me)
- *	GetState(me)
- *	GetHistory(me, oSource1, oSource2, oTarget1, oTarget2, oMutant1, oMutant2)
- *	PutState(me, iState)
- *	PutHistory(me, iSource1, iSource2, iTarget1, iTarget2, iMutant1, iMutant2)
- *	WrapUpMutation(	me, oMutant1Sig, oMutant2Sig,
- *					iSource1, iSource2, iTarget1, iTarget2,
- *					iMutant1, iMutant2)
+ *	FrameMutationIndex(iParams)
+ *	GetState(iHist, iBin)
+ *	PutState(iHist, iBin, iState)
+ *	PutHistory(iHist, iBin, iSource1, iSource2, iTarget1, iTarget2, iMutant1, iMutant2)
  *
- *	PutState() and PutHistory() have the side effect of updating the relavent pointers to
- *	the next item in the ring buffers.
+ *	The history is addressed by bin number (the position in the current frame). Bins
+ *	above Nyquist share the state of their mirror image and always follow it.
+ *
+ *	PutState() may only be called for "Band Leaders"; it updates the state of the leader
+ *	*and* all the dependent "Band Followers".
  *
  ******************************************************************************************/
 
-	static inline Byte GetState(tMutator* me)
-		{ 
-		Byte result = *(me->history.curState);
+	static inline int FrameMutationIndex(const tMutationParams* iParams)
+		{
+		// Same as CalcMutationIndex(), but for any set of parameters
+		int result = iParams->irregular;
 		
-		if (me->history.bufIndex > me->history.nyquist)
-			result |= stateFollowLeadBit;
+		if (iParams->magOnly)			result += imUUIM;
+		else if (iParams->signOnly)		result += imWCM;
 		
 		return result;
 		}
 	
-	static inline void GetHistory(
-		tMutator*	me,
-		double*		oSource1,
-		double*		oSource2,
-		double*		oTarget1,
-		double*		oTarget2,
-		double*		oMutant1,
-		double*		oMutant2)
-		
-		{
-		tMutationPtr	muPtr = me->history.curMu;
-		
-		*oSource1 = (double) muPtr->source1;
-		*oSource2 = (double) muPtr->source2;
-		*oTarget1 = (double) muPtr->target1;
-		*oTarget2 = (double) muPtr->target2;
-		*oMutant1 = (double) muPtr->mutant1;
-		*oMutant2 = (double) muPtr->mutant2;
+	static inline Byte GetState(const tHistory* iHist, long iBin)
+		{ 
+		return (iBin <= iHist->nyquist)
+				? iHist->stateBuf[iBin]
+				: iHist->stateBuf[iHist->bufSize - iBin] | stateFollowLeadBit;
 		}
 	
-	// NB: Always call PutState() before PutHistory()/WrapUpMutation()!!!
-	static inline void PutState(tMutator* me, Byte iState)
+	static inline void PutState(tHistory* ioHist, long iBin, Byte iState)
 		{
-		BytePtr curStatePtr	= me->history.curState;
-		long	nyqOffset	= me->history.nyquist - me->history.bufIndex;
-				
-		if (nyqOffset > 0) {
-			// ASSERT: bufIndex in [0..nyquist-1]
-			// So: check if the current bin is a "Band Leader" and, if so, update
-			// it *and* all the dependent "Band Followers".
-			if ((*curStatePtr & stateFollowLeadBit) == 0) {
-				*curStatePtr++ = iState;
-				iState += stateFollowLeadBit;
-				
-				while (--nyqOffset >= 0 && (*curStatePtr & stateFollowLeadBit)) {
-					*curStatePtr++ = iState;
-					}
-				}
-			
-			me->history.curState += 1;
-			}
+		BytePtr	statePtr	= ioHist->stateBuf + iBin;
+		long	nyqOffset	= ioHist->nyquist - iBin;
 		
-		else {
-			// The Nyquist bin may have a "mind of its own", so we have to 
-			if (nyqOffset == 0 && (*curStatePtr & stateFollowLeadBit) == 0)
-				*curStatePtr = iState;
-			
-			me->history.curState -= 1;
-			}
+		*statePtr++ = iState;
+		iState += stateFollowLeadBit;
 		
-		}
-	
-	static void PutHistory(
-		tMutator*	me,
-		double		iSource1,
-		double		iSource2,
-		double		iTarget1,
-		double		iTarget2,
-		double		iMutant1,
-		double		iMutant2)
-		{
-		tMutationPtr	muPtr = me->history.curMu;
-		
-		muPtr->source1 = (tInterval) iSource1;
-		muPtr->source2 = (tInterval) iSource2;
-		muPtr->target1 = (tInterval) iTarget1;
-		muPtr->target2 = (tInterval) iTarget2;
-		muPtr->mutant1 = (tInterval) iMutant1;
-		muPtr->mutant2 = (tInterval) iMutant2;
-		
-		// Update pointers in ring buffer
-		if (++(me->history.bufIndex) == me->history.bufSize) {
-			// Hit end of ring buffer; wrap around to beginning & update frame parameters
-			me->history.bufIndex	= 0;
-			me->history.curMu		= me->history.muBuffer;
-			if (me->paramUpdatePending) UpdateFrameParams(me);
+		while (--nyqOffset >= 0 && (*statePtr & stateFollowLeadBit)) {
+			*statePtr++ = iState;
 			}
-		else me->history.curMu += 1;	// Just nudge history up to next bin
 		}
 	
-	static void WrapUpRegMutation(
-		tMutator*	me,
+	static inline void PutHistory(
+		tHistory*	ioHist,
+		long		iBin,
 		double		iSource1,
 		double		iSource2,
 		double		iTarget1,
@@ -613,35 +565,12 @@ DoOBands(
 		double		iMutant1,
 		double		iMutant2)
 		{
-		
-		if ( HasHistory(me) ) {
-			// Even though we may currently be using absolute intervals, the user may want
-			// to switch over to relative intervals at any time, so we need to maintain
-			// history...
-			PutHistory(	me, iSource1, iSource2, iTarget1, iTarget2, iMutant1, iMutant2);
-			}
-		
-		}
-		
-	static void WrapUpIrregMutation(
-		tMutator*	me,
-		double		iSource1,
-		double		iSource2,
-		double		iTarget1,
-		double		iTarget2,
-		double		iMutant1,
-		double		iMutant2,
-		Byte		iState)
-		{
-		
-		if ( HasHistory(me) ) {
-			// Even though we may currently be using absolute intervals, the user may want
-			// to switch over to relative intervals at any time, so we need to maintain
-			// history...
-			PutState(me, iState);
-			PutHistory(me, iSource1, iSource2, iTarget1, iTarget2, iMutant1, iMutant2);
-			}
-		
+		ioHist->source1[iBin] = iSource1;
+		ioHist->source2[iBin] = iSource2;
+		ioHist->target1[iBin] = iTarget1;
+		ioHist->target2[iBin] = iTarget2;
+		ioHist->mutant1[iBin] = iMutant1;
+		ioHist->mutant2[iBin] = iMutant2;
 		}
 		
 	
@@ -649,6 +578,39 @@ DoOBands(
 #pragma mark -
 #pragma mark • DSP Methods
 
+/******************************************************************************************
+ *
+ *	SetBufSize(me, iVecSize)
+ *
+ *	The 32-bit chain converts its signals to double precision before handing them to the
+ *	kernels. Make sure there is room for kConvVectors vectors of iVecSize samples.
+ *
+ ******************************************************************************************/
+
+static OSErr
+SetBufSize(
+	tMutator*	me,
+	long		iVecSize)
+	
+	{
+	double*	newBuf;
+	
+	if (me->bufSize >= iVecSize)
+		return noErr;
+	
+	newBuf = (double*) NewPtr(kConvVectors * iVecSize * sizeof(double));
+	if (newBuf == NIL)
+		return MemError();
+	
+	if (me->convBuf != NIL)
+		DisposePtr((Ptr) me->convBuf);
+	me->convBuf = newBuf;
+	me->bufSize = iVecSize;
+	
+	return noErr;
+	}
+
+
 /******************************************************************************************
  *
  *	BuildDSPChain(iAtom, iParam, iMaxParamLen)
@@ -666,6 +628,11 @@ BuildDSPChain(
 	Boolean	hasDelta		= HasHistory(me);
 	int		outlet1Index	= hasDelta ? outletMutant1 : (outletMutant1 - 1);
 	
+	if (SetBufSize(me, ioDSPVectors[inletSource1]->s_n) != noErr) {
+		error("%s: can't allocate memory for buffers; object disabled.", kClassName);
+		return;
+		}
+	
 	dsp_add(
 		PerformMutator, 11,						// Preform method and # parameters to pass
 		me,											//	1: The performing Mutator
@@ -707,11 +674,23 @@ BuildDSPChain(
  *		- Delta Emphasis signal (may be NIL)
  *		- Mutant signals (out)
  *
- *	The perform method routes to the specific mutation performance routine appropriate
- *	for the current value of mutationType, etc.
+ *	Copies the signals to double precision and lets MutateVector() do the work.
  *
  ******************************************************************************************/
 
+	static inline double* CopyToDouble(const t_sample* iSig, double* oBuf, long iCount)
+		{
+		long i;
+		
+		if (iSig == NIL)
+			return NIL;
+		
+		for (i = 0; i < iCount; i += 1)
+			oBuf[i] = iSig[i];
+		
+		return oBuf;
+		}
+
 int*
 PerformMutator(
 	int* iParams)
@@ -734,85 +713,37 @@ PerformMutator(
 		paramNextLink
 		};
 	
-	tMutator*		me	= (tMutator*) iParams[paramMe];
-	tMutationParams	curParams;
+	tMutator*	me	= (tMutator*) iParams[paramMe];
+	long		vecSize,
+				i;
+	double*		buf;
+	t_sample*	mutant1;
+	t_sample*	mutant2;
 	
 	if (me->coreObject.z_disabled) goto exit;
 	
-	// Copy mutation parameters; we use them a lot
-	curParams = ( HasHistory(me) )
-					? me->frameParams
-					: me->params;
-	
-	// Parameters for the vector calculation method depend upon whether the mutation
-	// is irregular or uniform; if absolute or relative intervals are used; and if
-	// there are any signals that need to be sampled at audio rate.
-	
-	if (curParams.irregular) {
-		// Irregular Mutations
-		if (curParams.relInterval) {
-			// Irregular w/relative intervals
-			CalcRelIrreg(
-				me, (long) iParams[paramVectorSize],
-				(t_sample*) iParams[paramSource1], (t_sample*) iParams[paramSource2],
-				(t_sample*) iParams[paramTarget1], (t_sample*) iParams[paramTarget2],
-				(t_sample*) iParams[paramMutant1], (t_sample*) iParams[paramMutant2],
-				iParams[paramOmega]
-					? *((t_sample*) iParams[paramOmega])
-					: (t_sample) curParams.omega,
-				iParams[paramPi]
-					? *((t_sample*) iParams[paramPi])
-					: (t_sample) curParams.pi,
-				iParams[paramDelta]
-					? *((t_sample*) iParams[paramDelta])
-					: (t_sample) curParams.delta);
-			}
-		else {
-			// Irregular w/Absolute Intervals
-			CalcAbsIrreg(
-				me, (long) iParams[paramVectorSize],
-				(t_sample*) iParams[paramSource1], (t_sample*) iParams[paramSource2],
-				(t_sample*) iParams[paramTarget1], (t_sample*) iParams[paramTarget2],
-				(t_sample*) iParams[paramMutant1], (t_sample*) iParams[paramMutant2],
-				iParams[paramOmega]
-					? *((t_sample*) iParams[paramOmega])
-					: (t_sample) curParams.omega,
-				iParams[paramPi]
-					? *((t_sample*) iParams[paramPi])
-					: (t_sample) curParams.pi);
-			}
-		}
-		
-	else {
-		// Uniform Mutations
-		if (curParams.relInterval) {
-			// Uniform w/Relative intervals
-			CalcRelUniform(
-				me, (long) iParams[paramVectorSize],
-				(t_sample*) iParams[paramSource1], (t_sample*) iParams[paramSource2],
-				(t_sample*) iParams[paramTarget1], (t_sample*) iParams[paramTarget2],
-				(t_sample*) iParams[paramMutant1], (t_sample*) iParams[paramMutant2],
-				iParams[paramOmega]
-					? *((t_sample*) iParams[paramOmega])
-					: (t_sample) curParams.omega,
-				iParams[paramDelta]
-					? *((t_sample*) iParams[paramDelta])
-					: (t_sample) curParams.delta);
-			}
-		else {
-			// Uniform w/Absolute Intervals
-			CalcAbsUniform(
-				me, (long) iParams[paramVectorSize],
-				(t_sample*) iParams[paramSource1], (t_sample*) iParams[paramSource2],
-				(t_sample*) iParams[paramTarget1], (t_sample*) iParams[paramTarget2],
-				(t_sample*) iParams[paramMutant1], (t_sample*) iParams[paramMutant2],
-				iParams[paramOmega]
-					? *((t_sample*) iParams[paramOmega])
-					: (t_sample) curParams.omega);
-			}
+	vecSize	= (long) iParams[paramVectorSize];
+	mutant1	= (t_sample*) iParams[paramMutant1];
+	mutant2	= (t_sample*) iParams[paramMutant2];
+	buf		= me->convBuf;
+	
+	MutateVector(
+		me, vecSize,
+		CopyToDouble((t_sample*) iParams[paramSource1], buf, vecSize),
+		CopyToDouble((t_sample*) iParams[paramSource2], buf + vecSize, vecSize),
+		CopyToDouble((t_sample*) iParams[paramTarget1], buf + 2 * vecSize, vecSize),
+		CopyToDouble((t_sample*) iParams[paramTarget2], buf + 3 * vecSize, vecSize),
+		buf + 4 * vecSize,
+		buf + 5 * vecSize,
+		CopyToDouble((t_sample*) iParams[paramOmega], buf + 6 * vecSize, vecSize),
+		CopyToDouble((t_sample*) iParams[paramPi], buf + 7 * vecSize, vecSize),
+		CopyToDouble((t_sample*) iParams[paramDelta], buf + 8 * vecSize, vecSize));
+	
+	buf += 4 * vecSize;
+	for (i = 0; i < vecSize; i += 1) {
+		mutant1[i] = buf[i];
+		mutant2[i] = buf[vecSize + i];
 		}
-	
-	 
 
 exit:
 	return iParams + paramNextLink;
@@ -820,435 +751,509 @@ exit:
 
 /******************************************************************************************
  *
- *	CalcAbsIrreg(me, iVectorSize, iSource1, iSource2, iTarget1, iTarget2,
- *					oMutant1, oMutant2, iOmega, iPi)
+ *	BuildDSPChain64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	PerformMutator64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. Which of the Omega, Pi, and Delta inlets are connected is
+ *	passed to the perform method as flags.
  *
  ******************************************************************************************/
 
 void
-CalcAbsIrreg(
+BuildDSPChain64(
+	tMutator*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iSampleRate, iMaxVectorSize, iFlags)
+	
+	long	conn = 0;
+	
+	if (iConnectCounts[inletOmega] > 0)	conn |= connOmega;
+	if (iConnectCounts[inletPi] > 0)	conn |= connPi;
+	
+	// Objects without a delta emphasis inlet have their outlets at that index
+	if (HasHistory(me) && iConnectCounts[inletDelta] > 0)
+		conn |= connDelta;
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) PerformMutator64, 0, (void*) conn);
+	}
+	
+
+void
+PerformMutator64(
 	tMutator*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
 	long		iVectorSize,
-	t_sample*	iSource1,
-	t_sample*	iSource2,
-	t_sample*	iTarget1,
-	t_sample*	iTarget2,
-	t_sample*	oMutant1,
-	t_sample*	oMutant2,
-	t_sample	iOmega,
-	t_sample	iPi)
+	long		iFlags,
+	void*		iUser)
 	
 	{
-	double		curSource1,
-				curSource2,
-				curTarget1,
-				curTarget2,
-				curMutant1,
-				curMutant2;
-	Boolean		hasHist		= HasHistory(me);
-	tMutate1Func mutateFunc	= hasHist
-								? me->frameParams.function.irregularFunc
-								: me->params.function.irregularFunc;
-	
-	if (iOmega <= 0.0) do {
-		// With Ω == 0, the mutant is simply the source. Note, however, that the mutant
-		// values may need to be corrected to current range settings whereas the source
-		// values (used in history maintenance) are not range-checked.
-		curMutant1 = curSource1 = *iSource1++,
-		curMutant2 = curSource2 = *iSource2++;
-		
-		WrapUpIrregMutation(me, curSource1, curSource2, *iTarget1++, *iTarget2++,
-							curMutant1, curMutant2, stateSource);
-		
-		*oMutant1++ = curMutant1;
-		*oMutant2++ = curMutant2;
-		} while (--iVectorSize > 0);
-	
-	else if (1.0 <= iOmega) do {
-		curSource1 = *iSource1++;
-		curSource2 = *iSource2++;
-		curTarget1 = *iTarget1++;
-		curTarget2 = *iTarget2++;
-		curMutant1 = mutateFunc(curSource1, curTarget1),
-		curMutant2 = mutateFunc(curSource2, curTarget2);
-		
-		WrapUpIrregMutation(me, curSource1, curSource2, curTarget1, curTarget2,
-							curMutant1, curMutant2, stateTarget);
-		
-		*oMutant1++ = curMutant1;
-		*oMutant2++ = curMutant2;
-		} while (--iVectorSize > 0);
-	
-	else {
-		// iOmega in (0.0 .. 1.0)
-		Byte			curState	= stateIndeterminate;
-		unsigned long	s2mThresh,
-						m2mThresh,
-						i2mThresh	= CalcMutantThreshholds(iOmega, iPi, &s2mThresh, &m2mThresh);
-		
-		do {
-			unsigned long curThresh;
-			curSource1 = *iSource1++,
-			curSource2 = *iSource2++,
-			curTarget1 = *iTarget1++,
-			curTarget2 = *iTarget2++;
-			
-			if (hasHist) curState	= GetState(me);
-			
-			if (curState & stateFollowLeadBit) {
-				if (curState == stateFollowLeadBit + stateTarget) {
-					curMutant1	= mutateFunc(curSource1, curTarget1);
-					curMutant2	= mutateFunc(curSource2, curTarget2);
-					}
-				else {
-					curMutant1	= curSource1;
-					curMutant2	= curSource2;
-					}
-				}
-			
-			else {
-				switch (curState) {
-					case stateSource:
-						curThresh = s2mThresh;
-						break;
-					case stateTarget:
-						curThresh = m2mThresh;
-						break;
-					default:
-						// ASSERT: (curState == stateIndeterminate)
-						curThresh = i2mThresh;
-						break;
-					}
-			
-				if ( WannaMutateStrict(curThresh) ) {
-					curState	= stateTarget;
-					curMutant1	= mutateFunc(curSource1, curTarget1);
-					curMutant2	= mutateFunc(curSource2, curTarget2);
-					}
-				else {
-					curState	= stateSource;
-					curMutant1	= curSource1;
-					curMutant2	= curSource2;
-					}
-				
-				}
-			
-			WrapUpIrregMutation(me, curSource1, curSource2, curTarget1, curTarget2,
-								curMutant1, curMutant2, curState);
-		
-			*oMutant1++ = curMutant1;
-			*oMutant2++ = curMutant2;
-			} while (--iVectorSize > 0);
-		}
+	#pragma unused(iDSP64, iInCount, iOutCount, iFlags)
 	
+	long	conn	= (long) iUser;
+	
+	if (me->coreObject.z_disabled) return;
+	
+	MutateVector(
+		me, iVectorSize,
+		iIns[inletSource1], iIns[inletSource2], iIns[inletTarget1], iIns[inletTarget2],
+		iOuts[0], iOuts[1],
+		(conn & connOmega) ? iIns[inletOmega] : NIL,
+		(conn & connPi) ? iIns[inletPi] : NIL,
+		(conn & connDelta) ? iIns[inletDelta] : NIL);
 	}
 
+
+#pragma mark -
+#pragma mark • Calculation Kernels
+
 /******************************************************************************************
  *
- *	CalcAbsUniform(me, iVectorSize, iSource, iTarget, oMutant, iOmega)
+ *	DecideBins(me, iBin, iCount, iOmega, iPi, ioState, oMutate)
+ *
+ *	Decide which of the iCount bins starting at iBin are to be mutated in an irregular
+ *	mutation. Only "Band Leaders" draw random
+ *	numbers (in the same order as before, so results are reproducible from a given seed);
+ *	"Band Followers" just look up the state their leader left for them.
+ *
+ *	Without history the state is simply passed from one sample to the next in ioState.
+ *
+ *	This is the only part of an irregular mutation that has to run bin by bin. The
+ *	kernels then do the arithmetic for the whole block, selecting by oMutate.
  *
  ******************************************************************************************/
 
-void
-CalcAbsUniform(
+static void
+DecideBins(
 	tMutator*	me,
-	long		iVectorSize,
-	t_sample*	iSource1,
-	t_sample*	iSource2,
-	t_sample*	iTarget1,
-	t_sample*	iTarget2,
-	t_sample*	oMutant1,
-	t_sample*	oMutant2,
-	t_sample	iOmega)
+	long		iBin,
+	long		iCount,
+	double		iOmega,
+	double		iPi,
+	Byte*		ioState,
+	Byte		oMutate[])
 	
 	{
-	double		curSource1,
-				curSource2,
-				curTarget1,
-				curTarget2,
-				curMutant1,
-				curMutant2;
-	tMutateFunc mutateFunc	= HasHistory(me)
-								? me->frameParams.function.uniformFunc
-								: me->params.function.uniformFunc;
-	
-	if (iOmega <= 0.0) do {
-		curMutant1 = curSource1 = *iSource1++,
-		curMutant2 = curSource2 = *iSource2++;
+	tHistory*		hist	= &me->history;
+	long			bin		= iBin,
+					i;
+	unsigned long	s2mThresh,
+					m2mThresh,
+					i2mThresh;
+	UInt32			s1, s2, s3;
+	
+	if (iOmega <= 0.0 || 1.0 <= iOmega) {
+		// No random decisions to be made.
+		Byte state = (iOmega <= 0.0) ? stateSource : stateTarget;
+		
+		for (i = 0; i < iCount; i += 1)
+			oMutate[i] = (state == stateTarget);
+		
+		if ( HasHistory(me) ) {
+			for (i = 0; i < iCount; i += 1) {
+				if ((GetState(hist, bin + i) & stateFollowLeadBit) == 0)
+					PutState(hist, bin + i, state);
+				}
+			}
+		
+		return;
+		}
+	
+	i2mThresh = CalcMutantThreshholds(iOmega, iPi, &s2mThresh, &m2mThresh);
+	
+	Taus88LoadGlobal(&s1, &s2, &s3);
+	
+	for (i = 0; i < iCount; i += 1) {
+		Byte			curState = HasHistory(me) ? GetState(hist, bin + i) : *ioState;
+		unsigned long	curThresh;
 		
-		WrapUpRegMutation(	me,  curSource1, curSource2, *iTarget1++, *iTarget2++,
-							curMutant1, curMutant2);
+		if (curState & stateFollowLeadBit) {
+			oMutate[i] = (curState == stateFollowLeadBit + stateTarget);
+			continue;
+			}
 		
-		*oMutant1++ = curMutant1;
-		*oMutant2++ = curMutant2;
-		} while (--iVectorSize > 0);
-	
-	else do {
-		curSource1 = *iSource1++;
-		curSource2 = *iSource2++;
-		curTarget1 = *iTarget1++;
-		curTarget2 = *iTarget2++;
-		curMutant1 = mutateFunc(curSource1, curTarget1, iOmega),
-		curMutant2 = mutateFunc(curSource2, curTarget2, iOmega);
+		switch (curState) {
+			case stateSource:	curThresh = s2mThresh;	break;
+			case stateTarget:	curThresh = m2mThresh;	break;
+			default:			curThresh = i2mThresh;	break;
+			}
 		
-		WrapUpRegMutation(	me, curSource1, curSource2, curTarget1, curTarget2,
-							curMutant1, curMutant2);
+		oMutate[i]	= Taus88Process(&s1, &s2, &s3) < curThresh;
+		curState	= oMutate[i] ? stateTarget : stateSource;
 		
-		*oMutant1++ = curMutant1;
-		*oMutant2++ = curMutant2;
-		} while (--iVectorSize > 0);
+		if ( HasHistory(me) )
+			 PutState(hist, bin + i, curState);
+		else *ioState = curState;
+		}
 	
+	Taus88StoreGlobal(s1, s2, s3);
 	}
-		
+
 
 /******************************************************************************************
  *
- *	CalcRelIrreg(me, iVectorSize, iSource, iTarget, oMutant, iOmega, iPi, iDelta)
+ *	CalcAbsUniform(me, iCount, iSource1, iSource2, iTarget1, iTarget2,
+ *					oMutant1, oMutant2, iOmega, iPi, iDelta, ioState, iType)
+ *	CalcAbsIrreg(	me, iCount, iSource1, iSource2, iTarget1, iTarget2,
+ *					oMutant1, oMutant2, iOmega, iPi, iDelta, ioState, iType)
+ *	CalcRelUniform(	me, iCount, iSource1, iSource2, iTarget1, iTarget2,
+ *					oMutant1, oMutant2, iOmega, iPi, iDelta, ioState, iType)
+ *	CalcRelIrreg(	me, iCount, iSource1, iSource2, iTarget1, iTarget2,
+ *					oMutant1, oMutant2, iOmega, iPi, iDelta, ioState, iType)
+ *
+ *	Generic kernels, working on a run of iCount bins that starts at the current position
+ *	in the frame and doesn't cross the end of the frame. iType is the mutation type;
+ *	the instances below pass it as a constant, so there is no indirect call for each bin
+ *	and the loops vectorize.
+ *
+ *	Each loop reads all four input signals for a bin before writing anything, so the
+ *	mutant vectors may share memory with the inputs.
+ *
+ *	With Ω == 0, the mutant is simply the source. We don't leave this to MutateUniform()
+ *	as UUIM and WCM don't reduce to the identity function.
  *
  ******************************************************************************************/
 
-void
-CalcRelIrreg(
-	tMutator*	me,
-	long		iVectorSize,
-	t_sample*	iSource1,
-	t_sample*	iSource2,
-	t_sample*	iTarget1,
-	t_sample*	iTarget2,
-	t_sample*	oMutant1,
-	t_sample*	oMutant2,
-	t_sample	iOmega,
-	t_sample	iPi,
-	t_sample	iDelta)
+static inline void
+CalcAbsUniform(
+	tMutator*		me,
+	long			iCount,
+	const double*	iSource1,
+	const double*	iSource2,
+	const double*	iTarget1,
+	const double*	iTarget2,
+	double*			oMutant1,
+	double*			oMutant2,
+	double			iOmega,
+	double			iPi,
+	double			iDelta,
+	Byte*			ioState,
+	int				iType)
 	
 	{
-	double	prevSource1,
-			prevSource2,
-			prevTarget1,
-			prevTarget2,
-			prevMutant1,
-			prevMutant2,
-			curSource1,
-			curSource2,
-			curTarget1,
-			curTarget2,
-			curMutant1,
-			curMutant2;
-	
-	tEmphasisFunction
-				emphFunc	=  (iDelta == 0.0)
-								? EmphasizeZero 
-								: (iDelta > 0.0) ? EmphasizePos : EmphasizeNeg;
-	double		effectDelta = EffectiveDeltaValue(iDelta);
-	tMutate1Func mutateFunc	= me->frameParams.function.irregularFunc;
-	
-	if (iOmega <= 0.0) do {
-		GetHistory(	me,
-					&prevSource1, &prevSource2,
-					&prevTarget1, &prevTarget2,
-					&prevMutant1, &prevMutant2);
+	#pragma unused(iPi, iDelta, ioState)
+	
+	tHistory*	hist		= &me->history;
+	long		bin			= hist->bufIndex,
+				i;
+	Boolean		hasHist		= HasHistory(me),
+				identity	= (iOmega <= 0.0);
+	
+	for (i = 0; i < iCount; i += 1) {
+		double	s1	= iSource1[i],
+				s2	= iSource2[i],
+				t1	= iTarget1[i],
+				t2	= iTarget2[i],
+				m1	= identity ? s1 : MutateUniform(iType, s1, t1, iOmega),
+				m2	= identity ? s2 : MutateUniform(iType, s2, t2, iOmega);
+		
+		// Even though we may currently be using absolute intervals, the user may want
+		// to switch over to relative intervals at any time, so we need to maintain
+		// history...
+		if (hasHist)
+			PutHistory(hist, bin + i, s1, s2, t1, t2, m1, m2);
 		
-		curSource1 = *iSource1++,
-		curSource2 = *iSource2++;
+		oMutant1[i] = m1;
+		oMutant2[i] = m2;
+		}
+	
+	}
+
+static inline void
+CalcAbsIrreg(
+	tMutator*		me,
+	long			iCount,
+	const double*	iSource1,
+	const double*	iSource2,
+	const double*	iTarget1,
+	const double*	iTarget2,
+	double*			oMutant1,
+	double*			oMutant2,
+	double			iOmega,
+	double			iPi,
+	double			iDelta,
+	Byte*			ioState,
+	int				iType)
+	
+	{
+	#pragma unused(iDelta)
+	
+	tHistory*	hist	= &me->history;
+	long		bin		= hist->bufIndex,
+				done,
+				i;
+	Boolean		hasHist	= HasHistory(me);
+	Byte		mutate[kMutateBlock];
+	
+	for (done = 0; done < iCount; done += kMutateBlock) {
+		long count = iCount - done;
+		if (count > kMutateBlock) count = kMutateBlock;
 		
-		curMutant1 = emphFunc(prevMutant1, curSource1 - prevSource1, effectDelta);
-		curMutant2 = emphFunc(prevMutant2, curSource2 - prevSource2, effectDelta);
+		DecideBins(me, bin + done, count, iOmega, iPi, ioState, mutate);
 		
-		WrapUpIrregMutation(me,  curSource1, curSource2, *iTarget1++, *iTarget2++,
-							curMutant1, curMutant2, stateSource);
+		for (i = done; i < done + count; i += 1) {
+			double	s1	= iSource1[i],
+					s2	= iSource2[i],
+					t1	= iTarget1[i],
+					t2	= iTarget2[i],
+					m1	= mutate[i - done] ? MutateIrregular(iType, s1, t1) : s1,
+					m2	= mutate[i - done] ? MutateIrregular(iType, s2, t2) : s2;
+			
+			if (hasHist)
+				PutHistory(hist, bin + i, s1, s2, t1, t2, m1, m2);
+			
+			oMutant1[i] = m1;
+			oMutant2[i] = m2;
+			}
+		}
+	
+	}
+
+static inline void
+CalcRelUniform(
+	tMutator*		me,
+	long			iCount,
+	const double*	iSource1,
+	const double*	iSource2,
+	const double*	iTarget1,
+	const double*	iTarget2,
+	double*			oMutant1,
+	double*			oMutant2,
+	double			iOmega,
+	double			iPi,
+	double			iDelta,
+	Byte*			ioState,
+	int				iType)
+	
+	{
+	#pragma unused(iPi, ioState)
+	
+	tHistory*	hist		= &me->history;
+	long		bin			= hist->bufIndex,
+				i;
+	Boolean		identity	= (iOmega == 0.0);
+	double		prevCoeff	= EmphPrevCoeff(iDelta),
+				intCoeff	= EmphIntCoeff(iDelta);
+	
+	for (i = 0; i < iCount; i += 1) {
+		double	s1	= iSource1[i],
+				s2	= iSource2[i],
+				t1	= iTarget1[i],
+				t2	= iTarget2[i],
+				ds1	= s1 - hist->source1[bin + i],
+				ds2	= s2 - hist->source2[bin + i],
+				dt1	= t1 - hist->target1[bin + i],
+				dt2	= t2 - hist->target2[bin + i],
+				m1	= identity ? ds1 : MutateUniform(iType, ds1, dt1, iOmega),
+				m2	= identity ? ds2 : MutateUniform(iType, ds2, dt2, iOmega);
 		
-		*oMutant1++ = curMutant1;
-		*oMutant2++ = curMutant2;
-		} while (--iVectorSize > 0);
-	
-	else if (1.0 <= iOmega) do {
-		GetHistory(	me,
-					&prevSource1, &prevSource2,
-					&prevTarget1, &prevTarget2,
-					&prevMutant1, &prevMutant2);
+		m1 = prevCoeff * hist->mutant1[bin + i] + intCoeff * m1;
+		m2 = prevCoeff * hist->mutant2[bin + i] + intCoeff * m2;
 		
-		curSource1 = *iSource1++,
-		curSource2 = *iSource2++,
-		curTarget1 = *iTarget1++,
-		curTarget2 = *iTarget2++;
+		PutHistory(hist, bin + i, s1, s2, t1, t2, m1, m2);
 		
-		curMutant1 = emphFunc(
-						prevMutant1,
-						mutateFunc(curSource1 - prevSource1, curTarget1 - prevTarget1),
-						effectDelta);
-		curMutant2 = emphFunc(
-						prevMutant2,
-						mutateFunc(curSource2 - prevSource2, curTarget2 - prevTarget2),
-						effectDelta);
+		oMutant1[i] = m1;
+		oMutant2[i] = m2;
+		}
+	
+	}
+
+static inline void
+CalcRelIrreg(
+	tMutator*		me,
+	long			iCount,
+	const double*	iSource1,
+	const double*	iSource2,
+	const double*	iTarget1,
+	const double*	iTarget2,
+	double*			oMutant1,
+	double*			oMutant2,
+	double			iOmega,
+	double			iPi,
+	double			iDelta,
+	Byte*			ioState,
+	int				iType)
+	
+	{
+	tHistory*	hist		= &me->history;
+	long		bin			= hist->bufIndex,
+				done,
+				i;
+	double		prevCoeff	= EmphPrevCoeff(iDelta),
+				intCoeff	= EmphIntCoeff(iDelta);
+	Byte		mutate[kMutateBlock];
+	
+	for (done = 0; done < iCount; done += kMutateBlock) {
+		long count = iCount - done;
+		if (count > kMutateBlock) count = kMutateBlock;
 		
-		WrapUpIrregMutation(me,  curSource1, curSource2, curTarget1, curTarget2,
-							curMutant1, curMutant2, stateTarget);
+		DecideBins(me, bin + done, count, iOmega, iPi, ioState, mutate);
 		
-		*oMutant1++ = curMutant1;
-		*oMutant2++ = curMutant2;
-		} while (--iVectorSize > 0);
-	
-	else {
-		// iOmega in (0.0 .. 1.0)
-		unsigned long	s2mThresh,
-						m2mThresh,
-						i2mThresh	= CalcMutantThreshholds(iOmega, iPi, &s2mThresh, &m2mThresh);
-			
-		do	{
-			Byte			curState = GetState(me);
-			unsigned long	curThresh;
-			
-			GetHistory(	me,
-						&prevSource1, &prevSource2, &prevTarget1, &prevTarget2,
-						&prevMutant1, &prevMutant2);
-			
-			curSource1	= *iSource1++,
-			curSource2	= *iSource2++,
-			curTarget1	= *iTarget1++,
-			curTarget2	= *iTarget2++;
-			
-			if (curState & stateFollowLeadBit) {
-				if (curState == stateFollowLeadBit + stateTarget) {
-					curMutant1 = mutateFunc(curSource1 - prevSource1,
-											curTarget1 - prevTarget1);
-					curMutant2 = mutateFunc(curSource2 - prevSource2,
-											curTarget2 - prevTarget2);
-					}
-				else {
-					curMutant1 = curSource2 - prevSource2;
-					curMutant2 = curSource2 - prevSource2;
-					}
-				}
-			
-			else {
-				switch (curState) {
-					case stateSource:
-						curThresh = s2mThresh;
-						break;
-					case stateTarget:
-						curThresh = m2mThresh;
-						break;
-					default:
-						curThresh = i2mThresh;
-						break;
-					}
+		for (i = done; i < done + count; i += 1) {
+			double	s1	= iSource1[i],
+					s2	= iSource2[i],
+					t1	= iTarget1[i],
+					t2	= iTarget2[i],
+					ds1	= s1 - hist->source1[bin + i],
+					ds2	= s2 - hist->source2[bin + i],
+					dt1	= t1 - hist->target1[bin + i],
+					dt2	= t2 - hist->target2[bin + i],
+					m1	= mutate[i - done] ? MutateIrregular(iType, ds1, dt1) : ds1,
+					m2	= mutate[i - done] ? MutateIrregular(iType, ds2, dt2) : ds2;
 			
-				if ( WannaMutateStrict(curThresh) ) {
-					curState = stateTarget;
-					curMutant1 = mutateFunc(curSource1 - prevSource1,
-											curTarget1 - prevTarget1);
-					curMutant2 = mutateFunc(curSource2 - prevSource2,
-											curTarget2 - prevTarget2);
-					}
-				else {
-					curState = stateSource;
-					curMutant1 = curSource2 - prevSource2;
-					curMutant2 = curSource2 - prevSource2;
-					}
-				}
-				
-			curMutant1 = emphFunc(prevMutant1, curMutant1, effectDelta);
-			curMutant2 = emphFunc(prevMutant2, curMutant2, effectDelta);
+			m1 = prevCoeff * hist->mutant1[bin + i] + intCoeff * m1;
+			m2 = prevCoeff * hist->mutant2[bin + i] + intCoeff * m2;
 			
-			WrapUpIrregMutation(me,  curSource1, curSource2, curTarget1, curTarget2,
-								curMutant1, curMutant2, curState);
-		
-			*oMutant1++ = curMutant1;
-			*oMutant2++ = curMutant2;
+			PutHistory(hist, bin + i, s1, s2, t1, t2, m1, m2);
 			
-			} while (--iVectorSize > 0);
-		
+			oMutant1[i] = m1;
+			oMutant2[i] = m2;
+			}
 		}
 	
 	}
-		
+
+
+/******************************************************************************************
+ *
+ *	Kernel instances
+ *
+ *	One kernel for each combination of mutation type and absolute/relative intervals.
+ *	Unlike tim~, frim~ can only change mutation settings at the start of a frame, so
+ *	MutateVector() looks the kernel up for each run of bins.
+ *
+ ******************************************************************************************/
+
+typedef void (*tFrameKernel)(	tMutator*, long,
+								const double*, const double*, const double*, const double*,
+								double*, double*,
+								double, double, double, Byte*);
+
+#define DefineKernel(calc, type)																\
+	static void calc##_##type(																	\
+					tMutator* me, long iCount,													\
+					const double* iSource1, const double* iSource2,								\
+					const double* iTarget1, const double* iTarget2,								\
+					double* oMutant1, double* oMutant2,											\
+					double iOmega, double iPi, double iDelta, Byte* ioState)					\
+		{																						\
+		calc(	me, iCount, iSource1, iSource2, iTarget1, iTarget2, oMutant1, oMutant2,			\
+				iOmega, iPi, iDelta, ioState, type);											\
+		}
+
+DefineKernel(CalcAbsUniform, imUSIM)
+DefineKernel(CalcRelUniform, imUSIM)
+DefineKernel(CalcAbsUniform, imUUIM)
+DefineKernel(CalcRelUniform, imUUIM)
+DefineKernel(CalcAbsUniform, imWCM)
+DefineKernel(CalcRelUniform, imWCM)
+
+DefineKernel(CalcAbsIrreg, imISIM)
+DefineKernel(CalcRelIrreg, imISIM)
+DefineKernel(CalcAbsIrreg, imIUIM)
+DefineKernel(CalcRelIrreg, imIUIM)
+DefineKernel(CalcAbsIrreg, imLCM)
+DefineKernel(CalcRelIrreg, imLCM)
+
+#undef DefineKernel
+
+	// Indexed by mutation type, then [relInterval]
+static const tFrameKernel kKernels[imLast + 1][2] = {
+	{CalcAbsUniform_imUSIM, CalcRelUniform_imUSIM},
+	{CalcAbsIrreg_imISIM, CalcRelIrreg_imISIM},
+	{CalcAbsUniform_imUUIM, CalcRelUniform_imUUIM},
+	{CalcAbsIrreg_imIUIM, CalcRelIrreg_imIUIM},
+	{CalcAbsUniform_imWCM, CalcRelUniform_imWCM},
+	{CalcAbsIrreg_imLCM, CalcRelIrreg_imLCM}
+	};
+
 
 /******************************************************************************************
  *
- *	CalcRelUniform(me, iVectorSize, iSource, iTarget, oMutant, iOmega, iDelta)
+ *	MutateVector(me, iVectorSize, iSource1, iSource2, iTarget1, iTarget2,
+ *					oMutant1, oMutant2, iOmega, iPi, iDelta)
+ *
+ *	Common to the 32- and 64-bit perform methods. The signal vector is split at frame
+ *	boundaries; each run of bins goes to the kernel for the current frame parameters.
+ *	When a frame is complete, pending parameter changes are made.
+ *
+ *	Omega, Pi, and Delta are taken from the first sample of their signal in each run (if
+ *	a signal is connected), otherwise from the parameters.
  *
  ******************************************************************************************/
 
-void
-CalcRelUniform(
-	tMutator*	me,
-	long		iVectorSize,
-	t_sample*	iSource1,
-	t_sample*	iSource2,
-	t_sample*	iTarget1,
-	t_sample*	iTarget2,
-	t_sample*	oMutant1,
-	t_sample*	oMutant2,
-	t_sample	iOmega,
-	t_sample	iDelta)
+static void
+MutateVector(
+	tMutator*		me,
+	long			iVectorSize,
+	const double*	iSource1,
+	const double*	iSource2,
+	const double*	iTarget1,
+	const double*	iTarget2,
+	double*			oMutant1,
+	double*			oMutant2,
+	const double*	iOmega,
+	const double*	iPi,
+	const double*	iDelta)
 	
 	{
-	double	prevSource1,
-			prevSource2,
-			prevTarget1,
-			prevTarget2,
-			prevMutant1,
-			prevMutant2,
-			curSource1,
-			curSource2,
-			curTarget1,
-			curTarget2,
-			curMutant1,
-			curMutant2;
-	
-	tEmphasisFunction
-				emphFunc	=  (iDelta == 0.0)
-									? EmphasizeZero 
-									: (iDelta > 0.0) ? EmphasizePos : EmphasizeNeg;
-	double		effectDelta = EffectiveDeltaValue(iDelta);
-	
-	if (iOmega == 0.0) do {
-		GetHistory(	me,
-					&prevSource1, &prevSource2,
-					&prevTarget1, &prevTarget2,
-					&prevMutant1, &prevMutant2);
+	tHistory*	hist	= &me->history;
+	Byte		state	= stateIndeterminate;		// Only used without history
+	
+	if ( !HasHistory(me) ) {
+		// Without history there are no relative intervals (and no frames)
+		const tMutationParams* params = &me->params;
+		
+		kKernels[FrameMutationIndex(params)][false](
+				me, iVectorSize, iSource1, iSource2, iTarget1, iTarget2, oMutant1, oMutant2,
+				iOmega ? iOmega[0] : params->omega,
+				iPi ? iPi[0] : params->pi,
+				params->delta,
+				&state);
+		return;
+		}
+	
+	while (iVectorSize > 0) {
+		const tMutationParams*	params	= &me->frameParams;
+		long					count	= hist->bufSize - hist->bufIndex;
 		
-		curSource1 = *iSource1++;
-		curSource2 = *iSource2++;	
+		if (count > iVectorSize)
+			count = iVectorSize;
 		
-		curMutant1 = emphFunc(prevMutant1, curSource1 - prevSource1, effectDelta);
-		curMutant2 = emphFunc(prevMutant2, curSource2 - prevSource2, effectDelta);
+		kKernels[FrameMutationIndex(params)][params->relInterval](
+				me, count, iSource1, iSource2, iTarget1, iTarget2, oMutant1, oMutant2,
+				iOmega ? iOmega[0] : params->omega,
+				iPi ? iPi[0] : params->pi,
+				iDelta ? iDelta[0] : params->delta,
+				&state);
 		
-		WrapUpRegMutation(	me,  curSource1, curSource2, *iTarget1++, *iTarget2++,
-							curMutant1, curMutant2);
+		iSource1 += count;
+		iSource2 += count;
+		iTarget1 += count;
+		iTarget2 += count;
+		oMutant1 += count;
+		oMutant2 += count;
+		if (iOmega)	iOmega	+= count;
+		if (iPi)	iPi		+= count;
+		if (iDelta)	iDelta	+= count;
 		
-		*oMutant1++ = curMutant1;
-		*oMutant2++ = curMutant2;
-		} while (--iVectorSize > 0);
-	
-	else {
-		tMutateFunc mutateFunc	= me->frameParams.function.uniformFunc;
-		 do {
-			GetHistory(	me,
-						&prevSource1, &prevSource2,
-						&prevTarget1, &prevTarget2,
-						&prevMutant1, &prevMutant2);
-			
-			curSource1 = *iSource1++;
-			curSource2 = *iSource2++;
-			curTarget1 = *iTarget1++;
-			curTarget2 = *iTarget2++;	
-			
-			curMutant1 = emphFunc(
-							prevMutant1,
-							mutateFunc(curSource1 - prevSource1, curTarget1 - prevTarget2, iOmega),
-							effectDelta);
-			curMutant2 = emphFunc(
-							prevMutant2,
-							mutateFunc(curSource2 - prevSource2, curTarget2 - prevTarget2, iOmega),
-							effectDelta);
-			
-			WrapUpRegMutation(	me,  curSource1, curSource2, curTarget1, curTarget2,
-								curMutant1, curMutant2);
+		hist->bufIndex += count;
+		if (hist->bufIndex == hist->bufSize) {
+			// Hit end of frame; wrap around to beginning & update frame parameters
+			hist->bufIndex = 0;
+			if (me->paramUpdatePending) UpdateFrameParams(me);
+			}
 		
-			*oMutant1++ = curMutant1;
-			*oMutant2++ = curMutant2;
-			} while (--iVectorSize > 0);
+		iVectorSize -= count;
 		}
 	
 	}
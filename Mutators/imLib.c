@@ -36,7 +36,7 @@
 #pragma mark • Constants
 
 const double	kMaxPi			= 65535.0 / 65536.0;
-const long		kMaxHistory 	= 2048;
+const long		kMaxHistory 	= 16384;
 
 
 const char*		kShortNames[imLast + 1]
@@ -299,6 +299,7 @@ Initialize(
 			me->params.omegaSR	= false;
 			me->params.piSR		= false;
 			me->params.deltaSR	= false;
+			SelectKernel(me);
 		#endif
 	#endif
 	
@@ -360,6 +361,10 @@ SetMutatorType(tMutator* me, short iType)
 			break;
 		}
 	
+#if __IM_MSP__ && !__IM_DOUBLEBARREL__
+	SelectKernel(me);
+#endif
+
 #if __IM_HISTORY__
 	if (me->history.bufSize > 0) {
 		if (me->history.bufIndex == 0)
@@ -462,20 +467,21 @@ DoClear(
 #if __IM_HISTORY__
 
 	long			index;
-	tMutationPtr	mPtr;
+	float*			plane;
 	BytePtr			sPtr;
 	
-	index	= me->history.bufSize;
-	mPtr	= me->history.muBuffer + index;
-	do {
-		(--mPtr)->source1	= 0;
-		mPtr->source2		= 0;
-		mPtr->target1		= 0;
-		mPtr->target2		= 0;
-		mPtr->mutant1		= 0;
-		mPtr->mutant2		= 0;
-		
-		} while (--index > 0);
+	if (me->history.bufSize == 0)
+		return;
+	
+	// All the planes are in one contiguous block
+	#if __IM_DOUBLEBARREL__
+		index	= 6 * me->history.bufSize;
+	#else
+		index	= 3 * me->history.bufSize;
+	#endif
+	plane	= me->history.planeBuf;
+	do { *plane++ = 0; }
+		while (--index > 0);
 		
 	index	= me->history.nyquist;
 	sPtr	= me->history.stateBuf + index;
@@ -526,6 +532,10 @@ DoAbsInt(
 	
 	me->params.relInterval = false;
 	
+#if __IM_MSP__ && !__IM_DOUBLEBARREL__
+	SelectKernel(me);
+#endif
+
 #if __IM_HISTORY__
 	if (me->history.bufSize > 0) {
 		if (me->history.bufIndex == 0)
@@ -554,6 +564,10 @@ DoRelInt(
 //	DoClear(me);
 	DoDelta(me, iDelta);
 	
+#if __IM_MSP__ && !__IM_DOUBLEBARREL__
+	SelectKernel(me);
+#endif
+
 #if __IM_HISTORY__
 	// ASSERT: (me->history.bufSize > 0)
 	if (me->history.bufIndex == 0)
@@ -598,6 +612,7 @@ DoControlRate(
 			break;
 		}
 	
+	SelectKernel(me);
 	}
 
 void
@@ -627,5 +642,6 @@ DoSampleRate(
 			break;
 		}
 	
+	SelectKernel(me);
 	}
 #endif
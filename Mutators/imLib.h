@@ -152,6 +152,13 @@ enum {
 	
 	};
 
+	// Flags for connected parameter inlets, passed to the 64-bit perform methods
+enum {
+	connOmega		= 1 << inletOmega,
+	connPi			= 1 << inletPi,
+	connDelta		= 1 << inletDelta
+	};
+
 	// Numeric codes for the Interval Mutation functions (maps to MENU items, strings, etc.)
 enum {
 	imUSIM			= 0,
@@ -237,33 +244,31 @@ typedef struct {
 	} tMutationParams;
 
 #if __IM_HISTORY__
-	typedef struct {
-		#if __IM_DOUBLEBARREL__
-		float	source1,
-				source2,
-				target1,
-				target2,
-				mutant1,
-				mutant2;
-		#else
-		float	source,
-				target,
-				mutant;
-		#endif
-		} tMutation;
-	typedef tMutation* tMutationPtr;
-	
-	
 	typedef struct {
 		// Ring buffer to maintain state over "history" (generally to maintain
-		// state for each individual bin of a Fourier transform)
+		// state for each individual bin of a Fourier transform).
+		// The values are kept in planes of bufSize floats each, indexed by bin, so a run
+		// of bins can be processed with straight vector loops. All planes live in one
+		// block of memory starting at planeBuf. stateBuf holds nyquist + 1 bytes, one
+		// for each bin from DC to Nyquist; the bins above Nyquist use the state of their
+		// mirror image.
 		unsigned short	bufSize,
 						bufIndex,
 						nyquist;
-		tMutationPtr	muBuffer,
-						curMu;
-		BytePtr			stateBuf,
-						curState;
+		float*			planeBuf;
+		#if __IM_DOUBLEBARREL__
+		float			*source1,			// Real or amplitude
+						*source2,			// Imaginary or phase
+						*target1,
+						*target2,
+						*mutant1,
+						*mutant2;
+		#else
+		float			*source,
+						*target,
+						*mutant;
+		#endif
+		BytePtr			stateBuf;
 		} tHistory;
 #else
 	typedef struct {
@@ -274,14 +279,30 @@ typedef struct {
 		} tHistory;
 #endif
 
+#if __IM_MSP__ && !__IM_DOUBLEBARREL__
+		// Signature of the specialized calculation kernels in tim~.c. After the object
+		// come vector size, source, target, and mutant vectors, and the omega, pi, and
+		// delta signals (NIL for inlets without a signal).
+	struct mutator;
+	typedef void (*tMutateKernel)(	struct mutator*, long,
+									const double*, const double*, double*,
+									const double*, const double*, const double*);
+#endif
+
+
 #pragma mark  Object Structure
 
-typedef struct {
+typedef struct mutator {
 	#if __IM_MSP__
 		t_pxobject		coreObject;
 	#else
 		t_object		coreObject;
 		tInterval		pendTarget;
+		#if !__IM_JITTER__
+		long			listTargets,		// Number of pending targets for list mode
+						listSize;			// Capacity of listBuf, in list elements
+		double*			listBuf;			// Pending targets followed by work space
+		#endif
 	#endif
 	
 	tHistory			history;
@@ -292,6 +313,15 @@ typedef struct {
 		Boolean			paramUpdatePending;
 	#endif
 	
+	#if __IM_MSP__
+		#if !__IM_DOUBLEBARREL__
+		tMutateKernel	kernel;				// Chosen by SelectKernel()
+		long			sigConn;			// conn... flags for signals at the parameter inlets
+		#endif
+		long			bufSize;			// Samples per vector in convBuf
+		double*			convBuf;			// 32-bit signals are converted here for the kernels
+	#endif
+	
 	} tMutator;
 
 
@@ -352,6 +382,7 @@ void		DoRelInt(tMutator*, float);
 #if __IM_MSP__ && !__IM_DOUBLEBARREL__
 	void	DoControlRate(tMutator*);
 	void	DoSampleRate(tMutator*);
+	void	SelectKernel(tMutator*);			// Defined in tim~.c
 #endif
 
 #if __IM_HISTORY__
@@ -373,8 +404,48 @@ static inline tInterval Sign(tInterval iValue)
 	{ return iValue > 0.0 ? 1.0 : (iValue == 0.0 ? 0.0 : -1.0); }
 static inline tInterval Mod(tInterval iVal, tInterval iMod)
 	{ return fmod(iVal, iMod); }
+
+	// Inline counterparts to the Calc__Mutant() functions, indexed by mutation type.
+	// When iType is a constant the switch folds away, leaving a few arithmetic operations
+	// and selects that the compiler can vectorize.
+	// MutateUniform() gives the same results as CalcSIMutant(), CalcUIMutant(), and
+	// CalcWCMutant(), bit for bit (hence the tests for zero, which would otherwise give
+	// us -0.0 occasionally); MutateIrregular() as CalcSIMutant1(), CalcUIMutant1(), and
+	// CalcLCMutant1().
+static inline double
+MutateUniform(int iType, tInterval iSource, tInterval iTarget, double iOmega)
+	{
+	switch (iType) {
+		case imUUIM:	return (iSource == 0.0)
+								? 0.0
+								: Sign(iSource) * (iSource + iOmega * (Abs(iTarget) - iSource));
+		case imWCM:		return (iSource == 0.0)
+								? 0.0
+								: Abs(iSource) * (Sign(iSource)
+												+ iOmega * (Sign(iTarget) - Sign(iSource)));
+		default:		return iSource + iOmega * (iTarget - iSource);		// imUSIM
+		}
+	}
+
+static inline tInterval
+MutateIrregular(int iType, tInterval iSource, tInterval iTarget)
+	{
+	switch (iType) {
+		case imIUIM:	return Sign(iSource) * Abs(iTarget);
+		case imLCM:		return Abs(iSource) * Sign(iTarget);
+		default:		return iTarget;										// imISIM
+		}
+	}
 	
 
+	// EmphasizePos(), EmphasizeNeg(), and EmphasizeZero() can all be written as
+	//		mutant = EmphPrevCoeff(delta) * prevMutant + EmphIntCoeff(delta) * interval
+	// One of the coefficients is always 1.0, so the results are bit-identical.
+static inline double EmphPrevCoeff(double iDelta)
+	{ return (iDelta < 0.0) ? 1.0 + iDelta : 1.0; }
+static inline double EmphIntCoeff(double iDelta)
+	{ return (iDelta > 0.0) ? 1.0 - iDelta : 1.0; }
+
 static inline double
 CalcOmegaPrimeCore(double iOmega, double iPi)
 	{ return  pow(iOmega, (iPi > kMaxPi) ? 1.0 - kMaxPi : 1.0 - iPi); }
@@ -78,7 +78,9 @@ const char	kClassName[]	= "lp.emeric~";					// Class name
 	#define kFBankSize				24
 #endif
 
-const float kFBankCenters[]	= {	50.,	150.,	250.,
+	// The default filter bank, and the one the object used exclusively until bands became
+	// configurable. Any other band layout is set up with the bands or centers messages.
+const double kFBankCenters[]	= {	50.,	150.,	250.,
 								350.,	450.,	570.,
 								700.,	840.,	1000.,
 								1170.,	1370.,	1600.,
@@ -100,16 +102,73 @@ enum {
 	strIndexOutLeft		= strIndexOutSig
 	};
 
+enum {
+	kMaxBands		= 1024,						// Upper limit for bands/centers messages
+	
+	kMinFFTSize		= 64,						// Limits for the STFT engine, and the
+	kMaxFFTSize		= 16384,					// default. All powers of two.
+	kDefFFTSize		= 1024,
+	kSTFTOverlap	= 4,						// hop = size / kSTFTOverlap
+	
+	kPhaseBits		= 10,						// Random phases for the STFT engine come
+	kPhaseTabSize	= 1 << kPhaseBits			// from a table of this size
+	};
+
+	// Per-band planes in the bank buffer, in this order
+enum bankPlanes {
+	planeCenters		= 0,
+	planeA0,
+	planeB1,
+	planeB2,
+	planeSrcY1,
+	planeSrcY2,
+	planeExcY1,
+	planeExcY2,
+	planeAmpSums,
+	planeBandProd,
+	planeBandBins,
+	
+	planeCount
+	};
+
 #pragma mark • Type Definitions
 
+	// The filter bank is stored "structure of arrays" style, with one array per coefficient
+	// or state variable, indexed by band. This allows the perform methods to run all
+	// filters in the bank side by side for each sample.
+	// The arrays all point into the one bank buffer allocated by SetBands().
 typedef struct resonParams {
-			double	a0, b1, b2;			// Following Dodge & Jerse
+			double	*a0,				// Following Dodge & Jerse
+					*b1,
+					*b2;
 			} tResonParams;
 
 typedef struct resonBuf	{
-			double y1, y2;				// Ditto: D&J var names
+			double	*y1,				// Ditto: D&J var names
+					*y2;
 			} tResonBuf;
 
+	// State of the STFT engine. Allocated as a single block by STFTNew(); all pointers
+	// point into the same block, directly after the header.
+	// The transform is an unnormalized radix-2 FFT, and both analysis and synthesis use
+	// a periodic Hann window. With an overlap of 4 the squared windows sum to 3/2, so
+	// each synthesized frame is scaled by 2 / (3 * size) before overlap-add.
+typedef struct stft {
+			long	size,				// Frame size (power of two)
+					hop,				// Samples between frames
+					fill;				// Samples collected since the last frame
+			double	scale;				// Overlap-add normalization
+			double	*window,			// size
+					*cosTab,			// size/2 twiddle factors
+					*sinTab,
+					*re,				// size, work buffers for the transform
+					*im,
+					*inBuf,				// size, analysis frame
+					*outBuf;			// size, overlap-add accumulator
+			long	*bitRev,			// size
+					*binBand;			// size/2 + 1: which band each bin belongs to
+			} tSTFT;
+
 
 #pragma mark • Object Structure
 
@@ -127,20 +186,30 @@ typedef struct {
 					
 	float			curSR;
 	
-	tResonParams	rParams[kFBankSize];	// These also depend on omega as well as the
-	tResonBuf		srcRBuf[kFBankSize],	// hard-wired center frequencies and sample
-					excRBuf[kFBankSize];	// rate
+	long			bandCount;				// Number of bands in filterbank
+	double*			bankBuf;				// All per-band planes, bandCount * planeCount
+	double*			centers;				// Center frequencies, ascending
+	
+	tResonParams	rParams;				// These also depend on omega as well as the
+	tResonBuf		srcRBuf,				// center frequencies and sample rate
+					excRBuf;
 	
 	tSampleVector	exciteBuf;				// Need a private buffer of samples for the
 	unsigned long	exciteBufSize;			// excitation buffer
 	
-	double			ampSums[kFBankSize];	// Cache sum of (absolute) amplitudes of the
+	double*			ampSums;				// Cache sum of (absolute) amplitudes of the
 											// ring buffer below
+	double*			bandProd;				// Scratch, one value per band
+	double*			bandBins;				// Number of FFT bins in each band
 	int				sumToUpdate;			// Update one running sum per sample vector
 	tSampleVector	ringBuf,				// Allocate at dsp_add time; size depends on SR
-					ringBufCurPos;			// Points to vector of 21 amps inside the ring buffer
+					ringBufCurPos;			// Points to row of band amps inside the ring buffer
 	unsigned long	ringBufMaxSize,			// Size in # of floats stored
 					ringBufCurSize;
+	
+	tSTFT*			stft;					// Non-NIL when the STFT engine is selected
+	Boolean			perBin;					// STFT engine: per-bin rather than per-band
+											// envelopes
 	} objEmeric;
 
 
@@ -154,6 +223,10 @@ static tTaus88Data
 				sTausData		= {0x4a1fcf79, 0xb86271cc, 0x6c986d11};
 */
 
+	// Random phases for the STFT engine
+static double	sPhaseCos[kPhaseTabSize],
+				sPhaseSin[kPhaseTabSize];
+
 #pragma mark • Function Prototypes
 
 	// Class message functions
@@ -164,6 +237,11 @@ void	EmericFree(objEmeric*);
 static void EmericOmega(objEmeric*, double);
 static void EmericFloat(objEmeric*, double);
 static void EmericTattle(objEmeric*);
+static void	EmericBands(objEmeric*, long);
+static void	EmericCenters(objEmeric*, Symbol*, short, Atom*);
+static void	EmericEngine(objEmeric*, Symbol*, short, Atom*);
+static void	EmericPerBin(objEmeric*, long);
+static void	EmericLatency(objEmeric*);
 static void	EmericAssist(objEmeric*, void*, long, long, char*);
 static void	EmericInfo(objEmeric*);
 
@@ -172,6 +250,8 @@ static void	EmericInfo(objEmeric*);
 static void	EmericDSP(objEmeric*, t_signal**, short*);
 static int*	EmericPerform6(int*);
 static int*	EmericPerform5(int*);
+static void	EmericDSP64(objEmeric*, t_object*, short*, double, long, long);
+static void	EmericPerform64(objEmeric*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -221,9 +301,15 @@ main(void)
 	addmess	((method) EmericTattle,	"tattle",	A_NOTHING);
 	addmess	((method) EmericAssist,	"assist",	A_CANT, 0);
 	addmess	((method) EmericInfo,	"info",		A_CANT, 0);
+	addmess	((method) EmericBands,	"bands",	A_DEFLONG, 0);
+	addmess	((method) EmericCenters,"centers",	A_GIMME, 0);
+	addmess	((method) EmericEngine,	"engine",	A_GIMME, 0);
+	addmess	((method) EmericPerBin,	"perbin",	A_LONG, 0);
+	addmess	((method) EmericLatency,"latency",	A_NOTHING);
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) EmericDSP, "dsp", A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) EmericDSP64, "dsp64", A_CANT, 0);
 
 	// Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -235,6 +321,18 @@ main(void)
 */
 	Taus88Init();
 	
+	// Phase table for the STFT engine
+	{
+	int i;
+	
+	for (i = 0; i < kPhaseTabSize; i += 1) {
+		double phi = k2pi * i / kPhaseTabSize;
+		
+		sPhaseCos[i] = cos(phi);
+		sPhaseSin[i] = sin(phi);
+		}
+	}
+	
 	}
 
 #pragma mark -
@@ -265,8 +363,9 @@ Omega2Q(
 
 static unsigned long
 Omega2BufSize(
-	double iOmega,
-	double iSR)
+	double	iOmega,
+	double	iSR,
+	long	iBandCount)
 	
 	{
 	const double	kMaxBufDur = 0.1,			// Buffer needs to store up to 100 ms.
@@ -274,7 +373,7 @@ Omega2BufSize(
 	
 	double			bufDur = kMinBufDur + iOmega * (kMaxBufDur - kMinBufDur);
 	
-	return kFBankSize * (unsigned long) ceil(bufDur * iSR);
+	return iBandCount * (unsigned long) ceil(bufDur * iSR);
 	}
 
 
@@ -297,8 +396,8 @@ CalcRunningSum(
 	do	{
 		sum += *s;
 		
-		s += kFBankSize;
-		i -= kFBankSize;
+		s += me->bandCount;
+		i -= me->bandCount;
 		} while (i > 0);
 	
 	me->ampSums[iFiltNum] = sum;
@@ -324,18 +423,25 @@ static void
 CalcFiltParams(
 	double			q,
 	double			sr,
-	tResonParams	oRParams[])
+	const double	iCenters[],
+	long			iBandCount,
+	tResonParams*	oRParams)
 	
 	{
-	// The filter bank sums the output of all 21 filters, so reduce amplitude such that
-	// the sum will have the same power as the input signal
-	const double kFBankAmpFactor	= 0.2182178902;				// = sqrt(1/kFBankSize)
-
-	int i;
+	// The filter bank sums the output of all filters, so reduce amplitude such that
+	// the sum will have the same power as the input signal. The factor was tuned for the
+	// original 21 bands; other band counts scale it by the square root of the ratio to
+	// the default 24, which leaves the default bank exactly where it was.
+	const double kFBankAmpFactor	= 0.2182178902;				// = sqrt(1/21)
+	
+	double	ampFactor = (iBandCount == kFBankSize)
+							? kFBankAmpFactor
+							: kFBankAmpFactor * sqrt((double) kFBankSize / (double) iBandCount);
+	int		i;
 	
-	for (i = 0; i < kFBankSize; i += 1) {
-		double	f0 = kFBankCenters[i],
-				a0 = kFBankAmpFactor,
+	for (i = 0; i < iBandCount; i += 1) {
+		double	f0 = iCenters[i],
+				a0 = ampFactor,
 				b1 = 0.0,
 				b2 = 0.0;
 		
@@ -365,13 +471,46 @@ CalcFiltParams(
 			a0	 *= sqrt(a0sq);
 			}
 		
-		oRParams[i].a0 = a0;
-		oRParams[i].b1 = b1;
-		oRParams[i].b2 = b2;
+		oRParams->a0[i] = a0;
+		oRParams->b1[i] = b1;
+		oRParams->b2[i] = b2;
 		}
 	
 	}
 
+/******************************************************************************************
+ *
+ *	EnterCritical()
+ *	ExitCritical(iPrevLock)
+ *
+ *	Keep the perform methods out while we rearrange buffers they use.
+ *	
+ ******************************************************************************************/
+
+static inline short
+EnterCritical(void)
+	{
+#if __HAS_CRITICAL_REGIONS__
+	critical_enter(0);
+	return 0;
+#else
+	return lockout_set(1);
+#endif
+	}
+
+static inline void
+ExitCritical(
+	short iPrevLock)
+	
+	{
+#if __HAS_CRITICAL_REGIONS__
+	#pragma unused(iPrevLock)
+	critical_exit(0);
+#else
+	lockout_set(iPrevLock);
+#endif
+	}
+
 /******************************************************************************************
  *
  *	InitVocBuffers(me)
@@ -386,12 +525,12 @@ InitVocBuffers(
 	{
 	int i;
 	
-	for (i = 0; i < kFBankSize; i += 1) {
+	for (i = 0; i < me->bandCount; i += 1) {
 		me->ampSums[i]		= 0.0;
-		me->srcRBuf[i].y1	= 0.0;
-		me->srcRBuf[i].y2	= 0.0;
-		me->excRBuf[i].y1	= 0.0;
-		me->excRBuf[i].y2	= 0.0;
+		me->srcRBuf.y1[i]	= 0.0;
+		me->srcRBuf.y2[i]	= 0.0;
+		me->excRBuf.y1[i]	= 0.0;
+		me->excRBuf.y2[i]	= 0.0;
 		}
 	
 	me->ringBuf			= NIL;
@@ -417,17 +556,15 @@ SetVocBufSize(
 	double* const	kAmpSumBase = me->ampSums;
 	floatPtr const	kRingBufBase = me->ringBuf,
 					kRingBufStop = kRingBufBase + me->ringBufCurSize;
-	const long		kRBCurSize	= me->ringBufCurSize;
+	const long		kRBCurSize	= me->ringBufCurSize,
+					kBandCount	= me->bandCount;
 	
 	unsigned long	i, j, k;						// General-purpose counters
 	floatPtr		p;								// General-purpose pointers
 	double*			s;
+	short			prevLock;
 	
-#if __HAS_CRITICAL_REGIONS__
-	critical_enter(0);
-#else
-	short prevLock = lockout_set(1);
-#endif
+	prevLock = EnterCritical();
 
 	// Two basic alternatives
 	if (iNewSize < 	me->ringBufCurSize) {
@@ -443,7 +580,7 @@ SetVocBufSize(
 			do	{
 				
 				s = kAmpSumBase;
-				j -= k = kFBankSize;
+				j -= k = kBandCount;
 				do { *s++ -= *p++; } while (--k > 0);
 				
 				} while (j > 0);
@@ -454,7 +591,7 @@ SetVocBufSize(
 		
 		// Finish remaining samples
 		while (i > 0) {
-			i -= k = kFBankSize;
+			i -= k = kBandCount;
 			s = kAmpSumBase;
 			do { *s++ -= *p++; } while (--k > 0);
 			}
@@ -479,20 +616,20 @@ SetVocBufSize(
 		// Need to expand the ring buffer
 		// This entails filling the new history with the current mean values to ensure a
 		// smooth transition.
-		const double kMeanFactor = ((double) kFBankSize) / ((double) me->ringBufCurSize);
-		const long	 kNewSamples = (iNewSize - me->ringBufCurSize) / kFBankSize;
+		// The current means are staged in the bandProd scratch plane, which the perform
+		// methods won't touch while we're inside the critical region.
+		const double kMeanFactor = ((double) kBandCount) / ((double) me->ringBufCurSize);
+		const long	 kNewSamples = (iNewSize - me->ringBufCurSize) / kBandCount;
 		
-		float	curMeans[kFBankSize];
+		double*	curMeans = me->bandProd;
 		
 		s = kAmpSumBase;
-		p = &curMeans[0];
-		i = kFBankSize;
-		do	{
-			double m = *s * kMeanFactor;			// Get current mean for this filter band
+		for (k = 0; k < kBandCount; k += 1) {
+			double m = s[k] * kMeanFactor;			// Get current mean for this filter band
 			
-			*s++ += m * kNewSamples;				// Adjust running sums-of-amplitudes
-			*p++ = (m > FLT_EPSILON) ? m : 0.0;		// Convert mean to single-precision.
-			} while (--i > 0);
+			s[k] += m * kNewSamples;				// Adjust running sums-of-amplitudes
+			curMeans[k] = (m > FLT_EPSILON) ? m : 0.0;
+			}
 			
 		i = iNewSize - me->ringBufCurSize;
 		p = me->ringBufCurPos;
@@ -500,24 +637,220 @@ SetVocBufSize(
 		BlockMoveData((Ptr) p, (Ptr) (p + i), j * sizeof(float));
 		
 		do	{
-			BlockMoveData((Ptr) curMeans, (Ptr) p, kFBankSize);
+			for (k = 0; k < kBandCount; k += 1)
+				p[k] = curMeans[k];					// Convert mean to single-precision.
 			
-			p += kFBankSize;
-			i -= kFBankSize;
+			p += kBandCount;
+			i -= kBandCount;
 			} while (i > 0);
 		}
 	// ... otherwise no change
 	
 	// Don't forget to update cur size component
 	me->ringBufCurSize = iNewSize;
+	
+	ExitCritical(prevLock);
+	}
 
-#if __HAS_CRITICAL_REGIONS__
-	critical_exit(0);
-#else
-	lockout_set(prevLock);
-#endif
+/******************************************************************************************
+ *
+ *	STFTNew(iSize)
+ *	STFTMapBands(me, ioSTFT)
+ *
+ *	STFTNew() allocates and initializes everything the STFT engine needs for frames of
+ *	iSize samples (must be a power of two); returns NIL if memory is short.
+ *
+ *	STFTMapBands() assigns each bin up to Nyquist to the band whose center is nearest on a
+ *	logarithmic scale (the band edges are the geometric means of neighboring centers),
+ *	and counts the bins in each band. Must be called whenever centers, sample rate, or
+ *	frame size change, and not while the STFT is running.
+ *	
+ ******************************************************************************************/
+
+static tSTFT*
+STFTNew(
+	long iSize)
+	
+	{
+	const long	kHalf	= iSize / 2;
+	
+	tSTFT*	stft;
+	double*	d;
+	long*	l;
+	long	i, j, bits;
+	
+	stft = (tSTFT*) NewPtrClear(sizeof(tSTFT)
+									+ 6 * iSize * sizeof(double)
+									+ (iSize + kHalf + 1) * sizeof(long));
+	if (stft == NIL)
+		return NIL;
+	
+	d = (double*) (stft + 1);
+	stft->window	= d;	d += iSize;
+	stft->cosTab	= d;	d += kHalf;
+	stft->sinTab	= d;	d += kHalf;
+	stft->re		= d;	d += iSize;
+	stft->im		= d;	d += iSize;
+	stft->inBuf		= d;	d += iSize;
+	stft->outBuf	= d;	d += iSize;
+	l = (long*) d;
+	stft->bitRev	= l;	l += iSize;
+	stft->binBand	= l;
+	
+	stft->size	= iSize;
+	stft->hop	= iSize / kSTFTOverlap;
+	stft->fill	= 0;
+	stft->scale	= 2.0 / (3.0 * iSize);
+	
+	for (i = 0; i < iSize; i += 1)
+		stft->window[i] = 0.5 - 0.5 * cos(k2pi * i / iSize);
+	
+	// Forward twiddle factors
+	for (i = 0; i < kHalf; i += 1) {
+		stft->cosTab[i] = cos(k2pi * i / iSize);
+		stft->sinTab[i] = -sin(k2pi * i / iSize);
+		}
+	
+	for (bits = 0; (1L << bits) < iSize; bits += 1) { }
+	for (i = 0; i < iSize; i += 1) {
+		long r = 0;
+		
+		for (j = 0; j < bits; j += 1)
+			if (i & (1L << j)) r |= 1L << (bits - 1 - j);
+		stft->bitRev[i] = r;
+		}
+	
+	return stft;
+	}
+
+static void
+STFTMapBands(
+	objEmeric*	me,
+	tSTFT*		ioSTFT)
+	
+	{
+	const long		kHalf		= ioSTFT->size / 2,
+					kBandCount	= me->bandCount;
+	const double	kBinFreq	= me->curSR / ioSTFT->size;
+	const double*	centers		= me->centers;
+	
+	long	band = 0,
+			k;
+	
+	for (k = 0; k < kBandCount; k += 1)
+		me->bandBins[k] = 0.0;
+	
+	for (k = 0; k <= kHalf; k += 1) {
+		double f = k * kBinFreq;
+		
+		while (band + 1 < kBandCount && f * f > centers[band] * centers[band + 1])
+			band += 1;
+		
+		ioSTFT->binBand[k] = band;
+		me->bandBins[band] += 1.0;
+		}
+	
+	}
+
+
+/******************************************************************************************
+ *
+ *	SetBands(me, iCenters, iCount)
+ *	
+ *	Replace the filter bank (and the ring buffer of amplitudes, whose layout depends on
+ *	the number of bands) with one using the given center frequencies. The new buffers
+ *	are allocated and initialized before we swap them in, so the old bank keeps working
+ *	if memory is short.
+ *
+ *	The centers are sorted; the STFT engine relies on ascending order.
+ *
+ ******************************************************************************************/
+
+	static int CompareCenters(const void* iA, const void* iB)
+		{
+		double a = *(const double*) iA,
+			   b = *(const double*) iB;
+		
+		return (a < b) ? -1 : (a > b);
+		}
+
+static OSErr
+SetBands(
+	objEmeric*		me,
+	const double	iCenters[],
+	long			iCount)
+	
+	{
+	const double kMaxOmega = 1.0;
+	
+	double*			newBank;
+	double*			oldBank	= me->bankBuf;
+	floatPtr		newRing	= NIL,
+					oldRing	= me->ringBuf;
+	unsigned long	ringMaxSize = 0,
+					ringCurSize = 0;
+	tResonParams	params;
+	short			prevLock;
+	
+	newBank = (double*) NewPtrClear(planeCount * iCount * sizeof(double));
+	if (newBank == NIL)
+		return MemError();
+	
+	if (oldRing != NIL) {
+		ringMaxSize = Omega2BufSize(kMaxOmega, me->curSR, iCount);
+		ringCurSize = Omega2BufSize(me->omega, me->curSR, iCount);
+		newRing = (floatPtr) NewPtrClear(ringMaxSize * sizeof(float));
+		if (newRing == NIL) {
+			DisposePtr((Ptr) newBank);
+			return MemError();
+			}
+		}
+	
+	BlockMoveData((Ptr) iCenters, (Ptr) (newBank + planeCenters * iCount), iCount * sizeof(double));
+	qsort(newBank + planeCenters * iCount, iCount, sizeof(double), CompareCenters);
+	
+	params.a0 = newBank + planeA0 * iCount;
+	params.b1 = newBank + planeB1 * iCount;
+	params.b2 = newBank + planeB2 * iCount;
+	if (me->curSR > 0.0)
+		CalcFiltParams(Omega2Q(me->omega), me->curSR, newBank + planeCenters * iCount, iCount, &params);
+	
+	prevLock = EnterCritical();
+	
+	me->bankBuf			= newBank;
+	me->bandCount		= iCount;
+	me->centers			= newBank + planeCenters * iCount;
+	me->rParams			= params;
+	me->srcRBuf.y1		= newBank + planeSrcY1 * iCount;
+	me->srcRBuf.y2		= newBank + planeSrcY2 * iCount;
+	me->excRBuf.y1		= newBank + planeExcY1 * iCount;
+	me->excRBuf.y2		= newBank + planeExcY2 * iCount;
+	me->ampSums			= newBank + planeAmpSums * iCount;
+	me->bandProd		= newBank + planeBandProd * iCount;
+	me->bandBins		= newBank + planeBandBins * iCount;
+	me->sumToUpdate		= 0;
+	
+	if (newRing != NIL) {
+		me->ringBuf			= newRing;
+		me->ringBufCurPos	= newRing;
+		me->ringBufMaxSize	= ringMaxSize;
+		me->ringBufCurSize	= ringCurSize;
+		}
+	
+	if (me->stft != NIL)
+		STFTMapBands(me, me->stft);
+	
+	ExitCritical(prevLock);
+	
+	if (oldBank != NIL)
+		DisposePtr((Ptr) oldBank);
+	if (newRing != NIL)
+		DisposePtr((Ptr) oldRing);
+	
+	return noErr;
 	}
 
+
 /******************************************************************************************
  *
  *	SetSR(me, iSR)
@@ -543,8 +876,8 @@ SetSR(
 												// buffer is needed
 	
 	OSErr			myErr			= noErr;
-	unsigned long	ringBufMaxSize	= Omega2BufSize(kMaxOmega, iSR),
-					ringBufCurSize	= Omega2BufSize(me->omega, iSR);
+	unsigned long	ringBufMaxSize	= Omega2BufSize(kMaxOmega, iSR, me->bandCount),
+					ringBufCurSize	= Omega2BufSize(me->omega, iSR, me->bandCount);
 	
 	me->curSR = iSR;
 	
@@ -604,8 +937,15 @@ SetSR(
 		else myErr = MemError();
 		}
 	
-	if (myErr == noErr)	
-		CalcFiltParams(Omega2Q(me->omega), iSR, me->rParams);
+	if (myErr == noErr)	{
+		CalcFiltParams(Omega2Q(me->omega), iSR, me->centers, me->bandCount, &me->rParams);
+		
+		if (me->stft != NIL) {
+			short prevLock = EnterCritical();
+			STFTMapBands(me, me->stft);
+			ExitCritical(prevLock);
+			}
+		}
 	
 	return myErr;
 	}
@@ -649,9 +989,20 @@ EmericNew(
 	me->vocXFade		= 0.0;
 	me->exciteBuf		= NIL;
 	me->exciteBufSize	= 0;
+	me->curSR			= 0.0;
+	me->bandCount		= 0;
+	me->bankBuf			= NIL;
+	me->stft			= NIL;
+	me->perBin			= false;
 	
 	InitVocBuffers(me);
 	
+	if (SetBands(me, kFBankCenters, kFBankSize) != noErr) {
+		freeobject((Object*) me);
+		me = NIL;
+		goto punt;
+		}
+	
 	SetSR(me, sys_getsr());		// This will be recalculated in the DSP method
 								// With omega == 0, this call simply clears all rParams
 								// Ignore return value at this time.
@@ -683,6 +1034,10 @@ EmericFree(
 		DisposePtr((Ptr) me->ringBuf);
 	if (me->exciteBuf != NIL)
 		DisposePtr((Ptr) me->exciteBuf);
+	if (me->bankBuf != NIL)
+		DisposePtr((Ptr) me->bankBuf);
+	if (me->stft != NIL)
+		DisposePtr((Ptr) me->stft);
 	
 	}
 
@@ -726,10 +1081,10 @@ void EmericOmega(
 		me->vocXFade = 0.0;
 		}
 	
-	CalcFiltParams(Omega2Q(iOmega), me->curSR, me->rParams);
+	CalcFiltParams(Omega2Q(iOmega), me->curSR, me->centers, me->bandCount, &me->rParams);
 	
 	if (me->ringBuf != NIL) {
-		unsigned long newBufSize = Omega2BufSize(iOmega, me->curSR);
+		unsigned long newBufSize = Omega2BufSize(iOmega, me->curSR, me->bandCount);
 		if (newBufSize != me->ringBufCurSize) SetVocBufSize(me, newBufSize);
 		}
 	
@@ -755,6 +1110,197 @@ void EmericFloat(
 	}
 
 
+/******************************************************************************************
+ *
+ *	EmericBands(me, iCount)
+ *	EmericCenters(me, sym, iArgC, iArgV)
+ *
+ *	Two ways to lay out the filter bank. "bands n" spaces n centers evenly on the Bark
+ *	scale between the lowest and highest of the default centers (Traunmüller's formula);
+ *	"bands" or "bands 0" restores the default 24 bands. "centers f1 f2 ..." takes an
+ *	explicit list of frequencies in Hz.
+ *
+ ******************************************************************************************/
+
+	static inline double Hz2Bark(double f)
+		{ return 26.81 * f / (1960.0 + f) - 0.53; }
+	static inline double Bark2Hz(double z)
+		{ return 1960.0 * (z + 0.53) / (26.28 - z); }
+
+void
+EmericBands(
+	objEmeric*	me,
+	long		iCount)
+	
+	{
+	double*	centers;
+	double	zLo, zHi;
+	long	i;
+	
+	if (iCount == 0) {
+		if (SetBands(me, kFBankCenters, kFBankSize) != noErr)
+			error("%s: can't allocate memory for filter bank", kClassName);
+		return;
+		}
+	
+	if (iCount < 0 || kMaxBands < iCount) {
+		error("%s: band count must be between 1 and %ld", kClassName, (long) kMaxBands);
+		return;
+		}
+	
+	centers = (double*) NewPtr(iCount * sizeof(double));
+	if (centers == NIL) {
+		error("%s: can't allocate memory for filter bank", kClassName);
+		return;
+		}
+	
+	zLo = Hz2Bark(kFBankCenters[0]);
+	zHi = Hz2Bark(kFBankCenters[kFBankSize - 1]);
+	
+	if (iCount == 1)
+		centers[0] = Bark2Hz(0.5 * (zLo + zHi));
+	else for (i = 0; i < iCount; i += 1)
+		centers[i] = Bark2Hz(zLo + (zHi - zLo) * i / (iCount - 1));
+	
+	if (SetBands(me, centers, iCount) != noErr)
+		error("%s: can't allocate memory for filter bank", kClassName);
+	
+	DisposePtr((Ptr) centers);
+	}
+
+void
+EmericCenters(
+	objEmeric*	me,
+	Symbol*		sym,
+	short		iArgC,
+	Atom*		iArgV)
+	
+	{
+	#pragma unused(sym)
+	
+	double*	centers;
+	long	i;
+	
+	if (iArgC < 1 || kMaxBands < iArgC) {
+		error("%s: need between 1 and %ld center frequencies", kClassName, (long) kMaxBands);
+		return;
+		}
+	
+	centers = (double*) NewPtr(iArgC * sizeof(double));
+	if (centers == NIL) {
+		error("%s: can't allocate memory for filter bank", kClassName);
+		return;
+		}
+	
+	for (i = 0; i < iArgC; i += 1) {
+		double f = (iArgV[i].a_type == A_SYM) ? 0.0 : AtomGetFloat(&iArgV[i]);
+		
+		if (f <= 0.0) {
+			error("%s: invalid center frequency (argument %ld)", kClassName, i + 1);
+			goto exit;
+			}
+		centers[i] = f;
+		}
+	
+	if (SetBands(me, centers, iArgC) != noErr)
+		error("%s: can't allocate memory for filter bank", kClassName);
+	
+exit:
+	DisposePtr((Ptr) centers);
+	}
+
+
+/******************************************************************************************
+ *
+ *	EmericEngine(me, sym, iArgC, iArgV)
+ *	EmericPerBin(me, iPerBin)
+ *	EmericLatency(me)
+ *
+ *	"engine filter" selects the time-domain filter bank (the default). "engine fft [size]"
+ *	selects the STFT engine, which analyzes the source in frames of size samples (a power
+ *	of two between 64 and 16384, default 1024) with 75% overlap and resynthesizes it with
+ *	the band (or, after "perbin 1", bin) envelopes imposed on noise. The cost of the STFT
+ *	engine hardly depends on the number of bands, but it delays the signal by one frame.
+ *	The target inlet is not used by the STFT engine.
+ *
+ *	"latency" posts the current delay through the object.
+ *
+ ******************************************************************************************/
+
+void
+EmericEngine(
+	objEmeric*	me,
+	Symbol*		sym,
+	short		iArgC,
+	Atom*		iArgV)
+	
+	{
+	#pragma unused(sym)
+	
+	tSTFT*	newSTFT = NIL;
+	tSTFT*	oldSTFT;
+	short	prevLock;
+	
+	if (iArgC < 1 || iArgV[0].a_type != A_SYM)
+		goto bad;
+	
+	if (iArgV[0].a_w.w_sym == gensym("fft")) {
+		long size = (iArgC > 1) ? (long) AtomGetFloat(&iArgV[1]) : kDefFFTSize;
+		
+		if (size < kMinFFTSize || kMaxFFTSize < size || (size & (size - 1)) != 0) {
+			error("%s: FFT size must be a power of two between %ld and %ld",
+					kClassName, (long) kMinFFTSize, (long) kMaxFFTSize);
+			return;
+			}
+		if (me->stft != NIL && me->stft->size == size)
+			return;
+		
+		newSTFT = STFTNew(size);
+		if (newSTFT == NIL) {
+			error("%s: can't allocate memory for FFT engine", kClassName);
+			return;
+			}
+		}
+	else if (iArgV[0].a_w.w_sym != gensym("filter"))
+		goto bad;
+	
+	prevLock = EnterCritical();
+	if (newSTFT != NIL)
+		STFTMapBands(me, newSTFT);
+	oldSTFT		= me->stft;
+	me->stft	= newSTFT;
+	ExitCritical(prevLock);
+	
+	if (oldSTFT != NIL)
+		DisposePtr((Ptr) oldSTFT);
+	
+	return;
+	
+bad:
+	error("%s: engine must be filter or fft", kClassName);
+	}
+
+void
+EmericPerBin(
+	objEmeric*	me,
+	long		iPerBin)
+	
+	{
+	me->perBin = (iPerBin != 0);
+	}
+
+void
+EmericLatency(
+	objEmeric*	me)
+	
+	{
+	long latency = (me->stft != NIL) ? me->stft->size : 0;
+	
+	post("%s: latency %ld samples (%lf ms)",
+			kClassName, latency, (me->curSR > 0.0) ? 1000.0 * latency / me->curSR : 0.0);
+	}
+
+
 /******************************************************************************************
  *
  *	EmericTattle(me)
@@ -768,7 +1314,7 @@ EmericTattle(
 	objEmeric* me)
 	
 	{
-	const double	kMeanFactor = ((double) kFBankSize) / ((double) me->ringBufCurSize),
+	const double	kMeanFactor = ((double) me->bandCount) / ((double) me->ringBufCurSize),
 					kLatency	= 1000.0 / (kMeanFactor * me->curSR);
 	
 	int		i;
@@ -784,23 +1330,31 @@ EmericTattle(
 		post("Crossfading wet/dry: %lf source, %lf mutant", me->srcXFade, me->vocXFade);
 		}
 	
+	if (me->stft != NIL) {
+		post("  Engine: STFT, frame size %ld, hop %ld, %s envelopes",
+				me->stft->size, me->stft->hop, me->perBin ? "per-bin" : "per-band");
+		post("    latency %ld samples (%lf ms)",
+				me->stft->size, 1000.0 * me->stft->size / me->curSR);
+		}
+	else post("  Engine: filter bank");
+	
 	if (q > 0.0) {
-		post("  Filterbank state:");
-		for (i = 0; i < kFBankSize; i += 1) {
-			double			f0		= kFBankCenters[i],
+		post("  Filterbank state (%ld bands):", me->bandCount);
+		for (i = 0; i < me->bandCount; i += 1) {
+			double			f0		= me->centers[i],
 							halfBW	= 0.5 * f0 / q;
-			tResonParams*	params	= &me->rParams[i];
-			tResonBuf*		srcBuf	= &me->srcRBuf[i];
-			tResonBuf*		excBuf	= &me->excRBuf[i];
+			tResonParams*	params	= &me->rParams;
+			tResonBuf*		srcBuf	= &me->srcRBuf;
+			tResonBuf*		excBuf	= &me->excRBuf;
 			
 			if (f0 + halfBW < 0.5 * me->curSR)
 				 post("    Center freq %lf (3dB BW: %lf - %lf)",
 				 		f0, (f0 > halfBW) ? f0 - halfBW : (double) 0.0, f0 + halfBW);
 			else post("    Center freq %lf (BW > Nyquist)", f0);
 				
-			post("      a0: %lf, b1: %lf, b2: %lf", params->a0, params->b1, params->b2);
-			post("      srcRBuf: %lf, %lf", srcBuf->y1, srcBuf->y2);
-			post("      excRBuf: %lf, %lf", excBuf->y1, excBuf->y2);
+			post("      a0: %lf, b1: %lf, b2: %lf", params->a0[i], params->b1[i], params->b2[i]);
+			post("      srcRBuf: %lf, %lf", srcBuf->y1[i], srcBuf->y2[i]);
+			post("      excRBuf: %lf, %lf", excBuf->y1[i], excBuf->y2[i]);
 			}
 		}
 	else post("    -- infinite bandwidth --");
@@ -809,10 +1363,10 @@ EmericTattle(
 	post("  %ld values stored at 0x%p, ",
 			me->ringBufMaxSize, me->ringBuf);
 	post("  currently using %ld (%ld samples)",
-			me->ringBufCurSize, me->ringBufCurSize / kFBankSize);
+			me->ringBufCurSize, me->ringBufCurSize / me->bandCount);
 	
 	energy = 0.0;
-	for (i = 0; i < kFBankSize; i += 1) {
+	for (i = 0; i < me->bandCount; i += 1) {
 		double bandEnergy = me->ampSums[i] * kMeanFactor;
 		post("    band %ld sum of absolute amplitudes: %lf (mean %lf)",
 			 i, me->ampSums[i], bandEnergy);
@@ -969,31 +1523,32 @@ PerformNull(
 	
 	{
 	// ASSERT: a0 member is the same for all filters in filterbank, b1 and b2 are all zero
-	const double weight = me->rParams[0].a0;
+	const double weight = me->rParams.a0[0];
+	const long	 kBandCount = me->bandCount;
 	
-	unsigned long	i = kFBankSize;
-	tResonBuf*		s = me->srcRBuf;
-	tResonBuf*		x = me->excRBuf;
+	int				i;
+	tResonBuf*		s = &me->srcRBuf;
+	tResonBuf*		x = &me->excRBuf;
 	
 	// Maintain state of filter buffers.
 	// Need to special-case for the obnoxious situation of (iVecSize == 1)
 	if (iVecSize == 1) {
 		const double samp = iInput[0] * weight;
-		do {
-			s->y2 = s->y1;
-			s++->y1 = samp;
-			x->y2 = x->y1;
-			x++->y1 = samp;
-			} while (--i > 0);
+		for (i = 0; i < kBandCount; i += 1) {
+			s->y2[i] = s->y1[i];
+			s->y1[i] = samp;
+			x->y2[i] = x->y1[i];
+			x->y1[i] = samp;
+			}
 		}
 	else {
 		// ASSERT: iVecSize >= 2
 		const double	samp1 = iInput[iVecSize - 1] * weight,
 						samp2 = iInput[iVecSize - 2] * weight;
-		do {
-			x->y2	= s->y2		= samp2;
-			x++->y1 = s++->y1	= samp1;
-			} while (--i > 0);
+		for (i = 0; i < kBandCount; i += 1) {
+			x->y2[i] = s->y2[i] = samp2;
+			x->y1[i] = s->y1[i] = samp1;
+			}
 		}
 	
 	// ?? Should I update running sum buffer as well??
@@ -1011,9 +1566,6 @@ PerformNull(
  *
  ******************************************************************************************/
 
-	static inline void ClearOutputBuffer(long iBufSize, t_sample* iBuf)
-		{ do {*iBuf++ = 0.0; } while (--iBufSize > 0); }
-	
 	// Have now inlined the Taus88 code so we can keep stuff in registers
 	static inline void
 	MungeExcitationBuffer(
@@ -1038,41 +1590,77 @@ PerformNull(
 		
 		}
 	
+	// Run all the filters in the bank for one sample.
+	// The band loops have no dependencies from one band to the next, so they vectorize.
+	// The final sum over the bands is done separately and in band order, so the result is
+	// bit-for-bit what the old band-by-band loop produced.
+	// Keeps sum of (absolute) source amplitudes for each band, dropping the oldest value in
+	// the ring buffer (ioCache) and compensating for cumulative rounding errors.
 	static inline double
-	CalcFilterOutput(double x, double y1, double y2, double a0, double b1, double b2)
-		{
-		// Use first parameter as accumulator
-		// This would even be OK if a function call weren't call-by-value
-		x *= a0;
-		x -= b1 * y1;
-		x -= b2 * y2;
+	FilterBankTick(
+		objEmeric*	me,
+		double		iSrc,
+		double		iTgt,
+		floatPtr	ioCache,
+		double		iMeanFactor)
 		
-		return x;
-		}
-
-	static inline double
-	UpdateRunningSum(double iNewVal, double iGate, double* ioSum, float* ioCache)
 		{
-		double	result = *ioSum;
+		const double kGate	= 9.5367431641e-7;  		// -120 dB gate for the filters.
 		
-		// Work with absolute values of amplitudes
-		if (iNewVal < 0.0)
-			iNewVal = -iNewVal;
+		const long			kBandCount = me->bandCount;
+		const tResonParams*	p	= &me->rParams;
+		tResonBuf*			sb	= &me->srcRBuf;
+		tResonBuf*			xb	= &me->excRBuf;
+		double*				sum	= me->ampSums;
+		double*				prod = me->bandProd;
+		double				result = 0.0;
+		int					i;
 		
-		// Drop old sample, compensating for cumulative rounding errors
-		result -= *ioCache;
-		if (result < 0.0)
-			result = 0.0;
-		
-		// Add new sample (if larger than gate value)
-		if (iNewVal >= iGate) {
-			result += iNewVal;
-			*ioCache = iNewVal;
+		for (i = 0; i < kBandCount; i += 1) {
+			// Cf. Dodge & Jerse
+			double	srcY0	= iSrc * p->a0[i] - p->b1[i] * sb->y1[i] - p->b2[i] * sb->y2[i],
+					excY0	= iTgt * p->a0[i] - p->b1[i] * xb->y1[i] - p->b2[i] * xb->y2[i],
+					amp		= fabs(srcY0),
+					curSum	= sum[i] - ioCache[i];
+			
+			sb->y2[i] = sb->y1[i];
+			sb->y1[i] = srcY0;
+			xb->y2[i] = xb->y1[i];
+			xb->y1[i] = excY0;
+			
+			// Add new sample (if larger than gate value). Written as selects rather than
+			// branches so that the compiler can vectorize the loop.
+			curSum		= (curSum < 0.0) ? 0.0 : curSum;
+			amp			= (amp < kGate) ? 0.0 : amp;
+			curSum		+= amp;
+			ioCache[i]	= amp;
+			sum[i]		= curSum;
+			
+			// Convert source amplitude to analysis amplitude
+			// (ie, scaled as component in filterbank)
+			prod[i] = curSum * iMeanFactor * excY0;
 			}
-		else *ioCache = 0.0;
 		
-		// Update cached sum and return value
-		return (*ioSum = result);
+		for (i = 0; i < kBandCount; i += 1)
+			result += prod[i];
+		
+		return result;
+		}
+
+	// Bookkeeping at the end of each vector
+	static inline void
+	WrapUpPerform(
+		objEmeric*	me,
+		floatPtr	iRBCurPos)
+		
+		{
+		me->ringBufCurPos = iRBCurPos;
+		
+		// Finally, recalculate one of the running sum buffers from scratch,
+		// rotating through the filters, one per vector
+		if (me->sumToUpdate == 0)
+			me->sumToUpdate = me->bandCount;
+		CalcRunningSum(me, --(me->sumToUpdate));
 		}
 
 
@@ -1085,95 +1673,30 @@ Perform(
 	t_sample*	oOut)
 	
 	{
-	const double kGate	= 9.5367431641e-7;  		// -120 dB gate for the filters.
-	
 	// Cache values from object into registers (read-only)
 	const long			kRBCurSize	= me->ringBufCurSize;
-	const double		kMeanFactor	= ((double) kFBankSize) / ((double) kRBCurSize);
+	const long			kBandCount	= me->bandCount;
+	const double		kMeanFactor	= ((double) kBandCount) / ((double) kRBCurSize);
 	tSampleVector const	kRingBufBase = &me->ringBuf[0],
 						kRingBufStop = kRingBufBase + kRBCurSize;		// tSampleVector is just a pointer to t_sample
 	
-	// Other stuff to get into registers;
-	tResonParams*	curParam	= me->rParams;
-	tResonBuf*		curSrcBuf	= me->srcRBuf;
-	tResonBuf*		curExcBuf	= me->excRBuf;
-	double*			curAmpSum;
 	floatPtr		rbCurPos	= me->ringBufCurPos;
 	long			i;
 	
-	// 1) Clear output buffer
-	ClearOutputBuffer(iVecSize, oOut);
-	
-	// 2) Set up "real" excitation buffer
+	// 1) Set up "real" excitation buffer
 	MungeExcitationBuffer(iVecSize, me->noiseThresh, iSrc, iTgt, me->exciteBuf);
 
-	// 3) Loop through filters in filterbank
-	curAmpSum = me->ampSums;
-	i = kFBankSize;
-	do {
-		// Get filter parameters into registers (read-only)
-		const double	a0	= curParam->a0,
-						b1	= curParam->b1,
-						b2	= curParam++->b2;
-		
-		// Copy buffers into registers
-		double	srcY1	= curSrcBuf->y1,
-				srcY2	= curSrcBuf->y2,
-				excY1	= curExcBuf->y1,
-				excY2	= curExcBuf->y2;
-		
-		// Everything else we need...
-		floatPtr	rBufPos = rbCurPos++; 
-		t_sample*	s		= iSrc;
-		t_sample*	t		= iTgt;
-		t_sample*	o		= oOut;
-		long		j		= iVecSize;
+	// 2) Run the whole filterbank sample by sample. Each sample has its own row of
+	//	  kBandCount amplitudes in the ring buffer.
+	for (i = 0; i < iVecSize; i += 1) {
+		oOut[i] = FilterBankTick(me, iSrc[i], iTgt[i], rbCurPos, kMeanFactor);
 		
-		do {
-			double	srcY0, excY0;
-			
-			// Calculate current source amplitude and update filter buffer values
-			srcY0 = CalcFilterOutput(*s++, srcY1, srcY2, a0, b1, b2);
-			srcY2 = srcY1; srcY1 = srcY0;
-			
-			// Calculate current excitation amplitude and update filter buffer values
-			excY0 = CalcFilterOutput(*t++, excY1, excY2, a0, b1, b2);
-			excY2 = excY1; excY1 = excY0;
-			
-			// Convert source amplitude to analysis amplitude
-			// (ie, scaled as component in filterbank)
-			// and update ring buffer pointer
-			srcY0  = UpdateRunningSum(srcY0, kGate, curAmpSum, rBufPos) * kMeanFactor;
-			rBufPos += kFBankSize;
-			if (rBufPos >= kRingBufStop)
-				rBufPos -= kRBCurSize;
-			
-			// Update output value
-			*o++ += srcY0 * excY0;
-			} while (--j > 0);
-		
-		// Save buffer state for next run
-		curSrcBuf->y1	= srcY1;
-		curSrcBuf++->y2	= srcY2;
-		curExcBuf->y1	= excY1;
-		curExcBuf++->y2	= excY2;
-		curAmpSum += 1;
-		} while (--i > 0);
-	
-	
-	// Work out "real" current position in ring buffer and store for next call to this function
-	// Note that rbCurPos has already been incremented kFBankSize times
-	rbCurPos += ((iVecSize - 1) * kFBankSize) % kRBCurSize;
-	if (rbCurPos >= kRingBufStop)
-		rbCurPos -= kRBCurSize;
-	
-	me->ringBufCurPos = rbCurPos;
-	
-	// Finally, recalculate one of the running sum buffers from scratch,
-	// rotating through the filters, one per vector
-	if (me->sumToUpdate == 0)
-		me->sumToUpdate = kFBankSize;
-	CalcRunningSum(me, --(me->sumToUpdate));
+		rbCurPos += kBandCount;
+		if (rbCurPos >= kRingBufStop)
+			rbCurPos -= kRBCurSize;
+		}
+	
+	WrapUpPerform(me, rbCurPos);
 	}
 	
 /******************************************************************************************
@@ -1199,6 +1722,194 @@ PerformXFade(
 		} while (--iVecSize > 0);
 	}
 
+
+/******************************************************************************************
+ *
+ *	STFTTransform(iSTFT, ioRe, ioIm)
+ *	STFTFrame(me)
+ *	PerformSTFT(me, iVecSize, iSrc, oOut)
+ *
+ *	The STFT engine. STFTTransform() is an in-place, unnormalized, iterative radix-2 FFT;
+ *	swapping the real and imaginary arrays gives the inverse.
+ *
+ *	STFTFrame() is called every hop samples. It windows the most recent frame of the
+ *	source, takes its spectrum, and measures the envelope of each band (RMS over the
+ *	band's bins) or of each bin. Then, bin by bin, the noise threshold decides whether to
+ *	keep the source bin or to replace it by the envelope with a random phase. DC and
+ *	Nyquist always keep the source. The result is windowed again and overlap-added into
+ *	the output buffer.
+ *
+ *	PerformSTFT() just shuttles samples in and out of the frame buffers.
+ *
+ ******************************************************************************************/
+
+static void
+STFTTransform(
+	const tSTFT*	iSTFT,
+	double			ioRe[],
+	double			ioIm[])
+	
+	{
+	const long		kSize	= iSTFT->size;
+	const long*		bitRev	= iSTFT->bitRev;
+	const double*	cosTab	= iSTFT->cosTab;
+	const double*	sinTab	= iSTFT->sinTab;
+	
+	long	i, j, k, len;
+	
+	for (i = 0; i < kSize; i += 1) {
+		j = bitRev[i];
+		if (i < j) {
+			double t;
+			
+			t = ioRe[i]; ioRe[i] = ioRe[j]; ioRe[j] = t;
+			t = ioIm[i]; ioIm[i] = ioIm[j]; ioIm[j] = t;
+			}
+		}
+	
+	for (len = 2; len <= kSize; len <<= 1) {
+		const long	kHalfLen	= len >> 1,
+					kStride		= kSize / len;
+		
+		for (i = 0; i < kSize; i += len) {
+			double*	aRe = ioRe + i;
+			double*	aIm = ioIm + i;
+			double*	bRe = aRe + kHalfLen;
+			double*	bIm = aIm + kHalfLen;
+			
+			for (k = 0; k < kHalfLen; k += 1) {
+				double	wr = cosTab[k * kStride],
+						wi = sinTab[k * kStride],
+						tr = bRe[k] * wr - bIm[k] * wi,
+						ti = bRe[k] * wi + bIm[k] * wr;
+				
+				bRe[k] = aRe[k] - tr;
+				bIm[k] = aIm[k] - ti;
+				aRe[k] += tr;
+				aIm[k] += ti;
+				}
+			}
+		}
+	
+	}
+
+static void
+STFTFrame(
+	objEmeric*	me)
+	
+	{
+	tSTFT*			stft		= me->stft;
+	const long		kSize		= stft->size,
+					kHalf		= kSize / 2,
+					kHop		= stft->hop,
+					kBandCount	= me->bandCount;
+	const UInt32	kThresh		= me->noiseThresh;
+	const double*	window		= stft->window;
+	const long*		binBand		= stft->binBand;
+	
+	double*			re			= stft->re;
+	double*			im			= stft->im;
+	double*			energy		= me->bandProd;
+	double*			outBuf		= stft->outBuf;
+	double			scale		= stft->scale;
+	long			k;
+	UInt32			s1, s2, s3;
+	
+	// 1) Analysis
+	for (k = 0; k < kSize; k += 1) {
+		re[k] = stft->inBuf[k] * window[k];
+		im[k] = 0.0;
+		}
+	STFTTransform(stft, re, im);
+	
+	// 2) Envelopes. For per-band envelopes we collect band energies first and then store
+	//	  each bin's band RMS in the upper (redundant) half of im[], which is overwritten
+	//	  by the mirror image anyway
+	if (me->perBin) {
+		for (k = 1; k < kHalf; k += 1)
+			im[kSize - k] = sqrt(re[k] * re[k] + im[k] * im[k]);
+		}
+	else {
+		for (k = 0; k < kBandCount; k += 1)
+			energy[k] = 0.0;
+		for (k = 0; k <= kHalf; k += 1)
+			energy[binBand[k]] += re[k] * re[k] + im[k] * im[k];
+		for (k = 0; k < kBandCount; k += 1)
+			energy[k] = (me->bandBins[k] > 0.0) ? sqrt(energy[k] / me->bandBins[k]) : 0.0;
+		for (k = 1; k < kHalf; k += 1)
+			im[kSize - k] = energy[binBand[k]];
+		}
+	
+	// 3) Keep source bins or impose envelope on noise
+	Taus88LoadGlobal(&s1, &s2, &s3);
+	for (k = 1; k < kHalf; k += 1) {
+		if (Taus88Process(&s1, &s2, &s3) <= kThresh) {
+			double	env		= im[kSize - k];
+			UInt32	phase	= Taus88Process(&s1, &s2, &s3) >> (32 - kPhaseBits);
+			
+			re[k] = env * sPhaseCos[phase];
+			im[k] = env * sPhaseSin[phase];
+			}
+		}
+	Taus88StoreGlobal(s1, s2, s3);
+	
+	// 4) Hermitian symmetry, then synthesis
+	im[0] = im[kHalf] = 0.0;
+	for (k = 1; k < kHalf; k += 1) {
+		re[kSize - k] = re[k];
+		im[kSize - k] = -im[k];
+		}
+	STFTTransform(stft, im, re);				// Inverse: real part ends up in re[]
+	
+	// 5) Overlap-add and advance the frames by one hop
+	BlockMoveData((Ptr) (outBuf + kHop), (Ptr) outBuf, (kSize - kHop) * sizeof(double));
+	for (k = kSize - kHop; k < kSize; k += 1)
+		outBuf[k] = 0.0;
+	for (k = 0; k < kSize; k += 1)
+		outBuf[k] += re[k] * window[k] * scale;
+	
+	BlockMoveData((Ptr) (stft->inBuf + kHop), (Ptr) stft->inBuf, (kSize - kHop) * sizeof(double));
+	}
+
+static void
+PerformSTFT(
+	objEmeric*	me,
+	long		iVecSize,
+	t_sample*	iSrc,
+	t_sample*	oOut)
+	
+	{
+	tSTFT*	stft	= me->stft;
+	const long	kHop	= stft->hop;
+	double*	inTail	= stft->inBuf + stft->size - kHop;
+	double*	outHead	= stft->outBuf;
+	long	fill	= stft->fill;
+	
+	while (iVecSize > 0) {
+		long	chunk = kHop - fill,
+				i;
+		
+		if (chunk > iVecSize)
+			chunk = iVecSize;
+		
+		for (i = 0; i < chunk; i += 1) {
+			inTail[fill + i]	= iSrc[i];
+			oOut[i]				= outHead[fill + i];
+			}
+		
+		iSrc		+= chunk;
+		oOut		+= chunk;
+		iVecSize	-= chunk;
+		fill		+= chunk;
+		
+		if (fill == kHop) {
+			STFTFrame(me);
+			fill = 0;
+			}
+		}
+	
+	stft->fill = fill;
+	}
 	
 /******************************************************************************************
  *
@@ -1220,7 +1931,8 @@ PerformXFade(
  *	The actual work is done by the functions PerformNull(), PerformXFade() and Perform().
  *	PerformNull() is called when the current omega value is zero, and simply
  *	copies the input signal to the output signal (with some bookkeeping). The Perform()
- *	function is the "real thing".
+ *	function is the "real thing". When the STFT engine is selected, PerformSTFT() does
+ *	all the work, whatever the value of omega.
  *
  ******************************************************************************************/
 	
@@ -1248,7 +1960,17 @@ EmericPerform6(
 	
 	omega = ((tSampleVector) iParams[paramOmega])[0];
 	
-	if (omega == 0.0)
+	if (me->stft != NIL) {
+		float saveOmega	= me->omega;
+		
+		EmericOmega(me, omega);
+		PerformSTFT(me, iParams[paramVectorSize],
+					(tSampleVector) iParams[paramSrc],
+					(tSampleVector) iParams[paramOut]);
+		me->omega = saveOmega;
+		}
+	
+	else if (omega == 0.0)
 		PerformNull(me, iParams[paramVectorSize],
 					(tSampleVector) iParams[paramSrc],
 					(tSampleVector) iParams[paramOut]);
@@ -1297,8 +2019,12 @@ EmericPerform5(
 	
 	if (me->coreObject.z_disabled || me->ringBuf == NIL) goto exit;
 	
+	if (me->stft != NIL)
+		PerformSTFT(me, iParams[paramVectorSize],
+					(tSampleVector) iParams[paramSrc],
+					(tSampleVector) iParams[paramOut]);
 	
-	if (me->omega == 0.0)
+	else if (me->omega == 0.0)
 		PerformNull(me, iParams[paramVectorSize],
 					(tSampleVector) iParams[paramSrc],
 					(tSampleVector) iParams[paramOut]);
@@ -1319,3 +2045,273 @@ EmericPerform5(
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	PerformNull64(me, iVecSize, iInput, iOutput)
+ *	Perform64(me, iVecSize, iSrc, iTgt, oOut)
+ *	PerformXFade64(iSWeight, iVWeight, iVecSize, iSrc, iVoc)
+ *	PerformSTFT64(me, iVecSize, iSrc, oOut)
+ *
+ *	Versions of the above for 64-bit signal vectors. Filter state was already kept in
+ *	double precision, so these share FilterBankTick() with the 32-bit code.
+ *
+ ******************************************************************************************/
+
+static void
+PerformNull64(
+	objEmeric*	me,
+	long		iVecSize,
+	double*		iInput,
+	double*		iOutput)
+	
+	{
+	// ASSERT: a0 member is the same for all filters in filterbank, b1 and b2 are all zero
+	const double weight = me->rParams.a0[0];
+	const long	 kBandCount = me->bandCount;
+	
+	int				i;
+	tResonBuf*		s = &me->srcRBuf;
+	tResonBuf*		x = &me->excRBuf;
+	
+	// Maintain state of filter buffers.
+	// Need to special-case for the obnoxious situation of (iVecSize == 1)
+	if (iVecSize == 1) {
+		const double samp = iInput[0] * weight;
+		for (i = 0; i < kBandCount; i += 1) {
+			s->y2[i] = s->y1[i];
+			s->y1[i] = samp;
+			x->y2[i] = x->y1[i];
+			x->y1[i] = samp;
+			}
+		}
+	else {
+		// ASSERT: iVecSize >= 2
+		const double	samp1 = iInput[iVecSize - 1] * weight,
+						samp2 = iInput[iVecSize - 2] * weight;
+		for (i = 0; i < kBandCount; i += 1) {
+			x->y2[i] = s->y2[i] = samp2;
+			x->y1[i] = s->y1[i] = samp1;
+			}
+		}
+	
+	// ?? Should I update running sum buffer as well??
+	
+	// Copy input to output
+	if (iInput != iOutput)
+		do { *iOutput++ = *iInput++; } while (--iVecSize > 0);
+	}
+
+	static inline void
+	MungeExcitationBuffer64(
+		long			iBufSize,
+		long			iNoiseThresh,
+		const double*	iSrc,
+		const double*	iTgt,
+		t_sample*		oExc)
+		
+		{
+		UInt32	s1, s2, s3;
+			
+		Taus88LoadGlobal(&s1, &s2, &s3);
+		
+		do {
+			*oExc++ = (Taus88Process(&s1, &s2, &s3) > iNoiseThresh) ? *iSrc : *iTgt;
+			iTgt++;
+			iSrc++;
+			} while (--iBufSize > 0);
+		
+		Taus88StoreGlobal(s1, s2, s3);
+		
+		}
+
+static void
+Perform64(
+	objEmeric*	me,
+	long		iVecSize,
+	double*		iSrc,
+	double*		iTgt,
+	double*		oOut)
+	
+	{
+	const long			kRBCurSize	= me->ringBufCurSize;
+	const long			kBandCount	= me->bandCount;
+	const double		kMeanFactor	= ((double) kBandCount) / ((double) kRBCurSize);
+	tSampleVector const	kRingBufBase = &me->ringBuf[0],
+						kRingBufStop = kRingBufBase + kRBCurSize;
+	
+	floatPtr		rbCurPos	= me->ringBufCurPos;
+	long			i;
+	
+	MungeExcitationBuffer64(iVecSize, me->noiseThresh, iSrc, iTgt, me->exciteBuf);
+	
+	for (i = 0; i < iVecSize; i += 1) {
+		oOut[i] = FilterBankTick(me, iSrc[i], iTgt[i], rbCurPos, kMeanFactor);
+		
+		rbCurPos += kBandCount;
+		if (rbCurPos >= kRingBufStop)
+			rbCurPos -= kRBCurSize;
+		}
+	
+	WrapUpPerform(me, rbCurPos);
+	}
+
+static void
+PerformXFade64(
+	double		iSWeight,
+	double		iVWeight,
+	long		iVecSize,
+	double*		iSrc,
+	double*		iVoc)
+	
+	{
+	do {
+		double mix = iVWeight * *iVoc;
+		
+		mix += iSWeight * *iSrc++;
+		*iVoc++ = mix;
+		} while (--iVecSize > 0);
+	}
+
+
+static void
+PerformSTFT64(
+	objEmeric*	me,
+	long		iVecSize,
+	double*		iSrc,
+	double*		oOut)
+	
+	{
+	tSTFT*	stft	= me->stft;
+	const long	kHop	= stft->hop;
+	double*	inTail	= stft->inBuf + stft->size - kHop;
+	double*	outHead	= stft->outBuf;
+	long	fill	= stft->fill;
+	
+	while (iVecSize > 0) {
+		long	chunk = kHop - fill,
+				i;
+		
+		if (chunk > iVecSize)
+			chunk = iVecSize;
+		
+		for (i = 0; i < chunk; i += 1) {
+			inTail[fill + i]	= iSrc[i];
+			oOut[i]				= outHead[fill + i];
+			}
+		
+		iSrc		+= chunk;
+		oOut		+= chunk;
+		iVecSize	-= chunk;
+		fill		+= chunk;
+		
+		if (fill == kHop) {
+			STFTFrame(me);
+			fill = 0;
+			}
+		}
+	
+	stft->fill = fill;
+	}
+	
+/******************************************************************************************
+ *
+ *	EmericDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	EmericPerform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. A single perform method covers both EmericPerform6() and
+ *	EmericPerform5(); the user parameter is non-zero if the Omega inlet is connected.
+ *
+ ******************************************************************************************/
+
+void
+EmericDSP64(
+	objEmeric*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iFlags)
+	
+	enum {
+		inletSrcIn			= 0,
+		inletTgtIn,
+		inletOmega
+		};
+	
+	OSErr	myErr	= noErr;
+	
+	if (me->curSR != iSampleRate) {
+		myErr = SetSR(me, iSampleRate);
+		if (myErr != noErr) goto punt;
+		}
+	if (me->exciteBufSize != iMaxVectorSize) {
+		myErr = SetExciteBufSize(me, iMaxVectorSize);
+		if (myErr != noErr) goto punt;
+		}
+	
+	EmericOmega(me, me->omega);
+	
+	dsp_add64(	iDSP64, (t_object*) me, (t_perfroutine64) EmericPerform64, 0,
+				(void*) (long) (iConnectCounts[inletOmega] > 0));
+	return;
+	
+punt:
+	error("%s: can't allocate memory for buffers; object disabled.", kClassName);
+	}
+
+void
+EmericPerform64(
+	objEmeric*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iInCount, iOutCount, iFlags)
+	
+	Boolean		omegaSig	= (iUser != NIL);
+	double*		src			= iIns[0];
+	double*		tgt			= iIns[1];
+	double*		out			= iOuts[0];
+	double		omega;
+	float		saveOmega	= me->omega;
+	
+	if (me->coreObject.z_disabled || me->ringBuf == NIL) return;
+	
+	omega = omegaSig ? iIns[2][0] : me->omega;
+	
+	if (me->stft != NIL) {
+		if (omegaSig)
+			EmericOmega(me, omega);
+		
+		PerformSTFT64(me, iVectorSize, src, out);
+		
+		me->omega = saveOmega;
+		}
+	
+	else if (omega == 0.0)
+		PerformNull64(me, iVectorSize, src, out);
+	
+	else {
+		if (omegaSig)
+			EmericOmega(me, omega);
+		
+		Perform64(me, iVectorSize, src, tgt, out);
+		
+		if (me->srcXFade > 0.0)
+			PerformXFade64(me->srcXFade, me->vocXFade, iVectorSize, src, out);
+		
+		me->omega = saveOmega;
+		}
+	
+	}
@@ -42,46 +42,25 @@
 
 const char*	kClassName		= "lp.tim~";			// Class name
 
+enum {
+	kMutateBlock		= 64,						// Samples per pass in the kernels
+	kConvVectors		= 6							// Source, target, mutant, omega, pi, delta
+	};
+
 
 #pragma mark • Function Prototypes
 
 void*	NewMutator(Symbol*, short, Atom*);
 
+void	FreeMutator(tMutator*);
+
 void	BuildDSPChain(tMutator*, t_signal**, short*);
 int*	PerformMutator(int*);
-	// The following routines are where the actual work is done.
-	// The first parameters are always: Mutator object, vector size, Source signal, Target
-	// signal, and Mutant signal. The three signals are guaranteed never to be NIL.
-	// These parameters are all followed by omega. If the mutation is irregular, the 
-	// parameter pi follows. And, finally, if the mutation is not using absolute values
-	// there is a delta parameter.
-	// With control-rate mutations, omega, delta and pi are floats (taken from the first
-	// sample of the signal if non-NIL, otherwise the current values from the Mutator object
-	// are taken).
-void	CalcAbsIrregCR(	tMutator*, long,
-						t_sample*, t_sample*, t_sample*,
-						float, float);
-void	CalcAbsIrregSR(	tMutator*, long,
-						t_sample*, t_sample*, t_sample*,
-						t_sample*, t_sample*);
-void	CalcAbsUniformCR(tMutator*, long,
-						t_sample*, t_sample*, t_sample*,
-						float);
-void	CalcAbsUniformSR(tMutator*, long,
-						t_sample*, t_sample*, t_sample*,
-						t_sample*);
-void	CalcRelIrregCR(	tMutator*, long,
-						t_sample*, t_sample*, t_sample*,
-						float, float, float);
-void	CalcRelIrregSR(	tMutator*, long,
-						t_sample*, t_sample*, t_sample*,
-						t_sample*, t_sample*, t_sample*);
-void	CalcRelUniformCR(tMutator*, long,
-						t_sample*, t_sample*, t_sample*,
-						float, float);
-void	CalcRelUniformSR(tMutator*, long,
-						t_sample*, t_sample*, t_sample*,
-						t_sample*, t_sample*);
+void	BuildDSPChain64(tMutator*, t_object*, short*, double, long, long);
+void	PerformMutator64(tMutator*, t_object*, double**, long, double**, long, long, long, void*);
+	// The actual work is done by the kernels at the end of this file, one for each
+	// combination of mutation type, absolute/relative intervals, and control/sample rate.
+	// See SelectKernel().
 
 	// Various Max messages
 void	DoAssist(tMutator*, void* , long , long , char*);
@@ -108,7 +87,7 @@ main(void)
 	// Standard Max setup() call
 	setup(	&gObjectClass,				// Pointer to our class definition
 			(method) NewMutator,		// Instance creation function
-			(method) dsp_free,			// Default deallocation function
+			(method) FreeMutator,		// Custom deallocation function
 			sizeof(tMutator),			// Class object size
 			NIL,						// No menu function
 			A_GIMME,					// We parse our arguments
@@ -131,6 +110,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) BuildDSPChain, "dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) BuildDSPChain64, "dsp64",	A_CANT, 0);
 
 	//Our messages
 	addmess ((method) DoUSIM,		"usim",		A_NOTHING);
@@ -143,6 +123,9 @@ main(void)
 	addmess	((method) DoAbsInt,		"abs",		A_NOTHING);
 	addmess	((method) DoRelInt,		"rel",		A_DEFFLOAT, 0);
 	
+	addmess	((method) DoSampleRate,	"samplerate",	A_NOTHING);
+	addmess	((method) DoControlRate,	"controlrate",	A_NOTHING);
+	
 	
 	// Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -233,11 +216,33 @@ NewMutator(
 	outlet_new(me, "signal");			
 	
 	// Set up default/initial values
+	me->kernel	= NIL;
+	me->sigConn	= 0;
+	me->bufSize	= 0;
+	me->convBuf	= NIL;
 	Initialize(me, initType, initOmega, initPi, initDelta, gotInitDelta);
 	
 	return me;
 	}
 
+/******************************************************************************************
+ *
+ *	FreeMutator(me)
+ *
+ ******************************************************************************************/
+
+void
+FreeMutator(
+	tMutator* me)
+	
+	{
+	// Do this first, in case DSP is still running
+	dsp_free(&(me->coreObject));
+	
+	if (me->convBuf != NIL)
+		DisposePtr((Ptr) me->convBuf);
+	}
+
 #pragma mark -
 #pragma mark • Object Message Handlers
 
@@ -328,6 +333,39 @@ DoTattle(
 #pragma mark -
 #pragma mark • DSP Methods
 
+/******************************************************************************************
+ *
+ *	SetBufSize(me, iVecSize)
+ *
+ *	Make sure the conversion buffer has room for six vectors of iVecSize samples (source,
+ *	target, mutant, and the three parameter signals). Only needed by the 32-bit chain.
+ *
+ ******************************************************************************************/
+
+static OSErr
+SetBufSize(
+	tMutator*	me,
+	long		iVecSize)
+	
+	{
+	double*	newBuf;
+	
+	if (me->bufSize >= iVecSize)
+		return noErr;
+	
+	newBuf = (double*) NewPtr(kConvVectors * iVecSize * sizeof(double));
+	if (newBuf == NIL)
+		return MemError();
+	
+	if (me->convBuf != NIL)
+		DisposePtr((Ptr) me->convBuf);
+	me->convBuf = newBuf;
+	me->bufSize = iVecSize;
+	
+	return noErr;
+	}
+
+
 /******************************************************************************************
  *
  *	BuildDSPChain(me, ioDSPVectors, iConnectCounts)
@@ -341,6 +379,7 @@ BuildDSPChain(
 	short*		iConnectCounts)
 	
 	{
+	long	vecSize = ioDSPVectors[inletSource]->s_n;
 	
 	// Make sure we have connections at source, target, and mutant.
 	// Otherwise there's no point in doing any DSP!
@@ -349,10 +388,21 @@ BuildDSPChain(
 			|| iConnectCounts[outletMutant] == 0)
 		return;
 	
+	if (SetBufSize(me, vecSize) != noErr) {
+		error("%s: can't allocate memory for buffers; object disabled.", kClassName);
+		return;
+		}
+	
+	me->sigConn = 0;
+	if (iConnectCounts[inletOmega] > 0)	me->sigConn |= connOmega;
+	if (iConnectCounts[inletPi] > 0)	me->sigConn |= connPi;
+	if (iConnectCounts[inletDelta] > 0)	me->sigConn |= connDelta;
+	SelectKernel(me);
+	
 	dsp_add(
 		PerformMutator,
 		8, me,
-		(long) ioDSPVectors[inletSource]->s_n,
+		vecSize,
 		ioDSPVectors[inletSource]->s_vec,
 		ioDSPVectors[inletTarget]->s_vec,
 		iConnectCounts[inletOmega] > 0 ? ioDSPVectors[inletOmega]->s_vec : NIL,
@@ -375,15 +425,29 @@ BuildDSPChain(
  *		- Source signal
  *		- Target signal
  *		- Mutation Index signal
- *		- Delta Emphasis signal
  *		- Clumping signal
+ *		- Delta Emphasis signal
  *		- Mutant signal (out)
  *
- *	This perform methods route to the specific mutation performance routine appropriate
- *	for the current value of mutationType.
+ *	The kernels all work in double precision, so we copy the signals into the conversion
+ *	buffer, let the kernel selected for the current settings do its stuff, and copy the
+ *	mutant back out.
  *
  ******************************************************************************************/
 
+	static inline double* CopyToDouble(const t_sample* iSig, double* oBuf, long iCount)
+		{
+		long i;
+		
+		if (iSig == NIL)
+			return NIL;
+		
+		for (i = 0; i < iCount; i += 1)
+			oBuf[i] = iSig[i];
+		
+		return oBuf;
+		}
+
 int*
 PerformMutator(
 	int* iParams)
@@ -404,553 +468,821 @@ PerformMutator(
 		};
 	
 	tMutator*	me = (tMutator*) iParams[paramMe];
+	long		vecSize,
+				i;
+	double*		buf;
+	t_sample*	mutant;
 	
 	if (me->coreObject.z_disabled) goto exit;
 	
-	// Parameters for the vector calculation method depend upon whether the mutation
-	// is irregular or uniform; if absolute or relative intervals are used; and if
-	// there are any signals that need to be sampled at audio rate.
-	
-	if (!me->params.irregular) {
-		if (!me->params.relInterval) {
-			// Absolute Intervals
-			// The only parameter we have to worry about is the Mutation Index
-			if (iParams[paramOmega] && (me->params.omegaSR)) {
-				CalcAbsUniformSR(
-						me, (long) iParams[paramVectorSize],
-						(t_sample*) iParams[paramSource],
-						(t_sample*) iParams[paramTarget],
-						(t_sample*) iParams[paramMutant],
-						(t_sample*) iParams[paramOmega]);
-				}
-			else {
-				CalcAbsUniformCR(
-						me, (long) iParams[paramVectorSize],
-						(t_sample*) iParams[paramSource],
-						(t_sample*) iParams[paramTarget],
-						(t_sample*) iParams[paramMutant],
-						iParams[paramOmega]
-							? *((t_sample*) iParams[paramOmega])
-							: me->params.omega);
-				}
-			}
-		
-		else {
-			// Relative intervals
-			// Weed to consider Mutation Index and Delta Emphasis
-			if (iParams[paramOmega] && (me->params.omegaSR)
-					|| iParams[paramDelta] && (me->params.deltaSR) ) {
-				CalcRelUniformSR(
-						me, (long) iParams[paramVectorSize],
-						(t_sample*) iParams[paramSource],
-						(t_sample*) iParams[paramTarget],
-						(t_sample*) iParams[paramMutant],
-						(t_sample*) iParams[paramOmega],
-						(t_sample*) iParams[paramDelta]);
-				}
-			else {
-				CalcRelUniformCR(
-						me, (long) iParams[paramVectorSize],
-						(t_sample*) iParams[paramSource],
-						(t_sample*) iParams[paramTarget],
-						(t_sample*) iParams[paramMutant],
-						iParams[paramOmega]
-							? *((t_sample*) iParams[paramOmega])
-							: me->params.omega,
-						iParams[paramDelta]
-							? *((t_sample*) iParams[paramDelta])
-							: me->params.delta);
-				}
-			}
-		}
+	vecSize	= (long) iParams[paramVectorSize];
+	mutant	= (t_sample*) iParams[paramMutant];
+	buf		= me->convBuf;
 	
-	// Irregular Mutations
-	else if (!me->params.relInterval) {
-		// Absolute Intervals
-		// Possible signals in Omega and Pi
-		if (iParams[paramOmega] && (me->params.omegaSR)
-				|| iParams[paramPi] && (me->params.piSR)) {
-			CalcAbsIrregSR(
-				me, (long) iParams[paramVectorSize],
-				(t_sample*) iParams[paramSource],
-				(t_sample*) iParams[paramTarget],
-				(t_sample*) iParams[paramMutant],
-				(t_sample*) iParams[paramOmega],
-				(t_sample*) iParams[paramPi]);
-			}
-		else {
-			CalcAbsIrregCR(
-				me, (long) iParams[paramVectorSize],
-				(t_sample*) iParams[paramSource],
-				(t_sample*) iParams[paramTarget],
-				(t_sample*) iParams[paramMutant],
-				iParams[paramOmega] ? *((t_sample*) iParams[paramOmega]) : me->params.omega,
-				iParams[paramPi] ? *((t_sample*) iParams[paramPi]) : me->params.pi);
-			}
-		}
+	me->kernel(
+		me, vecSize,
+		CopyToDouble((t_sample*) iParams[paramSource], buf, vecSize),
+		CopyToDouble((t_sample*) iParams[paramTarget], buf + vecSize, vecSize),
+		buf + 2 * vecSize,
+		CopyToDouble((t_sample*) iParams[paramOmega], buf + 3 * vecSize, vecSize),
+		CopyToDouble((t_sample*) iParams[paramPi], buf + 4 * vecSize, vecSize),
+		CopyToDouble((t_sample*) iParams[paramDelta], buf + 5 * vecSize, vecSize));
+	
+	buf += 2 * vecSize;
+	for (i = 0; i < vecSize; i += 1)
+		mutant[i] = buf[i];
 	
-	// Irregular w/relative intervals; possible signals in Omega, Delta, and Pi
-	else if (iParams[paramOmega] && (me->params.omegaSR)
-				|| iParams[paramPi] && (me->params.piSR)
-				|| iParams[paramDelta] && (me->params.deltaSR)) {
-		CalcRelIrregSR(
-			me, (long) iParams[paramVectorSize],
-			(t_sample*) iParams[paramSource],
-			(t_sample*) iParams[paramTarget],
-			(t_sample*) iParams[paramMutant],
-			(t_sample*) iParams[paramOmega],
-			(t_sample*) iParams[paramPi],
-			(t_sample*) iParams[paramDelta]);
-		}
-		
-	else CalcRelIrregCR(
-			me, (long) iParams[paramVectorSize],
-			(t_sample*) iParams[paramSource],
-			(t_sample*) iParams[paramTarget],
-			(t_sample*) iParams[paramMutant],
-			iParams[paramOmega] ? *((t_sample*) iParams[paramOmega]) : me->params.omega,
-			iParams[paramPi] ? *((t_sample*) iParams[paramPi]) : me->params.pi,
-			iParams[paramDelta] ? *((t_sample*) iParams[paramDelta]) : me->params.delta);
-		
 exit:
 	return iParams + paramNextLink;
 	}
 
+
 /******************************************************************************************
  *
- *	CalcAbsIrregCR(me, iVectorSize, iSource, iTarget, oMutant, iOmega, iPi)
- *	CalcAbsIrregSR(me, iVectorSize, iSource, iTarget, oMutant, iOmega, iPi)
+ *	BuildDSPChain64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	PerformMutator64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. The kernels work on 64-bit vectors natively, so no
+ *	conversion is needed here.
  *
  ******************************************************************************************/
 
 void
-CalcAbsIrregCR(
+BuildDSPChain64(
 	tMutator*	me,
-	long		iVectorSize,
-	t_sample*	iSource,
-	t_sample*	iTarget,
-	t_sample*	oMutant,
-	float		iOmega,
-	float		iPi)
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
 	
 	{
-	tMutate1Func
-			mutateFunc	= me->params.function.irregularFunc;
+	#pragma unused(iSampleRate, iMaxVectorSize, iFlags)
 	
-	if (iOmega == 0.0) do {
-		double curMutant = *iSource++;
-		
-		*oMutant++ = curMutant;
-		} while (--iVectorSize > 0);
-	
-	else if (iOmega == 1.0) do {
-		double curMutant = mutateFunc(*iSource++, *iTarget++);
-		
-		*oMutant++ = curMutant;
-		} while (--iVectorSize > 0);
+	if (iConnectCounts[inletSource] == 0
+			|| iConnectCounts[inletTarget] == 0
+			|| iConnectCounts[outletMutant] == 0)
+		return;
 	
-	else {
-		// iOmega in (0.0 .. 1.0)
-		unsigned long
-				mutantToMutantThresh,
-				sourceToMutantThresh,
-				curThresh		= CalcMutantThreshholds(iOmega, iPi,
-														&sourceToMutantThresh,
-														&mutantToMutantThresh);
-		unsigned wishMutants	= ((float) iVectorSize) * iOmega + 0.5;
-		
-		 do {
-			double	curSource, curTarget, curMutant;
-			curSource = *iSource++,
-			curTarget = *iTarget++;
-			if ( WannaMutateTight(curThresh, wishMutants, iVectorSize) ) {
-				curThresh = mutantToMutantThresh;
-				wishMutants -= 1;
-				curMutant = mutateFunc(curSource, curTarget);
-				}
-			else {
-				curThresh = sourceToMutantThresh;
-				curMutant = curSource;
-				}
-			
-			*oMutant++ = curMutant;
-			} while (--iVectorSize > 0);
-		}
+	me->sigConn = 0;
+	if (iConnectCounts[inletOmega] > 0)	me->sigConn |= connOmega;
+	if (iConnectCounts[inletPi] > 0)	me->sigConn |= connPi;
+	if (iConnectCounts[inletDelta] > 0)	me->sigConn |= connDelta;
+	SelectKernel(me);
 	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) PerformMutator64, 0, NIL);
 	}
+	
 
 void
-CalcAbsIrregSR(
+PerformMutator64(
 	tMutator*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
 	long		iVectorSize,
-	t_sample*	iSource,
-	t_sample*	iTarget,
-	t_sample*	oMutant,
-	t_sample*	iOmega,
-	t_sample*	iPi)
+	long		iFlags,
+	void*		iUser)
 	
 	{
-	Boolean	mutating	= stateIndeterminate;
-	tMutate1Func
-			mutateFunc	= me->params.function.irregularFunc;
-	
-	 do {
-		double			curOmega	= iOmega ? *iOmega++ : me->params.omega,
-						curPi		= iPi ? *iPi++ : me->params.pi,
-						curMutant;
-		unsigned long	mutateThresh;
-		
-		switch (mutating) {
-			case stateSource:
-				mutateThresh = CalcSourceToMutantThresh(
-									curOmega,
-									CalcOmegaPrime(curOmega, curPi));
-				break;
-			case stateTarget:
-				mutateThresh = CalcMutantToMutantThresh(CalcOmegaPrime(curOmega, curPi));
-				break;
-			default:
-				mutateThresh = CalcInitThresh(curOmega);
-				break;
-			}
-			
-		if ( WannaMutateStrict(mutateThresh) ) {
-			mutating = stateTarget;
-			curMutant = mutateFunc(*iSource++, *iTarget++);
-			}
-		else {
-			mutating = stateSource;
-			curMutant = *iSource++;
-			iTarget += 1;				// Ignore target value
-			}
-		
-		*oMutant++ = curMutant;
-		} while (--iVectorSize > 0);
+	#pragma unused(iDSP64, iInCount, iOutCount, iFlags, iUser)
+	
+	long	conn = me->sigConn;
 	
+	if (me->coreObject.z_disabled) return;
+	
+	me->kernel(
+		me, iVectorSize,
+		iIns[inletSource], iIns[inletTarget], iOuts[0],
+		(conn & connOmega) ? iIns[inletOmega] : NIL,
+		(conn & connPi) ? iIns[inletPi] : NIL,
+		(conn & connDelta) ? iIns[inletDelta] : NIL);
 	}
 
+
+#pragma mark -
+#pragma mark • Calculation Kernels
+
 /******************************************************************************************
  *
- *	CalcAbsUniformCR(me, iVectorSize, iSource, iTarget, oMutant, iOmega)
- *	CalcAbsUniformSR(me, iVectorSize, iSource, iTarget, oMutant, iOmega)
+ *	FillRandom(oRand, iCount)
+ *	ParamBlock(iSig, iDefault, oBuf, iCount)
+ *	DecideTight(iCount, iSamplesLeft, iRand, iSrcToMut, iMutToMut, iInitThresh,
+ *					ioState, ioWishMutants, oMutate)
+ *	DecideStrict(iCount, iRand, iSrcToMut, iMutToMut, iInitThresh, ioState, oMutate)
+ *
+ *	Helpers for the kernels below.
+ *
+ *	The irregular kernels take their random numbers kMutateBlock at a time from
+ *	FillRandom(). The Decide...() functions compare the whole block against the
+ *	source-to-mutant and mutant-to-mutant thresholds in one pass (no dependencies between
+ *	samples, so this vectorizes), which leaves only a trivial walk along the two-state
+ *	Markov chain to be done one sample at a time. The walk follows the same rules as
+ *	WannaMutateTight() and WannaMutateStrict(); the initial threshold is only consulted
+ *	while the state is indeterminate.
+ *
+ *	ParamBlock() returns a pointer to iCount parameter values: the signal itself if there
+ *	is one, otherwise oBuf filled with the default value.
  *
  ******************************************************************************************/
 
-void
-CalcAbsUniformCR(
-	tMutator*	me,
-	long		iVectorSize,
-	t_sample*	iSource,
-	t_sample*	iTarget,
-	t_sample*	oMutant,
-	float		iOmega)
+static void
+FillRandom(
+	UInt32	oRand[],
+	long	iCount)
 	
 	{
-	tMutateFunc mutateFunc	= me->params.function.uniformFunc;
+	UInt32	s1, s2, s3;
 	
-	if (iOmega == 0.0) do {
-		double curMutant = *iSource++;
-		
-		*oMutant++ = curMutant;
-		} while (--iVectorSize > 0);
+	Taus88LoadGlobal(&s1, &s2, &s3);
+	while (iCount-- > 0)
+		*oRand++ = Taus88Process(&s1, &s2, &s3);
+	Taus88StoreGlobal(s1, s2, s3);
+	}
+
+static inline const double*
+ParamBlock(
+	const double*	iSig,
+	double			iDefault,
+	double			oBuf[],
+	long			iCount)
 	
-	else do {
-		double curMutant = mutateFunc(*iSource++, *iTarget++, iOmega);
-		
-		*oMutant++ = curMutant;
-		} while (--iVectorSize > 0);
+	{
+	long i;
+	
+	if (iSig != NIL)
+		return iSig;
 	
+	for (i = 0; i < iCount; i += 1)
+		oBuf[i] = iDefault;
+	
+	return oBuf;
 	}
+
+static void
+DecideTight(
+	long			iCount,
+	long			iSamplesLeft,
+	const UInt32	iRand[],
+	unsigned long	iSrcToMut,
+	unsigned long	iMutToMut,
+	unsigned long	iInitThresh,
+	Byte*			ioState,
+	long*			ioWishMutants,
+	Byte			oMutate[])
+	
+	{
+	Byte	fromSource[kMutateBlock],
+			fromMutant[kMutateBlock],
+			state		= *ioState;
+	long	wish		= *ioWishMutants,
+			i;
+	
+	for (i = 0; i < iCount; i += 1) {
+		fromSource[i] = iRand[i] < iSrcToMut;
+		fromMutant[i] = iRand[i] < iMutToMut;
+		}
+	
+	for (i = 0; i < iCount; i += 1, iSamplesLeft -= 1) {
+		Byte mutate;
 		
-void
-CalcAbsUniformSR(
-	tMutator*	me,
-	long		iVectorSize,
-	t_sample*	iSource,
-	t_sample*	iTarget,
-	t_sample*	oMutant,
-	t_sample*	iOmega)
+		if (wish >= iSamplesLeft)	mutate = true;
+		else if (wish <= 0)			mutate = false;
+		else switch (state) {
+			case stateSource:	mutate = fromSource[i];				break;
+			case stateTarget:	mutate = fromMutant[i];				break;
+			default:			mutate = iRand[i] < iInitThresh;	break;
+			}
+		
+		wish		-= mutate;
+		state		= mutate ? stateTarget : stateSource;
+		oMutate[i]	= mutate;
+		}
+	
+	*ioState		= state;
+	*ioWishMutants	= wish;
+	}
+
+static void
+DecideStrict(
+	long				iCount,
+	const UInt32		iRand[],
+	const unsigned long	iSrcToMut[],
+	const unsigned long	iMutToMut[],
+	unsigned long		iInitThresh,
+	Byte*				ioState,
+	Byte				oMutate[])
 	
 	{
-	tMutateFunc mutateFunc	= me->params.function.uniformFunc;
+	Byte	fromSource[kMutateBlock],
+			fromMutant[kMutateBlock],
+			state		= *ioState;
+	long	i;
+	
+	for (i = 0; i < iCount; i += 1) {
+		fromSource[i] = iRand[i] < iSrcToMut[i];
+		fromMutant[i] = iRand[i] < iMutToMut[i];
+		}
 	
-	 do {
-		double curMutant = mutateFunc(*iSource++, *iTarget++, *iOmega++);
+	for (i = 0; i < iCount; i += 1) {
+		Byte mutate;
+		
+		switch (state) {
+			case stateSource:	mutate = fromSource[i];				break;
+			case stateTarget:	mutate = fromMutant[i];				break;
+			default:			mutate = iRand[i] < iInitThresh;	break;
+			}
 		
-		*oMutant++ = curMutant;
-		} while (--iVectorSize > 0);
+		state		= mutate ? stateTarget : stateSource;
+		oMutate[i]	= mutate;
+		}
 	
+	*ioState = state;
 	}
 
+
 /******************************************************************************************
  *
- *	CalcRelIrregCR(me, iVectorSize, iSource, iTarget, oMutant, iOmega, iPi, iDelta)
- *	CalcRelIrregSR(me, iVectorSize, iSource, iTarget, oMutant, iOmega, iPi, iDelta)
+ *	CalcStrictThresholds(iCount, iOmega, iPi, oSrcToMut, oMutToMut)
+ *
+ *	Per-sample thresholds for signal-rate Omega and Pi. Same values as
+ *	CalcSourceToMutantThresh() and CalcMutantToMutantThresh() with CalcOmegaPrime(), but
+ *	written out inline so the loop has no calls other than pow().
  *
  ******************************************************************************************/
 
-void
-CalcRelIrregCR(
-	tMutator*	me,
-	long		iVectorSize,
-	t_sample*	iSource,
-	t_sample*	iTarget,
-	t_sample*	oMutant,
-	float		iOmega,
-	float		iPi,
-	float		iDelta)
+static void
+CalcStrictThresholds(
+	long			iCount,
+	const double	iOmega[],
+	const double	iPi[],
+	unsigned long	oSrcToMut[],
+	unsigned long	oMutToMut[])
 	
 	{
-	double	prevSource	= me->history.source,
-			prevTarget	= me->history.target,
-			prevMutant	= me->history.mutant;
-	Byte	prevState	= me->history.state;
-	tEmphasisFunction
-			emphFunc	=  (iDelta == 0.0)
-							? EmphasizeZero 
-							: (iDelta > 0.0) ? EmphasizePos : EmphasizeNeg;
-	double	effectDelta = EffectiveDeltaValue(iDelta);
-	tMutate1Func
-			mutateFunc	= me->params.function.irregularFunc;
-	
-	if (iOmega == 0.0) {
-		// We won't use the Target vector, but we must update prevTarget in case
-		// the next call to this method needs the value. We need to do this now,
-		// before we abuse iVectorSize as an index...
-		prevTarget = iTarget[iVectorSize - 1];
-		
-		 do {
-			double	curSource = *iSource++,
-					curMutant;
-			curMutant = emphFunc(prevMutant, curSource - prevSource, effectDelta);
-			
-			prevSource = curSource;
-			*oMutant++ = prevMutant = curMutant;
-			} while (--iVectorSize > 0);
-		}
+	long i;
 	
-	else if (iOmega == 1.0) do {
-		double	curSource = *iSource++,
-				curTarget = *iTarget++,
-				curMutant;
-		curMutant = emphFunc(
-						prevMutant,
-						mutateFunc(curSource - prevSource, curTarget - prevTarget),
-						effectDelta);
+	for (i = 0; i < iCount; i += 1) {
+		double	omega		= iOmega[i],
+				omegaPrime	= (omega <= 0.0) ? 0.0 : CalcOmegaPrimeCore(omega, iPi[i]);
 		
-		prevSource = curSource;
-		prevTarget = curTarget;
-		*oMutant++ = prevMutant = curMutant;
-		} while (--iVectorSize > 0);
+		oSrcToMut[i] = (omega <= 0.0)
+							? -1
+							: (omega >= 1.0)
+								? kULongMax
+								: CalcSourceToMutantThreshCore(omega, omegaPrime);
+		oMutToMut[i] = (omegaPrime <= 0.0)
+							? 0
+							: CalcMutantToMutantThreshCore(omegaPrime);
+		}
+	}
+
+
+/******************************************************************************************
+ *
+ *	CalcAbsUniformCR(me, iVectorSize, iSource, iTarget, oMutant, iOmega, iPi, iDelta, iType)
+ *	CalcAbsUniformSR(me, iVectorSize, iSource, iTarget, oMutant, iOmega, iPi, iDelta, iType)
+ *	CalcAbsIrregCR(me, iVectorSize, iSource, iTarget, oMutant, iOmega, iPi, iDelta, iType)
+ *	CalcAbsIrregSR(me, iVectorSize, iSource, iTarget, oMutant, iOmega, iPi, iDelta, iType)
+ *
+ *	Generic kernels for absolute intervals. These are never called directly; each is
+ *	instantiated once per mutation type below, with iType a constant, so that the mutation
+ *	arithmetic is inlined into the loops.
+ *
+ *	The parameter signals are NIL if nothing is connected to the corresponding inlet.
+ *	With control-rate kernels only the first sample of a parameter signal is used.
+ *
+ *	iSource and iTarget may be the same vector as oMutant (MSP is allowed to do that), so
+ *	the irregular kernels make their decisions for a block before writing any output.
+ *
+ ******************************************************************************************/
+
+static inline void
+CalcAbsUniformCR(
+	tMutator*		me,
+	long			iVectorSize,
+	const double*	iSource,
+	const double*	iTarget,
+	double*			oMutant,
+	const double*	iOmega,
+	const double*	iPi,
+	const double*	iDelta,
+	int				iType)
+	
+	{
+	#pragma unused(iPi, iDelta)
+	
+	double	omega = iOmega ? iOmega[0] : me->params.omega;
+	long	i;
+	
+	if (omega == 0.0) {
+		for (i = 0; i < iVectorSize; i += 1)
+			oMutant[i] = iSource[i];
+		}
+	
+	else for (i = 0; i < iVectorSize; i += 1)
+		oMutant[i] = MutateUniform(iType, iSource[i], iTarget[i], omega);
+	
+	}
+
+static inline void
+CalcAbsUniformSR(
+	tMutator*		me,
+	long			iVectorSize,
+	const double*	iSource,
+	const double*	iTarget,
+	double*			oMutant,
+	const double*	iOmega,
+	const double*	iPi,
+	const double*	iDelta,
+	int				iType)
+	
+	{
+	#pragma unused(me, iPi, iDelta)
+	
+	long i;
+	
+	// ASSERT: iOmega != NIL (otherwise we'd have selected the control-rate kernel)
+	for (i = 0; i < iVectorSize; i += 1)
+		oMutant[i] = MutateUniform(iType, iSource[i], iTarget[i], iOmega[i]);
+	
+	}
+
+static inline void
+CalcAbsIrregCR(
+	tMutator*		me,
+	long			iVectorSize,
+	const double*	iSource,
+	const double*	iTarget,
+	double*			oMutant,
+	const double*	iOmega,
+	const double*	iPi,
+	const double*	iDelta,
+	int				iType)
+	
+	{
+	#pragma unused(iDelta)
+	
+	double	omega	= iOmega ? iOmega[0] : me->params.omega,
+			pi		= iPi ? iPi[0] : me->params.pi;
+	long	i;
+	
+	if (omega == 0.0) {
+		for (i = 0; i < iVectorSize; i += 1)
+			oMutant[i] = iSource[i];
+		}
+	
+	else if (omega == 1.0) {
+		for (i = 0; i < iVectorSize; i += 1)
+			oMutant[i] = MutateIrregular(iType, iSource[i], iTarget[i]);
+		}
 	
 	else {
-		// iOmega in (0.0 .. 1.0)
-		unsigned long
-				mutantToMutantThresh,
-				sourceToMutantThresh,
-				curThresh		= CalcMutantThreshholds(iOmega, iPi,
-														&sourceToMutantThresh,
-														&mutantToMutantThresh);
-		unsigned wishMutants	= ((float) iVectorSize) * iOmega + 0.5;
-		
-		do	{
-			double	curSource	= *iSource++,
-					curTarget	= *iTarget++,
-					deltaMutant,
-					curMutant;
-			if ( WannaMutateTight(curThresh, wishMutants, iVectorSize) ) {
-				curThresh = mutantToMutantThresh;
-				wishMutants -= 1;
-				deltaMutant = mutateFunc(curSource - prevSource, curTarget - prevTarget);
-				}
-			else {
-				curThresh = sourceToMutantThresh;
-				deltaMutant = curSource - prevSource;	// Mutant interval for Omega = 0 is just the source interval
-				}
-			curMutant = emphFunc(prevMutant, deltaMutant, effectDelta);
+		// omega in (0.0 .. 1.0)
+		UInt32			rand[kMutateBlock];
+		Byte			mutate[kMutateBlock],
+						state			= stateIndeterminate;
+		unsigned long	srcToMut,
+						mutToMut,
+						initThresh		= CalcMutantThreshholds(omega, pi, &srcToMut, &mutToMut);
+		long			wishMutants		= ((float) iVectorSize) * omega + 0.5,
+						done;
+		
+		for (done = 0; done < iVectorSize; done += kMutateBlock) {
+			long count = iVectorSize - done;
+			if (count > kMutateBlock) count = kMutateBlock;
 			
-			prevSource = curSource;
-			prevTarget = curTarget;
-			*oMutant++ = prevMutant = curMutant;
-			} while (--iVectorSize > 0);
+			FillRandom(rand, count);
+			DecideTight(count, iVectorSize - done, rand, srcToMut, mutToMut, initThresh,
+						&state, &wishMutants, mutate);
+			
+			for (i = 0; i < count; i += 1) {
+				double	curSource = iSource[done + i];
+				
+				oMutant[done + i] = mutate[i]
+										? MutateIrregular(iType, curSource, iTarget[done + i])
+										: curSource;
+				}
+			}
 		}
 	
-	me->history.source	= prevSource;
-	me->history.target	= prevTarget;
-	me->history.mutant	= prevMutant;
-	me->history.state	= prevState;
 	}
-		
 
-void
-CalcRelIrregSR(
-	tMutator*	me,
-	long		iVectorSize,
-	t_sample*	iSource,
-	t_sample*	iTarget,
-	t_sample*	oMutant,
-	t_sample*	iOmega,
-	t_sample*	iPi,
-	t_sample*	iDelta)
+static inline void
+CalcAbsIrregSR(
+	tMutator*		me,
+	long			iVectorSize,
+	const double*	iSource,
+	const double*	iTarget,
+	double*			oMutant,
+	const double*	iOmega,
+	const double*	iPi,
+	const double*	iDelta,
+	int				iType)
 	
 	{
-	Byte	mutating	= stateIndeterminate;
-	double	prevSource	= me->history.source,
-			prevTarget	= me->history.target,
-			prevMutant	= me->history.mutant;
-	tMutate1Func
-			mutateFunc	= me->params.function.irregularFunc;
-	
-	do {
-		double			curOmega	= iOmega ? *iOmega++ : me->params.omega,
-						curPi		= iPi ? *iPi++ : me->params.pi,
-						curDelta	= iDelta ? *iDelta++ : me->params.delta,
-						deltaMutant,
-						curMutant;
-		unsigned long	mutateThresh;
-		
-		switch (mutating) {
-			case stateSource:
-				mutateThresh = CalcSourceToMutantThresh(
-									curOmega,
-									CalcOmegaPrime(curOmega, curPi));
-				break;
-			case stateTarget:
-				mutateThresh = CalcMutantToMutantThresh(CalcOmegaPrime(curOmega, curPi));
-				break;
-			default:
-				mutateThresh = CalcInitThresh(curOmega);
-				break;
-			}
+	#pragma unused(iDelta)
+	
+	UInt32			rand[kMutateBlock];
+	unsigned long	srcToMut[kMutateBlock],
+					mutToMut[kMutateBlock];
+	double			omegaBuf[kMutateBlock],
+					piBuf[kMutateBlock];
+	Byte			mutate[kMutateBlock],
+					state		= stateIndeterminate;
+	long			done,
+					i;
+	
+	for (done = 0; done < iVectorSize; done += kMutateBlock) {
+		long			count = iVectorSize - done;
+		const double	*omega, *pi;
+		
+		if (count > kMutateBlock) count = kMutateBlock;
+		
+		omega	= ParamBlock(iOmega ? iOmega + done : NIL, me->params.omega, omegaBuf, count);
+		pi		= ParamBlock(iPi ? iPi + done : NIL, me->params.pi, piBuf, count);
+		
+		CalcStrictThresholds(count, omega, pi, srcToMut, mutToMut);
+		FillRandom(rand, count);
+		DecideStrict(count, rand, srcToMut, mutToMut, CalcInitThresh(omega[0]), &state, mutate);
 		
-		if ( WannaMutateStrict(mutateThresh) ) {
-			mutating = stateTarget;
-			deltaMutant = mutateFunc(*iSource - prevSource, *iTarget - prevTarget);
+		for (i = 0; i < count; i += 1) {
+			double	curSource = iSource[done + i];
+			
+			oMutant[done + i] = mutate[i]
+									? MutateIrregular(iType, curSource, iTarget[done + i])
+									: curSource;
 			}
-		else {
-			mutating = stateSource;
-			deltaMutant = *iSource - prevSource;	// Mutant interval for Omega = 0 is
-			}										// just the source interval
-		curMutant = (curDelta >= 0.0)
-						? EmphasizePos(prevMutant, deltaMutant, 1.0 - curDelta)
-						: EmphasizeNeg(prevMutant, deltaMutant, 1.0 + curDelta);
-		
-		prevSource = *iSource++;
-		prevTarget = *iTarget++;
-		*oMutant++ = prevMutant = curMutant;
-		} while (--iVectorSize > 0);
+		}
 	
-	me->history.source	= prevSource;
-	me->history.target	= prevTarget;
-	me->history.mutant	= prevMutant;
 	}
-		
+
 
 /******************************************************************************************
  *
- *	CalcRelUniformCR(me, iVectorSize, iSource, iTarget, oMutant, iOmega, iDelta)
- *	CalcRelUniformSR(me, iVectorSize, iSource, iTarget, oMutant, iOmega, iDelta)
+ *	CalcRelUniformCR(me, iVectorSize, iSource, iTarget, oMutant, iOmega, iPi, iDelta, iType)
+ *	CalcRelUniformSR(me, iVectorSize, iSource, iTarget, oMutant, iOmega, iPi, iDelta, iType)
+ *	CalcRelIrregCR(me, iVectorSize, iSource, iTarget, oMutant, iOmega, iPi, iDelta, iType)
+ *	CalcRelIrregSR(me, iVectorSize, iSource, iTarget, oMutant, iOmega, iPi, iDelta, iType)
+ *
+ *	Generic kernels for relative intervals.
+ *
+ *	Each block is done in two passes. The first calculates the mutant intervals; it has no
+ *	dependencies between samples and vectorizes. The second applies Delta Emphasis, which
+ *	depends on the previous mutant and so must run sample by sample. Both
+ *	EmphasizePos() and EmphasizeNeg() (and EmphasizeZero()) can be written as
+ *
+ *		mutant = a * prevMutant + b * interval
+ *
+ *	with one of the coefficients equal to 1.0 (see EmphPrevCoeff() and EmphIntCoeff() in
+ *	imLib.h), giving bit-identical results without any branches in the second pass.
  *
  ******************************************************************************************/
 
-void
+	// Source and target intervals for one block, relative to the last samples of the
+	// previous block
+static inline void
+CalcIntervals(
+	long			iCount,
+	const double*	iSig,
+	double			iPrev,
+	double			oInterval[])
+	
+	{
+	long i;
+	
+	oInterval[0] = iSig[0] - iPrev;
+	for (i = 1; i < iCount; i += 1)
+		oInterval[i] = iSig[i] - iSig[i-1];
+	}
+
+static inline void
 CalcRelUniformCR(
-	tMutator*	me,
-	long		iVectorSize,
-	t_sample*	iSource,
-	t_sample*	iTarget,
-	t_sample*	oMutant,
-	float		iOmega,
-	float		iDelta)
+	tMutator*		me,
+	long			iVectorSize,
+	const double*	iSource,
+	const double*	iTarget,
+	double*			oMutant,
+	const double*	iOmega,
+	const double*	iPi,
+	const double*	iDelta,
+	int				iType)
 	
 	{
-	double	prevSource	= me->history.source,
+	#pragma unused(iPi)
+	
+	double	omega		= iOmega ? iOmega[0] : me->params.omega,
+			delta		= iDelta ? iDelta[0] : me->params.delta,
+			prevCoeff	= EmphPrevCoeff(delta),
+			intCoeff	= EmphIntCoeff(delta),
+			prevSource	= me->history.source,
 			prevTarget	= me->history.target,
 			prevMutant	= me->history.mutant;
-	tEmphasisFunction
-			emphFunc	=  (iDelta == 0.0)
-							? EmphasizeZero 
-							: (iDelta > 0.0) ? EmphasizePos : EmphasizeNeg;
-	double	effectDelta = EffectiveDeltaValue(iDelta);
-	
-	if (iOmega == 0.0) {
-		// We won't use the Target vector, but we must update prevTarget in case
-		// the next call to this method needs the value. We need to do this now,
-		// before we abuse iVectorSize as an index...
-		prevTarget = iTarget[iVectorSize - 1];
-		
-		 do {
-			double curSource, curMutant;
-			curSource = *iSource++;
-			curMutant = emphFunc(prevMutant, curSource - prevSource, effectDelta);
-			
-			prevSource = curSource;
-			*oMutant++ = prevMutant = curMutant;
-			} while (--iVectorSize > 0);
-		}
-	
-	else {
-		tMutateFunc mutateFunc	= me->params.function.uniformFunc;
-		 do {
-			double	curSource = *iSource++,
-					curTarget = *iTarget++, 
-					curMutant;
-			curMutant = emphFunc(
-							prevMutant,
-							mutateFunc(curSource - prevSource, curTarget - prevTarget, iOmega),
-							effectDelta);
-			
-			prevSource = curSource;
-			prevTarget = curTarget;
-			*oMutant++ = prevMutant = curMutant;
-			} while (--iVectorSize > 0);
+	double	srcInt[kMutateBlock],
+			tgtInt[kMutateBlock];
+	long	done,
+			i;
+	
+	for (done = 0; done < iVectorSize; done += kMutateBlock) {
+		long count = iVectorSize - done;
+		if (count > kMutateBlock) count = kMutateBlock;
+		
+		CalcIntervals(count, iSource + done, prevSource, srcInt);
+		if (omega != 0.0) {
+			CalcIntervals(count, iTarget + done, prevTarget, tgtInt);
+			for (i = 0; i < count; i += 1)
+				srcInt[i] = MutateUniform(iType, srcInt[i], tgtInt[i], omega);
+			}
+		
+		prevSource = iSource[done + count - 1];
+		prevTarget = iTarget[done + count - 1];
+		
+		for (i = 0; i < count; i += 1)
+			oMutant[done + i] = prevMutant = prevCoeff * prevMutant + intCoeff * srcInt[i];
 		}
 	
 	me->history.source	= prevSource;
 	me->history.target	= prevTarget;
 	me->history.mutant	= prevMutant;
 	}
-		
-void
+
+static inline void
 CalcRelUniformSR(
-	tMutator*	me,
-	long		iVectorSize,
-	t_sample*	iSource,
-	t_sample*	iTarget,
-	t_sample*	oMutant,
-	t_sample*	iOmega,
-	t_sample*	iDelta)
+	tMutator*		me,
+	long			iVectorSize,
+	const double*	iSource,
+	const double*	iTarget,
+	double*			oMutant,
+	const double*	iOmega,
+	const double*	iPi,
+	const double*	iDelta,
+	int				iType)
 	
 	{
+	#pragma unused(iPi)
+	
 	double	prevSource	= me->history.source,
 			prevTarget	= me->history.target,
 			prevMutant	= me->history.mutant;
-	tMutateFunc
-			mutateFunc	= me->params.function.uniformFunc;
-	
-	do {
-		double	curSource	= *iSource++,
-				curTarget	= *iTarget++,
-				omega		= iOmega ? *iOmega++ : me->params.omega,
-				delta		= iDelta ? *iDelta++ : me->params.delta,
-				mutantInt,
-				curMutant;
-		
-		mutantInt = mutateFunc(curSource - prevSource, curTarget - prevTarget, omega);
-		curMutant = (delta >= 0) 	// NB: I treat delta == 0.0 as positive here... this
-									// is OK, (cf. comments to the Emphasize...() functions)
-									// and special-casing this inside our calculation loop
-									// would not buy us anything in terms of performance.
-						? EmphasizePos(prevMutant, mutantInt, 1.0 - delta)
-						: EmphasizeNeg(prevMutant, mutantInt, 1.0 + delta);
-		
-		prevSource = curSource;
-		prevTarget = curTarget;
-		*oMutant++ = prevMutant = curMutant;
-		} while (--iVectorSize > 0);
+	double	srcInt[kMutateBlock],
+			tgtInt[kMutateBlock],
+			prevCoeff[kMutateBlock],
+			intCoeff[kMutateBlock],
+			omegaBuf[kMutateBlock],
+			deltaBuf[kMutateBlock];
+	long	done,
+			i;
+	
+	for (done = 0; done < iVectorSize; done += kMutateBlock) {
+		long			count = iVectorSize - done;
+		const double	*omega, *delta;
+		
+		if (count > kMutateBlock) count = kMutateBlock;
+		
+		omega	= ParamBlock(iOmega ? iOmega + done : NIL, me->params.omega, omegaBuf, count);
+		delta	= ParamBlock(iDelta ? iDelta + done : NIL, me->params.delta, deltaBuf, count);
+		
+		CalcIntervals(count, iSource + done, prevSource, srcInt);
+		CalcIntervals(count, iTarget + done, prevTarget, tgtInt);
+		for (i = 0; i < count; i += 1) {
+			srcInt[i]		= MutateUniform(iType, srcInt[i], tgtInt[i], omega[i]);
+			prevCoeff[i]	= EmphPrevCoeff(delta[i]);
+			intCoeff[i]		= EmphIntCoeff(delta[i]);
+			}
+		
+		prevSource = iSource[done + count - 1];
+		prevTarget = iTarget[done + count - 1];
+		
+		for (i = 0; i < count; i += 1)
+			oMutant[done + i] = prevMutant = prevCoeff[i] * prevMutant + intCoeff[i] * srcInt[i];
+		}
+	
+	me->history.source	= prevSource;
+	me->history.target	= prevTarget;
+	me->history.mutant	= prevMutant;
+	}
+
+static inline void
+CalcRelIrregCR(
+	tMutator*		me,
+	long			iVectorSize,
+	const double*	iSource,
+	const double*	iTarget,
+	double*			oMutant,
+	const double*	iOmega,
+	const double*	iPi,
+	const double*	iDelta,
+	int				iType)
+	
+	{
+	double			omega		= iOmega ? iOmega[0] : me->params.omega,
+					pi			= iPi ? iPi[0] : me->params.pi,
+					delta		= iDelta ? iDelta[0] : me->params.delta,
+					prevCoeff	= EmphPrevCoeff(delta),
+					intCoeff	= EmphIntCoeff(delta),
+					prevSource	= me->history.source,
+					prevTarget	= me->history.target,
+					prevMutant	= me->history.mutant;
+	double			srcInt[kMutateBlock],
+					tgtInt[kMutateBlock];
+	UInt32			rand[kMutateBlock];
+	Byte			mutate[kMutateBlock],
+					state		= stateIndeterminate;
+	unsigned long	srcToMut	= 0,
+					mutToMut	= 0,
+					initThresh	= 0;
+	long			wishMutants	= ((float) iVectorSize) * omega + 0.5,
+					done,
+					i;
+	
+	if (0.0 < omega && omega < 1.0)
+		initThresh = CalcMutantThreshholds(omega, pi, &srcToMut, &mutToMut);
+	
+	for (done = 0; done < iVectorSize; done += kMutateBlock) {
+		long count = iVectorSize - done;
+		if (count > kMutateBlock) count = kMutateBlock;
+		
+		CalcIntervals(count, iSource + done, prevSource, srcInt);
+		
+		if (omega == 1.0) {
+			CalcIntervals(count, iTarget + done, prevTarget, tgtInt);
+			for (i = 0; i < count; i += 1)
+				srcInt[i] = MutateIrregular(iType, srcInt[i], tgtInt[i]);
+			}
+		else if (omega != 0.0) {
+			CalcIntervals(count, iTarget + done, prevTarget, tgtInt);
+			FillRandom(rand, count);
+			DecideTight(count, iVectorSize - done, rand, srcToMut, mutToMut, initThresh,
+						&state, &wishMutants, mutate);
+			for (i = 0; i < count; i += 1)
+				srcInt[i] = mutate[i] ? MutateIrregular(iType, srcInt[i], tgtInt[i]) : srcInt[i];
+			}
+		
+		prevSource = iSource[done + count - 1];
+		prevTarget = iTarget[done + count - 1];
+		
+		for (i = 0; i < count; i += 1)
+			oMutant[done + i] = prevMutant = prevCoeff * prevMutant + intCoeff * srcInt[i];
+		}
 	
 	me->history.source	= prevSource;
 	me->history.target	= prevTarget;
 	me->history.mutant	= prevMutant;
 	}
+
+static inline void
+CalcRelIrregSR(
+	tMutator*		me,
+	long			iVectorSize,
+	const double*	iSource,
+	const double*	iTarget,
+	double*			oMutant,
+	const double*	iOmega,
+	const double*	iPi,
+	const double*	iDelta,
+	int				iType)
+	
+	{
+	double			prevSource	= me->history.source,
+					prevTarget	= me->history.target,
+					prevMutant	= me->history.mutant;
+	double			srcInt[kMutateBlock],
+					tgtInt[kMutateBlock],
+					prevCoeff[kMutateBlock],
+					intCoeff[kMutateBlock],
+					omegaBuf[kMutateBlock],
+					piBuf[kMutateBlock],
+					deltaBuf[kMutateBlock];
+	UInt32			rand[kMutateBlock];
+	unsigned long	srcToMut[kMutateBlock],
+					mutToMut[kMutateBlock];
+	Byte			mutate[kMutateBlock],
+					state		= stateIndeterminate;
+	long			done,
+					i;
+	
+	for (done = 0; done < iVectorSize; done += kMutateBlock) {
+		long			count = iVectorSize - done;
+		const double	*omega, *pi, *delta;
+		
+		if (count > kMutateBlock) count = kMutateBlock;
+		
+		omega	= ParamBlock(iOmega ? iOmega + done : NIL, me->params.omega, omegaBuf, count);
+		pi		= ParamBlock(iPi ? iPi + done : NIL, me->params.pi, piBuf, count);
+		delta	= ParamBlock(iDelta ? iDelta + done : NIL, me->params.delta, deltaBuf, count);
 		
+		CalcStrictThresholds(count, omega, pi, srcToMut, mutToMut);
+		FillRandom(rand, count);
+		DecideStrict(count, rand, srcToMut, mutToMut, CalcInitThresh(omega[0]), &state, mutate);
+		
+		CalcIntervals(count, iSource + done, prevSource, srcInt);
+		CalcIntervals(count, iTarget + done, prevTarget, tgtInt);
+		for (i = 0; i < count; i += 1) {
+			srcInt[i]		= mutate[i] ? MutateIrregular(iType, srcInt[i], tgtInt[i]) : srcInt[i];
+			prevCoeff[i]	= EmphPrevCoeff(delta[i]);
+			intCoeff[i]		= EmphIntCoeff(delta[i]);
+			}
+		
+		prevSource = iSource[done + count - 1];
+		prevTarget = iTarget[done + count - 1];
+		
+		for (i = 0; i < count; i += 1)
+			oMutant[done + i] = prevMutant = prevCoeff[i] * prevMutant + intCoeff[i] * srcInt[i];
+		}
+	
+	me->history.source	= prevSource;
+	me->history.target	= prevTarget;
+	me->history.mutant	= prevMutant;
+	}
+
+
+/******************************************************************************************
+ *
+ *	Kernel instances
+ *
+ *	One kernel for each combination of mutation type, absolute/relative intervals, and
+ *	control/sample rate parameters. SelectKernel() picks from kKernels[] whenever the
+ *	DSP chain is built or any of the settings change, so the perform methods only make
+ *	one indirect call per vector.
+ *
+ ******************************************************************************************/
+
+#define DefineKernel(calc, type)																\
+	static void calc##_##type(																	\
+					tMutator* me, long iVectorSize,												\
+					const double* iSource, const double* iTarget, double* oMutant,				\
+					const double* iOmega, const double* iPi, const double* iDelta)				\
+		{ calc(me, iVectorSize, iSource, iTarget, oMutant, iOmega, iPi, iDelta, type); }
+
+DefineKernel(CalcAbsUniformCR, imUSIM)
+DefineKernel(CalcAbsUniformSR, imUSIM)
+DefineKernel(CalcRelUniformCR, imUSIM)
+DefineKernel(CalcRelUniformSR, imUSIM)
+DefineKernel(CalcAbsUniformCR, imUUIM)
+DefineKernel(CalcAbsUniformSR, imUUIM)
+DefineKernel(CalcRelUniformCR, imUUIM)
+DefineKernel(CalcRelUniformSR, imUUIM)
+DefineKernel(CalcAbsUniformCR, imWCM)
+DefineKernel(CalcAbsUniformSR, imWCM)
+DefineKernel(CalcRelUniformCR, imWCM)
+DefineKernel(CalcRelUniformSR, imWCM)
+
+DefineKernel(CalcAbsIrregCR, imISIM)
+DefineKernel(CalcAbsIrregSR, imISIM)
+DefineKernel(CalcRelIrregCR, imISIM)
+DefineKernel(CalcRelIrregSR, imISIM)
+DefineKernel(CalcAbsIrregCR, imIUIM)
+DefineKernel(CalcAbsIrregSR, imIUIM)
+DefineKernel(CalcRelIrregCR, imIUIM)
+DefineKernel(CalcRelIrregSR, imIUIM)
+DefineKernel(CalcAbsIrregCR, imLCM)
+DefineKernel(CalcAbsIrregSR, imLCM)
+DefineKernel(CalcRelIrregCR, imLCM)
+DefineKernel(CalcRelIrregSR, imLCM)
+
+#undef DefineKernel
+
+	// Indexed by mutation type, then [relInterval][sample rate]
+static const tMutateKernel kKernels[imLast + 1][2][2] = {
+	{ {CalcAbsUniformCR_imUSIM, CalcAbsUniformSR_imUSIM},
+	  {CalcRelUniformCR_imUSIM, CalcRelUniformSR_imUSIM} },
+	{ {CalcAbsIrregCR_imISIM, CalcAbsIrregSR_imISIM},
+	  {CalcRelIrregCR_imISIM, CalcRelIrregSR_imISIM} },
+	{ {CalcAbsUniformCR_imUUIM, CalcAbsUniformSR_imUUIM},
+	  {CalcRelUniformCR_imUUIM, CalcRelUniformSR_imUUIM} },
+	{ {CalcAbsIrregCR_imIUIM, CalcAbsIrregSR_imIUIM},
+	  {CalcRelIrregCR_imIUIM, CalcRelIrregSR_imIUIM} },
+	{ {CalcAbsUniformCR_imWCM, CalcAbsUniformSR_imWCM},
+	  {CalcRelUniformCR_imWCM, CalcRelUniformSR_imWCM} },
+	{ {CalcAbsIrregCR_imLCM, CalcAbsIrregSR_imLCM},
+	  {CalcRelIrregCR_imLCM, CalcRelIrregSR_imLCM} }
+	};
+
+
+/******************************************************************************************
+ *
+ *	SelectKernel(me)
+ *
+ *	Called from BuildDSPChain() and BuildDSPChain64(), and from imLib.c whenever the
+ *	mutation type, interval mode, or control/sample rate settings change.
+ *
+ *	A parameter is only treated at sample rate if its signal is connected, its sample rate
+ *	flag is set, and the mutation actually uses it (Pi only matters to irregular mutations,
+ *	Delta only to relative intervals).
+ *
+ ******************************************************************************************/
+
+void
+SelectKernel(
+	tMutator* me)
+	
+	{
+	long	conn		= me->sigConn;
+	Boolean	sampleRate	= ((conn & connOmega) && me->params.omegaSR)
+						|| ((conn & connPi) && me->params.piSR && me->params.irregular)
+						|| ((conn & connDelta) && me->params.deltaSR && me->params.relInterval);
+	
+	me->kernel = kKernels[CalcMutationIndex(me)][me->params.relInterval][sampleRate];
+	}
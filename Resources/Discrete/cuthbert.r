@@ -1,7 +1,7 @@
 /*
 	File:		cuthbert.r
 
-	Contains:	Resources for ernie
+	Contains:	Resources for cuthbert
 
 	Written by:	Peter Castine
 
@@ -9,6 +9,10 @@
 
 	Change History (most recent first):
 
+         <1>  18102026    pc      Bump build: constant-time draw, new draw message. Arguments
+                                    are value count, seed, memory length. refer, set, clear,
+                                    zero, const and count now only decide which values can be
+                                    drawn (nonzero count); all of those are equally likely.
 */
 
 
@@ -28,9 +32,9 @@
 #define LPobjMinorRev		0							// 1-9	(decimal)
 #define LPobjBugFix			0							// 0-9	(decimal)
 #define LPobjStage			developStage				// Apple standard stage #defines
-#define LPobjStageBuild		2							// 1-255 (0 for Golden Master only)
+#define LPobjStageBuild		3							// 1-255 (0 for Golden Master only)
 #define LPobjRegion			0							// US
-#define LPobjVersStr		"1.0.d2"
+#define LPobjVersStr		"1.0.d3"
 #define LPobjCRYears		"2008"
 
 #define	LPobjLitterCategory	"Litter RNGs"				// Litter category
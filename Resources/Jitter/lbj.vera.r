@@ -0,0 +1 @@
+/*	File:		lbj.vera.r	Contains:	Resources for Max/Jitter external object lbj.vera	Written by:	Peter Castine	Copyright:	Copyright  2026 Peter Castine. All rights reserved.	Change History (most recent first):*//****************************************************************************************** ******************************************************************************************/	//	// Configuration values for this object	//	// These must be unique within Litter Package. The Names must match constant values used	// in the C/C++ source code (we try never to access resources by ID).#define LPobjID			17595#define LPobjName		"lbj.vera"	// 'vers' stuff we need to maintain manually#define LPobjLBJ			1#define LPobjMajorRev		0							// 1-99 (decimal)#define LPobjMinorRev		0							// 1-9	(decimal)#define LPobjBugFix			0							// 1-9	(decimal)#define LPobjStage			finalStage					// Apple standard stage #defines#define LPobjStageBuild		1							// 1-255 (0 for Golden Master only)#define LPobjRegion			0							// US#define LPobjVersStr		"1.0fc1"#define LPobjCRYears		"2026"#define	LPobjLitterCategory	"Litter Bundle Jitter"		// Litter Category#define LPobjMax3Category	""							// Category for Max 2.2 - 3.6x#define LPobjMax4Category	"Jitter Generators"			// Category starting at Max 4	// Description string (for Windows Properties box, taken from documentation)#define LPobjDescription	"Render bifurcation diagrams of the Verhulst growth models"	// The following sets up the 'mAxL' and 'vers' resources on Mac OS	// and VERSIONINFO resource on Windows	// It relies on the values above for resource IDs and names, as	// well as concrete values for the 'vers'/VERSIONINFO resources.#include "Litter Globals.r"	//	// -----------------------------------------	//	// Other Resource definitions 	//		// Assistance strings	#define LPAssistIn1			"Bang, other messages"#define LPAssistOut1		"Orbit density matrix"#define LPAssistOut2		"Dump"#ifdef RC_INVOKED					// Must be Windows RC Compiler	STRINGTABLE DISCARDABLE		BEGIN		lpStrIndexLastStandard + 1,		LPAssistIn1		lpStrIndexLastStandard + 2,		LPAssistOut1		lpStrIndexLastStandard + 3,		LPAssistOut2		END#else								// Must be Mac OS Resource Compiler	resource 'STR#' (LPobjID, LPobjName) {		{	/* array StringArray */			LPStdStrings,								// Standard Litter Strings						// Assist strings			LPAssistIn1,								// Inlets			LPAssistOut1, LPAssistOut2					// Outlets		}	};#endif		
\ No newline at end of file
@@ -0,0 +1 @@
+/*	File:		hubbub~.r	Contains:	Resources for Max/MSP external object hubbub~.	Written by:	Peter Castine	Copyright:	  2026 Peter Castine. All rights reserved.	Change History (most recent first):*/	//	// Configuration values for this object	//	// These must be unique within Litter Package. The Names must match constant values used	// in the C/C++ source code (we try never to access resources by ID).#define LPobjID			17594#define LPobjName		"lp.hubbub~"	// -----------------------------------------	// 'vers' stuff we need to maintain manually//#define LPobjStarter		1							// Comment out for Pro Bundles#define LPobjMajorRev		1							// 1-99	(decimal)#define LPobjMinorRev		0							// 0-9	(decimal)#define LPobjBugFix			0							// 0-9	(decimal)#define LPobjStage			betaStage					// Standard Apple stage#define LPobjStageBuild		1							// 1-255 (0 for Golden Master only)#define LPobjRegion			0							// US#define LPobjVersStr		"1.0b1"#define LPobjCRYears		"2026"#define	LPobjLitterCategory	"Litter Signals"			// Litter Category#define LPobjMax3Category	"MSP"						// Category for Max 2.2 - 3.6x#define LPobjMax4Category	"MSP Synthesis"				// Category starting at Max 4	// Description string (for Windows Properties box, taken from documentation)#define LPobjDescription	"Multichannel noise bank"	// The following sets up the 'mAxL' and 'vers' resources	// It relies on the values above for resource IDs and names, as	// well as concrete values for the 'vers'(1) resource.#include "Litter Globals.r"	//	// -----------------------------------------	//	// Other resource definitions 	//	// Assistance strings#define LPAssistIn1			"Int/Float (NN factor, all channels)"#define LPAssistOut1		"Signal (Noise channel %ld)"#ifdef RC_INVOKED					// Must be Windows RC Compiler	STRINGTABLE DISCARDABLE		BEGIN		lpStrIndexLastStandard + 1,		LPAssistIn1		lpStrIndexLastStandard + 2,		LPAssistOut1		END#else								// Must be Mac OS Resource Compiler	resource 'STR#' (LPobjID, LPobjName) {		{	/* array StringArray */			LPStdStrings,						// Standard Litter Strings						// Assist strings			LPAssistIn1,						// Inlets			LPAssistOut1						// Outlets		}	};#endif
\ No newline at end of file
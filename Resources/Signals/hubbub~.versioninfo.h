@@ -0,0 +1,23 @@
+// This file is automatically generated
+// There is no point in editing manually--edit the .r file instead
+
+#define LPobjID			17594
+#define LPobjName		lp.hubbub~
+//#define LPobjStarter		1							// Comment out for Pro Bundles
+#define LPobjMajorRev		1							// 1-99	(decimal)
+#define LPobjMinorRev		0							// 0-9	(decimal)
+#define LPobjBugFix			0							// 0-9	(decimal)
+#define LPobjStage			betaStage					// Standard Apple stage
+#define LPobjStageBuild		1							// 1-255 (0 for Golden Master only)
+#define LPobjRegion			0							// US
+#define LPobjVersStr		1.0b1
+#define LPobjCRYears		2026
+#define LPobjMax3Category	MSP						// Category for Max 2.2 - 3.6x
+#define LPobjMax4Category	MSP Synthesis				// Category starting at Max 4
+#define LPobjDescription	Multichannel noise bank
+
+#ifdef LPobjStarter
+	#define LPobjBundle All Bundles
+#else
+	#define LPobjBundle Pro Bundle
+#endif
@@ -83,6 +83,9 @@ static void	FetaInfo(tOneBit*);
 static void	FetaDSP(tOneBit*, t_signal**, short*);
 static int*	FetaPerformSimp(int*);
 static int*	FetaPerformMod(int*);
+static void	FetaDSP64(tOneBit*, t_object*, short*, double, long, long);
+static void	FetaPerformSimp64(tOneBit*, t_object*, double**, long, double**, long, long, long, void*);
+static void	FetaPerformMod64(tOneBit*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -130,6 +133,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess((method) FetaDSP, "dsp", A_CANT, 0);
+	LITTER_TIMEBOMB addmess((method) FetaDSP64, "dsp64", A_CANT, 0);
 
 	//Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -308,10 +312,7 @@ FetaPerformMod(
 		paramNextLink
 		};
 		
-	const int kRandBitCount = 32;
-	
-	long			vecCounter,
-					randBits;
+	long			vecCounter;
 	tSampleVector	inAmp,
 					outNoise;
 	tOneBit*		me = (tOneBit*) iParams[paramMe];
@@ -324,29 +325,7 @@ FetaPerformMod(
 	outNoise	= (tSampleVector) iParams[paramOut];
 	
 	// Do our stuff
-	// We rely on vecCounter being a power of 2, which means that either
-	// a single 32-bit random value will sort us out or we will use some
-	// exact integral multiple of 32-bits
-	if (vecCounter < kRandBitCount) {
-		randBits = Taus88(NIL);
-		
-		do {
-			*outNoise++ = (randBits < 0) ? -(*inAmp++) : *inAmp++;
-			randBits <<= 1;
-			} while (vecCounter-- > 0);
-		}
-	
-	else while (vecCounter > 0) {
-		int i = kRandBitCount;
-		
-		randBits = Taus88(NIL);
-		do {
-			*outNoise++ = (randBits < 0) ? -(*inAmp++) : *inAmp++;
-			randBits <<= 1;
-			} while (--i > 0);
-		
-		vecCounter -= kRandBitCount;
-		}
+	Taus88BitFlipVector(inAmp, outNoise, vecCounter);
 	
 exit:
 	return iParams + paramNextLink;
@@ -367,11 +346,8 @@ FetaPerformSimp(
 		paramNextLink
 		};
 		
-	const int kRandBitCount = 32;
-	
-	long			vecCounter,
-					randBits;
-	float			amp, negAmp;
+	long			vecCounter;
+	float			amp;
 	tSampleVector	outNoise;
 	tOneBit*		me = (tOneBit*) iParams[paramMe];
 	
@@ -381,33 +357,79 @@ FetaPerformSimp(
 	vecCounter	= (long) iParams[paramVectorSize];
 	outNoise	= (tSampleVector) iParams[paramOut];
 	amp			= me->amp;
-	negAmp		= -amp;
 	
 	// Do our stuff
-	// We rely on vecCounter being a power of 2, which means that either
-	// a single 32-bit random value will sort us out or we will use some
-	// exact integral multiple of 32-bits
-	if (vecCounter < kRandBitCount) {
-		randBits = Taus88(NIL);
-		
-		do {
-			*outNoise++ = (randBits < 0) ? negAmp : amp;
-			randBits <<= 1;
-			} while (vecCounter-- > 0);
-		}
-	
-	else while (vecCounter > 0) {
-		int i = kRandBitCount;
-		
-		randBits = Taus88(NIL);
-		do {
-			*outNoise++ = (randBits < 0) ? negAmp : amp;
-			randBits <<= 1;
-			} while (--i > 0);
-		
-		vecCounter -= kRandBitCount;
-		}
+	Taus88BitSigVector(outNoise, vecCounter, amp);
 	
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	FetaDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	FetaPerformMod64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *	FetaPerformSimp64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. As with the 32-bit methods, a signal connected to the inlet
+ *	gets its sign flipped at random; otherwise we generate ±amp.
+ *
+ ******************************************************************************************/
+
+void
+FetaDSP64(
+	tOneBit*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iSampleRate, iMaxVectorSize, iFlags)
+	
+	dsp_add64(	iDSP64, (t_object*) me,
+				(t_perfroutine64) ((iConnectCounts[0] > 0) ? FetaPerformMod64 : FetaPerformSimp64),
+				0, NIL);
+	}
+
+void
+FetaPerformMod64(
+	tOneBit*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iInCount, iOutCount, iFlags, iUser)
+	
+	if (me->coreObject.z_disabled) return;
+	
+	Taus88BitFlipVector64(iIns[0], iOuts[0], iVectorSize);
+	}
+
+void
+FetaPerformSimp64(
+	tOneBit*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iIns, iInCount, iOutCount, iFlags, iUser)
+	
+	if (me->coreObject.z_disabled) return;
+	
+	Taus88BitSigVector64(iOuts[0], iVectorSize, me->amp);
+	}
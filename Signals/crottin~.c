@@ -60,6 +60,13 @@ enum {
 	
 	outletNoise
 	};
+
+	// Flags for signal inlets with a connection, used by the 64-bit perform method
+enum {
+	connFreq		= 0x01,
+	connAmpRate		= 0x02,
+	connWidthRate	= 0x04
+	};
 	
 	
 #pragma mark • Type Definitions
@@ -128,6 +135,8 @@ static void	CrottinInfo(objCrottin*);
 	// MSP Messages
 static void	CrottinDSP(objCrottin*, t_signal**, short*);
 static int*	CrottinPerform(int*);
+static void	CrottinDSP64(objCrottin*, t_object*, short*, double, long, long);
+static void	CrottinPerform64(objCrottin*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -176,6 +185,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) CrottinDSP,		"dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) CrottinDSP64,		"dsp64",		A_CANT, 0);
 
 	//Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -887,3 +897,141 @@ CrottinPerform(
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	CrottinDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	CrottinPerform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. MSP 6 hands us a vector for every inlet, connected or not,
+ *	so the DSP method passes the connected inlets to the perform method as flags in the
+ *	user parameter.
+ *
+ ******************************************************************************************/
+
+void
+CrottinDSP64(
+	objCrottin*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iMaxVectorSize, iFlags)
+	
+	long conn = 0;
+	
+	if (me->sr != iSampleRate)
+		SetSR(me, iSampleRate);
+	
+	if (iConnectCounts[inletFreq] > 0)		conn |= connFreq;
+	if (iConnectCounts[inletAmpRate] > 0)	conn |= connAmpRate;
+	if (iConnectCounts[inletWidthRate] > 0)	conn |= connWidthRate;
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) CrottinPerform64, 0, (void*) conn);
+	}
+
+void
+CrottinPerform64(
+	objCrottin*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iInCount, iOutCount, iFlags)
+	
+	long			conn = (long) iUser,
+					i,
+					segCount,
+					seg,
+					sampsLeft;
+	double			x,
+					cumErr;
+	tSegmentPtr		sp;
+	tSampleVector64	out;
+	
+	if (me->coreObject.z_disabled) return;
+	
+	if (me->bang) {
+		RollOverGoals(me);
+		me->bang = false;
+		}
+	
+	// Copy parameters into registers
+	i			= iVectorSize;
+	out			= iOuts[0];
+	segCount	= me->segCount;
+	seg			= me->curSeg;
+	sp			= me->segments;
+	sampsLeft	= me->sampsLeft;
+	cumErr		= me->cumSampErr;
+	
+	// Need to update parameters?
+	if (conn & connFreq) {
+		x = iIns[inletFreq][0];
+		if (x != me->freq) SetFreq(me, x);
+		}
+	if (conn & connAmpRate) {
+		x = iIns[inletAmpRate][0];
+		if (x != me->ampRate) SetAmpRate(me, x);
+		}
+	if (conn & connWidthRate) {
+		x = iIns[inletWidthRate][0];
+		if (x != me->freq) SetWidthRate(me, x);
+		}
+	
+	// Same segment logic as CrottinPerform()
+	while (i > 0) {
+		double	amp = sp[seg].curAmp;
+		long	j	= sampsLeft;
+		
+		if (cumErr >= 0.5) {
+			j += 1;
+			cumErr -= 1.0;
+			}
+		
+		if (j > i) {
+			j = i;
+			sampsLeft -= j;
+			}
+		else {
+			cumErr += fmod(sp[seg].curWidth, 1.0);
+			
+			if (me->interpAmp)
+				sp[seg].curAmp += sp[seg].deltaAmp;
+			if (me->interpWidth)
+				sp[seg].curWidth += sp[seg].deltaWidth;
+			
+			seg += 1;
+			
+			if (seg >= segCount) {
+				if (me->interpAmp && --me->ampCtr <= 0)
+					RollOverAmpGoals(me);
+				if (me->interpWidth && --me->widthCtr <= 0)
+					RollOverWidthGoals(me);
+					
+				seg = 0;
+				}
+			
+			sampsLeft = sp[seg].curWidth;
+			}
+		
+		i -= j;
+		
+		while (j-- > 0)
+			*out++ = amp;
+		}
+	
+	me->curSeg		= seg;
+	me->sampsLeft	= sampsLeft;
+	me->cumSampErr	= cumErr;
+	}
@@ -114,6 +114,8 @@ static void	EpoisseInfo(objEpoisse*);
 	// MSP Messages
 static void	EpoisseDSP(objEpoisse*, t_signal**, short*);
 static int*	EpoissePerform(int*);
+static void	EpoisseDSP64(objEpoisse*, t_object*, short*, double, long, long);
+static void	EpoissePerform64(objEpoisse*, t_object*, double**, long, double**, long, long, long, void*);
 #endif
 
 #pragma mark -
@@ -483,6 +485,97 @@ EpoisseDSP(
 	}
 	
 
+/*****************************************************************************************
+ *
+ *	EpoissePerform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *	EpoisseDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *
+ *	Max 6 64-bit versions of the above. The wave table stays in single precision; only
+ *	the interpolated output is written as double.
+ *
+ *****************************************************************************************/
+	
+void
+EpoissePerform64(
+	objEpoisse*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iIns, iInCount, iOutCount, iFlags, iUser)
+	
+	long			n			= iVectorSize;
+	tSampleVector64	out			= iOuts[0];
+	double			phiFrac		= me->phiFrac,
+					cumPhiErr	= me->cumPhiErr;
+	long			phiStep		= me->phiStep,
+					curPhi		= me->curPhi,
+					countDown	= me->countDown,
+					interpSamp	= me->interpSamp;
+	tSampleVector	cur			= me->cur,
+					interp		= me->interp;
+	Boolean			stochInterp	= me->flags & flagStochastic;
+	
+	if (me->coreObject.z_disabled) return;
+	
+	while (n-- > 0) {
+		*out++ = (1.0 - cumPhiErr) * cur[curPhi] + cumPhiErr * cur[curPhi + 1];
+		
+		curPhi		+= phiStep;
+		cumPhiErr	+= phiFrac;
+		if (cumPhiErr >= 1.0) {
+			cumPhiErr	-= 1.0;
+			curPhi		+= 1;
+			}
+		if (curPhi >= kMaxBuf)
+			curPhi -= kMaxBuf;
+		
+		if (countDown-- <= 0) {
+			GenBuf(me);
+			countDown = kMaxBuf * me->pi + 0.5;
+			}
+		else {
+			cur[interpSamp] += stochInterp
+								? interp[interpSamp] * (ULong2Signal(Taus88(NIL)) + 1.0)
+								: interp[interpSamp];
+			interpSamp += 1;
+			interpSamp &= kMaxBufMask;			
+			}
+		}
+		
+	me->cumPhiErr	= cumPhiErr;
+	me->curPhi		= curPhi;
+	me->countDown	= countDown;
+	me->interpSamp	= interpSamp;
+	}
+	
+void
+EpoisseDSP64(
+	objEpoisse*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iConnectCounts, iMaxVectorSize, iFlags)
+	
+	if (me->sRate != iSampleRate) {
+		me->sRate	= iSampleRate;
+		EpoisseFreq(me, me->freq);
+		}
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) EpoissePerform64, 0, NIL);
+	}
+	
+
 #pragma mark -
 #pragma mark • Class Message Handlers
 
@@ -583,6 +676,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) EpoisseDSP,	"dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) EpoisseDSP64,	"dsp64",		A_CANT, 0);
 
 	//Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -113,6 +113,8 @@ static void	FrrrInfo(objLoFreq*);
 	// MSP Messages
 static void	FrrrDSP(objLoFreq*, t_signal**, short*);
 static int*	FrrrPerform(int*);
+static void	FrrrDSP64(objLoFreq*, t_object*, short*, double, long, long);
+static void	FrrrPerform64(objLoFreq*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -181,6 +183,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) FrrrDSP,		"dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) FrrrDSP64,		"dsp64",		A_CANT, 0);
 
 	//Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -637,3 +640,178 @@ FrrrPerform(
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	FrrrDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	FrrrPerform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. The helpers mirror PerformNoInterp() & Co., but the random
+ *	goals keep their full 32-bit resolution.
+ *
+ ******************************************************************************************/
+
+void
+FrrrDSP64(
+	objLoFreq*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iConnectCounts, iMaxVectorSize, iFlags)
+	
+	me->curSR = iSampleRate;
+	UpdateBaseFreq(me);
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) FrrrPerform64, 0, NIL);
+	}
+
+	static void PerformNoInterp64(objLoFreq* me, long iVecSize, tSampleVector64 oNoise)
+		{
+		double			curVal			= me->curVal,
+						goal			= me->goal;
+		unsigned long	baseFreqSamps	= me->baseFreqSamps,
+						sampsToGo		= me->sampsToGo;
+		
+		do {
+			unsigned long sampsThisTime;
+			
+			if (sampsToGo == 0) {
+				curVal		= goal;
+				goal		= Long2Signal64((SInt32) Taus88(NULL));
+				sampsToGo	= baseFreqSamps;
+				}
+			
+			sampsThisTime = sampsToGo;
+			if (sampsThisTime > iVecSize)
+				sampsThisTime = iVecSize;
+			
+			iVecSize -= sampsThisTime;
+			sampsToGo -= sampsThisTime;
+			
+			do { *oNoise++ = curVal; } while (--sampsThisTime > 0);
+				
+			} while (iVecSize > 0);
+		
+		me->curVal		= curVal;
+		me->goal		= goal;
+		me->sampsToGo	= sampsToGo;				// This always needs updating
+		
+		}
+	
+	static void PerformLinear64(objLoFreq* me, long iVecSize, tSampleVector64 oNoise)
+		{
+		double			curVal			= me->curVal,
+						goal			= me->goal,
+						slope			= me->slope;
+		unsigned long	baseFreqSamps	= me->baseFreqSamps,
+						sampsToGo		= me->sampsToGo;
+		
+		do {
+			unsigned long sampsThisTime;
+			
+			if (sampsToGo == 0) {
+				goal		= Long2Signal64((SInt32) Taus88(NULL));
+				sampsToGo	= baseFreqSamps;
+				slope		= (goal - curVal) / baseFreqSamps;
+				}
+			
+			sampsThisTime = sampsToGo;
+			if (sampsThisTime > iVecSize)
+				sampsThisTime = iVecSize;
+			
+			iVecSize -= sampsThisTime;
+			sampsToGo -= sampsThisTime;
+			
+			do { *oNoise++ = curVal += slope; } while (--sampsThisTime > 0);
+				
+			} while (iVecSize > 0);
+		
+		me->curVal		= curVal;
+		me->goal		= goal;
+		me->slope		= slope;
+		me->sampsToGo	= sampsToGo;				// This always needs updating
+		
+		}
+
+	static void PerformQuad64(objLoFreq* me, long iVecSize, tSampleVector64 oNoise)
+		{
+		double			curVal			= me->curVal,
+						goal			= me->goal,
+						slope			= me->slope,
+						curve			= me->curve;
+		unsigned long	baseFreqSamps	= me->baseFreqSamps,
+						sampsToGo		= me->sampsToGo;
+		
+		do {
+			unsigned long sampsThisTime;
+			
+			if (sampsToGo == 0) {
+				double	diff,
+						durInv,
+						durInv2;
+				goal		= Long2Signal64((SInt32) Taus88(NULL));
+				sampsToGo	= baseFreqSamps;
+				diff		= goal - curVal;
+				durInv		= 0.5 / sampsToGo;			// Take parabolic curve over twice
+				durInv2		= durInv * durInv;			// the distance between random samples
+				slope		= 4.0 * diff * (durInv - durInv2);
+				curve		= -8.0 * diff * durInv2;
+				}
+			
+			sampsThisTime = sampsToGo;
+			if (sampsThisTime > iVecSize)
+				sampsThisTime = iVecSize;
+			
+			iVecSize -= sampsThisTime;
+			sampsToGo -= sampsThisTime;
+			
+			do {
+				curVal	+= slope;
+				slope	+= curve;
+				*oNoise++ = curVal;
+				} while (--sampsThisTime > 0);
+				
+			} while (iVecSize > 0);
+		
+		me->curVal		= curVal;
+		me->goal		= goal;
+		me->slope		= slope;
+		me->curve		= curve;
+		me->sampsToGo	= sampsToGo;				// This always needs updating
+		
+		}
+
+void
+FrrrPerform64(
+	objLoFreq*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iIns, iInCount, iOutCount, iFlags, iUser)
+	
+	if (me->coreObject.z_disabled) return;
+	
+	switch (me->interp) {
+		case interpQuad:
+			PerformQuad64(me, iVectorSize, iOuts[0]);
+			break;
+		case interpLin:
+			PerformLinear64(me, iVectorSize, iOuts[0]);
+			break;
+		default:
+			PerformNoInterp64(me, iVectorSize, iOuts[0]);
+			break;
+		}
+	}
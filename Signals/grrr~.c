@@ -84,6 +84,8 @@ static void	GrrrInfo(tGray*);
 	// MSP Messages
 static void	GrrrDSP(tGray*, t_signal**, short*);
 static int*	GrrrPerform(int*);
+static void	GrrrDSP64(tGray*, t_object*, short*, double, long, long);
+static void	GrrrPerform64(tGray*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -127,6 +129,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) GrrrDSP, "dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) GrrrDSP64, "dsp64",		A_CANT, 0);
 
 	//Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -279,6 +282,66 @@ GrrrPerform(
 		*outNoise++ = ULong2Signal(prev);
 		} while (--vecCounter > 0);
 	
+	me->prev = prev;
+	
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	GrrrDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	GrrrPerform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain.
+ *
+ ******************************************************************************************/
+
+void
+GrrrDSP64(
+	tGray*		me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) GrrrPerform64, 0, NIL);
+	}
+
+void
+GrrrPerform64(
+	tGray*		me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iIns, iInCount, iOutCount, iFlags, iUser)
+	
+	UInt32			prev		= me->prev,
+					s1, s2, s3;
+	tSampleVector64	outNoise	= iOuts[0];
+	
+	if (me->coreObject.z_disabled) return;
+	
+	Taus88LoadGlobal(&s1, &s2, &s3);
+	
+	while (iVectorSize-- > 0) {
+		prev ^= Taus88Process(&s1, &s2, &s3);
+		*outNoise++ = ULong2Signal64(prev);
+		}
+	
+	Taus88StoreGlobal(s1, s2, s3);
+	
+	me->prev = prev;
+	}
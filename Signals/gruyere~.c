@@ -67,6 +67,12 @@ enum {
 	
 	outletNoise
 	};
+
+	// Flags for connected signal inlets (64-bit perform method)
+enum {
+	connFreq		= 0x01,
+	connEpsilon		= 0x02
+	};
 	
 	
 #pragma mark • Type Definitions
@@ -114,6 +120,8 @@ static void	GruyereInfo(objGruyere*);
 	// MSP Messages
 static void	GruyereDSP(objGruyere*, t_signal**, short*);
 static int*	GruyerePerform(int*);
+static void	GruyereDSP64(objGruyere*, t_object*, short*, double, long, long);
+static void	GruyerePerform64(objGruyere*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -178,6 +186,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) GruyereDSP,	"dsp",	A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) GruyereDSP64,	"dsp64",	A_CANT, 0);
 
 	//Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -690,3 +699,185 @@ GruyerePerform(
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	GruyereDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	GruyerePerform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. The user parameter carries flags for the signal inlets
+ *	that actually have a connection.
+ *
+ ******************************************************************************************/
+
+void
+GruyereDSP64(
+	objGruyere*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iMaxVectorSize, iFlags)
+	
+	long conn = 0;
+	
+	if (me->sr != iSampleRate)
+		SetSR(me, iSampleRate);
+	
+	if (me->bufSym != NIL)
+		GruyereSetBuf(me, me->bufSym, me->bufOffset);
+	
+	if (iConnectCounts[inletFreq] > 0)		conn |= connFreq;
+	if (iConnectCounts[inletEpsilon] > 0)	conn |= connEpsilon;
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) GruyerePerform64, 0, (void*) conn);
+	}
+
+void
+GruyerePerform64(
+	objGruyere*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iInCount, iOutCount, iFlags)
+	
+	long			conn = (long) iUser,
+					i,
+					tLen,
+					nChans;
+	unsigned long	rThresh;
+	double			x,
+					phi,
+					stepFactor;
+	tBufferPtr		buf;
+	tSampleVector	wTable;
+	tSampleVector64	out;
+	
+#if __BUFFER_HAS_INUSE_FLAG__
+	long			inuseState;
+#endif
+	
+	if (me->coreObject.z_disabled) goto exit;
+	
+	// Need to update control-rate parameters?
+	if (conn & connFreq) {
+		x = iIns[inletFreq][0];
+		if (x != me->freq) SetFreq(me, x);
+		}
+	if (conn & connEpsilon) {
+		x = iIns[inletEpsilon][0];
+		if (x != me->epsilon) SetEpsilon(me, x);
+		}
+	
+	// Copy other parameters and some object members into registers
+	i			= iVectorSize;
+	out			= iOuts[0];
+	stepFactor	= me->stepFactor;
+	buf			= me->buf;
+	rThresh		= me->randThresh;
+	phi			= me->phi;
+	
+	if (buf == NIL)  {
+		wTable	= gCosine;
+		tLen	= kTableLen;
+		nChans	= 1;
+		}
+	
+	else {
+		long offset;
+		
+		if (buf->b_valid && (offset = me->bufOffset) < buf->b_frames) {
+			wTable	= buf->b_samples + offset;
+			tLen	= buf->b_frames - offset;
+			
+			if (tLen > kTableLen)
+				tLen = kTableLen;
+			
+			nChans = buf->b_nchans;
+			
+		#if __BUFFER_HAS_INUSE_FLAG__
+			inuseState		= buf->b_inuse;
+			buf->b_inuse	= true;
+		#endif
+			}
+		
+		else {
+			while (i-- > 0) *out++ = 0.0;
+			goto exit;
+			}
+		}
+	
+	if (stepFactor > tLen) stepFactor = fmod(stepFactor, tLen);
+	
+	// Same as GruyerePerform() from here on
+	if (nChans == 1 && tLen == kTableLen) do {
+		unsigned long	rand = Taus88(NIL);
+		double			samp1, samp2, frac;
+		int				index;
+		
+		if (rand <= rThresh) {
+			phi += stepFactor;
+			if (phi >= (double) kTableLen) phi -= (double) kTableLen;
+			}
+		else {
+			phi += stepFactor * (rand & kTableLenMod);
+			if (phi >= tLen) phi = fmod(phi, (double) kTableLen);
+			}
+		
+		index	= phi;							// Truncate to int
+		frac	= phi - floor(phi);
+		
+		samp1 = wTable[index++];
+		samp2 = (index < kTableLen) ? wTable[index] : wTable[0];
+		
+		*out++ = (1.0 - frac) * samp1 + frac * samp2;
+		} while (--i > 0);
+	
+	else do {
+		unsigned long	rand = Taus88(NIL);
+		double			samp1, samp2, frac;
+		int				index;
+		
+		if (rand <= rThresh) {
+			phi += stepFactor;
+			if (phi >= (double) kTableLen) phi -= (double) kTableLen;
+			}
+		else {
+			phi += stepFactor * (rand % tLen);
+			if (phi >= tLen) phi = fmod(phi, (double) kTableLen);
+			}
+		
+		index	= phi;							// Truncate to int
+		frac	= phi - floor(phi);
+		
+		samp1 = (index < tLen) ? wTable[index * nChans] : 0.0;
+		index += 1;
+		samp2 = (index < kTableLen)
+					? ( (index < tLen) ? wTable[index * nChans] : 0.0 )
+					: wTable[0];
+		
+		*out++ = (1.0 - frac) * samp1 + frac * samp2;
+		} while (--i > 0);
+	
+	// Update object members
+	me->phi	= phi;
+
+#if __BUFFER_HAS_INUSE_FLAG__
+	if (wTable != gCosine)
+		buf->b_inuse = inuseState;
+#endif
+	
+exit:
+	return;
+	}
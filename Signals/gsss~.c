@@ -39,6 +39,10 @@ const char*	kClassName		= "lp.gsss~";			// Class name
 
 const int	kMaxNN			= 31;
 
+enum {
+	kChunkSize		= 256							// Deviates generated per block
+	};
+
 	// Indices for STR# resource
 enum {
 	strIndexInMu		= lpStrIndexLastStandard + 1,
@@ -57,6 +61,12 @@ enum {
 	outletNoise
 	};
 
+	// Flags for connected signal inlets (64-bit perform method)
+enum {
+	connMu			= 0x01,
+	connStdDev		= 0x02
+	};
+
 #pragma mark • Type Definitions
 
 
@@ -93,6 +103,9 @@ static void	GsssInfo(objGaussNoise*);
 static void	GsssDSP(objGaussNoise*, t_signal**, short*);
 static int*	GsssPerformStat(int*);
 static int*	GsssPerformDyn(int*);
+static void	GsssDSP64(objGaussNoise*, t_object*, short*, double, long, long);
+static void	GsssPerformStat64(objGaussNoise*, t_object*, double**, long, double**, long, long, long, void*);
+static void	GsssPerformDyn64(objGaussNoise*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -100,6 +113,69 @@ static int*	GsssPerformDyn(int*);
 
 #pragma mark • Inline Functions
 
+/******************************************************************************************
+ *
+ *	SigIsConstant(iSig, iCount)
+ *	SigIsConstant64(iSig, iCount)
+ *	GsssFillStat(iMu, iStdDev, iCount, oNoise)
+ *	
+ *	A signal connected to an inlet often just sits at one value (a sig~ or a line~ that
+ *	has reached its target). SigIsConstant() lets the perform routine recognize this and
+ *	fall back to the same scalar loop GsssPerformStat uses. A NIL vector (no signal
+ *	connected) also counts as constant.
+ *	
+ *	GsssFillStat() generates the normal deviates a block at a time and then scales them.
+ *	
+ ******************************************************************************************/
+
+static inline Boolean SigIsConstant(tSampleVector iSig, long iCount)
+	{
+	t_sample first;
+	
+	if (iSig == NIL) return true;
+	
+	first = *iSig++;
+	while (--iCount > 0) {
+		if (*iSig++ != first) return false;
+		}
+	
+	return true;
+	}
+
+static inline Boolean SigIsConstant64(tSampleVector64 iSig, long iCount)
+	{
+	double first;
+	
+	if (iSig == NIL) return true;
+	
+	first = *iSig++;
+	while (--iCount > 0) {
+		if (*iSig++ != first) return false;
+		}
+	
+	return true;
+	}
+
+static inline void GsssFillStat(double iMu, double iStdDev, long iCount, tSampleVector oNoise)
+	{
+	double	chunk[kChunkSize];
+	
+	while (iCount > 0) {
+		long	n = (iCount < kChunkSize) ? iCount : kChunkSize,
+				i;
+		
+		NormalKRTaus88Fill(NIL, chunk, n);
+		
+		if (iMu == 0.0 && iStdDev == 1.0)
+			 for (i = 0; i < n; i += 1) oNoise[i] = chunk[i];
+		else for (i = 0; i < n; i += 1) oNoise[i] = iStdDev * chunk[i] + iMu;
+		
+		oNoise	+= n;
+		iCount	-= n;
+		}
+	
+	}
+
 
 
 #pragma mark -
@@ -139,6 +215,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) GsssDSP, "dsp", A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) GsssDSP64, "dsp64", A_CANT, 0);
 
 	//Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -288,11 +365,8 @@ GsssDSP(
 	
 	{
 	
-	// Can a signal vector have an odd size?
-	// Not very likely. Since the creation of MSP (and presumably all of its forerunners),
-	// Vector size has always been a positive power of two. All FFT objects will rely on
-	// this, and David Zicarelli has indicated that an odd vector size is extremely unlikely.
-	// So, I won't bloat the code with a check here. But we may regret this some day.
+	// The perform methods make no assumptions about the vector size, not even that it is
+	// even (or non-zero).
 	
 	if (iConnectCounts[inletMu] == 0 && iConnectCounts[inletStdDev] == 0)
 			dsp_add(
@@ -318,7 +392,13 @@ GsssDSP(
  *	GsssPerformDyn(iParams)
  *
  *	GsssPerformStat is used when neither Gauss parameter has a signal connected.
- *	GsssPerformDyn is used if either parameters is controlled by a signal.
+ *	GsssPerformDyn is used if either parameters is controlled by a signal. If the
+ *	connected signals are constant over the current vector, GsssPerformDyn takes the same
+ *	route as GsssPerformStat. Otherwise a block of deviates is generated first and then
+ *	scaled and offset in a separate multiply-add pass.
+ *	
+ *	Both work in blocks of up to kChunkSize samples. This also keeps the scaling safe when
+ *	MSP hands us the same vector for input and output.
  *	
  *	Parameter block for GsssPerformStat contains 4 values:
  *		- Address of this function
@@ -326,7 +406,7 @@ GsssDSP(
  *		- Vector size
  *		- output signal
  *
- *	Parameter block for GsssPerformStat contains 6 values:
+ *	Parameter block for GsssPerformDyn contains 6 values:
  *		- Address of this function
  *		- The performing lp.gsss~ object
  *		- Vector size
@@ -350,24 +430,13 @@ GsssPerformStat(
 		paramNextLink
 		};
 	
-	double			mu,
-					stdDev;
-	long			vecCounter;
-	tSampleVector	outNoise;
 	objGaussNoise*	me = (objGaussNoise*) iParams[paramMe];
 	
 	if (me->coreObject.z_disabled) goto exit;
 	
-	// Copy parameters into registers
-	mu			= me->mu;
-	stdDev		= me->stdDev;
-	vecCounter	= (long) iParams[paramVectorSize];
-	outNoise	= (tSampleVector) iParams[paramOut];
-	
-	// Do our stuff
-	if (mu == 0.0 && stdDev == 1.0)
-		 do { *outNoise++ = NormalKRTaus88(NIL); } while (--vecCounter > 0);
-	else do { *outNoise++ = stdDev * NormalKRTaus88(NIL) + mu; } while (--vecCounter > 0);
+	GsssFillStat(	me->mu, me->stdDev,
+					(long) iParams[paramVectorSize],
+					(tSampleVector) iParams[paramOut]);
 		
 exit:
 	return iParams + paramNextLink;
@@ -390,6 +459,9 @@ GsssPerformDyn(
 		};
 		
 	long			vecCounter;
+	double			mu,
+					stdDev,
+					chunk[kChunkSize];
 	tSampleVector	muSig,
 					sdSig,
 					outNoise;
@@ -402,28 +474,177 @@ GsssPerformDyn(
 	muSig		= (tSampleVector) iParams[paramInMu];
 	sdSig		= (tSampleVector) iParams[paramInStdDev];
 	outNoise	= (tSampleVector) iParams[paramOut];
+	mu			= me->mu;
+	stdDev		= me->stdDev;
 	
-	// ASSERT: vecCount is even.
-	if (muSig && sdSig) do {
-		*outNoise++ = *sdSig++ * NormalKRTaus88(NIL) + *muSig++;
-		} while (--vecCounter > 0);
-		
-	else if (muSig) {
-		// No signal for Std. Dev.
-		double stdDev = me->stdDev;
-		do	{
-			*outNoise++ = stdDev * NormalKRTaus88(NIL) + *muSig++;
-			} while (--vecCounter > 0);
+	if (vecCounter <= 0) goto exit;
+	
+	// Effectively scalar parameters?
+	if (SigIsConstant(muSig, vecCounter) && SigIsConstant(sdSig, vecCounter)) {
+		if (muSig) mu		= *muSig;
+		if (sdSig) stdDev	= *sdSig;
+		GsssFillStat(mu, stdDev, vecCounter, outNoise);
+		goto exit;
 		}
-	else {
-		// ASSERT: no signal for µ, but there must be one for Std.Dev.
-		double mu = me->mu;
-		do	{
-			*outNoise++ = *sdSig++ * NormalKRTaus88(NIL) + mu;
-			} while (--vecCounter > 0);
+	
+	while (vecCounter > 0) {
+		long	n = (vecCounter < kChunkSize) ? vecCounter : kChunkSize,
+				i;
+		
+		NormalKRTaus88Fill(NIL, chunk, n);
+		
+		if (muSig && sdSig) {
+			for (i = 0; i < n; i += 1)
+				outNoise[i] = sdSig[i] * chunk[i] + muSig[i];
+			}
+		else if (muSig) {
+			// No signal for Std. Dev.
+			for (i = 0; i < n; i += 1)
+				outNoise[i] = stdDev * chunk[i] + muSig[i];
+			}
+		else {
+			// ASSERT: no signal for µ, but there must be one for Std.Dev.
+			for (i = 0; i < n; i += 1)
+				outNoise[i] = sdSig[i] * chunk[i] + mu;
+			}
+		
+		outNoise	+= n;
+		vecCounter	-= n;
+		if (muSig) muSig += n;
+		if (sdSig) sdSig += n;
 		}
 	
 exit:
 	return iParams + paramNextLink;
 	
-	}
\ No newline at end of file
+	}
+
+
+/******************************************************************************************
+ *
+ *	GsssDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	GsssPerformStat64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *	GsssPerformDyn64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain, following the same strategy as the 32-bit methods. With no
+ *	signals connected the deviates are generated straight into the outlet and scaled in
+ *	place. GsssPerformDyn64 gets the connected inlets as flags in the user parameter.
+ *
+ ******************************************************************************************/
+
+void
+GsssDSP64(
+	objGaussNoise*	me,
+	t_object*		iDSP64,
+	short*			iConnectCounts,
+	double			iSampleRate,
+	long			iMaxVectorSize,
+	long			iFlags)
+	
+	{
+	#pragma unused(iSampleRate, iMaxVectorSize, iFlags)
+	
+	long conn = 0;
+	
+	if (iConnectCounts[inletMu] > 0)		conn |= connMu;
+	if (iConnectCounts[inletStdDev] > 0)	conn |= connStdDev;
+	
+	if (conn == 0)
+		 dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) GsssPerformStat64, 0, NIL);
+	else dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) GsssPerformDyn64, 0, (void*) conn);
+	
+	}
+
+	static void GsssFillStat64(double iMu, double iStdDev, long iCount, tSampleVector64 oNoise)
+		{
+		long i;
+		
+		NormalKRTaus88Fill(NIL, oNoise, iCount);
+		
+		if (iMu != 0.0 || iStdDev != 1.0) {
+			for (i = 0; i < iCount; i += 1)
+				oNoise[i] = iStdDev * oNoise[i] + iMu;
+			}
+		}
+
+void
+GsssPerformStat64(
+	objGaussNoise*	me,
+	t_object*		iDSP64,
+	double**		iIns,
+	long			iInCount,
+	double**		iOuts,
+	long			iOutCount,
+	long			iVectorSize,
+	long			iFlags,
+	void*			iUser)
+	
+	{
+	#pragma unused(iDSP64, iIns, iInCount, iOutCount, iFlags, iUser)
+	
+	if (me->coreObject.z_disabled) return;
+	
+	GsssFillStat64(me->mu, me->stdDev, iVectorSize, iOuts[0]);
+	}
+
+void
+GsssPerformDyn64(
+	objGaussNoise*	me,
+	t_object*		iDSP64,
+	double**		iIns,
+	long			iInCount,
+	double**		iOuts,
+	long			iOutCount,
+	long			iVectorSize,
+	long			iFlags,
+	void*			iUser)
+	
+	{
+	#pragma unused(iDSP64, iInCount, iOutCount, iFlags)
+	
+	long			conn		= (long) iUser,
+					vecCounter	= iVectorSize;
+	double			mu			= me->mu,
+					stdDev		= me->stdDev,
+					chunk[kChunkSize];
+	tSampleVector64	muSig		= (conn & connMu) ? iIns[inletMu] : NIL,
+					sdSig		= (conn & connStdDev) ? iIns[inletStdDev] : NIL,
+					outNoise	= iOuts[0];
+	
+	if (me->coreObject.z_disabled || vecCounter <= 0) return;
+	
+	// Effectively scalar parameters?
+	if (SigIsConstant64(muSig, vecCounter) && SigIsConstant64(sdSig, vecCounter)) {
+		if (muSig) mu		= *muSig;
+		if (sdSig) stdDev	= *sdSig;
+		GsssFillStat64(mu, stdDev, vecCounter, outNoise);
+		return;
+		}
+	
+	// The outlet may share memory with one of the inlets, so go through a local buffer
+	while (vecCounter > 0) {
+		long	n = (vecCounter < kChunkSize) ? vecCounter : kChunkSize,
+				i;
+		
+		NormalKRTaus88Fill(NIL, chunk, n);
+		
+		if (muSig && sdSig) {
+			for (i = 0; i < n; i += 1)
+				outNoise[i] = sdSig[i] * chunk[i] + muSig[i];
+			}
+		else if (muSig) {
+			for (i = 0; i < n; i += 1)
+				outNoise[i] = stdDev * chunk[i] + muSig[i];
+			}
+		else {
+			for (i = 0; i < n; i += 1)
+				outNoise[i] = sdSig[i] * chunk[i] + mu;
+			}
+		
+		outNoise	+= n;
+		vecCounter	-= n;
+		if (muSig) muSig += n;
+		if (sdSig) sdSig += n;
+		}
+	
+	}
@@ -0,0 +1,859 @@
+/*
+	File:		hubbub~.c
+
+	Contains:	Multichannel noise bank. Generates several decorrelated channels of white,
+				gray, triangular, Gaussian, or variable-colored (Hurst) noise from split
+				Taus88 streams, all channels in one interleaved pass.
+
+	Written by:	Peter Castine
+
+	Copyright:	© 2026 Peter Castine
+
+	Change History (most recent first):
+
+*/
+
+
+/******************************************************************************************
+ ******************************************************************************************/
+
+#pragma mark • Include Files
+
+#include "LitterLib.h"	// Also #includes MaxUtils.h, ext.h
+#include "TrialPeriodUtils.h"
+#include "Taus88.h"
+#include "MiscUtils.h"
+
+
+#pragma mark • Constants
+
+const char*	kClassName		= "lp.hubbub~";			// Class name
+
+	// We used to define these as const int, but that causes GCC (XCode) to barf.
+	// enum seems to work with all compilers we've tried so far, so we'll go with it.
+enum {
+	kMaxChannels	= kTaus88MaxLanes,
+	kDefChannels	= 2,
+
+	kMaxBuf			= 4096,							// Same buffer length as qvvv~
+	kBufferSize
+	};
+
+const double	kMaxNN		= 31.0;
+const int		kIterations	= 12;					// log2(kMaxBuf)
+const double	kDefStdDev	= 0.4082482905;			// sqrt(1/6), as gsss~
+
+	// Indices for STR# resource
+enum {
+	strIndexInNN		= lpStrIndexLastStandard + 1,
+	strIndexOutNoise,
+
+	strIndexInLeft		= strIndexInNN,
+	strIndexOutLeft		= strIndexOutNoise
+	};
+
+	// Noise colors/distributions. Each corresponds to one of the single-channel
+	// Litter noise objects
+enum Color {
+	colWhite		= 0,							// schhh~
+	colGray,										// grrr~
+	colTri,											// trrr~
+	colGauss,										// gsss~
+	colHurst,										// qvvv~
+
+	colDef			= colWhite
+	};
+
+
+#pragma mark • Type Definitions
+
+typedef enum Color eColor;
+
+
+#pragma mark • Object Structure
+
+typedef struct {
+	t_pxobject		coreObject;
+
+	int				chanCount;
+	eColor			color;
+	tTaus88Lanes	lanes;						// One Taus88 stream per channel
+
+		// Per-channel parameters, stored as structure-of-arrays
+		// NN factor as bit mask (white, gray, triangular)...
+	UInt32			mask[kMaxChannels],
+					offset[kMaxChannels],
+					prev[kMaxChannels];			// Gray noise state
+		// ...and as quantization factors (Gaussian, Hurst), following qvvv~
+	float			nn[kMaxChannels],
+					factor[kMaxChannels],
+					factor1[kMaxChannels],
+					qOffset[kMaxChannels];
+	double			hurstExp[kMaxChannels],
+					hurstFac[kMaxChannels],
+					hurstGain[kMaxChannels];
+
+		// Work areas, allocated in the DSP method
+	long			frameCount;					// Frames available in words & samples
+	UInt32*			words;						// Interleaved random words
+	float*			samples;					// Interleaved output samples
+	float*			hurstBuf;					// Interleaved, (kBufferSize * chanCount)
+	int				bufPos;
+
+	tSampleVector	outSigs[kMaxChannels];
+	} objHubbub;
+
+
+#pragma mark • Global Variables
+
+
+
+#pragma mark • Function Prototypes
+
+	// Class message functions
+void*	HubbubNew(long, Symbol*);
+void	HubbubFree(objHubbub*);
+
+	// Object message functions
+static void HubbubInt(objHubbub*, long);
+static void HubbubFloat(objHubbub*, double);
+static void HubbubNN(objHubbub*, Symbol*, short, Atom[]);
+static void HubbubHurst(objHubbub*, Symbol*, short, Atom[]);
+static void HubbubColor(objHubbub*, Symbol*, short, Atom[]);
+static void HubbubSeed(objHubbub*, long);
+static void HubbubTattle(objHubbub*);
+static void	HubbubAssist(objHubbub*, void* , long , long , char*);
+static void	HubbubInfo(objHubbub*);
+
+	// MSP Messages
+static void	HubbubDSP(objHubbub*, t_signal**, short*);
+static int*	HubbubPerform(int*);
+static void	HubbubDSP64(objHubbub*, t_object*, short*, double, long, long);
+static void	HubbubPerform64(objHubbub*, t_object*, double**, long, double**, long, long, long, void*);
+
+
+#pragma mark -
+/*****************************  I M P L E M E N T A T I O N  ******************************/
+
+#pragma mark • Inline Functions
+
+
+#pragma mark -
+
+/******************************************************************************************
+ *
+ *	main()
+ *
+ *	Standard Max/MSP External Object Entry Point Function
+ *
+ ******************************************************************************************/
+
+void
+main(void)
+
+	{
+	LITTER_CHECKTIMEOUT(kClassName);
+
+	// Standard Max/MSP initialization mantra
+	setup(	&gObjectClass,				// Pointer to our class definition
+			(method) HubbubNew,			// Instance creation function
+			(method) HubbubFree,		// Custom deallocation function
+			sizeof(objHubbub),			// Class object size
+			NIL,						// No menu function
+										// Optional arguments:
+			A_DEFLONG,					//		-- Number of channels
+			A_DEFSYM,					//		-- Color
+			0);
+
+	dsp_initclass();
+
+	// Messages
+	addint	((method) HubbubInt);
+	addfloat((method) HubbubFloat);
+	addmess ((method) HubbubNN,			"nn",		A_GIMME, 0);
+	addmess ((method) HubbubHurst,		"hurst",	A_GIMME, 0);
+	addmess ((method) HubbubSeed,		"seed",		A_DEFLONG, 0);
+
+	// Colors
+	addmess ((method) HubbubColor,		"white",	A_GIMME, 0);
+	addmess ((method) HubbubColor,		"gray",		A_GIMME, 0);
+	addmess ((method) HubbubColor,		"tri",		A_GIMME, 0);
+	addmess ((method) HubbubColor,		"gauss",	A_GIMME, 0);
+	addmess ((method) HubbubColor,		"vary",		A_GIMME, 0);
+
+	// Information messages
+	addmess	((method) HubbubTattle,		"dblclick",	A_CANT, 0);
+	addmess	((method) HubbubTattle,		"tattle",	A_NOTHING);
+	addmess	((method) HubbubAssist,		"assist",	A_CANT, 0);
+	addmess	((method) HubbubInfo,		"info",		A_CANT, 0);
+
+	// MSP-Level messages
+	LITTER_TIMEBOMB addmess	((method) HubbubDSP,	"dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) HubbubDSP64,	"dsp64",	A_CANT, 0);
+
+	//Initialize Litter Library
+	LitterInit(kClassName, 0);
+	Taus88Init();
+
+	}
+
+
+
+#pragma mark -
+#pragma mark • Class Message Handlers
+
+/******************************************************************************************
+ *
+ *	HubbubNew(iChans, iColor)
+ *	HubbubFree(me)
+ *
+ ******************************************************************************************/
+
+	static void SetNN(objHubbub* me, int iChan, double iNN)
+		{
+		// Bit mask, as used by schhh~
+		if (iNN < 1.0) {
+			me->mask[iChan]		= kULongMax;
+			me->offset[iChan]	= 0;
+			}
+		else {
+			int nn = (iNN > kMaxNN) ? (int) kMaxNN : (int) iNN;
+			me->mask[iChan]		= kULongMax << nn;
+			me->offset[iChan]	= (~me->mask[iChan]) >> 1;
+			}
+
+		// Floating point quantization, as used by qvvv~
+		if (iNN <= 0.0) {
+			me->nn[iChan]		= 0.0;
+			me->factor[iChan]	= 0.0;
+			me->factor1[iChan]	= 0.0;
+			me->qOffset[iChan]	= 0.0;
+			}
+		else {
+			if (iNN > kMaxNN)
+				iNN = kMaxNN;
+			me->nn[iChan] = iNN;
+
+			if (iNN < 16.0) {
+				// Parabolic mapping of (0..16) to (8..16); see qvvv~ for the rationale
+				iNN /= 16.00;
+				iNN *= iNN;
+				iNN *= 8.0;
+				iNN += 8.0;
+				}
+
+			me->factor[iChan]	= pow(2.0, 31.0 - iNN);
+			me->factor1[iChan]	= 1.0 / me->factor[iChan];
+			me->qOffset[iChan]	= 0.5 * me->factor1[iChan];
+			}
+		}
+
+	static void SetHurst(objHubbub* me, int iChan, double iHurst)
+		{
+		int		i;
+		double	hf		= pow(0.5, iHurst),
+				xn		= 1.0,
+				power	= 1.0;
+
+		// RMS calculation of expected power sum, as in qvvv~
+		for (i = kIterations - 1; i > 0; i -= 1) {
+			xn		*= hf;
+			power	+= xn * xn;
+			}
+
+		me->hurstExp[iChan]		= iHurst;
+		me->hurstFac[iChan]		= hf;
+		me->hurstGain[iChan]	= 1.0 / sqrt(power);
+		}
+
+	static void ResetHurstBuf(objHubbub* me)
+		{
+		float*	buf = me->hurstBuf;
+		int		n	= me->chanCount,
+				i;
+
+		if (buf == NIL) return;
+
+		for (i = 0; i < kMaxBuf * n; i += 1)
+			buf[i] = 0.0;
+		for (i = 0; i < n; i += 1)
+			buf[kMaxBuf * n + i] = Taus88Signal(NIL) / 3.0;			// Same fudge as qvvv~
+
+		me->bufPos = kMaxBuf;
+		}
+
+void*
+HubbubNew(
+	long	iChans,
+	Symbol*	iColor)
+
+	{
+	objHubbub*	me			= NIL;
+	float*		hurstBuf	= NIL;
+	int			i;
+
+	if (iChans <= 0)
+		iChans = kDefChannels;
+	else if (iChans > kMaxChannels)
+		iChans = kMaxChannels;
+
+	// The Hurst buffer does not depend on the vector size, so allocate it right away
+	hurstBuf = (float*) NewPtr(kBufferSize * iChans * sizeof(float));
+	if (hurstBuf == NIL) goto punt;
+
+	// Let Max/MSP allocate us, our inlets, and outlets.
+	me = (objHubbub*) newobject(gObjectClass);
+	if (me == NIL) {
+		DisposePtr((Ptr) hurstBuf);
+		goto punt;
+		}
+
+	dsp_setup(&(me->coreObject), 1);				// Signal inlet for benefit of begin~
+	for (i = 0; i < iChans; i += 1)
+		outlet_new(me, "signal");
+
+	// Set up object components
+	me->chanCount	= iChans;
+	me->color		= colDef;
+	me->frameCount	= 0;
+	me->words		= NIL;
+	me->samples		= NIL;
+	me->hurstBuf	= hurstBuf;
+
+	Taus88LanesSeed(&me->lanes, iChans, 0);
+
+	for (i = 0; i < iChans; i += 1) {
+		me->prev[i] = 0;
+		SetNN(me, i, 0.0);
+		SetHurst(me, i, 0.0);
+		}
+	ResetHurstBuf(me);
+
+	if (iColor != NIL && iColor->s_name[0] != '\0')
+		HubbubColor(me, iColor, 0, NIL);
+
+punt:
+	return me;
+	}
+
+void
+HubbubFree(
+	objHubbub* me)
+
+	{
+
+	// First call dsp_free() to clean up DSP chain
+	dsp_free(&(me->coreObject));
+
+	if (me->words != NIL)		DisposePtr((Ptr) me->words);
+	if (me->samples != NIL)		DisposePtr((Ptr) me->samples);
+	if (me->hurstBuf != NIL)	DisposePtr((Ptr) me->hurstBuf);
+
+	}
+
+
+#pragma mark -
+#pragma mark • Object Message Handlers
+
+/******************************************************************************************
+ *
+ *	HubbubInt(me, iNN)
+ *	HubbubFloat(me, iNN)
+ *	HubbubNN(me, sym, iArgC, iArgV)
+ *	HubbubHurst(me, sym, iArgC, iArgV)
+ *
+ *	Set parameters, making sure nothing bad happens. A number in the left inlet sets the
+ *	NN factor for all channels. With the nn and hurst messages, a single value applies to
+ *	all channels, a list sets channels individually, starting with the first.
+ *
+ ******************************************************************************************/
+
+void HubbubInt(objHubbub* me, long iNN)
+	{ HubbubFloat(me, (double) iNN); }
+
+void HubbubFloat(objHubbub* me, double iNN)
+	{
+	int i;
+
+	for (i = 0; i < me->chanCount; i += 1)
+		SetNN(me, i, iNN);
+	}
+
+void
+HubbubNN(
+	objHubbub*	me,
+	Symbol*		sym,
+	short		iArgC,
+	Atom		iArgV[])
+
+	{
+	#pragma unused(sym)
+
+	int i;
+
+	if (iArgC == 1)
+		HubbubFloat(me, AtomGetFloat(iArgV));
+	else for (i = 0; i < iArgC && i < me->chanCount; i += 1)
+		SetNN(me, i, AtomGetFloat(iArgV + i));
+
+	}
+
+void
+HubbubHurst(
+	objHubbub*	me,
+	Symbol*		sym,
+	short		iArgC,
+	Atom		iArgV[])
+
+	{
+	#pragma unused(sym)
+
+	int i;
+
+	if (iArgC == 1) {
+		double hurst = AtomGetFloat(iArgV);
+		for (i = 0; i < me->chanCount; i += 1)
+			SetHurst(me, i, hurst);
+		}
+	else for (i = 0; i < iArgC && i < me->chanCount; i += 1)
+		SetHurst(me, i, AtomGetFloat(iArgV + i));
+
+	}
+
+
+/******************************************************************************************
+ *
+ *	HubbubColor(me, iSym, iArgC, iArgV)
+ *	HubbubSeed(me, iSeed)
+ *
+ *	The color messages (white, gray, tri, gauss, vary) take an optional list of Hurst
+ *	exponents, which only makes a difference for vary.
+ *
+ ******************************************************************************************/
+
+void
+HubbubColor(
+	objHubbub*	me,
+	Symbol*		iSym,
+	short		iArgC,
+	Atom		iArgV[])
+
+	{
+	static Symbol*	sColorSyms[colHurst + 1]	= {NIL, NIL, NIL, NIL, NIL};
+
+	int	i;
+
+	if (sColorSyms[0] == NIL) {
+		sColorSyms[colWhite]	= gensym("white");
+		sColorSyms[colGray]		= gensym("gray");
+		sColorSyms[colTri]		= gensym("tri");
+		sColorSyms[colGauss]	= gensym("gauss");
+		sColorSyms[colHurst]	= gensym("vary");
+		}
+
+	for (i = colWhite; i <= colHurst; i += 1) {
+		if (iSym == sColorSyms[i]) break;
+		}
+
+	if (i > colHurst) {
+		error("%s: unknown color %s", kClassName, iSym->s_name);
+		return;
+		}
+
+	me->color = (eColor) i;
+
+	if (iArgC > 0)
+		HubbubHurst(me, NIL, iArgC, iArgV);
+
+	}
+
+void HubbubSeed(objHubbub* me, long iSeed)
+	{ Taus88LanesSeed(&me->lanes, me->chanCount, (UInt32) iSeed); }
+
+
+/******************************************************************************************
+ *
+ *	HubbubTattle(me)
+ *
+ *	Post state information
+ *
+ ******************************************************************************************/
+
+void
+HubbubTattle(
+	objHubbub* me)
+
+	{
+	const char*	kColorNames[] = {"white", "gray", "triangular", "Gaussian", "variable"};
+	int			i;
+
+	post("%s state", kClassName);
+	post("  %ld channels of %s noise", (long) me->chanCount, kColorNames[me->color]);
+	for (i = 0; i < me->chanCount; i += 1) {
+		post("  channel %ld: NN factor %lf (mask = %lx), Hurst exponent %lf",
+				(long) i + 1, (double) me->nn[i], me->mask[i], me->hurstExp[i]);
+		}
+
+	}
+
+
+/******************************************************************************************
+ *
+ *	HubbubAssist()
+ *	HubbubInfo()
+ *
+ *	Fairly generic Assist/Info methods
+ *
+ ******************************************************************************************/
+
+void HubbubAssist(objHubbub* me, void* box, long iDir, long iArgNum, char* oCStr)
+	{
+	#pragma unused(me, box)
+
+	if (iDir == ASSIST_INLET)
+		LitterAssist(iDir, iArgNum, strIndexInLeft, strIndexOutLeft, oCStr);
+	else LitterAssistVA(iDir, 0, strIndexInLeft, strIndexOutLeft, oCStr, iArgNum + 1);
+	}
+
+void HubbubInfo(objHubbub* me)
+	{ LitterInfo(kClassName, &me->coreObject.z_ob, (method) HubbubTattle); }
+
+
+
+#pragma mark -
+#pragma mark • DSP Methods
+
+/******************************************************************************************
+ *
+ *	HubbubDSP(me, ioDSPVectors, iConnectCounts)
+ *	HubbubDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *
+ *	Make sure the interleaved work areas can hold a full vector (we always reserve room
+ *	for two random words per frame, so switching colors never needs to reallocate), then
+ *	remember where the outlets are. The 64-bit chain hands the outlets to the perform
+ *	method directly.
+ *
+ ******************************************************************************************/
+
+	static Boolean AllocWorkAreas(objHubbub* me, long iVecSize)
+		{
+		long	frames		= (iVecSize + 1) & ~1L;			// Gauss uses pairs of frames
+		int		chanCount	= me->chanCount;
+		
+		if (frames <= me->frameCount)
+			return true;
+		
+		if (me->words != NIL)	DisposePtr((Ptr) me->words);
+		if (me->samples != NIL)	DisposePtr((Ptr) me->samples);
+
+		me->words	= (UInt32*) NewPtr(2 * frames * chanCount * sizeof(UInt32));
+		me->samples	= (float*) NewPtr(frames * chanCount * sizeof(float));
+
+		if (me->words == NIL || me->samples == NIL) {
+			error("%s: could not allocate work area for vector size %ld", kClassName, iVecSize);
+			if (me->words != NIL)	DisposePtr((Ptr) me->words);
+			if (me->samples != NIL)	DisposePtr((Ptr) me->samples);
+			me->words		= NIL;
+			me->samples		= NIL;
+			me->frameCount	= 0;
+			return false;
+			}
+
+		me->frameCount = frames;
+		
+		return true;
+		}
+
+void
+HubbubDSP(
+	objHubbub*	me,
+	t_signal**	ioDSPVectors,
+	short*		connectCounts)
+
+	{
+	#pragma unused(connectCounts)
+
+	long	vecSize		= ioDSPVectors[0]->s_n;
+	int		chanCount	= me->chanCount,
+			i;
+
+	if (!AllocWorkAreas(me, vecSize))
+		return;
+
+	for (i = 0; i < chanCount; i += 1)
+		me->outSigs[i] = ioDSPVectors[i + 1]->s_vec;
+
+	dsp_add(HubbubPerform, 2, me, vecSize);
+
+	}
+
+void
+HubbubDSP64(
+	objHubbub*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+
+	{
+	#pragma unused(iConnectCounts, iSampleRate, iFlags)
+
+	if (AllocWorkAreas(me, iMaxVectorSize))
+		dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) HubbubPerform64, 0, NIL);
+
+	}
+
+
+/******************************************************************************************
+ *
+ *	HubbubPerform(iParams)
+ *	HubbubPerform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Parameter block for HubbubPerform contains 3 values:
+ *		- Address of this function
+ *		- The performing hubbub~ object
+ *		- Vector size
+ *
+ *	All channels are generated in one pass: the random words for every channel are
+ *	drawn interleaved from the split streams, shaped into interleaved samples with loops
+ *	that run across channels, and only then de-interleaved into the outlets. Per-channel
+ *	quantization for the floating point colors is done on the contiguous outlet vectors.
+ *	The 64-bit version shares the interleaved (single precision) work area and only
+ *	differs in the outlet vectors it de-interleaves into.
+ *
+ ******************************************************************************************/
+
+	static void GenerateHurstBuffer(objHubbub* me)
+		{
+		const int	n		= me->chanCount;
+
+		float*		buf		= me->hurstBuf;
+		UInt32		frameWords[kMaxChannels];
+		double		scale[kMaxChannels];
+		int			stride	= kMaxBuf / 2,
+					offset	= kMaxBuf / 4,
+					c;
+
+		//
+		// Voss random addition algorithm, as qvvv~, run across all channels at once
+		//
+		for (c = 0; c < n; c += 1)
+			scale[c] = me->hurstGain[c];
+
+		Taus88LanesFill(&me->lanes, frameWords, 1);
+		for (c = 0; c < n; c += 1) {
+			buf[c]				= buf[kMaxBuf * n + c];
+			buf[stride * n + c]	= scale[c] * Long2Signal((SInt32) frameWords[c]);
+			}
+		Taus88LanesFill(&me->lanes, frameWords, 1);
+		for (c = 0; c < n; c += 1)
+			buf[kMaxBuf * n + c] = scale[c] * Long2Signal((SInt32) frameWords[c]);
+
+		while (offset > 0) {
+			int i;
+
+			for (c = 0; c < n; c += 1)
+				scale[c] *= me->hurstFac[c];
+
+			for (i = offset; i < kMaxBuf; i += stride) {
+				float*	cur		= buf + i * n;
+				float*	left	= cur - offset * n;
+				float*	right	= cur + offset * n;
+
+				Taus88LanesFill(&me->lanes, frameWords, 1);
+				for (c = 0; c < n; c += 1)
+					cur[c] = 0.5 * (left[c] + right[c])
+								+ scale[c] * Long2Signal((SInt32) frameWords[c]);
+				}
+
+			stride = offset;
+			offset /= 2;
+			}
+
+		me->bufPos = 0;
+		}
+
+	// Gaussian noise is generated in pairs of frames, so for an odd vector size it needs
+	// one frame more (the spare variate is simply dropped). Every other color gets exactly
+	// one vector's worth; in particular the Hurst buffer must be read without gaps.
+	static inline long FramesNeeded(objHubbub* me, long iVecSize)
+		{ return (me->color == colGauss) ? (iVecSize + 1) & ~1L : iVecSize; }
+
+	static void GenerateFrames(objHubbub* me, long iFrames)
+		{
+		const int	n			= me->chanCount,
+					count		= iFrames * n;
+
+		UInt32*		words		= me->words;
+		float*		samples		= me->samples;
+		UInt32*		mask		= me->mask;
+		UInt32*		offset		= me->offset;
+		int			i, c;
+
+		switch (me->color) {
+		default:
+			// colWhite
+			Taus88LanesFill(&me->lanes, words, iFrames);
+			for (i = 0; i < count; i += n) {
+				for (c = 0; c < n; c += 1)
+					samples[i+c] = ULong2Signal((words[i+c] & mask[c]) + offset[c]);
+				}
+			break;
+
+		case colGray: {
+			UInt32* prev = me->prev;
+
+			Taus88LanesFill(&me->lanes, words, iFrames);
+			for (i = 0; i < count; i += n) {
+				for (c = 0; c < n; c += 1) {
+					prev[c] ^= words[i+c];
+					samples[i+c] = ULong2Signal((prev[c] & mask[c]) + offset[c]);
+					}
+				}
+			}
+			break;
+
+		case colTri: {
+			UInt32* words2 = words + count;
+
+			Taus88LanesFill(&me->lanes, words, iFrames);
+			Taus88LanesFill(&me->lanes, words2, iFrames);
+			for (i = 0; i < count; i += n) {
+				for (c = 0; c < n; c += 1) {
+					UInt32 t = (words[i+c] >> 1) + (words2[i+c] >> 1);
+					samples[i+c] = ULong2Signal((t & mask[c]) + offset[c]);
+					}
+				}
+			}
+			break;
+
+		case colGauss:
+			// Box-Muller without rejection (cf. UnitSq2Norm()): each pair of frames
+			// consumes one word per channel and frame, giving both the cosine and the
+			// sine variate. ASSERT: iFrames is even.
+			Taus88LanesFill(&me->lanes, words, iFrames);
+			for (i = 0; i < count; i += n + n) {
+				for (c = 0; c < n; c += 1) {
+					double	r	= kDefStdDev
+									* sqrt(-2.0 * log(ULong2Unit_zO(words[i+c]))),
+							phi	= k2pi * ULong2Unit_Zo(words[i+n+c]);
+
+					samples[i+c]	= r * cos(phi);
+					samples[i+n+c]	= r * sin(phi);
+					}
+				}
+			break;
+
+		case colHurst:
+			if (me->hurstBuf == NIL)
+				break;
+			for (i = 0; i < iFrames; i += 1) {
+				float* cur;
+
+				if (me->bufPos >= kMaxBuf)
+					GenerateHurstBuffer(me);
+				cur = me->hurstBuf + (me->bufPos++) * n;
+				for (c = 0; c < n; c += 1)
+					samples[i * n + c] = cur[c];
+				}
+			break;
+			}
+
+		}
+
+int*
+HubbubPerform(
+	int* iParams)
+
+	{
+	enum {
+		paramFuncAddress	= 0,
+		paramMe,
+		paramVectorSize,
+
+		paramNextLink
+		};
+
+	long		vecSize;
+	int			chanCount,
+				c;
+	float*		samples;
+	objHubbub*	me = (objHubbub*) iParams[paramMe];
+
+	if (me->coreObject.z_disabled) goto exit;
+	if (me->samples == NIL) goto exit;
+
+	// Copy parameters into registers
+	vecSize		= (long) iParams[paramVectorSize];
+	chanCount	= me->chanCount;
+	samples		= me->samples;
+
+	GenerateFrames(me, FramesNeeded(me, vecSize));
+
+	// De-interleave, applying floating-point NN quantization where needed
+	for (c = 0; c < chanCount; c += 1) {
+		tSampleVector	out		= me->outSigs[c];
+		float*			src		= samples + c;
+		long			i;
+
+		for (i = 0; i < vecSize; i += 1)
+			out[i] = src[i * chanCount];
+
+		if (me->nn[c] > 0.0 && (me->color == colGauss || me->color == colHurst)) {
+			float	factor	= me->factor[c],
+					factor1	= me->factor1[c],
+					offset	= me->qOffset[c];
+
+			for (i = 0; i < vecSize; i += 1)
+				out[i] = factor1 * floor(factor * out[i]) + offset;
+			}
+		}
+
+exit:
+	return iParams + paramNextLink;
+	}
+
+void
+HubbubPerform64(
+	objHubbub*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+
+	{
+	#pragma unused(iDSP64, iIns, iInCount, iOutCount, iFlags, iUser)
+
+	int		chanCount	= me->chanCount,
+			c;
+	float*	samples		= me->samples;
+
+	if (me->coreObject.z_disabled) return;
+	if (samples == NIL || iVectorSize > me->frameCount) return;
+
+	GenerateFrames(me, FramesNeeded(me, iVectorSize));
+
+	for (c = 0; c < chanCount; c += 1) {
+		tSampleVector64	out		= iOuts[c];
+		float*			src		= samples + c;
+		long			i;
+
+		for (i = 0; i < iVectorSize; i += 1)
+			out[i] = src[i * chanCount];
+
+		if (me->nn[c] > 0.0 && (me->color == colGauss || me->color == colHurst)) {
+			double	factor	= me->factor[c],
+					factor1	= me->factor1[c],
+					offset	= me->qOffset[c];
+
+			for (i = 0; i < iVectorSize; i += 1)
+				out[i] = factor1 * floor(factor * out[i]) + offset;
+			}
+		}
+
+	}
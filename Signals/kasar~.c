@@ -31,6 +31,8 @@ const unsigned long	kTableLen		= 256,
 				kTableLenMod	= 0x000001ff,
 				kMaxUnitThresh	= 0x07ffffff;		// kMaxUInt / kTableLen
 
+const double	kDefAmp			= 1.0;				// ??
+
 	// Indices for STR# resource
 enum {
 		// Inlets
@@ -61,7 +63,8 @@ typedef struct {
 					curN;
 	
 	double			sr,
-					*step;				// 
+					*step,				// 
+					amp;				// Output level when no signal is connected
 	} tCymbal;
 
 
@@ -88,6 +91,9 @@ static void	CymbalInfo(tCymbal*);
 static void	CymbalDSP(tCymbal*, t_signal**, short*);
 static int*	CymbalPerformSimp(int*);
 static int*	CymbalPerformMod(int*);
+static void	CymbalDSP64(tCymbal*, t_object*, short*, double, long, long);
+static void	CymbalPerformSimp64(tCymbal*, t_object*, double**, long, double**, long, long, long, void*);
+static void	CymbalPerformMod64(tCymbal*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -152,6 +158,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) CymbalDSP,	"dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) CymbalDSP64,	"dsp64",		A_CANT, 0);
 
 	//Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -175,8 +182,6 @@ CymbalNew(
 	double iAmp)
 	
 	{
-	const double kDefAmp = 1.0;						// ?? 
-	
 	tCymbal* me	= NIL;
 	
 	// Cheesy test for default amplitude
@@ -189,7 +194,7 @@ CymbalNew(
 	
 	outlet_new(me, "signal");
 	
-//	me->amp = iAmp;
+	me->amp = iAmp;
 	
 	return me;
 	}
@@ -206,7 +211,7 @@ CymbalNew(
  *
  ******************************************************************************************/
 
-/*void CymbalAmp(tCymbal* me, double iAmp)
+void CymbalAmp(tCymbal* me, double iAmp)
 	{ me->amp = iAmp; }
 
 void CymbalDefAmp(tCymbal* me)
@@ -214,7 +219,7 @@ void CymbalDefAmp(tCymbal* me)
 
 void CymbalInt(tCymbal* me, long iAmp)
 	{ CymbalAmp(me, (double) iAmp); }
-*/
+
 /******************************************************************************************
  *
  *	CymbalTattle(me)
@@ -322,10 +327,7 @@ CymbalPerformMod(
 		paramNextLink
 		};
 		
-	const int kRandBitCount = 32;
-	
-	long			vecCounter,
-					randBits;
+	long			vecCounter;
 	tSampleVector	inAmp,
 					outNoise;
 	tCymbal*		me = (tCymbal*) iParams[paramMe];
@@ -338,29 +340,7 @@ CymbalPerformMod(
 	outNoise	= (tSampleVector) iParams[paramOut];
 	
 	// Do our stuff
-	// We rely on vecCounter being a power of 2, which means that either
-	// a single 32-bit random value will sort us out or we will use some
-	// exact integral multiple of 32-bits
-	if (vecCounter < kRandBitCount) {
-		randBits = Taus88(NIL);
-		
-		do {
-			*outNoise++ = (randBits < 0) ? -(*inAmp++) : *inAmp++;
-			randBits <<= 1;
-			} while (vecCounter-- > 0);
-		}
-	
-	else while (vecCounter > 0) {
-		int i = kRandBitCount;
-		
-		randBits = Taus88(NIL);
-		do {
-			*outNoise++ = (randBits < 0) ? -(*inAmp++) : *inAmp++;
-			randBits <<= 1;
-			} while (--i > 0);
-		
-		vecCounter -= kRandBitCount;
-		}
+	Taus88BitFlipVector(inAmp, outNoise, vecCounter);
 	
 exit:
 	return iParams + paramNextLink;
@@ -381,11 +361,8 @@ CymbalPerformSimp(
 		paramNextLink
 		};
 		
-	const int kRandBitCount = 32;
-	
-	long			vecCounter,
-					randBits;
-	float			amp, negAmp;
+	long			vecCounter;
+	float			amp;
 	tSampleVector	outNoise;
 	tCymbal*		me = (tCymbal*) iParams[paramMe];
 	
@@ -394,34 +371,80 @@ CymbalPerformSimp(
 	// Copy parameters into registers
 	vecCounter	= (long) iParams[paramVectorSize];
 	outNoise	= (tSampleVector) iParams[paramOut];
-//	amp			= me->amp;
-	negAmp		= -amp;
+	amp			= me->amp;
 	
 	// Do our stuff
-	// We rely on vecCounter being a power of 2, which means that either
-	// a single 32-bit random value will sort us out or we will use some
-	// exact integral multiple of 32-bits
-	if (vecCounter < kRandBitCount) {
-		randBits = Taus88(NIL);
-		
-		do {
-			*outNoise++ = (randBits < 0) ? negAmp : amp;
-			randBits <<= 1;
-			} while (vecCounter-- > 0);
-		}
-	
-	else while (vecCounter > 0) {
-		int i = kRandBitCount;
-		
-		randBits = Taus88(NIL);
-		do {
-			*outNoise++ = (randBits < 0) ? negAmp : amp;
-			randBits <<= 1;
-			} while (--i > 0);
-		
-		vecCounter -= kRandBitCount;
-		}
+	Taus88BitSigVector(outNoise, vecCounter, amp);
 	
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	CymbalDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	CymbalPerformMod64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *	CymbalPerformSimp64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. As with the 32-bit methods, a signal connected to the inlet
+ *	gets its sign flipped at random; otherwise we generate ±amp.
+ *
+ ******************************************************************************************/
+
+void
+CymbalDSP64(
+	tCymbal*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iSampleRate, iMaxVectorSize, iFlags)
+	
+	dsp_add64(	iDSP64, (t_object*) me,
+				(t_perfroutine64) ((iConnectCounts[0] > 0) ? CymbalPerformMod64 : CymbalPerformSimp64),
+				0, NIL);
+	}
+
+void
+CymbalPerformMod64(
+	tCymbal*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iInCount, iOutCount, iFlags, iUser)
+	
+	if (me->coreObject.z_disabled) return;
+	
+	Taus88BitFlipVector64(iIns[0], iOuts[0], iVectorSize);
+	}
+
+void
+CymbalPerformSimp64(
+	tCymbal*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iIns, iInCount, iOutCount, iFlags, iUser)
+	
+	if (me->coreObject.z_disabled) return;
+	
+	Taus88BitSigVector64(iOuts[0], iVectorSize, me->amp);
+	}
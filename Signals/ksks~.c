@@ -123,6 +123,8 @@ static void	PluckInfo(objPluck*);
 	// MSP Messages
 static void	PluckDSP(objPluck*, t_signal**, short*);
 static int*	PluckPerform(int*);
+static void	PluckDSP64(objPluck*, t_object*, short*, double, long, long);
+static void	PluckPerform64(objPluck*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -173,6 +175,7 @@ main(void)
 	
 	// MSP-Level messages
 	addmess	((method) PluckDSP,		"dsp",		A_CANT, 0);
+	addmess	((method) PluckDSP64,		"dsp64",		A_CANT, 0);
 
 	//Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -683,3 +686,140 @@ PluckPerform(
 punt:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	PluckDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	PluckPerform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. Like PluckPerform(), this ignores the signal inlets.
+ *
+ ******************************************************************************************/
+
+void
+PluckDSP64(
+	objPluck*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iConnectCounts, iMaxVectorSize, iFlags)
+	
+	if (me->sr != iSampleRate) {
+		me->sr = iSampleRate;
+		me->phiStep	= kBufSize * (me->freq / iSampleRate);
+		}
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) PluckPerform64, 0, NIL);
+	}
+
+void
+PluckPerform64(
+	objPluck*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iIns, iInCount, iOutCount, iFlags, iUser)
+	
+	const double kMaxRho = 0.499999;					// Just under 0.5 to reduce DC
+	
+	long			n;
+	tSampleVector64	out;
+	double			phiFrac,
+					cumPhiErr,
+					rho;
+	long			phiStep,
+					curPhi,
+					prevPhi;
+	unsigned long	blendTau;
+	tSampleVector	buf;
+	
+	if (me->coreObject.z_disabled) return;
+	
+	if (me->trigger)
+		GenBuf(me);
+	
+	// Copy parameters and object members into registers
+	n			= iVectorSize;
+	out			= iOuts[0];
+	phiFrac		= me->phiFrac;
+	cumPhiErr	= me->cumPhiErr;
+	rho			= me->rho;
+	phiStep		= me->phiStep;
+	curPhi		= me->curPhi;
+	buf			= me->buf;
+	blendTau	= me->blendTau;
+	
+	if (rho <= 1.0) {
+		// Modified Karplus-Strong w/Decay Compression
+		rho *= kMaxRho;
+		
+		if (blendTau > 0) do {
+			if (Taus88(NIL) < blendTau)
+				buf[curPhi] *= -1.0;
+			
+			*out++ = buf[curPhi];
+			
+			prevPhi = curPhi;
+			curPhi = IncrPhi(curPhi, phiStep, &cumPhiErr, phiFrac);
+			
+			if (curPhi != prevPhi)
+				SmoothBuf(buf, prevPhi, curPhi, rho);
+			} while (--n > 0);
+		
+		else do {												// blendTau == 0
+			*out++ = buf[curPhi];
+			
+			prevPhi = curPhi;
+			curPhi = IncrPhi(curPhi, phiStep, &cumPhiErr, phiFrac);
+			
+			if (curPhi != prevPhi)
+				SmoothBuf(buf, prevPhi, curPhi, rho);
+			} while (--n > 0);
+		}
+	
+	else {														// rho > 1.0
+		// Karplus-Strong w/Decay Stretching
+		unsigned long tau = me->tau;
+		
+		if (blendTau > 0) do {
+			if (Taus88(NIL) < blendTau)
+				buf[curPhi] *= -1.0;
+			
+			*out++ = buf[curPhi];
+			
+			prevPhi = curPhi;
+			curPhi = IncrPhi(curPhi, phiStep, &cumPhiErr, phiFrac);
+			
+			if (curPhi != prevPhi && Taus88(NIL) <= tau)
+				SmoothBuf(buf, prevPhi, curPhi, kMaxRho);
+			
+			} while (--n > 0);
+		
+		else do {												// blendTau == 0
+			*out++ = buf[curPhi];
+			
+			prevPhi = curPhi;
+			curPhi = IncrPhi(curPhi, phiStep, &cumPhiErr, phiFrac);
+			
+			if (curPhi != prevPhi && Taus88(NIL) <= tau)
+				SmoothBuf(buf, prevPhi, curPhi, kMaxRho);
+			
+			} while (--n > 0);
+		}
+		
+	// Update member data
+	me->cumPhiErr	= cumPhiErr;
+	me->curPhi		= curPhi;
+	}
@@ -28,11 +28,17 @@
 #include "LitterLib.h"	// Also #includes MaxUtils.h, ext.h
 #include "TrialPeriodUtils.h"
 #include "MiscUtils.h"
+#include "LinCong.h"
 
 #pragma mark • Constants
 
 const char*	kClassName		= "lp.lll~";			// Class name
 
+	// Perform routine generates this many values at a time into a local buffer
+enum {
+	kChunkSize		= 256
+	};
+
 	// Indices for STR# resource
 enum {
 	strIndexInSeed		= lpStrIndexLastStandard + 1,
@@ -99,11 +105,8 @@ const tRepertoire	kRepertoire[] = {
 typedef struct {
 	t_pxobject		coreObject;
 	
-	unsigned long	mul,
-					add,
-					mod,
-					modMask,
-					seed;
+	tLinCong		lc;						// mul, add, mod & precalculated constants
+	UInt32			seed;
 	} tLCN;
 
 
@@ -121,6 +124,7 @@ static void LllMul(tLCN*, unsigned long);
 static void LllAdd(tLCN*, unsigned long);
 static void LllMod(tLCN*, unsigned long);
 static void LllSeed(tLCN*, unsigned long);
+static void LllSkip(tLCN*, double);
 static void LllTattle(tLCN*);
 static void	LllAssist(tLCN*, void* , long , long , char*);
 static void	LllInfo(tLCN*);
@@ -128,6 +132,8 @@ static void	LllInfo(tLCN*);
 	// MSP Messages
 static void	LllDSP(tLCN*, t_signal**, short*);
 static int*	LllPerform(int*);
+static void	LllDSP64(tLCN*, t_object*, short*, double, long, long);
+static void	LllPerform64(tLCN*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -172,6 +178,7 @@ main(void)
 	addmess	((method) LllMul,		"in1",		A_LONG, 0);
 	addmess	((method) LllAdd,		"in2",		A_LONG,	0);
 	addmess	((method) LllMod,		"in3",		A_LONG, 0);
+	addmess	((method) LllSkip,		"skip",		A_FLOAT, 0);
 	addmess	((method) LllTattle,	"dblclick",	A_CANT, 0);
 	addmess	((method) LllTattle,	"tattle",	A_NOTHING);
 	addmess	((method) LllAssist,	"assist",	A_CANT, 0);
@@ -179,6 +186,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) LllDSP,		"dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) LllDSP64,		"dsp64",		A_CANT, 0);
 
 	//Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -238,10 +246,7 @@ noMoreDefaults:
 	outlet_new(me, "signal");
 	
 	// Initialize and store object components
-	me->mul		= iMul;
-	me->add		= iAdd;
-	LllMod(me, iMod);								// This is the only parameter with
-													// some added initialization work.
+	LinCongSetup(&me->lc, iMul, iAdd, iMod);
 	me->seed	= iSeed;
 
 	return me;
@@ -256,25 +261,27 @@ noMoreDefaults:
  *	LllMul(me, iMul)
  *	LllAdderl(me, iMul)
  *	LllMod(me, iMul)
+ *	LllSkip(me, iCount)
  *	
  *	Nothing reallly bad can happen... we simply treat everything as unsigned. A multiplier
  *	of 0 seems a little counter-productive, but even this is allowed.
  *
+ *	Changing any of the recurrence parameters recalculates the constants used by the
+ *	block kernel (see LinCong.c). Skip jumps ahead in the sequence as if iCount samples
+ *	had been generated, in logarithmic time.
+ *
  ******************************************************************************************/
 
-void LllMul	(tLCN* me, unsigned long iMul)		{ me->mul = iMul; }
-void LllAdd	(tLCN* me, unsigned long iAdd)		{ me->add = iAdd; }
+void LllMul	(tLCN* me, unsigned long iMul)		{ LinCongSetup(&me->lc, iMul, me->lc.add, me->lc.mod); }
+void LllAdd	(tLCN* me, unsigned long iAdd)		{ LinCongSetup(&me->lc, me->lc.mul, iAdd, me->lc.mod); }
+void LllMod	(tLCN* me, unsigned long iMod)		{ LinCongSetup(&me->lc, me->lc.mul, me->lc.add, iMod); }
 void LllSeed	(tLCN* me, unsigned long iSeed)		{ me->seed = iSeed; }
 
-void LllMod	(tLCN* me, unsigned long iMod)
+void LllSkip(tLCN* me, double iCount)
 	{
-	unsigned bitCount = CountBits(iMod);
-	
-	me->mod		= iMod;
-	me->modMask = bitCount == 1
-					? iMod - 1
-					: 0;
-	
+	if (iCount < 0.0)
+		error("%s: can't skip backwards (%lf)", kClassName, iCount);
+	else me->seed = LinCongSkip(&me->lc, me->seed, (UInt64) iCount);
 	}
 
 
@@ -294,14 +301,14 @@ LllTattle(
 	
 	post("%s state",
 			kClassName);
-	post("  Current multiplier: %lu", me->mul);
-	post("  Current adder: %lu", me->add);
-	post("  Current modulo: %lu", me->mod);
-	if (me->mod == 0)
+	post("  Current multiplier: %lu", (unsigned long) me->lc.mul);
+	post("  Current adder: %lu", (unsigned long) me->lc.add);
+	post("  Current modulo: %lu", (unsigned long) me->lc.mod);
+	if (me->lc.mod == 0)
 		post("     ...which is treated as 4294967296");
-	if (me->modMask != 0)
-		post("     ...which we perform by masking with %lx", me->modMask);
-	post("  Current seed: %lu", me->seed);
+	if (me->lc.modMask != 0)
+		post("     ...which we perform by masking with %lx", (unsigned long) me->lc.modMask);
+	post("  Current seed: %lu", (unsigned long) me->seed);
 	
 	}
 
@@ -361,12 +368,14 @@ LllDSP(
  *
  *	LllPerform(iParams)
  *
- *	Parameter block for PerformSync contains 8 values:
+ *	Parameter block for PerformSync contains 4 values:
  *		- Address of this function
- *		- The performing schhh~ object
+ *		- The performing lll~ object
  *		- Vector size
  *		- output signal
- *		- Imaginary output signal
+ *
+ *	The sequence is generated a chunk at a time by LinCongFill(), then mapped to the
+ *	signal range.
  *
  ******************************************************************************************/
 
@@ -387,46 +396,34 @@ LllPerform(
 	long			vecCounter;
 	tSampleVector	outNoise;
 	tLCN*			me = (tLCN*) iParams[paramMe];
-	unsigned long	mul,
-					add,
-					mod,
-					seed;
+	UInt32			seed,
+					chunk[kChunkSize];
+	double			scale;
 	
 	if (me->coreObject.z_disabled) goto exit;
 	
 	// Copy parameters into registers
 	vecCounter	= (long) iParams[paramVectorSize];
 	outNoise	= (tSampleVector) iParams[paramOut];
-	mul			= me->mul;
-	add			= me->add;
-	mod			= me->mod;
 	seed		= me->seed;
+	scale		= (me->lc.mod == 0) ? 0.0 : (double) kULongMax / (double) me->lc.mod;
 	
 	// Do our stuff
-	if (mod == 0) do {
-		// Treat modulo as 2^32, which means we just let the processor truncate arithmetic overflow
-		seed *= mul;
-		seed += add;
-		*outNoise++ = ULong2Signal(seed);
-		} while (--vecCounter > 0);
+	while (vecCounter > 0) {
+		long	n = (vecCounter < kChunkSize) ? vecCounter : kChunkSize,
+				i;
 		
-	else {
-		unsigned long	modMask = me->modMask;
-		double			scale	= (double) kULongMax / (double) mod;
+		seed = LinCongFill(&me->lc, seed, chunk, n);
 		
-		if (modMask != 0)  do {
-			seed *= mul;
-			seed += add;
-			seed &= modMask;
-			*outNoise++ = scale * Long2Signal((long) seed) - 1.0;
-			} while (--vecCounter > 0);
+		if (me->lc.mod == 0)
+			// Modulo is 2^32, values already cover the full range
+			for (i = 0; i < n; i += 1)
+				outNoise[i] = ULong2Signal(chunk[i]);
+		else for (i = 0; i < n; i += 1)
+				outNoise[i] = scale * Long2Signal((long) chunk[i]) - 1.0;
 		
-		else  do {
-			seed *= mul;
-			seed += add;
-			seed %= mod;
-			*outNoise++ = scale * Long2Signal((long) seed) - 1.0;
-			} while (--vecCounter > 0);
+		outNoise	+= n;
+		vecCounter	-= n;
 		}
 	
 	me->seed = seed;
@@ -434,3 +431,70 @@ LllPerform(
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	LllDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	LllPerform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. The mapping to the signal range is done in double
+ *	precision, so the full resolution of the sequence survives.
+ *
+ ******************************************************************************************/
+
+void
+LllDSP64(
+	tLCN*		me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) LllPerform64, 0, NIL);
+	}
+
+void
+LllPerform64(
+	tLCN*		me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iIns, iInCount, iOutCount, iFlags, iUser)
+	
+	long			vecCounter	= iVectorSize;
+	tSampleVector64	outNoise	= iOuts[0];
+	UInt32			seed		= me->seed,
+					chunk[kChunkSize];
+	double			scale		= (me->lc.mod == 0)
+									? 2.0 / ((double) kULongMax + 1.0)
+									: 2.0 / (double) me->lc.mod;
+	
+	if (me->coreObject.z_disabled) return;
+	
+	while (vecCounter > 0) {
+		long	n = (vecCounter < kChunkSize) ? vecCounter : kChunkSize,
+				i;
+		
+		seed = LinCongFill(&me->lc, seed, chunk, n);
+		
+		for (i = 0; i < n; i += 1)
+			outNoise[i] = scale * chunk[i] - 1.0;
+		
+		outNoise	+= n;
+		vecCounter	-= n;
+		}
+	
+	me->seed = seed;
+	}
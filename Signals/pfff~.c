@@ -180,6 +180,8 @@ static void	PvvvInfo(tBrown*);
 	// MSP Messages
 static void	PvvvDSP(tBrown*, t_signal**, short*);
 static int*	PvvvPerform(int*);
+static void	PvvvDSP64(tBrown*, t_object*, short*, double, long, long);
+static void	PvvvPerform64(tBrown*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -236,6 +238,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) PvvvDSP,		"dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) PvvvDSP64,		"dsp64",		A_CANT, 0);
 
 	//Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -721,3 +724,70 @@ PvvvPerform(
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	PvvvDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	PvvvPerform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. The integer buffer is shared with PvvvPerform(); only the
+ *	final conversion differs.
+ *
+ ******************************************************************************************/
+
+void
+PvvvDSP64(
+	tBrown*		me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) PvvvPerform64, 0, NIL);
+	}
+
+void
+PvvvPerform64(
+	tBrown*		me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iIns, iInCount, iOutCount, iFlags, iUser)
+	
+	long*			curSamp;
+	long			vecSize		= iVectorSize,
+					i;
+	tSampleVector64	outNoise	= iOuts[0];
+	
+	if (me->coreObject.z_disabled) return;
+	
+	if (me->bufPos + vecSize > kMaxBuf)
+		GenerateNewBuffer(me);
+	curSamp	= me->buffer + me->bufPos;
+	me->bufPos += vecSize;
+	
+	if (me->nn == 0) {
+		for (i = 0; i < vecSize; i += 1)
+			outNoise[i] = Long2Signal64(curSamp[i]);
+		}
+	else {
+		long	mask	= me->mask,
+				offset	= me->offset;
+		
+		for (i = 0; i < vecSize; i += 1)
+			outNoise[i] = Long2Signal64((curSamp[i] & mask) + offset);
+		}
+	
+	}
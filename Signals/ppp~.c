@@ -106,6 +106,8 @@ static void	PppInfo(tPop*);
 	// MSP Messages
 static void	PppDSP(tPop*, t_signal**, short*);
 static int*	PppPerform(int*);
+static void	PppDSP64(tPop*, t_object*, short*, double, long, long);
+static void	PppPerform64(tPop*, t_object*, double**, long, double**, long, long, long, void*);
 
 static void PppCalcNext(tPop*);
 
@@ -159,6 +161,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) PppDSP, "dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) PppDSP64, "dsp64",		A_CANT, 0);
 
 	// Stash pointers to commonly used symbols
 	gSymSymbol	= gensym("sym");
@@ -608,3 +611,172 @@ PppPerform(
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	PppDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	PppPerform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. PopCorn64() is PopCorn() writing to a 64-bit vector.
+ *
+ ******************************************************************************************/
+
+void
+PppDSP64(
+	tPop*		me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iConnectCounts, iMaxVectorSize, iFlags)
+	
+	me->curSR = iSampleRate;
+	
+	if (me->sampsToNext < 0)
+		PppCalcNext(me);
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) PppPerform64, 0, NIL);
+	}
+
+	static long PopCorn64(tPop* me, long vecCounter, tSampleVector64 oNoise)
+		{
+		double	curLevel	= me->curLevel,
+				slope		= me->slope,
+				goal		= me->nextLevel;
+		long	sampsAtStart = vecCounter,
+				popWidth	= me->popWidth,
+				sampsThisTime;
+		
+		if (curLevel == 0.0) {
+			// We're starting a brand new pop. Weee!
+			slope = goal / popWidth;
+			sampsThisTime = popWidth;
+			if (sampsThisTime > vecCounter) {
+				// Won't make it all the way up
+				while (vecCounter-- > 0)
+					*oNoise++ = curLevel += slope;
+				goto exit;
+				}
+			// At this point we know that we can at least go as far as the peak
+			vecCounter -= sampsThisTime;
+			while (sampsThisTime-- > 0)
+				*oNoise++ = curLevel += slope;
+			// We're at the top (or bottom). Reverse slope and continue back to 0
+			slope = -slope;
+			sampsThisTime = popWidth;
+			if (sampsThisTime > vecCounter)
+				while (vecCounter-- > 0) *oNoise++ = curLevel += slope;
+			else {
+				vecCounter -= sampsThisTime;
+				while (sampsThisTime-- > 0)
+					*oNoise++ = curLevel += slope;
+				slope	= 0.0;
+				curLevel = 0.0;
+				}
+			}
+		
+		else if ((goal > 0.0 && slope > 0.0)
+					|| (goal < 0.0 && slope < 0.0)) {
+			// We are picking up in the first half of a pop.
+			sampsThisTime = (goal - curLevel) / slope + 0.5;
+			if (sampsThisTime > vecCounter) {
+				// We still won't make it all the way to the peak. Strange, but possible
+				while (vecCounter-- > 0)
+					*oNoise++ = curLevel += slope;
+				goto exit;
+				}
+			// At this point we know that we can at least go as far as the peak
+			vecCounter -= sampsThisTime;
+			while (sampsThisTime-- > 0)
+				*oNoise++ = curLevel += slope;
+			// We're at the top (or bottom). Reverse slope and continue back to 0
+			slope = - slope;
+			sampsThisTime = popWidth;
+			if (sampsThisTime > vecCounter)
+				while (vecCounter-- > 0) *oNoise++ = curLevel += slope;
+			else {
+				vecCounter -= sampsThisTime;
+				while (sampsThisTime-- > 0)
+					*oNoise++ = curLevel += slope;
+				slope = 0.0;
+				curLevel = 0.0;
+				}
+			}
+		
+		else {
+			// Aha. We are picking up on the return half of a pop.
+			sampsThisTime = -curLevel / slope + 0.5;
+			if (sampsThisTime > vecCounter)
+				while (vecCounter-- > 0) *oNoise++ = curLevel += slope;
+			else {
+				vecCounter -= sampsThisTime;
+				while (sampsThisTime-- > 0)
+					*oNoise++ = curLevel += slope;
+				slope = 0.0;
+				curLevel = 0.0;
+				}
+			}
+			
+		if (curLevel == 0.0) {
+			// Made it to end of pop.
+			// That was fun. When can we do it again?
+			PppCalcNext(me);
+			}
+	exit:
+		// Don't forget to update state.
+		me->slope		= slope;
+		me->curLevel	= curLevel;
+		
+		return sampsAtStart - vecCounter;
+		}
+
+void
+PppPerform64(
+	tPop*		me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iIns, iInCount, iOutCount, iFlags, iUser)
+	
+	long			vecCounter	= iVectorSize,
+					sampsToNext;
+	tSampleVector64	outNoise	= iOuts[0];
+	
+	if (me->coreObject.z_disabled) return;
+	
+	sampsToNext	= (me->curLevel == 0.0) ? me->sampsToNext : 0;
+	
+	while (vecCounter > 0) {
+		if (sampsToNext > 0) {
+			long sampsThisTime = sampsToNext;
+			if (sampsThisTime > vecCounter)
+				sampsThisTime = vecCounter;
+			
+			vecCounter	-= sampsThisTime;
+			sampsToNext	-= sampsThisTime;
+			
+			while (sampsThisTime-- > 0) *outNoise++ = 0.0;
+			}
+		
+		else {
+			long sampsDone = PopCorn64(me, vecCounter, outNoise);
+			
+			vecCounter	-= sampsDone;
+			outNoise	+= sampsDone;
+			sampsToNext	= me->sampsToNext;
+			}
+		}
+	
+	me->sampsToNext = sampsToNext;
+	}
@@ -102,6 +102,8 @@ static void	Pvvv2Info(objBrown*);
 	// MSP Messages
 static void	Pvvv2DSP(objBrown*, t_signal**, short*);
 static int*	Pvvv2Perform(int*);
+static void	Pvvv2DSP64(objBrown*, t_object*, short*, double, long, long);
+static void	Pvvv2Perform64(objBrown*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -159,6 +161,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) Pvvv2DSP,		"dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) Pvvv2DSP64,		"dsp64",		A_CANT, 0);
 
 	//Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -557,3 +560,115 @@ Pvvv2Perform(
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	Pvvv2DSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	Pvvv2Perform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain, reading from the same Voss buffer as Pvvv2Perform().
+ *
+ ******************************************************************************************/
+
+void
+Pvvv2DSP64(
+	objBrown*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) Pvvv2Perform64, 0, NIL);
+	}
+
+void
+Pvvv2Perform64(
+	objBrown*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iIns, iInCount, iOutCount, iFlags, iUser)
+	
+	float*			curSamp;
+	long			vecSize		= iVectorSize;
+	tSampleVector64	outNoise	= iOuts[0];
+	
+	if (me->coreObject.z_disabled) return;
+	
+	// Time to generate new buffer?
+	// Condition must also take possibility of vector size changing mid-buffer
+	if (me->bufPos + vecSize > kMaxBuf) {
+		GenerateNewBuffer(me);
+		}
+	curSamp	= me->buffer + me->bufPos;
+	me->bufPos += vecSize;
+	
+	// Do we have to deal with NN factor and/or Range actions?
+	switch(me->action) {
+	default:
+		// actStet
+		if (me->nn == 0)
+			do { *outNoise++ = *curSamp++; } while (--vecSize > 0);
+		else {
+			float	factor	= me->factor,
+					factor1	= me->factor1,
+					offset	= me->offset;
+			
+			do { *outNoise++ = factor1 * floor(factor * (*curSamp++)) + offset; } 
+			while (--vecSize > 0);
+			}
+		break;
+	
+	case actClip:
+		if (me->nn == 0)
+			do { *outNoise++ = ClipSignal(*curSamp++); } while (--vecSize > 0);
+		else {
+			float	factor	= me->factor,
+					factor1	= me->factor1,
+					offset	= me->offset;
+			
+			do { *outNoise++ = factor1 * floor(factor * ClipSignal(*curSamp++)) + offset; }
+			while (--vecSize > 0);
+			}
+		break;
+	
+	case actWrap:
+		if (me->nn == 0)
+			do { *outNoise++ = WrapSignal(*curSamp++); } while (--vecSize > 0);
+		else {
+			float	factor	= me->factor,
+					factor1	= me->factor1,
+					offset	= me->offset;
+			
+			do { *outNoise++ = factor1 * floor(factor * WrapSignal(*curSamp++)) + offset; }
+			while (--vecSize > 0);
+			}
+		break;
+	
+	case actReflect:
+		if (me->nn == 0)
+			do { *outNoise++ = ReflectSignal(*curSamp++); } while (--vecSize > 0);
+		else {
+			float	factor	= me->factor,
+					factor1	= me->factor1,
+					offset	= me->offset;
+			
+			do { *outNoise++ = factor1 * floor(factor * ReflectSignal(*curSamp++)) + offset; }
+			while (--vecSize > 0);
+			}
+		break;
+		}
+	
+	}
@@ -84,6 +84,8 @@ static void	ShhhInfo(tWhite*);
 	// MSP Messages
 static void	ShhhDSP(tWhite*, t_signal**, short*);
 static int*	ShhhPerform(int*);
+static void	ShhhDSP64(tWhite*, t_object*, short*, double, long, long);
+static void	ShhhPerform64(tWhite*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -129,6 +131,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) ShhhDSP,		"dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) ShhhDSP64,	"dsp64",	A_CANT, 0);
 
 	//Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -318,3 +321,51 @@ ShhhPerform(
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	ShhhDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	ShhhPerform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	64-bit signal chain (Max 6 and later). The float path above is kept for older hosts.
+ *
+ ******************************************************************************************/
+
+void
+ShhhDSP64(
+	tWhite*		me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) ShhhPerform64, 0, NIL);
+	}
+
+void
+ShhhPerform64(
+	tWhite*		me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iIns, iInCount, iOutCount, iFlags, iUser)
+	
+	if (me->coreObject.z_disabled) return;
+	
+	if (me->nn == 0)
+			Taus88SigVector64(iOuts[0], iVectorSize);
+	else	Taus88SigVectorMasked64(iOuts[0], iVectorSize, me->mask, me->offset);
+	
+	}
@@ -96,6 +96,8 @@ static void	SssInfo(tPink*);
 	// MSP Messages
 static void	SssDSP(tPink*, t_signal**, short*);
 static int*	SssPerform(int*);
+static void	SssDSP64(tPink*, t_object*, short*, double, long, long);
+static void	SssPerform64(tPink*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -141,6 +143,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) SssDSP,		"dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) SssDSP64,		"dsp64",		A_CANT, 0);
 
 	//Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -406,3 +409,121 @@ SssPerform(
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	SssDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	SssPerform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. The dice are the same as for SssPerform(); the sum is
+ *	converted to a double-precision sample at full 32-bit resolution.
+ *
+ ******************************************************************************************/
+
+void
+SssDSP64(
+	tPink*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) SssPerform64, 0, NIL);
+	}
+
+void
+SssPerform64(
+	tPink*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iIns, iInCount, iOutCount, iFlags, iUser)
+	
+	long			vecCounter	= iVectorSize;
+	tSampleVector64	outNoise	= iOuts[0];
+	unsigned long*	firstDie;
+	unsigned long	sum,
+					mask,
+					offset;
+	unsigned short	counter;				// Must be 16-bit value to match "dice" array
+	
+	if (me->coreObject.z_disabled) return;
+	
+	// Copy parameters into registers
+	sum			= me->sum;
+	firstDie	= me->dice;
+	mask		= me->mask;
+	offset		= me->offset;
+	counter		= me->counter;
+	
+	// Do our stuff
+	do {
+		unsigned long*		curDie		= firstDie;
+		int				 	bitCount	= CountBits(counter);
+		unsigned			bit			= 0x01;
+		
+		switch (bitCount) {
+			case 0:
+				InitDice(me);
+				sum = me->sum;
+				break;
+			
+			case 1:
+				// Just update one die
+				while ((bit & counter) == 0)
+					{
+					bit		*= 2;			// Let compiler choose fastest way to do this
+					curDie	+= 1;
+					}
+				sum -= *curDie;
+				sum += *curDie = Taus88(NULL) / kArraySize;
+				break;
+			
+			default:
+				if (bitCount < kArraySize / 2) {
+					// Still faster to calculate differences
+					int i = kArraySize;
+					do {
+						if (bit & counter) {
+							sum -= *curDie;
+							sum += *curDie = Taus88(NULL) / kArraySize;
+							}
+						bit		*= 2;
+						curDie	+= 1;
+						} while (--i > 0);
+					}
+				else {
+					// Faster just to update and recalculate sum from scratch
+					int i	= kArraySize;
+					sum	= 0;
+					do {
+						if (bit & counter)
+							*curDie = Taus88(NULL) / kArraySize;
+						sum += *curDie++;
+						bit *= 2;
+						} while (--i > 0);
+					}
+				break;
+			}
+		
+		*outNoise++	= ULong2Signal64((sum & mask) + offset);
+		counter++;
+		}
+		while (--vecCounter > 0);
+	
+	me->sum		= sum;
+	me->counter	= counter;
+	
+	}
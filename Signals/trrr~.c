@@ -85,6 +85,8 @@ static void	TrrrInfo(tTriNoise*);
 	// MSP Messages
 static void	TrrrDSP(tTriNoise*, t_signal**, short*);
 static int*	TrrrPerform(int*);
+static void	TrrrDSP64(tTriNoise*, t_object*, short*, double, long, long);
+static void	TrrrPerform64(tTriNoise*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -130,6 +132,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess((method) TrrrDSP, "dsp", A_CANT, 0);
+	LITTER_TIMEBOMB addmess((method) TrrrDSP64, "dsp64", A_CANT, 0);
 
 	//Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -326,3 +329,66 @@ TrrrPerform(
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	TrrrDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	TrrrPerform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain.
+ *
+ ******************************************************************************************/
+
+void
+TrrrDSP64(
+	tTriNoise*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) TrrrPerform64, 0, NIL);
+	}
+
+void
+TrrrPerform64(
+	tTriNoise*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iIns, iInCount, iOutCount, iFlags, iUser)
+	
+	long			vecCounter	= iVectorSize;
+	tSampleVector64	outNoise	= iOuts[0];
+	
+	if (me->coreObject.z_disabled) return;
+	
+	// Do our stuff
+	if (me->nn > 0) {
+		unsigned long	mask	= me->mask,
+						offset	= me->offset;
+		do {
+			unsigned long t = (Taus88(NULL) >> 1) + (Taus88(NULL) >> 1);
+			*outNoise++ = ULong2Signal64((t & mask) + offset);
+			} while (--vecCounter > 0);
+		}
+	
+	else do {
+		// Taus88TriSig() only has 24 bits to play with; here we can keep all 32
+		UInt32 t = (Taus88(NULL) >> 1) + (Taus88(NULL) >> 1);
+		*outNoise++ = ULong2Signal64(t);
+		} while (--vecCounter > 0);
+
+	}
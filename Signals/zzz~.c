@@ -89,6 +89,8 @@ static void	ZzzInfo(tPink*);
 	// MSP Messages
 static void	ZzzDSP(tPink*, t_signal**, short*);
 static int*	ZzzPerform(int*);
+static void	ZzzDSP64(tPink*, t_object*, short*, double, long, long);
+static void	ZzzPerform64(tPink*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -134,6 +136,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) ZzzDSP,		"dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) ZzzDSP64,		"dsp64",		A_CANT, 0);
 
 	//Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -385,3 +388,99 @@ ZzzPerform(
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	ZzzDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	ZzzPerform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. Same Voss-McCartney update as ZzzPerform().
+ *
+ ******************************************************************************************/
+
+void
+ZzzDSP64(
+	tPink*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) ZzzPerform64, 0, NIL);
+	}
+
+void
+ZzzPerform64(
+	tPink*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iIns, iInCount, iOutCount, iFlags, iUser)
+	
+	long			vecCounter	= iVectorSize;
+	tSampleVector64	outNoise	= iOuts[0];
+	unsigned long*	firstDie;
+	unsigned long	sum,
+					mask,
+					offset;
+	unsigned short	counter;						// Must be 16-bit to match dice count
+	
+	if (me->coreObject.z_disabled) return;
+	
+	// Copy parameters into registers
+	sum			= me->sum;
+	firstDie	= me->dice;
+	mask		= me->mask;
+	offset		= me->offset;
+	counter		= me->counter;
+	
+	// Do our stuff
+	do {
+		unsigned long	samp;
+		
+		if (counter != 0) {
+			// Need to count the number of clear LSBs
+			unsigned long	rightZeroes	= 0;
+			unsigned 		testBit		= 0x01;
+			unsigned long*	curDie;				// Calculate address later...
+			
+			// ASSERT: counter != 0
+			// (Otherwise the following will never terminate!)
+			while ((counter & testBit) == 0) {
+				testBit		*= 2;
+				rightZeroes	+= 1;
+				}
+			
+			// rightZeroes is the index into the array of "dice" of the element that gets modified
+			// this time around. Calculate the address once
+			curDie = firstDie + rightZeroes;
+			sum -= *curDie;
+			sum += *curDie = Taus88(NULL) / kArraySize;
+			}
+		// If c == 0, nothing gets changed (aside from the hi-freq. white noise component)
+		counter++;
+		
+		// Add high frequency white-noise component to sum
+		samp  = Taus88(NULL) / kArraySize;
+		samp += sum;
+		samp &= mask;
+		*outNoise++	= ULong2Signal64(samp + offset);
+		}
+		while (--vecCounter > 0);
+	
+	me->sum		= sum;
+	me->counter	= counter;
+	
+	}
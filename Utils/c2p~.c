@@ -58,6 +58,12 @@ enum {
 	outletPhase
 	};
 
+	// Flags for connected outlets, passed to the 64-bit perform method
+enum {
+	connAmp		= 0x01,
+	connPhase	= 0x02
+	};
+
 
 #pragma mark • Type Definitions
 
@@ -75,6 +81,8 @@ typedef struct {
 static void*	C2PNew(void);
 static void		C2PDSP(tConverter*, t_signal**, short*);
 static int*		C2PPerform(int*);
+static void		C2PDSP64(tConverter*, t_object*, short*, double, long, long);
+static void		C2PPerform64(tConverter*, t_object*, double**, long, double**, long, long, long, void*);
 
 	// Various Max messages
 static void		C2PAssist(tConverter*, void* , long , long , char*);
@@ -115,6 +123,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) C2PDSP, "dsp", A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) C2PDSP64, "dsp64", A_CANT, 0);
 
 	// Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -267,3 +276,74 @@ exit:
 	return iParams + paramNextLink;
 	}
 
+
+/******************************************************************************************
+ *
+ *	C2PDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	C2PPerform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. Each outlet gets its own loop, so the amplitude loop has
+ *	no calls to atan2() in it and can be vectorized.
+ *
+ ******************************************************************************************/
+
+void
+C2PDSP64(
+	tConverter*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iSampleRate, iMaxVectorSize, iFlags)
+	
+	long conn = 0;
+	
+	if (iConnectCounts[outletAmp] > 0)	conn |= connAmp;
+	if (iConnectCounts[outletPhase] > 0)	conn |= connPhase;
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) C2PPerform64, 0, (void*) conn);
+	}
+
+void
+C2PPerform64(
+	tConverter*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iInCount, iOutCount, iFlags)
+	
+	long			conn		= (long) iUser,
+					i;
+	tSampleVector64	realSig		= iIns[inletReal],
+					imagSig		= iIns[inletImag],
+					ampSig		= iOuts[0],
+					phaseSig	= iOuts[1];
+	
+	if (me->coreObject.z_disabled) return;
+	
+	// Unconnected inlets read as zero, so only the outlets need checking
+	if (conn & connPhase) {
+		for (i = 0; i < iVectorSize; i += 1) {
+			double	real	= realSig[i],
+					imag	= imagSig[i];
+			
+			phaseSig[i] = (real != 0.0 || imag != 0.0) ? atan2(imag, real) : 0.0;
+			}
+		}
+	
+	if (conn & connAmp) {
+		for (i = 0; i < iVectorSize; i += 1)
+			ampSig[i] = sqrt(realSig[i] * realSig[i] + imagSig[i] * imagSig[i]);
+		}
+	
+	}
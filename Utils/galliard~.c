@@ -65,6 +65,8 @@ void	GalliardConstInt(objPolynom*, long);
 	
 void	GalliardDSP(objPolynom*, t_signal*[], short[]);
 int*	GalliardPerform(int[]);				// Relies on int as 32-bit. Stupid ext_proto.h
+void	GalliardDSP64(objPolynom*, t_object*, short*, double, long, long);
+void	GalliardPerform64(objPolynom*, t_object*, double**, long, double**, long, long, long, void*);
 
 void	GalliardTattle(objPolynom*);
 void	GalliardAssist(objPolynom*,	tBoxPtr, long, long, char[]);
@@ -112,6 +114,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) GalliardDSP, 	"dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) GalliardDSP64, "dsp64",	A_CANT, 0);
 
 	// Informational messages
 	addmess	((method) GalliardTattle,	"dblclick",	A_CANT, 0);
@@ -335,6 +338,68 @@ exit:
 	return iParams + paramNextLink;
 	}
 
+/******************************************************************************************
+ *
+ *	GalliardDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	GalliardPerform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. The polynomial is evaluated in double precision anyway, so
+ *	the only difference is that nothing gets rounded to float on the way in or out.
+ *
+ ******************************************************************************************/
+
+void
+GalliardDSP64(
+	objPolynom*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) GalliardPerform64, 0, NIL);
+	}
+
+void
+GalliardPerform64(
+	objPolynom*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iInCount, iOutCount, iFlags, iUser)
+	
+	long			vecCounter	= iVectorSize;
+	tSampleVector64	inSig		= iIns[0],
+					outSig		= iOuts[0];
+	int				order;
+	double*			coeffs;
+	
+	if (me->coreObject.z_disabled) return;
+	
+	// Do our stuff
+	order	= me->order;
+	coeffs	= me->coeffs;
+	
+	// Watch out! EvalPoly() is currently unsafe for 0th-order functions
+	if (order == 0) do {
+		*outSig++ = *coeffs;
+		} while (--vecCounter > 0);
+	else do {
+		*outSig++ = EvalPoly(*inSig++, coeffs, order);
+		} while (--vecCounter > 0);
+	
+	}
+
 /******************************************************************************************
  *
  *	GalliardTattle(me)
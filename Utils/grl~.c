@@ -76,6 +76,9 @@ static void		GrlFree(tRanger*);
 static void		GrlDSP(tRanger*, t_signal**, short*);
 static int*		GrlPerformSimple(int*);
 static int*		GrlPerformHist(int*);
+static void		GrlDSP64(tRanger*, t_object*, short*, double, long, long);
+static void		GrlPerformSimple64(tRanger*, t_object*, double**, long, double**, long, long, long, void*);
+static void		GrlPerformHist64(tRanger*, t_object*, double**, long, double**, long, long, long, void*);
 
 	// Various Max messages
 static void		GrlAssist(tRanger*, void* , long , long , char*);
@@ -129,6 +132,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) GrlDSP,		"dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) GrlDSP64,		"dsp64",		A_CANT, 0);
 
 	// Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -487,3 +491,187 @@ exit:
 	return iParams + paramNextLink;
 	}
 
+
+/******************************************************************************************
+ *
+ *	GrlDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	GrlPerformSimple64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *	GrlPerformHist64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. Unwrapping is done in double precision; the history buffer
+ *	stays single precision, as it is shared with the 32-bit perform method.
+ *
+ ******************************************************************************************/
+
+void
+GrlDSP64(
+	tRanger*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+	
+	dsp_add64(	iDSP64, (t_object*) me,
+				(t_perfroutine64) ((me->histSize > 1) ? GrlPerformHist64 : GrlPerformSimple64),
+				0, NIL);
+	}
+
+void
+GrlPerformSimple64(
+	tRanger*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iInCount, iOutCount, iFlags, iUser)
+	
+	long			vecCounter	= iVectorSize;
+	tSampleVector64	inSig		= iIns[0],
+					outSig		= iOuts[0];
+	double			maxStep,
+					maxStep2,
+					prevSamp;
+	
+	if (me->coreObject.z_disabled) return;
+	
+	maxStep		= me->maxStep;
+	maxStep2	= maxStep + maxStep;
+	prevSamp	= me->prevSamp;
+	
+	if (maxStep > 0.0) do {
+		// Unwrap
+		double	curSamp = *inSig++,
+					diff	= fmod(curSamp - prevSamp, maxStep2);
+		if (diff > maxStep) {
+			diff -= maxStep2;
+			}
+		else if (diff < -maxStep) {
+			diff += maxStep2;
+			}
+		*outSig++ = prevSamp +=  diff;
+		} while (--vecCounter > 0);
+	
+	else if (maxStep == 0.0) do {
+		*outSig++ = prevSamp;
+		} while (--vecCounter > 0);
+	
+	else if (inSig != outSig) {
+		// me->min > me->max, so we do no unwrapping, just copy samples
+		// Note that we're so lazy we don't even do that much if inSig == outSig.
+		do {
+			*outSig++ = *inSig++;
+			} while (--vecCounter > 0);
+		
+		// We need an updated value for prevSig
+		prevSamp = outSig[-1];
+		}
+	
+	else {
+		// We just need an updated value for prevSig
+		prevSamp = outSig[iVectorSize - 1];
+		}
+		
+	// Whether or not we used me->prevSamp in this run, we must update it. It might
+	// be used in the next run.
+	me->prevSamp = prevSamp;
+	
+	}
+
+
+void
+GrlPerformHist64(
+	tRanger*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iInCount, iOutCount, iFlags, iUser)
+	
+	long			vecCounter	= iVectorSize;
+	tSampleVector64	inSig		= iIns[0],
+					outSig		= iOuts[0];
+	double			maxStep,
+					maxStep2;
+	float*			histPtr;
+	unsigned		bufCounter;
+	
+	if (me->coreObject.z_disabled) return;
+	
+	maxStep		= me->maxStep;
+	maxStep2	= maxStep + maxStep;
+	histPtr		= me->buffer + me->curElem;
+	bufCounter	= me->histSize - me->curElem;
+	
+	// Now that I have local copies of the descriptors for my circular buffer,
+	// I update the values stored in the unwrap~ object. Best to do this now
+	// before vecCounter is invalidated from my abusing it as loop counter.
+	me->curElem = (me->curElem + vecCounter) % me->histSize;
+	
+	// What happens next depends upon the current value of maxStep
+	if (maxStep > 0.0) do {
+		// Unwrap
+		double	curSamp		= *inSig++,
+				prevSamp	= *histPtr,
+					diff		= fmod(curSamp - prevSamp, maxStep2);
+		
+		if (diff > maxStep) {
+			diff -= maxStep2;
+			}
+		else if (diff < -maxStep) {
+			diff += maxStep2;
+			}
+		*outSig++ = prevSamp += diff;
+		*histPtr++ = prevSamp;
+		if (--bufCounter == 0) {
+			bufCounter	= me->histSize;
+			histPtr		= me->buffer;
+			}
+		} while (--vecCounter > 0);
+	
+	else if (maxStep2 == 0.0) do {
+		*outSig++ = *histPtr++;
+		if (--bufCounter == 0) {
+			bufCounter	= me->histSize;
+			histPtr		= me->buffer;
+			}
+		} while (--vecCounter > 0);
+	
+	else if (inSig != outSig) do {
+		// me->min > me->max, so we do no unwrapping, just copy samples
+		// Note that we're so lazy we don't even do that much if inSig == outSig.
+		*histPtr++ = *outSig++ = *inSig++;
+		if (--bufCounter == 0) {
+			bufCounter	= me->histSize;
+			histPtr		= me->buffer;
+			}
+		} while (--vecCounter > 0);
+	
+	else {
+		// Well, we don't need to copy MSP signal vectors, but we *do* need to maintain
+		// our own history
+		do {
+			*histPtr++ = *inSig++;
+			if (--bufCounter == 0) {
+				bufCounter	= me->histSize;
+				histPtr		= me->buffer;
+				}
+			} while (--vecCounter > 0);
+		}
+	
+	}
@@ -102,6 +102,8 @@ static void	NetochkaInfo(tDegrade*);
 	// MSP Messages
 static void	NetochkaDSP(tDegrade*, t_signal**, short*);
 static int*	NetochkaPerform(int*);
+static void	NetochkaDSP64(tDegrade*, t_object*, short*, double, long, long);
+static void	NetochkaPerform64(tDegrade*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -147,6 +149,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess	((method) NetochkaDSP,		"dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) NetochkaDSP64,		"dsp64",		A_CANT, 0);
 
 	// Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -644,3 +647,238 @@ NetochkaPerform(
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	NetochkaDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	NetochkaPerform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. Same as NetochkaPerform(), using the same helpers; the held
+ *	sample is cached in single precision so switching between the two is seamless.
+ *
+ ******************************************************************************************/
+
+void
+NetochkaDSP64(
+	tDegrade*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iConnectCounts, iMaxVectorSize, iFlags)
+	
+	if (me->curSR != iSampleRate) {
+		me->curSR = iSampleRate;
+		NetochkaESR(me, me->effSR);
+		}
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) NetochkaPerform64, 0, NIL);
+	}
+
+void
+NetochkaPerform64(
+	tDegrade*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iInCount, iOutCount, iFlags, iUser)
+	
+	long			vecCounter	= iVectorSize;
+	tSampleVector64	inSig		= iIns[0],
+					outSig		= iOuts[0];
+	int				nn;
+	double			skipSamps;
+	
+	if (me->coreObject.z_disabled) return;
+	
+	// Do our stuff
+	nn			= me->nn;
+	skipSamps	= me->skipSamps;
+	
+	if (nn == 0) {
+		// No nn factor
+		if (skipSamps == 0.0) {
+			// Not much to do...
+			// ...and even then, only if input and output are not sharing the same
+			// vector.
+			if (inSig != outSig)
+				do { *outSig++ = *inSig++; } while (--vecCounter > 0);
+			}
+		
+		else {
+			// Downsample
+			float	curSamp		= me->curSamp;
+			double	curSkipFrac	= me->curSkipFrac;
+			long	extraSteps	= curSkipFrac;					// Truncate float-to-integer
+			
+			if (extraSteps >= vecCounter) {
+				// Fill vector with current sample; update cached counter.
+				me->curSkipFrac -= vecCounter;
+				do { *outSig++ = curSamp; } while (--vecCounter > 0);
+				}
+			
+			else {
+				// Finish off last run of the current sample...
+				inSig		+= extraSteps;
+				vecCounter	-= extraSteps;
+				curSkipFrac -= extraSteps;
+				
+				while (extraSteps-- > 0)
+					*outSig++ = curSamp;
+				
+				// ... and run through the rest of the vector
+				while (vecCounter > 0) {
+					curSamp = *outSig++ = *inSig++;
+					vecCounter -= 1;
+					
+					extraSteps	= skipSamps + curSkipFrac;
+					if (extraSteps > vecCounter)
+						extraSteps = vecCounter;
+					inSig		+= extraSteps;
+					vecCounter	-= extraSteps;
+					curSkipFrac	+= skipSamps - extraSteps;
+					
+					while (extraSteps-- > 0) 
+						*outSig++ = curSamp;
+					}
+				
+				me->curSamp		= curSamp;
+				me->curSkipFrac	= curSkipFrac;
+				}
+			}
+		}														// END IF (nn == 0)
+	
+	else {
+		double	nnFrac	= me->nnFrac,
+				offset	= me->offset,
+				factor	= me->factor;
+		
+		if (nnFrac == 0.0) {
+			// Integral NN/Dither
+			float (*IntNNFunc)(double, double, double, long);
+			
+			if (nn < 0) {
+				IntNNFunc = Dither;
+				nn = -nn;
+				}
+			else IntNNFunc = Mask;
+			
+			if (skipSamps == 0.0) do {
+				// Just mask/dither
+				*outSig++ = IntNNFunc(*inSig++, factor, offset, nn);
+				} while (--vecCounter > 0);
+			
+			else {
+				// Mask/dither and downsample
+				float	curSamp		= me->curSamp;
+				double	curSkipFrac	= me->curSkipFrac;
+				long	extraSteps	= curSkipFrac;				// Truncate float-to-integer
+				
+				if (extraSteps >= vecCounter) {
+					// Fill vector with current sample; update cached counter.
+					me->curSkipFrac -= vecCounter;
+					do { *outSig++ = curSamp; } while (--vecCounter > 0);
+					}
+				
+				else {
+					// Finish off last run of the current sample...
+					inSig		+= extraSteps;
+					vecCounter	-= extraSteps;
+					curSkipFrac -= extraSteps;
+					
+					while (extraSteps-- > 0)
+						*outSig++ = curSamp;
+					
+					// ... and run through the rest of the vector
+					while (vecCounter > 0) {
+						curSamp = *outSig++ = IntNNFunc(*inSig++, factor, offset, nn);
+						vecCounter -= 1;
+						
+						extraSteps	= skipSamps + curSkipFrac;
+						if (extraSteps > vecCounter)
+							extraSteps = vecCounter;
+						inSig		+= extraSteps;
+						vecCounter	-= extraSteps;
+						curSkipFrac	+= skipSamps - extraSteps;
+						
+						while (extraSteps-- > 0) 
+							*outSig++ = curSamp;
+						}
+					
+					me->curSamp		= curSamp;
+					me->curSkipFrac	= curSkipFrac;
+					}											// END (extraSteps < vecCounter)
+				}												// END (skipSamps != 0.0)
+			}													// END IF (nnFrac == 0.0)
+		
+		else {
+			// Fractional NN/Dither
+			float (*FloatNNFunc)(double, double, double, double, long);
+			
+			if (nn < 0) {
+				FloatNNFunc = DitherAndNudge;
+				nn = -nn;
+				}
+			else FloatNNFunc = MaskAndNudge;
+			
+			if (skipSamps == 0.0) do {
+				// Just mask/dither
+				*outSig++ = FloatNNFunc(*inSig++, factor, offset, nnFrac, nn);
+				} while (--vecCounter > 0);
+			
+			else {
+				// Mask/dither and downsample
+				float	curSamp		= me->curSamp;
+				double	curSkipFrac	= me->curSkipFrac;
+				long	extraSteps	= curSkipFrac;				// Truncate float-to-integer
+				
+				if (extraSteps >= vecCounter) {
+					// Fill vector with current sample; update cached counter.
+					me->curSkipFrac -= vecCounter;
+					do { *outSig++ = curSamp; } while (--vecCounter > 0);
+					}
+				
+				else {
+					// Finish off last run of the current sample...
+					inSig		+= extraSteps;
+					vecCounter	-= extraSteps;
+					curSkipFrac -= extraSteps;
+					
+					while (extraSteps-- > 0)
+						*outSig++ = curSamp;
+					
+					// ... and run through the rest of the vector
+					while (vecCounter > 0) {
+						curSamp = *outSig++ = FloatNNFunc(*inSig++, factor, offset, nnFrac, nn);
+						vecCounter -= 1;
+						
+						extraSteps	= skipSamps + curSkipFrac;
+						if (extraSteps > vecCounter)
+							extraSteps = vecCounter;
+						inSig		+= extraSteps;
+						vecCounter	-= extraSteps;
+						curSkipFrac	+= skipSamps - extraSteps;
+						
+						while (extraSteps-- > 0) 
+							*outSig++ = curSamp;
+						}
+					
+					me->curSamp		= curSamp;
+					me->curSkipFrac	= curSkipFrac;
+					}											// END (extraSteps < vecCounter)
+				}												// END (skipSamps != 0.0)
+			}													// END (nnFrac != 0.0)
+		}														// END (nn != 0)
+	
+	}
@@ -55,6 +55,12 @@ enum {
 	outletImag
 	};
 
+	// Flags for connected outlets, passed to the 64-bit perform method
+enum {
+	connReal	= 0x01,
+	connImag	= 0x02
+	};
+
 
 #pragma mark • Type Definitions
 
@@ -72,6 +78,8 @@ typedef struct {
 static void*	P2CNew(void);
 static void	P2CDSP(tConverter*, t_signal**, short*);
 static int*	P2CPerform(int*);
+static void	P2CDSP64(tConverter*, t_object*, short*, double, long, long);
+static void	P2CPerform64(tConverter*, t_object*, double**, long, double**, long, long, long, void*);
 
 	// Various Max messages
 static void	P2CAssist(tConverter*, void* , long , long , char*);
@@ -112,6 +120,7 @@ main(void)
 	
 	// MSP-Level messages
 	LITTER_TIMEBOMB addmess((method) P2CDSP, "dsp", A_CANT, 0);
+	LITTER_TIMEBOMB addmess((method) P2CDSP64, "dsp64", A_CANT, 0);
 	
 	// Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -259,3 +268,68 @@ exit:
 	return iParams + paramNextLink;
 	}
 
+
+/******************************************************************************************
+ *
+ *	P2CDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *	P2CPerform64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVectorSize, iFlags, iUser)
+ *
+ *	Max 6 64-bit signal chain. Outlets that are not connected are not calculated.
+ *
+ ******************************************************************************************/
+
+void
+P2CDSP64(
+	tConverter*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iSampleRate, iMaxVectorSize, iFlags)
+	
+	long conn = 0;
+	
+	if (iConnectCounts[outletReal] > 0)	conn |= connReal;
+	if (iConnectCounts[outletImag] > 0)	conn |= connImag;
+	
+	dsp_add64(iDSP64, (t_object*) me, (t_perfroutine64) P2CPerform64, 0, (void*) conn);
+	}
+
+void
+P2CPerform64(
+	tConverter*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iInCount, iOutCount, iFlags)
+	
+	long			conn		= (long) iUser,
+					i;
+	tSampleVector64	ampSig		= iIns[inletAmp],
+					phaseSig	= iIns[inletPhase],
+					realSig		= iOuts[0],
+					imagSig		= iOuts[1];
+	
+	if (me->coreObject.z_disabled) return;
+	
+	if (conn & connReal) {
+		for (i = 0; i < iVectorSize; i += 1)
+			realSig[i] = ampSig[i] * cos(phaseSig[i]);
+		}
+	
+	if (conn & connImag) {
+		for (i = 0; i < iVectorSize; i += 1)
+			imagSig[i] = ampSig[i] * sin(phaseSig[i]);
+		}
+	
+	}
@@ -80,10 +80,13 @@ enum {
 	// MSP message functions
 #ifdef __MAX_MSP_OBJECT__
 	void	ScampDSP(objScamp*, t_signal**, short*);
+	void	ScampDSP64(objScamp*, t_object*, short*, double, long, long);
 #endif
 
 int*	ScampPerformStatic(int*);
 int*	ScampPerformDynamic(int*);
+void	ScampPerformStatic64(objScamp*, t_object*, double**, long, double**, long, long, long, void*);
+void	ScampPerformDynamic64(objScamp*, t_object*, double**, long, double**, long, long, long, void*);
 
 
 #pragma mark -
@@ -123,6 +126,7 @@ main(void)
 	ScampAddMessages();
 	
 	LITTER_TIMEBOMB addmess	((method) ScampDSP, 	"dsp",		A_CANT, 0);
+	LITTER_TIMEBOMB addmess	((method) ScampDSP64, 	"dsp64",	A_CANT, 0);
 
 	// Initialize Litter Library
 	LitterInit(kClassName, 0);
@@ -1562,4 +1566,1068 @@ ScampPerformDynamic(
 exit:
 	return iParams + paramNextLink;
 	}
+
+
+/******************************************************************************************
+ *
+ *	ScampDSP64(me, iDSP64, iConnectCounts, iSampleRate, iMaxVectorSize, iFlags)
+ *
+ *	Max 6 64-bit signal chain. Unlike MSP 5, MSP 6 passes a vector for every signal inlet,
+ *	so the DSP method records which inlets are connected in a set of flags for the perform
+ *	methods, which replace the unconnected ones with NIL just like ScampDSP() does.
+ *
+ ******************************************************************************************/
+
+	static inline tSampleVector64 ConnVec(double** iIns, long iConn, int iInlet)
+		{ return (iConn & (1 << iInlet)) ? iIns[iInlet] : NIL; }
+
+void
+ScampDSP64(
+	objScamp*	me,
+	t_object*	iDSP64,
+	short*		iConnectCounts,
+	double		iSampleRate,
+	long		iMaxVectorSize,
+	long		iFlags)
+	
+	{
+	#pragma unused(iSampleRate, iMaxVectorSize, iFlags)
+	
+	long	conn = 0;
+	int		i;
+	
+	if (iConnectCounts[outletSigOut] == 0)
+		return;
+	
+	for (i = inletSigIn; i <= inletCurve; i += 1) {
+		if (iConnectCounts[i] > 0)
+			conn |= 1 << i;
+		}
+	
+	dsp_add64(	iDSP64, (t_object*) me,
+				(t_perfroutine64) ((conn & ~(1 << inletSigIn)) == 0
+										? ScampPerformStatic64
+										: ScampPerformDynamic64),
+				0, (void*) conn);
+	}
+	
+
+/******************************************************************************************
+ *
+ *	PerformStatLinStet64(me, iVecSize, iSigIn, oSigOut)
+ *	PerformStatLinLim64(me, iVecSize, iSigIn, oSigOut)
+ *	PerformStatCurveStet64(me, iVecSize, iSigIn, oSigOut)
+ *	PerformStatCurveLim64(me, iVecSize, iSigIn, oSigOut)
+ *	
+ *	ScampPerformStatic64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVecSize, iFlags, iUser)
+ *	
+ *	64-bit versions of the static-parameter perform methods above, sample for sample.
+ *
+ ******************************************************************************************/
+
+static void
+PerformStatLinStet64(
+	objScamp*		me,
+	long			iVecSize,
+	tSampleVector64	iSigIn,
+	tSampleVector64	oSigOut)
+	
+	{
+	double	scale	= me->slope,
+			offset	= me->offset;
+	
+	if (iSigIn != NIL) {
+		double curSamp;
+		
+		if (me->symmetry == symAxis) do {
+			curSamp  = *iSigIn++;
+			curSamp *= (curSamp >= 0.0) ? scale : -scale;
+			curSamp += offset;
+			
+			*oSigOut++ = curSamp;
+			} while (--iVecSize > 0);
+		
+		else do {
+			curSamp  = *iSigIn++;
+			curSamp *= scale;
+			curSamp += offset;
+			
+			*oSigOut++ = curSamp;
+			} while (--iVecSize > 0);
+		}
+		 	
+	else {							// Unusual situation: generating signal from all-static input
+		double outVal = me->input;
+		
+		if (me->symmetry == symAxis && outVal < 0.0)
+			outVal = -outVal;
+		outVal *= scale;
+		outVal += offset;
+		
+		do { *oSigOut++ = outVal; } while (--iVecSize > 0);
+		}
+	
+	}
+	
+static void
+PerformStatLinLim64(
+	objScamp*		me,
+	long			iVecSize,
+	tSampleVector64	iSigIn,
+	tSampleVector64	oSigOut)
+
+	{
+	double		scale	= me->slope,
+				offset	= me->offset,
+				outMin	= me->outMin,
+				outMax	= me->outMax;
+	long*		ctr		= &me->limCounter;
+	tActFunc	limFunc;
+	
+	switch (me->action) {
+		case actWrap:		limFunc = Wrap;		break;
+		case actReflect:	limFunc = Reflect;	break;
+		default:			limFunc = Clip;		break;		// ASSERT: me->action == act Clip
+		}
+	
+	if (iSigIn != NIL) {
+		double curSamp;
+		
+		if (me->symmetry == symAxis) do {
+			curSamp  = *iSigIn++;
+			curSamp *= (curSamp >= 0.0) ? scale : -scale;
+			curSamp += offset;
+			
+			*oSigOut++ = limFunc(curSamp, outMin, outMax, ctr);
+			} while (--iVecSize > 0);
+		
+		else do {
+			curSamp  = *iSigIn++;
+			curSamp *= scale;
+			curSamp += offset;
+			
+			*oSigOut++ = limFunc(curSamp, outMin, outMax, ctr);
+			} while (--iVecSize > 0);
+		}
+		 	
+	else {							// Unusual situation: generating signal from all-static input
+		double outVal = me->input;
+		
+		if (me->symmetry == symAxis && outVal < 0.0)
+			outVal = -outVal;
+		outVal = limFunc(outVal * scale + offset, outMin, outMax, ctr);
+		
+		do { *oSigOut++ = outVal; } while (--iVecSize > 0);
+		}
+	
+	}
+
+static void
+PerformStatCurveStet64(
+	objScamp*		me,
+	long			iVecSize,
+	tSampleVector64	iSigIn,
+	tSampleVector64	oSigOut)
+	
+	{
+	double		inOrigin	= me->inMin,
+				inRange		= me->inMax - inOrigin,
+				inScale		= 1.0 / inRange,
+				outOffset	= me->outMin,
+				outRange	= me->outMax - outOffset,
+				curve		= me->curve;
+	tMapFunc	mapFunc;
+	
+	switch (me->mappingType) {
+	default:								// ASSERT: me->mappingType == mapLin
+		mapFunc = Kink;
+		break;			
+	case mapPow:
+		mapFunc = (curve == 2.0) ? Square : Power;
+		break;
+	case mapExp:
+		mapFunc = Exponent;
+		break;
+		}
+	
+	if (iSigIn != NIL) switch (me->symmetry) {
+		double curSamp;
+		
+		default:												// Must be symNone
+			do {
+				curSamp	 = (*iSigIn++ - inOrigin) * inScale;	// Optimization over MapToUnit()
+				curSamp	 = mapFunc(curSamp, curve);
+				*oSigOut++ = MapFromUnit(curSamp, outOffset, outRange);
+				} while (--iVecSize > 0);
+			break;
+		
+		case symAxis:
+			inOrigin += inRange * 0.5;
+			inScale += inScale;
+			
+			do {
+				curSamp	 = *iSigIn++ - inOrigin;
+				curSamp *= (curSamp >= 0.0) ? inScale : -inScale;
+				curSamp	 = mapFunc(curSamp, curve);
+				*oSigOut++ = MapFromUnit(curSamp, outOffset, outRange);
+				} while (--iVecSize > 0);
+			break;
+		
+		case symPoint:
+			outRange	*= 0.5;
+			outOffset	+= outRange;
+			inOrigin	+= inRange * 0.5;
+			inScale		+= inScale;
+			
+			do {
+				curSamp = *iSigIn++ - inOrigin;
+				
+				if (curSamp >= 0.0) {
+					curSamp *= inScale;
+					curSamp  = mapFunc(curSamp, curve);
+					*oSigOut++ = MapFromUnit(curSamp, outOffset, outRange);
+					}
+				else {
+					curSamp *= -inScale;
+					curSamp  = mapFunc(curSamp, curve);
+					*oSigOut++ = MapFromUnit(curSamp, outOffset, -outRange);
+					}
+				
+				} while (--iVecSize > 0);
+			break;
+		}
+	
+	else {							// Unusual situation: generating signal from all-static input
+		double outVal = me->input - inOrigin;
+		
+		switch (me->symmetry) {
+		default:
+			// Must be symNone
+			outVal *= inScale;
+			outVal  = mapFunc(outVal, curve);
+			outVal  = MapFromUnit(outVal, outOffset, outRange);
+				
+			do { *oSigOut++ = outVal; } while (--iVecSize > 0);
+			break;
+		
+		case symAxis:
+			inScale += inScale;							// Double scale factor for symmetry
+			
+			outVal -= inRange * 0.5;					// Correct origin
+			outVal *= (outVal < 0.0) ? -inScale : inScale;
+			outVal	= mapFunc(outVal, curve);
+			outVal  = MapFromUnit(outVal, outOffset, outRange);
+				
+			do { *oSigOut++ = outVal; } while (--iVecSize > 0);
+			break;
+		
+		case symPoint:
+			inScale		+= inScale;						// Double scale factor for symmetry
+			outRange	*= 0.5;							// and adjust output range
+			outOffset	+= outRange;
+			
+			outVal -= inRange * 0.5;					// Correct origin
+			if (outVal >= 0.0) {
+				outVal *= inScale;
+				outVal  = mapFunc(outVal, curve);
+				outVal  = MapFromUnit(outVal, outOffset, outRange);
+				}
+			else {
+				outVal *= -inScale;
+				outVal  = mapFunc(outVal, curve);
+				outVal  = MapFromUnit(outVal, outOffset, -outRange);
+				}
+			
+			do { *oSigOut++ = outVal; } while (--iVecSize > 0);
+			break;
+			}
+		}
+	
+	}
+	
+	
+static void
+PerformStatCurveLim64(
+	objScamp*		me,
+	long			iVecSize,
+	tSampleVector64	iSigIn,
+	tSampleVector64	oSigOut)
+	
+	{
+	double			inOrigin	= me->inMin,
+					inRange		= me->inMax - inOrigin,
+					inScale		= 1.0 / inRange,
+					outOffset	= me->outMin,
+					outRange	= me->outMax - outOffset,
+					curve		= me->curve;
+	long*			ctr		= &me->limCounter;
+	tMapFunc		mapFunc;
+	tUnitActFunc	limFunc;
+	
+	switch (me->mappingType) {
+		default:		mapFunc = Kink;		break;			// ASSERT: me->mappingType == mapLin
+		case mapPow:	mapFunc = Power;	break;
+		case mapExp:	mapFunc = Exponent;	break;
+		}
+	
+	switch (me->action) {
+		default:			limFunc = UnitClip;		break;		// ASSERT: me->action == actClip
+		case actWrap:		limFunc = UnitWrap;		break;
+		case actReflect:	limFunc = UnitReflect;	break;
+		}
+	
+	if (iSigIn != NIL) switch (me->symmetry) {
+		double curSamp;
+		
+		default:
+			// Must be symNone
+			do {
+				curSamp	 = (*iSigIn++ - inOrigin) * inScale;	// Optimization over MapToUnit()
+				curSamp	 = limFunc(mapFunc(curSamp, curve), ctr);
+				*oSigOut++ = MapFromUnit(curSamp, outOffset, outRange);
+				} while (--iVecSize > 0);
+			break;
+		
+		case symAxis:
+			inOrigin += inRange * 0.5;
+			inScale += inScale;
+			
+			do {
+				curSamp	 = *iSigIn++ - inOrigin;	// Optimization over MapToUnit()
+				curSamp *= (curSamp < 0.0) ? -inScale : inScale;
+				curSamp	 = limFunc(mapFunc(curSamp, curve), ctr);
+				*oSigOut++ = MapFromUnit(curSamp, outOffset, outRange);
+				} while (--iVecSize > 0);
+			break;
+		
+		case symPoint:
+			inOrigin	+= inRange * 0.5;
+			inScale		+= inScale;
+			outRange	*= 0.5;
+			outOffset	+= outRange;
+			
+			do {
+				Boolean	flipPoint;
+				
+				curSamp	 = *iSigIn++;
+				curSamp -= inOrigin;
+				curSamp *= ( flipPoint = (curSamp < 0.0) ) ? inScale : -inScale;
+				curSamp	 = limFunc(mapFunc(curSamp, curve), ctr);
+				*oSigOut++ = MapFromUnit(flipPoint ? -curSamp : curSamp, outOffset, outRange);
+				} while (--iVecSize > 0);
+			break;
+		}
+	
+	else {
+		// Unusual situation: generating signal from all-static input
+		double outVal = me->input - inOrigin;
+		
+		switch (me->symmetry) {
+		default:
+			// Must be symNone
+			outVal *= inScale;
+			outVal  = limFunc(mapFunc(outVal, curve), ctr);
+			outVal  = MapFromUnit(outVal, outOffset, outRange);
+				
+			do { *oSigOut++ = outVal; } while (--iVecSize > 0);
+			break;
+		
+		case symAxis:
+			inScale += inScale;							// Double scale factor for symmetry
+			
+			outVal -= inRange * 0.5;					// Correct origin
+			outVal *= (outVal < 0.0) ? -inScale : inScale;
+			outVal	= limFunc(mapFunc(outVal, curve), ctr);
+			outVal  = MapFromUnit(outVal, outOffset, outRange);
+				
+			do { *oSigOut++ = outVal; } while (--iVecSize > 0);
+			break;
+		
+		case symPoint:
+			inScale		+= inScale;						// Double scale factor for symmetry
+			outRange	*= 0.5;							// and adjust output range
+			outOffset	+= outRange;
+			
+			outVal -= inRange * 0.5;					// Correct origin
+			{
+			Boolean	flipPoint;
+			
+			outVal *= ( flipPoint = (outVal < 0.0) ) ? -inScale : inScale;
+			outVal  = limFunc(mapFunc(outVal, curve), ctr);
+			outVal  = MapFromUnit(flipPoint ? -outVal : outVal, outOffset, outRange);
+			}
+				
+			do { *oSigOut++ = outVal; } while (--iVecSize > 0);
+			break;
+			}
+		}
+	
+	}
+void
+ScampPerformStatic64(
+	objScamp*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iInCount, iOutCount, iFlags)
+	
+	long			conn	= (long) iUser;
+	tSampleVector64	sigIn	= ConnVec(iIns, conn, inletSigIn),
+					sigOut	= iOuts[0];
+	tScampFlags		flags;
+	
+	if (me->coreObject.z_disabled)
+		return;
+	
+	flags = me->flags;
+	
+	if (flags.rangeInval)
+		ScampCalcRange(me);
+		
+	if (flags.degenerate) {
+		if (me->action == actStet)
+			 PerformStatLinStet64(me, iVectorSize, sigIn, sigOut);
+		else PerformStatLinLim64(me, iVectorSize, sigIn, sigOut);
+		}
+	else {
+		if (me->action == actStet)
+			 PerformStatCurveStet64(me, iVectorSize, sigIn, sigOut);
+		else PerformStatCurveLim64(me, iVectorSize, sigIn, sigOut);
+		}
+	
+	}
+	
+
+/******************************************************************************************
+ *
+ *	PerformDynLinStet64(me, iVSize, iSigIn, iSig1, iSig2, iSigMin, iSigMax, iSigCurve, oSig)
+ *	PerformDynLinLim64(me, iVSize, iSigIn, iSig1, iSig2, iSigMin, iSigMax, iSigCurve, oSig)
+ *	PerformDynCurveStet64(me, iVSize, iSigIn, iSig1, iSig2, iSigMin, iSigMax, iSigCurve, oSig)
+ *	PerformDynCurveLim64(me, iVSize, iSigIn, iSig1, iSig2, iSigMin, iSigMax, iSigCurve, oSig)
+ *	
+ *	ScampPerformDynamic64(me, iDSP64, iIns, iInCount, iOuts, iOutCount, iVecSize, iFlags, iUser)
+ *	
+ *	64-bit versions of the signal-parameter perform methods.
+ *
+ ******************************************************************************************/
+
+static void
+PerformDynLinStet64(
+	objScamp*		me,
+	long			iVecSize,
+	tSampleVector64	iSigIn,
+	tSampleVector64	iSig1,
+	tSampleVector64	iSig2,
+	tSampleVector64	iSigOutMin,
+	tSampleVector64	iSigOutMax,
+	tSampleVector64	oSigOut)
+	
+	{
+	double	statIn	= me->input,
+			curSamp;
+	
+	if (me->flags.map) {
+		// Modern "map" mode
+		double	inMin	= me->inMin,
+				inMax	= me->inMax,
+				outMin	= me->outMin,
+				outMax	= me->outMax;
+		
+		if (me->symmetry == symAxis) do {
+			curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+			
+			if (iSig1 != NIL)		inMin	= *iSig1++;
+			if (iSig2 != NIL)		inMax	= *iSig2++;
+			if (iSigOutMin != NIL)	outMin	= *iSigOutMin++;
+			if (iSigOutMax != NIL)	outMax	= *iSigOutMax++;
+			
+			curSamp -= inMin;
+			curSamp /= (inMax - inMin);
+			curSamp *= (curSamp >= 0.0) ? (outMax - outMin) : (outMin - outMax);
+			curSamp += outMin;
+			
+			*oSigOut++ = curSamp;
+			} while (--iVecSize > 0);
+		
+		else do {
+			curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+			
+			if (iSig1 != NIL)		inMin	= *iSig1++;
+			if (iSig2 != NIL)		inMax	= *iSig2++;
+			if (iSigOutMin != NIL)	outMin	= *iSigOutMin++;
+			if (iSigOutMax != NIL)	outMax	= *iSigOutMax++;
+			
+			curSamp -= inMin;
+			curSamp /= inMax - inMin;
+			curSamp *= outMax - outMin;
+			curSamp += outMin;
+			
+			*oSigOut++ = curSamp;
+			} while (--iVecSize > 0);
+		}
+	
+	else {
+		// Traditional "scale" mode
+		double	scale	= me->slope,
+				offset	= me->offset;
+		
+		if (me->symmetry == symAxis) do {
+			curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+			
+			if (iSig1 != NIL)	scale	= *iSig1++;
+			if (iSig2 != NIL)	offset	= *iSig2++;
+			
+			curSamp *= (curSamp >= offset) ? scale : -scale;
+			curSamp += offset;
+			
+			*oSigOut++ = curSamp;
+			} while (--iVecSize > 0);
+		
+		else do {
+			curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+			curSamp *= (iSig1 != NIL) ? *iSig1++ : scale;
+			curSamp += (iSig2 != NIL) ? *iSig2++ : offset;
+			
+			*oSigOut++ = curSamp;
+			} while (--iVecSize > 0);
+		}
+	
+	}
+	
+static void
+PerformDynLinLim64(
+	objScamp*		me,
+	long			iVecSize,
+	tSampleVector64	iSigIn,
+	tSampleVector64	iSig1,
+	tSampleVector64	iSig2,
+	tSampleVector64	iSigOutMin,
+	tSampleVector64	iSigOutMax,
+	tSampleVector64	oSigOut)
+
+	{
+	double		statIn	= me->input,
+				outMin	= me->outMin,
+				outMax	= me->outMax,
+				curSamp;
+	long*		ctr		= &me->limCounter;
+	tActFunc	limFunc;
+	
+	switch (me->action) {
+		case actWrap:		limFunc = Wrap;		break;
+		case actReflect:	limFunc = Reflect;	break;
+		default:			limFunc = Clip;		break;		// ASSERT: me->action == act Clip
+		}
+	
+	if (me->flags.map) {
+		// Modern "map" mode
+		double	inMin	= me->inMin,
+				inMax	= me->inMax;
+		
+		if (me->symmetry == symAxis) do {
+			curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+			
+			if (iSig1 != NIL)		inMin	= *iSig1++;
+			if (iSig2 != NIL)		inMax	= *iSig2++;
+			if (iSigOutMin != NIL)	outMin	= *iSigOutMin++;
+			if (iSigOutMax != NIL)	outMax	= *iSigOutMax++;
+			
+			curSamp -= inMin;
+			curSamp /= (inMax - inMin);
+			curSamp *= (curSamp >= 0.0) ? (outMax - outMin) : (outMin - outMax);
+			curSamp += outMin;
+			
+			*oSigOut++ = limFunc(curSamp, outMin, outMax, ctr);
+			} while (--iVecSize > 0);
+		
+		else do {
+			curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+			
+			if (iSig1 != NIL)		inMin	= *iSig1++;
+			if (iSig2 != NIL)		inMax	= *iSig2++;
+			if (iSigOutMin != NIL)	outMin	= *iSigOutMin++;
+			if (iSigOutMax != NIL)	outMax	= *iSigOutMax++;
+			
+			curSamp -= inMin;
+			curSamp /= inMax - inMin;
+			curSamp *= outMax - outMin;
+			curSamp += outMin;
+			
+			*oSigOut++ = limFunc(curSamp, outMin, outMax, ctr);
+			} while (--iVecSize > 0);
+		}
+	
+	else {
+		// Traditional "scale" mode
+		double	scale	= me->slope,
+				offset	= me->offset;
+		
+		if (me->symmetry == symAxis) do {
+			curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+			
+			if (iSig1 != NIL)		scale	= *iSig1++;
+			if (iSig2 != NIL)		offset	= *iSig2++;
+			if (iSigOutMin != NIL)	outMin	= *iSigOutMin++;
+			if (iSigOutMax != NIL)	outMax	= *iSigOutMax++;
+			
+			curSamp *= (curSamp >= offset) ? scale : -scale;
+			curSamp += offset;
+			
+			*oSigOut++ = limFunc(curSamp, outMin, outMax, ctr);
+			} while (--iVecSize > 0);
+		
+		else do {
+			curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+			curSamp *= (iSig1 != NIL) ? *iSig1++ : scale;
+			curSamp += (iSig2 != NIL) ? *iSig2++ : offset;
+			
+			if (iSigOutMin != NIL)	outMin	= *iSigOutMin++;
+			if (iSigOutMax != NIL)	outMax	= *iSigOutMax++;
+			
+			*oSigOut++ = limFunc(curSamp, outMin, outMax, ctr);
+			} while (--iVecSize > 0);
+		}
+	}
+
+static void
+PerformDynCurveStet64(
+	objScamp*		me,
+	long			iVecSize,
+	tSampleVector64	iSigIn,
+	tSampleVector64	iSig1,
+	tSampleVector64	iSig2,
+	tSampleVector64	iSigOutMin,
+	tSampleVector64	iSigOutMax,
+	tSampleVector64	iSigCurve,
+	tSampleVector64	oSigOut)
+	
+	{
+	double		statIn	= me->input,
+				outMin	= me->outMin,
+				outMax	= me->outMax,
+				curve	= me->curve,
+				inMin,
+				inMax,
+				curSamp;
+	tMapFunc	mapFunc;
+	
+	switch (me->mappingType) {
+		default:		mapFunc = Kink;		break;			// ASSERT: me->mappingType == mapLin
+		case mapPow:	mapFunc = Power;	break;
+		case mapExp:	mapFunc = Exponent;	break;
+		}
+	
+	if (me->flags.map) {
+		// Modern "map" mode
+		inMin	= me->inMin;
+		inMax	= me->inMax;
+		
+		switch (me->symmetry) {
+		default:
+			// Must be symNone
+			do {
+				curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+				
+				if (iSig1 != NIL)		inMin	= *iSig1++;
+				if (iSig2 != NIL)		inMax	= *iSig2++;
+				if (iSigOutMin != NIL)	outMin	= *iSigOutMin++;
+				if (iSigOutMax != NIL)	outMax	= *iSigOutMax++;
+				if (iSigCurve != NIL)	curve	= *iSigCurve++;
+				
+				curSamp -= inMin;
+				curSamp /= inMax - inMin;
+				curSamp	 = mapFunc(curSamp, curve);
+				curSamp	*= outMax - outMin;
+				curSamp += outMin;
+				
+				*oSigOut++ = curSamp;
+				} while (--iVecSize > 0);
+			break;
+		
+		case symAxis:
+			do {
+				curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+				
+				if (iSig1 != NIL)		inMin	= *iSig1++;
+				if (iSig2 != NIL)		inMax	= *iSig2++;
+				if (iSigOutMin != NIL)	outMin	= *iSigOutMin++;
+				if (iSigOutMax != NIL)	outMax	= *iSigOutMax++;
+				if (iSigCurve != NIL)	curve	= *iSigCurve++;
+				
+				curSamp -= inMin;
+				curSamp /= (curSamp >= 0.0) ? (inMax - inMin) : (inMin - inMax);
+				curSamp	 = mapFunc(curSamp, curve);
+				curSamp	*= outMax - outMin;
+				curSamp += outMin;
+				
+				*oSigOut++ = curSamp;
+				} while (--iVecSize > 0);
+			break;
+		
+		case symPoint:
+			do {
+				Boolean	flipPoint;
+				
+				curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+				
+				if (iSig1 != NIL)		inMin	= *iSig1++;
+				if (iSig2 != NIL)		inMax	= *iSig2++;
+				if (iSigOutMin != NIL)	outMin	= *iSigOutMin++;
+				if (iSigOutMax != NIL)	outMax	= *iSigOutMax++;
+				if (iSigCurve != NIL)	curve	= *iSigCurve++;
+				
+				curSamp -= inMin;
+				curSamp /= (flipPoint = (curSamp < 0.0)) ? (inMin - inMax) : (inMax - inMin);
+				curSamp	 = mapFunc(curSamp, curve);
+				curSamp	*= flipPoint ? (outMin - outMax) : (outMax - outMin);
+				curSamp += outMin;
+				
+				*oSigOut++ = curSamp;
+				} while (--iVecSize > 0);
+			break;
+			}
+		}
+	
+	else {
+		// Traditional "scale" mode
+		// Strange thing to do with curves, but hey! why not?
+		double	scale	= me->slope,
+				offset	= me->offset,
+				invScale;
+		
+		switch (me->symmetry) {
+		default:
+			// Must be symNone
+			do {
+				curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+				
+				if (iSig1 != NIL)		scale	= *iSig1++;
+				if (iSig2 != NIL)		offset	= *iSig2++;
+				if (iSigOutMin != NIL)	outMin	= *iSigOutMin++;
+				if (iSigOutMax != NIL)	outMax	= *iSigOutMax++;
+				if (iSigCurve != NIL)	curve	= *iSigCurve++;
+				
+				// Extrapolate inMin/inMax from scale and offset
+				invScale = 1.0 / scale;
+				inMin = (outMin - offset) * invScale;
+				inMax = inMin + (outMax - outMin) * invScale;
+				
+				curSamp -= inMin;
+				curSamp /= inMax - inMin;
+				curSamp	 = mapFunc(curSamp, curve);
+				curSamp	*= outMax - outMin;
+				curSamp += outMin;
+				
+				*oSigOut++ = curSamp;
+				} while (--iVecSize > 0);
+			break;
+		
+		case symAxis:
+			do {
+				curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+				
+				if (iSig1 != NIL)		scale	= *iSig1++;
+				if (iSig2 != NIL)		offset	= *iSig2++;
+				if (iSigOutMin != NIL)	outMin	= *iSigOutMin++;
+				if (iSigOutMax != NIL)	outMax	= *iSigOutMax++;
+				if (iSigCurve != NIL)	curve	= *iSigCurve++;
+				
+				// Extrapolate inMin/inMax from scale and offset
+				invScale = 1.0 / scale;
+				inMin = (outMin - offset) * invScale;
+				inMax = inMin + (outMax - outMin) * invScale;
+				
+				curSamp -= inMin;
+				curSamp /= (curSamp >= 0.0) ? (inMax - inMin) : (inMin - inMax);
+				curSamp	 = mapFunc(curSamp, curve);
+				curSamp	*= outMax - outMin;
+				curSamp += outMin;
+				
+				*oSigOut++ = curSamp;
+				} while (--iVecSize > 0);
+			break;
+		
+		case symPoint:
+			do {
+				Boolean	flipPoint;
+				
+				curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+				
+				if (iSig1 != NIL)		scale	= *iSig1++;
+				if (iSig2 != NIL)		offset	= *iSig2++;
+				if (iSigOutMin != NIL)	outMin	= *iSigOutMin++;
+				if (iSigOutMax != NIL)	outMax	= *iSigOutMax++;
+				if (iSigCurve != NIL)	curve	= *iSigCurve++;
+				
+				// Extrapolate inMin/inMax from scale and offset
+				invScale = 1.0 / scale;
+				inMin = (outMin - offset) * invScale;
+				inMax = inMin + (outMax - outMin) * invScale;
+				
+				curSamp -= inMin;
+				curSamp /= (flipPoint = (curSamp < 0.0)) ? (inMin - inMax) : (inMax - inMin);
+				curSamp	 = mapFunc(curSamp, curve);
+				curSamp	*= flipPoint ? (outMin - outMax) : (outMax - outMin);
+				curSamp += outMin;
+				
+				*oSigOut++ = curSamp;
+				} while (--iVecSize > 0);
+			break;
+			}
+		}
+	
+	}
+	
+	
+static void
+PerformDynCurveLim64(
+	objScamp*		me,
+	long			iVecSize,
+	tSampleVector64	iSigIn,
+	tSampleVector64	iSig1,
+	tSampleVector64	iSig2,
+	tSampleVector64	iSigOutMin,
+	tSampleVector64	iSigOutMax,
+	tSampleVector64	iSigCurve,
+	tSampleVector64	oSigOut)
+	
+	{
+	double			statIn	= me->input,
+					outMin	= me->outMin,
+					outMax	= me->outMax,
+					curve	= me->curve,
+					inMin,
+					inMax,
+					curSamp;
+	long*			ctr		= &me->limCounter;
+	tMapFunc		mapFunc;
+	tUnitActFunc	limFunc;
+	
+	switch (me->mappingType) {
+		default:		mapFunc = Kink;		break;			// ASSERT: me->mappingType == mapLin
+		case mapPow:	mapFunc = Power;	break;
+		case mapExp:	mapFunc = Exponent;	break;
+		}
+	
+	switch (me->action) {
+		default:			limFunc = UnitClip;		break;		// ASSERT: me->action == actClip
+		case actWrap:		limFunc = UnitWrap;		break;
+		case actReflect:	limFunc = UnitReflect;	break;
+		}
+	
+	if (me->flags.map) {
+		// Modern "map" mode
+		inMin	= me->inMin;
+		inMax	= me->inMax;
+		
+		switch (me->symmetry) {
+		default:
+			// Must be symNone
+			do {
+				curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+				
+				if (iSig1 != NIL)		inMin	= *iSig1++;
+				if (iSig2 != NIL)		inMax	= *iSig2++;
+				if (iSigOutMin != NIL)	outMin	= *iSigOutMin++;
+				if (iSigOutMax != NIL)	outMax	= *iSigOutMax++;
+				if (iSigCurve != NIL)	curve	= *iSigCurve++;
+				
+				curSamp -= inMin;
+				curSamp /= inMax - inMin;
+				curSamp	 = limFunc(mapFunc(curSamp, curve), ctr);
+				curSamp	*= outMax - outMin;
+				curSamp += outMin;
+				
+				*oSigOut++ = curSamp;
+				} while (--iVecSize > 0);
+			break;
+		
+		case symAxis:
+			do {
+				curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+				
+				if (iSig1 != NIL)		inMin	= *iSig1++;
+				if (iSig2 != NIL)		inMax	= *iSig2++;
+				if (iSigOutMin != NIL)	outMin	= *iSigOutMin++;
+				if (iSigOutMax != NIL)	outMax	= *iSigOutMax++;
+				if (iSigCurve != NIL)	curve	= *iSigCurve++;
+				
+				curSamp -= inMin;
+				curSamp /= (curSamp >= 0.0) ? (inMax - inMin) : (inMin - inMax);
+				curSamp	 = limFunc(mapFunc(curSamp, curve), ctr);
+				curSamp	*= outMax - outMin;
+				curSamp += outMin;
+				
+				*oSigOut++ = curSamp;
+				} while (--iVecSize > 0);
+			break;
+		
+		case symPoint:
+			do {
+				Boolean	flipPoint;
+				
+				curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+				
+				if (iSig1 != NIL)		inMin	= *iSig1++;
+				if (iSig2 != NIL)		inMax	= *iSig2++;
+				if (iSigOutMin != NIL)	outMin	= *iSigOutMin++;
+				if (iSigOutMax != NIL)	outMax	= *iSigOutMax++;
+				if (iSigCurve != NIL)	curve	= *iSigCurve++;
+				
+				curSamp -= inMin;
+				curSamp /= (flipPoint = (curSamp < 0.0)) ? (inMin - inMax) : (inMax - inMin);
+				curSamp	 = limFunc(mapFunc(curSamp, curve) , ctr);
+				curSamp	*= flipPoint ? (outMin - outMax) : (outMax - outMin);
+				curSamp += outMin;
+				
+				*oSigOut++ = curSamp;
+				} while (--iVecSize > 0);
+			break;
+			}
+		}
+	
+	else {
+		// Traditional "scale" mode
+		// Strange thing to do with curves, but hey! why not?
+		double	scale	= me->slope,
+				offset	= me->offset,
+				invScale;
+		
+		switch (me->symmetry) {
+		default:
+			// Must be symNone
+			do {
+				curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+				
+				if (iSig1 != NIL)		scale	= *iSig1++;
+				if (iSig2 != NIL)		offset	= *iSig2++;
+				if (iSigOutMin != NIL)	outMin	= *iSigOutMin++;
+				if (iSigOutMax != NIL)	outMax	= *iSigOutMax++;
+				if (iSigCurve != NIL)	curve	= *iSigCurve++;
+				
+				// Extrapolate inMin/inMax from scale and offset
+				invScale = 1.0 / scale;
+				inMin = (outMin - offset) * invScale;
+				inMax = inMin + (outMax - outMin) * invScale;
+				
+				curSamp -= inMin;
+				curSamp /= inMax - inMin;
+				curSamp	 = limFunc(mapFunc(curSamp, curve) , ctr);
+				curSamp	*= outMax - outMin;
+				curSamp += outMin;
+				
+				*oSigOut++ = curSamp;
+				} while (--iVecSize > 0);
+			break;
+		
+		case symAxis:
+			do {
+				curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+				
+				if (iSig1 != NIL)		scale	= *iSig1++;
+				if (iSig2 != NIL)		offset	= *iSig2++;
+				if (iSigOutMin != NIL)	outMin	= *iSigOutMin++;
+				if (iSigOutMax != NIL)	outMax	= *iSigOutMax++;
+				if (iSigCurve != NIL)	curve	= *iSigCurve++;
+				
+				// Extrapolate inMin/inMax from scale and offset
+				invScale = 1.0 / scale;
+				inMin = (outMin - offset) * invScale;
+				inMax = inMin + (outMax - outMin) * invScale;
+				
+				curSamp -= inMin;
+				curSamp /= (curSamp >= 0.0) ? (inMax - inMin) : (inMin - inMax);
+				curSamp	 = limFunc(mapFunc(curSamp, curve) , ctr);
+				curSamp	*= outMax - outMin;
+				curSamp += outMin;
+				
+				*oSigOut++ = curSamp;
+				} while (--iVecSize > 0);
+			break;
+		
+		case symPoint:
+			do {
+				Boolean	flipPoint;
+				
+				curSamp  = (iSigIn != NIL) ? *iSigIn++ : statIn;
+				
+				if (iSig1 != NIL)		scale	= *iSig1++;
+				if (iSig2 != NIL)		offset	= *iSig2++;
+				if (iSigOutMin != NIL)	outMin	= *iSigOutMin++;
+				if (iSigOutMax != NIL)	outMax	= *iSigOutMax++;
+				if (iSigCurve != NIL)	curve	= *iSigCurve++;
+				
+				// Extrapolate inMin/inMax from scale and offset
+				invScale = 1.0 / scale;
+				inMin = (outMin - offset) * invScale;
+				inMax = inMin + (outMax - outMin) * invScale;
+				
+				curSamp -= inMin;
+				curSamp /= (flipPoint = (curSamp < 0.0)) ? (inMin - inMax) : (inMax - inMin);
+				curSamp	 = limFunc(mapFunc(curSamp, curve) , ctr);
+				curSamp	*= flipPoint ? (outMin - outMax) : (outMax - outMin);
+				curSamp += outMin;
+				
+				*oSigOut++ = curSamp;
+				} while (--iVecSize > 0);
+			break;
+			}
+		}
+	
+	}
+void
+ScampPerformDynamic64(
+	objScamp*	me,
+	t_object*	iDSP64,
+	double**	iIns,
+	long		iInCount,
+	double**	iOuts,
+	long		iOutCount,
+	long		iVectorSize,
+	long		iFlags,
+	void*		iUser)
+	
+	{
+	#pragma unused(iDSP64, iInCount, iOutCount, iFlags)
+	
+	long			conn		= (long) iUser;
+	tSampleVector64	sigIn		= ConnVec(iIns, conn, inletSigIn),
+					sig1		= ConnVec(iIns, conn, inlet1),
+					sig2		= ConnVec(iIns, conn, inlet2),
+					sigMinOut	= ConnVec(iIns, conn, inletMinOut),
+					sigMaxOut	= ConnVec(iIns, conn, inletMaxOut),
+					sigCurve	= ConnVec(iIns, conn, inletCurve),
+					sigOut		= iOuts[0];
+	tScampFlags		flags;
+	
+	if (me->coreObject.z_disabled)
+		return;
+	
+	flags = me->flags;
+	
+	if (flags.rangeInval && (sig1 == NIL || sig2 == NIL))
+		ScampCalcRange(me);
+		
+	if (me->mappingType == mapLin || (flags.degenerate && sigCurve == NIL)) {
+		if (me->action == actStet)
+			 PerformDynLinStet64(me, iVectorSize, sigIn, sig1, sig2,
+								 sigMinOut, sigMaxOut, sigOut);
+		else PerformDynLinLim64(me, iVectorSize, sigIn, sig1, sig2,
+								sigMinOut, sigMaxOut, sigOut);
+		}
+	else {
+		if (me->action == actStet)
+			 PerformDynCurveStet64(me, iVectorSize, sigIn, sig1, sig2,
+								   sigMinOut, sigMaxOut, sigCurve, sigOut);
+		else PerformDynCurveLim64(me, iVectorSize, sigIn, sig1, sig2,
+								  sigMinOut, sigMaxOut, sigCurve, sigOut);
+		}
 	
+	}